@@ -48,6 +48,21 @@
 #define COMMON_CODEC_NAME_KEY "CodecName"
 #define COMMON_CODEC_NAME_DEF ""
 
+#define COMMON_VIDEO_FEC_KEY "VideoFec"
+#define COMMON_VIDEO_FEC_DEF 1
+
+#define COMMON_KCP_FEC_KEY "KcpFec"
+#define COMMON_KCP_FEC_DEF ""
+
+#define COMMON_MOVE_LANE_COPIES_KEY "MoveLaneCopies"
+#define COMMON_MOVE_LANE_COPIES_DEF 2
+
+#define COMMON_MULTIPATH_KEY "Multipath"
+#define COMMON_MULTIPATH_DEF 0
+
+#define COMMON_MULTIPATH_DUPLICATE_KEY "MultipathDuplicate"
+#define COMMON_MULTIPATH_DUPLICATE_DEF 1
+
 // 用户启动配置
 #define COMMON_RECORD_KEY "RecordPath"
 #define COMMON_RECORD_DEF ""
@@ -403,6 +418,72 @@ QString Config::getCodecName()
     return codecName;
 }
 
+bool Config::getVideoFec()
+{
+    int videoFec = COMMON_VIDEO_FEC_DEF;
+    m_settings->beginGroup(GROUP_COMMON);
+    videoFec = m_settings->value(COMMON_VIDEO_FEC_KEY, COMMON_VIDEO_FEC_DEF).toInt();
+    m_settings->endGroup();
+    return videoFec != 0;
+}
+
+bool Config::getKcpFec(quint8 &data, quint8 &parity)
+{
+    data = 0;
+    parity = 0;
+    QString kcpFec;
+    m_settings->beginGroup(GROUP_COMMON);
+    kcpFec = m_settings->value(COMMON_KCP_FEC_KEY, COMMON_KCP_FEC_DEF).toString().trimmed();
+    m_settings->endGroup();
+    if (kcpFec.isEmpty() || kcpFec == "0") {
+        return false;
+    }
+
+    // 格式 k:m，上限与 FecCodec.h 的 FEC_XOR_MAX_GROUP / FEC_RS_MAX_DATA / FEC_RS_MAX_PARITY 一致
+    const QStringList parts = kcpFec.split(':');
+    bool okK = false;
+    bool okM = false;
+    const int k = parts.size() == 2 ? parts[0].toInt(&okK) : 0;
+    const int m = parts.size() == 2 ? parts[1].toInt(&okM) : 0;
+    if (!okK || !okM || k < 1 || k > 64 || m < 1 || m > 16) {
+        qWarning() << "Invalid KcpFec" << kcpFec << "(expected k:m, k 1-64, m 1-16), KCP FEC disabled";
+        return false;
+    }
+    if (m == 1 && k > 32) {
+        qWarning() << "KcpFec" << kcpFec << "exceeds the XOR group limit, using k=32";
+    }
+    data = static_cast<quint8>(m == 1 ? qMin(k, 32) : k);
+    parity = static_cast<quint8>(m);
+    return true;
+}
+
+int Config::getMoveLaneCopies()
+{
+    int copies = COMMON_MOVE_LANE_COPIES_DEF;
+    m_settings->beginGroup(GROUP_COMMON);
+    copies = m_settings->value(COMMON_MOVE_LANE_COPIES_KEY, COMMON_MOVE_LANE_COPIES_DEF).toInt();
+    m_settings->endGroup();
+    return qBound(0, copies, 3);
+}
+
+bool Config::getMultipath()
+{
+    int multipath = COMMON_MULTIPATH_DEF;
+    m_settings->beginGroup(GROUP_COMMON);
+    multipath = m_settings->value(COMMON_MULTIPATH_KEY, COMMON_MULTIPATH_DEF).toInt();
+    m_settings->endGroup();
+    return multipath != 0;
+}
+
+bool Config::getMultipathDuplicate()
+{
+    int duplicate = COMMON_MULTIPATH_DUPLICATE_DEF;
+    m_settings->beginGroup(GROUP_COMMON);
+    duplicate = m_settings->value(COMMON_MULTIPATH_DUPLICATE_KEY, COMMON_MULTIPATH_DUPLICATE_DEF).toInt();
+    m_settings->endGroup();
+    return duplicate != 0;
+}
+
 QStringList Config::getConnectedGroups()
 {
     return m_userData->childGroups();
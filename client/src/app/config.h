@@ -73,6 +73,12 @@ public:
     QString getLogLevel();
     QString getCodecOptions();
     QString getCodecName();
+    bool getVideoFec();
+    // KCP 控制通道 FEC（KcpFec=k:m，m=1 为 XOR，m>1 为 Reed-Solomon），未配置返回 false
+    bool getKcpFec(quint8 &data, quint8 &parity);
+    int getMoveLaneCopies();
+    bool getMultipath();
+    bool getMultipathDuplicate();
     QStringList getConnectedGroups();
 
     // 读写用户配置 (userdata.ini) - 通用 / Read/write user config (userdata.ini) - general
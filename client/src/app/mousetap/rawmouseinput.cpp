@@ -0,0 +1,24 @@
+// rawmouseinput.cpp
+#include <QtGlobal>
+
+#include "rawmouseinput.h"
+#if defined(Q_OS_LINUX) && defined(QSC_HAVE_XCB_XINPUT)
+#include "xrawmouseinput.h"
+#endif
+
+// ---------------------------------------------------------
+// 根据操作系统创建对应的实现
+// Windows / macOS 暂无实现，Linux 构建时缺少 libxcb-xinput 也不编译 XInput2 后端，
+// 调用方继续使用光标回中方式
+// ---------------------------------------------------------
+RawMouseInput *RawMouseInput::create()
+{
+#if defined(Q_OS_LINUX) && defined(QSC_HAVE_XCB_XINPUT)
+    return new XRawMouseInput();
+#elif defined(Q_OS_LINUX)
+    qWarning("[RawMouse] Built without libxcb-xinput, falling back to cursor re-centering");
+    return Q_NULLPTR;
+#else
+    return Q_NULLPTR;
+#endif
+}
@@ -0,0 +1,40 @@
+// rawmouseinput.h
+#ifndef RAWMOUSEINPUT_H
+#define RAWMOUSEINPUT_H
+#include <QtGlobal>
+#include <functional>
+
+// ---------------------------------------------------------
+// 原始鼠标相对位移输入 (抽象类) / Raw relative mouse input (Abstract)
+// 在独立线程读取设备级相对位移（未经光标加速、不受窗口边界限制），
+// 游戏模式下替代"光标回中 + 读取偏移"的方式
+// Reads device-level relative motion on its own thread (no pointer
+// acceleration, not clipped to the window); replaces cursor warping in game mode
+// ---------------------------------------------------------
+class RawMouseInput
+{
+public:
+    // 一次相对位移 / One relative motion sample
+    struct Delta {
+        double dx = 0.0;
+        double dy = 0.0;
+        qint64 timestampUs = 0;     // 接收时刻（steady_clock 微秒）
+    };
+
+    // 在输入线程回调，一次交付一批 / Called on the input thread, one batch per wakeup
+    using DeltaCallback = std::function<void(const Delta *deltas, int count)>;
+
+    // 创建当前平台的实现；不支持的平台返回 nullptr
+    // Create the platform backend; returns nullptr where unsupported
+    static RawMouseInput *create();
+
+    virtual ~RawMouseInput() = default;
+
+    // 启动输入线程 / Start the input thread
+    virtual bool start(DeltaCallback callback) = 0;
+    // 停止并等待线程退出（可重复调用）/ Stop and join (idempotent)
+    virtual void stop() = 0;
+    virtual bool isRunning() const = 0;
+    virtual const char *backendName() const = 0;
+};
+#endif // RAWMOUSEINPUT_H
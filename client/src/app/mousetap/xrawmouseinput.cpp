@@ -0,0 +1,202 @@
+#include <QDebug>
+
+#include <xcb/xcb.h>
+#include <xcb/xinput.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <poll.h>
+#include <stdlib.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <vector>
+
+#include "xrawmouseinput.h"
+
+// 单次唤醒最多交付的位移数（8kHz 鼠标在一次调度延迟内通常只有几个）
+static constexpr int MAX_BATCH = 256;
+
+static double fp3232ToDouble(const xcb_input_fp3232_t &v)
+{
+    return v.integral + v.frac / 4294967296.0;
+}
+
+static qint64 steadyNowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+XRawMouseInput::XRawMouseInput() {}
+
+XRawMouseInput::~XRawMouseInput()
+{
+    stop();
+}
+
+bool XRawMouseInput::start(DeltaCallback callback)
+{
+    if (m_running.load()) {
+        return true;
+    }
+    stop();     // 线程因连接断开已自行退出时先回收
+
+    // 独立连接：不与 Qt 的 xcb 连接共享事件队列，也不需要 Qt 线程参与
+    int screenNum = 0;
+    xcb_connection_t *conn = xcb_connect(nullptr, &screenNum);
+    if (!conn || xcb_connection_has_error(conn)) {
+        qWarning("[RawMouse] cannot connect to X server");
+        if (conn) {
+            xcb_disconnect(conn);
+        }
+        return false;
+    }
+
+    const xcb_query_extension_reply_t *ext = xcb_get_extension_data(conn, &xcb_input_id);
+    if (!ext || !ext->present) {
+        qWarning("[RawMouse] XInputExtension not available");
+        xcb_disconnect(conn);
+        return false;
+    }
+    xcb_input_xi_query_version_reply_t *version = xcb_input_xi_query_version_reply(
+        conn, xcb_input_xi_query_version(conn, 2, 2), nullptr);
+    // 原始事件在抓取期间也投递到根窗口需要 XI 2.1+
+    const bool versionOk = version && (version->major_version > 2
+                                       || (version->major_version == 2 && version->minor_version >= 1));
+    free(version);
+    if (!versionOk) {
+        qWarning("[RawMouse] XInput 2.1+ required");
+        xcb_disconnect(conn);
+        return false;
+    }
+
+    xcb_screen_iterator_t it = xcb_setup_roots_iterator(xcb_get_setup(conn));
+    for (int i = 0; i < screenNum && it.rem; ++i) {
+        xcb_screen_next(&it);
+    }
+    if (!it.rem) {
+        xcb_disconnect(conn);
+        return false;
+    }
+
+    struct {
+        xcb_input_event_mask_t head;
+        uint32_t mask;
+    } eventMask;
+    eventMask.head.deviceid = XCB_INPUT_DEVICE_ALL_MASTER;
+    eventMask.head.mask_len = 1;
+    eventMask.mask = XCB_INPUT_XI_EVENT_MASK_RAW_MOTION;
+    xcb_generic_error_t *error = xcb_request_check(
+        conn, xcb_input_xi_select_events_checked(conn, it.data->root, 1, &eventMask.head));
+    if (error) {
+        qWarning("[RawMouse] XISelectEvents failed: %d", error->error_code);
+        free(error);
+        xcb_disconnect(conn);
+        return false;
+    }
+
+    m_wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_wakeFd < 0) {
+        qWarning("[RawMouse] eventfd failed: %s", strerror(errno));
+        xcb_disconnect(conn);
+        return false;
+    }
+
+    m_conn = conn;
+    m_xiOpcode = ext->major_opcode;
+    m_callback = std::move(callback);
+    m_running.store(true);
+    m_thread = std::thread(&XRawMouseInput::run, this);
+    qInfo("[RawMouse] XInput2 raw motion started");
+    return true;
+}
+
+void XRawMouseInput::stop()
+{
+    if (!m_thread.joinable()) {
+        return;
+    }
+    m_running.store(false);
+    const uint64_t one = 1;
+    ssize_t ret = ::write(m_wakeFd, &one, sizeof(one));
+    Q_UNUSED(ret);
+    m_thread.join();
+
+    ::close(m_wakeFd);
+    m_wakeFd = -1;
+    xcb_disconnect(m_conn);
+    m_conn = nullptr;
+    m_callback = nullptr;
+    qInfo("[RawMouse] XInput2 raw motion stopped");
+}
+
+void XRawMouseInput::run()
+{
+    std::vector<Delta> batch;
+    batch.reserve(MAX_BATCH);
+
+    pollfd fds[2];
+    fds[0].fd = xcb_get_file_descriptor(m_conn);
+    fds[0].events = POLLIN;
+    fds[1].fd = m_wakeFd;
+    fds[1].events = POLLIN;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        // 先取空 xcb 已缓冲的事件，再阻塞等待 socket
+        xcb_generic_event_t *event;
+        while ((event = xcb_poll_for_event(m_conn)) != nullptr) {
+            if ((event->response_type & 0x7f) == XCB_GE_GENERIC) {
+                auto *ge = reinterpret_cast<xcb_ge_generic_event_t *>(event);
+                if (ge->extension == m_xiOpcode && ge->event_type == XCB_INPUT_RAW_MOTION) {
+                    auto *raw = reinterpret_cast<xcb_input_raw_motion_event_t *>(event);
+                    const uint32_t *mask = xcb_input_raw_button_press_valuator_mask(raw);
+                    const int maskLen = xcb_input_raw_button_press_valuator_mask_length(raw);
+                    // axisvalues_raw：设备原始计数，未经指针加速
+                    const xcb_input_fp3232_t *values = xcb_input_raw_button_press_axisvalues_raw(raw);
+                    const int valueCount = xcb_input_raw_button_press_axisvalues_raw_length(raw);
+
+                    Delta delta;
+                    delta.timestampUs = steadyNowUs();
+                    int index = 0;
+                    for (int axis = 0; axis < maskLen * 32 && index < valueCount; ++axis) {
+                        if (!(mask[axis / 32] & (1u << (axis % 32)))) {
+                            continue;
+                        }
+                        // 轴 0/1 为相对 X/Y，其余（滚轮等）忽略
+                        if (axis == 0) {
+                            delta.dx = fp3232ToDouble(values[index]);
+                        } else if (axis == 1) {
+                            delta.dy = fp3232ToDouble(values[index]);
+                        }
+                        ++index;
+                    }
+                    if (delta.dx != 0.0 || delta.dy != 0.0) {
+                        batch.push_back(delta);
+                        if (static_cast<int>(batch.size()) >= MAX_BATCH) {
+                            m_callback(batch.data(), static_cast<int>(batch.size()));
+                            batch.clear();
+                        }
+                    }
+                }
+            }
+            free(event);
+        }
+        if (!batch.empty()) {
+            m_callback(batch.data(), static_cast<int>(batch.size()));
+            batch.clear();
+        }
+        if (xcb_connection_has_error(m_conn)) {
+            qWarning("[RawMouse] X connection lost");
+            break;
+        }
+
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (poll(fds, 2, -1) < 0 && errno != EINTR) {
+            qWarning("[RawMouse] poll failed: %s", strerror(errno));
+            break;
+        }
+    }
+    m_running.store(false);
+}
@@ -0,0 +1,40 @@
+#ifndef XRAWMOUSEINPUT_H
+#define XRAWMOUSEINPUT_H
+
+#include <atomic>
+#include <thread>
+
+#include "rawmouseinput.h"
+
+struct xcb_connection_t;
+
+// ---------------------------------------------------------
+// XInput2 原始移动事件实现 / XInput2 raw motion backend
+// 独立的 xcb 连接在根窗口上订阅 XI_RawMotion（所有主设备），
+// 原始事件不受指针抓取和窗口边界影响；线程用 poll 等待 xcb fd 与 eventfd
+// ---------------------------------------------------------
+class XRawMouseInput : public RawMouseInput
+{
+public:
+    XRawMouseInput();
+    ~XRawMouseInput() override;
+
+    bool start(DeltaCallback callback) override;
+    void stop() override;
+    bool isRunning() const override { return m_running.load(); }
+    const char *backendName() const override { return "XInput2"; }
+
+private:
+    void run();
+
+private:
+    xcb_connection_t *m_conn = nullptr;
+    quint8 m_xiOpcode = 0;
+    int m_wakeFd = -1;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    DeltaCallback m_callback;
+};
+
+#endif // XRAWMOUSEINPUT_H
@@ -0,0 +1,118 @@
+#include "ClockSync.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace qsc {
+
+int64_t ClockSync::nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ClockSync::addSample(int64_t clientSendUs, int64_t deviceRecvUs, int64_t deviceSendUs, int64_t clientRecvUs)
+{
+    const int64_t rtt = (clientRecvUs - clientSendUs) - (deviceSendUs - deviceRecvUs);
+    if (rtt < 0 || clientRecvUs < clientSendUs) {
+        return;
+    }
+
+    Sample sample;
+    sample.clientUs = clientSendUs + (clientRecvUs - clientSendUs) / 2;
+    sample.offsetUs = ((deviceRecvUs - clientSendUs) + (deviceSendUs - clientRecvUs)) / 2;
+    sample.rttUs = rtt;
+
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_samples[m_next] = sample;
+    m_next = (m_next + 1) % MAX_SAMPLES;
+    m_count = std::min(m_count + 1, MAX_SAMPLES);
+    m_estimate.lastRttUs = rtt;
+    refit();
+}
+
+void ClockSync::refit()
+{
+    // 按 RTT 选出最好的 1/4
+    Sample sorted[MAX_SAMPLES];
+    std::copy(m_samples, m_samples + m_count, sorted);
+    std::sort(sorted, sorted + m_count, [](const Sample &a, const Sample &b) {
+        return a.rttUs < b.rttUs;
+    });
+    const int selected = std::min(m_count, std::max(MIN_FIT_SAMPLES, m_count / 4));
+
+    m_estimate.valid = true;
+    m_estimate.samples = m_count;
+    m_estimate.minRttUs = sorted[0].rttUs;
+    m_estimate.offsetUs = sorted[0].offsetUs;
+    m_estimate.refClientUs = sorted[0].clientUs;
+    m_estimate.drift = 0.0;
+
+    if (selected < MIN_FIT_SAMPLES) {
+        return;
+    }
+    int64_t first = sorted[0].clientUs;
+    int64_t last = first;
+    for (int i = 1; i < selected; ++i) {
+        first = std::min(first, sorted[i].clientUs);
+        last = std::max(last, sorted[i].clientUs);
+    }
+    if (last - first < DRIFT_MIN_SPAN_US) {
+        return;
+    }
+
+    // 最小二乘：offset = a + drift × (t - 参考时刻)，参考时刻取均值避免大数相减丢精度
+    double meanX = 0.0, meanY = 0.0;
+    for (int i = 0; i < selected; ++i) {
+        meanX += static_cast<double>(sorted[i].clientUs - first);
+        meanY += static_cast<double>(sorted[i].offsetUs - sorted[0].offsetUs);
+    }
+    meanX /= selected;
+    meanY /= selected;
+    double num = 0.0, den = 0.0;
+    for (int i = 0; i < selected; ++i) {
+        const double dx = static_cast<double>(sorted[i].clientUs - first) - meanX;
+        const double dy = static_cast<double>(sorted[i].offsetUs - sorted[0].offsetUs) - meanY;
+        num += dx * dy;
+        den += dx * dx;
+    }
+    if (den <= 0.0) {
+        return;
+    }
+    m_estimate.drift = std::max(-MAX_DRIFT, std::min(MAX_DRIFT, num / den));
+    m_estimate.refClientUs = first + static_cast<int64_t>(meanX);
+    m_estimate.offsetUs = sorted[0].offsetUs + static_cast<int64_t>(meanY);
+}
+
+ClockSync::Estimate ClockSync::estimate() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return m_estimate;
+}
+
+bool ClockSync::isSynced() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return m_estimate.valid;
+}
+
+int64_t ClockSync::deviceToClientUs(int64_t deviceUs) const
+{
+    const Estimate e = estimate();
+    if (!e.valid) {
+        return deviceUs;
+    }
+    // client = device - (offset + drift × (client - ref))，解出 client
+    const double client = (static_cast<double>(deviceUs - e.offsetUs - e.refClientUs)) / (1.0 + e.drift);
+    return e.refClientUs + static_cast<int64_t>(client);
+}
+
+void ClockSync::reset()
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_count = 0;
+    m_next = 0;
+    m_estimate = Estimate();
+}
+
+} // namespace qsc
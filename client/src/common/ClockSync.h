@@ -0,0 +1,86 @@
+#ifndef CLOCKSYNC_H
+#define CLOCKSYNC_H
+
+#include <cstdint>
+#include <mutex>
+
+namespace qsc {
+
+/**
+ * @brief 客户端/设备时钟同步 / Client-device clock synchronization (NTP-style)
+ *
+ * 客户端经控制通道发送 PING(t0)，设备回 PONG(t0, t1 接收, t2 发送)，客户端收到时记 t3：
+ *   RTT    = (t3 - t0) - (t2 - t1)
+ *   offset = ((t1 - t0) + (t2 - t3)) / 2      （设备时钟 - 客户端时钟）
+ *
+ * 过滤 / Filtering:
+ * - 保留最近 MAX_SAMPLES 个样本，只取 RTT 最小的 1/4（至少 MIN_FIT_SAMPLES 个）：
+ *   排队越少的样本往返越对称，offset 误差上界为 RTT/2
+ * - 所选样本跨度 ≥ DRIFT_MIN_SPAN_US 后对所选样本做线性回归估计漂移（ppm），
+ *   否则漂移取 0、offset 取 RTT 最小的样本
+ *
+ * 两端时钟 / Clocks:
+ * - 客户端：nowUs()，单调时钟（steady_clock）
+ * - 设备端：System.nanoTime() / 1000，与 MediaCodec 输入 Surface 的 PTS 同为 CLOCK_MONOTONIC，
+ *   因此 deviceToClientUs(pts) 即该帧在客户端时钟下的采集时刻
+ *
+ * 线程安全：addSample 在控制通道线程调用，估计值可在任意线程（如视频 IO 线程）读取。
+ */
+class ClockSync
+{
+public:
+    static constexpr int MAX_SAMPLES = 64;
+    static constexpr int MIN_FIT_SAMPLES = 4;
+    static constexpr int64_t DRIFT_MIN_SPAN_US = 30 * 1000 * 1000;   // 30 秒
+    static constexpr double MAX_DRIFT = 500e-6;                        // 晶振漂移上限 500ppm
+
+    struct Estimate {
+        bool valid = false;
+        int64_t offsetUs = 0;       // refClientUs 时刻的 offset（设备 - 客户端）
+        double drift = 0.0;         // offset 每微秒变化量（0.000001 = 1ppm）
+        int64_t refClientUs = 0;
+        int64_t minRttUs = 0;       // 窗口内最小 RTT
+        int64_t lastRttUs = 0;
+        int samples = 0;
+    };
+
+    /**
+     * @brief 客户端单调时钟（微秒）
+     */
+    static int64_t nowUs();
+
+    /**
+     * @brief 加入一次 PING/PONG 交换；RTT 为负（时间戳异常）时丢弃
+     */
+    void addSample(int64_t clientSendUs, int64_t deviceRecvUs, int64_t deviceSendUs, int64_t clientRecvUs);
+
+    Estimate estimate() const;
+    bool isSynced() const;
+
+    /**
+     * @brief 设备时间（如视频 PTS）换算为客户端时间，未同步时原样返回
+     */
+    int64_t deviceToClientUs(int64_t deviceUs) const;
+
+    void reset();
+
+private:
+    void refit();
+
+private:
+    struct Sample {
+        int64_t clientUs;           // 交换中点（客户端时钟）
+        int64_t offsetUs;
+        int64_t rttUs;
+    };
+
+    mutable std::mutex m_mutex;
+    Sample m_samples[MAX_SAMPLES] = {};
+    int m_count = 0;
+    int m_next = 0;
+    Estimate m_estimate;
+};
+
+} // namespace qsc
+
+#endif // CLOCKSYNC_H
@@ -58,6 +58,15 @@ void ConfigCenter::registerDefaults()
     m_defaults["common/logLevel"] = "*:W";
     m_defaults["common/codecOptions"] = "";
     m_defaults["common/codecName"] = "";
+    m_defaults["common/RawMouseInput"] = 0;
+    m_defaults["common/InputThread"] = 0;
+    m_defaults["common/InputMacroRecord"] = "";
+    m_defaults["common/InputMacroReplay"] = "";
+    m_defaults["common/InputMacroSpeed"] = 1.0;
+    m_defaults["common/LatencyProbeTrials"] = 0;
+    m_defaults["common/LatencyProbeTouch"] = "0.5,0.5";
+    m_defaults["common/LatencyProbeRegion"] = "0.45,0.45,0.1,0.1";
+    m_defaults["common/LatencyProbeThreshold"] = 8;
 
     // 用户配置默认值
     m_defaults["user/recordPath"] = "";
@@ -223,6 +232,53 @@ QString ConfigCenter::adbPath() const { return get<QString>("common/adbPath", ""
 QString ConfigCenter::logLevel() const { return get<QString>("common/logLevel", "*:W"); }
 QString ConfigCenter::codecOptions() const { return get<QString>("common/codecOptions", ""); }
 QString ConfigCenter::codecName() const { return get<QString>("common/codecName", ""); }
+bool ConfigCenter::rawMouseInput() const { return get<int>("common/RawMouseInput", 0) != 0; }
+bool ConfigCenter::inputThread() const { return get<int>("common/InputThread", 0) != 0; }
+QString ConfigCenter::inputMacroRecordPath() const { return get<QString>("common/InputMacroRecord", ""); }
+QString ConfigCenter::inputMacroReplayPath() const { return get<QString>("common/InputMacroReplay", ""); }
+double ConfigCenter::inputMacroSpeed() const { return get<double>("common/InputMacroSpeed", 1.0); }
+int ConfigCenter::latencyProbeTrials() const { return qMax(0, get<int>("common/LatencyProbeTrials", 0)); }
+int ConfigCenter::latencyProbeThreshold() const { return qBound(1, get<int>("common/LatencyProbeThreshold", 8), 255); }
+bool ConfigCenter::groupControl() const { return get<int>("common/GroupControl", 0) != 0; }
+
+// 逗号分隔的小数列表；未加引号时 QSettings 会把 "a,b" 读成 QStringList
+static QList<double> realList(const QVariant& value)
+{
+    const QStringList parts = value.userType() == QMetaType::QStringList ? value.toStringList()
+                                                                       : value.toString().split(',');
+    QList<double> out;
+    for (const QString& part : parts) {
+        bool ok = false;
+        const double v = part.trimmed().toDouble(&ok);
+        if (!ok) {
+            return {};
+        }
+        out.append(v);
+    }
+    return out;
+}
+
+QPointF ConfigCenter::latencyProbeTouch() const
+{
+    const QList<double> v = realList(get("common/LatencyProbeTouch", QVariant(QStringLiteral("0.5,0.5"))));
+    if (v.size() != 2) {
+        qWarning("[ConfigCenter] Invalid LatencyProbeTouch, using 0.5,0.5");
+        return QPointF(0.5, 0.5);
+    }
+    return QPointF(qBound(0.0, v[0], 1.0), qBound(0.0, v[1], 1.0));
+}
+
+QRectF ConfigCenter::latencyProbeRegion() const
+{
+    const QList<double> v = realList(get("common/LatencyProbeRegion", QVariant(QStringLiteral("0.45,0.45,0.1,0.1"))));
+    const QRectF unit(0, 0, 1, 1);
+    const QRectF region = v.size() == 4 ? QRectF(v[0], v[1], v[2], v[3]).intersected(unit) : QRectF();
+    if (region.isEmpty()) {
+        qWarning("[ConfigCenter] Invalid LatencyProbeRegion, using 0.45,0.45,0.1,0.1");
+        return QRectF(0.45, 0.45, 0.1, 0.1);
+    }
+    return region;
+}
 
 // --- 用户配置快捷方法 ---
 QString ConfigCenter::recordPath() const { return get<QString>("user/recordPath", ""); }
@@ -322,6 +378,23 @@ void ConfigCenter::setKeyMap(const QString& serial, const QString& keyMapFile)
     set(deviceKey(serial, "keyMap"), keyMapFile);
 }
 
+QRectF ConfigCenter::groupCalibration(const QString& serial) const
+{
+    const QList<double> v = realList(get(deviceKey(serial, "groupCalibration"), QVariant(QStringLiteral("0,0,1,1"))));
+    const QRectF rect = v.size() == 4 ? QRectF(v[0], v[1], v[2], v[3]) : QRectF();
+    if (rect.isEmpty()) {
+        qWarning("[ConfigCenter] Invalid groupCalibration for %s, using 0,0,1,1", qPrintable(serial));
+        return QRectF(0, 0, 1, 1);
+    }
+    return rect;
+}
+
+void ConfigCenter::setGroupCalibration(const QString& serial, const QRectF& rect)
+{
+    set(deviceKey(serial, "groupCalibration"),
+        QString("%1,%2,%3,%4").arg(rect.x()).arg(rect.y()).arg(rect.width()).arg(rect.height()));
+}
+
 // --- 配置变更监听 ---
 int ConfigCenter::addChangeListener(const QString& key, ConfigChangeListener listener)
 {
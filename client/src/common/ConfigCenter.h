@@ -6,7 +6,9 @@
 #include <QRecursiveMutex>
 #include <QVariant>
 #include <QMap>
+#include <QPointF>
 #include <QRect>
+#include <QRectF>
 #include <QString>
 #include <functional>
 
@@ -67,6 +69,19 @@ public:
     QString logLevel() const;
     QString codecOptions() const;
     QString codecName() const;
+    bool rawMouseInput() const;
+    bool inputThread() const;
+    // 输入宏（回归测试用）：首帧后自动录制/回放，路径为空则关闭
+    QString inputMacroRecordPath() const;
+    QString inputMacroReplayPath() const;
+    double inputMacroSpeed() const;
+    // 点击→画面延迟探测：次数为 0 关闭；坐标与区域均为归一化值（0-1）
+    int latencyProbeTrials() const;
+    QPointF latencyProbeTouch() const;
+    QRectF latencyProbeRegion() const;
+    int latencyProbeThreshold() const;
+    // 群控：首台连接的设备为主控，之后连接的设备跟随其输入
+    bool groupControl() const;
 
     // --- 用户配置快捷方法 ---
     QString recordPath() const;
@@ -140,6 +155,10 @@ public:
     QString keyMap(const QString& serial) const;
     void setKeyMap(const QString& serial, const QString& keyMapFile);
 
+    // 群控校准：主控整个画面在该从设备画面中的归一化矩形（默认 0,0,1,1）
+    QRectF groupCalibration(const QString& serial) const;
+    void setGroupCalibration(const QString& serial, const QRectF& rect);
+
     // --- 配置变更监听 ---
     int addChangeListener(const QString& key, ConfigChangeListener listener);
     void removeChangeListener(int listenerId);
@@ -52,6 +52,31 @@ public:
      */
     virtual qsc::core::DeviceSession* getSession(const QString& serial) = 0;
 
+    /**
+     * @brief 开始群控：主控设备的触摸/按键输入同步发送到从设备（已有群控先停止）
+     * @param leader 主控设备序列号
+     * @param followers 从设备序列号（控制通道须线程安全，否则跳过）
+     * @return 主控未连接返回 false
+     */
+    virtual bool startGroupControl(const QString& leader, const QStringList& followers) = 0;
+
+    /**
+     * @brief 停止群控，从设备释放残留的触摸点
+     */
+    virtual void stopGroupControl() = 0;
+
+    /**
+     * @brief 群控进行中加入从设备
+     * @param serial 设备序列号
+     * @return 成功返回 true
+     */
+    virtual bool addGroupFollower(const QString& serial) = 0;
+
+    /**
+     * @brief 群控统计：每台从设备一行（发送数、延迟 P50/P99/max、积压、丢弃，落后设备标记 [straggler]）
+     */
+    virtual QString groupControlStats() = 0;
+
 signals:
     void deviceConnected(bool success, const QString& serial, const QString& deviceName, const QSize& size);
     void deviceDisconnected(QString serial);
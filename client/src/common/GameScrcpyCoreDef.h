@@ -34,6 +34,18 @@ struct DeviceParams {
 
     // KCP 视频/控制传输端口 (UDP) - WiFi 模式 / KCP video/control port (UDP) - WiFi mode
     quint16 kcpPort = 27185;
+    // KCP 控制通道 FEC (k:m)，0 = 关闭；m=1 为 XOR，m>1 为 Reed-Solomon / Control channel FEC, 0 = off
+    quint8 kcpFecData = 0;
+    quint8 kcpFecParity = 0;
+    // UDP 视频自适应 FEC（按丢包回报调整校验比例）/ Loss-adaptive FEC on the UDP video lane
+    bool videoFec = true;
+    // 触摸 MOVE 不可靠通道每条发送份数，0 = 关闭（全部走 KCP 可靠通道）/ Unreliable touch-move lane copies, 0 = off
+    quint8 moveLaneCopies = 2;
+    // USB 连接时设备的 WiFi 地址：非空则再开一条 WiFi KCP 控制通道，控制消息走实测最快的路径
+    // Device WiFi IP for a USB connection: non-empty opens a second WiFi KCP control path (multipath)
+    QString multipathIp = "";
+    // 多路径时 DOWN/UP 等关键消息在两条路径各发一份 / Send critical DOWN/UP on both paths
+    bool multipathDuplicate = true;
 
     // TCP 本地端口 - USB 模式 / TCP local port - USB mode
     quint16 localPort = 27183;
@@ -52,6 +52,20 @@ void PerformanceMonitor::reportFrameQueueDepth(int depth)
     m_metrics.frameQueueDepth = depth;
 }
 
+void PerformanceMonitor::reportCaptureLatency(double latencyMs)
+{
+    m_captureLatency.addSample(latencyMs);
+}
+
+void PerformanceMonitor::reportClickToPhoton(qint64 latencyUs, bool timedOut)
+{
+    if (timedOut) {
+        m_metrics.clickToPhotonTimeouts++;
+        return;
+    }
+    m_clickToPhotonHist.addSample(latencyUs);
+}
+
 // === 网络指标报告 ===
 
 void PerformanceMonitor::reportNetworkLatency(double latencyMs)
@@ -79,6 +93,13 @@ void PerformanceMonitor::reportKcpRetransmit()
     m_metrics.kcpRetransmits++;
 }
 
+void PerformanceMonitor::reportClockSync(double offsetMs, double driftPpm)
+{
+    m_metrics.clockOffsetMs = offsetMs;
+    m_metrics.clockDriftPpm = driftPpm;
+    m_metrics.clockSynced = true;
+}
+
 // === 输入指标报告 ===
 
 void PerformanceMonitor::reportInputLatency(double latencyMs)
@@ -96,6 +117,14 @@ void PerformanceMonitor::reportInputDropped()
     m_metrics.inputEventsDropped++;
 }
 
+void PerformanceMonitor::reportInputToWire(qint64 queueUs, qint64 totalUs)
+{
+    m_inputQueueHist.addSample(queueUs);
+    m_inputToWireHist.addSample(totalUs);
+    m_inputLatency.addSample(totalUs / 1000.0);
+    m_metrics.inputEventsProcessed++;
+}
+
 // === 内存指标报告 ===
 
 void PerformanceMonitor::reportFramePoolUsage(int used, int total)
@@ -112,7 +141,13 @@ PerformanceMetrics PerformanceMonitor::currentMetrics() const
     m.avgDecodeLatencyMs = m_decodeLatency.average();
     m.avgRenderLatencyMs = m_renderLatency.average();
     m.networkLatencyMs = m_networkLatency.average();
+    m.captureLatencyMs = m_captureLatency.average();
     m.avgInputLatencyMs = m_inputLatency.average();
+    m.inputToWireP50Ms = m_inputToWireHist.percentileUs(0.50) / 1000.0;
+    m.inputToWireP99Ms = m_inputToWireHist.percentileUs(0.99) / 1000.0;
+    m.clickToPhotonP50Ms = m_clickToPhotonHist.percentileUs(0.50) / 1000.0;
+    m.clickToPhotonP99Ms = m_clickToPhotonHist.percentileUs(0.99) / 1000.0;
+    m.clickToPhotonSamples = m_clickToPhotonHist.count();
     return m;
 }
 
@@ -153,7 +188,11 @@ void PerformanceMonitor::reset()
     m_decodeLatency.reset();
     m_renderLatency.reset();
     m_networkLatency.reset();
+    m_captureLatency.reset();
     m_inputLatency.reset();
+    m_inputQueueHist.reset();
+    m_inputToWireHist.reset();
+    m_clickToPhotonHist.reset();
 }
 
 // === 格式化输出 ===
@@ -180,18 +219,20 @@ QString PerformanceMonitor::formatDetailed() const
         "总帧数: %4\n"
         "丢帧数: %5 (%6%)\n"
         "帧队列深度: %7\n"
+        "点击→画面: P50 %8 ms / P99 %9 ms (%10 次, 超时 %11)\n"
         "\n=== 网络 ===\n"
-        "延迟: %8 ms\n"
-        "发送: %9 KB\n"
-        "接收: %10 KB\n"
-        "待发送: %11 bytes\n"
-        "KCP重传: %12\n"
+        "延迟: %12 ms\n"
+        "发送: %13 KB\n"
+        "接收: %14 KB\n"
+        "待发送: %15 bytes\n"
+        "KCP重传: %16\n"
         "\n=== 输入 ===\n"
-        "延迟: %13 ms (avg)\n"
-        "已处理: %14\n"
-        "已丢弃: %15\n"
+        "延迟: %17 ms (avg)\n"
+        "已处理: %18\n"
+        "已丢弃: %19\n"
+        "输入→发出: P50 %20 ms / P99 %21 ms\n"
         "\n=== 帧池 ===\n"
-        "使用: %16 / %17"
+        "使用: %22 / %23"
     )
     .arg(m.fps)
     .arg(m.avgDecodeLatencyMs, 0, 'f', 2)
@@ -200,6 +241,10 @@ QString PerformanceMonitor::formatDetailed() const
     .arg(m.droppedFrames)
     .arg(m.totalFrames > 0 ? 100.0 * m.droppedFrames / m.totalFrames : 0, 0, 'f', 2)
     .arg(m.frameQueueDepth)
+    .arg(m.clickToPhotonP50Ms, 0, 'f', 1)
+    .arg(m.clickToPhotonP99Ms, 0, 'f', 1)
+    .arg(m.clickToPhotonSamples)
+    .arg(m.clickToPhotonTimeouts)
     .arg(m.networkLatencyMs, 0, 'f', 2)
     .arg(m.bytesSent / 1024.0, 0, 'f', 1)
     .arg(m.bytesReceived / 1024.0, 0, 'f', 1)
@@ -208,8 +253,39 @@ QString PerformanceMonitor::formatDetailed() const
     .arg(m.avgInputLatencyMs, 0, 'f', 2)
     .arg(m.inputEventsProcessed)
     .arg(m.inputEventsDropped)
+    .arg(m.inputToWireP50Ms, 0, 'f', 2)
+    .arg(m.inputToWireP99Ms, 0, 'f', 2)
     .arg(m.framePoolUsed)
     .arg(m.framePoolTotal);
 }
 
+QString PerformanceMonitor::formatInputHistogram() const
+{
+    // 每行一个非空桶：上界、样本数、累计百分比；两条直方图并排便于区分排队与分发/发送耗时
+    const quint64 total = m_inputToWireHist.count();
+    if (total == 0) {
+        return QString("输入→发出: 无样本");
+    }
+    QString out = QString("输入→发出直方图 (%1 个样本, avg %2 us, max %3 us)\n"
+                          "  <=us        排队   入队→发出   累计%\n")
+                      .arg(total)
+                      .arg(m_inputToWireHist.averageUs(), 0, 'f', 1)
+                      .arg(m_inputToWireHist.maxUs());
+    quint64 seen = 0;
+    for (int i = 0; i < LatencyHistogram::BUCKETS; ++i) {
+        const quint64 queued = m_inputQueueHist.bucket(i);
+        const quint64 wire = m_inputToWireHist.bucket(i);
+        if (queued == 0 && wire == 0) {
+            continue;
+        }
+        seen += wire;
+        out += QString("  %1 %2 %3 %4\n")
+                   .arg(LatencyHistogram::bucketUpperUs(i), 8)
+                   .arg(queued, 10)
+                   .arg(wire, 11)
+                   .arg(100.0 * seen / total, 7, 'f', 2);
+    }
+    return out;
+}
+
 } // namespace qsc
@@ -19,9 +19,17 @@ struct PerformanceMetrics {
     quint64 totalFrames = 0;            // 总帧数 / Total frames
     quint64 droppedFrames = 0;          // 丢帧数 / Dropped frames
     int frameQueueDepth = 0;            // 帧队列深度 / Frame queue depth
+    double captureLatencyMs = 0;        // 采集→接收延迟 (ms，由 PTS 和时钟同步推算) / Capture-to-receive latency (ms)
+    double clickToPhotonP50Ms = 0;      // 点击→画面变化 P50 (ms，延迟探测模式) / Click-to-photon P50 (ms, latency probe)
+    double clickToPhotonP99Ms = 0;      // 点击→画面变化 P99 (ms) / Click-to-photon P99 (ms)
+    quint64 clickToPhotonSamples = 0;   // 点击→画面样本数 / Click-to-photon samples
+    quint64 clickToPhotonTimeouts = 0;  // 点击后画面未变化的次数 / Click-to-photon trials without a change
 
     // 网络指标 / Network metrics
-    double networkLatencyMs = 0;        // 网络延迟 (ms) / Network latency (ms)
+    double networkLatencyMs = 0;        // 网络单向延迟 (ms，RTT/2) / Network one-way latency (ms, RTT/2)
+    double clockOffsetMs = 0;           // 设备时钟 - 客户端时钟 (ms) / Device minus client clock (ms)
+    double clockDriftPpm = 0;           // 时钟漂移 (ppm) / Clock drift (ppm)
+    bool clockSynced = false;           // 时钟同步是否有效 / Whether the clock estimate is valid
     quint64 bytesSent = 0;              // 发送字节数 / Bytes sent
     quint64 bytesReceived = 0;          // 接收字节数 / Bytes received
     int pendingBytes = 0;               // 待发送字节数 / Pending bytes
@@ -31,6 +39,8 @@ struct PerformanceMetrics {
     double avgInputLatencyMs = 0;       // 平均输入延迟 (ms) / Average input latency (ms)
     quint64 inputEventsProcessed = 0;   // 已处理输入事件数 / Input events processed
     quint64 inputEventsDropped = 0;     // 丢弃的输入事件数 / Input events dropped
+    double inputToWireP50Ms = 0;        // 输入→写入控制通道 P50 (ms，输入线程模式) / Input-to-wire P50 (ms, input thread mode)
+    double inputToWireP99Ms = 0;        // 输入→写入控制通道 P99 (ms) / Input-to-wire P99 (ms)
 
     // 内存指标 / Memory metrics
     quint64 memoryUsageBytes = 0;       // 内存使用 (字节) / Memory usage (bytes)
@@ -107,6 +117,72 @@ private:
     int m_windowSize;
 };
 
+/**
+ * @brief 无锁对数分桶延迟直方图 / Lock-free log2-bucketed latency histogram
+ *
+ * 桶 0 统计 [0, 2) us，桶 i 统计 [2^i, 2^(i+1)) us，最后一桶收纳更大的值。
+ * addSample 只有原子加，可在任意线程调用；百分位取所在桶的上界（2 倍精度），
+ * 用于观察尾延迟分布而不是精确值。
+ */
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS = 24;          // 最后一桶 ≥ 2^23 us ≈ 8.4 s
+
+    void addSample(qint64 us) {
+        if (us < 0) us = 0;
+        m_buckets[bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_totalUs.fetch_add(static_cast<quint64>(us), std::memory_order_relaxed);
+        qint64 cur = m_maxUs.load(std::memory_order_relaxed);
+        while (us > cur && !m_maxUs.compare_exchange_weak(cur, us, std::memory_order_relaxed)) {}
+    }
+
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+    quint64 bucket(int i) const { return m_buckets[i].load(std::memory_order_relaxed); }
+    qint64 maxUs() const { return m_maxUs.load(std::memory_order_relaxed); }
+    static qint64 bucketUpperUs(int i) { return qint64(2) << i; }
+
+    double averageUs() const {
+        const quint64 n = count();
+        return n ? static_cast<double>(m_totalUs.load(std::memory_order_relaxed)) / n : 0;
+    }
+
+    // p ∈ (0, 1]，返回所在桶上界（不超过已记录的最大值）
+    qint64 percentileUs(double p) const {
+        const quint64 n = count();
+        if (n == 0) return 0;
+        quint64 rank = static_cast<quint64>(p * n + 0.5);
+        if (rank == 0) rank = 1;
+        quint64 seen = 0;
+        for (int i = 0; i < BUCKETS; ++i) {
+            seen += bucket(i);
+            if (seen >= rank) {
+                return qMin(bucketUpperUs(i), maxUs());
+            }
+        }
+        return maxUs();
+    }
+
+    void reset() {
+        for (auto& b : m_buckets) b.store(0, std::memory_order_relaxed);
+        m_count.store(0, std::memory_order_relaxed);
+        m_totalUs.store(0, std::memory_order_relaxed);
+        m_maxUs.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static int bucketOf(qint64 us) {
+        int b = 0;
+        while (b < BUCKETS - 1 && us >= (qint64(2) << b)) ++b;
+        return b;
+    }
+
+    std::atomic<quint64> m_buckets[BUCKETS] = {};
+    std::atomic<quint64> m_count{0};
+    std::atomic<quint64> m_totalUs{0};
+    std::atomic<qint64> m_maxUs{0};
+};
+
 /**
  * @brief 性能监控器 (单例)
  *
@@ -135,6 +211,9 @@ public:
     void reportFrameDecoded();
     void reportFrameDropped();
     void reportFrameQueueDepth(int depth);
+    void reportCaptureLatency(double latencyMs);
+    // 延迟探测：触摸写出→区域亮度变化的帧解码完成；timedOut 表示超时未检测到变化
+    void reportClickToPhoton(qint64 latencyUs, bool timedOut);
 
     // === 网络指标报告 ===
     void reportNetworkLatency(double latencyMs);
@@ -142,17 +221,23 @@ public:
     void reportBytesReceived(quint64 bytes);
     void reportPendingBytes(int bytes);
     void reportKcpRetransmit();
+    void reportClockSync(double offsetMs, double driftPpm);
 
     // === 输入指标报告 ===
     void reportInputLatency(double latencyMs);
     void reportInputProcessed();
     void reportInputDropped();
+    // 输入线程：queueUs 为入队→开始分发，totalUs 为入队→写入控制通道
+    void reportInputToWire(qint64 queueUs, qint64 totalUs);
 
     // === 内存指标报告 ===
     void reportFramePoolUsage(int used, int total);
 
     // === 获取当前指标 ===
     PerformanceMetrics currentMetrics() const;
+    const LatencyHistogram& inputQueueHistogram() const { return m_inputQueueHist; }
+    const LatencyHistogram& inputToWireHistogram() const { return m_inputToWireHist; }
+    const LatencyHistogram& clickToPhotonHistogram() const { return m_clickToPhotonHist; }
 
     // === 控制 ===
     void setEnabled(bool enabled);
@@ -162,6 +247,7 @@ public:
     // === 格式化输出 ===
     QString formatSummary() const;
     QString formatDetailed() const;
+    QString formatInputHistogram() const;
 
 signals:
     void metricsUpdated(const PerformanceMetrics& metrics);
@@ -178,7 +264,11 @@ private:
     LatencyTracker m_decodeLatency{60};
     LatencyTracker m_renderLatency{60};
     LatencyTracker m_networkLatency{60};
+    LatencyTracker m_captureLatency{60};
     LatencyTracker m_inputLatency{60};
+    LatencyHistogram m_inputQueueHist;
+    LatencyHistogram m_inputToWireHist;
+    LatencyHistogram m_clickToPhotonHist;
 
     QTimer* m_updateTimer = nullptr;
     bool m_enabled = false;
@@ -0,0 +1,282 @@
+#include "PreciseTimer.h"
+
+#include <QtGlobal>
+#include <QDebug>
+#include <QMetaObject>
+#include <algorithm>
+#include <chrono>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <ctime>
+#include <pthread.h>
+#include <sys/prctl.h>
+#endif
+
+#ifdef Q_OS_WIN
+#include <qt_windows.h>  // Windows 基础类型（UINT, DWORD 等），timeapi.h 依赖
+#include <timeapi.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002    // 旧版 SDK 未定义
+#endif
+#endif
+
+namespace qsc {
+
+// 调度线程定时器松弛（20µs；内核默认 50µs，显式设置同时防止继承到更大的值）
+static constexpr unsigned long SCHEDULER_TIMER_SLACK_NS = 20000;
+
+#ifdef Q_OS_WIN
+/**
+ * @brief 每线程一个可等待定时器（调度线程与脚本线程都会调用 sleepUntilNs）
+ *
+ * 优先创建高精度定时器，系统不支持时（Win10 1803 之前）退回普通定时器并加大自旋段。
+ */
+struct ThreadWaitableTimer
+{
+    HANDLE handle = nullptr;
+    bool highResolution = false;
+
+    ThreadWaitableTimer()
+    {
+        handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        highResolution = handle != nullptr;
+        if (!handle) {
+            handle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        }
+    }
+    ~ThreadWaitableTimer()
+    {
+        if (handle) CloseHandle(handle);
+    }
+};
+
+static ThreadWaitableTimer &threadWaitableTimer()
+{
+    static thread_local ThreadWaitableTimer timer;
+    return timer;
+}
+#endif
+
+// ---------------------------------------------------------
+// PreciseScheduler
+// ---------------------------------------------------------
+
+PreciseScheduler &PreciseScheduler::instance()
+{
+    // 进程级单例，不析构（调度线程在进程退出前一直休眠在条件变量上）
+    static PreciseScheduler *scheduler = new PreciseScheduler();
+    return *scheduler;
+}
+
+PreciseScheduler::PreciseScheduler()
+    : m_baseNs(nowNs())
+    , m_wheel(0)
+{
+#ifdef Q_OS_WIN
+    // Windows 默认定时器精度 15.6ms，条件变量等待及普通定时器回退路径依赖 1ms 精度
+    timeBeginPeriod(1);
+#endif
+    m_thread = std::thread([this]() { run(); });
+    m_thread.detach();
+}
+
+int64_t PreciseScheduler::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void PreciseScheduler::sleepUntilNs(int64_t deadlineNs)
+{
+#ifdef Q_OS_WIN
+    ThreadWaitableTimer &waitable = threadWaitableTimer();
+    const int spinUs = waitable.highResolution ? SPIN_US : SPIN_FALLBACK_US;
+#else
+    const int spinUs = SPIN_US;
+#endif
+    const int64_t sleepUntil = deadlineNs - static_cast<int64_t>(spinUs) * 1000;
+    const int64_t now = nowNs();
+    if (now < sleepUntil) {
+#ifdef Q_OS_LINUX
+        // steady_clock 即 CLOCK_MONOTONIC，绝对时间睡眠不受被信号打断影响
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(sleepUntil / 1000000000);
+        ts.tv_nsec = static_cast<long>(sleepUntil % 1000000000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+#elif defined(Q_OS_WIN)
+        // 可等待定时器的绝对时间基于系统时钟，与 steady_clock 不同源，这里用相对时间（负值，100ns 单位）
+        LARGE_INTEGER due;
+        due.QuadPart = -((sleepUntil - now) / 100);
+        if (waitable.handle && SetWaitableTimerEx(waitable.handle, &due, 0, nullptr, nullptr, nullptr, 0)) {
+            WaitForSingleObject(waitable.handle, INFINITE);
+        } else {
+            std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(sleepUntil)));
+        }
+#else
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(sleepUntil)));
+#endif
+    }
+    // 最后一段自旋，消除睡眠唤醒的调度抖动
+    while (nowNs() < deadlineNs) {
+        std::this_thread::yield();
+    }
+}
+
+void PreciseScheduler::schedule(Entry *entry, int64_t deadlineNs, uint64_t generation)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Due &due : m_due) {
+            if (due.entry == entry) due.entry = nullptr;
+        }
+        if (m_wheel.size() == 0) {
+            m_wheel.advance(toTick(nowNs()), [](TimerWheel::Node *) {});  // 空闲后同步轮时间
+        }
+        entry->deadlineNs = deadlineNs;
+        entry->generation = generation;
+        m_wheel.schedule(&entry->node, toTick(deadlineNs));
+    }
+    m_cond.notify_one();
+}
+
+void PreciseScheduler::cancel(Entry *entry)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wheel.cancel(&entry->node);
+    for (Due &due : m_due) {
+        if (due.entry == entry) due.entry = nullptr;
+    }
+}
+
+void PreciseScheduler::run()
+{
+#ifdef Q_OS_LINUX
+    pthread_setname_np(pthread_self(), "precise-timer");
+    ::prctl(PR_SET_TIMERSLACK, SCHEDULER_TIMER_SLACK_NS, 0, 0, 0);
+#endif
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        // 取出已进入当前毫秒的节点，按精确截止时间依次等待并投递
+        m_due.clear();
+        m_wheel.advance(toTick(nowNs()), [this](TimerWheel::Node *node) {
+            Entry *entry = reinterpret_cast<Entry *>(node);
+            m_due.push_back({entry, entry->deadlineNs, entry->generation});
+        });
+        if (!m_due.empty()) {
+            std::sort(m_due.begin(), m_due.end(), [](const Due &a, const Due &b) {
+                return a.deadlineNs < b.deadlineNs;
+            });
+            for (size_t i = 0; i < m_due.size(); ++i) {
+                const int64_t deadlineNs = m_due[i].deadlineNs;
+                if (nowNs() < deadlineNs) {
+                    lock.unlock();
+                    sleepUntilNs(deadlineNs);
+                    lock.lock();
+                }
+                // 等待期间可能已被 stop / 重新 start / 析构
+                const Due due = m_due[i];
+                if (!due.entry) continue;
+
+                const int64_t now = nowNs();
+                m_wakeError.addSample((now - due.deadlineNs) / 1000);
+                // 持锁投递：定时器析构先 cancel（等待本锁），投递后 QObject 析构会丢弃未处理的事件
+                PreciseTimer *timer = due.entry->timer;
+                const uint64_t generation = due.generation;
+                QMetaObject::invokeMethod(timer, [timer, generation, deadlineNs]() {
+                    timer->fire(generation, deadlineNs);
+                }, Qt::QueuedConnection);
+            }
+            m_due.clear();
+            continue;   // 处理期间时间已推进，重新检查
+        }
+
+        const uint64_t next = m_wheel.nextExpiry();
+        if (next == TimerWheel::NO_EXPIRY) {
+            m_cond.wait(lock);
+        } else {
+            const int64_t wakeNs = m_baseNs + static_cast<int64_t>(next) * 1000000;
+            m_cond.wait_until(lock, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(wakeNs)));
+        }
+    }
+}
+
+QString PreciseScheduler::stats() const
+{
+    return QString("fires=%1,wake_p50=%2us,wake_p99=%3us,fire_p50=%4us,fire_p99=%5us,fire_max=%6us")
+        .arg(m_fireError.count())
+        .arg(m_wakeError.percentileUs(0.50))
+        .arg(m_wakeError.percentileUs(0.99))
+        .arg(m_fireError.percentileUs(0.50))
+        .arg(m_fireError.percentileUs(0.99))
+        .arg(m_fireError.maxUs());
+}
+
+// ---------------------------------------------------------
+// PreciseTimer
+// ---------------------------------------------------------
+
+PreciseTimer::PreciseTimer(QObject *parent)
+    : QObject(parent)
+{
+    m_entry.timer = this;
+}
+
+PreciseTimer::~PreciseTimer()
+{
+    // 必须在 QObject 析构前摘除，调度线程不会再向本对象投递
+    PreciseScheduler::instance().cancel(&m_entry);
+}
+
+void PreciseTimer::start()
+{
+    startUs(m_intervalUs);
+}
+
+void PreciseTimer::start(int ms)
+{
+    setInterval(ms);
+    start();
+}
+
+void PreciseTimer::startUs(int64_t us)
+{
+    m_intervalUs = qMax<int64_t>(us, 0);
+    arm(PreciseScheduler::nowNs() + m_intervalUs * 1000);
+}
+
+void PreciseTimer::stop()
+{
+    if (!m_active) return;
+    m_active = false;
+    ++m_generation;     // 已投递但未执行的回调作废
+    PreciseScheduler::instance().cancel(&m_entry);
+}
+
+void PreciseTimer::arm(int64_t deadlineNs)
+{
+    m_active = true;
+    PreciseScheduler::instance().schedule(&m_entry, deadlineNs, ++m_generation);
+}
+
+void PreciseTimer::fire(uint64_t generation, int64_t deadlineNs)
+{
+    if (!m_active || generation != m_generation) return;
+
+    m_lastErrorUs = (PreciseScheduler::nowNs() - deadlineNs) / 1000;
+    PreciseScheduler::instance().fireError().addSample(m_lastErrorUs);
+
+    if (m_singleShot) {
+        m_active = false;
+    } else {
+        // 按截止时间累加；落后超过一个周期时从当前时间重新计
+        int64_t next = deadlineNs + m_intervalUs * 1000;
+        const int64_t now = PreciseScheduler::nowNs();
+        if (next <= now) next = now + m_intervalUs * 1000;
+        arm(next);
+    }
+    emit timeout();
+}
+
+} // namespace qsc
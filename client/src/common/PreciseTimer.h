@@ -0,0 +1,142 @@
+#ifndef PRECISETIMER_H
+#define PRECISETIMER_H
+
+#include <QObject>
+#include <QString>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TimerWheel.h"
+#include "PerformanceMonitor.h"
+
+namespace qsc {
+
+class PreciseTimer;
+
+/**
+ * @brief 高精度定时调度器 / High-resolution scheduler for input handler timers
+ *
+ * QTimer 为毫秒粒度，到期检查又依赖所属线程的事件循环，配置 5ms 的首按延迟在界面繁忙时
+ * 可能 15ms 才触发。本调度器为进程内所有 PreciseTimer 提供单一调度线程：
+ * - 截止时间按毫秒挂入分层时间轮（qsc::TimerWheel），同时保留纳秒精确值
+ * - 空闲时在条件变量上等到最近一个毫秒槽，进入该毫秒后睡到截止前 SPIN_US，最后自旋到截止时间
+ *   （Linux 为 clock_nanosleep 绝对时间；Windows 为高精度可等待定时器）
+ * - 到期后把回调投递回定时器所属线程（输入线程模式下为空闲的输入线程，几乎无排队）
+ * - 统计 调度线程唤醒误差 与 回调实际执行误差（执行时刻 - 请求的截止时刻）
+ *
+ * 进程级单例，调度线程常驻；schedule/cancel 可在任意线程调用（内部加锁）。
+ */
+class PreciseScheduler
+{
+public:
+#ifdef Q_OS_WIN
+    static constexpr int SPIN_US = 50;              // 高精度可等待定时器（Win10 1803+）唤醒误差在数十微秒内
+    static constexpr int SPIN_FALLBACK_US = 1500;   // 不支持高精度定时器时按 1ms 粒度（timeBeginPeriod(1)）
+#else
+    static constexpr int SPIN_US = 200;
+#endif
+
+    /**
+     * @brief 定时节点（嵌入 PreciseTimer，只在调度器锁内访问）
+     */
+    struct Entry {
+        TimerWheel::Node node;          // 必须为首成员（由节点指针还原 Entry）
+        PreciseTimer *timer = nullptr;
+        int64_t deadlineNs = 0;
+        uint64_t generation = 0;
+    };
+
+    static PreciseScheduler &instance();
+
+    void schedule(Entry *entry, int64_t deadlineNs, uint64_t generation);
+    void cancel(Entry *entry);
+
+    /**
+     * @brief 阻塞调用线程直到绝对时间 deadlineNs（睡眠 + 最后 SPIN_US 自旋）
+     *
+     * 自旋只为消除最后一段唤醒抖动；长时间等待应由调用方先普通睡眠，临近截止时再调用本函数。
+     */
+    static void sleepUntilNs(int64_t deadlineNs);
+
+    // 单调时钟纳秒（与 ClockSync::nowUs 同源）
+    static int64_t nowNs();
+
+    // 唤醒误差：调度线程投递时刻 - 截止时刻；执行误差：回调开始执行时刻 - 截止时刻
+    LatencyHistogram &wakeError() { return m_wakeError; }
+    LatencyHistogram &fireError() { return m_fireError; }
+    QString stats() const;
+
+private:
+    PreciseScheduler();
+    void run();
+    uint64_t toTick(int64_t ns) const { return ns > m_baseNs ? static_cast<uint64_t>((ns - m_baseNs) / 1000000) : 0; }
+
+    struct Due {
+        Entry *entry;                   // cancel/重新 schedule 时置空
+        int64_t deadlineNs;
+        uint64_t generation;
+    };
+
+private:
+    const int64_t m_baseNs;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    TimerWheel m_wheel;
+    std::vector<Due> m_due;             // 当前毫秒内待精确等待的节点（按截止时间排序）
+    std::thread m_thread;
+
+    LatencyHistogram m_wakeError;
+    LatencyHistogram m_fireError;
+};
+
+/**
+ * @brief 高精度定时器 / QTimer-compatible timer backed by PreciseScheduler
+ *
+ * 接口与 Handler 用到的 QTimer 子集一致（setSingleShot/setInterval/start/stop/isActive），
+ * 另提供微秒间隔的 startUs()。timeout 在所属线程发出；start/stop 只能在所属线程调用。
+ * 重复模式按截止时间累加，不随回调耗时漂移。
+ */
+class PreciseTimer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PreciseTimer(QObject *parent = nullptr);
+    ~PreciseTimer() override;
+
+    void setSingleShot(bool singleShot) { m_singleShot = singleShot; }
+    bool isSingleShot() const { return m_singleShot; }
+    void setInterval(int ms) { m_intervalUs = static_cast<int64_t>(ms) * 1000; }
+    int interval() const { return static_cast<int>(m_intervalUs / 1000); }
+    bool isActive() const { return m_active; }
+
+    void start();
+    void start(int ms);
+    void startUs(int64_t us);
+    void stop();
+
+    // 最近一次触发的执行误差（us）
+    qint64 lastErrorUs() const { return m_lastErrorUs; }
+
+signals:
+    void timeout();
+
+private:
+    friend class PreciseScheduler;
+    void arm(int64_t deadlineNs);
+    void fire(uint64_t generation, int64_t deadlineNs);
+
+private:
+    PreciseScheduler::Entry m_entry;
+    int64_t m_intervalUs = 0;
+    uint64_t m_generation = 0;
+    bool m_singleShot = false;
+    bool m_active = false;
+    qint64 m_lastErrorUs = 0;
+};
+
+} // namespace qsc
+
+#endif // PRECISETIMER_H
@@ -0,0 +1,187 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <cstdint>
+#include <limits>
+
+namespace qsc {
+
+/**
+ * @brief 分层时间轮 / Hierarchical Timer Wheel
+ *
+ * 按毫秒 tick 推进的 4 层 × 64 槽时间轮（覆盖 2^24 ms ≈ 4.6 小时），
+ * 插入/删除 O(1)，推进时高层槽位逐级下放（cascade）。
+ * 4-level x 64-slot wheel ticking in milliseconds; O(1) schedule/cancel.
+ *
+ * 节点侵入式嵌入调用方对象，时间轮本身不分配内存。
+ * 非线程安全：只能在单一线程（事件循环/IO 线程）中使用。
+ */
+class TimerWheel
+{
+public:
+    /**
+     * @brief 定时节点（嵌入调用方对象，调用方保证在 cancel 前存活）
+     */
+    struct Node {
+        Node *prev = nullptr;
+        Node *next = nullptr;
+        uint64_t expire = 0;
+        bool linked() const { return prev != nullptr; }
+    };
+
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr uint64_t NO_EXPIRY = std::numeric_limits<uint64_t>::max();
+
+    explicit TimerWheel(uint64_t nowMs = 0)
+        : m_current(nowMs)
+    {
+        for (auto &level : m_slots) {
+            for (auto &slot : level) {
+                slot.prev = slot.next = &slot;
+            }
+        }
+    }
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    uint64_t current() const { return m_current; }
+    int size() const { return m_count; }
+
+    /**
+     * @brief 设置/重设定时（已过期的时间在下一次 advance 中触发）
+     */
+    void schedule(Node *node, uint64_t expireMs)
+    {
+        cancel(node);
+        node->expire = expireMs < m_current ? m_current : expireMs;
+        link(node);
+    }
+
+    void cancel(Node *node)
+    {
+        if (!node->linked()) return;
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        node->prev = node->next = nullptr;
+        m_count--;
+    }
+
+    /**
+     * @brief 推进到 nowMs，依次回调所有到期节点
+     *
+     * 回调前节点已摘除，回调内可以重新 schedule 自身或 cancel 其他节点。
+     */
+    template<typename Fn>
+    void advance(uint64_t nowMs, Fn &&onExpire)
+    {
+        while (m_current <= nowMs) {
+            // 空轮直接跳到目标时间，避免长时间空闲后逐 tick 追赶
+            if (m_count == 0) {
+                m_current = nowMs;
+                return;
+            }
+            const int index = static_cast<int>(m_current & (SLOTS - 1));
+            // 进入新一轮时把上层当前槽下放
+            if (index == 0) {
+                for (int level = 1; level < LEVELS; ++level) {
+                    const int upper = static_cast<int>((m_current >> (level * SLOT_BITS)) & (SLOTS - 1));
+                    cascade(level, upper);
+                    if (upper != 0) break;
+                }
+            }
+
+            // 先摘到临时链表，回调内重新调度到当前 tick 的节点留到下一次 advance
+            Node &head = m_slots[0][index];
+            Node pending;
+            pending.prev = pending.next = &pending;
+            if (head.next != &head) {
+                pending.next = head.next;
+                pending.prev = head.prev;
+                pending.next->prev = &pending;
+                pending.prev->next = &pending;
+                head.prev = head.next = &head;
+            }
+            while (pending.next != &pending) {
+                Node *node = pending.next;
+                cancel(node);
+                onExpire(node);
+            }
+            if (m_current == nowMs) break;
+            m_current++;
+        }
+    }
+
+    /**
+     * @brief 最近一次可能到期的时间（高层槽位返回槽起点，为保守下界）
+     */
+    uint64_t nextExpiry() const
+    {
+        if (m_count == 0) return NO_EXPIRY;
+
+        // 第 0 层精确；高层节点可能早于第 0 层节点到期（尚未下放），取各层最小值
+        uint64_t earliest = NO_EXPIRY;
+        for (int i = 0; i < SLOTS; ++i) {
+            const Node &head = m_slots[0][(m_current + i) & (SLOTS - 1)];
+            if (head.next != &head) {
+                earliest = m_current + i;
+                break;
+            }
+        }
+        for (int level = 1; level < LEVELS; ++level) {
+            const int shift = level * SLOT_BITS;
+            const uint64_t base = m_current >> shift;
+            for (int i = 1; i <= SLOTS; ++i) {
+                const Node &head = m_slots[level][(base + i) & (SLOTS - 1)];
+                if (head.next != &head) {
+                    const uint64_t start = (base + i) << shift;
+                    if (start < earliest) earliest = start;
+                    break;
+                }
+            }
+        }
+        return earliest;
+    }
+
+private:
+    void link(Node *node)
+    {
+        const uint64_t delta = node->expire - m_current;
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (uint64_t(1) << ((level + 1) * SLOT_BITS))) {
+            level++;
+        }
+        uint64_t expire = node->expire;
+        if (level == LEVELS - 1 && delta >= (uint64_t(1) << (LEVELS * SLOT_BITS))) {
+            expire = m_current + (uint64_t(1) << (LEVELS * SLOT_BITS)) - 1;  // 超出范围截断
+        }
+        const int index = static_cast<int>((expire >> (level * SLOT_BITS)) & (SLOTS - 1));
+        Node &head = m_slots[level][index];
+        node->prev = head.prev;
+        node->next = &head;
+        head.prev->next = node;
+        head.prev = node;
+        m_count++;
+    }
+
+    void cascade(int level, int index)
+    {
+        Node &head = m_slots[level][index];
+        while (head.next != &head) {
+            Node *node = head.next;
+            cancel(node);
+            link(node);
+        }
+    }
+
+private:
+    Node m_slots[LEVELS][SLOTS];
+    uint64_t m_current;
+    int m_count = 0;
+};
+
+} // namespace qsc
+
+#endif // TIMERWHEEL_H
@@ -10,6 +10,7 @@
 #include "SessionContext.h"
 #include "kcpcontrolsocket.h"
 #include "fastmsg.h"
+#include "inputmacro.h"
 #include "interfaces/IControlChannel.h"
 #include <QThread>
 
@@ -50,6 +51,9 @@ void Controller::startSender()
 
 void Controller::stopSender()
 {
+    stopMacro();
+    stopMacroRecording();
+
     // 先发送断开消息通知服务端
     postDisconnect();
 
@@ -75,6 +79,20 @@ void Controller::postFastMsg(const char *data, int len)
     }
 }
 
+void Controller::beginInputBatch()
+{
+    if (m_controlSender) {
+        m_controlSender->beginBatch();
+    }
+}
+
+void Controller::endInputBatch()
+{
+    if (m_controlSender) {
+        m_controlSender->endBatch();
+    }
+}
+
 void Controller::recvDeviceMsg(DeviceMsg *deviceMsg)
 {
     Q_UNUSED(deviceMsg);
@@ -83,8 +101,21 @@ void Controller::recvDeviceMsg(DeviceMsg *deviceMsg)
 // ---------------------------------------------------------
 // 更新键位映射脚本
 // ---------------------------------------------------------
-void Controller::updateScript(QString gameScript, bool runAutoStartScripts)
+void Controller::updateScript(QString gameScript, bool runAutoStartScripts,
+                              std::shared_ptr<const KeyMap::Table> compiledKeyMap)
 {
+    // 只改了键位：在当前会话的 KeyMap 上原子替换键位表，Handler、轮盘与触摸状态不受影响；
+    // 自启动脚本仍在运行，不重复启动
+    if (m_sessionContext && !gameScript.isEmpty()) {
+        if (!compiledKeyMap) {
+            compiledKeyMap = KeyMap::compile(gameScript);
+        }
+        if (m_sessionContext->installKeyMap(compiledKeyMap)) {
+            qInfo() << "[Controller] Keymap hot-swapped, session kept";
+            return;
+        }
+    }
+
     // 删除旧的 SessionContext
     if (m_sessionContext) {
         delete m_sessionContext;
@@ -95,7 +126,7 @@ void Controller::updateScript(QString gameScript, bool runAutoStartScripts)
     m_sessionContext = new SessionContext("default", this, this);
 
     if (!gameScript.isEmpty()) {
-        m_sessionContext->loadKeyMap(gameScript, runAutoStartScripts);
+        m_sessionContext->loadKeyMap(gameScript, runAutoStartScripts, std::move(compiledKeyMap));
     }
 
     // 设置分辨率
@@ -268,3 +299,56 @@ void Controller::resetAllTouchPoints()
     QByteArray data = FastMsg::serializeTouch(FastTouchEvent(0, FTA_RESET, 0, 0));
     postFastMsg(data);
 }
+
+// ---------------------------------------------------------
+// 输入宏
+// ---------------------------------------------------------
+bool Controller::startMacroRecording(const QString &path)
+{
+    if (!m_controlSender) {
+        return false;
+    }
+    if (!m_macroRecorder) {
+        m_macroRecorder.reset(new InputMacroRecorder());
+    }
+    if (!m_macroRecorder->open(path, m_mobileSize)) {
+        return false;
+    }
+    m_controlSender->setRecorder(m_macroRecorder.get());
+    return true;
+}
+
+void Controller::stopMacroRecording()
+{
+    if (m_controlSender) {
+        m_controlSender->setRecorder(nullptr);
+    }
+    if (m_macroRecorder) {
+        m_macroRecorder->close();
+    }
+}
+
+bool Controller::playMacro(const QString &path, double speed)
+{
+    if (!m_controlSender) {
+        return false;
+    }
+    if (!m_macroPlayer) {
+        m_macroPlayer = new InputMacroPlayer(m_controlSender, this);
+    }
+    return m_macroPlayer->play(path, m_mobileSize, speed);
+}
+
+void Controller::stopMacro()
+{
+    if (m_macroPlayer) {
+        m_macroPlayer->stop();
+    }
+}
+
+void Controller::setGroupBroadcaster(std::shared_ptr<GroupBroadcaster> broadcaster)
+{
+    if (m_controlSender) {
+        m_controlSender->setBroadcaster(std::move(broadcaster));
+    }
+}
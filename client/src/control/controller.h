@@ -20,13 +20,18 @@
 #include <QImage>
 #include <QTcpSocket>
 #include <functional>
+#include <memory>
 
 #include "keycodes.h"
+#include "keymap.h"
 
 class KcpControlSocket;
 class Receiver;
 class DeviceMsg;
 class ControlSender;
+class InputMacroRecorder;
+class InputMacroPlayer;
+class GroupBroadcaster;
 class SessionContext;
 class QKeyEvent;
 class QMouseEvent;
@@ -58,10 +63,17 @@ public:
 
     void postFastMsg(const QByteArray &data);  // FastMsg 协议快速发送
     void postFastMsg(const char *data, int len);  // P-KCP: 零分配版本
+
+    // 输入批次：期间的 postFastMsg 合并为一次写入（输入线程每批事件调用一次）
+    void beginInputBatch();
+    void endInputBatch();
     void recvDeviceMsg(DeviceMsg *deviceMsg);
 
     // 脚本管理
-    void updateScript(QString gameScript = "", bool runAutoStartScripts = true);
+    // compiledKeyMap 为调用方预先编译好的 gameScript 键位表（为空则在本线程解析）
+    // 脚本内容未变时只热替换键位表（保留会话、Handler 与触摸状态），否则重建 SessionContext
+    void updateScript(QString gameScript = "", bool runAutoStartScripts = true,
+                      std::shared_ptr<const KeyMap::Table> compiledKeyMap = nullptr);
     bool isCurrentCustomKeymap();
 
     // Android 常用功能快捷接口
@@ -118,6 +130,15 @@ public:
     // 释放全部触摸点（窗口关闭/切换键位时调用）
     void resetAllTouchPoints();
 
+    // 输入宏：录制发往设备的输入消息 / 按录制时序回放（speed 为回放倍速）
+    bool startMacroRecording(const QString &path);
+    void stopMacroRecording();
+    bool playMacro(const QString &path, double speed = 1.0);
+    void stopMacro();
+
+    // 群控：本设备的输入消息经广播器转发给从设备（nullptr 停止）
+    void setGroupBroadcaster(std::shared_ptr<GroupBroadcaster> broadcaster);
+
     // 获取 SessionContext（供其他模块访问）
     SessionContext* sessionContext() const { return m_sessionContext; }
 
@@ -128,6 +149,8 @@ private:
     KcpSendCallback m_sendCallback;
     QPointer<ControlSender> m_controlSender;
     QPointer<Receiver> m_receiver;
+    std::unique_ptr<InputMacroRecorder> m_macroRecorder;
+    QPointer<InputMacroPlayer> m_macroPlayer;
 
     SessionContext* m_sessionContext = nullptr;
 
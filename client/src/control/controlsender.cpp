@@ -1,8 +1,12 @@
 #include <QDebug>
 #include <QThread>
+#include <cstring>
 
 #include "controlsender.h"
 #include "kcpcontrolsocket.h"
+#include "fastmsg.h"
+#include "inputmacro.h"
+#include "groupbroadcaster.h"
 #include "interfaces/IControlChannel.h"
 
 /**
@@ -21,6 +25,8 @@ ControlSender::ControlSender(QObject *parent)
     m_coalesceTimer->setSingleShot(true);
     m_coalesceTimer->setInterval(0);
     connect(m_coalesceTimer, &QTimer::timeout, this, &ControlSender::flushCoalesced);
+
+    m_coalesceBuf.reserve(COALESCE_RESERVE);
 }
 
 ControlSender::~ControlSender()
@@ -33,6 +39,9 @@ void ControlSender::setSocket(KcpControlSocket *socket)
     m_socket = socket;
     m_tcpSocket = nullptr;
     m_controlChannel = nullptr;
+    // 新连接的服务端从 0 开始计数
+    m_laneSeq = 0;
+    memset(m_downGen, 0, sizeof(m_downGen));
 }
 
 void ControlSender::setTcpSocket(QTcpSocket *socket)
@@ -113,6 +122,36 @@ bool ControlSender::send(const QByteArray &data)
         return false;
     }
 
+    if (m_recorder) {
+        m_recorder->record(data.constData(), data.size());
+    }
+    if (m_broadcaster) {
+        m_broadcaster->publish(data.constData(), data.size());
+    }
+
+    const bool lane = moveLaneEnabled();
+    if (lane && data.size() == 6 && static_cast<quint8>(data.at(0)) == FMT_TOUCH_MOVE) {
+        // 合并缓冲区中可能有本次按下的 DOWN，先发出，保证计数一致
+        if (!m_coalesceBuf.isEmpty()) {
+            if (m_batchDepth > 0) {
+                // 输入批次未结束：不提前写出，批次内有同一触点的 DOWN 时 MOVE 随批次走可靠通道
+                if (hasPendingDown(static_cast<quint8>(data.at(1)))) {
+                    m_coalesceBuf.append(data);
+                    return true;
+                }
+            } else {
+                flushCoalesced();
+            }
+        }
+        return sendLaneMove(data);
+    }
+
+    // 输入批次：由 endBatch() 一次性发送
+    if (m_batchDepth > 0) {
+        m_coalesceBuf.append(data);
+        return true;
+    }
+
     // 事件循环合并：同一迭代内的消息追加到缓冲区，下次迭代一次性发送
     if (m_coalesceEnabled) {
         m_coalesceBuf.append(data);
@@ -126,6 +165,9 @@ bool ControlSender::send(const QByteArray &data)
 
     if (written == data.size()) {
         m_sentCount++;
+        if (lane) {
+            trackTouchDowns(data);
+        }
         return true;
     }
 
@@ -133,6 +175,13 @@ bool ControlSender::send(const QByteArray &data)
     return false;
 }
 
+void ControlSender::endBatch()
+{
+    if (m_batchDepth > 0 && --m_batchDepth == 0) {
+        flushCoalesced();
+    }
+}
+
 void ControlSender::flushCoalesced()
 {
     if (m_coalesceBuf.isEmpty()) return;
@@ -142,11 +191,87 @@ void ControlSender::flushCoalesced()
     if (written == m_coalesceBuf.size()) {
         m_sentCount++;
         m_batchCount++;
+        if (moveLaneEnabled()) {
+            trackTouchDowns(m_coalesceBuf);
+        }
     } else {
         m_droppedCount++;
     }
 
-    m_coalesceBuf.clear();
-    // 预留空间，减少下次 append 的内存分配
-    m_coalesceBuf.reserve(128);
+    // resize(0) 保留已分配容量（clear() 会释放），之后的 append 不再分配内存
+    m_coalesceBuf.resize(0);
+}
+
+bool ControlSender::moveLaneEnabled() const
+{
+    // 只有直接写 KcpControlSocket 时可用（IControlChannel / 回调路径没有裸 UDP 出口）
+    return m_socket && !m_controlChannel && !m_sendCallback && m_socket->moveLaneCopies() > 0;
+}
+
+bool ControlSender::sendLaneMove(const QByteArray &data)
+{
+    const quint8 seqId = static_cast<quint8>(data.at(1));
+    char buf[11];
+    int len = FastMsg::serializeLaneMoveInto(buf, data.constData(), ++m_laneSeq, m_downGen[seqId]);
+    if (m_socket->writeUnreliable(buf, len) == len) {
+        m_laneCount++;
+        return true;
+    }
+    m_droppedCount++;
+    return false;
+}
+
+bool ControlSender::hasPendingDown(quint8 seqId) const
+{
+    const char *p = m_coalesceBuf.constData();
+    int left = m_coalesceBuf.size();
+    while (left > 0) {
+        const int size = FastMsg::messageSize(p, left);
+        if (size <= 0) {
+            break;
+        }
+        const quint8 type = static_cast<quint8>(p[0]);
+        if (type == FMT_TOUCH_DOWN && static_cast<quint8>(p[1]) == seqId) {
+            return true;
+        }
+        if (type == FMT_BATCH) {
+            const int count = static_cast<quint8>(p[1]);
+            for (int i = 0; i < count; ++i) {
+                const char *e = p + 2 + i * 6;
+                if (static_cast<quint8>(e[0]) == seqId && static_cast<quint8>(e[1]) == FTA_DOWN) {
+                    return true;
+                }
+            }
+        }
+        p += size;
+        left -= size;
+    }
+    return false;
+}
+
+void ControlSender::trackTouchDowns(const QByteArray &data)
+{
+    const char *p = data.constData();
+    int left = data.size();
+    while (left > 0) {
+        const int size = FastMsg::messageSize(p, left);
+        if (size <= 0) {
+            break;
+        }
+        const quint8 type = static_cast<quint8>(p[0]);
+        if (type == FMT_TOUCH_DOWN) {
+            m_downGen[static_cast<quint8>(p[1])]++;
+        } else if (type == FMT_BATCH) {
+            // count(1) + [seqId(1)+action(1)+x(2)+y(2)]*N
+            const int count = static_cast<quint8>(p[1]);
+            for (int i = 0; i < count; ++i) {
+                const char *e = p + 2 + i * 6;
+                if (static_cast<quint8>(e[1]) == FTA_DOWN) {
+                    m_downGen[static_cast<quint8>(e[0])]++;
+                }
+            }
+        }
+        p += size;
+        left -= size;
+    }
 }
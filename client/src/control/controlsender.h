@@ -8,8 +8,11 @@
 #include <QTimer>
 #include <functional>
 #include <atomic>
+#include <memory>
 
 class KcpControlSocket;
+class InputMacroRecorder;
+class GroupBroadcaster;
 
 namespace qsc { namespace core { class IControlChannel; } }
 
@@ -23,6 +26,18 @@ using SendCallback = std::function<qint64(const QByteArray&)>;
  * - KCP 模式：直接调用 KCP 写入 / KCP mode: direct KCP write
  * - TCP 模式：直接调用 TCP 写入 / TCP mode: direct TCP write
  * 支持事件循环合并模式，同一迭代内的多次 send() 合并为一次系统调用
+ *
+ * 触摸 MOVE 不可靠通道（KCP 模式且 KcpControlSocket::moveLaneCopies() > 0）：
+ * 单条 FMT_TOUCH_MOVE 改写为 FMT_TOUCH_MOVE_SEQ 经裸 UDP 发送，丢包不再阻塞后续 MOVE；
+ * DOWN/UP/按键等仍走可靠通道。每个 seqId 发出的 DOWN 次数随消息携带，
+ * 服务端据此丢弃上一次按下残留的 MOVE。
+ *
+ * 输入线程模式下 InputThread 在每批输入事件前后调用 beginBatch()/endBatch()，
+ * 一批事件产生的消息一次写出，不依赖事件循环合并定时器。
+ * 批次内的不可靠 MOVE 不会提前写出批次；其触点的 DOWN 仍在批次中时 MOVE 随批次发送。
+ *
+ * 设置 InputMacroRecorder 后，send() 收到的输入消息带微秒时间戳录入宏文件。
+ * 设置 GroupBroadcaster 后，send() 收到的输入消息同时转发给群控从设备。
  */
 class ControlSender : public QObject
 {
@@ -47,6 +62,16 @@ public:
     // 启用/禁用事件循环合并模式（同一迭代内多条消息合并为一次写入）
     void setCoalesceEnabled(bool enabled);
 
+    // 输入宏录制（nullptr 停止），录制器由调用方持有
+    void setRecorder(InputMacroRecorder *recorder) { m_recorder = recorder; }
+
+    // 群控广播（nullptr 停止）：本设备作为主控，输入消息转发给所有从设备
+    void setBroadcaster(std::shared_ptr<GroupBroadcaster> broadcaster) { m_broadcaster = std::move(broadcaster); }
+
+    // 输入批次：beginBatch/endBatch 之间的消息追加到预分配缓冲区，endBatch 时一次写出（可嵌套）
+    void beginBatch() { ++m_batchDepth; }
+    void endBatch();
+
     // 发送数据（即时发送）
     bool send(const QByteArray &data);
 
@@ -58,6 +83,7 @@ public:
     quint64 droppedCount() const { return m_droppedCount; }
     quint64 sentCount() const { return m_sentCount; }
     quint64 batchCount() const { return m_batchCount; }
+    quint64 laneCount() const { return m_laneCount; }
 
 signals:
     void sendError(const QString &error);
@@ -66,25 +92,42 @@ private slots:
     void flushCoalesced();
 
 private:
+    static constexpr int COALESCE_RESERVE = 4096;
+
     qint64 doWrite(const QByteArray &data);
 
+    // 不可靠通道
+    bool moveLaneEnabled() const;
+    bool sendLaneMove(const QByteArray &data);
+    void trackTouchDowns(const QByteArray &data);
+    // 合并缓冲区中是否有该触点尚未发出的 DOWN
+    bool hasPendingDown(quint8 seqId) const;
+
 private:
     QPointer<KcpControlSocket> m_socket;
     QPointer<QTcpSocket> m_tcpSocket;
     qsc::core::IControlChannel* m_controlChannel = nullptr;
     SendCallback m_sendCallback;
+    InputMacroRecorder *m_recorder = nullptr;
+    std::shared_ptr<GroupBroadcaster> m_broadcaster;
 
     std::atomic<bool> m_running{false};
 
-    // 事件循环合并
+    // 事件循环合并 / 输入批次（共用缓冲区，构造时预分配，发送后保留容量）
     bool m_coalesceEnabled = false;
+    int m_batchDepth = 0;
     QByteArray m_coalesceBuf;
     QTimer *m_coalesceTimer = nullptr;
 
+    // 不可靠通道：全局递增序号 + 每个 seqId 已发出的 DOWN 次数 (mod 256，与服务端计数一致)
+    quint32 m_laneSeq = 0;
+    quint8 m_downGen[256] = {};
+
     // 统计
     quint64 m_droppedCount = 0;
     quint64 m_sentCount = 0;
     quint64 m_batchCount = 0;  // 合并批次计数
+    quint64 m_laneCount = 0;   // 不可靠通道发送计数
 };
 
 #endif // CONTROLSENDER_H
@@ -0,0 +1,333 @@
+#include <QDebug>
+#include <QtGlobal>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#endif
+
+#include "groupbroadcaster.h"
+#include "inputmacro.h"
+#include "fastmsg.h"
+#include "ClockSync.h"
+
+static void putU16(char *p, quint16 v)
+{
+    p[0] = static_cast<char>((v >> 8) & 0xFF);
+    p[1] = static_cast<char>(v & 0xFF);
+}
+
+static quint16 getU16(const char *p)
+{
+    return static_cast<quint16>((static_cast<quint8>(p[0]) << 8) | static_cast<quint8>(p[1]));
+}
+
+GroupBroadcaster::Calibration GroupBroadcaster::Calibration::fromRect(const QRectF &rect)
+{
+    Calibration calibration;
+    calibration.scaleX = rect.width();
+    calibration.scaleY = rect.height();
+    calibration.offsetX = rect.x();
+    calibration.offsetY = rect.y();
+    return calibration;
+}
+
+GroupBroadcaster::GroupBroadcaster()
+    : m_ring(new Slot[RING_SIZE])
+{
+}
+
+GroupBroadcaster::~GroupBroadcaster()
+{
+    clear();
+}
+
+bool GroupBroadcaster::addFollower(const QString &name, WriteFn write, const Calibration &calibration)
+{
+    if (!write) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_followersMutex);
+    for (const auto &follower : m_followers) {
+        if (follower->name == name) {
+            return false;
+        }
+    }
+    auto follower = std::make_unique<Follower>();
+    follower->name = name;
+    follower->write = std::move(write);
+    follower->calibration = calibration;
+    // 从加入时刻开始转发，不补发加入前的消息
+    follower->cursor.store(m_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    Follower *raw = follower.get();
+    follower->thread = std::thread([this, raw]() { run(raw); });
+    m_followers.push_back(std::move(follower));
+    m_followerCount.store(static_cast<int>(m_followers.size()), std::memory_order_relaxed);
+    qInfo("[GroupBroadcaster] Follower %s joined (%d total)%s", qPrintable(name),
+          static_cast<int>(m_followers.size()), calibration.isIdentity() ? "" : ", calibrated");
+    return true;
+}
+
+void GroupBroadcaster::removeFollower(const QString &name)
+{
+    std::unique_ptr<Follower> removed;
+    {
+        std::lock_guard<std::mutex> lock(m_followersMutex);
+        auto it = std::find_if(m_followers.begin(), m_followers.end(),
+                               [&name](const std::unique_ptr<Follower> &f) { return f->name == name; });
+        if (it == m_followers.end()) {
+            return;
+        }
+        removed = std::move(*it);
+        m_followers.erase(it);
+        m_followerCount.store(static_cast<int>(m_followers.size()), std::memory_order_relaxed);
+    }
+    stopFollower(removed.get());
+    qInfo("[GroupBroadcaster] Follower %s left", qPrintable(name));
+}
+
+void GroupBroadcaster::clear()
+{
+    std::vector<std::unique_ptr<Follower>> removed;
+    {
+        std::lock_guard<std::mutex> lock(m_followersMutex);
+        removed.swap(m_followers);
+        m_followerCount.store(0, std::memory_order_relaxed);
+    }
+    for (auto &follower : removed) {
+        stopFollower(follower.get());
+    }
+}
+
+void GroupBroadcaster::stopFollower(Follower *follower)
+{
+    follower->running.store(false, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+    }
+    m_cond.notify_all();
+    if (follower->thread.joinable()) {
+        follower->thread.join();
+    }
+    // 释放主控转发过去、仍按下的触摸点
+    const QByteArray reset = FastMsg::serializeTouch(FastTouchEvent(0, FTA_RESET, 0, 0));
+    follower->write(reset);
+}
+
+// ---------------------------------------------------------
+// 发布（主控 Controller 线程）
+// ---------------------------------------------------------
+void GroupBroadcaster::publish(const char *data, int len)
+{
+    if (m_followerCount.load(std::memory_order_relaxed) == 0 || !data || len <= 0) {
+        return;
+    }
+
+    // 先确认含输入消息，避免无谓占用槽位（覆盖落后设备仍需要的旧消息）
+    int inputBytes = 0;
+    for (int pos = 0; pos < len;) {
+        const int size = FastMsg::messageSize(data + pos, len - pos);
+        if (size <= 0) {
+            break;
+        }
+        if (InputMacro::isInputMessage(static_cast<quint8>(data[pos]))) {
+            inputBytes += size;
+        }
+        pos += size;
+    }
+    if (inputBytes == 0) {
+        return;
+    }
+    if (inputBytes > SLOT_BYTES) {
+        if (m_oversized.fetch_add(1, std::memory_order_relaxed) == 0) {
+            qWarning("[GroupBroadcaster] Message of %d bytes exceeds slot size %d, not broadcast", inputBytes, SLOT_BYTES);
+        }
+        return;
+    }
+
+    const quint64 seq = m_head.load(std::memory_order_relaxed) + 1;
+    Slot &slot = m_ring[seq & (RING_SIZE - 1)];
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    int out = 0;
+    for (int pos = 0; pos < len;) {
+        const int size = FastMsg::messageSize(data + pos, len - pos);
+        if (size <= 0) {
+            break;
+        }
+        if (InputMacro::isInputMessage(static_cast<quint8>(data[pos]))) {
+            memcpy(slot.data + out, data + pos, size);
+            out += size;
+        }
+        pos += size;
+    }
+    slot.len = out;
+    slot.publishUs = qsc::ClockSync::nowUs();
+    slot.seq.store(seq, std::memory_order_release);
+    m_head.store(seq, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+    }
+    m_cond.notify_all();
+}
+
+bool GroupBroadcaster::readSlot(quint64 seq, char *out, int *len, qint64 *publishUs) const
+{
+    const Slot &slot = m_ring[seq & (RING_SIZE - 1)];
+    if (slot.seq.load(std::memory_order_acquire) != seq) {
+        return false;
+    }
+    *len = qBound(0, slot.len, SLOT_BYTES);
+    *publishUs = slot.publishUs;
+    memcpy(out, slot.data, *len);
+    // 顺序锁：拷贝期间被发布线程覆盖则序号已变
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.seq.load(std::memory_order_relaxed) == seq;
+}
+
+// ---------------------------------------------------------
+// 从设备发送线程
+// ---------------------------------------------------------
+void GroupBroadcaster::run(Follower *follower)
+{
+#ifdef Q_OS_LINUX
+    pthread_setname_np(pthread_self(), "group-send");
+#endif
+
+    const bool remapNeeded = !follower->calibration.isIdentity();
+    QByteArray out;
+    out.reserve(MAX_WRITE_BYTES + SLOT_BYTES);
+    std::vector<qint64> stamps;
+    stamps.reserve(MAX_WRITE_BYTES / 6);
+    char msg[SLOT_BYTES];
+
+    while (follower->running.load(std::memory_order_relaxed)) {
+        quint64 cursor = follower->cursor.load(std::memory_order_relaxed);
+        const quint64 head = m_head.load(std::memory_order_acquire);
+        if (cursor >= head) {
+            std::unique_lock<std::mutex> lock(m_waitMutex);
+            m_cond.wait_for(lock, std::chrono::milliseconds(100), [this, follower, cursor]() {
+                return !follower->running.load(std::memory_order_relaxed)
+                       || m_head.load(std::memory_order_acquire) > cursor;
+            });
+            continue;
+        }
+
+        out.resize(0);
+        stamps.clear();
+        while (cursor < head && out.size() < MAX_WRITE_BYTES) {
+            int len = 0;
+            qint64 publishUs = 0;
+            if (!readSlot(cursor + 1, msg, &len, &publishUs)) {
+                // 落后超过环形缓冲区：丢弃被覆盖的消息，从最新处继续并释放残留的按下
+                const quint64 latest = m_head.load(std::memory_order_acquire);
+                follower->dropped.fetch_add(latest - cursor + stamps.size(), std::memory_order_relaxed);
+                cursor = latest;
+                out.resize(0);
+                stamps.clear();
+                out.append(FastMsg::serializeTouch(FastTouchEvent(0, FTA_RESET, 0, 0)));
+                break;
+            }
+            if (remapNeeded) {
+                remap(msg, len, follower->calibration);
+            }
+            out.append(msg, len);
+            stamps.push_back(publishUs);
+            ++cursor;
+        }
+        follower->cursor.store(cursor, std::memory_order_relaxed);
+
+        if (out.isEmpty()) {
+            continue;
+        }
+        const qint64 written = follower->write(out);
+        if (written != out.size()) {
+            follower->failed.fetch_add(stamps.size(), std::memory_order_relaxed);
+            continue;
+        }
+        const qint64 now = qsc::ClockSync::nowUs();
+        for (qint64 publishUs : stamps) {
+            follower->latency.addSample(now - publishUs);
+        }
+        follower->sent.fetch_add(stamps.size(), std::memory_order_relaxed);
+    }
+}
+
+void GroupBroadcaster::remap(char *msg, int len, const Calibration &calibration)
+{
+    auto mapPoint = [&calibration](char *p) {
+        const double x = getU16(p) * calibration.scaleX + calibration.offsetX * 65535.0;
+        const double y = getU16(p + 2) * calibration.scaleY + calibration.offsetY * 65535.0;
+        putU16(p, static_cast<quint16>(qBound(0.0, x + 0.5, 65535.0)));
+        putU16(p + 2, static_cast<quint16>(qBound(0.0, y + 0.5, 65535.0)));
+    };
+    for (int pos = 0; pos < len;) {
+        char *p = msg + pos;
+        const int size = FastMsg::messageSize(p, len - pos);
+        if (size <= 0) {
+            break;
+        }
+        const quint8 type = static_cast<quint8>(p[0]);
+        if (type == FMT_TOUCH_DOWN || type == FMT_TOUCH_UP || type == FMT_TOUCH_MOVE) {
+            mapPoint(p + 2);
+        } else if (type == FMT_BATCH) {
+            // count(1) + [seqId(1)+action(1)+x(2)+y(2)]*N
+            const int count = static_cast<quint8>(p[1]);
+            for (int i = 0; i < count; ++i) {
+                mapPoint(p + 2 + i * 6 + 2);
+            }
+        }
+        pos += size;
+    }
+}
+
+// ---------------------------------------------------------
+// 统计
+// ---------------------------------------------------------
+QString GroupBroadcaster::stats(bool reset)
+{
+    std::lock_guard<std::mutex> lock(m_followersMutex);
+    if (m_followers.empty()) {
+        return QString();
+    }
+
+    // 各设备 P99 的中位数作为落后判定基准
+    std::vector<qint64> p99s;
+    for (const auto &follower : m_followers) {
+        if (follower->latency.count() > 0) {
+            p99s.push_back(follower->latency.percentileUs(0.99));
+        }
+    }
+    qint64 medianP99 = 0;
+    if (!p99s.empty()) {
+        std::nth_element(p99s.begin(), p99s.begin() + p99s.size() / 2, p99s.end());
+        medianP99 = p99s[p99s.size() / 2];
+    }
+
+    const quint64 head = m_head.load(std::memory_order_acquire);
+    QString out;
+    for (const auto &follower : m_followers) {
+        const qint64 p99 = follower->latency.percentileUs(0.99);
+        const quint64 cursor = follower->cursor.load(std::memory_order_relaxed);
+        const bool straggler = follower->latency.count() > 0 && p99 >= STRAGGLER_MIN_US
+                               && p99 > medianP99 * STRAGGLER_FACTOR;
+        out += QString("%1: sent=%2 p50=%3us p99=%4us max=%5us backlog=%6 dropped=%7 failed=%8%9\n")
+                   .arg(follower->name)
+                   .arg(follower->sent.load(std::memory_order_relaxed))
+                   .arg(follower->latency.percentileUs(0.50))
+                   .arg(p99)
+                   .arg(follower->latency.maxUs())
+                   .arg(head > cursor ? head - cursor : 0)
+                   .arg(follower->dropped.load(std::memory_order_relaxed))
+                   .arg(follower->failed.load(std::memory_order_relaxed))
+                   .arg(straggler ? " [straggler]" : "");
+        if (reset) {
+            follower->latency.reset();
+        }
+    }
+    return out;
+}
@@ -0,0 +1,115 @@
+#ifndef GROUPBROADCASTER_H
+#define GROUPBROADCASTER_H
+
+#include <QByteArray>
+#include <QRectF>
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "PerformanceMonitor.h"
+
+/**
+ * @brief 群控广播器 / Fans one device's input stream out to many devices
+ *
+ * 主控设备的 ControlSender::send() 把输入消息（触摸、按键、批量触摸）交给 publish()，
+ * 每台从设备一个发送线程，经各自的控制通道写出：
+ * - 发布：消息只序列化一次，拷贝进共享环形缓冲区（RING_SIZE 槽，序号 + 顺序锁校验），
+ *   发布线程的开销与从设备数量无关（一次拷贝 + 一次唤醒）
+ * - 发送：各线程按自己的读位置取出积压的消息，逐台做坐标校准后合并为一次写入，
+ *   某台设备写入阻塞不影响其他设备
+ * - 校准：主控归一化坐标按从设备的校准矩形映射（主控整个画面 → 从设备画面中的矩形）
+ * - 落后：读位置被覆盖时跳到最新消息并补发 TOUCH_RESET，避免残留按下的触摸点
+ * - 统计：每台设备 发布→写出完成 的延迟直方图，stats() 输出并标出明显落后的设备
+ *
+ * addFollower/removeFollower/stats 在管理线程调用；publish 只在主控 Controller 所在线程调用。
+ * 写入回调在从设备发送线程调用，必须线程安全。
+ */
+class GroupBroadcaster
+{
+public:
+    static constexpr int RING_SIZE = 1024;          // 2 的幂
+    static constexpr int SLOT_BYTES = 256;          // 单次 send 的输入消息上限（约 42 个批量触摸点）
+    static constexpr int MAX_WRITE_BYTES = 4096;    // 单次合并写入上限
+    static constexpr int STRAGGLER_FACTOR = 2;      // P99 超过各设备 P99 中位数的倍数视为落后
+    static constexpr qint64 STRAGGLER_MIN_US = 5000;
+
+    using WriteFn = std::function<qint64(const QByteArray &)>;
+
+    /**
+     * @brief 从设备坐标校准：x' = x * scaleX + offsetX（归一化 0-1 空间）
+     */
+    struct Calibration {
+        double scaleX = 1.0, scaleY = 1.0;
+        double offsetX = 0.0, offsetY = 0.0;
+
+        bool isIdentity() const { return scaleX == 1.0 && scaleY == 1.0 && offsetX == 0.0 && offsetY == 0.0; }
+        // rect 为主控整个画面在从设备画面中对应的归一化矩形
+        static Calibration fromRect(const QRectF &rect);
+    };
+
+    GroupBroadcaster();
+    ~GroupBroadcaster();
+
+    GroupBroadcaster(const GroupBroadcaster &) = delete;
+    GroupBroadcaster &operator=(const GroupBroadcaster &) = delete;
+
+    bool addFollower(const QString &name, WriteFn write, const Calibration &calibration);
+    // 停止该设备的发送线程并补发 TOUCH_RESET
+    void removeFollower(const QString &name);
+    void clear();
+    int followerCount() const { return m_followerCount.load(std::memory_order_relaxed); }
+
+    void publish(const char *data, int len);
+
+    /**
+     * @brief 每台从设备一行：已发送、延迟 P50/P99/max、积压、丢弃、写入失败
+     * @param reset 输出后清空延迟直方图（按统计周期观察）
+     */
+    QString stats(bool reset);
+
+private:
+    struct Slot {
+        std::atomic<quint64> seq{0};    // 0 = 正在写入
+        qint64 publishUs = 0;
+        int len = 0;
+        char data[SLOT_BYTES];
+    };
+
+    struct Follower {
+        QString name;
+        WriteFn write;
+        Calibration calibration;
+        std::thread thread;
+        std::atomic<bool> running{true};
+        std::atomic<quint64> cursor{0};     // 已取出的最大序号
+        std::atomic<quint64> sent{0};
+        std::atomic<quint64> dropped{0};
+        std::atomic<quint64> failed{0};
+        qsc::LatencyHistogram latency;
+    };
+
+    void run(Follower *follower);
+    bool readSlot(quint64 seq, char *out, int *len, qint64 *publishUs) const;
+    static void remap(char *msg, int len, const Calibration &calibration);
+    void stopFollower(Follower *follower);
+
+private:
+    std::unique_ptr<Slot[]> m_ring;
+    std::atomic<quint64> m_head{0};         // 已发布的最大序号（从 1 开始）
+    std::atomic<int> m_followerCount{0};
+    std::atomic<quint64> m_oversized{0};
+
+    std::mutex m_waitMutex;
+    std::condition_variable m_cond;
+
+    std::mutex m_followersMutex;            // 只保护 m_followers 容器本身
+    std::vector<std::unique_ptr<Follower>> m_followers;
+};
+
+#endif // GROUPBROADCASTER_H
@@ -33,6 +33,7 @@ public:
     void onFocusLost() override;
     void reset() override;
     int priority() const override { return 70; }  // 比视角控制优先级更高
+    int keyMapType() const override { return KeyMap::KMT_FREE_LOOK; }
     QString name() const override { return QStringLiteral("FreeLookHandler"); }
 
     // 设置 KeyMap 引用
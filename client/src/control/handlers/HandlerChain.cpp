@@ -45,6 +45,7 @@ void HandlerChain::removeHandler(IInputHandler* handler)
 
     m_handlers.removeOne(handler);
     handler->setParent(nullptr);
+    m_sorted = false;
 
     qDebug() << "[HandlerChain] Removed handler:" << handler->name();
 }
@@ -56,6 +57,7 @@ void HandlerChain::clear()
         delete handler;
     }
     m_handlers.clear();
+    std::fill(std::begin(m_keyRoutes), std::end(m_keyRoutes), nullptr);
 }
 
 void HandlerChain::sortHandlers()
@@ -66,21 +68,30 @@ void HandlerChain::sortHandlers()
               [](IInputHandler* a, IInputHandler* b) {
                   return a->priority() < b->priority();
               });
+
+    // 键盘事件路由表：每种键位类型取优先级最高的 Handler
+    std::fill(std::begin(m_keyRoutes), std::end(m_keyRoutes), nullptr);
+    for (auto handler : m_handlers) {
+        const int type = handler->keyMapType();
+        if (type >= 0 && type < KEY_ROUTES && !m_keyRoutes[type]) {
+            m_keyRoutes[type] = handler;
+        }
+    }
     m_sorted = true;
 }
 
 bool HandlerChain::dispatchKeyEvent(const QKeyEvent* event,
                                     const QSize& frameSize,
-                                    const QSize& showSize)
+                                    const QSize& showSize,
+                                    int keyMapType)
 {
     sortHandlers();
 
-    for (auto handler : m_handlers) {
-        if (handler->handleKeyEvent(event, frameSize, showSize)) {
-            return true;  // 事件被消费
-        }
+    // 键盘事件只有按键位类型匹配的 Handler 会消费，直接路由
+    if (keyMapType < 0 || keyMapType >= KEY_ROUTES || !m_keyRoutes[keyMapType]) {
+        return false;
     }
-    return false;
+    return m_keyRoutes[keyMapType]->handleKeyEvent(event, frameSize, showSize);  // true 表示事件被消费
 }
 
 bool HandlerChain::dispatchMouseEvent(const QMouseEvent* event,
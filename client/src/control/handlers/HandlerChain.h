@@ -55,11 +55,13 @@ public:
 
     /**
      * @brief 分发键盘事件
+     * @param keyMapType 该按键在键位表中的类型（KeyMap::KeyMapType），只交给声明处理该类型的 Handler
      * @return true 表示事件被某个 Handler 消费
      */
     bool dispatchKeyEvent(const QKeyEvent* event,
                           const QSize& frameSize,
-                          const QSize& showSize);
+                          const QSize& showSize,
+                          int keyMapType);
 
     /**
      * @brief 分发鼠标事件
@@ -95,7 +97,10 @@ public:
 private:
     void sortHandlers();
 
+    static constexpr int KEY_ROUTES = 16;
+
     QList<IInputHandler*> m_handlers;
+    IInputHandler* m_keyRoutes[KEY_ROUTES] = {};   // 键位类型 -> 处理该类型的最高优先级 Handler
     Controller* m_controller = nullptr;
     SessionContext* m_sessionContext = nullptr;
     bool m_sorted = true;
@@ -104,6 +104,12 @@ public:
      */
     virtual int priority() const { return 100; }
 
+    /**
+     * @brief 处理的键位类型（KeyMap::KeyMapType），-1 表示不处理任何键位的键盘事件
+     * HandlerChain 据此把键盘事件直接路由到对应 Handler，不再逐个询问
+     */
+    virtual int keyMapType() const { return -1; }
+
 protected:
     Controller* m_controller = nullptr;
     SessionContext* m_sessionContext = nullptr;
@@ -49,18 +49,18 @@ SteerWheelHandler::SteerWheelHandler(QObject* parent)
     : IInputHandler(parent)
 {
     // 初始化定时器
-    m_state.delayData.timer = new QTimer(this);
+    m_state.delayData.timer = new qsc::PreciseTimer(this);
     m_state.delayData.timer->setSingleShot(true);
-    connect(m_state.delayData.timer, &QTimer::timeout, this, &SteerWheelHandler::onSteerWheelTimer);
+    connect(m_state.delayData.timer, &qsc::PreciseTimer::timeout, this, &SteerWheelHandler::onSteerWheelTimer);
 
-    m_state.firstPressTimer = new QTimer(this);
+    m_state.firstPressTimer = new qsc::PreciseTimer(this);
     m_state.firstPressTimer->setSingleShot(true);
     m_state.firstPressTimer->setInterval(5);
-    connect(m_state.firstPressTimer, &QTimer::timeout, this, &SteerWheelHandler::onFirstPressTimer);
+    connect(m_state.firstPressTimer, &qsc::PreciseTimer::timeout, this, &SteerWheelHandler::onFirstPressTimer);
 
-    m_state.humanizeTimer = new QTimer(this);
+    m_state.humanizeTimer = new qsc::PreciseTimer(this);
     m_state.humanizeTimer->setSingleShot(true);
-    connect(m_state.humanizeTimer, &QTimer::timeout, this, &SteerWheelHandler::onHumanizeTimer);
+    connect(m_state.humanizeTimer, &qsc::PreciseTimer::timeout, this, &SteerWheelHandler::onHumanizeTimer);
 }
 
 SteerWheelHandler::~SteerWheelHandler()
@@ -222,8 +222,10 @@ void SteerWheelHandler::onFirstPressTimer()
 {
     if (!m_state.pendingNode) return;
 
-    if (m_state.delayData.pressedNum > 0) {
-        executeMove(*m_state.pendingNode);
+    // 等待期间键位表可能已热替换，按当前表取轮盘节点
+    const KeyMap::KeyMapNode* node = m_keyMap ? m_keyMap->getSteerWheelNode() : nullptr;
+    if (node && m_state.delayData.pressedNum > 0) {
+        executeMove(*node);
     }
 }
 
@@ -3,7 +3,7 @@
 
 #include "IInputHandler.h"
 #include "keymap.h"
-#include <QTimer>
+#include "PreciseTimer.h"
 #include <QQueue>
 #include <QPointF>
 
@@ -32,6 +32,7 @@ public:
     void reset() override;
     QString name() const override { return "SteerWheelHandler"; }
     int priority() const override { return 20; }  // 高优先级
+    int keyMapType() const override { return KeyMap::KMT_STEER_WHEEL; }
 
     // ========== 配置方法 ==========
 
@@ -82,7 +83,7 @@ private:
         bool pressedRight = false;
         quint32 fastTouchSeqId = 0;
         bool isFirstPress = true;
-        QTimer* firstPressTimer = nullptr;
+        qsc::PreciseTimer* firstPressTimer = nullptr;
         const KeyMap::KeyMapNode* pendingNode = nullptr;
 
         // 拟人化参数
@@ -90,13 +91,13 @@ private:
         double currentLengthFactor = 1.0;
         double targetAngleOffset = 0.0;
         double targetLengthFactor = 1.0;
-        QTimer* humanizeTimer = nullptr;
+        qsc::PreciseTimer* humanizeTimer = nullptr;
         int lastPressedState = 0;
 
         // 延迟数据
         struct {
             QPointF currentPos;
-            QTimer* timer = nullptr;
+            qsc::PreciseTimer* timer = nullptr;
             QQueue<QPointF> queuePos;
             QQueue<quint32> queueTimer;
             int pressedNum = 0;
@@ -6,6 +6,7 @@
 #include "keymap.h"
 #include "fastmsg.h"
 #include "ConfigCenter.h"
+#include "ClockSync.h"
 #include <QRandomGenerator>
 #include <algorithm>
 
@@ -44,15 +45,20 @@ static QSize getTargetSize(const QSize& frameSize, const QSize& showSize) {
 ViewportHandler::ViewportHandler(QObject* parent)
     : IInputHandler(parent)
 {
-    m_state.centerRepressTimer = new QTimer(this);
+    m_state.centerRepressTimer = new qsc::PreciseTimer(this);
     m_state.centerRepressTimer->setSingleShot(true);
     m_state.centerRepressTimer->setInterval(5);
-    connect(m_state.centerRepressTimer, &QTimer::timeout, this, &ViewportHandler::onCenterRepressTimer);
+    connect(m_state.centerRepressTimer, &qsc::PreciseTimer::timeout, this, &ViewportHandler::onCenterRepressTimer);
 
-    m_state.idleCenterTimer = new QTimer(this);
+    m_state.idleCenterTimer = new qsc::PreciseTimer(this);
     m_state.idleCenterTimer->setSingleShot(true);
     m_state.idleCenterTimer->setInterval(1000);
-    connect(m_state.idleCenterTimer, &QTimer::timeout, this, &ViewportHandler::onIdleCenterTimer);
+    connect(m_state.idleCenterTimer, &qsc::PreciseTimer::timeout, this, &ViewportHandler::onIdleCenterTimer);
+
+    // 重采样节拍：微秒级间隔
+    m_resample.timer = new qsc::PreciseTimer(this);
+    m_resample.timer->setSingleShot(true);
+    connect(m_resample.timer, &qsc::PreciseTimer::timeout, this, &ViewportHandler::onMouseMoveTimer);
 }
 
 ViewportHandler::~ViewportHandler()
@@ -95,6 +101,34 @@ void ViewportHandler::reset()
     m_moveSendScheduled = false;
     m_smoothedDelta = {0, 0};
     m_subPixelAccum = {0, 0};
+
+    if (m_resample.rawEvents > 0) {
+        qInfo("[Viewport] Touch moves: %llu raw -> %llu emitted (resample %lld us, predict %lld us)",
+              static_cast<unsigned long long>(m_resample.rawEvents),
+              static_cast<unsigned long long>(m_resample.emittedMoves),
+              static_cast<long long>(m_resample.periodUs),
+              static_cast<long long>(m_resample.predictUs));
+    }
+    m_resample.rawEvents = 0;
+    m_resample.emittedMoves = 0;
+    m_resample.velocity = {0, 0};
+    m_resample.predicted = false;
+}
+
+void ViewportHandler::loadResampleConfig()
+{
+    m_resample.periodUs = 0;
+    m_resample.predictUs = 0;
+    if (!m_keyMap || !m_keyMap->isValidMouseMoveMap()) return;
+
+    const auto& mouseMove = m_keyMap->getMouseMoveMap().data.mouseMove;
+    if (mouseMove.moveRateHz > 0.0) {
+        m_resample.periodUs = qRound64(1000000.0 / qMin(mouseMove.moveRateHz, MAX_MOVE_RATE_HZ));
+        // 预测依赖节拍补发真实位置，只在重采样模式下生效
+        if (mouseMove.predictMs > 0.0) {
+            m_resample.predictUs = qRound64(qMin(mouseMove.predictMs, MAX_PREDICT_MS) * 1000.0);
+        }
+    }
 }
 
 void ViewportHandler::startTouch(const QSize& frameSize, const QSize& showSize)
@@ -113,19 +147,46 @@ void ViewportHandler::startTouch(const QSize& frameSize, const QSize& showSize)
         m_state.touching = true;
         m_smoothedDelta = {0, 0};
         m_subPixelAccum = {0, 0};
+
+        loadResampleConfig();
+        m_resample.nextEmitUs = 0;
+        m_resample.lastEmitUs = 0;
+        m_resample.velocity = {0, 0};
+        m_resample.predicted = false;
     }
 }
 
 void ViewportHandler::addMoveDelta(const QPointF& delta)
 {
+    m_resample.rawEvents++;
+
+    // 方向反转：立即发出反转前的累积量，拐点不被平均到下一拍；拐点处不外推
+    if (m_resample.periodUs > 0 && m_state.touching && !m_state.waitingForCenterRepress
+        && QPointF::dotProduct(m_pendingMoveDelta, delta) < 0.0) {
+        m_resample.timer->stop();
+        m_resample.velocity = {0, 0};
+        m_resample.lastEmitUs = 0;
+        onMouseMoveTimer();
+    }
     m_pendingMoveDelta += delta;
 }
 
 void ViewportHandler::scheduleMoveSend()
 {
-    if (!m_moveSendScheduled) {
-        m_moveSendScheduled = true;
+    if (m_moveSendScheduled) return;
+    m_moveSendScheduled = true;
+
+    if (m_resample.periodUs <= 0) {
+        onMouseMoveTimer();
+        return;
+    }
+
+    // 已到拍（含空闲后的第一个增量）立即发送，否则等到下一拍
+    const qint64 waitUs = m_resample.nextEmitUs - qsc::ClockSync::nowUs();
+    if (waitUs <= 0) {
         onMouseMoveTimer();
+    } else {
+        m_resample.timer->startUs(waitUs);
     }
 }
 
@@ -136,6 +197,16 @@ void ViewportHandler::accumulatePendingOvershoot(const QPointF& delta)
 
 void ViewportHandler::stopTouch()
 {
+    // 先发出还没到拍的累积量，抬起位置与已发出的移动一致
+    if (m_resample.timer && m_resample.timer->isActive()) {
+        if (m_state.touching) {
+            onMouseMoveTimer();
+        }
+        m_resample.timer->stop();
+    }
+    m_moveSendScheduled = false;
+    m_resample.predicted = false;
+
     if (m_state.centerRepressTimer)
         m_state.centerRepressTimer->stop();
     m_state.waitingForCenterRepress = false;
@@ -177,6 +248,8 @@ void ViewportHandler::resetView()
 
     m_smoothedDelta = {0, 0};
     m_subPixelAccum = {0, 0};
+    m_resample.velocity = {0, 0};
+    m_resample.predicted = false;
 }
 
 
@@ -190,7 +263,15 @@ void ViewportHandler::onMouseMoveTimer()
         return;
     }
 
-    if (m_pendingMoveDelta.isNull()) return;
+    if (m_pendingMoveDelta.isNull()) {
+        // 停止移动后的下一拍补发真实位置，外推量不留在设备上
+        if (m_resample.predicted && m_state.touching) {
+            m_resample.predicted = false;
+            m_resample.emittedMoves++;
+            sendFastTouch(FTA_MOVE, m_state.lastConverPos);
+        }
+        return;
+    }
 
     m_state.idleCenterCompleted = false;
     if (m_state.idleCenterTimer)
@@ -198,6 +279,20 @@ void ViewportHandler::onMouseMoveTimer()
 
     processMove(m_pendingMoveDelta);
     m_pendingMoveDelta = {0, 0};
+
+    if (m_resample.periodUs > 0) {
+        // 保持节拍相位，定时误差不累积；空闲后重新对齐
+        const qint64 now = qsc::ClockSync::nowUs();
+        if (now - m_resample.nextEmitUs > m_resample.periodUs) {
+            m_resample.nextEmitUs = now + m_resample.periodUs;
+        } else {
+            m_resample.nextEmitUs += m_resample.periodUs;
+        }
+        if (m_resample.predicted) {
+            m_moveSendScheduled = true;
+            m_resample.timer->startUs(qMax<qint64>(0, m_resample.nextEmitUs - now));
+        }
+    }
 }
 
 void ViewportHandler::processMove(const QPointF& delta)
@@ -233,6 +328,9 @@ void ViewportHandler::processMove(const QPointF& delta)
         sendFastTouch(FTA_MOVE, edgePos);
         sendFastTouch(FTA_UP, edgePos);
         m_state.touching = false;
+        m_resample.emittedMoves++;
+        m_resample.velocity = {0, 0};
+        m_resample.predicted = false;
 
         m_state.waitingForCenterRepress = true;
         m_state.pendingCenterPos = centerPos;
@@ -242,10 +340,47 @@ void ViewportHandler::processMove(const QPointF& delta)
     }
     m_state.lastConverPos = newPos;
     if (m_state.touching) {
-        sendFastTouch(FTA_MOVE, m_state.lastConverPos);
+        sendMove(m_state.lastConverPos, m_smoothedDelta);
     }
 }
 
+void ViewportHandler::sendMove(const QPointF& pos, const QPointF& step)
+{
+    constexpr double EDGE_MIN = 0.05, EDGE_MAX = 0.95;
+
+    const qint64 now = qsc::ClockSync::nowUs();
+    QPointF target = pos;
+    m_resample.predicted = false;
+
+    if (m_resample.predictUs > 0) {
+        // 速度取相邻两拍的平均；间隔过长（停顿后）重新估计
+        const qint64 dt = now - m_resample.lastEmitUs;
+        if (m_resample.lastEmitUs > 0 && dt > 0 && dt <= 4 * m_resample.periodUs) {
+            QPointF velocity = step / static_cast<double>(dt);
+            m_resample.velocity = m_resample.velocity.isNull() ? velocity : (velocity + m_resample.velocity) * 0.5;
+        } else {
+            m_resample.velocity = {0, 0};
+        }
+
+        // 外推量不超过一步的位移，避免停顿/急停时明显越过
+        QPointF ahead = m_resample.velocity * static_cast<double>(m_resample.predictUs);
+        const double aheadLen = std::hypot(ahead.x(), ahead.y());
+        const double stepLen = std::hypot(step.x(), step.y());
+        if (aheadLen > stepLen && aheadLen > 0.0) {
+            ahead *= stepLen / aheadLen;
+        }
+        if (!ahead.isNull()) {
+            target.setX(qBound(EDGE_MIN, pos.x() + ahead.x(), EDGE_MAX));
+            target.setY(qBound(EDGE_MIN, pos.y() + ahead.y(), EDGE_MAX));
+            m_resample.predicted = true;
+        }
+    }
+
+    m_resample.lastEmitUs = now;
+    m_resample.emittedMoves++;
+    sendFastTouch(FTA_MOVE, target);
+}
+
 void ViewportHandler::onCenterRepressTimer()
 {
     if (!m_state.waitingForCenterRepress || !m_keyMap) {
@@ -280,6 +415,9 @@ void ViewportHandler::onCenterRepressTimer()
     m_state.pendingOvershoot = {0, 0};
     m_smoothedDelta = {0, 0};
     m_subPixelAccum = {0, 0};
+    m_resample.velocity = {0, 0};
+    m_resample.lastEmitUs = 0;
+    m_resample.predicted = false;
 
     if (m_state.idleCenterTimer && !m_state.idleCenterCompleted)
         m_state.idleCenterTimer->start();
@@ -2,7 +2,7 @@
 #define VIEWPORTHANDLER_H
 
 #include "IInputHandler.h"
-#include <QTimer>
+#include "PreciseTimer.h"
 #include <QPointF>
 #include <QSize>
 #include <QMouseEvent>
@@ -20,6 +20,13 @@ class SessionContext;
  * - 边缘回中机制 / Edge re-centering mechanism
  * - 空闲回中机制 / Idle re-centering mechanism
  * - 随机偏移（防检测）/ Random offset (anti-detection)
+ * - 移动重采样（可选）/ Optional touch move resampling
+ *
+ * 重采样：默认每个鼠标增量立即发一条 FTA_MOVE，高回报率鼠标会刷满控制通道，
+ * 低回报率时触摸间隔又不均匀。键位节点设置 moveRateHz（如 120/240，对齐设备触控
+ * 采样率）后，增量在亚像素精度下累积，按固定节拍发出；方向反转时立即发出反转前
+ * 的累积量，甩枪拐点不被平均掉。predictMs > 0 时按近期速度外推一小段（不超过
+ * 一步的位移），停止移动后的下一拍补发真实位置。原始事件数/发出数在 reset() 时输出。
  */
 class ViewportHandler : public IInputHandler
 {
@@ -65,6 +72,10 @@ public:
     // 重置视角到中心（脚本调用）
     void resetView();
 
+    // 原始移动增量数 / 实际发出的 FTA_MOVE 数
+    quint64 rawMoveEvents() const { return m_resample.rawEvents; }
+    quint64 emittedMoves() const { return m_resample.emittedMoves; }
+
 private slots:
     void onMouseMoveTimer();
     void onCenterRepressTimer();
@@ -73,6 +84,8 @@ private slots:
 private:
     void sendFastTouch(quint8 action, const QPointF& pos);
     void processMove(const QPointF& delta);
+    void sendMove(const QPointF& pos, const QPointF& step);
+    void loadResampleConfig();
 
     // 注意：m_controller 和 m_sessionContext 继承自 IInputHandler
     KeyMap* m_keyMap = nullptr;
@@ -91,10 +104,10 @@ private:
         bool waitingForCenterRepress = false;
         QPointF pendingCenterPos;
         QPointF pendingOvershoot;
-        QTimer* centerRepressTimer = nullptr;
+        qsc::PreciseTimer* centerRepressTimer = nullptr;
 
         // 空闲回中定时器
-        QTimer* idleCenterTimer = nullptr;
+        qsc::PreciseTimer* idleCenterTimer = nullptr;
         bool idleCenterCompleted = false;  // 空闲回正已完成，等待鼠标移动
     } m_state;
 
@@ -113,6 +126,23 @@ private:
 
     QPointF m_smoothedDelta = {0, 0};   // EMA 平滑状态
     QPointF m_subPixelAccum = {0, 0};   // 亚像素精度累积
+
+    // ========== 移动重采样 ==========
+    static constexpr double MAX_MOVE_RATE_HZ = 1000.0;
+    static constexpr double MAX_PREDICT_MS = 20.0;
+
+    struct {
+        qint64 periodUs = 0;        // 0 = 不重采样
+        qint64 predictUs = 0;       // 0 = 不预测
+        qint64 nextEmitUs = 0;      // 下一拍时间（保持相位，平均间隔等于周期）
+        qint64 lastEmitUs = 0;
+        QPointF velocity = {0, 0};  // 归一化坐标 / µs
+        bool predicted = false;     // 上次发出的是外推位置
+        qsc::PreciseTimer* timer = nullptr;
+
+        quint64 rawEvents = 0;
+        quint64 emittedMoves = 0;
+    } m_resample;
 };
 
 #endif // VIEWPORTHANDLER_H
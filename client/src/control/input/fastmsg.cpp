@@ -1,5 +1,7 @@
 #include "fastmsg.h"
 
+#include <cstring>
+
 std::atomic<quint32> FastTouchSeq::s_counter{0};
 
 // ========== Touch (RESET=1B, 其余=6B) ==========
@@ -70,7 +72,129 @@ QByteArray FastMsg::keyClick(quint16 keycode) {
     return QByteArray(buf, 6);
 }
 
+QByteArray FastMsg::fecReport(quint16 lossPermille, quint8 avgBurstX10, quint8 maxBurst,
+                              quint16 recovered, quint16 unrecovered) {
+    char buf[9];
+    buf[0] = static_cast<char>(FMT_FEC_REPORT);
+    buf[1] = static_cast<char>((lossPermille >> 8) & 0xFF);
+    buf[2] = static_cast<char>(lossPermille & 0xFF);
+    buf[3] = static_cast<char>(avgBurstX10);
+    buf[4] = static_cast<char>(maxBurst);
+    buf[5] = static_cast<char>((recovered >> 8) & 0xFF);
+    buf[6] = static_cast<char>(recovered & 0xFF);
+    buf[7] = static_cast<char>((unrecovered >> 8) & 0xFF);
+    buf[8] = static_cast<char>(unrecovered & 0xFF);
+    return QByteArray(buf, 9);
+}
+
+QByteArray FastMsg::requestKeyFrame() {
+    char buf[1] = { static_cast<char>(FMT_REQUEST_KEYFRAME) };
+    return QByteArray(buf, 1);
+}
+
+QByteArray FastMsg::bitrateTarget(quint32 bitrateBps) {
+    char buf[5];
+    buf[0] = static_cast<char>(FMT_BITRATE_TARGET);
+    buf[1] = static_cast<char>((bitrateBps >> 24) & 0xFF);
+    buf[2] = static_cast<char>((bitrateBps >> 16) & 0xFF);
+    buf[3] = static_cast<char>((bitrateBps >> 8) & 0xFF);
+    buf[4] = static_cast<char>(bitrateBps & 0xFF);
+    return QByteArray(buf, 5);
+}
+
+QByteArray FastMsg::videoFeedback(quint32 seq, quint32 recvTimeUs, quint32 recvBytes) {
+    char buf[13];
+    buf[0] = static_cast<char>(FMT_VIDEO_FEEDBACK);
+    const quint32 fields[3] = { seq, recvTimeUs, recvBytes };
+    for (int i = 0; i < 3; ++i) {
+        buf[1 + i * 4] = static_cast<char>((fields[i] >> 24) & 0xFF);
+        buf[2 + i * 4] = static_cast<char>((fields[i] >> 16) & 0xFF);
+        buf[3 + i * 4] = static_cast<char>((fields[i] >> 8) & 0xFF);
+        buf[4 + i * 4] = static_cast<char>(fields[i] & 0xFF);
+    }
+    return QByteArray(buf, 13);
+}
+
+QByteArray FastMsg::ping(qint64 clientTimeUs) {
+    char buf[9];
+    buf[0] = static_cast<char>(FMT_PING);
+    for (int i = 0; i < 8; ++i) {
+        buf[1 + i] = static_cast<char>((static_cast<quint64>(clientTimeUs) >> (56 - 8 * i)) & 0xFF);
+    }
+    return QByteArray(buf, 9);
+}
+
 QByteArray FastMsg::disconnect() {
     char buf[1] = { static_cast<char>(FMT_DISCONNECT) };
     return QByteArray(buf, 1);
 }
+
+int FastMsg::serializeLaneMoveInto(char* buf, const char* touchMove, quint32 laneSeq, quint8 downGen) {
+    buf[0] = static_cast<char>(FMT_TOUCH_MOVE_SEQ);
+    buf[1] = static_cast<char>((laneSeq >> 24) & 0xFF);
+    buf[2] = static_cast<char>((laneSeq >> 16) & 0xFF);
+    buf[3] = static_cast<char>((laneSeq >> 8) & 0xFF);
+    buf[4] = static_cast<char>(laneSeq & 0xFF);
+    buf[5] = static_cast<char>(downGen);
+    // seqId(1)+x(2)+y(2) 原样沿用
+    memcpy(buf + 6, touchMove + 1, 5);
+    return 11;
+}
+
+int FastMsg::serializePathDupInto(char* buf, quint32 pathSeq, const char* msg, int len) {
+    buf[0] = static_cast<char>(FMT_PATH_DUP);
+    buf[1] = static_cast<char>((pathSeq >> 24) & 0xFF);
+    buf[2] = static_cast<char>((pathSeq >> 16) & 0xFF);
+    buf[3] = static_cast<char>((pathSeq >> 8) & 0xFF);
+    buf[4] = static_cast<char>(pathSeq & 0xFF);
+    memcpy(buf + 5, msg, static_cast<size_t>(len));
+    return 5 + len;
+}
+
+int FastMsg::messageSize(const char* data, int len) {
+    if (len <= 0) return 0;
+    int size = 0;
+    switch (static_cast<quint8>(data[0])) {
+    case FMT_TOUCH_DOWN:
+    case FMT_TOUCH_UP:
+    case FMT_TOUCH_MOVE:
+        size = 6;
+        break;
+    case FMT_TOUCH_RESET:
+    case FMT_REQUEST_KEYFRAME:
+    case FMT_DISCONNECT:
+        size = 1;
+        break;
+    case FMT_KEY_DOWN:
+    case FMT_KEY_UP:
+        size = 3;
+        break;
+    case FMT_BATCH:
+        if (len < 2) return 0;
+        size = 2 + 6 * static_cast<quint8>(data[1]);
+        break;
+    case FMT_FEC_REPORT:
+    case FMT_PING:
+        size = 9;
+        break;
+    case FMT_BITRATE_TARGET:
+        size = 5;
+        break;
+    case FMT_TOUCH_MOVE_SEQ:
+        size = 11;
+        break;
+    case FMT_VIDEO_FEEDBACK:
+        size = 13;
+        break;
+    case FMT_PATH_DUP: {
+        if (len < 6 || static_cast<quint8>(data[5]) == FMT_PATH_DUP) return 0;
+        const int inner = messageSize(data + 5, len - 5);
+        if (inner == 0) return 0;
+        size = 5 + inner;
+        break;
+    }
+    default:
+        return 0;
+    }
+    return size <= len ? size : 0;
+}
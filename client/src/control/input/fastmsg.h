@@ -28,6 +28,13 @@ enum FastMsgType : quint8 {
     FMT_KEY_DOWN    = 14,   // keycode(2) = 总 3B
     FMT_KEY_UP      = 15,   // keycode(2) = 总 3B
     FMT_BATCH       = 16,   // count(1)+[seqId(1)+action(1)+x(2)+y(2)]*N = 2+6N
+    FMT_FEC_REPORT  = 17,   // loss(2)+avgBurst(1)+maxBurst(1)+recovered(2)+unrecovered(2) = 总 9B
+    FMT_REQUEST_KEYFRAME = 18, // 无载荷 = 总 1B
+    FMT_BITRATE_TARGET = 19,   // bitrate(4) = 总 5B
+    FMT_PING        = 20,   // clientTimeUs(8) = 总 9B，设备回 PONG
+    FMT_TOUCH_MOVE_SEQ = 21, // laneSeq(4)+downGen(1)+seqId(1)+x(2)+y(2) = 总 11B，只走不可靠通道
+    FMT_PATH_DUP    = 22,   // pathSeq(4)+内层消息 = 5+N B，多路径重复发送，设备按 pathSeq 去重
+    FMT_VIDEO_FEEDBACK = 23, // seq(4)+recvTimeUs(4)+recvBytes(4) = 总 13B，视频发送端拥塞控制反馈
     FMT_DISCONNECT  = 0xFF, // 无载荷 = 总 1B
 };
 
@@ -86,8 +93,33 @@ public:
     /// 按键点击 (DOWN+UP): 6B
     static QByteArray keyClick(quint16 keycode);
 
+    /// 视频丢包回报: 9B
+    static QByteArray fecReport(quint16 lossPermille, quint8 avgBurstX10, quint8 maxBurst,
+                                quint16 recovered, quint16 unrecovered);
+
+    /// 请求关键帧: 1B
+    static QByteArray requestKeyFrame();
+
+    /// 接收端估计的目标码率 (bps): 5B
+    static QByteArray bitrateTarget(quint32 bitrateBps);
+
+    /// 视频传输反馈 (最大序号、其到达时刻的客户端时钟低 32 位、区间内收到的字节数): 13B
+    static QByteArray videoFeedback(quint32 seq, quint32 recvTimeUs, quint32 recvBytes);
+
+    /// 时钟同步请求 (客户端单调时钟, 微秒): 9B
+    static QByteArray ping(qint64 clientTimeUs);
+
     /// 断开连接: 1B
     static QByteArray disconnect();
+
+    /// 不可靠通道 MOVE: 由 6B 的 FMT_TOUCH_MOVE 加上通道序号和该触摸点的 DOWN 计数，11B
+    static int serializeLaneMoveInto(char* buf, const char* touchMove, quint32 laneSeq, quint8 downGen);
+
+    /// 多路径重复发送的包装: [FMT_PATH_DUP][pathSeq(4)][内层消息]，返回写入字节数
+    static int serializePathDupInto(char* buf, quint32 pathSeq, const char* msg, int len);
+
+    /// 首条消息的长度，数据不足或类型未知返回 0
+    static int messageSize(const char* data, int len);
 };
 
 // ---- 全局 seqId 生成器 (线程安全, 0-255 循环) ----
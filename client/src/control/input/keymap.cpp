@@ -18,7 +18,17 @@
 
 
 
-KeyMap::KeyMap(QObject *parent) : QObject(parent) {}
+KeyMap::KeyMap(QObject *parent)
+
+    : QObject(parent)
+
+    , m_table(std::make_shared<Table>())
+
+{
+
+    m_current.store(m_table.get(), std::memory_order_release);
+
+}
 
 
 
@@ -28,6 +38,54 @@ KeyMap::~KeyMap() {}
 
 void KeyMap::loadKeyMap(const QString &json)
 
+{
+
+    install(compile(json));
+
+}
+
+
+
+std::shared_ptr<const KeyMap::Table> KeyMap::compile(const QString &json)
+
+{
+
+    // 临时解析器：解析状态不落在正在使用的 KeyMap 上，可在任意线程编译
+
+    KeyMap parser;
+
+    parser.parseKeyMap(json);
+
+    return parser.buildTable();
+
+}
+
+
+
+void KeyMap::install(std::shared_ptr<const Table> table)
+
+{
+
+    if (!table) {
+
+        return;
+
+    }
+
+    // 上一代表保留到下一次安装：热替换时会话不重建，排队中的回调可能仍持有上一代节点的引用
+
+    m_retired = std::move(m_table);
+
+    m_table = std::move(table);
+
+    m_current.store(m_table.get(), std::memory_order_release);
+
+}
+
+
+
+void KeyMap::parseKeyMap(const QString &json)
+
 {
 
     QString errorString;
@@ -146,6 +204,10 @@ void KeyMap::loadKeyMap(const QString &json)
 
             keyMapNode.data.mouseMove.startPos = getItemPos(mouseMoveMap, "startPos");
 
+            keyMapNode.data.mouseMove.moveRateHz = checkItemDouble(mouseMoveMap, "moveRateHz") ? getItemDouble(mouseMoveMap, "moveRateHz") : 0.0;
+
+            keyMapNode.data.mouseMove.predictMs = checkItemDouble(mouseMoveMap, "predictMs") ? getItemDouble(mouseMoveMap, "predictMs") : 0.0;
+
             m_idxMouseMove = m_keyMapNodes.size();
 
             m_keyMapNodes.push_back(keyMapNode);
@@ -326,6 +388,12 @@ void KeyMap::loadKeyMap(const QString &json)
 
                 keyMapNode.data.mouseMove.speedRatio.setY(getItemDouble(node, "speedRatioY"));
 
+                // 可选：移动重采样频率 / 外推时长（见 ViewportHandler）
+
+                keyMapNode.data.mouseMove.moveRateHz = checkItemDouble(node, "moveRateHz") ? getItemDouble(node, "moveRateHz") : 0.0;
+
+                keyMapNode.data.mouseMove.predictMs = checkItemDouble(node, "predictMs") ? getItemDouble(node, "predictMs") : 0.0;
+
 
 
                 // 记录索引，让 isValidMouseMoveMap() 返回 true
@@ -390,8 +458,6 @@ void KeyMap::loadKeyMap(const QString &json)
 
 
 
-    makeReverseMap();
-
 
 
 parseError:
@@ -412,15 +478,17 @@ const KeyMap::KeyMapNode &KeyMap::getKeyMapNode(int key)
 
 {
 
-    auto p = m_rmapKey.value(key, &m_invalidNode);
+    const Table *t = table();
+
+    const KeyMapNode *p = t->lookupKey(key, Qt::NoModifier, true);
 
-    if (p == &m_invalidNode) {
+    if (!p) {
 
-        return *m_rmapMouse.value(key, &m_invalidNode);
+        p = t->lookupMouse(key);
 
     }
 
-    return *p;
+    return p ? *p : m_invalidNode;
 
 }
 
@@ -430,37 +498,11 @@ const KeyMap::KeyMapNode &KeyMap::getKeyMapNodeKey(int key, Qt::KeyboardModifier
 
 {
 
-    // 首先尝试精确匹配（带修饰键）
-
-    qint64 hash = makeKeyHash(key, modifiers);
-
-    KeyMapNode *p = m_rmapKey.value(hash, nullptr);
-
-    if (p) {
-
-        return *p;
-
-    }
-
-
-
-    // 如果没有精确匹配，尝试仅匹配按键（无修饰键）
-
-    // 这样可以兼容旧的配置
-
-    hash = makeKeyHash(key, Qt::NoModifier);
-
-    p = m_rmapKey.value(hash, nullptr);
-
-    if (p) {
+    // 精确匹配（带修饰键）优先，否则回退到仅匹配按键（兼容旧配置）；回退已在编译时展开
 
-        return *p;
+    const KeyMapNode *p = table()->lookupKey(key, modifiers, false);
 
-    }
-
-
-
-    return m_invalidNode;
+    return p ? *p : m_invalidNode;
 
 }
 
@@ -470,7 +512,9 @@ const KeyMap::KeyMapNode &KeyMap::getKeyMapNodeMouse(int key)
 
 {
 
-    return *m_rmapMouse.value(key, &m_invalidNode);
+    const KeyMapNode *p = table()->lookupMouse(key);
+
+    return p ? *p : m_invalidNode;
 
 }
 
@@ -580,7 +624,7 @@ bool KeyMap::isSwitchOnKeyboard()
 
 {
 
-    return m_switchKey.type == AT_KEY;
+    return table()->switchKey.type == AT_KEY;
 
 }
 
@@ -590,7 +634,7 @@ int KeyMap::getSwitchKey()
 
 {
 
-    return m_switchKey.key;
+    return table()->switchKey.key;
 
 }
 
@@ -600,7 +644,7 @@ bool KeyMap::isValidMouseMoveMap()
 
 {
 
-    return m_idxMouseMove != -1;
+    return table()->idxMouseMove != -1;
 
 }
 
@@ -610,7 +654,7 @@ bool KeyMap::isValidSteerWheelMap()
 
 {
 
-    return m_idxSteerWheel != -1;
+    return table()->idxSteerWheel != -1;
 
 }
 
@@ -620,9 +664,11 @@ const KeyMap::KeyMapNode &KeyMap::getMouseMoveMap()
 
 {
 
-    if (m_idxMouseMove >= 0 && m_idxMouseMove < m_keyMapNodes.size()) {
+    const Table *t = table();
+
+    if (t->idxMouseMove >= 0 && t->idxMouseMove < t->nodes.size()) {
 
-        return m_keyMapNodes[m_idxMouseMove];
+        return t->nodes[t->idxMouseMove];
 
     }
 
@@ -661,19 +707,21 @@ double KeyMap::getSteerWheelCoefficient(int direction) const
 
 const KeyMap::KeyMapNode* KeyMap::getSteerWheelNode() const
 {
-    if (m_idxSteerWheel >= 0 && m_idxSteerWheel < m_keyMapNodes.size()) {
-        return &m_keyMapNodes[m_idxSteerWheel];
+    const Table *t = table();
+    if (t->idxSteerWheel >= 0 && t->idxSteerWheel < t->nodes.size()) {
+        return &t->nodes[t->idxSteerWheel];
     }
     return nullptr;
 }
 
 double KeyMap::getSteerWheelOffset(int direction) const
 {
-    if (m_idxSteerWheel < 0 || m_idxSteerWheel >= m_keyMapNodes.size()) {
+    const KeyMapNode *steerWheel = getSteerWheelNode();
+    if (!steerWheel) {
         return 0.0;
     }
 
-    const KeyMapNode &node = m_keyMapNodes[m_idxSteerWheel];
+    const KeyMapNode &node = *steerWheel;
     double baseOffset = 0.0;
 
     switch (direction) {
@@ -690,126 +738,134 @@ double KeyMap::getSteerWheelOffset(int direction) const
 
 
 
-void KeyMap::makeReverseMap()
+// ---------------------------------------------------------
+// 编译后的键位表
+// ---------------------------------------------------------
 
+int KeyMap::Table::keySlot(int key)
 {
+    if (key >= 0 && key < 0x100) {
+        return key;
+    }
+    // 特殊键 Qt::Key_Escape(0x01000000) 起的一段
+    if ((key & ~0x1FF) == 0x01000000) {
+        return 0x100 + (key & 0x1FF);
+    }
+    return -1;
+}
 
-    m_rmapKey.clear();
-
-    m_rmapMouse.clear();
+int KeyMap::Table::modMask(Qt::KeyboardModifiers modifiers)
+{
+    // Shift/Ctrl/Alt/Meta 在 Qt::KeyboardModifier 中是连续的 4 位（0x02000000 起）
+    return static_cast<int>((static_cast<uint>(modifiers) >> 25) & (MOD_MASKS - 1));
+}
 
-    for (int i = 0; i < m_keyMapNodes.size(); ++i) {
+int KeyMap::Table::mouseSlot(int key)
+{
+    if (key == WHEEL_UP) return MOUSE_SLOTS - 2;
+    if (key == WHEEL_DOWN) return MOUSE_SLOTS - 1;
+    const uint bits = static_cast<uint>(key);
+    if (bits == 0 || (bits & (bits - 1)) != 0) {
+        return -1;  // 只接受单个按键位
+    }
+    int slot = 0;
+    while (!(bits & (1u << slot))) ++slot;
+    return slot;
+}
 
-        auto &node = m_keyMapNodes[i];
+const KeyMap::KeyMapNode *KeyMap::Table::lookupKey(int key, Qt::KeyboardModifiers modifiers, bool exact) const
+{
+    const int slot = keySlot(key);
+    const bool dense = slot >= 0 && (static_cast<uint>(modifiers) & ~MOD_BITS) == 0;
+    if (dense) {
+        const int mask = modMask(modifiers);
+        const quint16 idx = exact ? keysExact[slot][mask] : keys[slot][mask];
+        return idx ? &nodes[idx - 1] : nullptr;
+    }
 
-        switch (node.type) {
+    // 稠密表之外：超出范围的按键或带 Keypad 等其他修饰位，按原哈希规则查找
+    int idx = sparseKeys.value(makeKeyHash(key, modifiers), 0);
+    if (!idx && !exact) {
+        idx = (slot >= 0) ? keys[slot][0] : sparseKeys.value(makeKeyHash(key, Qt::NoModifier), 0);
+    }
+    return idx ? &nodes[idx - 1] : nullptr;
+}
 
+const KeyMap::KeyMapNode *KeyMap::Table::lookupMouse(int key) const
+{
+    const int slot = mouseSlot(key);
+    if (slot >= 0) {
+        return mouse[slot] ? &nodes[mouse[slot] - 1] : nullptr;
+    }
+    const int idx = sparseMouse.value(key, 0);
+    return idx ? &nodes[idx - 1] : nullptr;
+}
 
+void KeyMap::Table::bind(const KeyNode &keyNode, int index)
+{
+    // 同一按键重复绑定时后出现的节点生效（与原反查表 QMultiHash::value 一致）
+    const quint16 idx = static_cast<quint16>(index + 1);
+    if (keyNode.type == AT_KEY) {
+        const int slot = keySlot(keyNode.key);
+        if (slot >= 0 && (static_cast<uint>(keyNode.modifiers) & ~MOD_BITS) == 0) {
+            keysExact[slot][modMask(keyNode.modifiers)] = idx;
+        } else {
+            sparseKeys.insert(makeKeyHash(keyNode.key, keyNode.modifiers), idx);
+        }
+    } else {
+        const int slot = mouseSlot(keyNode.key);
+        if (slot >= 0) {
+            mouse[slot] = idx;
+        } else {
+            sparseMouse.insert(keyNode.key, idx);
+        }
+    }
+}
 
-        case KMT_STEER_WHEEL: {
+std::shared_ptr<const KeyMap::Table> KeyMap::buildTable()
+{
+    auto t = std::make_shared<Table>();
+    t->nodes = m_keyMapNodes;
+    t->switchKey = m_switchKey;
+    t->idxSteerWheel = m_idxSteerWheel;
+    t->idxMouseMove = m_idxMouseMove;
+
+    if (t->nodes.size() >= 0xFFFF) {
+        qWarning() << "json error: too many keymap nodes" << t->nodes.size();
+        t->nodes.resize(0xFFFE);
+    }
 
+    for (int i = 0; i < t->nodes.size(); ++i) {
+        const KeyMapNode &node = t->nodes[i];
+        switch (node.type) {
+        case KMT_STEER_WHEEL:
             // 方向盘的四个方向键
-
-            if (node.data.steerWheel.left.type == AT_KEY) {
-
-                m_rmapKey.insert(makeKeyHash(node.data.steerWheel.left.key, node.data.steerWheel.left.modifiers), &node);
-
-            } else {
-
-                m_rmapMouse.insert(node.data.steerWheel.left.key, &node);
-
-            }
-
-            if (node.data.steerWheel.right.type == AT_KEY) {
-
-                m_rmapKey.insert(makeKeyHash(node.data.steerWheel.right.key, node.data.steerWheel.right.modifiers), &node);
-
-            } else {
-
-                m_rmapMouse.insert(node.data.steerWheel.right.key, &node);
-
-            }
-
-            if (node.data.steerWheel.up.type == AT_KEY) {
-
-                m_rmapKey.insert(makeKeyHash(node.data.steerWheel.up.key, node.data.steerWheel.up.modifiers), &node);
-
-            } else {
-
-                m_rmapMouse.insert(node.data.steerWheel.up.key, &node);
-
-            }
-
-            if (node.data.steerWheel.down.type == AT_KEY) {
-
-                m_rmapKey.insert(makeKeyHash(node.data.steerWheel.down.key, node.data.steerWheel.down.modifiers), &node);
-
-            } else {
-
-                m_rmapMouse.insert(node.data.steerWheel.down.key, &node);
-
-            }
-
-        } break;
-
-
-
-        case KMT_ANDROID_KEY: {
-
-            if (node.data.androidKey.keyNode.type == AT_KEY) {
-
-                m_rmapKey.insert(makeKeyHash(node.data.androidKey.keyNode.key, node.data.androidKey.keyNode.modifiers), &node);
-
-            } else {
-
-                m_rmapMouse.insert(node.data.androidKey.keyNode.key, &node);
-
-            }
-
-        } break;
-
-
-
-        case KMT_SCRIPT: {
-
-            if (node.data.script.keyNode.type == AT_KEY) {
-
-                m_rmapKey.insert(makeKeyHash(node.data.script.keyNode.key, node.data.script.keyNode.modifiers), &node);
-
-            } else {
-
-                m_rmapMouse.insert(node.data.script.keyNode.key, &node);
-
-            }
-
-        } break;
-
-
-
-        case KMT_FREE_LOOK: {
-
-            if (node.data.freeLook.keyNode.type == AT_KEY) {
-
-                m_rmapKey.insert(makeKeyHash(node.data.freeLook.keyNode.key, node.data.freeLook.keyNode.modifiers), &node);
-
-            } else {
-
-                m_rmapMouse.insert(node.data.freeLook.keyNode.key, &node);
-
-            }
-
-        } break;
-
-
-
+            t->bind(node.data.steerWheel.left, i);
+            t->bind(node.data.steerWheel.right, i);
+            t->bind(node.data.steerWheel.up, i);
+            t->bind(node.data.steerWheel.down, i);
+            break;
+        case KMT_ANDROID_KEY:
+            t->bind(node.data.androidKey.keyNode, i);
+            break;
+        case KMT_SCRIPT:
+            t->bind(node.data.script.keyNode, i);
+            break;
+        case KMT_FREE_LOOK:
+            t->bind(node.data.freeLook.keyNode, i);
+            break;
         default:
-
             break;
-
         }
-
     }
 
+    // 展开修饰键回退：组合没有精确绑定时直接指向无修饰键绑定，查找只需一次数组访问
+    for (int slot = 0; slot < Table::KEY_SLOTS; ++slot) {
+        for (int mask = 0; mask < Table::MOD_MASKS; ++mask) {
+            t->keys[slot][mask] = t->keysExact[slot][mask] ? t->keysExact[slot][mask] : t->keysExact[slot][0];
+        }
+    }
+    return t;
 }
 
 
@@ -2,12 +2,12 @@
 
 #define KEYMAP_H
 
+#include <QHash>
+
 #include <QJsonObject>
 
 #include <QMetaEnum>
 
-#include <QMultiHash>
-
 #include <QObject>
 
 #include <QPair>
@@ -18,6 +18,10 @@
 
 #include <QVector>
 
+#include <atomic>
+
+#include <memory>
+
 
 
 #include "keycodes.h"
@@ -31,6 +35,9 @@ constexpr int WHEEL_DOWN = 0x10000002;
  *
  * 解析脚本中的按键绑定配置，将键盘/鼠标事件映射为 Android 触摸/按键操作。
  * Parses key binding configs from scripts, maps keyboard/mouse events to Android touch/key actions.
+ *
+ * 解析结果编译为只读的 Table（稠密数组按 键码×修饰键掩码 直接索引到节点），热重载时在
+ * 任意线程 compile() 好新表，再由输入线程 install() 原子替换当前表指针，查找路径不加锁、不哈希。
  */
 class KeyMap : public QObject
 
@@ -174,6 +181,10 @@ public:
 
                 QPointF speedRatio = { 1.0, 1.0 };
 
+                double moveRateHz = 0.0;   // 移动重采样频率，0 = 每个增量立即发送
+
+                double predictMs = 0.0;    // 移动外推时长，0 = 不预测
+
             } mouseMove;
 
 
@@ -224,6 +235,43 @@ public:
 
     };
 
+    /**
+     * @brief 编译后的键位表 / Compiled, immutable dispatch table
+     *
+     * 节点中的位置在解析时已归一化，表内只保存 节点索引 + 1（0 表示未绑定）：
+     * - keys：普通键（< 0x100）与 Qt 特殊键段（0x01000000 起 0x200 个）× Shift/Ctrl/Alt/Meta 16 种组合，
+     *   组合未精确绑定时已在编译时回退到无修饰键绑定
+     * - keysExact：同上但不回退（getKeyMapNode 的精确语义）
+     * - mouse：单个鼠标按键位 + 滚轮上/下
+     * 其余按键或带 Keypad 等修饰位的组合走 sparseKeys/sparseMouse 哈希（极少出现）。
+     */
+    struct Table {
+        static constexpr int KEY_SLOTS = 0x300;
+        static constexpr int MOD_MASKS = 16;
+        static constexpr int MOUSE_SLOTS = 34;
+        static constexpr uint MOD_BITS = 0x1E000000;    // Shift | Control | Alt | Meta
+
+        QVector<KeyMapNode> nodes;
+        KeyNode switchKey = { AT_KEY, Qt::Key_QuoteLeft };
+        int idxSteerWheel = -1;
+        int idxMouseMove = -1;
+
+        quint16 keys[KEY_SLOTS][MOD_MASKS] = {};
+        quint16 keysExact[KEY_SLOTS][MOD_MASKS] = {};
+        quint16 mouse[MOUSE_SLOTS] = {};
+        QHash<qint64, int> sparseKeys;
+        QHash<int, int> sparseMouse;
+
+        // exact=false 时组合键未绑定回退到无修饰键绑定
+        const KeyMapNode *lookupKey(int key, Qt::KeyboardModifiers modifiers, bool exact) const;
+        const KeyMapNode *lookupMouse(int key) const;
+        void bind(const KeyNode &keyNode, int index);
+
+        static int keySlot(int key);
+        static int modMask(Qt::KeyboardModifiers modifiers);
+        static int mouseSlot(int key);
+    };
+
 
 
     KeyMap(QObject *parent = Q_NULLPTR);
@@ -234,6 +282,12 @@ public:
 
     void loadKeyMap(const QString &json);
 
+    // 解析并编译键位表（不修改任何 KeyMap 实例，可在任意线程调用）
+    static std::shared_ptr<const Table> compile(const QString &json);
+
+    // 替换当前键位表（在使用本 KeyMap 的线程调用；上一代表保留到下一次替换）
+    void install(std::shared_ptr<const Table> table);
+
     const KeyMap::KeyMapNode &getKeyMapNode(int key);
 
     const KeyMap::KeyMapNode &getKeyMapNodeKey(int key, Qt::KeyboardModifiers modifiers = Qt::NoModifier);
@@ -244,7 +298,7 @@ public:
     const KeyMap::KeyMapNode &getKeyMapNodeByDisplayName(const QString& displayName);
 
     // 获取所有键位节点（供自动启动脚本检测使用）
-    const QVector<KeyMapNode>& getKeyMapNodes() const { return m_keyMapNodes; }
+    const QVector<KeyMapNode>& getKeyMapNodes() const { return table()->nodes; }
 
     bool isSwitchOnKeyboard();
 
@@ -287,7 +341,11 @@ public:
 
 private:
 
-    void makeReverseMap();
+    void parseKeyMap(const QString &json);
+
+    std::shared_ptr<const Table> buildTable();
+
+    const Table *table() const { return m_current.load(std::memory_order_acquire); }
 
 
 
@@ -337,6 +395,7 @@ private:
 
 
 
+    // 解析状态（仅 compile() 的临时解析器使用，查找一律走 m_current）
     QVector<KeyMapNode> m_keyMapNodes;
 
     KeyNode m_switchKey = { AT_KEY, Qt::Key_QuoteLeft };
@@ -365,15 +424,17 @@ private:
 
 
 
-    // 使用 qint64 作为键，低32位存储 key，高32位存储 modifiers
+    // 当前键位表；m_retired 为上一代，延后一次替换再释放
+
+    std::shared_ptr<const Table> m_table;
 
-    QMultiHash<qint64, KeyMapNode *> m_rmapKey;
+    std::shared_ptr<const Table> m_retired;
 
-    QMultiHash<int, KeyMapNode *> m_rmapMouse;
+    std::atomic<const Table *> m_current{nullptr};
 
 
 
-    // 辅助函数：组合 key 和 modifiers 为查找键
+    // 辅助函数：组合 key 和 modifiers 为查找键（低32位存储 key，高32位存储 modifiers）
 
     static qint64 makeKeyHash(int key, Qt::KeyboardModifiers modifiers) {
 
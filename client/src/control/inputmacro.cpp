@@ -0,0 +1,386 @@
+#include <QDebug>
+#include <QFileInfo>
+#include <cmath>
+#include <cstring>
+
+#include "inputmacro.h"
+#include "controlsender.h"
+#include "fastmsg.h"
+#include "ClockSync.h"
+#include "PreciseTimer.h"
+
+// ---------------------------------------------------------
+// 编码辅助
+// ---------------------------------------------------------
+
+static void appendVarint(QByteArray &buf, quint64 value)
+{
+    while (value >= 0x80) {
+        buf.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buf.append(static_cast<char>(value));
+}
+
+static bool readVarint(const QByteArray &buf, int &pos, quint64 &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < buf.size(); shift += 7) {
+        const quint8 b = static_cast<quint8>(buf.at(pos++));
+        value |= static_cast<quint64>(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void putU16(char *p, quint16 v)
+{
+    p[0] = static_cast<char>((v >> 8) & 0xFF);
+    p[1] = static_cast<char>(v & 0xFF);
+}
+
+static quint16 getU16(const char *p)
+{
+    return static_cast<quint16>((static_cast<quint8>(p[0]) << 8) | static_cast<quint8>(p[1]));
+}
+
+bool InputMacro::isInputMessage(quint8 type)
+{
+    switch (type) {
+    case FMT_TOUCH_DOWN:
+    case FMT_TOUCH_UP:
+    case FMT_TOUCH_MOVE:
+    case FMT_TOUCH_RESET:
+    case FMT_KEY_DOWN:
+    case FMT_KEY_UP:
+    case FMT_BATCH:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ---------------------------------------------------------
+// InputMacroRecorder
+// ---------------------------------------------------------
+
+InputMacroRecorder::~InputMacroRecorder()
+{
+    close();
+}
+
+bool InputMacroRecorder::open(const QString &path, const QSize &deviceSize)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[InputMacro] Cannot open record file:" << path << m_file.errorString();
+        return false;
+    }
+
+    m_buf.clear();
+    m_buf.reserve(FLUSH_BYTES + 256);
+    char header[InputMacro::HEADER_SIZE] = {};
+    memcpy(header, InputMacro::MAGIC, 4);
+    header[4] = static_cast<char>(InputMacro::VERSION);
+    putU16(header + 6, static_cast<quint16>(qBound(0, deviceSize.width(), 0xFFFF)));
+    putU16(header + 8, static_cast<quint16>(qBound(0, deviceSize.height(), 0xFFFF)));
+    m_buf.append(header, InputMacro::HEADER_SIZE);
+
+    m_startUs = qsc::ClockSync::nowUs();
+    m_lastUs = m_startUs;
+    m_records = 0;
+    qInfo() << "[InputMacro] Recording to" << QFileInfo(path).absoluteFilePath() << "device" << deviceSize;
+    return true;
+}
+
+void InputMacroRecorder::record(const char *data, int len)
+{
+    if (!m_file.isOpen() || !data || len <= 0) {
+        return;
+    }
+
+    // 逐条过滤，只保留输入消息
+    m_msg.resize(0);
+    const char *p = data;
+    int left = len;
+    while (left > 0) {
+        const int size = FastMsg::messageSize(p, left);
+        if (size <= 0) {
+            break;
+        }
+        if (InputMacro::isInputMessage(static_cast<quint8>(p[0]))) {
+            m_msg.append(p, size);
+        }
+        p += size;
+        left -= size;
+    }
+    if (m_msg.isEmpty()) {
+        return;
+    }
+
+    const qint64 nowUs = qsc::ClockSync::nowUs();
+    appendVarint(m_buf, static_cast<quint64>(qMax<qint64>(nowUs - m_lastUs, 0)));
+    appendVarint(m_buf, static_cast<quint64>(m_msg.size()));
+    m_buf.append(m_msg);
+    m_lastUs = nowUs;
+    m_records++;
+
+    if (m_buf.size() >= FLUSH_BYTES) {
+        flush();
+    }
+}
+
+void InputMacroRecorder::close()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    flush();
+    const qint64 bytes = m_file.size();
+    m_file.close();
+    qInfo("[InputMacro] Recorded %llu records, %lld bytes, %.1f s",
+          static_cast<unsigned long long>(m_records), static_cast<long long>(bytes),
+          (m_lastUs - m_startUs) / 1e6);
+}
+
+void InputMacroRecorder::flush()
+{
+    if (m_buf.isEmpty()) {
+        return;
+    }
+    if (m_file.write(m_buf) != m_buf.size()) {
+        qWarning() << "[InputMacro] Write failed:" << m_file.errorString();
+    }
+    m_buf.resize(0);
+}
+
+// ---------------------------------------------------------
+// InputMacroPlayer
+// ---------------------------------------------------------
+
+InputMacroPlayer::InputMacroPlayer(ControlSender *sender, QObject *parent)
+    : QObject(parent)
+    , m_sender(sender)
+{
+    m_timer = new qsc::PreciseTimer(this);
+    m_timer->setSingleShot(true);
+    connect(m_timer, &qsc::PreciseTimer::timeout, this, &InputMacroPlayer::onTimer);
+}
+
+InputMacroPlayer::~InputMacroPlayer()
+{
+    stop();
+}
+
+bool InputMacroPlayer::play(const QString &path, const QSize &deviceSize, double speed)
+{
+    stop();
+
+    QSize recordedSize;
+    if (!load(path, recordedSize)) {
+        return false;
+    }
+    if (m_events.isEmpty()) {
+        qWarning() << "[InputMacro] No input in macro:" << path;
+        return false;
+    }
+
+    m_speed = (speed > 0.0) ? speed : 1.0;
+    setupRemap(recordedSize, deviceSize);
+    memset(m_touchDown, 0, sizeof(m_touchDown));
+    m_lateness.reset();
+    m_rebases = 0;
+    m_next = 0;
+    m_startNs = qsc::PreciseScheduler::nowNs();
+
+    qInfo("[InputMacro] Replaying %d records (%.1f s) at %.2fx, recorded %dx%d, device %dx%d%s",
+          static_cast<int>(m_events.size()), m_events.last().atUs / 1e6, m_speed,
+          recordedSize.width(), recordedSize.height(), deviceSize.width(), deviceSize.height(),
+          m_remap ? ", remapped" : "");
+    onTimer();
+    return true;
+}
+
+void InputMacroPlayer::stop()
+{
+    if (!isPlaying()) {
+        return;
+    }
+    m_timer->stop();
+    finish(false);
+}
+
+bool InputMacroPlayer::load(const QString &path, QSize &recordedSize)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[InputMacro] Cannot open macro file:" << path << file.errorString();
+        return false;
+    }
+    m_data = file.readAll();
+    m_events.clear();
+
+    if (m_data.size() < InputMacro::HEADER_SIZE
+        || memcmp(m_data.constData(), InputMacro::MAGIC, 4) != 0) {
+        qWarning() << "[InputMacro] Not a macro file:" << path;
+        return false;
+    }
+    if (static_cast<quint8>(m_data.at(4)) != InputMacro::VERSION) {
+        qWarning() << "[InputMacro] Unsupported macro version" << static_cast<quint8>(m_data.at(4));
+        return false;
+    }
+    recordedSize = QSize(getU16(m_data.constData() + 6), getU16(m_data.constData() + 8));
+
+    int pos = InputMacro::HEADER_SIZE;
+    qint64 atUs = 0;
+    while (pos < m_data.size()) {
+        quint64 delta = 0;
+        quint64 len = 0;
+        if (!readVarint(m_data, pos, delta) || !readVarint(m_data, pos, len)
+            || len == 0 || len > static_cast<quint64>(m_data.size() - pos)) {
+            // 录制中途退出时末尾可能不完整，保留之前的记录
+            qWarning() << "[InputMacro] Truncated macro, replaying first" << m_events.size() << "records";
+            break;
+        }
+        atUs += static_cast<qint64>(delta);
+        m_events.append({ atUs, pos, static_cast<int>(len) });
+        pos += static_cast<int>(len);
+    }
+    return true;
+}
+
+void InputMacroPlayer::setupRemap(const QSize &recordedSize, const QSize &deviceSize)
+{
+    m_remap = false;
+    m_scaleX = m_scaleY = 1.0;
+    m_offsetX = m_offsetY = 0.0;
+    if (recordedSize.isEmpty() || deviceSize.isEmpty()) {
+        return;
+    }
+
+    // 坐标已归一化，宽高比相同时无需映射；不同时按等比居中放入当前设备
+    const double sx = static_cast<double>(deviceSize.width()) / recordedSize.width();
+    const double sy = static_cast<double>(deviceSize.height()) / recordedSize.height();
+    if (std::abs(sx - sy) < 1e-3 * qMax(sx, sy)) {
+        return;
+    }
+    const double s = qMin(sx, sy);
+    m_scaleX = recordedSize.width() * s / deviceSize.width();
+    m_scaleY = recordedSize.height() * s / deviceSize.height();
+    m_offsetX = (1.0 - m_scaleX) * 0.5 * 65535;
+    m_offsetY = (1.0 - m_scaleY) * 0.5 * 65535;
+    m_remap = true;
+}
+
+void InputMacroPlayer::onTimer()
+{
+    const qint64 nowNs = qsc::PreciseScheduler::nowNs();
+    while (m_next < m_events.size()) {
+        const Event &event = m_events[m_next];
+        const qint64 deadlineNs = m_startNs + static_cast<qint64>(event.atUs * 1000 / m_speed);
+        const qint64 lateUs = (nowNs - deadlineNs) / 1000;
+        if (lateUs < 0) {
+            m_timer->startUs(-lateUs);
+            return;
+        }
+        if (lateUs > MAX_CATCHUP_US) {
+            // 卡顿后整体顺延，保持后续记录的相对间隔
+            m_startNs += lateUs * 1000;
+            m_rebases++;
+        }
+        m_lateness.addSample(lateUs);
+        sendEvent(event);
+        ++m_next;
+    }
+    finish(true);
+}
+
+void InputMacroPlayer::sendEvent(const Event &event)
+{
+    QByteArray msg = m_data.mid(event.offset, event.len);
+    char *p = msg.data();
+    int left = msg.size();
+    while (left > 0) {
+        const int size = FastMsg::messageSize(p, left);
+        if (size <= 0) {
+            break;
+        }
+        const quint8 type = static_cast<quint8>(p[0]);
+        if (type == FMT_TOUCH_DOWN || type == FMT_TOUCH_UP || type == FMT_TOUCH_MOVE) {
+            remapPoint(p + 2);
+            trackTouch(static_cast<quint8>(p[1]), static_cast<quint8>(type - FMT_TOUCH_DOWN), p + 2);
+        } else if (type == FMT_TOUCH_RESET) {
+            memset(m_touchDown, 0, sizeof(m_touchDown));
+        } else if (type == FMT_BATCH) {
+            // count(1) + [seqId(1)+action(1)+x(2)+y(2)]*N
+            const int count = static_cast<quint8>(p[1]);
+            for (int i = 0; i < count; ++i) {
+                char *e = p + 2 + i * 6;
+                remapPoint(e + 2);
+                trackTouch(static_cast<quint8>(e[0]), static_cast<quint8>(e[1]), e + 2);
+            }
+        }
+        p += size;
+        left -= size;
+    }
+
+    if (m_sender) {
+        m_sender->send(msg);
+    }
+}
+
+void InputMacroPlayer::remapPoint(char *p)
+{
+    if (!m_remap) {
+        return;
+    }
+    const double x = getU16(p) * m_scaleX + m_offsetX;
+    const double y = getU16(p + 2) * m_scaleY + m_offsetY;
+    putU16(p, static_cast<quint16>(qBound(0.0, x + 0.5, 65535.0)));
+    putU16(p + 2, static_cast<quint16>(qBound(0.0, y + 0.5, 65535.0)));
+}
+
+void InputMacroPlayer::trackTouch(quint8 seqId, quint8 action, const char *pos)
+{
+    if (action == FTA_DOWN || action == FTA_MOVE) {
+        m_touchDown[seqId] = true;
+        memcpy(m_touchPos[seqId], pos, 4);
+    } else if (action == FTA_UP) {
+        m_touchDown[seqId] = false;
+    }
+}
+
+void InputMacroPlayer::finish(bool completed)
+{
+    // 中途停止时补发 UP，避免设备上留下按住的触摸点
+    for (int seqId = 0; seqId < 256; ++seqId) {
+        if (!m_touchDown[seqId]) {
+            continue;
+        }
+        m_touchDown[seqId] = false;
+        char buf[6];
+        buf[0] = static_cast<char>(FMT_TOUCH_UP);
+        buf[1] = static_cast<char>(seqId);
+        memcpy(buf + 2, m_touchPos[seqId], 4);
+        if (m_sender) {
+            m_sender->send(QByteArray(buf, 6));
+        }
+    }
+
+    qInfo("[InputMacro] Replay %s: %llu/%d records, lateness p50 %lld us, p99 %lld us, max %lld us, rebases %llu",
+          completed ? "finished" : "stopped",
+          static_cast<unsigned long long>(m_lateness.count()), static_cast<int>(m_events.size()),
+          static_cast<long long>(m_lateness.percentileUs(0.50)),
+          static_cast<long long>(m_lateness.percentileUs(0.99)),
+          static_cast<long long>(m_lateness.maxUs()),
+          static_cast<unsigned long long>(m_rebases));
+
+    m_data.clear();
+    m_events.clear();
+    m_next = 0;
+    emit finished();
+}
@@ -0,0 +1,134 @@
+#ifndef INPUTMACRO_H
+#define INPUTMACRO_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QFile>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+#include "PerformanceMonitor.h"
+
+class ControlSender;
+namespace qsc { class PreciseTimer; }
+
+/**
+ * 输入宏文件格式 / Input macro file format (big-endian, 与 FastMsg 一致)
+ *
+ *   Header 12B: magic "GSMC"(4) + version(1) + reserved(1) + width(2) + height(2) + reserved(2)
+ *   Record:     deltaUs(varint) + len(varint) + FastMsg 原始字节(len)
+ *
+ * width/height 为录制时的设备分辨率，回放到不同分辨率时据此重映射坐标。
+ * deltaUs 为与上一条记录的间隔（首条相对录制开始），单条记录可含多条 FastMsg。
+ */
+namespace InputMacro {
+constexpr char MAGIC[4] = { 'G', 'S', 'M', 'C' };
+constexpr quint8 VERSION = 1;
+constexpr int HEADER_SIZE = 12;
+
+// 是否为需要录制/回放的输入消息（触摸、按键、批量触摸）
+bool isInputMessage(quint8 type);
+}
+
+/**
+ * @brief 输入宏录制器 / Records the FastMsg input stream leaving ControlSender
+ *
+ * 由 ControlSender::send() 在消息进入合并缓冲/发送前调用，时间戳取 ClockSync::nowUs()（微秒）。
+ * 只保留输入消息，FEC 回报、码率、PING 等链路消息不录制。记录先写入内存缓冲，
+ * 满 FLUSH_BYTES 或 close() 时落盘。只在 ControlSender 所在线程调用。
+ */
+class InputMacroRecorder
+{
+public:
+    static constexpr int FLUSH_BYTES = 64 * 1024;
+
+    ~InputMacroRecorder();
+
+    bool open(const QString &path, const QSize &deviceSize);
+    void record(const char *data, int len);
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+    quint64 recordCount() const { return m_records; }
+
+private:
+    void flush();
+
+private:
+    QFile m_file;
+    QByteArray m_buf;
+    QByteArray m_msg;           // 单次 record 过滤后的消息（复用容量）
+    qint64 m_lastUs = 0;
+    qint64 m_startUs = 0;
+    quint64 m_records = 0;
+};
+
+/**
+ * @brief 输入宏回放器 / Replays a recorded macro through ControlSender
+ *
+ * - 定时：每条记录的截止时间 = 开始时刻 + 录制时间 / speed（绝对时间，误差不累积），
+ *   由 PreciseTimer（高精度调度线程）唤醒；同一时刻到期的记录一次发出
+ * - 漂移补偿：单条迟到超过 MAX_CATCHUP_US（进程卡顿等）时把开始时刻整体后移，
+ *   之后的记录保持原有间隔，不会把积压的 MOVE 挤在一起突发
+ * - 坐标重映射：录制与当前设备宽高比不同时按等比居中（letterbox）映射归一化坐标
+ * - 停止时为仍按下的触摸点补发 UP
+ *
+ * 完成后输出 实际发送时刻 - 截止时刻 的分布。只在所属线程（Controller 线程）调用。
+ */
+class InputMacroPlayer : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr qint64 MAX_CATCHUP_US = 50000;
+
+    InputMacroPlayer(ControlSender *sender, QObject *parent = nullptr);
+    ~InputMacroPlayer();
+
+    bool play(const QString &path, const QSize &deviceSize, double speed = 1.0);
+    void stop();
+    bool isPlaying() const { return m_next < m_events.size(); }
+
+signals:
+    void finished();
+
+private:
+    struct Event {
+        qint64 atUs;            // 相对录制开始
+        int offset;
+        int len;
+    };
+
+    bool load(const QString &path, QSize &recordedSize);
+    void setupRemap(const QSize &recordedSize, const QSize &deviceSize);
+    void onTimer();
+    void sendEvent(const Event &event);
+    void remapPoint(char *p);
+    void trackTouch(quint8 seqId, quint8 action, const char *pos);
+    void finish(bool completed);
+
+private:
+    QPointer<ControlSender> m_sender;
+    qsc::PreciseTimer *m_timer = nullptr;
+
+    QByteArray m_data;
+    QVector<Event> m_events;
+    int m_next = 0;
+    qint64 m_startNs = 0;
+    double m_speed = 1.0;
+
+    // 归一化坐标映射 x' = x * scale + offset（0-65535 空间）
+    bool m_remap = false;
+    double m_scaleX = 1.0, m_scaleY = 1.0;
+    double m_offsetX = 0.0, m_offsetY = 0.0;
+
+    // 按 seqId 记录仍按下的触摸点及最后位置（x/y 各 2 字节）
+    bool m_touchDown[256] = {};
+    char m_touchPos[256][4] = {};
+
+    qsc::LatencyHistogram m_lateness;
+    quint64 m_rebases = 0;
+};
+
+#endif // INPUTMACRO_H
@@ -2,6 +2,15 @@
 
 #include "devicemsg.h"
 
+static quint64 readBE(const QByteArray &bytes, int offset, int size)
+{
+    quint64 value = 0;
+    for (int i = 0; i < size; ++i) {
+        value = (value << 8) | static_cast<quint8>(bytes.at(offset + i));
+    }
+    return value;
+}
+
 DeviceMsg::DeviceMsg(QObject *parent) : QObject(parent) {}
 
 DeviceMsg::~DeviceMsg() {}
@@ -13,7 +22,41 @@ DeviceMsg::DeviceMsgType DeviceMsg::type()
 
 qint32 DeviceMsg::deserialize(QByteArray &byteArray)
 {
-    Q_UNUSED(byteArray);
-    // 暂无需要反序列化的设备消息
-    return -1;
+    if (byteArray.isEmpty()) {
+        return 0;
+    }
+
+    const int available = byteArray.size();
+    qint32 size = 0;
+    switch (static_cast<quint8>(byteArray.at(0))) {
+    case DMT_CLIPBOARD:
+        if (available < 5) return 0;
+        size = 5 + static_cast<qint32>(readBE(byteArray, 1, 4));
+        if (size > DEVICE_MSG_MAX_SIZE) return -1;
+        break;
+    case DMT_ACK_CLIPBOARD:
+        size = 9;
+        break;
+    case DMT_UHID_OUTPUT:
+        if (available < 5) return 0;
+        size = 5 + static_cast<qint32>(readBE(byteArray, 3, 2));
+        break;
+    case DMT_PONG:
+        size = 25;
+        break;
+    default:
+        qWarning() << "Unknown device message type:" << static_cast<quint8>(byteArray.at(0));
+        return -1;
+    }
+    if (available < size) {
+        return 0;
+    }
+
+    m_data.type = static_cast<DeviceMsgType>(static_cast<quint8>(byteArray.at(0)));
+    if (m_data.type == DMT_PONG) {
+        m_data.pong.clientTime = static_cast<qint64>(readBE(byteArray, 1, 8));
+        m_data.pong.deviceRecvTime = static_cast<qint64>(readBE(byteArray, 9, 8));
+        m_data.pong.deviceSendTime = static_cast<qint64>(readBE(byteArray, 17, 8));
+    }
+    return size;
 }
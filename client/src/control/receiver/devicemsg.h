@@ -10,6 +10,8 @@
  *
  * 解析从 Android 设备接收到的控制响应消息。
  * Parses control response messages received from Android device.
+ *
+ * 目前只使用 PONG（时钟同步），其余类型按长度跳过以保持流同步。
  */
 class DeviceMsg : public QObject
 {
@@ -18,17 +20,36 @@ public:
     enum DeviceMsgType
     {
         DMT_NULL = -1,
+        DMT_CLIPBOARD = 0,      // len(4) + text
+        DMT_ACK_CLIPBOARD = 1,  // sequence(8)
+        DMT_UHID_OUTPUT = 2,    // id(2) + len(2) + data
+        DMT_PONG = 3,           // clientTime(8) + deviceRecvTime(8) + deviceSendTime(8)，微秒
     };
     explicit DeviceMsg(QObject *parent = nullptr);
     virtual ~DeviceMsg();
 
     DeviceMsg::DeviceMsgType type();
+
+    /**
+     * @return 消耗的字节数；0 表示数据不完整，-1 表示无法解析
+     */
     qint32 deserialize(QByteArray &byteArray);
 
+    // DMT_PONG
+    qint64 pongClientTime() const { return m_data.pong.clientTime; }
+    qint64 pongDeviceRecvTime() const { return m_data.pong.deviceRecvTime; }
+    qint64 pongDeviceSendTime() const { return m_data.pong.deviceSendTime; }
+
 private:
     struct DeviceMsgData
     {
         DeviceMsgType type = DMT_NULL;
+        struct
+        {
+            qint64 clientTime = 0;
+            qint64 deviceRecvTime = 0;
+            qint64 deviceSendTime = 0;
+        } pong;
     };
 
     DeviceMsgData m_data;
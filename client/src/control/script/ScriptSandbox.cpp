@@ -6,6 +6,7 @@
 #include "fastmsg.h"
 #include "keycodes.h"
 #include "ConfigCenter.h"
+#include "PreciseTimer.h"
 #include "ScriptTipWidget.h"
 #include "selectionregionmanager.h"
 #include "scriptbuttonmanager.h"
@@ -22,6 +23,8 @@
 #include <QApplication>
 #include <QRandomGenerator>
 #include <cmath>
+#include <chrono>
+#include <thread>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -592,15 +595,23 @@ void SandboxScriptApi::sleep(int ms)
     if (!m_isPress) return;
     if (ms <= 0) return;
 
-    const int checkInterval = 50;  // 增大检查间隔，减少循环次数
-    int remaining = ms;
+    // 按绝对截止时间分段等待（每段检查中断、喂狗），分段误差不累积；
+    // 中间分段普通睡眠（至少留出半段余量），只有最后一段由 PreciseScheduler::sleepUntilNs
+    // 睡眠 + 自旋到截止时间，滑动/按键时长精确到微秒级
+    const qint64 checkIntervalNs = 50 * 1000000LL;
+    const qint64 deadlineNs = qsc::PreciseScheduler::nowNs() + static_cast<qint64>(ms) * 1000000LL;
 
-    while (remaining > 0) {
+    for (;;) {
         if (isInterrupted()) break;
 
-        int sleepTime = qMin(remaining, checkInterval);
-        QThread::msleep(sleepTime);
-        remaining -= sleepTime;
+        const qint64 now = qsc::PreciseScheduler::nowNs();
+        if (now >= deadlineNs) break;
+        const qint64 remainingNs = deadlineNs - now;
+        if (remainingNs > checkIntervalNs) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(qMin(checkIntervalNs, remainingNs - checkIntervalNs / 2)));
+        } else {
+            qsc::PreciseScheduler::sleepUntilNs(deadlineNs);
+        }
 
         // 喂狗，避免超时
         if (m_sandbox && m_sandbox->m_watchdog) {
@@ -1,9 +1,11 @@
 #define _USE_MATH_DEFINES
+#include <chrono>
 #include <cmath>
+#include <functional>
 #include <QDebug>
 #include <QCursor>
 #include <QGuiApplication>
-#include <QTimer>
+#include <QThread>
 #include <QKeyEvent>
 #include <QMouseEvent>
 #include <QWheelEvent>
@@ -40,6 +42,24 @@ static QSize getTargetSize(const QSize& frameSize, const QSize& showSize, const
     return frameSize;
 }
 
+// 光标外观/位置只能在 GUI 线程操作；输入线程模式（InputThread）下转投到 GUI 线程
+static void runOnGuiThread(std::function<void()> fn)
+{
+    QCoreApplication* app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() == app->thread()) {
+        fn();
+        return;
+    }
+    QMetaObject::invokeMethod(app, std::move(fn), Qt::QueuedConnection);
+}
+
+// 单调时钟微秒（与 RawMouseInput::Delta::timestampUs 同源）
+static qint64 steadyNowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 InputDispatcher::InputDispatcher(QPointer<Controller> controller, KeyMap* keyMap, QObject* parent)
     : QObject(parent)
     , m_controller(controller)
@@ -50,6 +70,7 @@ InputDispatcher::InputDispatcher(QPointer<Controller> controller, KeyMap* keyMap
 
 InputDispatcher::~InputDispatcher()
 {
+    stopRawMouse();
     stopMouseMoveTimer();
     mouseMoveStopTouch();
 }
@@ -68,23 +89,28 @@ void InputDispatcher::setCursorCaptured(bool captured)
 
     if (m_cursorCaptured) {
         if (m_keyMap && m_keyMap->isValidMouseMoveMap()) {
+            runOnGuiThread([]() {
 #ifdef QT_NO_DEBUG
-            QGuiApplication::setOverrideCursor(QCursor(Qt::BlankCursor));
+                QGuiApplication::setOverrideCursor(QCursor(Qt::BlankCursor));
 #else
-            QGuiApplication::setOverrideCursor(QCursor(Qt::CrossCursor));
+                QGuiApplication::setOverrideCursor(QCursor(Qt::CrossCursor));
 #endif
+            });
             emit grabCursor(true);
 
             // 切回游戏模式时重置视角到中心，避免光标模式下鼠标偏移导致视角跳动
             if (m_viewportHandler) {
                 m_viewportHandler->resetView();
             }
+            startRawMouse();
         }
         m_ctrlMouseMove.ignoreCount = 1;
     } else {
-        QGuiApplication::restoreOverrideCursor();
+        runOnGuiThread([]() { QGuiApplication::restoreOverrideCursor(); });
         emit grabCursor(false);
 
+        stopRawMouse();
+
         stopMouseMoveTimer();
         mouseMoveStopTouch();
 
@@ -258,7 +284,9 @@ void InputDispatcher::keyEvent(const QKeyEvent* from, const QSize& frameSize, co
     }
 
     // 使用 HandlerChain 处理事件
-    if (m_handlerChain && m_handlerChain->dispatchKeyEvent(from, frameSize, showSize)) {
+    // 路由用按键本身（无修饰键）的类型，与 Handler 内部的查找一致
+    if (m_handlerChain && m_handlerChain->dispatchKeyEvent(from, frameSize, showSize,
+                                                           m_keyMap->getKeyMapNodeKey(from->key()).type)) {
         return;
     }
 
@@ -405,6 +433,11 @@ bool InputDispatcher::processMouseMove(const QMouseEvent* from)
         return false;
     }
 
+    // 原始输入在工作：位移由 drainRawMouse 交付，光标不回中
+    if (m_rawMouse && m_rawMouse->isRunning()) {
+        return true;
+    }
+
     if (m_ctrlMouseMove.ignoreCount > 0) {
         --m_ctrlMouseMove.ignoreCount;
         return true;
@@ -430,10 +463,16 @@ bool InputDispatcher::processMouseMove(const QMouseEvent* from)
     m_ctrlMouseMove.ignoreCount = 1;
     moveCursorTo(from, center);
 
+    applyMouseDelta(delta);
+    return true;
+}
+
+void InputDispatcher::applyMouseDelta(const QPointF& delta)
+{
     // 小眼睛自由视角处理
     if (m_freeLookHandler && m_freeLookHandler->isActive() && m_freeLookHandler->hasTouchId()) {
         m_freeLookHandler->processMouseDelta(delta, m_frameSize, m_showSize);
-        return true;
+        return;
     }
 
     // 正常的移动逻辑
@@ -454,8 +493,104 @@ bool InputDispatcher::processMouseMove(const QMouseEvent* from)
         m_viewportHandler->addMoveDelta(distance);
         m_viewportHandler->scheduleMoveSend();
     }
+}
 
-    return true;
+void InputDispatcher::startRawMouse()
+{
+    if (!qsc::ConfigCenter::instance().rawMouseInput()) {
+        return;
+    }
+    if (!m_rawMouse) {
+        m_rawMouse.reset(RawMouseInput::create());
+        if (!m_rawMouse) {
+            return;     // 当前平台无实现
+        }
+    }
+    if (m_rawMouse->isRunning()) {
+        return;
+    }
+
+    m_rawMouseStats = {};
+    m_rawMouseCarry = {};
+    // 输入线程：入队后只在主线程空闲时投递一次合并处理，避免每个样本一次跨线程调用
+    const bool started = m_rawMouse->start([this](const RawMouseInput::Delta* deltas, int count) {
+        for (int i = 0; i < count; ++i) {
+            RawMouseInput::Delta delta = deltas[i];
+            if (m_rawMouseCarry.dx != 0.0 || m_rawMouseCarry.dy != 0.0) {
+                delta.dx += m_rawMouseCarry.dx;
+                delta.dy += m_rawMouseCarry.dy;
+                delta.timestampUs = m_rawMouseCarry.timestampUs;
+            }
+            if (m_rawMouseQueue.tryPush(delta)) {
+                m_rawMouseCarry = {};
+            } else {
+                m_rawMouseCarry = delta;    // 主线程卡顿时累加，不丢位移
+            }
+        }
+        if (!m_rawMouseDrainPending.exchange(true)) {
+            QMetaObject::invokeMethod(this, [this]() { drainRawMouse(); }, Qt::QueuedConnection);
+        }
+    });
+    if (!started) {
+        qWarning("[RawMouse] %s unavailable, using cursor re-centering", m_rawMouse->backendName());
+    }
+}
+
+void InputDispatcher::stopRawMouse()
+{
+    if (!m_rawMouse || !m_rawMouse->isRunning()) {
+        return;
+    }
+    m_rawMouse->stop();
+
+    RawMouseInput::Delta delta;
+    while (m_rawMouseQueue.tryPop(delta)) {}
+    m_rawMouseDrainPending.store(false);
+
+    if (m_rawMouseStats.drains > 0) {
+        qInfo("[RawMouse] %llu samples in %llu batches, lag avg %lld us, max %lld us",
+              static_cast<unsigned long long>(m_rawMouseStats.samples),
+              static_cast<unsigned long long>(m_rawMouseStats.drains),
+              static_cast<long long>(m_rawMouseStats.lagTotalUs / static_cast<qint64>(m_rawMouseStats.drains)),
+              static_cast<long long>(m_rawMouseStats.lagMaxUs));
+    }
+}
+
+void InputDispatcher::drainRawMouse()
+{
+    // 先清标志再取队列：取的过程中新到的样本会再投递一次
+    m_rawMouseDrainPending.store(false);
+
+    QPointF sum(0, 0);
+    qint64 oldestUs = 0;
+    int count = 0;
+    RawMouseInput::Delta delta;
+    while (m_rawMouseQueue.tryPop(delta)) {
+        if (count == 0) {
+            oldestUs = delta.timestampUs;
+        }
+        sum += QPointF(delta.dx, delta.dy);
+        ++count;
+    }
+    if (count == 0 || !m_rawMouse || !m_rawMouse->isRunning()) {
+        return;
+    }
+
+    const qint64 lagUs = steadyNowUs() - oldestUs;
+    m_rawMouseStats.samples += static_cast<quint64>(count);
+    m_rawMouseStats.drains++;
+    m_rawMouseStats.lagTotalUs += lagUs;
+    m_rawMouseStats.lagMaxUs = qMax(m_rawMouseStats.lagMaxUs, lagUs);
+
+    // 原始事件与窗口焦点无关，只在游戏模式且本程序处于前台时生效
+    if (!m_cursorCaptured || m_needBackMouseMove
+        || QGuiApplication::applicationState() != Qt::ApplicationActive) {
+        return;
+    }
+    if (sum.isNull()) {
+        return;
+    }
+    applyMouseDelta(sum);
 }
 
 void InputDispatcher::moveCursorTo(const QMouseEvent* from, const QPoint& localPosPixel)
@@ -469,9 +604,10 @@ void InputDispatcher::moveCursorTo(const QMouseEvent* from, const QPoint& localP
 #endif
     globalPos -= posOffset;
 
-    QTimer::singleShot(0, [globalPos]() {
+    // 延到 GUI 线程的下一次事件循环（输入线程模式下同时完成跨线程）
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [globalPos]() {
         QCursor::setPos(globalPos);
-    });
+    }, Qt::QueuedConnection);
 }
 
 void InputDispatcher::mouseMoveStartTouch(const QMouseEvent* from)
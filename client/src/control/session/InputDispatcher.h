@@ -8,10 +8,13 @@
 #include <QHash>
 #include <QSet>
 #include <atomic>
+#include <memory>
 
 #include "keymap.h"
 #include "input.h"
 #include "keycodes.h"
+#include "rawmouseinput.h"
+#include "SPSCQueue.h"
 
 class QKeyEvent;
 class QMouseEvent;
@@ -105,6 +108,7 @@ private:
     // 鼠标处理
     bool processMouseClick(const QMouseEvent* from);
     bool processMouseMove(const QMouseEvent* from);
+    void applyMouseDelta(const QPointF& delta);
     void processCursorMouse(const QMouseEvent* from);
     void moveCursorTo(const QMouseEvent* from, const QPoint& localPosPixel);
     void mouseMoveStartTouch(const QMouseEvent* from);
@@ -112,6 +116,11 @@ private:
     void startMouseMoveTimer();
     void stopMouseMoveTimer();
 
+    // 原始鼠标输入（游戏模式下替代光标回中）
+    void startRawMouse();
+    void stopRawMouse();
+    void drainRawMouse();
+
     // 按键处理
     void processScript(const KeyMap::KeyMapNode& node, bool isPress);
     void processFreeLook(const KeyMap::KeyMapNode& node, const QKeyEvent* from);
@@ -160,6 +169,18 @@ private:
         int ignoreCount = 0;
     } m_ctrlMouseMove;
 
+    // 原始鼠标输入：输入线程入队，主线程合并后交给 Viewport/FreeLook
+    std::unique_ptr<RawMouseInput> m_rawMouse;
+    qsc::SPSCQueue<RawMouseInput::Delta, 1024> m_rawMouseQueue;
+    std::atomic<bool> m_rawMouseDrainPending{false};
+    RawMouseInput::Delta m_rawMouseCarry;       // 队列满时暂存（仅输入线程访问）
+    struct {
+        quint64 samples = 0;
+        quint64 drains = 0;
+        qint64 lagTotalUs = 0;                  // 最早样本到主线程应用的延迟
+        qint64 lagMaxUs = 0;
+    } m_rawMouseStats;
+
     // 按键状态
     QHash<int, bool> m_keyStates;
     bool m_modifierComboDetected = false;
@@ -0,0 +1,230 @@
+#include <QDebug>
+#include <QThread>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QWheelEvent>
+
+#include "InputThread.h"
+#include "controller.h"
+#include "ClockSync.h"
+
+InputThread::InputThread(QObject* parent)
+    : QObject(parent)
+{
+}
+
+InputThread::~InputThread()
+{
+    stop();
+}
+
+bool InputThread::start(Controller* controller)
+{
+    if (!controller || controller->parent() || isRunning()) {
+        return false;
+    }
+
+    if (!m_thread) {
+        m_thread = new QThread(this);
+        m_thread->setObjectName("Input");
+    }
+    m_controller = controller;
+    m_stats.events = 0;
+    m_stats.batches = 0;
+    m_stats.dropped.store(0);
+    m_toWireHist.reset();
+
+    controller->moveToThread(m_thread);
+    m_thread->start(QThread::HighestPriority);
+    qInfo("[InputThread] Started, input dispatch and control writes bypass the GUI event loop");
+    return true;
+}
+
+void InputThread::stop()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    // 在输入线程处理完剩余事件（含已投递的 invoke），再把 Controller 移回调用线程
+    if (m_controller) {
+        QThread* caller = QThread::currentThread();
+        QPointer<Controller> controller = m_controller;
+        QMetaObject::invokeMethod(controller.data(), [this, controller, caller]() {
+            drain();
+            if (controller) {
+                controller->moveToThread(caller);
+            }
+        }, Qt::BlockingQueuedConnection);
+    }
+    m_thread->quit();
+    m_thread->wait();
+
+    Record record;
+    while (m_queue.tryPop(record)) {}
+    m_drainPending.store(false);
+    m_controller.clear();
+
+    if (m_stats.events > 0) {
+        qInfo("[InputThread] %llu events in %llu batches, dropped %llu, input->wire p50 %lld us, p99 %lld us, max %lld us",
+              static_cast<unsigned long long>(m_stats.events),
+              static_cast<unsigned long long>(m_stats.batches),
+              static_cast<unsigned long long>(m_stats.dropped.load()),
+              static_cast<long long>(m_toWireHist.percentileUs(0.50)),
+              static_cast<long long>(m_toWireHist.percentileUs(0.99)),
+              static_cast<long long>(m_toWireHist.maxUs()));
+    }
+}
+
+bool InputThread::isRunning() const
+{
+    return m_thread && m_thread->isRunning();
+}
+
+void InputThread::invoke(std::function<void()> fn)
+{
+    if (!m_controller || !isRunning()) {
+        return;
+    }
+    QMetaObject::invokeMethod(m_controller.data(), std::move(fn), Qt::QueuedConnection);
+}
+
+bool InputThread::postKeyEvent(const QKeyEvent* event, const QSize& frameSize, const QSize& showSize)
+{
+    Record record;
+    record.kind = Record::Key;
+    record.type = event->type();
+    record.key = event->key();
+    record.autoRepeat = event->isAutoRepeat();
+    record.modifiers = event->modifiers();
+    record.frameSize = frameSize;
+    record.showSize = showSize;
+    return post(record);
+}
+
+bool InputThread::postMouseEvent(const QMouseEvent* event, const QSize& frameSize, const QSize& showSize)
+{
+    Record record;
+    record.kind = Record::Mouse;
+    record.type = event->type();
+    record.button = event->button();
+    record.buttons = event->buttons();
+    record.modifiers = event->modifiers();
+#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
+    record.localPos = event->localPos();
+    record.globalPos = event->screenPos();
+#else
+    record.localPos = event->position();
+    record.globalPos = event->globalPosition();
+#endif
+    record.frameSize = frameSize;
+    record.showSize = showSize;
+    return post(record);
+}
+
+bool InputThread::postWheelEvent(const QWheelEvent* event, const QSize& frameSize, const QSize& showSize)
+{
+    Record record;
+    record.kind = Record::Wheel;
+    record.type = event->type();
+    record.buttons = event->buttons();
+    record.modifiers = event->modifiers();
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
+    record.localPos = event->position();
+    record.globalPos = event->globalPosition();
+#else
+    record.localPos = event->posF();
+    record.globalPos = event->globalPosF();
+#endif
+    record.angleDelta = event->angleDelta();
+    record.frameSize = frameSize;
+    record.showSize = showSize;
+    return post(record);
+}
+
+bool InputThread::post(const Record& record)
+{
+    if (!m_controller || !isRunning()) {
+        return false;
+    }
+
+    Record stamped = record;
+    stamped.enqueueUs = qsc::ClockSync::nowUs();
+    if (!m_queue.tryPush(stamped)) {
+        if (m_stats.dropped.fetch_add(1, std::memory_order_relaxed) == 0) {
+            qWarning("[InputThread] Queue full, input thread stalled; dropping events");
+        }
+        qsc::PerformanceMonitor::instance().reportInputDropped();
+        return false;
+    }
+    if (!m_drainPending.exchange(true)) {
+        QMetaObject::invokeMethod(m_controller.data(), [this]() { drain(); }, Qt::QueuedConnection);
+    }
+    return true;
+}
+
+void InputThread::drain()
+{
+    // 先清标志再取队列：取的过程中新到的事件会再投递一次
+    m_drainPending.store(false);
+
+    qint64 enqueueUs[MAX_BATCH];
+    qint64 startUs[MAX_BATCH];
+    Record record;
+    for (;;) {
+        int count = 0;
+        if (m_controller) {
+            m_controller->beginInputBatch();
+        }
+        while (count < MAX_BATCH && m_queue.tryPop(record)) {
+            enqueueUs[count] = record.enqueueUs;
+            startUs[count] = qsc::ClockSync::nowUs();
+            dispatch(record);
+            ++count;
+        }
+        if (m_controller) {
+            m_controller->endInputBatch();
+        }
+        if (count == 0) {
+            return;
+        }
+
+        const qint64 wireUs = qsc::ClockSync::nowUs();
+        auto& monitor = qsc::PerformanceMonitor::instance();
+        for (int i = 0; i < count; ++i) {
+            m_toWireHist.addSample(wireUs - enqueueUs[i]);
+            monitor.reportInputToWire(startUs[i] - enqueueUs[i], wireUs - enqueueUs[i]);
+        }
+        m_stats.events += static_cast<quint64>(count);
+        m_stats.batches++;
+    }
+}
+
+void InputThread::dispatch(const Record& record)
+{
+    Controller* controller = m_controller.data();
+    if (!controller) {
+        return;
+    }
+
+    // 在输入线程重建事件对象，Handler 看到的与 GUI 线程直接分发时一致
+    switch (record.kind) {
+    case Record::Key: {
+        QKeyEvent event(record.type, record.key, record.modifiers, QString(), record.autoRepeat);
+        controller->keyEvent(&event, record.frameSize, record.showSize);
+        break;
+    }
+    case Record::Mouse: {
+        QMouseEvent event(record.type, record.localPos, record.globalPos,
+                          record.button, record.buttons, record.modifiers);
+        controller->mouseEvent(&event, record.frameSize, record.showSize);
+        break;
+    }
+    case Record::Wheel: {
+        QWheelEvent event(record.localPos, record.globalPos, QPoint(), record.angleDelta,
+                          record.buttons, record.modifiers, Qt::NoScrollPhase, false);
+        controller->wheelEvent(&event, record.frameSize, record.showSize);
+        break;
+    }
+    }
+}
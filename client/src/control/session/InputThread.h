@@ -0,0 +1,111 @@
+#ifndef INPUT_THREAD_H
+#define INPUT_THREAD_H
+
+#include <QObject>
+#include <QPointer>
+#include <QPoint>
+#include <QPointF>
+#include <QSize>
+#include <QEvent>
+#include <atomic>
+#include <functional>
+
+#include "SPSCQueue.h"
+#include "PerformanceMonitor.h"
+
+class QThread;
+class QKeyEvent;
+class QMouseEvent;
+class QWheelEvent;
+class Controller;
+
+/**
+ * @brief 输入线程 / Dedicated input thread
+ *
+ * Qt 只在 GUI 线程投递键鼠事件，原来从 HandlerChain 分发、FastMsg 序列化到写控制通道
+ * 也都在 GUI 线程完成，GUI 线程忙于绘制或模态对话框时输入延迟随之增大。启用后：
+ * - Controller（连同 SessionContext、HandlerChain、各 Handler、ControlSender）移到本线程，
+ *   Handler 的定时器也在本线程的事件循环中运行
+ * - GUI 线程只把事件压成定长记录（事件字段 + 当时的 frameSize/showSize 几何快照）放进无锁
+ *   SPSC 队列，队列由空变非空时投递一次 drain()，不逐事件跨线程调用
+ * - drain() 每轮最多取 MAX_BATCH 条，在 Controller::beginInputBatch/endInputBatch 之间分发，
+ *   一轮产生的 FastMsg 在 ControlSender 的预分配缓冲区中合并为一次写入
+ * - 每条事件的 入队→开始分发、入队→写出（或确认无需发送）延迟计入 PerformanceMonitor 直方图
+ *
+ * 控制通道写入必须线程安全：KCP 自带锁；TCP 由 DeviceController 换成 ControlSocketWriter。
+ * 光标显示/位置等 GUI 操作由 InputDispatcher 转投回 GUI 线程。
+ *
+ * 线程：除 drain() 外所有接口只在 GUI 线程调用。
+ */
+class InputThread : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int QUEUE_SIZE = 1024;
+    static constexpr int MAX_BATCH = 64;
+
+    explicit InputThread(QObject* parent = nullptr);
+    ~InputThread();
+
+    /**
+     * @brief 启动线程并把 controller 移过去（controller 不能有 parent）
+     */
+    bool start(Controller* controller);
+
+    /**
+     * @brief 处理完已入队的事件后把 controller 移回调用线程，结束线程（可重复调用）
+     */
+    void stop();
+
+    bool isRunning() const;
+
+    /**
+     * @brief 在输入线程按投递顺序执行（脚本加载、焦点、快捷键等非热路径调用）
+     */
+    void invoke(std::function<void()> fn);
+
+    // 事件入队；队列满（输入线程卡住超过 QUEUE_SIZE 个事件）时丢弃并返回 false
+    bool postKeyEvent(const QKeyEvent* event, const QSize& frameSize, const QSize& showSize);
+    bool postMouseEvent(const QMouseEvent* event, const QSize& frameSize, const QSize& showSize);
+    bool postWheelEvent(const QWheelEvent* event, const QSize& frameSize, const QSize& showSize);
+
+private:
+    struct Record {
+        enum Kind : quint8 { Key, Mouse, Wheel };
+
+        Kind kind = Key;
+        QEvent::Type type = QEvent::None;
+        int key = 0;
+        bool autoRepeat = false;
+        Qt::KeyboardModifiers modifiers;
+        Qt::MouseButton button = Qt::NoButton;
+        Qt::MouseButtons buttons;
+        QPointF localPos;
+        QPointF globalPos;
+        QPoint angleDelta;
+        QSize frameSize;
+        QSize showSize;
+        qint64 enqueueUs = 0;
+    };
+
+    bool post(const Record& record);
+    void drain();
+    void dispatch(const Record& record);
+
+private:
+    QThread* m_thread = nullptr;
+    QPointer<Controller> m_controller;
+
+    qsc::SPSCQueue<Record, QUEUE_SIZE> m_queue;
+    std::atomic<bool> m_drainPending{false};
+
+    // 本线程统计（停止时输出），全局直方图见 PerformanceMonitor
+    struct {
+        quint64 events = 0;
+        quint64 batches = 0;
+        std::atomic<quint64> dropped{0};
+    } m_stats;
+    qsc::LatencyHistogram m_toWireHist;
+};
+
+#endif // INPUT_THREAD_H
@@ -166,19 +166,58 @@ void SessionContext::runAutoStartScripts()
 
 // ========== KeyMap 管理 ==========
 
-void SessionContext::loadKeyMap(const QString& json, bool runAutoStartScripts)
+void SessionContext::loadKeyMap(const QString& json, bool runAutoStartScripts,
+                                std::shared_ptr<const KeyMap::Table> compiled)
 {
     if (m_scriptBridge) {
         m_scriptBridge->reset();
     }
 
-    m_keyMap.loadKeyMap(json);
+    if (compiled) {
+        m_keyMap.install(std::move(compiled));
+    } else {
+        m_keyMap.loadKeyMap(json);
+    }
 
     if (runAutoStartScripts) {
         this->runAutoStartScripts();
     }
 }
 
+bool SessionContext::installKeyMap(std::shared_ptr<const KeyMap::Table> compiled)
+{
+    if (!compiled) {
+        return false;
+    }
+
+    // 按出现顺序比较脚本节点：脚本变化需要重置脚本引擎并重跑自启动脚本，交给调用方重建会话
+    const QVector<KeyMap::KeyMapNode>& oldNodes = m_keyMap.getKeyMapNodes();
+    auto nextScript = [](const QVector<KeyMap::KeyMapNode>& nodes, int& i) -> const QString* {
+        for (; i < nodes.size(); ++i) {
+            if (nodes[i].type == KeyMap::KMT_SCRIPT) {
+                return &nodes[i++].script;
+            }
+        }
+        return nullptr;
+    };
+    int oldIdx = 0;
+    int newIdx = 0;
+    for (;;) {
+        const QString* oldScript = nextScript(oldNodes, oldIdx);
+        const QString* newScript = nextScript(compiled->nodes, newIdx);
+        if (!oldScript || !newScript) {
+            if (oldScript || newScript) return false;
+            break;
+        }
+        if (*oldScript != *newScript) {
+            return false;
+        }
+    }
+
+    m_keyMap.install(std::move(compiled));
+    return true;
+}
+
 // ========== 帧获取回调 ==========
 
 void SessionContext::setFrameGrabCallback(std::function<QImage()> callback)
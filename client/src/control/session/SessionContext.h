@@ -110,7 +110,13 @@ public:
 
     // ========== KeyMap 管理 ==========
 
-    void loadKeyMap(const QString& json, bool runAutoStartScripts = true);
+    void loadKeyMap(const QString& json, bool runAutoStartScripts = true,
+                    std::shared_ptr<const KeyMap::Table> compiled = nullptr);
+    /**
+     * @brief 热替换键位表（会话与各 Handler 保持不变）
+     * @return 新表的脚本与当前不同时返回 false 且不安装，由调用方重建会话
+     */
+    bool installKeyMap(std::shared_ptr<const KeyMap::Table> compiled);
     KeyMap* keyMap() { return &m_keyMap; }
     const KeyMap* keyMap() const { return &m_keyMap; }
 
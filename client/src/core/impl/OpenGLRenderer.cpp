@@ -40,6 +40,15 @@ void OpenGLRenderer::renderFrame(const FrameData& frame)
         setFrameSize(frame.width, frame.height);
     }
 
+    // NV12 直通帧
+    if (frame.isNV12) {
+        if (m_widget->yuvFormat() != YUVFormat::NV12) {
+            m_widget->setYUVFormat(YUVFormat::NV12);
+        }
+        m_widget->updateTexturesNV12(frame.dataY, frame.dataUV, frame.linesizeY, frame.linesizeUV);
+        return;
+    }
+
     // 更新纹理
     m_widget->updateTextures(
         frame.dataY, frame.dataU, frame.dataV,
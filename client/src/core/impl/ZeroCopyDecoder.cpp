@@ -1,4 +1,5 @@
 #include "ZeroCopyDecoder.h"
+#include "infra/PixelConvert.h"
 #include <QDebug>
 #include <QDateTime>
 #include <QMutex>
@@ -82,108 +83,6 @@ static void simdMemcpy(void* dst, const void* src, size_t size)
 #endif
 }
 
-// NV12 UV 去交织的 SIMD 加速
-// 将 UVUVUV... 交织数据分离为独立的 UUU... 和 VVV... 平面
-// SSE2: 使用 _mm_shuffle_epi8 / maskmove 实现 ~4x 加速
-// AVX2: 使用 _mm256_shuffle_epi8 实现 ~8x 加速
-static void simdDeinterleaveUV(const uint8_t* src, uint8_t* dstU, uint8_t* dstV,
-                                int width, int height, int srcStride, int dstUStride, int dstVStride)
-{
-#ifdef __AVX2__
-    // AVX2: 每次处理 32 个 UV 对 (64 字节输入 → 32U + 32V)
-    const __m256i shuffleU = _mm256_setr_epi8(
-        0, 2, 4, 6, 8, 10, 12, 14,  // 低 128 位偶数位置 (U)
-        -1, -1, -1, -1, -1, -1, -1, -1,
-        0, 2, 4, 6, 8, 10, 12, 14,
-        -1, -1, -1, -1, -1, -1, -1, -1
-    );
-    const __m256i shuffleV = _mm256_setr_epi8(
-        1, 3, 5, 7, 9, 11, 13, 15,  // 低 128 位奇数位置 (V)
-        -1, -1, -1, -1, -1, -1, -1, -1,
-        1, 3, 5, 7, 9, 11, 13, 15,
-        -1, -1, -1, -1, -1, -1, -1, -1
-    );
-
-    for (int y = 0; y < height; ++y) {
-        const uint8_t* row = src + y * srcStride;
-        uint8_t* uRow = dstU + y * dstUStride;
-        uint8_t* vRow = dstV + y * dstVStride;
-        int x = 0;
-
-        // AVX2 主循环: 每次处理 16 个 UV 对 (32 字节)
-        for (; x + 16 <= width; x += 16) {
-            __m256i uv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x * 2));
-            __m256i u = _mm256_shuffle_epi8(uv, shuffleU);
-            __m256i v = _mm256_shuffle_epi8(uv, shuffleV);
-
-            // 结果在每个 128 位 lane 的低 8 字节中
-            // 提取并合并: lane0[0:7] + lane1[0:7] → 16 字节连续 U
-            __m128i u_lo = _mm256_castsi256_si128(u);
-            __m128i u_hi = _mm256_extracti128_si256(u, 1);
-            __m128i u_packed = _mm_unpacklo_epi64(u_lo, u_hi);
-
-            __m128i v_lo = _mm256_castsi256_si128(v);
-            __m128i v_hi = _mm256_extracti128_si256(v, 1);
-            __m128i v_packed = _mm_unpacklo_epi64(v_lo, v_hi);
-
-            _mm_storeu_si128(reinterpret_cast<__m128i*>(uRow + x), u_packed);
-            _mm_storeu_si128(reinterpret_cast<__m128i*>(vRow + x), v_packed);
-        }
-
-        // 标量尾部
-        for (; x < width; ++x) {
-            uRow[x] = row[x * 2];
-            vRow[x] = row[x * 2 + 1];
-        }
-    }
-#elif defined(__SSE2__)
-    // SSE2: 使用 _mm_and / _mm_srli 偶奇分离
-    const __m128i maskLow = _mm_set1_epi16(0x00FF);
-
-    for (int y = 0; y < height; ++y) {
-        const uint8_t* row = src + y * srcStride;
-        uint8_t* uRow = dstU + y * dstUStride;
-        uint8_t* vRow = dstV + y * dstVStride;
-        int x = 0;
-
-        // SSE2 主循环: 每次处理 8 个 UV 对 (16 字节)
-        for (; x + 8 <= width; x += 8) {
-            __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 2));
-
-            // U = 偶数字节 (位置 0,2,4,6,8,10,12,14)
-            __m128i u16 = _mm_and_si128(uv, maskLow);
-            // V = 奇数字节 (位置 1,3,5,7,9,11,13,15)
-            __m128i v16 = _mm_srli_epi16(uv, 8);
-
-            // 16位 → 8位 pack: u16 和 v16 各有 8 个 16 位值
-            __m128i u8 = _mm_packus_epi16(u16, u16);  // 低 8 字节有效
-            __m128i v8 = _mm_packus_epi16(v16, v16);  // 低 8 字节有效
-
-            // 存储 8 个 U 和 V
-            _mm_storel_epi64(reinterpret_cast<__m128i*>(uRow + x), u8);
-            _mm_storel_epi64(reinterpret_cast<__m128i*>(vRow + x), v8);
-        }
-
-        // 标量尾部
-        for (; x < width; ++x) {
-            uRow[x] = row[x * 2];
-            vRow[x] = row[x * 2 + 1];
-        }
-    }
-#else
-    // 标量回退
-    for (int y = 0; y < height; ++y) {
-        const uint8_t* row = src + y * srcStride;
-        uint8_t* uRow = dstU + y * dstUStride;
-        uint8_t* vRow = dstV + y * dstVStride;
-        for (int x = 0; x < width; ++x) {
-            uRow[x] = row[x * 2];
-            vRow[x] = row[x * 2 + 1];
-        }
-    }
-#endif
-}
-
 // 静态硬件像素格式（用于回调）
 static int s_hwPixFmtGlobal = AV_PIX_FMT_NONE;
 // 标记硬件格式协商是否在运行时失败（getHwFormat 回调中设置）
@@ -651,6 +550,7 @@ bool ZeroCopyDecoder::decode(const uint8_t* data, int size, int64_t pts, int fla
         qWarning("[ZeroCopyDecoder] Send packet error: %s", errorbuf);
         m_packet->data = nullptr;
         m_packet->size = 0;
+        emit keyFrameRequested();
 
         // 连续失败计数，超过阈值则关闭硬件解码重新用软解打开
         m_consecutiveErrors++;
@@ -750,12 +650,14 @@ bool ZeroCopyDecoder::decode(const uint8_t* data, int size, int64_t pts, int fla
         qWarning("[ZeroCopyDecoder] Receive frame error: %s", errorbuf);
 
         // WiFi 高码率下丢包导致大量 receive 错误时，刷新解码器
-        // 等待下一个 I 帧重新建立正确的参考帧
+        // 并请求服务端立即输出 I 帧重新建立正确的参考帧
+        emit keyFrameRequested();
         m_receiveErrors++;
         if (m_receiveErrors >= 10) {
             qWarning("[ZeroCopyDecoder] Too many receive errors (%d), flushing decoder", m_receiveErrors);
             avcodec_flush_buffers(m_codecCtx);
             m_receiveErrors = 0;
+            m_waitingForKeyframe = true;  // 刷新后参考帧已清空，丢弃 P 帧直到关键帧
         }
     }
 
@@ -811,23 +713,31 @@ void ZeroCopyDecoder::processDecodedFrame(AVFrame* frame)
 
     // 优先使用 FrameQueue
     if (m_frameQueue) {
+        // 渲染端支持 NV12 时保留双平面布局，省去一次色度平面去交织
+        const bool keepNV12 = isNV12 && m_frameQueue->nv12Accepted();
+        const FrameLayout wantLayout = keepNV12 ? FrameLayout::NV12 : FrameLayout::YUV420P;
+
         FrameData* poolFrame = m_frameQueue->acquireFrame();
         if (poolFrame) {
-            // 检查帧池尺寸是否匹配
-            if (poolFrame->width != w || poolFrame->height != h) {
-                qInfo("[ZeroCopyDecoder] Frame size changed: %dx%d -> %dx%d",
-                      poolFrame->width, poolFrame->height, w, h);
+            // 检查帧池尺寸和布局是否匹配
+            if (poolFrame->width != w || poolFrame->height != h || poolFrame->layout != wantLayout) {
+                qInfo("[ZeroCopyDecoder] Frame layout changed: %dx%d %s -> %dx%d %s",
+                      poolFrame->width, poolFrame->height,
+                      poolFrame->layout == FrameLayout::NV12 ? "NV12" : "YUV420P",
+                      w, h, keepNV12 ? "NV12" : "YUV420P");
                 // 1. 先释放当前帧
                 m_frameQueue->releaseFrame(poolFrame);
                 // 2. 清空队列中所有旧尺寸的帧（否则消费者会收到旧尺寸帧）
                 m_frameQueue->clear();
-                // 3. 调整帧池尺寸
+                // 3. 调整帧池尺寸和布局
+                m_frameQueue->setLayout(wantLayout);
                 m_frameQueue->resize(w, h);
                 // 4. 重新获取帧
                 poolFrame = m_frameQueue->acquireFrame();
 
                 // 5. 如果获取的帧仍然是旧尺寸（被消费者持有后释放的），跳过这一帧
-                if (poolFrame && (poolFrame->width != w || poolFrame->height != h)) {
+                if (poolFrame && (poolFrame->width != w || poolFrame->height != h ||
+                                  poolFrame->layout != wantLayout)) {
                     qWarning("[ZeroCopyDecoder] Got stale frame after resize, skipping");
                     m_frameQueue->releaseFrame(poolFrame);
                     poolFrame = nullptr;
@@ -836,10 +746,6 @@ void ZeroCopyDecoder::processDecodedFrame(AVFrame* frame)
 
             if (poolFrame && poolFrame->dataY) {
                 if (isNV12) {
-                    // NV12 转 YUV420P: 在解码端做 UV 去交织
-                    // 直接 NV12 传 GPU 存在 GL_LUMINANCE_ALPHA 兑容性问题（ANGLE/不同驱动）
-                    // SIMD 加速去交织
-
                     // 复制 Y 平面
                     if (frame->linesize[0] == poolFrame->linesizeY) {
                         simdMemcpy(poolFrame->dataY, frame->data[0], poolFrame->linesizeY * h);
@@ -850,15 +756,27 @@ void ZeroCopyDecoder::processDecodedFrame(AVFrame* frame)
                         }
                     }
 
-                    // NV12 UV 去交织 SIMD 加速
-                    // 替代逐像素循环，使用 SSE2/AVX2 批量分离 UV 交织数据
-                    simdDeinterleaveUV(frame->data[1],
-                                       poolFrame->dataU, poolFrame->dataV,
-                                       uvW, uvH,
-                                       frame->linesize[1],
-                                       poolFrame->linesizeU, poolFrame->linesizeV);
-
-                    poolFrame->isNV12 = false;  // 已转为 YUV420P
+                    if (keepNV12) {
+                        // NV12 直通：UV 交织平面原样拷贝，由渲染器 NV12 着色器采样
+                        if (frame->linesize[1] == poolFrame->linesizeUV) {
+                            simdMemcpy(poolFrame->dataUV, frame->data[1], poolFrame->nv12UVPlaneSize());
+                        } else {
+                            for (int y = 0; y < uvH; ++y) {
+                                memcpy(poolFrame->dataUV + y * poolFrame->linesizeUV,
+                                       frame->data[1] + y * frame->linesize[1], uvW * 2);
+                            }
+                        }
+                        poolFrame->isNV12 = true;
+                    } else {
+                        // 渲染端不支持 NV12（GL_LUMINANCE_ALPHA 兼容性问题，ANGLE/Core Profile）
+                        // NV12 UV 去交织 SIMD 加速
+                        simdDeinterleaveUV(frame->data[1],
+                                           poolFrame->dataU, poolFrame->dataV,
+                                           uvW, uvH,
+                                           frame->linesize[1],
+                                           poolFrame->linesizeU, poolFrame->linesizeV);
+                        poolFrame->isNV12 = false;  // 已转为 YUV420P
+                    }
                 } else {
                     // YUV420P 格式：3 个独立平面
                     // 检查 linesize 是否完全匹配
@@ -907,6 +825,10 @@ void ZeroCopyDecoder::processDecodedFrame(AVFrame* frame)
                 poolFrame->height = h;
                 poolFrame->pts = frame->pts;
 
+                if (m_frameObserver) {
+                    m_frameObserver(*poolFrame);
+                }
+
                 // 入队
                 if (!m_frameQueue->pushFrame(poolFrame)) {
                     qWarning("[ZeroCopyDecoder] Frame queue full, dropping frame");
@@ -1052,17 +974,11 @@ void ZeroCopyDecoder::peekFrame(std::function<void(int, int, uint8_t*)> callback
         // 检查是否 NV12
         bool isNV12 = (m_lastAVFrame->format == AV_PIX_FMT_NV12);
         if (isNV12) {
-            const uint8_t* uvSrc = m_lastAVFrame->data[1];
-            int uvLinesize = m_lastAVFrame->linesize[1];
-            for (int y = 0; y < uvH; ++y) {
-                const uint8_t* uvRow = uvSrc + y * uvLinesize;
-                uint8_t* uRow = m_lastFrameU.data() + y * uvW;
-                uint8_t* vRow = m_lastFrameV.data() + y * uvW;
-                for (int x = 0; x < uvW; ++x) {
-                    uRow[x] = uvRow[x * 2];
-                    vRow[x] = uvRow[x * 2 + 1];
-                }
-            }
+            // 截图路径仍需 U/V 平面，复用解码热路径的 SIMD 去交织
+            simdDeinterleaveUV(m_lastAVFrame->data[1],
+                               m_lastFrameU.data(), m_lastFrameV.data(),
+                               uvW, uvH,
+                               m_lastAVFrame->linesize[1], uvW, uvW);
         } else {
             if (m_lastAVFrame->linesize[1] == uvW) {
                 memcpy(m_lastFrameU.data(), m_lastAVFrame->data[1], uvW * uvH);
@@ -1166,6 +1082,10 @@ void ZeroCopyDecoder::processGPUDirectFrame(AVFrame* hwFrame)
             AVFrame* clonedFrame = av_frame_clone(hwFrame);
             poolFrame->hwAVFrame = clonedFrame;
 
+            if (m_frameObserver) {
+                m_frameObserver(*poolFrame);
+            }
+
             m_frameQueue->pushFrame(poolFrame);
             emit frameReady();
         } else {
@@ -10,6 +10,7 @@
 #include <QElapsedTimer>
 #include <QSet>
 #include <atomic>
+#include <cstdint>
 
 // FFmpeg 前向声明（必须在 namespace 外部）
 struct AVCodecContext;
@@ -54,6 +55,15 @@ public:
      */
     void setFrameQueue(FrameQueue* queue);
 
+    /**
+     * @brief 帧观察回调：每帧入队前在解码线程调用（用于点击→画面延迟探测等）
+     *
+     * 必须在 open() 之前设置；回调只能读取帧数据，不可持有指针。
+     * GPU 直通帧同样回调（isGPUDirect=true，无 CPU 亮度数据）。
+     */
+    using FrameObserver = std::function<void(const FrameData&)>;
+    void setFrameObserver(FrameObserver observer) { m_frameObserver = std::move(observer); }
+
     /**
      * @brief 获取硬件解码器名称
      */
@@ -88,6 +98,11 @@ signals:
      */
     void fpsUpdated(quint32 fps);
 
+    /**
+     * @brief 解码出错，需要关键帧恢复参考链（解码线程发出，上层限频后请求服务端）
+     */
+    void keyFrameRequested();
+
     /**
      * @brief 新帧可用信号
      */
@@ -117,6 +132,7 @@ private:
     // 零拷贝输出
     FrameQueue* m_frameQueue = nullptr;
     FrameCallback m_frameCallback;
+    FrameObserver m_frameObserver;
 
     // GPU 直通渲染
     bool m_gpuDirectEnabled = false;
@@ -66,7 +66,19 @@ void ZeroCopyRenderer::renderFrame(const FrameData& frame)
         return;
     }
 
-    // 始终使用 YUV420P 渲染路径（NV12 已在解码端转为 YUV420P）
+    // NV12 直通帧：Y + UV 双平面，由 NV12 着色器转换
+    if (frame.isNV12) {
+        if (yuvFormat() != YUVFormat::NV12) {
+            setYUVFormat(YUVFormat::NV12);
+        }
+        QYUVOpenGLWidget::updateTexturesNV12(
+            frame.dataY, frame.dataUV,
+            frame.linesizeY, frame.linesizeUV
+        );
+        return;
+    }
+
+    // YUV420P 渲染路径（渲染端不支持 NV12 时解码端已去交织）
     if (yuvFormat() != YUVFormat::YUV420P) {
         setYUVFormat(YUVFormat::YUV420P);
     }
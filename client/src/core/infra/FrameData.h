@@ -7,6 +7,17 @@
 namespace qsc {
 namespace core {
 
+/**
+ * @brief 帧池内存布局 / Frame pool memory layout
+ *
+ * YUV420P: [Y][U][V] 三平面
+ * NV12:    [Y][UV]   双平面（硬解回读直通，无需去交织）
+ */
+enum class FrameLayout : uint8_t {
+    YUV420P,
+    NV12
+};
+
 /**
  * @brief 视频帧数据结构 / Video Frame Data Structure
  *
@@ -41,6 +52,9 @@ struct FrameData {
     // 是否为 NV12 格式（硬解直通，跳过 CPU 去交织）
     bool isNV12 = false;
 
+    // 帧内存布局（由 FramePool 分配时设置）
+    FrameLayout layout = FrameLayout::YUV420P;
+
     // ========================================================
     // GPU 直通渲染 / GPU Direct Rendering
     // ========================================================
@@ -68,6 +82,9 @@ struct FrameData {
     // 获取 U/V 平面大小 / Get U/V plane size
     int uvPlaneSize() const { return linesizeU * (height / 2); }
 
+    // 获取 NV12 UV 交织平面大小 / Get NV12 interleaved UV plane size
+    int nv12UVPlaneSize() const { return linesizeUV * (height / 2); }
+
     // 是否有效 / Check validity
     bool isValid() const {
         return dataY != nullptr && width > 0 && height > 0;
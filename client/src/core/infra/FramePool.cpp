@@ -23,7 +23,7 @@ FramePool::FramePool(int poolSize, int maxWidth, int maxHeight)
     // 预分配所有帧内存
     for (int i = 0; i < poolSize; ++i) {
         m_frames[i].poolIndex = i;
-        allocateFrame(m_frames[i], maxWidth, maxHeight);
+        allocateFrame(m_frames[i], maxWidth, maxHeight, FrameLayout::YUV420P);
     }
 }
 
@@ -40,18 +40,20 @@ FrameData* FramePool::acquire()
     const int poolSz = static_cast<int>(m_frames.size());
     const int curW = m_width.load(std::memory_order_acquire);
     const int curH = m_height.load(std::memory_order_acquire);
+    const FrameLayout curLayout = layout();
 
     for (int i = 0; i < poolSz; ++i) {
         bool expected = false;
         if (m_inUse[i].compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
             // CAS 成功，拿到此槽位
 
-            // 检查帧尺寸是否匹配（resize 后旧帧可能不匹配）
-            if (m_frames[i].width != curW || m_frames[i].height != curH) {
+            // 检查帧尺寸/布局是否匹配（resize/setLayout 后旧帧可能不匹配）
+            if (m_frames[i].width != curW || m_frames[i].height != curH ||
+                m_frames[i].layout != curLayout) {
                 // 罕见路径：需要重新分配，使用 resize mutex
                 std::lock_guard<std::mutex> lock(m_resizeMutex);
                 deallocateFrame(m_frames[i]);
-                allocateFrame(m_frames[i], curW, curH);
+                allocateFrame(m_frames[i], curW, curH, curLayout);
             }
 
             m_frames[i].refCount.store(1, std::memory_order_release);
@@ -91,10 +93,32 @@ void FramePool::resize(int width, int height)
     m_height.store(height, std::memory_order_release);
 
     // 重新分配空闲帧的内存
+    const FrameLayout curLayout = layout();
     for (size_t i = 0; i < m_frames.size(); ++i) {
         if (!m_inUse[i].load(std::memory_order_acquire)) {
             deallocateFrame(m_frames[i]);
-            allocateFrame(m_frames[i], width, height);
+            allocateFrame(m_frames[i], width, height, curLayout);
+        }
+    }
+}
+
+void FramePool::setLayout(FrameLayout layout)
+{
+    if (layout == this->layout()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_resizeMutex);
+
+    m_layout.store(static_cast<int>(layout), std::memory_order_release);
+
+    // 重新分配空闲帧（被持有的帧在下次 acquire 时处理）
+    const int w = m_width.load(std::memory_order_relaxed);
+    const int h = m_height.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        if (!m_inUse[i].load(std::memory_order_acquire)) {
+            deallocateFrame(m_frames[i]);
+            allocateFrame(m_frames[i], w, h, layout);
         }
     }
 }
@@ -111,30 +135,37 @@ int FramePool::availableCount() const
     return count;
 }
 
-void FramePool::allocateFrame(FrameData& frame, int width, int height)
+void FramePool::allocateFrame(FrameData& frame, int width, int height, FrameLayout layout)
 {
-    // YUV420P 格式：Y 平面完整，U/V 平面各为 Y 的 1/4
-    // 额外分配 NV12 UV 交织平面空间
+    // YUV420P 格式：Y 平面完整，U/V 平面各为 Y 的 1/4，布局 [Y][U][V]
+    // NV12 格式：Y 平面完整，UV 交织平面为 Y 的 1/2，布局 [Y][UV]
     // linesize 使用 32 字节对齐，与 FFmpeg 默认策略一致
     constexpr int ALIGN = 32;
     int alignedWidth = (width + ALIGN - 1) & ~(ALIGN - 1);
 
     frame.width = width;
     frame.height = height;
+    frame.layout = layout;
     frame.linesizeY = alignedWidth;
-    frame.linesizeU = (alignedWidth / 2 + ALIGN - 1) & ~(ALIGN - 1);  // UV 也对齐
-    frame.linesizeV = frame.linesizeU;
-    // NV12: UV 交织平面 linesize = width (两个分量交织, 每个分量 w/2, 总共 w)
-    frame.linesizeUV = alignedWidth;
 
     int sizeY = frame.linesizeY * height;
-    int sizeU = frame.linesizeU * (height / 2);
-    int sizeV = frame.linesizeV * (height / 2);
-    int sizeUV = frame.linesizeUV * (height / 2);  // NV12 UV 平面
+    int sizeChroma = 0;
+
+    if (layout == FrameLayout::NV12) {
+        // NV12: UV 交织平面 linesize = width (两个分量交织, 每个分量 w/2, 总共 w)
+        frame.linesizeU = 0;
+        frame.linesizeV = 0;
+        frame.linesizeUV = alignedWidth;
+        sizeChroma = frame.linesizeUV * (height / 2);
+    } else {
+        frame.linesizeU = (alignedWidth / 2 + ALIGN - 1) & ~(ALIGN - 1);  // UV 也对齐
+        frame.linesizeV = frame.linesizeU;
+        frame.linesizeUV = 0;
+        sizeChroma = (frame.linesizeU + frame.linesizeV) * (height / 2);
+    }
 
     // 分配 32 字节对齐的连续内存块（支持 AVX）
-    // 布局: [Y][U][V][UV_NV12]
-    size_t totalSize = sizeY + sizeU + sizeV + sizeUV + ALIGN;
+    size_t totalSize = sizeY + sizeChroma + ALIGN;
 #ifdef _WIN32
     uint8_t* rawBuffer = static_cast<uint8_t*>(_aligned_malloc(totalSize, ALIGN));
 #else
@@ -143,15 +174,19 @@ void FramePool::allocateFrame(FrameData& frame, int width, int height)
 #endif
 
     frame.dataY = rawBuffer;
-    frame.dataU = rawBuffer + sizeY;
-    frame.dataV = rawBuffer + sizeY + sizeU;
-    frame.dataUV = rawBuffer + sizeY + sizeU + sizeV;
+    if (layout == FrameLayout::NV12) {
+        frame.dataU = nullptr;
+        frame.dataV = nullptr;
+        frame.dataUV = rawBuffer + sizeY;
+    } else {
+        frame.dataU = rawBuffer + sizeY;
+        frame.dataV = rawBuffer + sizeY + frame.linesizeU * (height / 2);
+        frame.dataUV = nullptr;
+    }
 
     // 初始化为黑色（Y=0, U=V=128）
-    std::memset(frame.dataY, 0, sizeY);
-    std::memset(frame.dataU, 128, sizeU);
-    std::memset(frame.dataV, 128, sizeV);
-    std::memset(frame.dataUV, 128, sizeUV);
+    std::memset(rawBuffer, 0, sizeY);
+    std::memset(rawBuffer + sizeY, 128, sizeChroma);
 }
 
 void FramePool::deallocateFrame(FrameData& frame)
@@ -176,6 +211,7 @@ void FramePool::deallocateFrame(FrameData& frame)
     frame.linesizeV = 0;
     frame.linesizeUV = 0;
     frame.isNV12 = false;
+    frame.layout = FrameLayout::YUV420P;
 }
 
 } // namespace core
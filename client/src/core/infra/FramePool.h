@@ -52,6 +52,19 @@ public:
      */
     void resize(int width, int height);
 
+    /**
+     * @brief 切换帧内存布局（解码输出格式变化时调用）
+     * @param layout YUV420P 三平面或 NV12 双平面
+     *
+     * 空闲帧立即重新分配，被持有的帧在下次 acquire 时重新分配。
+     */
+    void setLayout(FrameLayout layout);
+
+    /**
+     * @brief 获取当前帧内存布局
+     */
+    FrameLayout layout() const { return static_cast<FrameLayout>(m_layout.load(std::memory_order_acquire)); }
+
     /**
      * @brief 获取当前可用帧数
      */
@@ -63,7 +76,7 @@ public:
     int poolSize() const { return static_cast<int>(m_frames.size()); }
 
 private:
-    void allocateFrame(FrameData& frame, int width, int height);
+    void allocateFrame(FrameData& frame, int width, int height, FrameLayout layout);
     void deallocateFrame(FrameData& frame);
 
 private:
@@ -74,6 +87,7 @@ private:
     std::mutex m_resizeMutex;                   // 仅用于 resize 和帧重新分配
     std::atomic<int> m_width{0};
     std::atomic<int> m_height{0};
+    std::atomic<int> m_layout{static_cast<int>(FrameLayout::YUV420P)};
 };
 
 } // namespace core
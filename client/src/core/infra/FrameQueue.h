@@ -229,6 +229,33 @@ public:
         m_pool->resize(width, height);
     }
 
+    /**
+     * @brief 切换帧池内存布局（解码输出格式变化时调用）
+     */
+    void setLayout(FrameLayout layout) {
+        m_pool->setLayout(layout);
+    }
+
+    /**
+     * @brief 当前帧池内存布局
+     */
+    FrameLayout layout() const {
+        return m_pool->layout();
+    }
+
+    /**
+     * @brief 消费端是否接受 NV12 帧（由渲染器声明）
+     *
+     * 生产者据此决定保留 NV12 双平面，还是在解码端去交织为 YUV420P。
+     */
+    void setNV12Accepted(bool accepted) {
+        m_nv12Accepted.store(accepted, std::memory_order_release);
+    }
+
+    bool nv12Accepted() const {
+        return m_nv12Accepted.load(std::memory_order_acquire);
+    }
+
     /**
      * @brief 清空队列
      */
@@ -277,6 +304,9 @@ private:
     std::unique_ptr<FramePool> m_pool;
     std::unique_ptr<DynamicSPSCQueue<FrameData*>> m_queue;
 
+    // 消费端 NV12 能力（默认接受，渲染器不支持时回退为 YUV420P）
+    std::atomic<bool> m_nv12Accepted{true};
+
     // 抖动统计
     JitterStats m_stats;
     std::chrono::steady_clock::time_point m_lastPushTime{};
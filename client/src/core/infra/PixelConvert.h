@@ -0,0 +1,20 @@
+#ifndef CORE_PIXELCONVERT_H
+#define CORE_PIXELCONVERT_H
+
+#include <cstdint>
+
+namespace qsc {
+namespace core {
+
+/**
+ * @brief NV12 UV 去交织：UVUV... 拆为 U、V 两个平面（AVX2 / SSE2 / 标量）
+ *
+ * width 为每行 UV 对数。解码端 YUV420P 输出与渲染端 NV12 回退路径共用。
+ */
+void simdDeinterleaveUV(const uint8_t* src, uint8_t* dstU, uint8_t* dstV,
+                        int width, int height, int srcStride, int dstUStride, int dstVStride);
+
+} // namespace core
+} // namespace qsc
+
+#endif // CORE_PIXELCONVERT_H
@@ -264,6 +264,34 @@ void DeviceSession::resetAllTouchPoints()
     }
 }
 
+void DeviceSession::startMacroRecording(const QString& path)
+{
+    if (m_inputManager) {
+        m_inputManager->startMacroRecording(path);
+    }
+}
+
+void DeviceSession::stopMacroRecording()
+{
+    if (m_inputManager) {
+        m_inputManager->stopMacroRecording();
+    }
+}
+
+void DeviceSession::playMacro(const QString& path, double speed)
+{
+    if (m_inputManager) {
+        m_inputManager->playMacro(path, speed);
+    }
+}
+
+void DeviceSession::stopMacro()
+{
+    if (m_inputManager) {
+        m_inputManager->stopMacro();
+    }
+}
+
 // === 回调设置 ===
 
 void DeviceSession::setFrameGrabCallback(std::function<QImage()> callback)
@@ -296,5 +324,12 @@ void DeviceSession::releaseFrame(FrameData* frame)
     }
 }
 
+void DeviceSession::setNV12Accepted(bool accepted)
+{
+    if (m_frameQueue) {
+        m_frameQueue->setNV12Accepted(accepted);
+    }
+}
+
 } // namespace core
 } // namespace qsc
@@ -142,6 +142,12 @@ public:
     void runAutoStartScripts();
     void resetAllTouchPoints();
 
+    // 输入宏：录制/回放发往设备的输入消息（回归测试）
+    void startMacroRecording(const QString& path);
+    void stopMacroRecording();
+    void playMacro(const QString& path, double speed = 1.0);
+    void stopMacro();
+
     // === 回调设置 ===
 
     void setFrameGrabCallback(std::function<QImage()> callback);
@@ -175,6 +181,12 @@ public:
      */
     void releaseFrame(FrameData* frame);
 
+    /**
+     * @brief 声明渲染端是否支持 NV12 直接渲染
+     * 不支持时解码器回退为 YUV420P（CPU 去交织）
+     */
+    void setNV12Accepted(bool accepted);
+
 signals:
     // === 状态信号 ===
 
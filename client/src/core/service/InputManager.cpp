@@ -1,5 +1,9 @@
 #include "InputManager.h"
 #include "controller.h"
+#include "InputThread.h"
+#include "ConfigCenter.h"
+#include "PreciseTimer.h"
+#include "ClockSync.h"
 #include "interfaces/IControlChannel.h"
 #include "kcpcontrolsocket.h"
 #include "keycodes.h"
@@ -8,6 +12,7 @@
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <QPointer>
+#include <QDebug>
 
 namespace qsc {
 namespace core {
@@ -20,15 +25,19 @@ InputManager::InputManager(QObject* parent)
 InputManager::~InputManager()
 {
     // 清除回调，防止销毁后被调用
-    if (m_controller) {
-        m_controller->connectScriptTipSignal(nullptr);
-        m_controller->connectKeyMapOverlayUpdateSignal(nullptr);
-    }
+    callController([](Controller* controller) {
+        controller->connectScriptTipSignal(nullptr);
+        controller->connectKeyMapOverlayUpdateSignal(nullptr);
+    });
     stop();
 }
 
 void InputManager::initialize(KcpSendCallback sendCallback, const QString& gameScript)
 {
+    // 重新初始化：旧 Controller 先回到本线程再销毁
+    if (m_inputThread) {
+        m_inputThread->stop();
+    }
     m_controller = std::make_unique<Controller>(std::move(sendCallback), gameScript);
 
     connect(m_controller.get(), &Controller::grabCursor, this, &InputManager::cursorGrabChanged);
@@ -47,26 +56,35 @@ void InputManager::initialize(KcpSendCallback sendCallback, const QString& gameS
             emit safeThis->keyMapOverlayUpdated();
         }
     });
+
+    if (ConfigCenter::instance().inputThread()) {
+        if (!m_inputThread) {
+            m_inputThread = std::make_unique<InputThread>();
+        }
+        m_inputThread->start(m_controller.get());
+    }
 }
 
 void InputManager::setControlChannel(IControlChannel* channel)
 {
     m_controlChannel = channel;
     // 将 IControlChannel 传递给 Controller
-    if (m_controller) {
-        m_controller->setControlChannel(channel);
-    }
+    callController([channel](Controller* controller) { controller->setControlChannel(channel); });
 }
 
 void InputManager::setKcpControlSocket(KcpControlSocket* socket)
 {
-    if (m_controller) {
-        m_controller->setControlSocket(socket);
-    }
+    // KcpControlSocket::write 内部加锁，可在输入线程直接调用
+    callController([socket](Controller* controller) { controller->setControlSocket(socket); });
 }
 
 void InputManager::setTcpControlSocket(QTcpSocket* socket)
 {
+    if (isInputThreadRunning()) {
+        // QTcpSocket 不能在输入线程写，继续使用 sendCallback（DeviceController 的 ControlSocketWriter）
+        qWarning() << "[InputManager] TCP control socket ignored in input thread mode";
+        return;
+    }
     if (m_controller) {
         m_controller->setTcpControlSocket(socket);
     }
@@ -75,22 +93,43 @@ void InputManager::setTcpControlSocket(QTcpSocket* socket)
 void InputManager::setMobileSize(const QSize& size)
 {
     m_mobileSize = size;
-    if (m_controller) {
-        m_controller->setMobileSize(size);
-    }
+    callController([size](Controller* controller) { controller->setMobileSize(size); });
 }
 
 void InputManager::start()
 {
-    if (m_controller) {
-        m_controller->startSender();
-    }
+    callController([](Controller* controller) { controller->startSender(); });
 }
 
 void InputManager::stop()
 {
-    if (m_controller) {
-        m_controller->stopSender();
+    callController([](Controller* controller) { controller->stopSender(); });
+    // 等输入线程处理完已投递的调用（包括上面的断开消息），Controller 回到本线程
+    if (m_inputThread) {
+        m_inputThread->stop();
+    }
+
+    auto& scheduler = qsc::PreciseScheduler::instance();
+    if (scheduler.fireError().count() > 0) {
+        qInfo("[InputManager] Handler timers: %s", qPrintable(scheduler.stats()));
+    }
+}
+
+bool InputManager::isInputThreadRunning() const
+{
+    return m_inputThread && m_inputThread->isRunning();
+}
+
+void InputManager::callController(std::function<void(Controller*)> fn)
+{
+    if (!m_controller) {
+        return;
+    }
+    Controller* controller = m_controller.get();
+    if (isInputThreadRunning()) {
+        m_inputThread->invoke([controller, fn]() { fn(controller); });
+    } else {
+        fn(controller);
     }
 }
 
@@ -98,21 +137,27 @@ void InputManager::stop()
 
 void InputManager::keyEvent(const QKeyEvent* event, const QSize& frameSize, const QSize& showSize)
 {
-    if (m_controller) {
+    if (isInputThreadRunning()) {
+        m_inputThread->postKeyEvent(event, frameSize, showSize);
+    } else if (m_controller) {
         m_controller->keyEvent(event, frameSize, showSize);
     }
 }
 
 void InputManager::mouseEvent(const QMouseEvent* event, const QSize& frameSize, const QSize& showSize)
 {
-    if (m_controller) {
+    if (isInputThreadRunning()) {
+        m_inputThread->postMouseEvent(event, frameSize, showSize);
+    } else if (m_controller) {
         m_controller->mouseEvent(event, frameSize, showSize);
     }
 }
 
 void InputManager::wheelEvent(const QWheelEvent* event, const QSize& frameSize, const QSize& showSize)
 {
-    if (m_controller) {
+    if (isInputThreadRunning()) {
+        m_inputThread->postWheelEvent(event, frameSize, showSize);
+    } else if (m_controller) {
         m_controller->wheelEvent(event, frameSize, showSize);
     }
 }
@@ -121,111 +166,130 @@ void InputManager::wheelEvent(const QWheelEvent* event, const QSize& frameSize,
 
 void InputManager::postGoBack()
 {
-    if (m_controller) {
-        m_controller->postGoBack();
-    }
+    callController([](Controller* controller) { controller->postGoBack(); });
 }
 
 void InputManager::postGoHome()
 {
-    if (m_controller) {
-        m_controller->postGoHome();
-    }
+    callController([](Controller* controller) { controller->postGoHome(); });
 }
 
 void InputManager::postGoMenu()
 {
-    if (m_controller) {
-        m_controller->postGoMenu();
-    }
+    callController([](Controller* controller) { controller->postGoMenu(); });
 }
 
 void InputManager::postAppSwitch()
 {
-    if (m_controller) {
-        m_controller->postAppSwitch();
-    }
+    callController([](Controller* controller) { controller->postAppSwitch(); });
 }
 
 void InputManager::postPower()
 {
-    if (m_controller) {
-        m_controller->postPower();
-    }
+    callController([](Controller* controller) { controller->postPower(); });
 }
 
 void InputManager::postVolumeUp()
 {
-    if (m_controller) {
-        m_controller->postVolumeUp();
-    }
+    callController([](Controller* controller) { controller->postVolumeUp(); });
 }
 
 void InputManager::postVolumeDown()
 {
-    if (m_controller) {
-        m_controller->postVolumeDown();
-    }
+    callController([](Controller* controller) { controller->postVolumeDown(); });
 }
 
 void InputManager::postBackOrScreenOn(bool down)
 {
-    if (m_controller) {
-        m_controller->postBackOrScreenOn(down);
-    }
+    callController([down](Controller* controller) { controller->postBackOrScreenOn(down); });
 }
 
 void InputManager::postKeyCodeClick(int keycode)
 {
-    if (m_controller) {
-        m_controller->postKeyCodeClick(static_cast<AndroidKeycode>(keycode));
-    }
+    callController([keycode](Controller* controller) {
+        controller->postKeyCodeClick(static_cast<AndroidKeycode>(keycode));
+    });
 }
 
 void InputManager::postDisconnect()
 {
-    if (m_controller) {
-        m_controller->postDisconnect();
-    }
+    callController([](Controller* controller) { controller->postDisconnect(); });
+}
+
+void InputManager::postFastMsg(const QByteArray& data, std::shared_ptr<std::atomic<qint64>> sentUs)
+{
+    callController([data, sentUs](Controller* controller) {
+        // 单条批次：endInputBatch 立即写出，不等下一次事件循环合并
+        controller->beginInputBatch();
+        controller->postFastMsg(data);
+        controller->endInputBatch();
+        if (sentUs) {
+            sentUs->store(ClockSync::nowUs(), std::memory_order_release);
+        }
+    });
 }
 
 // === 状态管理 ===
 
 void InputManager::onWindowFocusLost()
 {
-    if (m_controller) {
-        m_controller->onWindowFocusLost();
-    }
+    callController([](Controller* controller) { controller->onWindowFocusLost(); });
 }
 
 void InputManager::resetAllTouchPoints()
 {
-    if (m_controller) {
-        m_controller->resetAllTouchPoints();
-    }
+    callController([](Controller* controller) { controller->resetAllTouchPoints(); });
+}
+
+// === 输入宏 ===
+
+void InputManager::startMacroRecording(const QString& path)
+{
+    callController([path](Controller* controller) { controller->startMacroRecording(path); });
+}
+
+void InputManager::stopMacroRecording()
+{
+    callController([](Controller* controller) { controller->stopMacroRecording(); });
+}
+
+void InputManager::playMacro(const QString& path, double speed)
+{
+    callController([path, speed](Controller* controller) { controller->playMacro(path, speed); });
+}
+
+void InputManager::stopMacro()
+{
+    callController([](Controller* controller) { controller->stopMacro(); });
+}
+
+void InputManager::setGroupBroadcaster(std::shared_ptr<GroupBroadcaster> broadcaster)
+{
+    callController([broadcaster](Controller* controller) { controller->setGroupBroadcaster(broadcaster); });
 }
 
 // === 脚本管理 ===
 
 void InputManager::updateScript(const QString& gameScript, bool runAutoStartScripts)
 {
-    if (m_controller) {
-        m_controller->updateScript(gameScript, runAutoStartScripts);
+    // JSON 解析与键位表编译在调用线程完成，输入线程只做指针替换
+    std::shared_ptr<const KeyMap::Table> compiled;
+    if (!gameScript.isEmpty()) {
+        compiled = KeyMap::compile(gameScript);
     }
+    callController([gameScript, runAutoStartScripts, compiled](Controller* controller) {
+        controller->updateScript(gameScript, runAutoStartScripts, compiled);
+    });
 }
 
 void InputManager::resetScriptState()
 {
-    if (m_controller) {
-        m_controller->resetScriptState();
-    }
+    callController([](Controller* controller) { controller->resetScriptState(); });
 }
 
 void InputManager::runAutoStartScripts()
 {
-    if (m_controller) {
-        m_controller->runAutoStartScripts();
-    }
+    callController([](Controller* controller) { controller->runAutoStartScripts(); });
 }
 
 bool InputManager::isCurrentCustomKeymap() const
@@ -237,9 +301,7 @@ bool InputManager::isCurrentCustomKeymap() const
 
 void InputManager::setFrameGrabCallback(std::function<QImage()> callback)
 {
-    if (m_controller) {
-        m_controller->setFrameGrabCallback(std::move(callback));
-    }
+    callController([callback](Controller* controller) { controller->setFrameGrabCallback(callback); });
 }
 
 } // namespace core
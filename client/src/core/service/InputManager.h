@@ -4,16 +4,19 @@
 #include <QObject>
 #include <QSize>
 #include <QImage>
+#include <atomic>
 #include <memory>
 #include <functional>
 
 // 前向声明
 class Controller;
+class InputThread;
 class QKeyEvent;
 class QMouseEvent;
 class QWheelEvent;
 class KcpControlSocket;
 class QTcpSocket;
+class GroupBroadcaster;
 
 namespace qsc {
 namespace core {
@@ -28,6 +31,9 @@ class IInputProcessor;
  * 管理输入处理和控制命令发送 / Manages input processing and control command sending:
  * UI Events -> InputProcessor -> Controller -> ControlChannel -> Device
  *
+ * 输入线程模式（InputThread=1）：Controller 移到 InputThread，键鼠事件经无锁队列投递，
+ * 其余调用按顺序转投到输入线程执行。
+ *
  * 职责：
  * - 协调输入处理器和控制器的生命周期
  * - 路由键盘/鼠标/滚轮事件
@@ -79,10 +85,15 @@ public:
     void start();
 
     /**
-     * @brief 停止控制发送
+     * @brief 停止控制发送（输入线程模式下同时结束输入线程）
      */
     void stop();
 
+    /**
+     * @brief 是否运行在输入线程模式（Controller 属于输入线程，控制通道写入须线程安全）
+     */
+    bool isInputThreadRunning() const;
+
     // === 事件处理 ===
 
     void keyEvent(const QKeyEvent* event, const QSize& frameSize, const QSize& showSize);
@@ -102,11 +113,29 @@ public:
     void postKeyCodeClick(int keycode);
     void postDisconnect();
 
+    /**
+     * @brief 立即发送一条 FastMsg（不进入事件循环合并），写出后把 ClockSync::nowUs() 存入 sentUs
+     *
+     * 供延迟探测使用：时间戳在 Controller 所在线程写出后立即取得，不含转投到输入线程的排队时间。
+     */
+    void postFastMsg(const QByteArray& data, std::shared_ptr<std::atomic<qint64>> sentUs = nullptr);
+
     // === 状态管理 ===
 
     void onWindowFocusLost();
     void resetAllTouchPoints();
 
+    // === 输入宏（录制/回放发往设备的输入消息）===
+
+    void startMacroRecording(const QString& path);
+    void stopMacroRecording();
+    void playMacro(const QString& path, double speed = 1.0);
+    void stopMacro();
+
+    // === 群控（本设备为主控，输入消息转发给从设备；nullptr 停止）===
+
+    void setGroupBroadcaster(std::shared_ptr<GroupBroadcaster> broadcaster);
+
     // === 脚本管理 ===
 
     void updateScript(const QString& gameScript, bool runAutoStartScripts = true);
@@ -139,7 +168,11 @@ signals:
     void keyMapOverlayUpdated();
 
 private:
+    // 输入线程模式下 Controller 属于输入线程：调用按顺序投递过去；否则直接调用
+    void callController(std::function<void(Controller*)> fn);
+
     std::unique_ptr<Controller> m_controller;
+    std::unique_ptr<InputThread> m_inputThread;    // ConfigCenter::inputThread() 开启时创建
     IControlChannel* m_controlChannel = nullptr;
     QSize m_mobileSize;
 };
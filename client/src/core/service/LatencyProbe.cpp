@@ -0,0 +1,280 @@
+#include "LatencyProbe.h"
+#include "infra/FrameData.h"
+#include "ClockSync.h"
+#include "PerformanceMonitor.h"
+#include "fastmsg.h"
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace qsc {
+namespace core {
+
+LatencyProbe::LatencyProbe(const Options& options, Sender sender, QObject* parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_sender(std::move(sender))
+    , m_sentUs(std::make_shared<std::atomic<qint64>>(0))
+{
+    m_tick = new QTimer(this);
+    m_tick->setTimerType(Qt::PreciseTimer);
+    m_tick->setInterval(TICK_MS);
+    connect(m_tick, &QTimer::timeout, this, &LatencyProbe::onTick);
+}
+
+LatencyProbe::~LatencyProbe()
+{
+    stop();
+}
+
+void LatencyProbe::start()
+{
+    if (m_options.trials <= 0 || isRunning()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_state = State::Settling;
+        // 连接后先等画面稳定一段时间再开始第一次点击
+        m_stateUs = ClockSync::nowUs() + START_DELAY_US - GAP_US;
+        m_lastChangeUs = m_stateUs;
+        m_trial = 0;
+        m_timeouts = 0;
+        m_samples.clear();
+        m_samples.reserve(m_options.trials);
+        m_frameWidth = 0;
+        m_frameHeight = 0;
+    }
+    m_seqId = FastTouchSeq::next();
+    m_active.store(true, std::memory_order_release);
+    m_tick->start();
+    qInfo("[LatencyProbe] Started: %d trials, touch (%.3f, %.3f), region (%.3f, %.3f %.3fx%.3f), threshold %d",
+          m_options.trials, m_options.touch.x(), m_options.touch.y(),
+          m_options.region.x(), m_options.region.y(), m_options.region.width(), m_options.region.height(),
+          m_options.threshold);
+}
+
+void LatencyProbe::stop()
+{
+    bool pressed = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state == State::Idle) {
+            return;
+        }
+        pressed = m_state == State::Pressed || m_state == State::Release;
+    }
+    if (pressed) {
+        sendTouch(FTA_UP, nullptr);
+    }
+    finish();
+}
+
+bool LatencyProbe::isRunning() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_state != State::Idle;
+}
+
+// ---------------------------------------------------------
+// 解码线程：区域比较
+// ---------------------------------------------------------
+void LatencyProbe::onFrame(const FrameData& frame)
+{
+    if (!m_active.load(std::memory_order_acquire)) {
+        return;
+    }
+    if (frame.isGPUDirect || !frame.dataY || frame.width <= 0 || frame.height <= 0) {
+        if (!m_gpuWarned) {
+            m_gpuWarned = true;
+            qWarning("[LatencyProbe] Frame has no CPU luma plane (GPU direct?), probe cannot measure");
+        }
+        return;
+    }
+
+    const qint64 now = ClockSync::nowUs();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_state == State::Idle) {
+        return;
+    }
+
+    // 首帧或分辨率变化（旋转）：按新尺寸换算区域并重新取基准
+    if (frame.width != m_frameWidth || frame.height != m_frameHeight) {
+        m_frameWidth = frame.width;
+        m_frameHeight = frame.height;
+        m_x = qBound(0, static_cast<int>(m_options.region.x() * frame.width), frame.width - 1);
+        m_y = qBound(0, static_cast<int>(m_options.region.y() * frame.height), frame.height - 1);
+        m_w = qBound(1, static_cast<int>(m_options.region.width() * frame.width), frame.width - m_x);
+        m_h = qBound(1, static_cast<int>(m_options.region.height() * frame.height), frame.height - m_y);
+        m_baseline.resize(static_cast<size_t>(m_w) * m_h);
+        captureBaseline(frame.dataY, frame.linesizeY);
+        m_lastChangeUs = now;
+        return;
+    }
+
+    const uint8_t* region = frame.dataY + static_cast<ptrdiff_t>(m_y) * frame.linesizeY + m_x;
+    const quint64 sad = regionSad(region, frame.linesizeY, m_baseline.data(), m_w, m_w, m_h);
+    const bool changed = sad > static_cast<quint64>(m_options.threshold) * m_w * m_h;
+    if (!changed) {
+        return;
+    }
+
+    switch (m_state) {
+    case State::Settling:
+        m_lastChangeUs = now;
+        captureBaseline(frame.dataY, frame.linesizeY);
+        break;
+    case State::Pressed: {
+        // 写出时刻未回填之前的变化不可能由本次点击引起
+        const qint64 sentUs = m_sentUs->load(std::memory_order_acquire);
+        if (sentUs > 0 && now > sentUs) {
+            const qint64 latencyUs = now - sentUs;
+            m_samples.append(latencyUs);
+            PerformanceMonitor::instance().reportClickToPhoton(latencyUs, false);
+            qDebug("[LatencyProbe] Trial %d: %.2f ms", m_trial + 1, latencyUs / 1000.0);
+            m_state = State::Release;
+            m_stateUs = now;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void LatencyProbe::captureBaseline(const uint8_t* src, int stride)
+{
+    const uint8_t* row = src + static_cast<ptrdiff_t>(m_y) * stride + m_x;
+    for (int y = 0; y < m_h; ++y) {
+        memcpy(m_baseline.data() + static_cast<size_t>(y) * m_w, row + static_cast<ptrdiff_t>(y) * stride, m_w);
+    }
+}
+
+quint64 LatencyProbe::regionSad(const uint8_t* a, int strideA, const uint8_t* b, int strideB, int width, int height)
+{
+    quint64 total = 0;
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* pa = a + static_cast<ptrdiff_t>(y) * strideA;
+        const uint8_t* pb = b + static_cast<ptrdiff_t>(y) * strideB;
+        int x = 0;
+#ifdef __SSE2__
+        // 每 16 字节一次 psadbw，两个 64 位部分和累加
+        __m128i acc = _mm_setzero_si128();
+        for (; x + 16 <= width; x += 16) {
+            const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pa + x));
+            const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pb + x));
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+        }
+        total += static_cast<quint64>(_mm_cvtsi128_si32(acc))
+               + static_cast<quint64>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+#endif
+        for (; x < width; ++x) {
+            total += static_cast<quint64>(pa[x] > pb[x] ? pa[x] - pb[x] : pb[x] - pa[x]);
+        }
+    }
+    return total;
+}
+
+// ---------------------------------------------------------
+// 所属线程：试验调度
+// ---------------------------------------------------------
+void LatencyProbe::onTick()
+{
+    const qint64 now = ClockSync::nowUs();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    switch (m_state) {
+    case State::Settling:
+        if (m_frameWidth == 0 || now - m_stateUs < GAP_US || now - m_lastChangeUs < SETTLE_US) {
+            return;
+        }
+        m_sentUs->store(0, std::memory_order_relaxed);
+        m_state = State::Pressed;
+        m_stateUs = now;
+        lock.unlock();
+        sendTouch(FTA_DOWN, m_sentUs);
+        return;
+    case State::Pressed: {
+        const qint64 sentUs = m_sentUs->load(std::memory_order_acquire);
+        if (now - (sentUs > 0 ? sentUs : m_stateUs) < TIMEOUT_US) {
+            return;
+        }
+        m_timeouts++;
+        PerformanceMonitor::instance().reportClickToPhoton(0, true);
+        qWarning("[LatencyProbe] Trial %d: no change within %lld ms", m_trial + 1,
+                 static_cast<long long>(TIMEOUT_US / 1000));
+        m_state = State::Release;
+        return;
+    }
+    case State::Release:
+        lock.unlock();
+        sendTouch(FTA_UP, nullptr);
+        lock.lock();
+        if (++m_trial >= m_options.trials) {
+            lock.unlock();
+            finish();
+            return;
+        }
+        // UP 引起的画面恢复也要等静止，间隔从现在算
+        m_state = State::Settling;
+        m_stateUs = now;
+        m_lastChangeUs = now;
+        return;
+    default:
+        return;
+    }
+}
+
+void LatencyProbe::sendTouch(quint8 action, std::shared_ptr<std::atomic<qint64>> sentUs)
+{
+    if (m_sender) {
+        m_sender(FastMsg::serializeTouch(FastTouchEvent::fromNormalized(m_seqId, action,
+                                                                        m_options.touch.x(), m_options.touch.y())),
+                 std::move(sentUs));
+    }
+}
+
+void LatencyProbe::finish()
+{
+    m_active.store(false, std::memory_order_release);
+    m_tick->stop();
+
+    QVector<qint64> samples;
+    int trials = 0;
+    int timeouts = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_state = State::Idle;
+        samples = m_samples;
+        trials = m_trial;
+        timeouts = m_timeouts;
+    }
+
+    if (samples.isEmpty()) {
+        qWarning("[LatencyProbe] Finished %d trials without a sample (timeouts=%d)", trials, timeouts);
+    } else {
+        std::sort(samples.begin(), samples.end());
+        // 最近秩百分位
+        auto pct = [&samples](double p) {
+            const int rank = qMax(1, static_cast<int>(std::ceil(p * samples.size())));
+            return samples[rank - 1] / 1000.0;
+        };
+        double sum = 0;
+        for (qint64 us : samples) {
+            sum += us;
+        }
+        qInfo("[LatencyProbe] Click-to-photon over %d trials: min=%.2fms p50=%.2fms p90=%.2fms p99=%.2fms "
+              "max=%.2fms avg=%.2fms timeouts=%d",
+              trials, samples.first() / 1000.0, pct(0.50), pct(0.90), pct(0.99), samples.last() / 1000.0,
+              sum / samples.size() / 1000.0, timeouts);
+    }
+    emit finished();
+}
+
+} // namespace core
+} // namespace qsc
@@ -0,0 +1,120 @@
+#ifndef CORE_LATENCYPROBE_H
+#define CORE_LATENCYPROBE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class QTimer;
+
+namespace qsc {
+namespace core {
+
+struct FrameData;
+
+/**
+ * @brief 点击→画面延迟探测 / Click-to-photon latency probe
+ *
+ * 在指定位置发送触摸，监视解码帧中指定区域的亮度，测量 触摸写出控制通道 → 区域变化的帧解码完成
+ * 的时间，重复 trials 次得到分布。与人工观察无关，替身设备与真机均可使用：
+ * - 区域比较：对 Y 平面区域与基准副本做绝对差求和（SSE2 _mm_sad_epu8，其余平台标量），
+ *   平均差超过 threshold 视为变化；只读取区域所在行，每帧开销与区域面积成正比
+ * - 每次试验：区域连续 SETTLE_US 无变化后发送 DOWN（写出时刻由 Controller 线程回填），
+ *   之后第一帧变化即为样本；TIMEOUT_US 内未变化记为超时；随后发送 UP，间隔 GAP_US 再开始下一次
+ * - 结束后输出 min/P50/P90/P99/max，并报告给 PerformanceMonitor（与解码指标并列）
+ *
+ * 线程：onFrame() 在解码线程调用，其余在所属线程（界面线程）调用；状态由 m_mutex 保护。
+ * 需要 CPU 帧数据，GPU 直通帧无法比较（跳过并告警）。
+ */
+class LatencyProbe : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr qint64 SETTLE_US = 300000;
+    static constexpr qint64 TIMEOUT_US = 1000000;
+    static constexpr qint64 GAP_US = 200000;
+    static constexpr qint64 START_DELAY_US = 1000000;
+    static constexpr int TICK_MS = 5;
+
+    struct Options {
+        int trials = 0;
+        QPointF touch{0.5, 0.5};            // 归一化点击位置
+        QRectF region{0.45, 0.45, 0.1, 0.1};  // 归一化检测区域
+        int threshold = 8;                  // 区域平均亮度差阈值（0-255）
+    };
+
+    /**
+     * @brief 发送回调：把 FastMsg 写出控制通道；sentUs 非空时写出后存入 ClockSync::nowUs()
+     */
+    using Sender = std::function<void(const QByteArray& msg, std::shared_ptr<std::atomic<qint64>> sentUs)>;
+
+    LatencyProbe(const Options& options, Sender sender, QObject* parent = nullptr);
+    ~LatencyProbe() override;
+
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    /**
+     * @brief 解码线程：每帧入队前调用（ZeroCopyDecoder 帧观察回调）
+     */
+    void onFrame(const FrameData& frame);
+
+    /**
+     * @brief 两个 Y 区域的绝对差之和
+     */
+    static quint64 regionSad(const uint8_t* a, int strideA, const uint8_t* b, int strideB, int width, int height);
+
+signals:
+    void finished();
+
+private:
+    enum class State {
+        Idle,
+        Settling,       // 等待区域静止
+        Pressed,        // DOWN 已投递，等待写出时刻回填与区域变化
+        Release,        // 已检测到变化或超时，待发送 UP
+    };
+
+    void onTick();
+    void sendTouch(quint8 action, std::shared_ptr<std::atomic<qint64>> sentUs);
+    void captureBaseline(const uint8_t* src, int stride);
+    void finish();
+
+private:
+    const Options m_options;
+    Sender m_sender;
+    QTimer* m_tick = nullptr;
+    quint32 m_seqId = 0;
+
+    std::atomic<bool> m_active{false};
+    std::shared_ptr<std::atomic<qint64>> m_sentUs;
+
+    mutable std::mutex m_mutex;
+    State m_state = State::Idle;
+    qint64 m_stateUs = 0;               // 进入当前状态的时刻
+    qint64 m_lastChangeUs = 0;          // 区域最近一次变化的帧时刻
+    int m_trial = 0;
+    int m_timeouts = 0;
+    QVector<qint64> m_samples;
+
+    // 区域基准（像素坐标，随帧尺寸重新计算）
+    std::vector<uint8_t> m_baseline;
+    int m_frameWidth = 0;
+    int m_frameHeight = 0;
+    int m_x = 0, m_y = 0, m_w = 0, m_h = 0;
+    bool m_gpuWarned = false;
+};
+
+} // namespace core
+} // namespace qsc
+
+#endif // CORE_LATENCYPROBE_H
@@ -41,6 +41,15 @@ void ZeroCopyStreamManager::setDecoder(std::unique_ptr<ZeroCopyDecoder> decoder)
     qInfo("[ZeroCopyStreamManager] Custom decoder injected");
 }
 
+void ZeroCopyStreamManager::setFrameObserver(std::function<void(const FrameData&)> observer)
+{
+    if (m_running) {
+        qWarning("[ZeroCopyStreamManager] Cannot set frame observer while running");
+        return;
+    }
+    m_frameObserver = std::move(observer);
+}
+
 void ZeroCopyStreamManager::installVideoSocket(VideoSocket* socket)
 {
     m_videoSocket = socket;
@@ -188,12 +197,15 @@ bool ZeroCopyStreamManager::openDecoder()
 
     // 设置帧队列
     m_decoder->setFrameQueue(m_frameQueue.get());
+    m_decoder->setFrameObserver(m_frameObserver);
 
     // 连接信号
     connect(m_decoder.get(), &ZeroCopyDecoder::frameReady,
             this, &ZeroCopyStreamManager::frameReady);
     connect(m_decoder.get(), &ZeroCopyDecoder::fpsUpdated,
             this, &ZeroCopyStreamManager::onDecoderFpsUpdated);
+    connect(m_decoder.get(), &ZeroCopyDecoder::keyFrameRequested,
+            this, &ZeroCopyStreamManager::keyFrameRequested);
 
     // 根据配置确定解码器 codec ID
     AVCodecID codecId = AV_CODEC_ID_H264;
@@ -47,6 +47,13 @@ public:
      */
     void setDecoder(std::unique_ptr<ZeroCopyDecoder> decoder);
 
+    /**
+     * @brief 设置帧观察回调（转交 ZeroCopyDecoder::setFrameObserver，在解码线程调用）
+     *
+     * 必须在 start() 之前调用。
+     */
+    void setFrameObserver(std::function<void(const FrameData&)> observer);
+
     /**
      * @brief 安装 TCP 视频 Socket
      */
@@ -141,6 +148,11 @@ signals:
      */
     void fpsUpdated(quint32 fps);
 
+    /**
+     * @brief 解码器请求关键帧（转发 ZeroCopyDecoder::keyFrameRequested）
+     */
+    void keyFrameRequested();
+
     /**
      * @brief 流停止信号
      */
@@ -191,6 +203,7 @@ private:
 
     QSize m_frameSize;
     QString m_videoCodec = "h264";
+    std::function<void(const FrameData&)> m_frameObserver;
     quint32 m_currentFps = 0;
     bool m_running = false;
     bool m_decoderOpened = false;
@@ -15,6 +15,7 @@
 #endif
 
 #include "qyuvopenglwidget.h"
+#include "infra/PixelConvert.h"
 
 // 调试日志
 #define RENDER_LOG(msg) qDebug() << "[Render]" << QDateTime::currentDateTime().toString("hh:mm:ss.zzz") \
@@ -379,19 +380,54 @@ void QYUVOpenGLWidget::submitFrameDirect(uint8_t* dataY, uint8_t* dataU, uint8_t
         return;
     }
 
-    m_uploadTimer.start();
-    m_totalFrames++;
-
-    // 无锁帧提交：
-    // 创建新的帧槽，通过原子 exchange 投入邮箱
-    // 如果旧帧还没被渲染线程取走（被跳过），立即释放
     auto* newSlot = new DirectFrameSlot{
         dataY, dataU, dataV,
         width, height,
         linesizeY, linesizeU, linesizeV,
-        std::move(releaseCallback)
+        std::move(releaseCallback),
+        nullptr, 0, false
     };
+    submitDirectSlot(newSlot);
+}
 
+// ---------------------------------------------------------
+// 帧提交 - NV12 直接指针版本
+// UV 交织平面原样上传，色度由 NV12 着色器采样
+// ---------------------------------------------------------
+void QYUVOpenGLWidget::submitFrameDirectNV12(uint8_t* dataY, uint8_t* dataUV,
+                                             int width, int height,
+                                             int linesizeY, int linesizeUV,
+                                             std::function<void()> releaseCallback)
+{
+    if (m_isDestroying.load(std::memory_order_acquire)) {
+        if (releaseCallback) releaseCallback();
+        return;
+    }
+
+    auto* newSlot = new DirectFrameSlot{
+        dataY, nullptr, nullptr,
+        width, height,
+        linesizeY, 0, 0,
+        std::move(releaseCallback),
+        dataUV, linesizeUV, true
+    };
+    submitDirectSlot(newSlot);
+}
+
+// ---------------------------------------------------------
+// 直接帧投递（submitFrameDirect / submitFrameDirectNV12 共用）
+// ---------------------------------------------------------
+void QYUVOpenGLWidget::submitDirectSlot(DirectFrameSlot* newSlot)
+{
+    const int width = newSlot->width;
+    const int height = newSlot->height;
+
+    m_uploadTimer.start();
+    m_totalFrames++;
+
+    // 无锁帧提交：
+    // 通过原子 exchange 将帧槽投入邮箱
+    // 如果旧帧还没被渲染线程取走（被跳过），立即释放
     DirectFrameSlot* old = m_pendingDirectFrame.exchange(newSlot, std::memory_order_acq_rel);
     if (old) {
         // 旧帧被跳过（渲染来不及），立即释放
@@ -487,6 +523,7 @@ void QYUVOpenGLWidget::updateTexturesNV12(quint8 *dataY, quint8 *dataUV, quint32
 
             m_linesizeY = w;
             m_linesizeUV = w;
+            m_grabDataStale = true;
         }
     }
 
@@ -516,13 +553,7 @@ void QYUVOpenGLWidget::setYUVFormat(YUVFormat format)
         if (context()) {
             makeCurrent();
             deInitTextures();
-            if (format == YUVFormat::NV12) {
-                initShaderNV12();
-                initTexturesNV12();
-            } else {
-                initShader();
-                initTextures();
-            }
+            initTextures();     // NV12 可用时同时创建 Y + UV 纹理
             doneCurrent();
         }
 
@@ -533,35 +564,55 @@ void QYUVOpenGLWidget::setYUVFormat(YUVFormat format)
 // ---------------------------------------------------------
 // NV12: 初始化 NV12 专用着色器
 // ---------------------------------------------------------
-void QYUVOpenGLWidget::initShaderNV12()
+bool QYUVOpenGLWidget::initShaderNV12()
 {
+    if (m_shaderProgramNV12.isLinked()) {
+        return true;
+    }
+
+    QString fragShader = s_fragShaderNV12;
+    if (QCoreApplication::testAttribute(Qt::AA_UseOpenGLES)) {
+        fragShader.prepend(R"(
+                           precision mediump int;
+                           precision mediump float;
+                           )");
+    }
+
     // 编译 NV12 着色器
     if (!m_shaderProgramNV12.addShaderFromSourceCode(QOpenGLShader::Vertex, s_vertShader)) {
         qCritical() << "NV12 Vertex shader compile error:" << m_shaderProgramNV12.log();
-        return;
+        m_shaderProgramNV12.removeAllShaders();
+        return false;
     }
 
-    if (!m_shaderProgramNV12.addShaderFromSourceCode(QOpenGLShader::Fragment, s_fragShaderNV12)) {
+    if (!m_shaderProgramNV12.addShaderFromSourceCode(QOpenGLShader::Fragment, fragShader)) {
         qCritical() << "NV12 Fragment shader compile error:" << m_shaderProgramNV12.log();
-        return;
+        m_shaderProgramNV12.removeAllShaders();
+        return false;
     }
 
-    // 绑定属性位置
+    // 绑定属性位置（与 YUV420P 着色器一致，共享同一 VBO 属性指针）
     m_shaderProgramNV12.bindAttributeLocation("vertexIn", 0);
     m_shaderProgramNV12.bindAttributeLocation("textureIn", 1);
 
     if (!m_shaderProgramNV12.link()) {
         qCritical() << "NV12 Shader link error:" << m_shaderProgramNV12.log();
-        return;
+        m_shaderProgramNV12.removeAllShaders();
+        return false;
     }
 
-    // 设置纹理采样器 uniform
+    // 设置顶点属性和纹理采样器 uniform
     m_shaderProgramNV12.bind();
+    m_shaderProgramNV12.setAttributeBuffer("vertexIn", GL_FLOAT, 0, 3, 3 * sizeof(float));
+    m_shaderProgramNV12.enableAttributeArray("vertexIn");
+    m_shaderProgramNV12.setAttributeBuffer("textureIn", GL_FLOAT, 12 * sizeof(float), 2, 2 * sizeof(float));
+    m_shaderProgramNV12.enableAttributeArray("textureIn");
     m_shaderProgramNV12.setUniformValue("textureY", 0);
     m_shaderProgramNV12.setUniformValue("textureUV", 1);
     m_shaderProgramNV12.release();
 
     qInfo() << "NV12 shader initialized successfully";
+    return true;
 }
 
 // ---------------------------------------------------------
@@ -618,17 +669,19 @@ QImage QYUVOpenGLWidget::grabCurrentFrame()
             if (m_renderedFrame && m_renderedFrame->dataY) {
                 w = m_renderedFrame->width;
                 h = m_renderedFrame->height;
-                int uvH = h / 2;
-                int uvW = w / 2;
 
-                m_yuvDataY.resize(w * h);
-                m_yuvDataU.resize(uvW * uvH);
-                m_yuvDataV.resize(uvW * uvH);
-                for (int y = 0; y < h; ++y)
-                    memcpy(m_yuvDataY.data() + y * w, m_renderedFrame->dataY + y * m_renderedFrame->linesizeY, w);
-                for (int y = 0; y < uvH; ++y) {
-                    memcpy(m_yuvDataU.data() + y * uvW, m_renderedFrame->dataU + y * m_renderedFrame->linesizeU, uvW);
-                    memcpy(m_yuvDataV.data() + y * uvW, m_renderedFrame->dataV + y * m_renderedFrame->linesizeV, uvW);
+                grabLumaPlane(m_renderedFrame->dataY, m_renderedFrame->linesizeY, w, h);
+                if (m_renderedFrame->isNV12) {
+                    grabChromaNV12(m_renderedFrame->dataUV, m_renderedFrame->linesizeUV, w, h);
+                } else {
+                    int uvH = h / 2;
+                    int uvW = w / 2;
+                    m_yuvDataU.resize(uvW * uvH);
+                    m_yuvDataV.resize(uvW * uvH);
+                    for (int y = 0; y < uvH; ++y) {
+                        memcpy(m_yuvDataU.data() + y * uvW, m_renderedFrame->dataU + y * m_renderedFrame->linesizeU, uvW);
+                        memcpy(m_yuvDataV.data() + y * uvW, m_renderedFrame->dataV + y * m_renderedFrame->linesizeV, uvW);
+                    }
                 }
                 m_grabDataStale = false;
             }
@@ -673,6 +726,12 @@ QImage QYUVOpenGLWidget::grabCurrentFrame()
                 }
                 m_grabDataStale = false;
             }
+            // NV12 旧路径（updateTexturesNV12）：Y 已紧凑缓存，仅需拆分 UV
+            else if (m_yuvFormat == YUVFormat::NV12 && !m_yuvDataUV.empty()) {
+                grabChromaNV12(m_yuvDataUV.data(), static_cast<int>(m_linesizeUV),
+                               m_frameSize.width(), m_frameSize.height());
+                m_grabDataStale = false;
+            }
         }
 
         if (m_yuvDataY.empty() || !m_frameSize.isValid()) {
@@ -728,9 +787,42 @@ QImage QYUVOpenGLWidget::grabCurrentFrame()
 std::vector<uint8_t> QYUVOpenGLWidget::grabCurrentFrameGrayscale()
 {
     QMutexLocker locker(&m_yuvMutex);
+    // 直接帧路径为懒拷贝，这里只刷新 Y 分量（NV12/YUV420P 的 Y 平面布局相同）
+    // 不清除 m_grabDataStale，色度仍由 grabCurrentFrame 按需同步
+    if (m_grabDataStale && m_renderedFrame && m_renderedFrame->dataY) {
+        grabLumaPlane(m_renderedFrame->dataY, m_renderedFrame->linesizeY,
+                      m_renderedFrame->width, m_renderedFrame->height);
+    }
     return m_yuvDataY;  // 返回 Y 分量的副本
 }
 
+// ---------------------------------------------------------
+// 截图缓存：拷贝 Y 平面为紧凑布局（调用方持有 m_yuvMutex）
+// ---------------------------------------------------------
+void QYUVOpenGLWidget::grabLumaPlane(const uint8_t* src, int stride, int width, int height)
+{
+    m_yuvDataY.resize(static_cast<size_t>(width) * height);
+    if (stride == width) {
+        memcpy(m_yuvDataY.data(), src, m_yuvDataY.size());
+        return;
+    }
+    for (int y = 0; y < height; ++y) {
+        memcpy(m_yuvDataY.data() + y * width, src + y * stride, width);
+    }
+}
+
+// ---------------------------------------------------------
+// 截图缓存：NV12 UV 交织平面拆分为 U/V 平面（调用方持有 m_yuvMutex）
+// ---------------------------------------------------------
+void QYUVOpenGLWidget::grabChromaNV12(const uint8_t* srcUV, int stride, int width, int height)
+{
+    const int uvW = width / 2;
+    const int uvH = height / 2;
+    m_yuvDataU.resize(static_cast<size_t>(uvW) * uvH);
+    m_yuvDataV.resize(static_cast<size_t>(uvW) * uvH);
+    qsc::core::simdDeinterleaveUV(srcUV, m_yuvDataU.data(), m_yuvDataV.data(), uvW, uvH, stride, uvW, uvW);
+}
+
 // ---------------------------------------------------------
 // PBO 相关方法
 // ---------------------------------------------------------
@@ -808,6 +900,7 @@ void QYUVOpenGLWidget::initPBO()
     glGenBuffers(PBO_COUNT, m_pboY.data());
     glGenBuffers(PBO_COUNT, m_pboU.data());
     glGenBuffers(PBO_COUNT, m_pboV.data());
+    glGenBuffers(PBO_COUNT, m_pboUV.data());
 
     // 初始化 Y 分量 PBO
     for (int i = 0; i < PBO_COUNT; ++i) {
@@ -827,6 +920,12 @@ void QYUVOpenGLWidget::initPBO()
         glBufferData(GL_PIXEL_UNPACK_BUFFER, uvSize, nullptr, GL_STREAM_DRAW);
     }
 
+    // 初始化 NV12 UV 交织分量 PBO (每像素 2 字节)
+    for (int i = 0; i < PBO_COUNT; ++i) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pboUV[i]);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, uvSize * 2, nullptr, GL_STREAM_DRAW);
+    }
+
     // 解绑
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
@@ -845,10 +944,12 @@ void QYUVOpenGLWidget::deInitPBO()
     glDeleteBuffers(PBO_COUNT, m_pboY.data());
     glDeleteBuffers(PBO_COUNT, m_pboU.data());
     glDeleteBuffers(PBO_COUNT, m_pboV.data());
+    glDeleteBuffers(PBO_COUNT, m_pboUV.data());
 
     m_pboY.fill(0);
     m_pboU.fill(0);
     m_pboV.fill(0);
+    m_pboUV.fill(0);
 
     m_pboInited = false;
 
@@ -860,8 +961,12 @@ void QYUVOpenGLWidget::updateTextureWithPBONoContext(GLuint texture, quint32 tex
 {
     if (!pixels || !m_pboInited) return;
 
+    // textureType 3 为 NV12 UV 交织平面：半分辨率，每像素 2 字节
     QSize size = (textureType == 0) ? m_frameSize : m_frameSize / 2;
-    int dataSize = size.width() * size.height();
+    const int bytesPerPixel = (textureType == 3) ? 2 : 1;
+    const GLenum pixelFormat = (textureType == 3) ? GL_LUMINANCE_ALPHA : GL_LUMINANCE;
+    const int rowBytes = size.width() * bytesPerPixel;
+    int dataSize = rowBytes * size.height();
 
     // 选择对应的 PBO（固定使用索引0，不再交替）
     GLuint pbo = 0;
@@ -869,6 +974,7 @@ void QYUVOpenGLWidget::updateTextureWithPBONoContext(GLuint texture, quint32 tex
         case 0: pbo = m_pboY[0]; break;
         case 1: pbo = m_pboU[0]; break;
         case 2: pbo = m_pboV[0]; break;
+        case 3: pbo = m_pboUV[0]; break;
         default: return;
     }
 
@@ -891,14 +997,14 @@ void QYUVOpenGLWidget::updateTextureWithPBONoContext(GLuint texture, quint32 tex
     }
 
     const uint8_t* srcData = pixels;
-    bool needStrideCopy = (stride != static_cast<quint32>(size.width()));
+    bool needStrideCopy = (stride != static_cast<quint32>(rowBytes));
 
     if (needStrideCopy) {
         if (m_pboTempBuffer.size() < static_cast<size_t>(dataSize)) {
             m_pboTempBuffer.resize(dataSize);
         }
         for (int y = 0; y < size.height(); ++y) {
-            memcpy(m_pboTempBuffer.data() + y * size.width(), pixels + y * stride, size.width());
+            memcpy(m_pboTempBuffer.data() + y * rowBytes, pixels + y * stride, rowBytes);
         }
         srcData = m_pboTempBuffer.data();
     }
@@ -926,7 +1032,7 @@ void QYUVOpenGLWidget::updateTextureWithPBONoContext(GLuint texture, quint32 tex
     glBindTexture(GL_TEXTURE_2D, texture);
     glPixelStorei(GL_UNPACK_ROW_LENGTH, size.width());
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.width(), size.height(),
-                    GL_LUMINANCE, GL_UNSIGNED_BYTE, nullptr);
+                    pixelFormat, GL_UNSIGNED_BYTE, nullptr);
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
@@ -937,13 +1043,17 @@ void QYUVOpenGLWidget::updateTextureWithPBO(GLuint texture, quint32 textureType,
     if (!pixels || !m_pboInited) return;
 
     QSize size = (textureType == 0) ? m_frameSize : m_frameSize / 2;
-    int dataSize = size.width() * size.height();
+    const int bytesPerPixel = (textureType == 3) ? 2 : 1;
+    const GLenum pixelFormat = (textureType == 3) ? GL_LUMINANCE_ALPHA : GL_LUMINANCE;
+    const int rowBytes = size.width() * bytesPerPixel;
+    int dataSize = rowBytes * size.height();
 
     GLuint pbo = 0;
     switch (textureType) {
         case 0: pbo = m_pboY[0]; break;
         case 1: pbo = m_pboU[0]; break;
         case 2: pbo = m_pboV[0]; break;
+        case 3: pbo = m_pboUV[0]; break;
         default: return;
     }
 
@@ -965,14 +1075,14 @@ void QYUVOpenGLWidget::updateTextureWithPBO(GLuint texture, quint32 textureType,
     }
 
     const uint8_t* srcData = pixels;
-    bool needStrideCopy = (stride != static_cast<quint32>(size.width()));
+    bool needStrideCopy = (stride != static_cast<quint32>(rowBytes));
 
     if (needStrideCopy) {
         if (m_pboTempBuffer.size() < static_cast<size_t>(dataSize)) {
             m_pboTempBuffer.resize(dataSize);
         }
         for (int y = 0; y < size.height(); ++y) {
-            memcpy(m_pboTempBuffer.data() + y * size.width(), pixels + y * stride, size.width());
+            memcpy(m_pboTempBuffer.data() + y * rowBytes, pixels + y * stride, rowBytes);
         }
         srcData = m_pboTempBuffer.data();
     }
@@ -998,7 +1108,7 @@ void QYUVOpenGLWidget::updateTextureWithPBO(GLuint texture, quint32 textureType,
     glBindTexture(GL_TEXTURE_2D, texture);
     glPixelStorei(GL_UNPACK_ROW_LENGTH, size.width());
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.width(), size.height(),
-                    GL_LUMINANCE, GL_UNSIGNED_BYTE, nullptr);
+                    pixelFormat, GL_UNSIGNED_BYTE, nullptr);
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
     doneCurrent();
@@ -1017,6 +1127,46 @@ bool QYUVOpenGLWidget::isRegionDirty(const quint8* newData, const quint8* oldDat
     return false;
 }
 
+// ---------------------------------------------------------
+// NV12 帧上传（在 paintGL 中调用，上下文已就绪）
+// 返回 true 表示已上传到 NV12 纹理，应使用 NV12 着色器绘制；
+// NV12 着色器不可用时在此去交织为 U/V 平面，走 YUV420P 着色器
+// ---------------------------------------------------------
+bool QYUVOpenGLWidget::uploadFrameNV12(quint8 *dataY, quint8 *dataUV, quint32 linesizeY, quint32 linesizeUV)
+{
+    if (m_nv12Supported && m_textureNV12[0] && m_textureNV12[1]) {
+        if (isPBOEnabled() && m_pboInited) {
+            updateTextureWithPBONoContext(m_textureNV12[0], 0, dataY, linesizeY);
+            updateTextureWithPBONoContext(m_textureNV12[1], 3, dataUV, linesizeUV);
+        } else {
+            updateTextureNoContext(m_textureNV12[0], 0, dataY, linesizeY);
+            updateTextureNoContext(m_textureNV12[1], 3, dataUV, linesizeUV);
+        }
+        return true;
+    }
+
+    if (!dataUV) return false;
+
+    // 回退：CPU 去交织 (解码端尚未收到能力通知时的过渡帧)
+    const int uvW = m_frameSize.width() / 2;
+    const int uvH = m_frameSize.height() / 2;
+    m_nv12FallbackU.resize(static_cast<size_t>(uvW) * uvH);
+    m_nv12FallbackV.resize(static_cast<size_t>(uvW) * uvH);
+    qsc::core::simdDeinterleaveUV(dataUV, m_nv12FallbackU.data(), m_nv12FallbackV.data(), uvW, uvH,
+                                  static_cast<int>(linesizeUV), uvW, uvW);
+
+    if (isPBOEnabled() && m_pboInited) {
+        updateTextureWithPBONoContext(m_texture[0], 0, dataY, linesizeY);
+        updateTextureWithPBONoContext(m_texture[1], 1, m_nv12FallbackU.data(), uvW);
+        updateTextureWithPBONoContext(m_texture[2], 2, m_nv12FallbackV.data(), uvW);
+    } else {
+        updateTextureNoContext(m_texture[0], 0, dataY, linesizeY);
+        updateTextureNoContext(m_texture[1], 1, m_nv12FallbackU.data(), uvW);
+        updateTextureNoContext(m_texture[2], 2, m_nv12FallbackV.data(), uvW);
+    }
+    return false;
+}
+
 // ---------------------------------------------------------
 // OpenGL 初始化
 // 创建VBO，编译着色器，检查PBO支持
@@ -1036,6 +1186,17 @@ void QYUVOpenGLWidget::initializeGL()
     // 检查并初始化 PBO
     checkPBOSupport();
 
+    // 探测 NV12 直接渲染能力：Core Profile 不支持 GL_LUMINANCE_ALPHA
+    {
+        QOpenGLContext* ctx = QOpenGLContext::currentContext();
+        const bool coreProfile = ctx && !ctx->isOpenGLES() &&
+                                 ctx->format().profile() == QSurfaceFormat::CoreProfile;
+        m_nv12Supported = !coreProfile && initShaderNV12();
+        m_nv12Probed = true;
+        qInfo() << "NV12 direct rendering" << (m_nv12Supported ? "enabled" : "disabled (fallback to YUV420P)");
+        emit nv12SupportDetected(m_nv12Supported);
+    }
+
     // 提升渲染线程优先级
 #ifdef Q_OS_WIN
     SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
@@ -1066,7 +1227,6 @@ void QYUVOpenGLWidget::paintGL()
     }
 
     m_renderTimer.start();
-    m_shaderProgram.bind();
 
     if (m_needUpdate) {
         deInitPBO();
@@ -1083,10 +1243,12 @@ void QYUVOpenGLWidget::paintGL()
         DirectFrameSlot* directFrame = m_pendingDirectFrame.exchange(nullptr, std::memory_order_acq_rel);
 
         if (!directFrame && !m_hasPendingFrame.load(std::memory_order_acquire)) {
-            m_shaderProgram.release();
             return;
         }
 
+        // 无新数据时沿用上次的着色器和纹理重绘
+        bool drawNV12 = m_lastDrawNV12;
+
         {
             if (directFrame) {
                 // 释放上一帧渲染的帧
@@ -1111,20 +1273,26 @@ void QYUVOpenGLWidget::paintGL()
                     m_needUpdate = false;
                 }
 
-                if (isPBOEnabled() && m_pboInited) {
+                if (directFrame->isNV12) {
+                    drawNV12 = uploadFrameNV12(directFrame->dataY, directFrame->dataUV,
+                                               directFrame->linesizeY, directFrame->linesizeUV);
+                } else if (isPBOEnabled() && m_pboInited) {
                     updateTextureWithPBONoContext(m_texture[0], 0, directFrame->dataY, directFrame->linesizeY);
                     updateTextureWithPBONoContext(m_texture[1], 1, directFrame->dataU, directFrame->linesizeU);
                     updateTextureWithPBONoContext(m_texture[2], 2, directFrame->dataV, directFrame->linesizeV);
+                    drawNV12 = false;
                 } else {
                     updateTextureNoContext(m_texture[0], 0, directFrame->dataY, directFrame->linesizeY);
                     updateTextureNoContext(m_texture[1], 1, directFrame->dataU, directFrame->linesizeU);
                     updateTextureNoContext(m_texture[2], 2, directFrame->dataV, directFrame->linesizeV);
+                    drawNV12 = false;
                 }
 
                 m_grabDataStale = true;
                 m_linesizeY = w;
                 m_linesizeU = w / 2;
                 m_linesizeV = w / 2;
+                m_linesizeUV = w;
 
                 // 保留帧引用用于截图
                 m_renderedFrame = directFrame;
@@ -1153,6 +1321,7 @@ void QYUVOpenGLWidget::paintGL()
                     updateTextureNoContext(m_texture[1], 1, const_cast<quint8*>(dataU), m_zcLinesizeU);
                     updateTextureNoContext(m_texture[2], 2, const_cast<quint8*>(dataV), m_zcLinesizeV);
                 }
+                drawNV12 = false;
 
                 m_grabDataStale = true;
                 m_linesizeY = m_zcFrameWidth;
@@ -1164,28 +1333,45 @@ void QYUVOpenGLWidget::paintGL()
                 }
                 else if (!m_yuvDataY.empty() && m_frameSize.isValid()) {
                 // 回退到旧路径
-                if (isPBOEnabled() && m_pboInited) {
+                if (m_yuvFormat == YUVFormat::NV12 && !m_yuvDataUV.empty()) {
+                    drawNV12 = uploadFrameNV12(m_yuvDataY.data(), m_yuvDataUV.data(), m_linesizeY, m_linesizeUV);
+                } else if (isPBOEnabled() && m_pboInited) {
                     updateTextureWithPBONoContext(m_texture[0], 0, m_yuvDataY.data(), m_linesizeY);
                     updateTextureWithPBONoContext(m_texture[1], 1, m_yuvDataU.data(), m_linesizeU);
                     updateTextureWithPBONoContext(m_texture[2], 2, m_yuvDataV.data(), m_linesizeV);
+                    drawNV12 = false;
                 } else {
                     updateTextureNoContext(m_texture[0], 0, m_yuvDataY.data(), m_linesizeY);
                     updateTextureNoContext(m_texture[1], 1, m_yuvDataU.data(), m_linesizeU);
                     updateTextureNoContext(m_texture[2], 2, m_yuvDataV.data(), m_linesizeV);
+                    drawNV12 = false;
                 }
                 m_hasPendingFrame.store(false, std::memory_order_release);
                 }
             } // end else (non-direct fallback path)
         } // end hasPendingFrame block
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_texture[0]);
+        m_lastDrawNV12 = drawNV12;
+        QOpenGLShaderProgram& program = drawNV12 ? m_shaderProgramNV12 : m_shaderProgram;
+        program.bind();
+
+        if (drawNV12) {
+            // NV12: Y + UV 两个纹理
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, m_textureNV12[0]);
+
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, m_textureNV12[1]);
+        } else {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, m_texture[0]);
 
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, m_texture[1]);
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, m_texture[1]);
 
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, m_texture[2]);
+            glActiveTexture(GL_TEXTURE2);
+            glBindTexture(GL_TEXTURE_2D, m_texture[2]);
+        }
 
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
@@ -1201,9 +1387,9 @@ void QYUVOpenGLWidget::paintGL()
                     Qt::HighEventPriority);
             }
         }
-    }
 
-    m_shaderProgram.release();
+        program.release();
+    }
 
     double renderTimeMs = m_renderTimer.nsecsElapsed() / 1000000.0;
     m_totalRenderTime += renderTimeMs;
@@ -1280,6 +1466,9 @@ void QYUVOpenGLWidget::initShader()
     }
     m_shaderProgram.addShaderFromSourceCode(QOpenGLShader::Vertex, s_vertShader);
     m_shaderProgram.addShaderFromSourceCode(QOpenGLShader::Fragment, s_fragShader);
+    // 固定属性位置，与 NV12 着色器共享 VBO 属性指针
+    m_shaderProgram.bindAttributeLocation("vertexIn", 0);
+    m_shaderProgram.bindAttributeLocation("textureIn", 1);
     m_shaderProgram.link();
     m_shaderProgram.bind();
 
@@ -1324,6 +1513,11 @@ void QYUVOpenGLWidget::initTextures()
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, m_frameSize.width() / 2, m_frameSize.height() / 2, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, nullptr);
 
+    // NV12 纹理与 YUV420P 纹理同时存在，按帧格式选择着色器
+    if (m_nv12Supported) {
+        initTexturesNV12();
+    }
+
     m_textureInited = true;
 }
 
@@ -1331,8 +1525,12 @@ void QYUVOpenGLWidget::deInitTextures()
 {
     if (QOpenGLFunctions::isInitialized(QOpenGLFunctions::d_ptr)) {
         glDeleteTextures(3, m_texture);
+        if (m_textureNV12[0]) {
+            glDeleteTextures(2, m_textureNV12);
+        }
     }
     memset(m_texture, 0, sizeof(m_texture));
+    memset(m_textureNV12, 0, sizeof(m_textureNV12));
     m_textureInited = false;
 }
 
@@ -1341,22 +1539,30 @@ void QYUVOpenGLWidget::updateTextureNoContext(GLuint texture, quint32 textureTyp
 {
     if (!pixels) return;
     QSize size = 0 == textureType ? m_frameSize : m_frameSize / 2;
+    // textureType 3: NV12 UV 交织平面，ROW_LENGTH 以像素(2 字节)计
+    const bool isUV = (3 == textureType);
+    const GLenum pixelFormat = isUV ? GL_LUMINANCE_ALPHA : GL_LUMINANCE;
+    const GLint rowLength = static_cast<GLint>(isUV ? stride / 2 : stride);
 
     glBindTexture(GL_TEXTURE_2D, texture);
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(stride));
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.width(), size.height(), GL_LUMINANCE, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.width(), size.height(), pixelFormat, GL_UNSIGNED_BYTE, pixels);
 }
 
 void QYUVOpenGLWidget::updateTexture(GLuint texture, quint32 textureType, quint8 *pixels, quint32 stride)
 {
     if (!pixels) return;
     QSize size = 0 == textureType ? m_frameSize : m_frameSize / 2;
+    // textureType 3: NV12 UV 交织平面，ROW_LENGTH 以像素(2 字节)计
+    const bool isUV = (3 == textureType);
+    const GLenum pixelFormat = isUV ? GL_LUMINANCE_ALPHA : GL_LUMINANCE;
+    const GLint rowLength = static_cast<GLint>(isUV ? stride / 2 : stride);
 
     makeCurrent();
 
     glBindTexture(GL_TEXTURE_2D, texture);
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(stride));
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.width(), size.height(), GL_LUMINANCE, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.width(), size.height(), pixelFormat, GL_UNSIGNED_BYTE, pixels);
 
     doneCurrent();
 }
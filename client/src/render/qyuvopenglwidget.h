@@ -69,6 +69,9 @@ struct DirectFrameSlot {
     int linesizeU = 0;
     int linesizeV = 0;
     std::function<void()> releaseCallback;
+    uint8_t* dataUV = nullptr;      // NV12: UV 交织平面（isNV12 时 dataU/dataV 为空）
+    int linesizeUV = 0;
+    bool isNV12 = false;
 };
 class QYUVOpenGLWidget
     : public QOpenGLWidget
@@ -124,6 +127,25 @@ public:
                           int linesizeY, int linesizeU, int linesizeV,
                           std::function<void()> releaseCallback);
 
+    /**
+     * @brief 零拷贝帧提交 - NV12 直接指针版本
+     *
+     * Y + UV 交织双平面直接上传，由 NV12 着色器完成色彩转换，
+     * 省去 CPU 端 UV 去交织。着色器不可用时在 GUI 线程回退为去交织。
+     *
+     * @param dataY Y 分量指针
+     * @param dataUV UV 交织分量指针
+     * @param width 帧宽度
+     * @param height 帧高度
+     * @param linesizeY Y 分量行字节数
+     * @param linesizeUV UV 分量行字节数
+     * @param releaseCallback 渲染完成后的释放回调
+     */
+    void submitFrameDirectNV12(uint8_t* dataY, uint8_t* dataUV,
+                               int width, int height,
+                               int linesizeY, int linesizeUV,
+                               std::function<void()> releaseCallback);
+
     // NV12: 直接 NV12 格式更新 (避免格式转换)
     void updateTexturesNV12(quint8 *dataY, quint8 *dataUV, quint32 linesizeY, quint32 linesizeUV);
 
@@ -155,6 +177,16 @@ public:
      */
     bool isPBOSupported() const { return m_pboSupported; }
 
+    /**
+     * @brief NV12 着色器是否可用（Core Profile 下无 GL_LUMINANCE_ALPHA）
+     */
+    bool isNV12Supported() const { return m_nv12Supported; }
+
+    /**
+     * @brief 是否已完成 NV12 能力探测（initializeGL 之后为 true）
+     */
+    bool isNV12Probed() const { return m_nv12Probed; }
+
     /**
      * @brief 释放当前持有的直接指针帧
      *
@@ -178,6 +210,11 @@ signals:
      */
     void statisticsUpdated(const RenderStatistics& stats);
 
+    /**
+     * @brief NV12 渲染能力探测完成信号 (initializeGL 中发送)
+     */
+    void nv12SupportDetected(bool supported);
+
 protected:
     void initializeGL() override;
     void paintGL() override;
@@ -189,7 +226,7 @@ protected:
 
 private:
     void initShader();
-    void initShaderNV12();                                  // NV12: NV12 专用着色器
+    bool initShaderNV12();                                  // NV12: NV12 专用着色器
     void initTextures();
     void initTexturesNV12();                                // NV12: NV12 纹理初始化
     void deInitTextures();
@@ -203,6 +240,16 @@ private:
     void updateTextureWithPBONoContext(GLuint texture, quint32 textureType, quint8 *pixels, quint32 stride);
     bool checkPBOSupport();
 
+    // === 直接帧投递 ===
+    void submitDirectSlot(DirectFrameSlot* slot);
+
+    // === NV12 上传 ===
+    bool uploadFrameNV12(quint8 *dataY, quint8 *dataUV, quint32 linesizeY, quint32 linesizeUV);
+
+    // === 截图缓存（调用方持有 m_yuvMutex）===
+    void grabLumaPlane(const uint8_t* src, int stride, int width, int height);
+    void grabChromaNV12(const uint8_t* srcUV, int stride, int width, int height);
+
     // === 脏区域检测 ===
     bool isRegionDirty(const quint8* newData, const quint8* oldData, size_t size, int sampleStep = 64);
 
@@ -216,6 +263,11 @@ private:
     GLuint m_texture[3] = { 0 };
     GLuint m_textureNV12[2] = { 0 };                        // NV12: Y + UV 纹理
     YUVFormat m_yuvFormat = YUVFormat::YUV420P;             // NV12: 当前格式
+    bool m_nv12Supported = false;                           // NV12: 着色器可用
+    bool m_nv12Probed = false;                              // NV12: 已完成能力探测
+    bool m_lastDrawNV12 = false;                            // NV12: 上次绘制使用的着色器
+    std::vector<uint8_t> m_nv12FallbackU;                   // NV12 不可用时的去交织缓冲
+    std::vector<uint8_t> m_nv12FallbackV;
 
     // YUV 数据缓存 (用于帧获取)
     QMutex m_yuvMutex;
@@ -262,6 +314,7 @@ private:
     std::array<GLuint, PBO_COUNT> m_pboY = {0, 0};          // Y 分量 PBO
     std::array<GLuint, PBO_COUNT> m_pboU = {0, 0};          // U 分量 PBO
     std::array<GLuint, PBO_COUNT> m_pboV = {0, 0};          // V 分量 PBO
+    std::array<GLuint, PBO_COUNT> m_pboUV = {0, 0};         // NV12: UV 交织分量 PBO
     int m_pboIndex = 0;                                     // 当前写入的 PBO 索引
     bool m_pboEnabled = true;                               // PBO 是否启用
     bool m_pboSupported = false;                            // 硬件是否支持 PBO
@@ -0,0 +1,213 @@
+/**
+ * @file BandwidthEstimator.cpp
+ * @brief 接收端带宽估计实现
+ */
+
+#include "BandwidthEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+BandwidthEstimator::BandwidthEstimator(uint32_t maxBitrateBps)
+    : m_maxBitrate(std::max(maxBitrateBps, MIN_BITRATE))
+    , m_target(m_maxBitrate)
+{
+}
+
+void BandwidthEstimator::setMaxBitrate(uint32_t maxBitrateBps)
+{
+    m_maxBitrate = std::max(maxBitrateBps, MIN_BITRATE);
+    m_target = std::min(m_target, m_maxBitrate);
+}
+
+void BandwidthEstimator::onPacket(int64_t nowMs, int bytes, uint32_t lost)
+{
+    m_arrivals.push_back({nowMs, bytes});
+    m_windowBytes += bytes;
+    while (!m_arrivals.empty() && nowMs - m_arrivals.front().time > RATE_WINDOW_MS) {
+        m_windowBytes -= m_arrivals.front().bytes;
+        m_arrivals.pop_front();
+    }
+
+    if (m_lossWindowStart < 0) {
+        m_lossWindowStart = nowMs;
+    }
+    m_lossReceived++;
+    m_lossLost += lost;
+    if (nowMs - m_lossWindowStart >= LOSS_WINDOW_MS) {
+        const uint32_t total = m_lossReceived + m_lossLost;
+        // 样本太少时丢包率没有意义（静止画面几乎不发包）
+        if (total >= 20) {
+            m_lossRatio = static_cast<double>(m_lossLost) / total;
+            m_lossUpdated = true;
+        }
+        m_lossReceived = 0;
+        m_lossLost = 0;
+        m_lossWindowStart = nowMs;
+    }
+}
+
+void BandwidthEstimator::onFrame(int64_t nowMs, int64_t ptsUs)
+{
+    if (!m_hasPrevFrame || ptsUs < m_prevPts) {
+        // 首帧或 PTS 回退（编码器重建），重新开始
+        m_hasPrevFrame = true;
+        m_prevArrival = nowMs;
+        m_prevPts = ptsUs;
+        return;
+    }
+    if (ptsUs == m_prevPts) {
+        return;
+    }
+
+    // 延迟变化 = 到达间隔 - 发送（采集）间隔；队列增长时持续为正
+    const double delay = static_cast<double>(nowMs - m_prevArrival)
+                         - static_cast<double>(ptsUs - m_prevPts) / 1000.0;
+    m_prevArrival = nowMs;
+    m_prevPts = ptsUs;
+    updateTrendline(nowMs, delay);
+}
+
+void BandwidthEstimator::updateTrendline(int64_t nowMs, double delayMs)
+{
+    m_numDeltas = std::min(m_numDeltas + 1, 1000);
+    m_accumulatedDelay += delayMs;
+    m_smoothedDelay = TRENDLINE_SMOOTHING * m_smoothedDelay
+                      + (1.0 - TRENDLINE_SMOOTHING) * m_accumulatedDelay;
+    if (m_firstArrival < 0) {
+        m_firstArrival = nowMs;
+    }
+    m_trend.push_back({static_cast<double>(nowMs - m_firstArrival), m_smoothedDelay});
+    if (static_cast<int>(m_trend.size()) > TRENDLINE_WINDOW) {
+        m_trend.pop_front();
+    }
+
+    double trend = m_prevTrend;
+    if (static_cast<int>(m_trend.size()) == TRENDLINE_WINDOW) {
+        // 最小二乘斜率：累积延迟随时间的增长速度
+        double sumX = 0.0, sumY = 0.0;
+        for (const TrendPoint &p : m_trend) {
+            sumX += p.x;
+            sumY += p.y;
+        }
+        const double avgX = sumX / TRENDLINE_WINDOW;
+        const double avgY = sumY / TRENDLINE_WINDOW;
+        double numerator = 0.0, denominator = 0.0;
+        for (const TrendPoint &p : m_trend) {
+            numerator += (p.x - avgX) * (p.y - avgY);
+            denominator += (p.x - avgX) * (p.x - avgX);
+        }
+        if (denominator != 0.0) {
+            trend = numerator / denominator;
+        }
+    }
+    detect(nowMs, trend);
+}
+
+void BandwidthEstimator::detect(int64_t nowMs, double trend)
+{
+    const double modified = std::min(m_numDeltas, 60) * trend * TRENDLINE_GAIN;
+    const int64_t elapsed = m_lastDetect < 0 ? 0 : nowMs - m_lastDetect;
+    m_lastDetect = nowMs;
+
+    if (modified > m_threshold) {
+        m_overuseTime = m_overuseTime < 0 ? elapsed / 2.0 : m_overuseTime + elapsed;
+        m_overuseCount++;
+        // 持续过载且趋势未回落才判定，避免单帧抖动（如 I 帧）触发降码率
+        if (m_overuseTime > OVERUSE_TIME_MS && m_overuseCount > 1 && trend >= m_prevTrend) {
+            m_usage = Usage::Overusing;
+            m_overuseTime = 0.0;
+            m_overuseCount = 0;
+        }
+    } else if (modified < -m_threshold) {
+        m_overuseTime = -1.0;
+        m_overuseCount = 0;
+        m_usage = Usage::Underusing;
+    } else {
+        m_overuseTime = -1.0;
+        m_overuseCount = 0;
+        m_usage = Usage::Normal;
+    }
+    m_prevTrend = trend;
+    updateThreshold(nowMs, modified);
+}
+
+void BandwidthEstimator::updateThreshold(int64_t nowMs, double modifiedTrend)
+{
+    if (m_lastThresholdUpdate < 0) {
+        m_lastThresholdUpdate = nowMs;
+    }
+    const double magnitude = std::fabs(modifiedTrend);
+    // 突变（如路由切换）不参与阈值自适应
+    if (magnitude > m_threshold + 15.0) {
+        m_lastThresholdUpdate = nowMs;
+        return;
+    }
+    // 阈值向当前趋势靠拢：下降快、上升慢，和并发 TCP 流竞争时不至于饿死
+    const double k = magnitude < m_threshold ? 0.039 : 0.0087;
+    const int64_t elapsed = std::min<int64_t>(nowMs - m_lastThresholdUpdate, 100);
+    m_threshold += k * (magnitude - m_threshold) * elapsed;
+    m_threshold = std::max(6.0, std::min(600.0, m_threshold));
+    m_lastThresholdUpdate = nowMs;
+}
+
+uint32_t BandwidthEstimator::update(int64_t nowMs)
+{
+    while (!m_arrivals.empty() && nowMs - m_arrivals.front().time > RATE_WINDOW_MS) {
+        m_windowBytes -= m_arrivals.front().bytes;
+        m_arrivals.pop_front();
+    }
+    if (m_lastUpdate < 0) {
+        m_lastUpdate = nowMs;
+        return m_target;
+    }
+    const int64_t elapsed = std::min<int64_t>(nowMs - m_lastUpdate, 1000);
+    m_lastUpdate = nowMs;
+
+    double target = m_target;
+    const double incoming = incomingBitrate();
+    const bool canDecrease = m_lastDecrease < 0 || nowMs - m_lastDecrease >= DECREASE_INTERVAL_MS;
+
+    if (m_usage == Usage::Overusing && incoming > 0 && canDecrease) {
+        target = std::min(target, DECREASE_FACTOR * incoming);
+        m_lastDecrease = nowMs;
+    }
+    if (m_lossUpdated) {
+        m_lossUpdated = false;
+        if (m_lossRatio > HIGH_LOSS) {
+            target *= 1.0 - 0.5 * m_lossRatio;
+            m_lastDecrease = nowMs;
+        }
+    }
+    // 刚降过码率时等一个间隔再增长，让编码器输出和队列先稳定下来
+    if (m_usage == Usage::Normal && m_lossRatio < LOW_LOSS
+        && (m_lastDecrease < 0 || nowMs - m_lastDecrease >= DECREASE_INTERVAL_MS)) {
+        target *= 1.0 + INCREASE_PER_SECOND * elapsed / 1000.0;
+    }
+
+    const double minimum = std::min(MIN_BITRATE, m_maxBitrate);
+    m_target = static_cast<uint32_t>(std::max(minimum, std::min<double>(m_maxBitrate, target)));
+    return m_target;
+}
+
+uint32_t BandwidthEstimator::incomingBitrate() const
+{
+    if (m_arrivals.size() < 2) return 0;
+    const int64_t span = m_arrivals.back().time - m_arrivals.front().time;
+    // 窗口不足 200ms 时速率不可信
+    if (span < 200) return 0;
+    return static_cast<uint32_t>(m_windowBytes * 8 * 1000 / span);
+}
+
+const char *BandwidthEstimator::usageName() const
+{
+    switch (m_usage) {
+    case Usage::Overusing:
+        return "overuse";
+    case Usage::Underusing:
+        return "underuse";
+    case Usage::Normal:
+    default:
+        return "normal";
+    }
+}
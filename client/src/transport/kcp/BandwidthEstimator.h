@@ -0,0 +1,132 @@
+/**
+ * @file BandwidthEstimator.h
+ * @brief 接收端带宽估计 / Receiver-side bandwidth estimation (REMB-style)
+ *
+ * 在视频接收路径上估计可用带宽，经控制通道把目标码率回报给设备端编码器，
+ * 让编码器在网络队列堆积之前主动降码率。
+ *
+ * 三路信号 / Signals:
+ * - 到达速率：最近 500ms 收到的字节数
+ * - 延迟梯度：以帧为组，比较相邻帧的到达间隔与 PTS 间隔，
+ *             累积延迟经平滑后做线性回归（trendline），斜率持续超过自适应阈值即判定过载
+ * - 丢包率：原始丢包（FEC 恢复前），每 500ms 窗口统计一次
+ *
+ * 码率控制（AIMD）/ Rate control:
+ * - 过载：目标降至 0.85 × 到达速率（每 200ms 最多一次）
+ * - 欠载（队列排空中）：保持
+ * - 正常：每秒 +8% 乘性增长，上限为配置码率
+ * - 丢包 > 10%：按 (1 - 0.5 × 丢包率) 下调；2%~10% 保持；< 2% 允许增长
+ *
+ * 非线程安全：只在接收 IO 线程调用；目标码率由调用方以原子变量发布。
+ */
+
+#ifndef BANDWIDTH_ESTIMATOR_H
+#define BANDWIDTH_ESTIMATOR_H
+
+#include <cstdint>
+#include <deque>
+
+class BandwidthEstimator
+{
+public:
+    enum class Usage {
+        Normal,
+        Overusing,
+        Underusing,
+    };
+
+    static constexpr int TRENDLINE_WINDOW = 20;         // 回归窗口（帧组数）
+    static constexpr double TRENDLINE_SMOOTHING = 0.9;
+    static constexpr double TRENDLINE_GAIN = 4.0;
+    static constexpr double INITIAL_THRESHOLD = 12.5;
+    static constexpr int64_t OVERUSE_TIME_MS = 10;      // 持续过载时间
+    static constexpr int64_t RATE_WINDOW_MS = 500;
+    static constexpr int64_t LOSS_WINDOW_MS = 500;
+    static constexpr int64_t DECREASE_INTERVAL_MS = 200;
+    static constexpr double DECREASE_FACTOR = 0.85;
+    static constexpr double INCREASE_PER_SECOND = 0.08;
+    static constexpr double HIGH_LOSS = 0.10;
+    static constexpr double LOW_LOSS = 0.02;
+    static constexpr uint32_t MIN_BITRATE = 500000;     // 500kbps 保底
+
+    explicit BandwidthEstimator(uint32_t maxBitrateBps = 8000000);
+
+    /**
+     * @brief 配置码率上限（用户设置的码率），目标码率被钳到 [MIN_BITRATE, max]
+     */
+    void setMaxBitrate(uint32_t maxBitrateBps);
+
+    /**
+     * @brief 收到一个数据包
+     * @param lost 该包之前的序号空洞（原始丢包数，可靠传输传 0）
+     */
+    void onPacket(int64_t nowMs, int bytes, uint32_t lost = 0);
+
+    /**
+     * @brief 一帧完整收到；nowMs 为该帧首包到达时间（与帧大小无关，I 帧不会误判过载），
+     *        ptsUs 为编码器 PTS，配置帧不要传入
+     */
+    void onFrame(int64_t nowMs, int64_t ptsUs);
+
+    /**
+     * @brief 推进码率控制，返回最新目标码率（bps）
+     */
+    uint32_t update(int64_t nowMs);
+
+    uint32_t targetBitrate() const { return m_target; }
+    uint32_t incomingBitrate() const;
+    double lossRatio() const { return m_lossRatio; }
+    Usage usage() const { return m_usage; }
+    const char *usageName() const;
+
+private:
+    void updateTrendline(int64_t nowMs, double delayMs);
+    void detect(int64_t nowMs, double trend);
+    void updateThreshold(int64_t nowMs, double modifiedTrend);
+
+private:
+    uint32_t m_maxBitrate;
+    uint32_t m_target;
+    int64_t m_lastUpdate = -1;
+    int64_t m_lastDecrease = -1;
+
+    // 到达速率（滑动窗口）
+    struct Arrival {
+        int64_t time;
+        int bytes;
+    };
+    std::deque<Arrival> m_arrivals;
+    int64_t m_windowBytes = 0;
+
+    // 丢包
+    uint32_t m_lossReceived = 0;
+    uint32_t m_lossLost = 0;
+    int64_t m_lossWindowStart = -1;
+    double m_lossRatio = 0.0;
+    bool m_lossUpdated = false;
+
+    // 延迟梯度（帧组）
+    bool m_hasPrevFrame = false;
+    int64_t m_prevArrival = 0;
+    int64_t m_prevPts = 0;
+    int64_t m_firstArrival = -1;
+    double m_accumulatedDelay = 0.0;
+    double m_smoothedDelay = 0.0;
+    int m_numDeltas = 0;
+    struct TrendPoint {
+        double x;       // 到达时间（ms，相对首帧）
+        double y;       // 平滑累积延迟（ms）
+    };
+    std::deque<TrendPoint> m_trend;
+    double m_prevTrend = 0.0;
+
+    // 过载检测
+    Usage m_usage = Usage::Normal;
+    double m_threshold = INITIAL_THRESHOLD;
+    int64_t m_lastThresholdUpdate = -1;
+    double m_overuseTime = -1.0;
+    int m_overuseCount = 0;
+    int64_t m_lastDetect = -1;
+};
+
+#endif // BANDWIDTH_ESTIMATOR_H
@@ -2,23 +2,26 @@
  * @file FecCodec.h
  * @brief FEC 前向纠错编解码器 / Forward Error Correction Codec
  *
- * 基于 XOR 的简单 FEC，用于 KCP 传输层。
- * Simple XOR-based FEC for KCP transport layer.
+ * 用于 KCP 传输层的 FEC，支持两种方案 / Two schemes for KCP transport layer:
+ * - XOR (parityCount=1): 每 N 个数据包生成 1 个 XOR 校验包，可恢复组内 1 个丢包
+ * - Reed-Solomon (parityCount>1): 系统 Cauchy RS 码 (GF(2^8))，
+ *   k 个数据包 + m 个校验包，组内任意 m 个丢包均可恢复
  *
- * 原理：每 N 个数据包生成 1 个 FEC 校验包。
- * 当丢失 1 个数据包时，可通过其余 N-1 个数据包和 FEC 包恢复，
- * 无需等待 KCP 重传（至少 1 RTT），消除尾延迟。
- *
- * Principle: For every N data packets, generate 1 FEC parity packet.
- * When 1 packet is lost, recover from remaining N-1 packets + FEC packet,
- * eliminating the need to wait for KCP retransmission (at least 1 RTT).
+ * 当丢包可恢复时，无需等待 KCP 重传（至少 1 RTT），消除尾延迟。
+ * When losses are recoverable, no need to wait for KCP retransmission
+ * (at least 1 RTT), eliminating tail latency.
  *
  * 编码格式 / Encoding format:
- *   [1B type] [1B groupId] [1B index] [1B groupSize] [2B originalLen] [payload...]
- *   type: 0x01 = 数据包, 0x02 = FEC 校验包
+ *   XOR: [1B type] [1B groupId] [1B index] [1B groupSize] [2B originalLen] [payload...]
+ *        type: 0x01 = 数据包, 0x02 = FEC 校验包
+ *   RS:  [1B type] [1B groupId] [1B index] [1B k] [1B m] [2B originalLen] [payload...]
+ *        type: 0x03 = 数据包, 0x04 = RS 校验包 (index = k + 校验序号)
+ *
+ * 协商 / Negotiation:
+ *   XOR 包格式与旧版本完全一致；RS 仅在双方约定后启用（客户端通过 kcp_fec=k:m
+ *   服务端参数下发）。解码器同时识别两种格式，未启用 RS 的一端不会收到 RS 包。
  *
- * 默认配置: groupSize=10, fecCount=2 (10:2 编码)
- * 最多容忍同组内丢失 1 个包（XOR FEC 限制，非 Reed-Solomon）
+ * 默认配置: groupSize=10, parityCount=1 (XOR 10:1 编码)
  *
  * 线程安全: 编码器和解码器各自线程安全，可在不同线程使用。
  */
@@ -29,54 +32,280 @@
 #include <cstdint>
 #include <cstring>
 #include <vector>
-#include <functional>
 #include <mutex>
 #include <array>
+#include <atomic>
 #include <algorithm>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
 namespace fec {
 
 // FEC 包头大小
 static constexpr int FEC_HEADER_SIZE = 6;
+static constexpr int FEC_RS_HEADER_SIZE = 7;
 
 // 包类型
 static constexpr uint8_t FEC_TYPE_DATA = 0x01;
 static constexpr uint8_t FEC_TYPE_PARITY = 0x02;
+static constexpr uint8_t FEC_TYPE_RS_DATA = 0x03;
+static constexpr uint8_t FEC_TYPE_RS_PARITY = 0x04;
+
+// RS 参数上限（k + m <= 256 为 Cauchy 矩阵的数学上限，这里按实际需要收紧）
+static constexpr int FEC_RS_MAX_DATA = 64;
+static constexpr int FEC_RS_MAX_PARITY = 16;
+
+// XOR 组大小上限（server 端 FecCodec.java 按此上限解码，客户端编码不得超出）
+static constexpr int FEC_XOR_MAX_GROUP = 32;
+
+// ============================================================================
+// GF(2^8) 运算 / GF(2^8) Arithmetic
+// ============================================================================
+
+/**
+ * @brief GF(2^8) 有限域运算（本原多项式 x^8+x^4+x^3+x^2+1 = 0x11D）
+ *
+ * 乘法使用 64KB 全乘法表（标量路径）和按系数拆分的半字节表（PSHUFB 路径）。
+ * 表在首次使用时构建，之后只读，可跨线程共享。
+ */
+namespace gf256 {
+
+struct Tables {
+    uint8_t exp[512];
+    uint8_t log[256];
+    uint8_t inv[256];
+    uint8_t mul[256][256];
+    // PSHUFB 半字节表: c*x = nibLo[c][x & 0x0F] ^ nibHi[c][x >> 4]
+    alignas(16) uint8_t nibLo[256][16];
+    alignas(16) uint8_t nibHi[256][16];
+
+    Tables() {
+        int x = 1;
+        for (int i = 0; i < 255; ++i) {
+            exp[i] = static_cast<uint8_t>(x);
+            log[x] = static_cast<uint8_t>(i);
+            x <<= 1;
+            if (x & 0x100) x ^= 0x11D;
+        }
+        for (int i = 255; i < 512; ++i) {
+            exp[i] = exp[i - 255];
+        }
+        log[0] = 0;
+
+        for (int a = 0; a < 256; ++a) {
+            for (int b = 0; b < 256; ++b) {
+                mul[a][b] = (a == 0 || b == 0) ? 0 : exp[log[a] + log[b]];
+            }
+            inv[a] = (a == 0) ? 0 : exp[255 - log[a]];
+            for (int n = 0; n < 16; ++n) {
+                nibLo[a][n] = mul[a][n];
+                nibHi[a][n] = mul[a][n << 4];
+            }
+        }
+    }
+};
+
+inline const Tables& tables() {
+    static const Tables t;
+    return t;
+}
+
+inline uint8_t mul(uint8_t a, uint8_t b) { return tables().mul[a][b]; }
+inline uint8_t inv(uint8_t a) { return tables().inv[a]; }
+
+/**
+ * @brief dst[i] ^= src[i]
+ */
+inline void xorRow(uint8_t* dst, const uint8_t* src, int len)
+{
+    int i = 0;
+#ifdef __AVX2__
+    for (; i + 32 <= len; i += 32) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(d, s));
+    }
+#endif
+#ifdef __SSE2__
+    for (; i + 16 <= len; i += 16) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(d, s));
+    }
+#endif
+    for (; i < len; ++i) {
+        dst[i] ^= src[i];
+    }
+}
+
+/**
+ * @brief dst[i] ^= c * src[i]  (GF(2^8))
+ *
+ * AVX2/SSSE3: PSHUFB 半字节查表，每次处理 32/16 字节
+ * 标量: 全乘法表逐字节查表
+ */
+inline void mulAddRow(uint8_t* dst, const uint8_t* src, uint8_t c, int len)
+{
+    if (c == 0) return;
+    if (c == 1) {
+        xorRow(dst, src, len);
+        return;
+    }
+
+    const Tables& t = tables();
+    int i = 0;
+#if defined(__AVX2__)
+    {
+        const __m256i lo = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(t.nibLo[c])));
+        const __m256i hi = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(t.nibHi[c])));
+        const __m256i mask = _mm256_set1_epi8(0x0F);
+        for (; i + 32 <= len; i += 32) {
+            __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i l = _mm256_and_si256(s, mask);
+            __m256i h = _mm256_and_si256(_mm256_srli_epi64(s, 4), mask);
+            __m256i p = _mm256_xor_si256(_mm256_shuffle_epi8(lo, l), _mm256_shuffle_epi8(hi, h));
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(d, p));
+        }
+    }
+#endif
+#if defined(__SSSE3__)
+    {
+        const __m128i lo = _mm_load_si128(reinterpret_cast<const __m128i*>(t.nibLo[c]));
+        const __m128i hi = _mm_load_si128(reinterpret_cast<const __m128i*>(t.nibHi[c]));
+        const __m128i mask = _mm_set1_epi8(0x0F);
+        for (; i + 16 <= len; i += 16) {
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i l = _mm_and_si128(s, mask);
+            __m128i h = _mm_and_si128(_mm_srli_epi64(s, 4), mask);
+            __m128i p = _mm_xor_si128(_mm_shuffle_epi8(lo, l), _mm_shuffle_epi8(hi, h));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(d, p));
+        }
+    }
+#endif
+    const uint8_t* row = t.mul[c];
+    for (; i < len; ++i) {
+        dst[i] ^= row[src[i]];
+    }
+}
+
+/**
+ * @brief Cauchy 编码矩阵系数: C[i][j] = 1 / ((k + i) ^ j)
+ *
+ * 行集 {k..k+m-1} 与列集 {0..k-1} 不相交，任意方阵子矩阵均可逆，
+ * 保证任意 m 个丢包都能恢复。
+ */
+inline uint8_t cauchy(int k, int parityIdx, int dataIdx)
+{
+    return inv(static_cast<uint8_t>((k + parityIdx) ^ dataIdx));
+}
+
+/**
+ * @brief 原地求逆 n×n 矩阵 (Gauss-Jordan)
+ * @return 奇异矩阵返回 false
+ */
+inline bool invertMatrix(uint8_t* m, int n)
+{
+    uint8_t work[FEC_RS_MAX_PARITY * FEC_RS_MAX_PARITY * 2];
+    const int w = n * 2;
+    for (int r = 0; r < n; ++r) {
+        for (int c = 0; c < n; ++c) {
+            work[r * w + c] = m[r * n + c];
+            work[r * w + n + c] = (r == c) ? 1 : 0;
+        }
+    }
+
+    for (int col = 0; col < n; ++col) {
+        int pivot = col;
+        while (pivot < n && work[pivot * w + col] == 0) ++pivot;
+        if (pivot == n) return false;
+        if (pivot != col) {
+            for (int c = 0; c < w; ++c) std::swap(work[pivot * w + c], work[col * w + c]);
+        }
+
+        const uint8_t scale = inv(work[col * w + col]);
+        for (int c = 0; c < w; ++c) work[col * w + c] = mul(work[col * w + c], scale);
+
+        for (int r = 0; r < n; ++r) {
+            if (r == col) continue;
+            const uint8_t f = work[r * w + col];
+            if (f == 0) continue;
+            for (int c = 0; c < w; ++c) work[r * w + c] ^= mul(f, work[col * w + c]);
+        }
+    }
+
+    for (int r = 0; r < n; ++r) {
+        for (int c = 0; c < n; ++c) {
+            m[r * n + c] = work[r * w + n + c];
+        }
+    }
+    return true;
+}
+
+} // namespace gf256
 
 /**
  * @brief FEC 编码器 / FEC Encoder
  *
  * 将原始数据包编码为带 FEC 头的数据包 + 周期性的校验包。
- * 用于发送端，每 groupSize 个原始包生成 1 个 XOR 校验包。
+ * 用于发送端：parityCount=1 时每 groupSize 个原始包生成 1 个 XOR 校验包，
+ * parityCount>1 时生成 parityCount 个 RS 校验包。
+ * 校验包增量累加，无需缓存整组数据。
  */
 class FecEncoder {
 public:
     /**
      * @param groupSize 每组数据包数量 (默认 10)
      * @param maxPacketSize 单包最大大小 (默认 1400，匹配 KCP MTU)
+     * @param parityCount 每组校验包数量 (默认 1 = XOR；>1 启用 Reed-Solomon)
      */
-    explicit FecEncoder(int groupSize = 10, int maxPacketSize = 1400)
+    explicit FecEncoder(int groupSize = 10, int maxPacketSize = 1400, int parityCount = 1)
         : m_groupSize(groupSize)
         , m_maxPacketSize(maxPacketSize)
+        , m_parityCount(parityCount)
         , m_parityBuf(maxPacketSize, 0)
     {
+        if (m_parityCount > 1) {
+            m_groupSize = std::min(std::max(m_groupSize, 1), FEC_RS_MAX_DATA);
+            m_parityCount = std::min(m_parityCount, FEC_RS_MAX_PARITY);
+            m_rsParity.assign(m_parityCount, std::vector<uint8_t>(maxPacketSize, 0));
+        } else {
+            m_groupSize = std::min(std::max(m_groupSize, 1), FEC_XOR_MAX_GROUP);
+        }
+        // 预留最大包长，稳态编码不再扩容
+        m_encodeBuf.reserve(maxPacketSize + FEC_RS_HEADER_SIZE);
         reset();
     }
 
+    /**
+     * @brief 是否使用 Reed-Solomon 编码
+     */
+    bool isReedSolomon() const { return m_parityCount > 1; }
+
+    int groupSize() const { return m_groupSize; }
+    int parityCount() const { return m_parityCount; }
+
     /**
      * @brief 编码一个数据包
      *
      * @param data 原始数据
      * @param len 数据长度
      * @param outputCb 输出回调: (data, len) 每个输出包调用一次
-     *                 可能被调用 1 次（数据包）或 2 次（数据包 + FEC 校验包）
+     *                 可能被调用 1 次（数据包）或 1 + parityCount 次（组结束时）
      */
-    void encode(const uint8_t* data, int len,
-                std::function<void(const uint8_t*, int)> outputCb)
+    template <typename OutputCb>
+    void encode(const uint8_t* data, int len, OutputCb&& outputCb)
     {
-        if (!data || len <= 0 || len > m_maxPacketSize - FEC_HEADER_SIZE) {
+        const int headerSize = isReedSolomon() ? FEC_RS_HEADER_SIZE : FEC_HEADER_SIZE;
+        if (!data || len <= 0 || len > m_maxPacketSize - headerSize) {
             // 超过 MTU 的包不做 FEC，直接透传
-            if (outputCb && data && len > 0) {
+            if (data && len > 0) {
                 outputCb(data, len);
             }
             return;
@@ -84,6 +313,17 @@ public:
 
         std::lock_guard<std::mutex> lock(m_mutex);
 
+        if (isReedSolomon()) {
+            encodeRS(data, len, outputCb);
+        } else {
+            encodeXor(data, len, outputCb);
+        }
+    }
+
+private:
+    template <typename OutputCb>
+    void encodeXor(const uint8_t* data, int len, OutputCb& outputCb)
+    {
         // 构建 FEC 数据包: [type=0x01][groupId][index][groupSize][originalLen(2B)][payload]
         m_encodeBuf.resize(FEC_HEADER_SIZE + len);
         m_encodeBuf[0] = FEC_TYPE_DATA;
@@ -95,9 +335,7 @@ public:
         memcpy(m_encodeBuf.data() + FEC_HEADER_SIZE, data, len);
 
         // 输出数据包
-        if (outputCb) {
-            outputCb(m_encodeBuf.data(), static_cast<int>(m_encodeBuf.size()));
-        }
+        outputCb(static_cast<const uint8_t*>(m_encodeBuf.data()), static_cast<int>(m_encodeBuf.size()));
 
         // 更新 XOR 校验: parityBuf ^= paddedData
         int paddedLen = len + 2; // 包含 originalLen 字段
@@ -109,9 +347,7 @@ public:
         m_parityBuf[0] ^= m_encodeBuf[4];
         m_parityBuf[1] ^= m_encodeBuf[5];
         // XOR payload
-        for (int i = 0; i < len; ++i) {
-            m_parityBuf[2 + i] ^= data[i];
-        }
+        gf256::xorRow(m_parityBuf.data() + 2, data, len);
         if (paddedLen > m_maxParityLen) {
             m_maxParityLen = paddedLen;
         }
@@ -130,9 +366,7 @@ public:
             m_encodeBuf[5] = static_cast<uint8_t>(m_maxParityLen & 0xFF);
             memcpy(m_encodeBuf.data() + FEC_HEADER_SIZE, m_parityBuf.data(), m_maxParityLen);
 
-            if (outputCb) {
-                outputCb(m_encodeBuf.data(), static_cast<int>(m_encodeBuf.size()));
-            }
+            outputCb(static_cast<const uint8_t*>(m_encodeBuf.data()), static_cast<int>(m_encodeBuf.size()));
 
             // 重置组
             m_groupId++;
@@ -140,19 +374,76 @@ public:
         }
     }
 
-private:
+    template <typename OutputCb>
+    void encodeRS(const uint8_t* data, int len, OutputCb& outputCb)
+    {
+        // 构建 RS 数据包: [type=0x03][groupId][index][k][m][originalLen(2B)][payload]
+        m_encodeBuf.resize(FEC_RS_HEADER_SIZE + len);
+        m_encodeBuf[0] = FEC_TYPE_RS_DATA;
+        m_encodeBuf[1] = m_groupId;
+        m_encodeBuf[2] = static_cast<uint8_t>(m_index);
+        m_encodeBuf[3] = static_cast<uint8_t>(m_groupSize);
+        m_encodeBuf[4] = static_cast<uint8_t>(m_parityCount);
+        m_encodeBuf[5] = static_cast<uint8_t>((len >> 8) & 0xFF);
+        m_encodeBuf[6] = static_cast<uint8_t>(len & 0xFF);
+        memcpy(m_encodeBuf.data() + FEC_RS_HEADER_SIZE, data, len);
+
+        outputCb(static_cast<const uint8_t*>(m_encodeBuf.data()), static_cast<int>(m_encodeBuf.size()));
+
+        // 分片 = [originalLen(2B)][payload]，短分片视为尾部补零
+        const uint8_t* shard = m_encodeBuf.data() + FEC_RS_HEADER_SIZE - 2;
+        const int shardLen = len + 2;
+        for (int p = 0; p < m_parityCount; ++p) {
+            auto& parity = m_rsParity[p];
+            if (shardLen > static_cast<int>(parity.size())) {
+                parity.resize(shardLen, 0);
+            }
+            gf256::mulAddRow(parity.data(), shard, gf256::cauchy(m_groupSize, p, m_index), shardLen);
+        }
+        if (shardLen > m_maxParityLen) {
+            m_maxParityLen = shardLen;
+        }
+
+        m_index++;
+
+        if (m_index >= m_groupSize) {
+            // 发射 m 个校验包: [type=0x04][groupId][index=k+p][k][m][parityLen(2B)][parity...]
+            m_encodeBuf.resize(FEC_RS_HEADER_SIZE + m_maxParityLen);
+            for (int p = 0; p < m_parityCount; ++p) {
+                m_encodeBuf[0] = FEC_TYPE_RS_PARITY;
+                m_encodeBuf[1] = m_groupId;
+                m_encodeBuf[2] = static_cast<uint8_t>(m_groupSize + p);
+                m_encodeBuf[3] = static_cast<uint8_t>(m_groupSize);
+                m_encodeBuf[4] = static_cast<uint8_t>(m_parityCount);
+                m_encodeBuf[5] = static_cast<uint8_t>((m_maxParityLen >> 8) & 0xFF);
+                m_encodeBuf[6] = static_cast<uint8_t>(m_maxParityLen & 0xFF);
+                memcpy(m_encodeBuf.data() + FEC_RS_HEADER_SIZE, m_rsParity[p].data(), m_maxParityLen);
+
+                outputCb(static_cast<const uint8_t*>(m_encodeBuf.data()), static_cast<int>(m_encodeBuf.size()));
+            }
+
+            m_groupId++;
+            reset();
+        }
+    }
+
     void reset() {
         m_index = 0;
         m_maxParityLen = 0;
         std::fill(m_parityBuf.begin(), m_parityBuf.end(), 0);
+        for (auto& parity : m_rsParity) {
+            std::fill(parity.begin(), parity.end(), 0);
+        }
     }
 
     int m_groupSize;
     int m_maxPacketSize;
+    int m_parityCount;
     uint8_t m_groupId = 0;
     int m_index = 0;
     int m_maxParityLen = 0;
     std::vector<uint8_t> m_parityBuf;
+    std::vector<std::vector<uint8_t>> m_rsParity;   // RS: m 个校验累加缓冲
     std::vector<uint8_t> m_encodeBuf;
     std::mutex m_mutex;
 };
@@ -161,35 +452,68 @@ private:
  * @brief FEC 解码器 / FEC Decoder
  *
  * 接收带 FEC 头的数据包，尝试恢复丢失的包。
- * 用于接收端。
+ * 用于接收端，同时识别 XOR 与 RS 两种包格式。
+ *
+ * 零分配 / Allocation-free:
+ *   构造时按 (maxGroupSize + maxParityCount) × MTU 为每个组槽预分配分片区，
+ *   恢复所需的校正子/输出缓冲也在构造时分配。稳态解码不触发任何堆分配，
+ *   输出回调为模板参数，不经过 std::function。
  */
 class FecDecoder {
 public:
-    explicit FecDecoder(int maxGroupSize = 16, int maxPacketSize = 1400)
-        : m_maxGroupSize(maxGroupSize)
+    /**
+     * @param maxGroupSize 可接受的最大组大小 k
+     * @param maxPacketSize 单包最大大小 (决定分片槽大小)
+     * @param maxParityCount 可接受的最大 RS 校验包数 m
+     */
+    explicit FecDecoder(int maxGroupSize = 16, int maxPacketSize = 1400,
+                        int maxParityCount = FEC_RS_MAX_PARITY)
+        : m_maxGroupSize(std::min(std::max(maxGroupSize, 1), FEC_RS_MAX_DATA))
         , m_maxPacketSize(maxPacketSize)
+        , m_maxParityCount(std::min(std::max(maxParityCount, 1), FEC_RS_MAX_PARITY))
+        // 分片步长按 32 字节对齐，SIMD 整行处理不跨越相邻分片
+        , m_shardStride((maxPacketSize + 31) & ~31)
     {
+        const size_t shardsPerGroup = static_cast<size_t>(m_maxGroupSize + m_maxParityCount);
+        m_arena.assign(shardsPerGroup * MAX_GROUPS * m_shardStride, 0);
+        m_scratch.assign(static_cast<size_t>(m_maxParityCount + 1) * m_shardStride, 0);
+
+        for (int i = 0; i < MAX_GROUPS; ++i) {
+            FecGroup& g = m_groups[i].group;
+            g.shards = m_arena.data() + i * shardsPerGroup * m_shardStride;
+            g.parity = g.shards + static_cast<size_t>(m_maxGroupSize) * m_shardStride;
+        }
     }
 
+    FecDecoder(const FecDecoder&) = delete;
+    FecDecoder& operator=(const FecDecoder&) = delete;
+
     /**
      * @brief 解码一个 FEC 包
      *
      * @param data FEC 编码的数据
      * @param len 数据长度
-     * @param outputCb 输出回调: (data, len) 每个恢复的原始数据包调用一次
+     * @param outputCb 输出回调: (const uint8_t* data, int len) 每个原始/恢复数据包调用一次。
+     *                 指针仅在回调期间有效。
      */
-    void decode(const uint8_t* data, int len,
-                std::function<void(const uint8_t*, int)> outputCb)
+    template <typename OutputCb>
+    void decode(const uint8_t* data, int len, OutputCb&& outputCb)
     {
-        if (!data || len < FEC_HEADER_SIZE || !outputCb) {
+        if (!data || len < FEC_HEADER_SIZE) {
             // 非 FEC 包，直接透传
-            if (outputCb && data && len > 0) {
+            if (data && len > 0) {
                 outputCb(data, len);
             }
             return;
         }
 
         uint8_t type = data[0];
+
+        if (type == FEC_TYPE_RS_DATA || type == FEC_TYPE_RS_PARITY) {
+            decodeRS(data, len, outputCb);
+            return;
+        }
+
         uint8_t groupId = data[1];
         uint8_t index = data[2];
         uint8_t groupSize = data[3];
@@ -202,13 +526,20 @@ public:
         }
 
         if (groupSize == 0 || groupSize > m_maxGroupSize) {
-            return; // 无效组大小
+            // 组大小超出本端能力（对端配置不一致）：数据包照常交付，只是不参与恢复
+            if (type == FEC_TYPE_DATA) {
+                const int originalLen = (data[4] << 8) | data[5];
+                if (originalLen > 0 && originalLen <= len - FEC_HEADER_SIZE) {
+                    outputCb(data + FEC_HEADER_SIZE, originalLen);
+                }
+            }
+            return;
         }
 
         std::lock_guard<std::mutex> lock(m_mutex);
 
         // 查找或创建组
-        FecGroup& group = getOrCreateGroup(groupId, groupSize);
+        FecGroup& group = getOrCreateGroup(groupId, groupSize, 0);
 
         int payloadLen = len - FEC_HEADER_SIZE;
 
@@ -219,28 +550,28 @@ public:
                 return; // 无效长度
             }
 
-            // 记录已收到
-            if (index < groupSize && !group.received[index]) {
-                group.received[index] = true;
+            // 记录已收到（超出分片槽的包只交付，不参与恢复）
+            if (index < groupSize && !group.received[index] && originalLen + 2 <= m_shardStride) {
+                group.received[index] = 1;
                 group.receivedCount++;
 
-                // 保存数据用于可能的恢复
-                group.packets[index].assign(data + FEC_HEADER_SIZE, data + len);
-                group.originalLens[index] = originalLen;
+                // 保存分片 [originalLen(2B)][payload] 用于可能的恢复（与校验覆盖范围一致）
+                memcpy(shard(group, index), data + FEC_HEADER_SIZE - 2, originalLen + 2);
+                group.shardLens[index] = static_cast<uint16_t>(originalLen + 2);
             }
 
             // 输出原始数据
-            outputCb(data + FEC_HEADER_SIZE + 2, originalLen);
+            outputCb(data + FEC_HEADER_SIZE, originalLen);
 
         } else if (type == FEC_TYPE_PARITY) {
             // FEC 校验包
             int parityLen = (data[4] << 8) | data[5];
-            if (parityLen <= 0 || parityLen > payloadLen) {
+            if (parityLen <= 0 || parityLen > payloadLen || parityLen > m_shardStride) {
                 return;
             }
 
             group.hasParity = true;
-            group.parityData.assign(data + FEC_HEADER_SIZE, data + FEC_HEADER_SIZE + parityLen);
+            memcpy(group.parity, data + FEC_HEADER_SIZE, parityLen);
             group.parityLen = parityLen;
 
             // 尝试恢复丢失的包
@@ -258,38 +589,62 @@ public:
      */
     static bool isFecPacket(const uint8_t* data, int len) {
         if (!data || len < FEC_HEADER_SIZE) return false;
-        return data[0] == FEC_TYPE_DATA || data[0] == FEC_TYPE_PARITY;
+        return data[0] == FEC_TYPE_DATA || data[0] == FEC_TYPE_PARITY ||
+               (len >= FEC_RS_HEADER_SIZE &&
+                (data[0] == FEC_TYPE_RS_DATA || data[0] == FEC_TYPE_RS_PARITY));
     }
 
 private:
+    /**
+     * 组状态只保存元数据，分片内容位于 m_arena 中该组的固定区域：
+     *   shards: [maxGroupSize × stride] 数据分片
+     *   parity: [maxParityCount × stride] 校验分片 (XOR 只用第 0 个)
+     */
     struct FecGroup {
         uint8_t groupSize = 0;
+        uint8_t parityCount = 0;    // 0 = XOR 组，>0 = RS 组的 m
         int receivedCount = 0;
         bool hasParity = false;
         bool recovered = false;  // 是否已经尝试过恢复
         int parityLen = 0;
-        std::vector<uint8_t> parityData;
-        std::vector<bool> received;
-        std::vector<std::vector<uint8_t>> packets;
-        std::vector<int> originalLens;
+        int parityReceived = 0;
+        std::array<uint8_t, FEC_RS_MAX_DATA> received{};
+        std::array<uint16_t, FEC_RS_MAX_DATA> shardLens{};
+        std::array<uint8_t, FEC_RS_MAX_PARITY> parityValid{};
+        uint8_t* shards = nullptr;
+        uint8_t* parity = nullptr;
 
-        void init(uint8_t gs) {
+        void init(uint8_t gs, uint8_t pc) {
             groupSize = gs;
+            parityCount = pc;
             receivedCount = 0;
             hasParity = false;
             recovered = false;
             parityLen = 0;
-            parityData.clear();
-            received.assign(gs, false);
-            packets.resize(gs);
-            originalLens.assign(gs, 0);
+            parityReceived = 0;
+            received.fill(0);
+            shardLens.fill(0);
+            parityValid.fill(0);
         }
     };
 
-    FecGroup& getOrCreateGroup(uint8_t groupId, uint8_t groupSize) {
+    uint8_t* shard(FecGroup& group, int index) const {
+        return group.shards + static_cast<size_t>(index) * m_shardStride;
+    }
+
+    uint8_t* parityShard(FecGroup& group, int index) const {
+        return group.parity + static_cast<size_t>(index) * m_shardStride;
+    }
+
+    uint8_t* scratch(int index) {
+        return m_scratch.data() + static_cast<size_t>(index) * m_shardStride;
+    }
+
+    FecGroup& getOrCreateGroup(uint8_t groupId, uint8_t groupSize, uint8_t parityCount) {
         // 使用环形缓冲区管理组（最多缓存 4 个组）
         for (auto& g : m_groups) {
-            if (g.id == groupId && g.active) {
+            if (g.id == groupId && g.active &&
+                g.group.groupSize == groupSize && g.group.parityCount == parityCount) {
                 return g.group;
             }
         }
@@ -297,12 +652,13 @@ private:
         auto& slot = m_groups[m_nextSlot % MAX_GROUPS];
         slot.id = groupId;
         slot.active = true;
-        slot.group.init(groupSize);
+        slot.group.init(groupSize, parityCount);
         m_nextSlot++;
         return slot.group;
     }
 
-    void tryRecover(FecGroup& group, std::function<void(const uint8_t*, int)>& outputCb) {
+    template <typename OutputCb>
+    void tryRecover(FecGroup& group, OutputCb& outputCb) {
         if (group.recovered || !group.hasParity) return;
         if (group.receivedCount < group.groupSize - 1) return;
         if (group.receivedCount >= group.groupSize) return; // 全收到了，无需恢复
@@ -319,24 +675,146 @@ private:
 
         group.recovered = true;
 
-        // XOR 恢复：recovered = parity ^ all_other_packets
-        std::vector<uint8_t> recovered(group.parityData);
+        // XOR 恢复（原地）：parity ^= all_other_packets
+        uint8_t* recovered = group.parity;
+        const int recoveredSize = group.parityLen;
 
         for (int i = 0; i < group.groupSize; ++i) {
             if (i == missingIdx) continue;
             if (!group.received[i]) continue;
 
-            const auto& pkt = group.packets[i];
-            for (size_t j = 0; j < pkt.size() && j < recovered.size(); ++j) {
-                recovered[j] ^= pkt[j];
-            }
+            gf256::xorRow(recovered, shard(group, i), std::min<int>(group.shardLens[i], recoveredSize));
         }
 
         // 提取恢复的原始数据
-        if (recovered.size() >= 2) {
+        if (recoveredSize >= 2) {
             int recoveredLen = (recovered[0] << 8) | recovered[1];
-            if (recoveredLen > 0 && recoveredLen <= static_cast<int>(recovered.size()) - 2) {
-                outputCb(recovered.data() + 2, recoveredLen);
+            if (recoveredLen > 0 && recoveredLen <= recoveredSize - 2) {
+                outputCb(static_cast<const uint8_t*>(recovered + 2), recoveredLen);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reed-Solomon 解码
+    // ------------------------------------------------------------------------
+
+    template <typename OutputCb>
+    void decodeRS(const uint8_t* data, int len, OutputCb& outputCb)
+    {
+        if (len < FEC_RS_HEADER_SIZE) return;
+
+        const uint8_t type = data[0];
+        const uint8_t groupId = data[1];
+        const uint8_t index = data[2];
+        const uint8_t k = data[3];
+        const uint8_t m = data[4];
+        const int fieldLen = (data[5] << 8) | data[6];
+        const int payloadLen = len - FEC_RS_HEADER_SIZE;
+
+        if (fieldLen <= 0 || fieldLen > payloadLen) {
+            return; // 无效长度
+        }
+        // 组参数超出本端能力（对端 k:m 更大）或分片超出槽大小：数据包照常交付，只是不存入组参与恢复，
+        // 否则每次 KCP 重传都会被同样丢弃，流会停住
+        if (k == 0 || k > m_maxGroupSize || m == 0 || m > m_maxParityCount || fieldLen + 2 > m_shardStride) {
+            if (type == FEC_TYPE_RS_DATA) {
+                outputCb(data + FEC_RS_HEADER_SIZE, fieldLen);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        FecGroup& group = getOrCreateGroup(groupId, k, m);
+
+        if (type == FEC_TYPE_RS_DATA) {
+            if (index < k && !group.received[index]) {
+                group.received[index] = 1;
+                group.receivedCount++;
+                // 保存分片 [originalLen(2B)][payload]
+                memcpy(shard(group, index), data + FEC_RS_HEADER_SIZE - 2, fieldLen + 2);
+                group.shardLens[index] = static_cast<uint16_t>(fieldLen + 2);
+            }
+            outputCb(data + FEC_RS_HEADER_SIZE, fieldLen);
+        } else {
+            const int p = index - k;
+            if (p < 0 || p >= m || group.parityValid[p]) return;
+            group.parityValid[p] = 1;
+            group.parityReceived++;
+            // 同组校验分片等长，短于已知长度的部分补零
+            uint8_t* dst = parityShard(group, p);
+            memcpy(dst, data + FEC_RS_HEADER_SIZE, fieldLen);
+            memset(dst + fieldLen, 0, m_shardStride - fieldLen);
+            group.parityLen = std::max(group.parityLen, fieldLen);
+        }
+
+        if (!group.recovered && group.receivedCount < k &&
+            group.receivedCount + group.parityReceived >= k) {
+            recoverRS(group, outputCb);
+        }
+    }
+
+    /**
+     * 丢失数据索引集合 M (|M| = e)，取 e 个已收校验行 P：
+     *   Σ_{j∈M} C[p][j]·d_j = parity_p ⊕ Σ_{j∉M} C[p][j]·d_j   (p ∈ P)
+     * 对 e×e Cauchy 子矩阵求逆后即可解出丢失分片。
+     * 校正子原地累加在校验分片上，输出经由 scratch 缓冲，全程无堆分配。
+     */
+    template <typename OutputCb>
+    void recoverRS(FecGroup& group, OutputCb& outputCb)
+    {
+        const int k = group.groupSize;
+        const int shardLen = group.parityLen;
+
+        int missing[FEC_RS_MAX_PARITY];
+        int rows[FEC_RS_MAX_PARITY];
+        int e = 0;
+        for (int j = 0; j < k; ++j) {
+            if (!group.received[j]) {
+                if (e >= FEC_RS_MAX_PARITY) return;
+                missing[e++] = j;
+            }
+        }
+        int r = 0;
+        for (int p = 0; p < group.parityCount && r < e; ++p) {
+            if (group.parityValid[p]) rows[r++] = p;
+        }
+        if (r < e) return;
+
+        group.recovered = true;
+
+        uint8_t matrix[FEC_RS_MAX_PARITY * FEC_RS_MAX_PARITY];
+        for (int a = 0; a < e; ++a) {
+            for (int b = 0; b < e; ++b) {
+                matrix[a * e + b] = gf256::cauchy(k, rows[a], missing[b]);
+            }
+        }
+        if (!gf256::invertMatrix(matrix, e)) return;
+
+        // 校正子: S_a = parity_{rows[a]} ⊕ Σ_{已收 j} C[rows[a]][j]·d_j
+        for (int a = 0; a < e; ++a) {
+            uint8_t* s = scratch(a);
+            memcpy(s, parityShard(group, rows[a]), shardLen);
+            for (int j = 0; j < k; ++j) {
+                if (!group.received[j]) continue;
+                gf256::mulAddRow(s, shard(group, j), gf256::cauchy(k, rows[a], j),
+                                 std::min<int>(group.shardLens[j], shardLen));
+            }
+        }
+
+        // d_{missing[b]} = Σ_a inv[b][a]·S_a
+        uint8_t* recovered = scratch(e);
+        for (int b = 0; b < e; ++b) {
+            memset(recovered, 0, shardLen);
+            for (int a = 0; a < e; ++a) {
+                gf256::mulAddRow(recovered, scratch(a), matrix[b * e + a], shardLen);
+            }
+            if (shardLen >= 2) {
+                int recoveredLen = (recovered[0] << 8) | recovered[1];
+                if (recoveredLen > 0 && recoveredLen <= shardLen - 2) {
+                    outputCb(static_cast<const uint8_t*>(recovered + 2), recoveredLen);
+                }
             }
         }
     }
@@ -352,9 +830,461 @@ private:
 
     int m_maxGroupSize;
     int m_maxPacketSize;
+    int m_maxParityCount;
+    int m_shardStride;
+    std::vector<uint8_t> m_arena;     // 所有组槽的分片区 (构造时一次性分配)
+    std::vector<uint8_t> m_scratch;   // RS 恢复: e 个校正子 + 1 个输出缓冲
     std::mutex m_mutex;
 };
 
+// ============================================================================
+// 序号分组 FEC（UDP 视频通道）/ Sequence-grouped FEC for the UDP video lane
+// ============================================================================
+
+/**
+ * 视频数据包保持原格式 [uint32 seq][flags][payload] 发送，零额外开销；
+ * 校验包旁路发送，并通过 flags 的 0x80 位区分：
+ *   [uint32 baseSeq][flags=0x80][k][m][parityIdx][shardLen(2B)][parity...]
+ *
+ * 分片 = [len(2B)][flags][payload]，len = 1 + payloadLen。
+ * 受保护的数据包在 flags 中置 0x04，接收端据此决定丢包后是否等待校验包。
+ * 组不跨帧：发送端在帧尾包后立即发射校验，因此接收端最多等待一帧。
+ * Cauchy 系数行固定从 SEQ_FEC_ROW_BASE 开始（与 k 无关），帧尾提前结束的短组无需重算。
+ */
+static constexpr uint8_t SEQ_FEC_FLAG_PROTECTED = 0x04;
+static constexpr uint8_t SEQ_FEC_FLAG_PARITY = 0x80;
+static constexpr int SEQ_FEC_HEADER_SIZE = 5;     // 紧跟 5B 视频头之后
+static constexpr int SEQ_FEC_ROW_BASE = 128;
+static constexpr int SEQ_FEC_MAX_DATA = 64;
+static constexpr int SEQ_FEC_MAX_PARITY = 8;
+
+/**
+ * @brief 序号分组 FEC 解码器 / Sequence-grouped FEC decoder
+ *
+ * 位于 UDP 收包与帧重组之间：按 seq 顺序向下游交付数据包。
+ * 出现空洞时，若后续包标记为受保护，则暂存后续包直到校验包恢复空洞
+ * 或确认无法恢复（组已关闭 / 更晚的组校验已到 / 超过 HOLD_LIMIT）。
+ *
+ * 仅 IO 线程调用，无锁；分片区构造时一次性分配，稳态零分配。
+ */
+class SeqFecDecoder {
+public:
+    static constexpr int RING_SIZE = 256;
+    static constexpr int HOLD_LIMIT = 128;
+    static constexpr int MAX_GROUPS = 8;
+
+    explicit SeqFecDecoder(int maxShardSize = 1400)
+        : m_stride((maxShardSize + 31) & ~31)
+    {
+        m_ring.assign(static_cast<size_t>(RING_SIZE) * m_stride, 0);
+        m_parity.assign(static_cast<size_t>(MAX_GROUPS) * SEQ_FEC_MAX_PARITY * m_stride, 0);
+        m_scratch.assign(static_cast<size_t>(SEQ_FEC_MAX_PARITY) * m_stride, 0);
+        reset();
+    }
+
+    SeqFecDecoder(const SeqFecDecoder&) = delete;
+    SeqFecDecoder& operator=(const SeqFecDecoder&) = delete;
+
+    void reset() {
+        m_started = false;
+        m_nextSeq = 0;
+        m_highestSeq = 0;
+        m_lastProtected = false;
+        m_haveParity = false;
+        m_latestParityBase = 0;
+        m_nextGroup = 0;
+        m_slotSeq.fill(0);
+        m_slotValid.fill(0);
+        for (auto& g : m_groups) g.active = false;
+    }
+
+    /**
+     * @brief 输入一个数据包
+     * @param deliver (uint32_t seq, uint8_t flags, const uint8_t* payload, int len)，按 seq 顺序调用
+     */
+    template <typename DeliverCb>
+    void onData(uint32_t seq, uint8_t flags, const uint8_t* payload, int len, DeliverCb&& deliver)
+    {
+        if (len < 0 || len + 3 > m_stride) return;
+
+        if (!m_started) {
+            m_started = true;
+            m_nextSeq = seq;
+            m_highestSeq = seq;
+        }
+
+        if (seqDiff(seq, m_nextSeq) < 0) {
+            return; // 已交付或已跳过的迟到/重复包
+        }
+
+        // 超出环形窗口：强制推进（有数据则交付，空洞直接跳过）
+        while (seqDiff(seq, m_nextSeq) >= RING_SIZE) {
+            deliverOrSkip(deliver);
+        }
+
+        const int idx = static_cast<int>(seq & (RING_SIZE - 1));
+        uint8_t* s = slot(idx);
+        const int shardLen = len + 1;
+        s[0] = static_cast<uint8_t>((shardLen >> 8) & 0xFF);
+        s[1] = static_cast<uint8_t>(shardLen & 0xFF);
+        s[2] = flags;
+        memcpy(s + 3, payload, len);
+        m_slotSeq[idx] = seq;
+        m_slotValid[idx] = 1;
+
+        if (seqDiff(seq, m_highestSeq) >= 0) {
+            m_highestSeq = seq;
+            m_lastProtected = (flags & SEQ_FEC_FLAG_PROTECTED) != 0;
+        }
+
+        drain(deliver);
+    }
+
+    /**
+     * @brief 输入一个校验包
+     * @param body 5B 视频头之后的内容: [k][m][parityIdx][shardLen(2B)][parity...]
+     */
+    template <typename DeliverCb>
+    void onParity(uint32_t baseSeq, const uint8_t* body, int len, DeliverCb&& deliver)
+    {
+        if (!m_started || len < SEQ_FEC_HEADER_SIZE) return;
+
+        const int k = body[0];
+        const int m = body[1];
+        const int p = body[2];
+        const int shardLen = (body[3] << 8) | body[4];
+        if (k <= 0 || k > SEQ_FEC_MAX_DATA || m <= 0 || m > SEQ_FEC_MAX_PARITY || p >= m) return;
+        if (shardLen < 3 || shardLen > m_stride || shardLen > len - SEQ_FEC_HEADER_SIZE) return;
+
+        if (!m_haveParity || seqDiff(baseSeq, m_latestParityBase) > 0) {
+            m_latestParityBase = baseSeq;
+            m_haveParity = true;
+        }
+
+        // 整组均已交付/跳过，校验包已无用
+        if (seqDiff(baseSeq + static_cast<uint32_t>(k), m_nextSeq) <= 0) {
+            drain(deliver);
+            return;
+        }
+
+        Group& g = findOrCreateGroup(baseSeq, k, m);
+        if (!g.closed && !(g.parityMask & (1u << p))) {
+            uint8_t* dst = parityShard(g, p);
+            memcpy(dst, body + SEQ_FEC_HEADER_SIZE, shardLen);
+            g.parityMask |= (1u << p);
+            g.shardLen = std::max(g.shardLen, shardLen);
+
+            tryRecover(g);
+            // 最后一个校验包已到仍无法恢复 → 组关闭，允许跳过空洞
+            if (p == m - 1) {
+                g.closed = true;
+            }
+        }
+
+        drain(deliver);
+    }
+
+    uint64_t recoveredCount() const { return m_recovered.load(std::memory_order_relaxed); }
+    uint64_t unrecoveredCount() const { return m_unrecovered.load(std::memory_order_relaxed); }
+
+private:
+    struct Group {
+        bool active = false;
+        bool closed = false;
+        uint32_t baseSeq = 0;
+        int k = 0;
+        int m = 0;
+        uint32_t parityMask = 0;
+        int shardLen = 0;
+        int index = 0;      // m_parity 中的组槽序号
+    };
+
+    static int32_t seqDiff(uint32_t a, uint32_t b) {
+        return static_cast<int32_t>(a - b);
+    }
+
+    uint8_t* slot(int idx) {
+        return m_ring.data() + static_cast<size_t>(idx) * m_stride;
+    }
+
+    bool hasSeq(uint32_t seq) const {
+        const int idx = static_cast<int>(seq & (RING_SIZE - 1));
+        return m_slotValid[idx] && m_slotSeq[idx] == seq;
+    }
+
+    int slotShardLen(uint32_t seq) {
+        const uint8_t* s = slot(static_cast<int>(seq & (RING_SIZE - 1)));
+        return (s[0] << 8) | s[1];
+    }
+
+    uint8_t* parityShard(Group& g, int p) {
+        return m_parity.data() + (static_cast<size_t>(g.index) * SEQ_FEC_MAX_PARITY + p) * m_stride;
+    }
+
+    Group& findOrCreateGroup(uint32_t baseSeq, int k, int m) {
+        for (auto& g : m_groups) {
+            if (g.active && g.baseSeq == baseSeq && g.k == k && g.m == m) {
+                return g;
+            }
+        }
+        const int index = m_nextGroup++ % MAX_GROUPS;
+        Group& g = m_groups[index];
+        g.active = true;
+        g.closed = false;
+        g.baseSeq = baseSeq;
+        g.k = k;
+        g.m = m;
+        g.parityMask = 0;
+        g.shardLen = 0;
+        g.index = index;
+        return g;
+    }
+
+    /**
+     * 空洞是否可以跳过（不再等待恢复）
+     */
+    bool canSkip(uint32_t seq) const {
+        if (!m_lastProtected) return true;                       // 发送端当前未启用校验
+        if (seqDiff(m_highestSeq, seq) >= HOLD_LIMIT) return true;
+        for (const auto& g : m_groups) {
+            if (g.active && seqDiff(seq, g.baseSeq) >= 0 && seqDiff(seq, g.baseSeq) < g.k) {
+                return g.closed;
+            }
+        }
+        // 没有覆盖该 seq 的组：若更晚的组校验已到，说明本组校验全部丢失
+        return m_haveParity && seqDiff(m_latestParityBase, seq) > 0;
+    }
+
+    template <typename DeliverCb>
+    void deliverOrSkip(DeliverCb& deliver) {
+        if (hasSeq(m_nextSeq)) {
+            const uint8_t* s = slot(static_cast<int>(m_nextSeq & (RING_SIZE - 1)));
+            const int shardLen = (s[0] << 8) | s[1];
+            deliver(m_nextSeq, s[2], static_cast<const uint8_t*>(s + 3), shardLen - 1);
+        } else {
+            m_unrecovered.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_nextSeq++;
+    }
+
+    template <typename DeliverCb>
+    void drain(DeliverCb& deliver) {
+        while (seqDiff(m_highestSeq, m_nextSeq) >= 0) {
+            if (!hasSeq(m_nextSeq) && !canSkip(m_nextSeq)) {
+                break;
+            }
+            deliverOrSkip(deliver);
+        }
+    }
+
+    /**
+     * 与 FecDecoder::recoverRS 相同的 Cauchy 求解，系数行为 SEQ_FEC_ROW_BASE + p，
+     * 恢复结果直接写回环形缓冲区对应槽位。
+     */
+    void tryRecover(Group& g) {
+        int missing[SEQ_FEC_MAX_PARITY];
+        int rows[SEQ_FEC_MAX_PARITY];
+        int e = 0;
+        for (int j = 0; j < g.k; ++j) {
+            if (!hasSeq(g.baseSeq + j)) {
+                if (e >= SEQ_FEC_MAX_PARITY) return;
+                missing[e++] = j;
+            }
+        }
+        if (e == 0) {
+            g.closed = true;
+            return;
+        }
+        int r = 0;
+        for (int p = 0; p < g.m && r < e; ++p) {
+            if (g.parityMask & (1u << p)) rows[r++] = p;
+        }
+        if (r < e) return;
+
+        uint8_t matrix[SEQ_FEC_MAX_PARITY * SEQ_FEC_MAX_PARITY];
+        for (int a = 0; a < e; ++a) {
+            for (int b = 0; b < e; ++b) {
+                matrix[a * e + b] = gf256::cauchy(SEQ_FEC_ROW_BASE, rows[a], missing[b]);
+            }
+        }
+        g.closed = true;
+        if (!gf256::invertMatrix(matrix, e)) return;
+
+        const int shardLen = g.shardLen;
+        for (int a = 0; a < e; ++a) {
+            uint8_t* s = m_scratch.data() + static_cast<size_t>(a) * m_stride;
+            memcpy(s, parityShard(g, rows[a]), shardLen);
+            for (int j = 0; j < g.k; ++j) {
+                const uint32_t seq = g.baseSeq + j;
+                if (!hasSeq(seq)) continue;
+                gf256::mulAddRow(s, slot(static_cast<int>(seq & (RING_SIZE - 1))),
+                                 gf256::cauchy(SEQ_FEC_ROW_BASE, rows[a], j),
+                                 std::min(slotShardLen(seq) + 2, shardLen));
+            }
+        }
+
+        for (int b = 0; b < e; ++b) {
+            const uint32_t seq = g.baseSeq + missing[b];
+            if (seqDiff(seq, m_nextSeq) < 0) continue;   // 已被跳过，恢复无意义
+
+            const int idx = static_cast<int>(seq & (RING_SIZE - 1));
+            uint8_t* dst = slot(idx);
+            memset(dst, 0, shardLen);
+            for (int a = 0; a < e; ++a) {
+                gf256::mulAddRow(dst, m_scratch.data() + static_cast<size_t>(a) * m_stride,
+                                 matrix[b * e + a], shardLen);
+            }
+            const int recoveredLen = (dst[0] << 8) | dst[1];
+            if (recoveredLen < 1 || recoveredLen > shardLen - 2) {
+                m_slotValid[idx] = 0;
+                continue;
+            }
+            m_slotSeq[idx] = seq;
+            m_slotValid[idx] = 1;
+            m_recovered.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    int m_stride;
+    std::vector<uint8_t> m_ring;        // RING_SIZE 个数据分片 [len][flags][payload]
+    std::vector<uint8_t> m_parity;      // MAX_GROUPS × SEQ_FEC_MAX_PARITY 个校验分片
+    std::vector<uint8_t> m_scratch;     // 校正子
+    std::array<uint32_t, RING_SIZE> m_slotSeq{};
+    std::array<uint8_t, RING_SIZE> m_slotValid{};
+    std::array<Group, MAX_GROUPS> m_groups{};
+    int m_nextGroup = 0;
+
+    bool m_started = false;
+    uint32_t m_nextSeq = 0;             // 下一个待交付 seq
+    uint32_t m_highestSeq = 0;          // 已收到的最大 seq
+    bool m_lastProtected = false;       // 最新数据包是否受校验保护
+    bool m_haveParity = false;
+    uint32_t m_latestParityBase = 0;
+
+    std::atomic<uint64_t> m_recovered{0};
+    std::atomic<uint64_t> m_unrecovered{0};
+};
+
+/**
+ * @brief 序号分组 FEC 编码器 / Sequence-grouped FEC encoder
+ *
+ * 与服务端 FecCodec.SeqFecEncoder 逐字节一致，供本地工具（设备替身、传输基准）
+ * 生成与真实设备相同的视频流。用法：
+ *   protect = beginPacket() → 数据包 flags 置 SEQ_FEC_FLAG_PROTECTED 并发送
+ *   → addPacket(seq, [flags][payload], endOfFrame, output)，组满或帧尾时输出校验包
+ *
+ * setParams 可在任意线程调用，新参数在下一个组边界生效；其余接口仅发送线程调用。
+ */
+class SeqFecEncoder {
+public:
+    explicit SeqFecEncoder(int maxShardSize = 1396, int k = 16, int m = 1)
+        : m_parity(static_cast<size_t>(SEQ_FEC_MAX_PARITY) * (maxShardSize + 2), 0)
+        , m_packet(4 + 1 + SEQ_FEC_HEADER_SIZE + maxShardSize + 2, 0)
+        , m_stride(maxShardSize + 2)
+    {
+        setParams(k, m);
+    }
+
+    SeqFecEncoder(const SeqFecEncoder&) = delete;
+    SeqFecEncoder& operator=(const SeqFecEncoder&) = delete;
+
+    void setParams(int k, int m) {
+        const int kk = std::max(1, std::min(k, SEQ_FEC_MAX_DATA));
+        const int mm = std::max(0, std::min(m, SEQ_FEC_MAX_PARITY));
+        m_pendingParams.store((kk << 8) | mm, std::memory_order_relaxed);
+    }
+
+    int groupSize() const { return m_pendingParams.load(std::memory_order_relaxed) >> 8; }
+    int parityCount() const { return m_pendingParams.load(std::memory_order_relaxed) & 0xFF; }
+
+    /**
+     * @brief 开始一个新数据包：组边界处应用新参数
+     * @return 该包是否受校验保护
+     */
+    bool beginPacket() {
+        if (m_index == 0) {
+            const int p = m_pendingParams.load(std::memory_order_relaxed);
+            m_k = p >> 8;
+            m_m = p & 0xFF;
+        }
+        return m_m > 0;
+    }
+
+    /**
+     * @brief 累加一个已发送的数据包
+     * @param data [flags][payload]
+     * @param len 1 + payload 长度
+     * @param output (const uint8_t* packet, int len)，每个校验包调用一次
+     */
+    template <typename OutputCb>
+    void addPacket(uint32_t seq, const uint8_t* data, int len, bool endOfFrame, OutputCb&& output)
+    {
+        if (m_m == 0 || len <= 0 || len + 2 > m_stride) return;
+        if (m_index == 0) {
+            m_baseSeq = seq;
+        }
+
+        const uint8_t lenBuf[2] = {
+            static_cast<uint8_t>((len >> 8) & 0xFF),
+            static_cast<uint8_t>(len & 0xFF),
+        };
+        for (int p = 0; p < m_m; ++p) {
+            const uint8_t c = gf256::cauchy(SEQ_FEC_ROW_BASE, p, m_index);
+            uint8_t* parity = parityShard(p);
+            gf256::mulAddRow(parity, lenBuf, c, 2);
+            gf256::mulAddRow(parity + 2, data, c, len);
+        }
+        m_maxShardLen = std::max(m_maxShardLen, len + 2);
+
+        m_index++;
+        if (m_index >= m_k || endOfFrame) {
+            flush(output);
+        }
+    }
+
+private:
+    template <typename OutputCb>
+    void flush(OutputCb& output)
+    {
+        // 短组的校验包数不超过组内数据包数
+        const int count = std::min(m_m, m_index);
+        uint8_t* pkt = m_packet.data();
+        for (int p = 0; p < count; ++p) {
+            pkt[0] = static_cast<uint8_t>(m_baseSeq >> 24);
+            pkt[1] = static_cast<uint8_t>(m_baseSeq >> 16);
+            pkt[2] = static_cast<uint8_t>(m_baseSeq >> 8);
+            pkt[3] = static_cast<uint8_t>(m_baseSeq);
+            pkt[4] = SEQ_FEC_FLAG_PARITY;
+            pkt[5] = static_cast<uint8_t>(m_index);
+            pkt[6] = static_cast<uint8_t>(count);
+            pkt[7] = static_cast<uint8_t>(p);
+            pkt[8] = static_cast<uint8_t>((m_maxShardLen >> 8) & 0xFF);
+            pkt[9] = static_cast<uint8_t>(m_maxShardLen & 0xFF);
+            memcpy(pkt + 10, parityShard(p), m_maxShardLen);
+            output(static_cast<const uint8_t*>(pkt), 10 + m_maxShardLen);
+        }
+        for (int p = 0; p < m_m; ++p) {
+            memset(parityShard(p), 0, m_maxShardLen);
+        }
+        m_index = 0;
+        m_maxShardLen = 0;
+    }
+
+    uint8_t* parityShard(int p) {
+        return m_parity.data() + static_cast<size_t>(p) * m_stride;
+    }
+
+    std::vector<uint8_t> m_parity;      // SEQ_FEC_MAX_PARITY 个校验累加缓冲
+    std::vector<uint8_t> m_packet;
+    int m_stride;
+    std::atomic<int> m_pendingParams{0};    // (k << 8) | m
+    int m_k = 0;
+    int m_m = 0;
+    int m_index = 0;
+    uint32_t m_baseSeq = 0;
+    int m_maxShardLen = 0;
+};
+
 } // namespace fec
 
 #endif // FEC_CODEC_H
@@ -29,6 +29,9 @@ KcpVideoClient::KcpVideoClient(QObject *parent)
     // 环形缓冲区预分配
     m_ringBuffer.reserve(DEFAULT_BUFFER_SIZE);
 
+    m_targetBitrate = m_bwe.targetBitrate();
+    m_clock.start();
+
     // DirectConnection: onDataReady 在 IO 线程执行，直接从 transport 读数据到环形缓冲区
     // 环形缓冲区通过 mutex 保护，decode 线程通过 recvBlocking 安全读取
     connect(m_transport, &KcpTransport::dataReady, this, &KcpVideoClient::onDataReady, Qt::DirectConnection);
@@ -66,6 +69,10 @@ void KcpVideoClient::configureBitrate(int bitrateBps)
     m_ringBuffer.reserve(m_maxBufferSize);
 
     m_transport->setWindowSize(windowSize, windowSize);
+
+    // 配置码率即带宽估计上限（须在 bind() 启动 IO 线程之前调用）
+    m_bwe.setMaxBitrate(static_cast<uint32_t>(bitrateBps));
+    m_targetBitrate = m_bwe.targetBitrate();
 }
 
 bool KcpVideoClient::bind(quint16 port)
@@ -149,9 +156,10 @@ void KcpVideoClient::close()
 
 QString KcpVideoClient::stats() const
 {
-    return QString("recv=%1,buf=%2,pend=%3")
+    return QString("recv=%1,buf=%2,pend=%3,bwe=%4kbps")
         .arg(m_totalRecv.load()).arg(m_ringBuffer.available())
-        .arg(m_transport ? m_transport->pending() : 0);
+        .arg(m_transport ? m_transport->pending() : 0)
+        .arg(m_targetBitrate.load() / 1000);
 }
 
 void KcpVideoClient::ensureIoThread()
@@ -175,6 +183,14 @@ void KcpVideoClient::onDataReady()
 
     m_totalRecv += totalRecv;
 
+    const qint64 now = m_clock.elapsed();
+    m_bwe.onPacket(now, totalRecv);
+    trackFrames(recvBuffer, totalRecv, now);
+    if (now - m_lastBweUpdate >= BWE_UPDATE_INTERVAL_MS) {
+        m_lastBweUpdate = now;
+        m_targetBitrate.store(m_bwe.update(now), std::memory_order_relaxed);
+    }
+
     QMutexLocker locker(&m_mutex);
 
     // 环形缓冲区 O(1) 写入
@@ -188,6 +204,54 @@ void KcpVideoClient::onDataReady()
     m_dataAvailable.wakeAll();
 }
 
+void KcpVideoClient::trackFrames(const char *data, int len, qint64 nowMs)
+{
+    while (len > 0 && m_frameTracking) {
+        if (m_streamHeaderLeft > 0) {
+            const int n = qMin(len, m_streamHeaderLeft);
+            m_streamHeaderLeft -= n;
+            data += n;
+            len -= n;
+            continue;
+        }
+        if (m_frameLeft > 0) {
+            const int n = static_cast<int>(qMin<qint64>(len, m_frameLeft));
+            m_frameLeft -= n;
+            data += n;
+            len -= n;
+            continue;
+        }
+
+        const int n = qMin(len, FRAME_META_SIZE - m_metaLen);
+        memcpy(m_meta + m_metaLen, data, static_cast<size_t>(n));
+        m_metaLen += n;
+        data += n;
+        len -= n;
+        if (m_metaLen < FRAME_META_SIZE) break;
+        m_metaLen = 0;
+
+        uint64_t ptsAndFlags = 0;
+        for (int i = 0; i < 8; ++i) {
+            ptsAndFlags = (ptsAndFlags << 8) | static_cast<uint8_t>(m_meta[i]);
+        }
+        const quint32 size = (static_cast<quint32>(static_cast<uint8_t>(m_meta[8])) << 24)
+                             | (static_cast<quint32>(static_cast<uint8_t>(m_meta[9])) << 16)
+                             | (static_cast<quint32>(static_cast<uint8_t>(m_meta[10])) << 8)
+                             | static_cast<quint32>(static_cast<uint8_t>(m_meta[11]));
+        if (size == 0 || size > 64u * 1024 * 1024) {
+            qWarning("[KcpVideoClient] Unexpected frame size %u, bandwidth estimation falls back to rate only",
+                     size);
+            m_frameTracking = false;
+            break;
+        }
+        m_frameLeft = size;
+        // 帧头随帧首字节到达，时间与帧大小无关；配置帧没有有效 PTS
+        if (!(ptsAndFlags & 0x8000000000000000ULL)) {
+            m_bwe.onFrame(nowMs, static_cast<int64_t>(ptsAndFlags & 0x3FFFFFFFFFFFFFFFULL));
+        }
+    }
+}
+
 //=============================================================================
 // KcpControlClient
 //=============================================================================
@@ -237,6 +301,13 @@ bool KcpControlClient::isActive() const
     return m_transport && m_transport->isActive() && !m_closed;
 }
 
+void KcpControlClient::setFec(int dataShards, int parityShards)
+{
+    if (m_transport) {
+        m_transport->setFecEnabled(dataShards > 0 && parityShards > 0, dataShards, parityShards);
+    }
+}
+
 int KcpControlClient::send(const QByteArray &data)
 {
     return m_transport->send(data);
@@ -247,6 +318,11 @@ int KcpControlClient::send(const char *data, int len)
     return m_transport->send(data, len);
 }
 
+int KcpControlClient::sendDatagram(const char *data, int len)
+{
+    return m_transport->sendDatagram(data, len);
+}
+
 int KcpControlClient::recvBlocking(char *buf, int bufSize, int timeoutMs)
 {
     if (!buf || bufSize <= 0 || m_closed) return 0;
@@ -287,13 +363,15 @@ void KcpControlClient::onDataReady()
 {
     if (!m_transport || m_closed) return;
 
-    while (m_transport->peekSize() > 0) {
-        QByteArray data = m_transport->recv();
-        if (data.isEmpty()) break;
-
+    // 一次取出整批消息，只加一次 m_mutex
+    std::vector<std::string> messages;
+    while (m_transport->core()->recvBatch(messages) > 0) {
         QMutexLocker locker(&m_mutex);
-        m_buffer.append(data);
+        for (const std::string &msg : messages) {
+            m_buffer.append(msg.data(), static_cast<int>(msg.size()));
+        }
         m_dataAvailable.wakeAll();
+        messages.clear();
     }
 
     emit dataReady();
@@ -15,9 +15,11 @@
 #include <QByteArray>
 #include <QHostAddress>
 #include <QThread>
+#include <QElapsedTimer>
 #include <atomic>
 #include <vector>
 
+#include "BandwidthEstimator.h"
 #include "KcpTransport.h"  // C-K05: 直接使用 KcpTransport 中定义的常量
 
 /**
@@ -136,6 +138,13 @@ public:
      */
     void configureBitrate(int bitrateBps);
 
+    /**
+     * @brief 接收端估计的目标码率（bps，任意线程）
+     *
+     * KCP 可靠传输下丢包体现为重传延迟，估计只依据到达速率和帧间延迟梯度。
+     */
+    quint32 targetBitrate() const { return m_targetBitrate.load(std::memory_order_relaxed); }
+
     /**
      * @brief 绑定本地端口
      */
@@ -196,6 +205,11 @@ private slots:
 private:
     int calculateWindowSize(int bitrateBps) const;
 
+    /**
+     * @brief 从字节流中解析帧头，把帧首字节到达时间和 PTS 送入带宽估计（IO 线程）
+     */
+    void trackFrames(const char *data, int len, qint64 nowMs);
+
     /**
      * @brief 确保 IO 线程已启动，transport 已移到 IO 线程
      *
@@ -220,6 +234,20 @@ private:
     int m_maxBufferSize = DEFAULT_BUFFER_SIZE;
     std::atomic<bool> m_closed{false};
     std::atomic<uint64_t> m_totalRecv{0};
+
+    // 带宽估计（估计器和帧头解析状态仅 IO 线程访问）
+    static constexpr int STREAM_HEADER_SIZE = 12;   // codec_id + width + height
+    static constexpr int FRAME_META_SIZE = 12;      // ptsAndFlags(8) + size(4)
+    static constexpr int BWE_UPDATE_INTERVAL_MS = 50;
+    BandwidthEstimator m_bwe;
+    QElapsedTimer m_clock;
+    qint64 m_lastBweUpdate = 0;
+    int m_streamHeaderLeft = STREAM_HEADER_SIZE;
+    char m_meta[FRAME_META_SIZE];
+    int m_metaLen = 0;
+    qint64 m_frameLeft = 0;
+    bool m_frameTracking = true;                    // 帧头异常（失步）后停止延迟梯度估计
+    std::atomic<quint32> m_targetBitrate{0};
 };
 
 /**
@@ -260,12 +288,22 @@ public:
      */
     bool isActive() const;
 
+    /**
+     * @brief 启用 FEC (k:m)，须与 server 端 kcp_fec 参数一致
+     */
+    void setFec(int dataShards, int parityShards);
+
     /**
      * @brief 发送数据
      */
     int send(const QByteArray &data);
     int send(const char *data, int len);
 
+    /**
+     * @brief 发送裸 UDP 数据报（不可靠通道，见 KcpTransport::sendDatagram）
+     */
+    int sendDatagram(const char *data, int len);
+
     /**
      * @brief 阻塞式接收（用于控制线程）
      */
@@ -16,6 +16,10 @@ KcpCore::KcpCore(uint32_t conv, void *user)
     : m_conv(conv)
     , m_user(user)
 {
+    // 分段池经 ikcp_allocator 接入，必须先于 ikcp_create 安装
+    KcpSegmentPool::install();
+    KcpSegmentPool::Scope scope(&m_pool);
+
     // 创建KCP对象 (参考 test.cpp: ikcp_create(0x11223344, (void*)0))
     m_kcp = ikcp_create(conv, this);
     if (m_kcp) {
@@ -28,6 +32,7 @@ KcpCore::~KcpCore()
 {
     // 释放KCP对象 (参考 test.cpp: ikcp_release)
     if (m_kcp) {
+        KcpSegmentPool::Scope scope(&m_pool);
         ikcp_release(m_kcp);
         m_kcp = nullptr;
     }
@@ -49,7 +54,14 @@ int KcpCore::send(const char *data, int len)
         return -1;
     }
 
+    if (isSingleOwner()) {
+        Command cmd;
+        cmd.data.assign(data, static_cast<size_t>(len));
+        return m_commands.tryPush(std::move(cmd)) ? 0 : -1;
+    }
+
     std::unique_lock<std::shared_mutex> lock(m_mutex);
+    KcpSegmentPool::Scope scope(&m_pool);
     return ikcp_send(m_kcp, data, len);
 }
 
@@ -59,7 +71,25 @@ int KcpCore::recv(char *buffer, int len)
         return -1;
     }
 
+    // 消息队列（单一所有者模式收好的，或关闭该模式后的剩余消息）
+    if (!m_carry.empty() || !m_messages.isEmpty()) {
+        if (m_carry.empty() && !m_messages.tryPop(m_carry)) {
+            return -1;
+        }
+        const int size = static_cast<int>(m_carry.size());
+        if (size > len) {
+            return -3;  // 与 ikcp_recv 一致：缓冲区不足
+        }
+        memcpy(buffer, m_carry.data(), static_cast<size_t>(size));
+        m_carry.clear();
+        return size;
+    }
+    if (isSingleOwner()) {
+        return -1;
+    }
+
     std::unique_lock<std::shared_mutex> lock(m_mutex);
+    KcpSegmentPool::Scope scope(&m_pool);
     return ikcp_recv(m_kcp, buffer, len);
 }
 
@@ -69,7 +99,8 @@ int KcpCore::input(const char *data, int size)
         return -1;
     }
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto lock = exclusiveLock();
+    KcpSegmentPool::Scope scope(&m_pool);
     return ikcp_input(m_kcp, data, size);
 }
 
@@ -79,8 +110,12 @@ void KcpCore::update(uint32_t current)
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto lock = exclusiveLock();
+    KcpSegmentPool::Scope scope(&m_pool);
+    runCommands();
     ikcp_update(m_kcp, current);
+    collectMessages();
+    publishSnapshot();
 }
 
 void KcpCore::flush()
@@ -89,8 +124,12 @@ void KcpCore::flush()
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto lock = exclusiveLock();
+    KcpSegmentPool::Scope scope(&m_pool);
+    runCommands();
     ikcp_flush(m_kcp);
+    collectMessages();
+    publishSnapshot();
 }
 
 int KcpCore::peekSize() const
@@ -99,15 +138,41 @@ int KcpCore::peekSize() const
         return -1;
     }
 
+    if (!m_carry.empty() || !m_messages.isEmpty()) {
+        if (m_carry.empty() && !m_messages.tryPop(m_carry)) {
+            return -1;
+        }
+        return static_cast<int>(m_carry.size());
+    }
+    if (isSingleOwner()) {
+        return -1;
+    }
+
     std::shared_lock<std::shared_mutex> lock(m_mutex);  // C-K02: 只读方法使用共享锁
     return ikcp_peeksize(m_kcp);
 }
 
+bool KcpCore::hasMessages() const
+{
+    if (!m_kcp) {
+        return false;
+    }
+    if (isSingleOwner()) {
+        return !m_messages.isEmpty();
+    }
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return !m_messages.isEmpty() || ikcp_peeksize(m_kcp) > 0;
+}
+
 int KcpCore::waitSnd() const
 {
     if (!m_kcp) {
         return 0;
     }
+    if (isSingleOwner()) {
+        return m_snapWaitSnd.load(std::memory_order_relaxed);
+    }
 
     std::shared_lock<std::shared_mutex> lock(m_mutex);  // 只读方法使用共享锁
     return ikcp_waitsnd(m_kcp);
@@ -119,7 +184,7 @@ uint32_t KcpCore::check(uint32_t current) const
         return current;
     }
 
-    std::shared_lock<std::shared_mutex> lock(m_mutex);  // 只读方法使用共享锁
+    auto lock = sharedLock();  // 只读方法使用共享锁
     return ikcp_check(m_kcp, current);
 }
 
@@ -131,97 +196,110 @@ void KcpCore::setFastMode()
 {
     if (!m_kcp) return;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-
-    // ============================================
-    // 极致低延迟配置
-    // ============================================
+    configure([](ikcpcb *kcp) {
+        // ============================================
+        // 极致低延迟配置
+        // ============================================
 
-    // nodelay=2: 最激进模式，立即发送不等待
-    // interval=1: 内部更新间隔1ms（最小值）
-    // resend=2: 2次ACK跨越立即重传
-    // nc=1: 关闭拥塞控制，不减速
-    ikcp_nodelay(m_kcp, 2, 1, 2, 1);
+        // nodelay=2: 最激进模式，立即发送不等待
+        // interval=1: 内部更新间隔1ms（最小值）
+        // resend=2: 2次ACK跨越立即重传
+        // nc=1: 关闭拥塞控制，不减速
+        ikcp_nodelay(kcp, 2, 1, 2, 1);
 
-    // 最小RTO=1ms（默认30ms，我们追求极致）
-    m_kcp->rx_minrto = 1;
+        // 最小RTO=1ms（默认30ms，我们追求极致）
+        kcp->rx_minrto = 1;
 
-    // 快速重传触发阈值
-    m_kcp->fastresend = 1;
+        // 快速重传触发阈值
+        kcp->fastresend = 1;
 
-    // 死链检测（可选，避免无限等待）
-    m_kcp->dead_link = 50;
+        // 死链检测（可选，避免无限等待）
+        kcp->dead_link = 50;
 
-    // 窗口大小：发送256，接收256（足够8Mbps@60fps）
-    ikcp_wndsize(m_kcp, 256, 256);
+        // 窗口大小：发送256，接收256（足够8Mbps@60fps）
+        ikcp_wndsize(kcp, 256, 256);
+    });
 }
 
 void KcpCore::setVideoStreamMode()
 {
     if (!m_kcp) return;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-
-    // ============================================
-    // 视频流专用配置 - 针对高码率视频流优化
-    // ============================================
+    configure([](ikcpcb *kcp) {
+        // ============================================
+        // 视频流专用配置 - 针对高码率视频流优化
+        // ============================================
 
-    // 最激进的nodelay配置
-    ikcp_nodelay(m_kcp, 2, 1, 2, 1);
+        // 最激进的nodelay配置
+        ikcp_nodelay(kcp, 2, 1, 2, 1);
 
-    // 最小RTO
-    m_kcp->rx_minrto = 1;
-    m_kcp->fastresend = 1;
+        // 最小RTO
+        kcp->rx_minrto = 1;
+        kcp->fastresend = 1;
 
-    // 流模式：视频不需要消息边界
-    m_kcp->stream = 1;
+        // 流模式：视频不需要消息边界
+        kcp->stream = 1;
 
-    // 大窗口：支持高码率
-    ikcp_wndsize(m_kcp, 512, 512);
+        // 大窗口：支持高码率
+        ikcp_wndsize(kcp, 512, 512);
 
-    // 死链检测宽松一点（视频偶尔卡顿正常）
-    m_kcp->dead_link = 100;
+        // 死链检测宽松一点（视频偶尔卡顿正常）
+        kcp->dead_link = 100;
+    });
 }
 
 void KcpCore::setNormalMode()
 {
     if (!m_kcp) return;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    ikcp_nodelay(m_kcp, 0, 10, 0, 1);
-    ikcp_wndsize(m_kcp, 128, 128);
+    configure([](ikcpcb *kcp) {
+        ikcp_nodelay(kcp, 0, 10, 0, 1);
+        ikcp_wndsize(kcp, 128, 128);
+    });
 }
 
 void KcpCore::setDefaultMode()
 {
     if (!m_kcp) return;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    ikcp_nodelay(m_kcp, 0, 10, 0, 0);
-    ikcp_wndsize(m_kcp, 32, 128);
+    configure([](ikcpcb *kcp) {
+        ikcp_nodelay(kcp, 0, 10, 0, 0);
+        ikcp_wndsize(kcp, 32, 128);
+    });
 }
 
 void KcpCore::setNoDelay(int nodelay, int interval, int resend, int nc)
 {
     if (!m_kcp) return;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    ikcp_nodelay(m_kcp, nodelay, interval, resend, nc);
+    configure([=](ikcpcb *kcp) {
+        ikcp_nodelay(kcp, nodelay, interval, resend, nc);
+    });
 }
 
 void KcpCore::setWindowSize(int sndwnd, int rcvwnd)
 {
     if (!m_kcp) return;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    ikcp_wndsize(m_kcp, sndwnd, rcvwnd);
+    configure([=](ikcpcb *kcp) {
+        ikcp_wndsize(kcp, sndwnd, rcvwnd);
+    });
 }
 
 int KcpCore::setMtu(int mtu)
 {
     if (!m_kcp) return -1;
 
+    if (isSingleOwner()) {
+        // 所有者线程稍后执行，拿不到 ikcp_setmtu 的返回值，按成功处理
+        configure([mtu](ikcpcb *kcp) {
+            ikcp_setmtu(kcp, mtu);
+        });
+        return 0;
+    }
+
     std::unique_lock<std::shared_mutex> lock(m_mutex);
+    KcpSegmentPool::Scope scope(&m_pool);
     return ikcp_setmtu(m_kcp, mtu);
 }
 
@@ -229,21 +307,26 @@ void KcpCore::setMinRto(int minrto)
 {
     if (!m_kcp) return;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_kcp->rx_minrto = minrto;
+    configure([minrto](ikcpcb *kcp) {
+        kcp->rx_minrto = minrto;
+    });
 }
 
 void KcpCore::setStream(int stream)
 {
     if (!m_kcp) return;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_kcp->stream = stream;
+    configure([stream](ikcpcb *kcp) {
+        kcp->stream = stream;
+    });
 }
 
 int KcpCore::state() const
 {
     if (!m_kcp) return -1;
+    if (isSingleOwner()) {
+        return m_snapState.load(std::memory_order_relaxed);
+    }
 
     std::shared_lock<std::shared_mutex> lock(m_mutex);  // 只读方法使用共享锁
     return static_cast<int>(m_kcp->state);
@@ -268,6 +351,9 @@ int KcpCore::kcpOutputCallback(const char *buf, int len, ikcpcb *kcp, void *user
 int KcpCore::getRtt() const
 {
     if (!m_kcp) return 0;
+    if (isSingleOwner()) {
+        return m_snapRtt.load(std::memory_order_relaxed);
+    }
     std::shared_lock<std::shared_mutex> lock(m_mutex);
     return m_kcp->rx_srtt;
 }
@@ -276,13 +362,20 @@ int KcpCore::processInputBatch(const char* const* data, const int* sizes, int co
 {
     if (!m_kcp || !data || !sizes || count <= 0) return -1;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto lock = exclusiveLock();
+    KcpSegmentPool::Scope scope(&m_pool);
+    runCommands();
     for (int i = 0; i < count; ++i) {
         if (data[i] && sizes[i] > 0) {
             ikcp_input(m_kcp, data[i], sizes[i]);
         }
     }
     ikcp_update(m_kcp, current);
+    if (isSingleOwner()) {
+        collectMessages();
+        publishSnapshot();
+        return m_messages.isEmpty() ? -1 : 1;
+    }
     return ikcp_peeksize(m_kcp);
 }
 
@@ -290,8 +383,24 @@ int KcpCore::recvAll(char *buffer, int maxLen)
 {
     if (!m_kcp || !buffer || maxLen <= 0) return 0;
 
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
     int totalRecv = 0;
+    if (!m_carry.empty() || !m_messages.isEmpty()) {
+        std::string msg;
+        while (nextMessage(msg)) {
+            if (totalRecv + static_cast<int>(msg.size()) > maxLen) {
+                m_carry.swap(msg);  // 缓冲区不足，留到下次
+                return totalRecv;
+            }
+            memcpy(buffer + totalRecv, msg.data(), msg.size());
+            totalRecv += static_cast<int>(msg.size());
+        }
+    }
+    if (isSingleOwner()) {
+        return totalRecv;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    KcpSegmentPool::Scope scope(&m_pool);
     int peekSz;
     while ((peekSz = ikcp_peeksize(m_kcp)) > 0) {
         if (totalRecv + peekSz > maxLen) break;  // 缓冲区不足，停止
@@ -301,3 +410,120 @@ int KcpCore::recvAll(char *buffer, int maxLen)
     }
     return totalRecv;
 }
+
+int KcpCore::recvBatch(std::vector<std::string> &out, int maxCount)
+{
+    if (!m_kcp || maxCount <= 0) return 0;
+
+    int count = 0;
+    std::string msg;
+    while (count < maxCount && nextMessage(msg)) {
+        out.push_back(std::move(msg));
+        msg.clear();
+        ++count;
+    }
+    if (isSingleOwner() || count >= maxCount) {
+        return count;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    KcpSegmentPool::Scope scope(&m_pool);
+    int peekSz;
+    while (count < maxCount && (peekSz = ikcp_peeksize(m_kcp)) > 0) {
+        std::string data(static_cast<size_t>(peekSz), '\0');
+        if (ikcp_recv(m_kcp, &data[0], peekSz) < 0) break;
+        out.push_back(std::move(data));
+        ++count;
+    }
+    return count;
+}
+
+//=============================================================================
+// 单一所有者模式
+//=============================================================================
+
+void KcpCore::setSingleOwner(bool enabled)
+{
+    if (!m_kcp || isSingleOwner() == enabled) return;
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_singleOwner.store(enabled, std::memory_order_release);
+    if (!enabled) {
+        // 所有者已停止：把还没来得及执行的发送/配置补上
+        KcpSegmentPool::Scope scope(&m_pool);
+        runCommands();
+    } else {
+        publishSnapshot();
+    }
+}
+
+std::unique_lock<std::shared_mutex> KcpCore::exclusiveLock() const
+{
+    if (isSingleOwner()) {
+        return std::unique_lock<std::shared_mutex>(m_mutex, std::defer_lock);
+    }
+    return std::unique_lock<std::shared_mutex>(m_mutex);
+}
+
+std::shared_lock<std::shared_mutex> KcpCore::sharedLock() const
+{
+    if (isSingleOwner()) {
+        return std::shared_lock<std::shared_mutex>(m_mutex, std::defer_lock);
+    }
+    return std::shared_lock<std::shared_mutex>(m_mutex);
+}
+
+void KcpCore::configure(std::function<void(ikcpcb *)> fn)
+{
+    if (isSingleOwner()) {
+        Command cmd;
+        cmd.configure = std::move(fn);
+        // 配置调用极少；队列满只可能是所有者已长时间停止服务，此时丢弃无影响
+        m_commands.tryPush(std::move(cmd));
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    fn(m_kcp);
+}
+
+void KcpCore::runCommands()
+{
+    Command cmd;
+    while (m_commands.tryPop(cmd)) {
+        if (cmd.configure) {
+            cmd.configure(m_kcp);
+            cmd.configure = nullptr;
+        } else {
+            ikcp_send(m_kcp, cmd.data.data(), static_cast<int>(cmd.data.size()));
+        }
+    }
+}
+
+void KcpCore::collectMessages()
+{
+    // 只有所有者入队，isFull 为假时入队必然成功
+    int peekSz;
+    while (!m_messages.isFull() && (peekSz = ikcp_peeksize(m_kcp)) > 0) {
+        std::string msg(static_cast<size_t>(peekSz), '\0');
+        if (ikcp_recv(m_kcp, &msg[0], peekSz) < 0) break;
+        m_messages.tryPush(std::move(msg));
+    }
+}
+
+void KcpCore::publishSnapshot()
+{
+    m_snapWaitSnd.store(ikcp_waitsnd(m_kcp), std::memory_order_relaxed);
+    m_snapState.store(static_cast<int>(m_kcp->state), std::memory_order_relaxed);
+    m_snapRtt.store(m_kcp->rx_srtt, std::memory_order_relaxed);
+}
+
+bool KcpCore::nextMessage(std::string &msg) const
+{
+    if (!m_carry.empty()) {
+        msg.swap(m_carry);
+        m_carry.clear();
+        return true;
+    }
+    return m_messages.tryPop(msg);
+}
@@ -44,9 +44,16 @@
 #ifndef KCP_CORE_H
 #define KCP_CORE_H
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "KcpSegmentPool.h"
+#include "SPSCQueue.h"
 
 extern "C" {
 #include "ikcp.h"
@@ -58,7 +65,7 @@ extern "C" {
  * 设计原则:
  * - 最小化封装，不添加额外复杂性
  * - 严格遵循kcp原始API设计
- * - 线程安全
+ * - 线程安全（默认每次调用加锁；单一所有者模式下由所有者线程独占 ikcpcb，见 setSingleOwner）
  */
 class KcpCore
 {
@@ -90,7 +97,9 @@ public:
 
     /**
      * @brief 发送数据 (参考 test.cpp: ikcp_send)
-     * @return 0成功，<0失败
+     *
+     * 单一所有者模式下只投递到命令队列（任意线程），由所有者线程在下次 update/flush 时发出。
+     * @return 0成功，<0失败（单一所有者模式下 -1 表示命令队列已满）
      */
     int send(const char *data, int len);
 
@@ -148,6 +157,19 @@ public:
      */
     int recvAll(char *buffer, int maxLen);
 
+    /**
+     * @brief 批量接收完整消息（保持消息边界，单次加锁 / 单一所有者模式下无锁）
+     * @param out 追加输出
+     * @param maxCount 最多取出的消息数
+     * @return 取出的消息数
+     */
+    int recvBatch(std::vector<std::string> &out, int maxCount = 64);
+
+    /**
+     * @brief 是否有完整消息可读（可在任意线程调用）
+     */
+    bool hasMessages() const;
+
     /**
      * @brief 获取待发送数据包数量 (参考 README: ikcp_waitsnd)
      */
@@ -158,6 +180,28 @@ public:
      */
     uint32_t check(uint32_t current) const;
 
+    //=========================================================================
+    // 单一所有者模式 / Single-owner mode
+    //
+    // 启用后只有所有者线程（KcpIoEngine IO 线程）调用 ikcp_*，全部不加锁：
+    // - send() / 配置方法：任意线程投递到命令队列，所有者在 update/flush/processInputBatch 开头执行
+    // - recv() / recvAll() / recvBatch() / peekSize()：读取所有者收好的消息队列（单一消费者）
+    // - waitSnd() / state() / getRtt()：返回所有者最近一次发布的快照
+    // - input() / update() / flush() / check() / processInputBatch()：仅所有者线程调用
+    //
+    // 消息队列满时所有者停止 ikcp_recv，数据留在 KCP 接收窗口内，由 KCP 流控反压对端。
+    //=========================================================================
+
+    /**
+     * @brief 启用/关闭单一所有者模式
+     *
+     * 必须在所有者开始服务前启用、在所有者停止服务后关闭（切换时不能有并发的 ikcp 调用）。
+     * 关闭时执行命令队列中剩余的命令。
+     */
+    void setSingleOwner(bool enabled);
+
+    bool isSingleOwner() const { return m_singleOwner.load(std::memory_order_acquire); }
+
     //=========================================================================
     // 配置 - 对应 README.md 中的协议配置
     //=========================================================================
@@ -246,16 +290,55 @@ public:
      */
     int getRtt() const;
 
+    /**
+     * @brief 分段内存池统计（命中率 / 各级峰值）
+     */
+    KcpSegmentPool::Stats poolStats() const { return m_pool.stats(); }
+
 private:
+    // 单一所有者模式的命令：data 为待发送消息；configure 非空时为配置命令
+    struct Command {
+        std::string data;
+        std::function<void(ikcpcb *)> configure;
+    };
+
+    static constexpr size_t COMMAND_QUEUE_SIZE = 1024;
+    static constexpr size_t MESSAGE_QUEUE_SIZE = 1024;
+
     // KCP输出回调（静态，传递给ikcp）
     static int kcpOutputCallback(const char *buf, int len, ikcpcb *kcp, void *user);
 
+    // 单一所有者模式下不加锁（返回未持有的锁对象）
+    std::unique_lock<std::shared_mutex> exclusiveLock() const;
+    std::shared_lock<std::shared_mutex> sharedLock() const;
+
+    // 配置：单一所有者模式下投递到命令队列，否则加锁直接执行
+    void configure(std::function<void(ikcpcb *)> fn);
+
+    // 以下在锁内或所有者线程调用
+    void runCommands();                 // 执行命令队列
+    void collectMessages();             // ikcp_recv 完整消息到消息队列
+    void publishSnapshot();             // 发布 waitSnd/state/rtt 快照
+
+    // 消费者：取下一条消息（先取暂存），无消息返回 false
+    bool nextMessage(std::string &msg) const;
+
 private:
+    KcpSegmentPool m_pool;              // 本实例 IKCPSEG 分配池（ikcp_* 调用期间经 Scope 生效）
     ikcpcb *m_kcp = nullptr;
     uint32_t m_conv;
     void *m_user = nullptr;
     OutputCallback m_output;
     mutable std::shared_mutex m_mutex;  // C-K01: 使用读写锁优化，只读方法用 shared_lock
+
+    // 单一所有者模式
+    std::atomic<bool> m_singleOwner{false};
+    qsc::SPSCQueue<Command, COMMAND_QUEUE_SIZE> m_commands;          // 任意线程 → 所有者
+    mutable qsc::SPSCQueue<std::string, MESSAGE_QUEUE_SIZE> m_messages;  // 所有者 → 消费者
+    mutable std::string m_carry;        // peekSize 已取出但未被 recv 消费的消息（仅消费者）
+    std::atomic<int> m_snapWaitSnd{0};
+    std::atomic<int> m_snapState{0};
+    std::atomic<int> m_snapRtt{0};
 };
 
 #endif // KCP_CORE_H
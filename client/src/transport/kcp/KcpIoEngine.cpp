@@ -0,0 +1,402 @@
+/**
+ * @file KcpIoEngine.cpp
+ * @brief KCP IO 引擎线程实现 (Linux epoll + timerfd + 分层时间轮)
+ */
+
+#include "KcpIoEngine.h"
+#include <QtGlobal>
+#include <QtDebug>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/prctl.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+// epoll data.u64 的保留值（会话 id 从 1 开始）
+static constexpr uint64_t WAKE_ID = 0;
+static constexpr uint64_t TIMER_ID = ~0ull;
+
+// 引擎线程定时器松弛（默认 50µs → 显式设置，防止继承到更大的值）
+static constexpr unsigned long ENGINE_TIMER_SLACK_NS = 50000;
+
+KcpIoEngine::KcpIoEngine()
+    : m_wheel(0)
+{
+}
+
+bool KcpIoEngine::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+KcpIoEngine *KcpIoEngine::instance()
+{
+    if (!isSupported()) return nullptr;
+
+    // 进程级单例，不析构（引擎线程在进程退出前一直休眠在 epoll 上）
+    static KcpIoEngine *engine = []() -> KcpIoEngine * {
+        auto *e = new KcpIoEngine();
+        if (!e->start()) {
+            delete e;
+            return nullptr;
+        }
+        return e;
+    }();
+    return engine;
+}
+
+QString KcpIoEngine::stats() const
+{
+    const quint64 fires = m_timerFires.load();
+    return QString("wakeups=%1,timers=%2,lateAvgUs=%3,lateMaxUs=%4,sessions=%5")
+        .arg(m_wakeups.load())
+        .arg(fires)
+        .arg(fires > 0 ? m_lateUsTotal.load() / fires : 0)
+        .arg(m_lateUsMax.load())
+        .arg(m_sessionCount.load());
+}
+
+#ifdef Q_OS_LINUX
+
+KcpIoEngine::~KcpIoEngine()
+{
+    if (m_epollFd >= 0) ::close(m_epollFd);
+    if (m_wakeFd >= 0) ::close(m_wakeFd);
+    if (m_timerFd >= 0) ::close(m_timerFd);
+}
+
+uint64_t KcpIoEngine::nowNs() const
+{
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+bool KcpIoEngine::start()
+{
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    m_timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (m_epollFd < 0 || m_wakeFd < 0 || m_timerFd < 0) {
+        qWarning("[KcpIoEngine] epoll/eventfd/timerfd failed: %s", strerror(errno));
+        return false;
+    }
+
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = WAKE_ID;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &ev);
+    ev.data.u64 = TIMER_ID;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_timerFd, &ev);
+
+    m_baseNs = nowNs();
+    m_thread = std::thread([this]() { run(); });
+    m_threadId = m_thread.get_id();
+    m_thread.detach();
+    qInfo("[KcpIoEngine] started");
+    return true;
+}
+
+bool KcpIoEngine::attach(Client *client, int fd, int firstDelayMs)
+{
+    if (!client || fd < 0) return false;
+
+    Command cmd;
+    cmd.attach = true;
+    cmd.client = client;
+    cmd.fd = fd;
+    cmd.delayMs = firstDelayMs;
+    bool ok = false;
+    cmd.result = &ok;
+    submit(cmd);
+    return ok;
+}
+
+void KcpIoEngine::detach(Client *client)
+{
+    if (!client) return;
+
+    Command cmd;
+    cmd.client = client;
+    submit(cmd);
+}
+
+void KcpIoEngine::wake(Client *client)
+{
+    if (!client) return;
+
+    if (!m_wakeQueue.tryPush(client)) {
+        m_wakeOverflow.store(true, std::memory_order_release);
+    }
+    uint64_t one = 1;
+    ssize_t ret = ::write(m_wakeFd, &one, sizeof(one));
+    Q_UNUSED(ret);
+}
+
+void KcpIoEngine::submit(const Command &cmd)
+{
+    // 引擎线程内（回调中）直接执行
+    if (std::this_thread::get_id() == m_threadId) {
+        const bool ok = apply(cmd);
+        if (cmd.result) *cmd.result = ok;
+        armTimer();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_commands.push_back(cmd);
+    const uint64_t ticket = ++m_submitted;
+    uint64_t one = 1;
+    ssize_t ret = ::write(m_wakeFd, &one, sizeof(one));
+    Q_UNUSED(ret);
+    m_cond.wait(lock, [this, ticket]() { return m_completed >= ticket; });
+}
+
+bool KcpIoEngine::apply(const Command &cmd)
+{
+    if (cmd.attach) {
+        auto session = std::make_unique<Session>();
+        session->client = cmd.client;
+        session->fd = cmd.fd;
+        session->id = m_nextId++;
+
+        epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u64 = session->id;
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, cmd.fd, &ev) < 0) {
+            // fd 不在 epoll 中的会话永远收不到包，不注册，由调用方退回自有接收线程
+            qWarning("[KcpIoEngine] epoll_ctl(ADD %d) failed: %s", cmd.fd, strerror(errno));
+            return false;
+        }
+        reschedule(session.get(), cmd.delayMs);
+        m_sessions.emplace(session->id, std::move(session));
+        m_sessionCount.store(static_cast<int>(m_sessions.size()), std::memory_order_relaxed);
+        return true;
+    }
+
+    for (auto it = m_sessions.begin(); it != m_sessions.end(); ++it) {
+        if (it->second->client != cmd.client) continue;
+        Session *session = it->second.get();
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, session->fd, nullptr);
+        m_wheel.cancel(&session->node);
+        session->client = nullptr;
+        // 可能正处于该会话的回调中，延后释放
+        m_retired.push_back(std::move(it->second));
+        m_sessions.erase(it);
+        m_sessionCount.store(static_cast<int>(m_sessions.size()), std::memory_order_relaxed);
+        break;
+    }
+    return true;
+}
+
+void KcpIoEngine::wakeSession(Client *client)
+{
+    // 会话数很少（每设备 1-2 个），线性查找即可；已注销的会话忽略
+    for (auto &entry : m_sessions) {
+        Session *session = entry.second.get();
+        if (session->client != client) continue;
+        const int delay = client->onEngineWake();
+        reschedule(session, delay);
+        return;
+    }
+}
+
+void KcpIoEngine::reschedule(Session *session, int delayMs)
+{
+    if (!session->client || delayMs < 0) {
+        m_wheel.cancel(&session->node);
+        return;
+    }
+    const uint64_t now = nowMs();
+    if (m_wheel.size() == 0) {
+        m_wheel.advance(now, [](qsc::TimerWheel::Node *) {});  // 空闲后同步轮时间
+    }
+    // KCP 时钟为毫秒粒度，至少推迟 1ms，避免同一毫秒内反复 update
+    m_wheel.schedule(&session->node, now + static_cast<uint64_t>(qMax(delayMs, 1)));
+}
+
+void KcpIoEngine::armTimer()
+{
+    const uint64_t next = m_wheel.nextExpiry();
+    if (next == m_armedMs) return;
+    m_armedMs = next;
+
+    itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    if (next != qsc::TimerWheel::NO_EXPIRY) {
+        // 绝对截止时间，不受本线程处理耗时影响
+        const uint64_t deadlineNs = m_baseNs + next * 1000000ull;
+        spec.it_value.tv_sec = static_cast<time_t>(deadlineNs / 1000000000ull);
+        spec.it_value.tv_nsec = static_cast<long>(deadlineNs % 1000000000ull);
+    }
+    ::timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+void KcpIoEngine::run()
+{
+    pthread_setname_np(pthread_self(), "kcp-io");
+    ::prctl(PR_SET_TIMERSLACK, ENGINE_TIMER_SLACK_NS, 0, 0, 0);
+
+    static constexpr int MAX_EVENTS = 32;
+    epoll_event events[MAX_EVENTS];
+
+    for (;;) {
+        int n = ::epoll_wait(m_epollFd, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            qWarning("[KcpIoEngine] epoll_wait failed: %s", strerror(errno));
+            break;
+        }
+        m_wakeups.fetch_add(1, std::memory_order_relaxed);
+
+        for (int i = 0; i < n; ++i) {
+            const uint64_t id = events[i].data.u64;
+            if (id == WAKE_ID) {
+                uint64_t value;
+                ssize_t ret = ::read(m_wakeFd, &value, sizeof(value));
+                Q_UNUSED(ret);
+
+                std::vector<Command> commands;
+                uint64_t submitted;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    commands.swap(m_commands);
+                    submitted = m_submitted;
+                }
+                for (const Command &cmd : commands) {
+                    const bool ok = apply(cmd);
+                    if (cmd.result) *cmd.result = ok;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_completed = submitted;
+                }
+                m_cond.notify_all();
+
+                Client *client = nullptr;
+                while (m_wakeQueue.tryPop(client)) {
+                    wakeSession(client);
+                }
+                if (m_wakeOverflow.exchange(false, std::memory_order_acq_rel)) {
+                    std::vector<Client *> clients;
+                    for (auto &entry : m_sessions) {
+                        clients.push_back(entry.second->client);
+                    }
+                    for (Client *c : clients) {
+                        wakeSession(c);
+                    }
+                }
+            } else if (id == TIMER_ID) {
+                uint64_t expirations;
+                ssize_t ret = ::read(m_timerFd, &expirations, sizeof(expirations));
+                Q_UNUSED(ret);
+                m_armedMs = qsc::TimerWheel::NO_EXPIRY;
+            } else {
+                auto it = m_sessions.find(id);
+                if (it == m_sessions.end()) continue;   // 本轮已注销
+                Session *session = it->second.get();
+                const int delay = session->client->onEngineReadable();
+                reschedule(session, delay);
+            }
+        }
+
+        // 推进时间轮，处理所有到期会话
+        const uint64_t now = nowNs();
+        m_wheel.advance((now - m_baseNs) / 1000000, [this, now](qsc::TimerWheel::Node *node) {
+            Session *session = reinterpret_cast<Session *>(node);
+            const uint64_t deadlineNs = m_baseNs + node->expire * 1000000ull;
+            const uint64_t lateUs = now > deadlineNs ? (now - deadlineNs) / 1000 : 0;
+            m_timerFires.fetch_add(1, std::memory_order_relaxed);
+            m_lateUsTotal.fetch_add(lateUs, std::memory_order_relaxed);
+            if (lateUs > m_lateUsMax.load(std::memory_order_relaxed)) {
+                m_lateUsMax.store(lateUs, std::memory_order_relaxed);
+            }
+
+            if (!session->client) return;
+            const int delay = session->client->onEngineTimer();
+            reschedule(session, delay);
+        });
+
+        m_retired.clear();
+        armTimer();
+    }
+}
+
+#else // !Q_OS_LINUX
+
+KcpIoEngine::~KcpIoEngine()
+{
+}
+
+uint64_t KcpIoEngine::nowNs() const
+{
+    return 0;
+}
+
+bool KcpIoEngine::start()
+{
+    return false;
+}
+
+bool KcpIoEngine::attach(Client *client, int fd, int firstDelayMs)
+{
+    Q_UNUSED(client);
+    Q_UNUSED(fd);
+    Q_UNUSED(firstDelayMs);
+    return false;
+}
+
+void KcpIoEngine::detach(Client *client)
+{
+    Q_UNUSED(client);
+}
+
+void KcpIoEngine::wake(Client *client)
+{
+    Q_UNUSED(client);
+}
+
+void KcpIoEngine::submit(const Command &cmd)
+{
+    Q_UNUSED(cmd);
+}
+
+void KcpIoEngine::wakeSession(Client *client)
+{
+    Q_UNUSED(client);
+}
+
+bool KcpIoEngine::apply(const Command &cmd)
+{
+    Q_UNUSED(cmd);
+    return false;
+}
+
+void KcpIoEngine::reschedule(Session *session, int delayMs)
+{
+    Q_UNUSED(session);
+    Q_UNUSED(delayMs);
+}
+
+void KcpIoEngine::armTimer()
+{
+}
+
+void KcpIoEngine::run()
+{
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,151 @@
+/**
+ * @file KcpIoEngine.h
+ * @brief KCP IO 引擎线程 / KCP IO engine thread
+ *
+ * 原实现每个 KcpTransport 用一个 QTimer 驱动 ikcp_update，间隔被限制在 1–100ms，
+ * 精度受 Qt 事件循环和系统定时器松弛影响，重传 / ACK flush 可能晚到数毫秒。
+ *
+ * 本引擎为进程内所有 KCP 会话提供单一 IO 线程：
+ * - 所有会话套接字注册到同一个 epoll，可读时直接在引擎线程读取并输入 KCP
+ * - 每个会话按 ikcp_check 返回的截止时间挂入分层时间轮（qsc::TimerWheel）
+ * - 用绝对时间 timerfd（纳秒精度）唤醒，线程定时器松弛降到 50µs
+ * - 无逐连接 QTimer，无信号跨线程跳转
+ * - 会话的 KcpCore 处于单一所有者模式，ikcpcb 只在引擎线程访问；
+ *   应用线程投递发送后调用 wake() 让引擎立即执行并 flush
+ *
+ * 仅 Linux 可用；其他平台 instance() 返回 nullptr，KcpTransport 继续使用 QTimer。
+ */
+
+#ifndef KCP_IO_ENGINE_H
+#define KCP_IO_ENGINE_H
+
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "SPSCQueue.h"
+#include "TimerWheel.h"
+
+class KcpIoEngine
+{
+public:
+    /**
+     * @brief 会话回调接口（全部在引擎线程调用）
+     *
+     * 返回值为距下次需要 update 的毫秒数（通常为 ikcp_check - now），<0 表示不再定时。
+     */
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+        virtual int onEngineReadable() = 0;
+        virtual int onEngineTimer() = 0;
+        virtual int onEngineWake() = 0;     // wake() 之后调用
+    };
+
+    /**
+     * @brief 当前平台是否支持（编译期确定）
+     */
+    static bool isSupported();
+
+    /**
+     * @brief 进程内唯一引擎（首次调用时启动线程），不支持的平台返回 nullptr
+     */
+    static KcpIoEngine *instance();
+
+    /**
+     * @brief 注册会话：监听 fd 可读，并在 firstDelayMs 后首次回调 onEngineTimer
+     *
+     * 同步完成：返回 true 时引擎已开始服务该会话；fd 无法加入 epoll 时不注册会话并返回 false，
+     * 调用方应改用自己的接收线程。
+     */
+    bool attach(Client *client, int fd, int firstDelayMs);
+
+    /**
+     * @brief 注销会话（同步：返回后不会再有该会话的回调，可在回调内调用）
+     */
+    void detach(Client *client);
+
+    /**
+     * @brief 请求在引擎线程尽快回调 onEngineWake（任意线程，无锁，不等待）
+     *
+     * 多次 wake 可能合并为一次回调；调用方自行去重可减少 eventfd 写入。
+     */
+    void wake(Client *client);
+
+    /**
+     * @brief 统计：唤醒次数 / 定时回调次数 / 定时延迟（实际唤醒 - 截止时间）
+     */
+    QString stats() const;
+
+    ~KcpIoEngine();
+
+private:
+    KcpIoEngine();
+
+    struct Session {
+        qsc::TimerWheel::Node node;     // 必须为首成员（由节点指针还原会话）
+        Client *client = nullptr;
+        int fd = -1;
+        uint64_t id = 0;
+    };
+
+    struct Command {
+        bool attach = false;
+        Client *client = nullptr;
+        int fd = -1;
+        int delayMs = 0;
+        bool *result = nullptr;         // attach 结果（引擎线程写入，submit 返回前有效）
+    };
+
+    bool start();
+    void run();
+    bool apply(const Command &cmd);
+    void wakeSession(Client *client);
+    void submit(const Command &cmd);
+    void reschedule(Session *session, int delayMs);
+    void armTimer();
+    uint64_t nowNs() const;
+    uint64_t nowMs() const { return (nowNs() - m_baseNs) / 1000000; }
+
+private:
+    int m_epollFd = -1;
+    int m_wakeFd = -1;
+    int m_timerFd = -1;
+    uint64_t m_baseNs = 0;
+    std::thread m_thread;
+    std::thread::id m_threadId;
+
+    // 跨线程命令（attach/detach），提交方等待引擎线程处理完成
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::vector<Command> m_commands;
+    uint64_t m_submitted = 0;
+    uint64_t m_completed = 0;
+
+    // 唤醒请求（多生产者安全：队列以 CAS 占位），溢出时唤醒全部会话
+    qsc::SPSCQueue<Client *, 256> m_wakeQueue;
+    std::atomic<bool> m_wakeOverflow{false};
+
+    // 以下仅引擎线程访问
+    qsc::TimerWheel m_wheel;
+    std::unordered_map<uint64_t, std::unique_ptr<Session>> m_sessions;
+    std::vector<std::unique_ptr<Session>> m_retired;   // 回调中注销的会话，本轮结束后释放
+    uint64_t m_nextId = 1;
+    uint64_t m_armedMs = qsc::TimerWheel::NO_EXPIRY;
+
+    // 统计
+    std::atomic<int> m_sessionCount{0};
+    std::atomic<uint64_t> m_wakeups{0};
+    std::atomic<uint64_t> m_timerFires{0};
+    std::atomic<uint64_t> m_lateUsTotal{0};
+    std::atomic<uint64_t> m_lateUsMax{0};
+};
+
+#endif // KCP_IO_ENGINE_H
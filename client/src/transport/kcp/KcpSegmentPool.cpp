@@ -0,0 +1,157 @@
+/**
+ * @file KcpSegmentPool.cpp
+ * @brief KCP 分段内存池实现
+ */
+
+#include "KcpSegmentPool.h"
+
+#include <cstdlib>
+#include <mutex>
+
+extern "C" {
+#include "ikcp.h"
+}
+
+namespace {
+
+// 块头：所属池 + 级别，保持 16 字节使载荷与 malloc 对齐一致
+struct alignas(16) BlockHeader {
+    KcpSegmentPool *pool;
+    int32_t cls;        // -1 = 直接 malloc
+};
+static_assert(sizeof(BlockHeader) == 16, "BlockHeader must keep 16-byte payload alignment");
+
+thread_local KcpSegmentPool *t_currentPool = nullptr;
+
+inline BlockHeader *headerOf(void *payload)
+{
+    return reinterpret_cast<BlockHeader *>(payload) - 1;
+}
+
+} // namespace
+
+std::atomic<uint64_t> KcpSegmentPool::s_fallbacks{0};
+
+KcpSegmentPool::~KcpSegmentPool()
+{
+    for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+        FreeBlock *block = m_freeList[cls];
+        while (block) {
+            FreeBlock *next = block->next;
+            std::free(headerOf(block));
+            block = next;
+        }
+        m_freeList[cls] = nullptr;
+    }
+}
+
+void KcpSegmentPool::install()
+{
+    static std::once_flag once;
+    std::call_once(once, []() {
+        ikcp_allocator(&KcpSegmentPool::hookMalloc, &KcpSegmentPool::hookFree);
+    });
+}
+
+KcpSegmentPool::Scope::Scope(KcpSegmentPool *pool)
+    : m_prev(t_currentPool)
+{
+    t_currentPool = pool;
+}
+
+KcpSegmentPool::Scope::~Scope()
+{
+    t_currentPool = m_prev;
+}
+
+KcpSegmentPool::Stats KcpSegmentPool::stats() const
+{
+    Stats s;
+    s.allocs = m_allocs.load(std::memory_order_relaxed);
+    s.hits = m_hits.load(std::memory_order_relaxed);
+    s.fallbacks = s_fallbacks.load(std::memory_order_relaxed);
+    for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+        s.inUse[cls] = m_inUse[cls].load(std::memory_order_relaxed);
+        s.highWater[cls] = m_highWater[cls].load(std::memory_order_relaxed);
+        s.cached[cls] = m_cached[cls].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void *KcpSegmentPool::allocate(size_t size)
+{
+    int cls = 0;
+    while (cls < CLASS_COUNT && size > CLASS_SIZES[cls]) {
+        ++cls;
+    }
+    if (cls == CLASS_COUNT) {
+        return nullptr;  // 超出最大级别（kcp->buffer 等），由调用方走 malloc
+    }
+
+    m_allocs.fetch_add(1, std::memory_order_relaxed);
+    const int inUse = m_inUse[cls].load(std::memory_order_relaxed) + 1;
+    m_inUse[cls].store(inUse, std::memory_order_relaxed);
+    if (inUse > m_highWater[cls].load(std::memory_order_relaxed)) {
+        m_highWater[cls].store(inUse, std::memory_order_relaxed);
+    }
+
+    if (FreeBlock *block = m_freeList[cls]) {
+        m_freeList[cls] = block->next;
+        m_cached[cls].fetch_sub(1, std::memory_order_relaxed);
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    auto *header = static_cast<BlockHeader *>(std::malloc(sizeof(BlockHeader) + CLASS_SIZES[cls]));
+    if (!header) {
+        m_inUse[cls].fetch_sub(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    header->pool = this;
+    header->cls = cls;
+    return header + 1;
+}
+
+void KcpSegmentPool::release(int cls, void *block)
+{
+    m_inUse[cls].fetch_sub(1, std::memory_order_relaxed);
+    if (m_cached[cls].load(std::memory_order_relaxed) >= MAX_CACHED_PER_CLASS) {
+        std::free(headerOf(block));
+        return;
+    }
+    auto *node = static_cast<FreeBlock *>(block);
+    node->next = m_freeList[cls];
+    m_freeList[cls] = node;
+    m_cached[cls].fetch_add(1, std::memory_order_relaxed);
+}
+
+void *KcpSegmentPool::hookMalloc(size_t size)
+{
+    if (KcpSegmentPool *pool = t_currentPool) {
+        if (void *p = pool->allocate(size)) {
+            return p;
+        }
+    }
+
+    s_fallbacks.fetch_add(1, std::memory_order_relaxed);
+    auto *header = static_cast<BlockHeader *>(std::malloc(sizeof(BlockHeader) + size));
+    if (!header) {
+        return nullptr;
+    }
+    header->pool = nullptr;
+    header->cls = -1;
+    return header + 1;
+}
+
+void KcpSegmentPool::hookFree(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    BlockHeader *header = headerOf(ptr);
+    if (header->pool) {
+        header->pool->release(header->cls, ptr);
+    } else {
+        std::free(header);
+    }
+}
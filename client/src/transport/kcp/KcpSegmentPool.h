@@ -0,0 +1,99 @@
+/**
+ * @file KcpSegmentPool.h
+ * @brief KCP 分段内存池 / KCP segment memory pool
+ *
+ * ikcp.c 每个发送/接收/确认的 IKCPSEG 都走一次 malloc/free，
+ * 高码率下 IO 线程每秒数万次堆分配。本池按大小分级缓存空闲块，
+ * 通过 ikcp_allocator 全局钩子接入。
+ *
+ * ikcp_allocator 是进程级、无上下文的钩子，因此"每个 KcpCore 一个池"的路由方式为：
+ * - KcpCore 在持锁调用 ikcp_* 期间用 Scope 设置线程局部的当前池（快速路径，无全局锁）
+ * - 每个块带 16 字节头记录所属池和级别，释放时直接归还所属池，与调用线程无关
+ * - 不在任何 Scope 内的分配（或超过最大级别）退化为普通 malloc，同样带头部
+ *
+ * 池本身不加锁：同一 KcpCore 的 ikcp_* 调用已被其互斥锁串行化。
+ */
+
+#ifndef KCP_SEGMENT_POOL_H
+#define KCP_SEGMENT_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class KcpSegmentPool
+{
+public:
+    // 大小级别（含 IKCPSEG 头约 72 字节）：控制小消息 / 中等 / 满 MSS 分段
+    static constexpr int CLASS_COUNT = 3;
+    static constexpr size_t CLASS_SIZES[CLASS_COUNT] = { 128, 512, 2048 };
+
+    // 每级最多缓存的空闲块数，超出直接 free（限制空闲内存约 4.7MB）
+    static constexpr int MAX_CACHED_PER_CLASS = 2048;
+
+    /**
+     * @brief 池统计（任意线程读取）
+     */
+    struct Stats {
+        uint64_t allocs = 0;        // 池内分配次数
+        uint64_t hits = 0;          // 命中空闲链表次数
+        uint64_t fallbacks = 0;     // 超出级别或无池时的 malloc 次数
+        int inUse[CLASS_COUNT] = {};
+        int highWater[CLASS_COUNT] = {};   // 各级同时在用块数峰值
+        int cached[CLASS_COUNT] = {};
+    };
+
+    KcpSegmentPool() = default;
+    ~KcpSegmentPool();
+
+    KcpSegmentPool(const KcpSegmentPool &) = delete;
+    KcpSegmentPool &operator=(const KcpSegmentPool &) = delete;
+
+    /**
+     * @brief 安装 ikcp_allocator 钩子（进程内只执行一次，须在首个 ikcp_create 之前）
+     */
+    static void install();
+
+    /**
+     * @brief 线程局部当前池作用域（可嵌套）
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(KcpSegmentPool *pool);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        KcpSegmentPool *m_prev;
+    };
+
+    Stats stats() const;
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    void *allocate(size_t size);
+    void release(int cls, void *block);
+
+    static void *hookMalloc(size_t size);
+    static void hookFree(void *ptr);
+
+private:
+    FreeBlock *m_freeList[CLASS_COUNT] = {};
+
+    // 统计：仅持有者线程写入，relaxed 即可
+    std::atomic<uint64_t> m_allocs{0};
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<int> m_inUse[CLASS_COUNT] = {};
+    std::atomic<int> m_highWater[CLASS_COUNT] = {};
+    std::atomic<int> m_cached[CLASS_COUNT] = {};
+
+    static std::atomic<uint64_t> s_fallbacks;
+};
+
+#endif // KCP_SEGMENT_POOL_H
@@ -53,6 +53,14 @@ KcpTransport::~KcpTransport()
 
 bool KcpTransport::bind(quint16 port)
 {
+    if (openBatchReceiver(port)) {
+        if (!m_engineAttached) {
+            m_updateTimer->start(m_updateInterval);
+        }
+        m_active = true;
+        return true;
+    }
+
     if (!m_socket->bind(QHostAddress::Any, port)) {
         emit errorOccurred(m_socket->errorString());
         return false;
@@ -70,16 +78,25 @@ bool KcpTransport::bind(quint16 port)
 void KcpTransport::connectTo(const QHostAddress &address, quint16 port)
 {
     m_remoteAddress = address;
-    m_remotePort = port;
+    m_remotePort.store(port, std::memory_order_release);
 
-    if (m_socket->state() != QAbstractSocket::BoundState) {
-        m_socket->bind();
+    // 未绑定时优先使用批量收包后端（仅 IPv4 目标）
+    bool batchReady = m_batchReceiver && m_batchReceiver->isOpen();
+    if (!batchReady && m_socket->state() != QAbstractSocket::BoundState
+        && address.protocol() == QAbstractSocket::IPv4Protocol) {
+        batchReady = openBatchReceiver(0);
     }
 
-    m_socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, QVariant(UDP_RECV_BUFFER_SIZE));
-    m_socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, QVariant(UDP_SEND_BUFFER_SIZE));
+    if (!batchReady) {
+        if (m_socket->state() != QAbstractSocket::BoundState) {
+            m_socket->bind();
+        }
+
+        m_socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, QVariant(UDP_RECV_BUFFER_SIZE));
+        m_socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, QVariant(UDP_SEND_BUFFER_SIZE));
+    }
 
-    if (!m_updateTimer->isActive()) {
+    if (!m_engineAttached && !m_updateTimer->isActive()) {
         m_updateTimer->start(m_updateInterval);
     }
     m_active = true;
@@ -90,12 +107,23 @@ void KcpTransport::close()
 {
     m_active = false;
     if (m_updateTimer) m_updateTimer->stop();
+    if (m_engineAttached) {
+        // 同步注销：返回后引擎不会再回调本对象
+        KcpIoEngine::instance()->detach(this);
+        m_engineAttached = false;
+        m_wakePending.store(false);
+        m_kcp->setSingleOwner(false);
+    }
+    if (m_batchReceiver) m_batchReceiver->stop();
     if (m_socket) m_socket->close();
     emit disconnected();
 }
 
 quint16 KcpTransport::localPort() const
 {
+    if (m_batchReceiver && m_batchReceiver->isOpen()) {
+        return m_batchReceiver->localPort();
+    }
     return m_socket ? m_socket->localPort() : 0;
 }
 
@@ -103,8 +131,15 @@ int KcpTransport::send(const char *data, int len)
 {
     if (!m_kcp || !m_active || len <= 0) return -1;
     int ret = m_kcp->send(data, len);
-    // 立即flush，减少延迟
-    if (ret >= 0) {
+    if (ret < 0) return ret;
+
+    if (m_kcp->isSingleOwner()) {
+        // 消息已入命令队列，唤醒引擎线程立即发出；引擎处理前的连续发送只唤醒一次
+        if (!m_wakePending.exchange(true)) {
+            KcpIoEngine::instance()->wake(this);
+        }
+    } else {
+        // 立即flush，减少延迟
         m_kcp->update(currentMs());
     }
     return ret;
@@ -115,6 +150,18 @@ int KcpTransport::send(const QByteArray &data)
     return send(data.constData(), data.size());
 }
 
+int KcpTransport::sendDatagram(const char *data, int len)
+{
+    const quint16 remotePort = m_remotePort.load(std::memory_order_acquire);
+    if (!m_socket || !m_active || remotePort == 0 || len <= 0) return -1;
+
+    if (m_batchReceiver && m_batchReceiver->isOpen()) {
+        return m_batchReceiver->send(data, len, m_remoteAddress, remotePort);
+    }
+    qint64 sent = m_socket->writeDatagram(data, len, m_remoteAddress, remotePort);
+    return sent < 0 ? -1 : static_cast<int>(sent);
+}
+
 QByteArray KcpTransport::recv()
 {
     if (!m_kcp) return QByteArray();
@@ -193,13 +240,17 @@ void KcpTransport::setStreamMode(int stream)
     if (m_kcp) m_kcp->setStream(stream);
 }
 
-void KcpTransport::setFecEnabled(bool enabled, int groupSize)
+void KcpTransport::setFecEnabled(bool enabled, int groupSize, int parityCount)
 {
     m_fecEnabled = enabled;
     if (enabled) {
-        m_fecEncoder = std::make_unique<fec::FecEncoder>(groupSize);
-        m_fecDecoder = std::make_unique<fec::FecDecoder>();
-        qInfo("[KcpTransport] FEC enabled: groupSize=%d", groupSize);
+        m_fecEncoder = std::make_unique<fec::FecEncoder>(groupSize, 1400, parityCount);
+        // 解码器分片区按协商的 k:m 预分配，稳态解码零分配
+        m_fecDecoder = std::make_unique<fec::FecDecoder>(std::max(groupSize, 16), 1400,
+                                                         std::max(parityCount, 1));
+        qInfo("[KcpTransport] FEC enabled: %s %d:%d",
+              m_fecEncoder->isReedSolomon() ? "RS" : "XOR",
+              m_fecEncoder->groupSize(), m_fecEncoder->parityCount());
     } else {
         m_fecEncoder.reset();
         m_fecDecoder.reset();
@@ -226,13 +277,7 @@ void KcpTransport::onSocketReadyRead()
     while (m_socket->hasPendingDatagrams() && count < MAX_BATCH) {
         qint64 size = m_socket->readDatagram(packets[count].data, sizeof(packets[count].data),
                                               &sender, &senderPort);
-        if (size <= 0) continue;
-
-        if (m_remotePort == 0) {
-            m_remoteAddress = sender;
-            m_remotePort = senderPort;
-            emit peerConnected();
-        }
+        if (size <= 0 || !acceptSender(sender, senderPort)) continue;
 
         packets[count].size = static_cast<int>(size);
         ptrs[count] = packets[count].data;
@@ -242,6 +287,90 @@ void KcpTransport::onSocketReadyRead()
 
     if (count == 0) return;
 
+    processDatagrams(ptrs, sizes, count);
+}
+
+bool KcpTransport::acceptSender(const QHostAddress &sender, quint16 senderPort)
+{
+    const quint16 remotePort = m_remotePort.load(std::memory_order_acquire);
+    if (remotePort == 0) {
+        m_remoteAddress = sender;
+        m_remotePort.store(senderPort, std::memory_order_release);
+        emit peerConnected();
+        return true;
+    }
+    // 已锁定远端：伪造或残留的其他来源不得改写远端，也不进入 KCP
+    return senderPort == remotePort
+        && sender.isEqual(m_remoteAddress, QHostAddress::ConvertV4MappedToIPv4);
+}
+
+bool KcpTransport::openBatchReceiver(quint16 port)
+{
+    if (!UdpBatchReceiver::isSupported()) return false;
+
+    auto receiver = std::make_unique<UdpBatchReceiver>();
+    if (!receiver->open(port, UDP_RECV_BUFFER_SIZE, false)) {
+        qWarning("[KcpTransport] recvmmsg backend unavailable, falling back to QUdpSocket");
+        return false;
+    }
+
+    // 收包回调：KcpCore 内部加锁（引擎模式下为所有者线程，不加锁），FEC 解码器仅在收包线程使用
+    m_batchCallback = [this](const UdpBatchReceiver::Batch &batch) {
+        if (!m_active) return;
+        if (!acceptSender(batch.sender, batch.senderPort)) return;
+        processDatagrams(batch.data, batch.sizes, batch.count);
+    };
+
+    // 优先挂到共享 IO 引擎（收包 + 定时 update 同线程），否则用接收器自带线程 + QTimer
+    // 引擎线程成为 ikcpcb 唯一所有者（须在 attach 前切换，attach 后首个回调即为所有者）
+    KcpIoEngine *engine = KcpIoEngine::instance();
+    if (engine) {
+        m_kcp->setSingleOwner(true);
+        if (engine->attach(this, receiver->fd(), 0)) {
+            m_batchReceiver = std::move(receiver);
+            m_engineAttached = true;
+            return true;
+        }
+        m_kcp->setSingleOwner(false);
+    }
+
+    if (!receiver->start(m_batchCallback)) {
+        return false;
+    }
+    m_batchReceiver = std::move(receiver);
+    return true;
+}
+
+void KcpTransport::setDatagramListener(quint8 marker, DatagramListener listener)
+{
+    m_datagramMarker = marker;
+    m_datagramListener = std::move(listener);
+}
+
+void KcpTransport::processDatagrams(const char *const *ptrs, const int *sizes, int count)
+{
+    if (!m_datagramListener) {
+        inputDatagrams(ptrs, sizes, count);
+        return;
+    }
+    // 旁路包把批次切成连续段，KCP 包仍按到达顺序批量输入
+    int start = 0;
+    for (int i = 0; i < count; ++i) {
+        if (sizes[i] > 1 && static_cast<quint8>(ptrs[i][0]) == m_datagramMarker) {
+            if (i > start) {
+                inputDatagrams(ptrs + start, sizes + start, i - start);
+            }
+            m_datagramListener(ptrs[i] + 1, sizes[i] - 1);
+            start = i + 1;
+        }
+    }
+    if (count > start) {
+        inputDatagrams(ptrs + start, sizes + start, count - start);
+    }
+}
+
+void KcpTransport::inputDatagrams(const char *const *ptrs, const int *sizes, int count)
+{
     // FEC 解码或批量输入
     bool hasData = false;
     if (m_fecEnabled && m_fecDecoder) {
@@ -253,7 +382,7 @@ void KcpTransport::onSocketReadyRead()
                 });
         }
         m_kcp->update(currentMs());
-        hasData = m_kcp->peekSize() > 0;
+        hasData = m_kcp->hasMessages();
     } else {
         // 非 FEC 模式：批量输入 + update（单次加锁）
         // processInputBatch 内部已做 peekSize，直接利用返回值，省去额外一次加锁
@@ -265,6 +394,36 @@ void KcpTransport::onSocketReadyRead()
     }
 }
 
+int KcpTransport::onEngineReadable()
+{
+    if (m_batchReceiver) {
+        m_batchReceiver->readPending(m_batchCallback);
+    }
+    return nextUpdateDelay();
+}
+
+int KcpTransport::onEngineTimer()
+{
+    m_kcp->update(currentMs());
+    return nextUpdateDelay();
+}
+
+int KcpTransport::onEngineWake()
+{
+    // 先清标志再执行命令：之后入队的发送会再次 wake，不会遗漏
+    m_wakePending.store(false);
+    // 执行投递的发送并立即 flush，不等下一个 interval
+    m_kcp->flush();
+    return nextUpdateDelay();
+}
+
+int KcpTransport::nextUpdateDelay()
+{
+    // ikcp_check 返回不早于 current 的下次 update 时间（不超过 interval）
+    const uint32_t current = currentMs();
+    return static_cast<int>(m_kcp->check(current) - current);
+}
+
 void KcpTransport::onUpdateTimer()
 {
     if (!m_kcp || !m_active) return;
@@ -296,19 +455,31 @@ void KcpTransport::scheduleNextUpdate()
 
 int KcpTransport::udpOutput(const char *buf, int len)
 {
-    if (!m_socket || !m_active || m_remotePort == 0) return -1;
+    const quint16 remotePort = m_remotePort.load(std::memory_order_acquire);
+    if (!m_socket || !m_active || remotePort == 0) return -1;
 
-    // FEC 编码：每 groupSize 个包生成 1 个 XOR 校验包，可恢复单个丢包
+    // udpOutput 只在 KcpCore 锁内或单一所有者线程中被调用，收发线程不会并发进入
+    UdpBatchReceiver *batch = (m_batchReceiver && m_batchReceiver->isOpen()) ? m_batchReceiver.get() : nullptr;
+
+    // FEC 编码：每 groupSize 个包生成 1 个 XOR 校验包（可恢复单个丢包），
+    // 或 parityCount 个 RS 校验包（可恢复组内任意 parityCount 个丢包）
     if (m_fecEnabled && m_fecEncoder) {
         m_fecEncoder->encode(reinterpret_cast<const uint8_t*>(buf), len,
-            [this](const uint8_t* data, int dataLen) {
-                m_socket->writeDatagram(reinterpret_cast<const char*>(data), dataLen,
-                                        m_remoteAddress, m_remotePort);
+            [this, batch, remotePort](const uint8_t* data, int dataLen) {
+                if (batch) {
+                    batch->send(reinterpret_cast<const char*>(data), dataLen, m_remoteAddress, remotePort);
+                } else {
+                    m_socket->writeDatagram(reinterpret_cast<const char*>(data), dataLen,
+                                            m_remoteAddress, remotePort);
+                }
             });
         return len;
     }
 
-    qint64 sent = m_socket->writeDatagram(buf, len, m_remoteAddress, m_remotePort);
+    if (batch) {
+        return batch->send(buf, len, m_remoteAddress, remotePort);
+    }
+    qint64 sent = m_socket->writeDatagram(buf, len, m_remoteAddress, remotePort);
     return sent < 0 ? -1 : static_cast<int>(sent);
 }
 
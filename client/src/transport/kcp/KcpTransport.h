@@ -34,10 +34,14 @@
 #include <QElapsedTimer>
 #include <QHostAddress>
 #include <QByteArray>
+#include <atomic>
+#include <functional>
 #include <memory>
 
 #include "KcpCore.h"
+#include "KcpIoEngine.h"
 #include "FecCodec.h"
+#include "UdpBatchReceiver.h"
 
 /**
  * @brief KCP 传输层 - UDP + KCP 协议栈 / KCP Transport - UDP + KCP Protocol Stack
@@ -46,8 +50,15 @@
  * - 管理 UDP 套接字 / Manage UDP socket
  * - 定时调用 KCP update / Periodically call KCP update
  * - 转发数据收发 / Forward data send/recv
+ *
+ * 收包与定时后端 / Receive & timer backend:
+ * - Linux: UdpBatchReceiver（recvmmsg 批量）挂到 KcpIoEngine 共享 IO 线程，
+ *   按 ikcp_check 截止时间由时间轮驱动 update；dataReady 在引擎线程发出
+ *   （跨线程的 AutoConnection 自动排队）。KcpCore 切换为单一所有者模式：
+ *   send() 只入命令队列并 wake 引擎，recv() 读取引擎收好的消息队列，双方不再争锁
+ * - 其他平台 / 回退: QUdpSocket readyRead + QTimer
  */
-class KcpTransport : public QObject
+class KcpTransport : public QObject, private KcpIoEngine::Client
 {
     Q_OBJECT
 
@@ -110,7 +121,7 @@ public:
     /**
      * @brief 获取远端端口
      */
-    quint16 remotePort() const { return m_remotePort; }
+    quint16 remotePort() const { return m_remotePort.load(std::memory_order_acquire); }
 
     //=========================================================================
     // 数据传输
@@ -123,6 +134,14 @@ public:
     int send(const char *data, int len);
     int send(const QByteArray &data);
 
+    /**
+     * @brief 直接发送一个 UDP 数据报（不经 KCP/FEC，不保证到达）
+     *
+     * 批量收包后端下直接 sendto 共享 fd（任意线程）；QUdpSocket 回退路径须在 socket 所在线程调用。
+     * @return 发送字节数，<0失败
+     */
+    int sendDatagram(const char *data, int len);
+
     /**
      * @brief 接收数据
      * @return 接收到的数据，无数据返回空
@@ -186,7 +205,7 @@ public:
     void setMtu(int mtu);
 
     /**
-     * @brief 设置更新间隔
+     * @brief 设置更新间隔（仅 QTimer 回退路径；引擎路径按 ikcp_check 调度）
      * @param interval 毫秒，默认10
      */
     void setUpdateInterval(int interval);
@@ -199,8 +218,9 @@ public:
      * @brief 启用/禁用 FEC
      * @param enabled 是否启用
      * @param groupSize FEC 组大小 (默认 10，即 10:1 编码)
+     * @param parityCount 每组校验包数 (默认 1 = XOR；>1 使用 Reed-Solomon k:m)
      */
-    void setFecEnabled(bool enabled, int groupSize = 10);
+    void setFecEnabled(bool enabled, int groupSize = 10, int parityCount = 1);
 
     /**
      * @brief FEC 是否启用
@@ -227,6 +247,19 @@ public:
      */
     void setStreamMode(int stream);
 
+    // =========================================================================
+    // 旁路数据报 / Side-channel datagrams
+    // =========================================================================
+
+    using DatagramListener = std::function<void(const char *data, int len)>;
+
+    /**
+     * @brief 首字节为 marker 的 UDP 包不进入 FEC/KCP，去掉 marker 后交给 listener（收包线程回调）
+     *
+     * 与服务端 KcpTransport.setDatagramListener 对应（如触摸 MOVE 不可靠通道），须在 bind() 之前设置。
+     */
+    void setDatagramListener(quint8 marker, DatagramListener listener);
+
     /**
      * @brief 获取KCP核心对象（高级用法）
      */
@@ -267,23 +300,49 @@ private:
     // 计算并设置下次更新时间
     void scheduleNextUpdate();
 
+    // 尝试启用 Linux 批量收包后端，失败返回 false（调用方回退到 QUdpSocket）
+    bool openBatchReceiver(quint16 port);
+
+    // 首个数据报锁定远端；已锁定时丢弃其他来源的数据报，返回是否接受
+    bool acceptSender(const QHostAddress &sender, quint16 senderPort);
+
+    // 分出旁路数据报，其余交给 inputDatagrams
+    void processDatagrams(const char *const *ptrs, const int *sizes, int count);
+    // 批量输入 KCP（FEC 解码 / processInputBatch），有完整消息时发出 dataReady
+    void inputDatagrams(const char *const *ptrs, const int *sizes, int count);
+
+    // KcpIoEngine::Client（引擎线程）
+    int onEngineReadable() override;
+    int onEngineTimer() override;
+    int onEngineWake() override;
+    int nextUpdateDelay();
+
 private:
     std::unique_ptr<KcpCore> m_kcp;
 
     QUdpSocket *m_socket = nullptr;
+    std::unique_ptr<UdpBatchReceiver> m_batchReceiver;
+    UdpBatchReceiver::BatchCallback m_batchCallback;
+    bool m_engineAttached = false;      // 由 KcpIoEngine 驱动收包和 update（不启用 QTimer）
+    std::atomic<bool> m_wakePending{false};  // 已请求 wake 但引擎尚未处理（合并连续发送）
     QTimer *m_updateTimer = nullptr;
     QElapsedTimer m_clock;
 
+    // 远端地址：端口非 0 即表示地址已发布（接收线程写入一次，发送路径 acquire 读取）
     QHostAddress m_remoteAddress;
-    quint16 m_remotePort = 0;
+    std::atomic<quint16> m_remotePort{0};
 
-    bool m_active = false;
+    std::atomic<bool> m_active{false};
     int m_updateInterval = 1;  // 每1ms调用一次update，保证低延迟
 
     // FEC 前向纠错
     bool m_fecEnabled = false;
     std::unique_ptr<fec::FecEncoder> m_fecEncoder;
     std::unique_ptr<fec::FecDecoder> m_fecDecoder;
+
+    // 旁路数据报
+    quint8 m_datagramMarker = 0;
+    DatagramListener m_datagramListener;
 };
 
 #endif // KCP_TRANSPORT_H
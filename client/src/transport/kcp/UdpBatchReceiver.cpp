@@ -0,0 +1,383 @@
+/**
+ * @file UdpBatchReceiver.cpp
+ * @brief 批量 UDP 接收后端实现 (Linux recvmmsg + UDP_GRO)
+ */
+
+#include "UdpBatchReceiver.h"
+#include <QtDebug>
+
+#ifdef Q_OS_LINUX
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// 旧版 glibc 头文件未定义 UDP_GRO（Linux 5.0+ 内核支持）
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#endif
+
+#ifdef Q_OS_LINUX
+struct UdpBatchReceiver::Native {
+    mmsghdr msgs[BATCH_SIZE];
+    iovec iovs[BATCH_SIZE];
+    sockaddr_in addrs[BATCH_SIZE];
+    // 每条消息的 cmsg 区，仅用于取 UDP_GRO 分段大小
+    alignas(cmsghdr) char control[BATCH_SIZE][CMSG_SPACE(sizeof(int))];
+
+    // 来源地址缓存：地址不变时不重复构造 QHostAddress
+    in_addr_t lastAddr = 0;
+    in_port_t lastPort = 0;
+    QHostAddress sender;
+};
+#else
+struct UdpBatchReceiver::Native {
+};
+#endif
+
+UdpBatchReceiver::UdpBatchReceiver() = default;
+
+UdpBatchReceiver::~UdpBatchReceiver()
+{
+    stop();
+}
+
+bool UdpBatchReceiver::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef Q_OS_LINUX
+
+bool UdpBatchReceiver::open(quint16 port, int recvBufferSize, bool enableGro)
+{
+    stop();
+
+    m_fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_fd < 0) {
+        qWarning("[UdpBatchReceiver] socket() failed: %s", strerror(errno));
+        return false;
+    }
+
+    setReceiveBufferSize(recvBufferSize);
+
+    m_groEnabled = false;
+    if (enableGro) {
+        int on = 1;
+        m_groEnabled = ::setsockopt(m_fd, SOL_UDP, UDP_GRO, &on, sizeof(on)) == 0;
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (::bind(m_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        qWarning("[UdpBatchReceiver] bind(%u) failed: %s", port, strerror(errno));
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    socklen_t addrLen = sizeof(addr);
+    ::getsockname(m_fd, reinterpret_cast<sockaddr *>(&addr), &addrLen);
+    m_localPort = ntohs(addr.sin_port);
+
+    // 预分配接收区：GRO 模式每条消息可能承载多个合并分段
+    m_bufferStride = m_groEnabled ? GRO_BUFFER : MAX_DATAGRAM;
+    const int maxSegments = m_groEnabled ? BATCH_SIZE * MAX_GRO_SEGMENTS : BATCH_SIZE;
+    m_buffers.assign(static_cast<size_t>(BATCH_SIZE) * m_bufferStride, 0);
+    m_ptrs.assign(maxSegments, nullptr);
+    m_sizes.assign(maxSegments, 0);
+
+    m_native = std::make_unique<Native>();
+    for (int i = 0; i < BATCH_SIZE; ++i) {
+        m_native->iovs[i].iov_base = m_buffers.data() + static_cast<size_t>(i) * m_bufferStride;
+        m_native->iovs[i].iov_len = m_bufferStride;
+    }
+
+    qInfo("[UdpBatchReceiver] bound port %u, batch=%d, gro=%s",
+          m_localPort, BATCH_SIZE, m_groEnabled ? "on" : "off");
+    return true;
+}
+
+bool UdpBatchReceiver::setReceiveBufferSize(int recvBufferSize)
+{
+    if (m_fd < 0) return false;
+    // 先尝试 SO_RCVBUFFORCE（需 CAP_NET_ADMIN），失败再用受 rmem_max 限制的 SO_RCVBUF
+    if (::setsockopt(m_fd, SOL_SOCKET, SO_RCVBUFFORCE, &recvBufferSize, sizeof(recvBufferSize)) == 0) {
+        return true;
+    }
+    return ::setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &recvBufferSize, sizeof(recvBufferSize)) == 0;
+}
+
+bool UdpBatchReceiver::start(BatchCallback callback)
+{
+    if (m_fd < 0 || m_running) return false;
+
+    // 内部线程模式才需要自己的 epoll + 唤醒 fd
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epollFd < 0 || m_wakeFd < 0) {
+        qWarning("[UdpBatchReceiver] epoll/eventfd failed: %s", strerror(errno));
+        stop();
+        return false;
+    }
+
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = m_fd;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_fd, &ev);
+    ev.data.fd = m_wakeFd;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &ev);
+
+    m_callback = std::move(callback);
+    m_running = true;
+    m_thread = std::thread([this]() { run(); });
+    return true;
+}
+
+void UdpBatchReceiver::stop()
+{
+    if (m_running.exchange(false) && m_wakeFd >= 0) {
+        uint64_t one = 1;
+        ssize_t ret = ::write(m_wakeFd, &one, sizeof(one));
+        Q_UNUSED(ret);
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+        m_epollFd = -1;
+    }
+    if (m_wakeFd >= 0) {
+        ::close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+    m_localPort = 0;
+}
+
+int UdpBatchReceiver::send(const char *data, int len, const QHostAddress &host, quint16 port)
+{
+    if (m_fd < 0) return -1;
+
+    bool ok = false;
+    quint32 ip4 = host.toIPv4Address(&ok);
+    if (!ok) return -1;
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(ip4);
+    addr.sin_port = htons(port);
+
+    ssize_t sent = ::sendto(m_fd, data, static_cast<size_t>(len), 0,
+                            reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    return sent < 0 ? -1 : static_cast<int>(sent);
+}
+
+void UdpBatchReceiver::run()
+{
+    epoll_event events[2];
+
+    while (m_running) {
+        int n = ::epoll_wait(m_epollFd, events, 2, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            qWarning("[UdpBatchReceiver] epoll_wait failed: %s", strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            if (events[i].data.fd != m_fd) continue;
+            // 边读边交付；不满一批说明队列已读空，回到 epoll（水平触发，不会漏）
+            while (m_running && receiveBatch(m_callback, nullptr) == BATCH_SIZE) {
+            }
+        }
+    }
+}
+
+int UdpBatchReceiver::readPending(const BatchCallback &callback)
+{
+    if (m_fd < 0 || !m_native) return 0;
+
+    int delivered = 0;
+    while (receiveBatch(callback, &delivered) == BATCH_SIZE) {
+    }
+    return delivered;
+}
+
+int UdpBatchReceiver::receiveBatch(const BatchCallback &callback, int *delivered)
+{
+    Native &nat = *m_native;
+    for (int i = 0; i < BATCH_SIZE; ++i) {
+        msghdr &hdr = nat.msgs[i].msg_hdr;
+        hdr.msg_name = &nat.addrs[i];
+        hdr.msg_namelen = sizeof(sockaddr_in);
+        hdr.msg_iov = &nat.iovs[i];
+        hdr.msg_iovlen = 1;
+        hdr.msg_control = m_groEnabled ? nat.control[i] : nullptr;
+        hdr.msg_controllen = m_groEnabled ? sizeof(nat.control[i]) : 0;
+        hdr.msg_flags = 0;
+        nat.msgs[i].msg_len = 0;
+    }
+
+    int received = ::recvmmsg(m_fd, nat.msgs, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    m_syscalls.fetch_add(1, std::memory_order_relaxed);
+    if (received <= 0) {
+        return 0;
+    }
+
+    // 拆分 GRO 合并消息：每段 gsoSize 字节，末段可能更短
+    // 按来源地址切分为多个子批：同一子批内所有数据报来源相同，避免首包来源被套用到整批
+    int count = 0;
+    int runStart = 0;
+    int runMsg = -1;
+    auto flushRun = [&]() {
+        if (count == runStart) return;
+        const sockaddr_in &from = nat.addrs[runMsg];
+        if (from.sin_addr.s_addr != nat.lastAddr || from.sin_port != nat.lastPort) {
+            nat.lastAddr = from.sin_addr.s_addr;
+            nat.lastPort = from.sin_port;
+            nat.sender = QHostAddress(ntohl(from.sin_addr.s_addr));
+        }
+
+        Batch batch;
+        batch.data = m_ptrs.data() + runStart;
+        batch.sizes = m_sizes.data() + runStart;
+        batch.count = count - runStart;
+        batch.sender = nat.sender;
+        batch.senderPort = ntohs(from.sin_port);
+
+        m_batches.fetch_add(1, std::memory_order_relaxed);
+        m_datagrams.fetch_add(static_cast<quint64>(batch.count), std::memory_order_relaxed);
+        if (delivered) {
+            *delivered += batch.count;
+        }
+        if (callback) {
+            callback(batch);
+        }
+        runStart = count;
+    };
+
+    for (int i = 0; i < received; ++i) {
+        const char *base = static_cast<const char *>(nat.iovs[i].iov_base);
+        int len = static_cast<int>(nat.msgs[i].msg_len);
+        if (len <= 0) continue;
+
+        if (runMsg >= 0 && (nat.addrs[i].sin_addr.s_addr != nat.addrs[runMsg].sin_addr.s_addr
+                            || nat.addrs[i].sin_port != nat.addrs[runMsg].sin_port)) {
+            flushRun();
+        }
+        if (count == runStart) runMsg = i;
+
+        int segSize = len;
+        if (m_groEnabled) {
+            msghdr &hdr = nat.msgs[i].msg_hdr;
+            for (cmsghdr *c = CMSG_FIRSTHDR(&hdr); c; c = CMSG_NXTHDR(&hdr, c)) {
+                if (c->cmsg_level == SOL_UDP && c->cmsg_type == UDP_GRO) {
+                    int gso = 0;
+                    memcpy(&gso, CMSG_DATA(c), sizeof(gso));
+                    if (gso > 0) segSize = gso;
+                    break;
+                }
+            }
+        }
+
+        for (int off = 0; off < len && count < static_cast<int>(m_ptrs.size()); off += segSize) {
+            m_ptrs[count] = base + off;
+            m_sizes[count] = qMin(segSize, len - off);
+            count++;
+        }
+    }
+    flushRun();
+
+    return received;
+}
+
+#else // !Q_OS_LINUX
+
+bool UdpBatchReceiver::open(quint16 port, int recvBufferSize, bool enableGro)
+{
+    Q_UNUSED(port);
+    Q_UNUSED(recvBufferSize);
+    Q_UNUSED(enableGro);
+    return false;
+}
+
+bool UdpBatchReceiver::setReceiveBufferSize(int recvBufferSize)
+{
+    Q_UNUSED(recvBufferSize);
+    return false;
+}
+
+bool UdpBatchReceiver::start(BatchCallback callback)
+{
+    Q_UNUSED(callback);
+    return false;
+}
+
+void UdpBatchReceiver::stop()
+{
+}
+
+int UdpBatchReceiver::send(const char *data, int len, const QHostAddress &host, quint16 port)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(len);
+    Q_UNUSED(host);
+    Q_UNUSED(port);
+    return -1;
+}
+
+int UdpBatchReceiver::readPending(const BatchCallback &callback)
+{
+    Q_UNUSED(callback);
+    return 0;
+}
+
+void UdpBatchReceiver::run()
+{
+}
+
+int UdpBatchReceiver::receiveBatch(const BatchCallback &callback, int *delivered)
+{
+    Q_UNUSED(callback);
+    Q_UNUSED(delivered);
+    return 0;
+}
+
+#endif // Q_OS_LINUX
+
+QString UdpBatchReceiver::stats() const
+{
+    const quint64 batches = m_batches.load();
+    const quint64 datagrams = m_datagrams.load();
+    return QString("batches=%1,dgrams=%2,syscalls=%3,avgBatch=%4,gro=%5")
+        .arg(batches)
+        .arg(datagrams)
+        .arg(m_syscalls.load())
+        .arg(batches > 0 ? static_cast<double>(datagrams) / batches : 0.0, 0, 'f', 1)
+        .arg(m_groEnabled ? "on" : "off");
+}
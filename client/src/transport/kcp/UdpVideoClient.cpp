@@ -4,6 +4,9 @@
  */
 
 #include "UdpVideoClient.h"
+#include "FecCodec.h"
+#include "PerformanceMonitor.h"
+#include "UdpBatchReceiver.h"
 #include <QVariant>
 #include <QtDebug>
 
@@ -21,6 +24,11 @@ UdpVideoClient::UdpVideoClient(QObject *parent)
     // 默认用下限值初始化，configure() 会根据实际参数重新设置
     m_ringBuffer.reserve(m_ringBufferSize);
     m_frameBuffer = new char[m_frameBufferSize];
+
+    // 分片 = [len(2B)][flags][payload ≤ MTU-5]
+    m_seqFec = std::make_unique<fec::SeqFecDecoder>(1408);
+
+    m_clock.start();
 }
 
 UdpVideoClient::~UdpVideoClient()
@@ -40,6 +48,11 @@ void UdpVideoClient::configure(quint32 bitrateBps, quint32 maxFps)
 {
     // fps 为 0 表示不限制，默认按 60fps 计算
     quint32 fps = (maxFps > 0) ? maxFps : 60;
+    m_maxFps = fps;
+
+    // 配置码率即带宽估计上限（编码器不会超过它）
+    m_bwe.setMaxBitrate(bitrateBps);
+    m_targetBitrate = m_bwe.targetBitrate();
 
     // 环形缓冲区：缓冲约 3 秒数据
     qint64 ringSize = static_cast<qint64>(bitrateBps) / 8 * 3;
@@ -47,9 +60,8 @@ void UdpVideoClient::configure(quint32 bitrateBps, quint32 maxFps)
                             MIN_RING_BUFFER);
 
     // OS 接收缓冲：约 10 帧数据量
-    qint64 recvSize = static_cast<qint64>(bitrateBps) / 8 / fps * 10;
-    m_recvBufferSize = qMax(static_cast<int>(qMin(recvSize, static_cast<qint64>(16 * 1024 * 1024))),
-                            MIN_RECV_BUFFER);
+    m_recvBufferSize = recvBufferSizeFor(bitrateBps);
+    m_appliedRecvBuffer = m_recvBufferSize;
 
     // 帧重组缓冲：I 帧可达平均帧的 10-15 倍，不能用 avg*3 估算。
     // 上限取 bitrate/8（=1秒数据=IDR间隔），单帧不可能超此值。最小 1MB，最大 8MB。
@@ -71,8 +83,80 @@ void UdpVideoClient::configure(quint32 bitrateBps, quint32 maxFps)
           m_frameBufferSize / 1024);
 }
 
+void UdpVideoClient::setFecEnabled(bool enabled)
+{
+    m_fecEnabled = enabled;
+    qInfo("[UdpVideoClient] video FEC %s", enabled ? "enabled" : "disabled");
+}
+
+UdpVideoClient::LossReport UdpVideoClient::takeLossReport()
+{
+    LossReport report;
+
+    const uint32_t packets = m_reportPackets.exchange(0);
+    const uint32_t lost = m_reportLost.exchange(0);
+    const uint32_t bursts = m_reportBursts.exchange(0);
+    const uint32_t maxBurst = m_reportMaxBurst.exchange(0);
+
+    const uint64_t total = static_cast<uint64_t>(packets) + lost;
+    if (total > 0) {
+        report.lossPermille = static_cast<quint16>(lost * 1000ULL / total);
+    }
+    if (bursts > 0) {
+        report.avgBurstX10 = static_cast<quint8>(qMin<uint32_t>(lost * 10 / bursts, 255));
+    }
+    report.maxBurst = static_cast<quint8>(qMin<uint32_t>(maxBurst, 255));
+
+    const uint64_t recovered = m_seqFec->recoveredCount();
+    const uint64_t unrecovered = m_seqFec->unrecoveredCount();
+    report.recovered = static_cast<quint16>(qMin<uint64_t>(recovered - m_lastRecovered, 0xFFFF));
+    report.unrecovered = static_cast<quint16>(qMin<uint64_t>(unrecovered - m_lastUnrecovered, 0xFFFF));
+    m_lastRecovered = recovered;
+    m_lastUnrecovered = unrecovered;
+
+    return report;
+}
+
+UdpVideoClient::TransportFeedback UdpVideoClient::takeTransportFeedback()
+{
+    TransportFeedback feedback;
+    feedback.recvBytes = m_feedbackBytes.exchange(0);
+    const uint64_t latest = m_feedbackLatest.load(std::memory_order_relaxed);
+    feedback.seq = static_cast<quint32>(latest >> 32);
+    feedback.recvTimeUs = static_cast<quint32>(latest);
+    return feedback;
+}
+
 bool UdpVideoClient::bind(quint16 port)
 {
+    // Linux：epoll 线程 + recvmmsg 批量收包，不经过 Qt 事件循环
+    if (UdpBatchReceiver::isSupported()) {
+        auto receiver = std::make_unique<UdpBatchReceiver>();
+        if (receiver->open(port, m_recvBufferSize, true)) {
+            receiver->start([this](const UdpBatchReceiver::Batch &batch) {
+                if (m_closed) return;
+                bool committed = false;
+                for (int i = 0; i < batch.count; ++i) {
+                    handleDatagram(batch.data[i], batch.sizes[i], committed);
+                }
+                if (committed) {
+                    m_dataAvailable.wakeAll();
+                }
+                updateBandwidthEstimate();
+            });
+            m_batchReceiver = std::move(receiver);
+            m_active = true;
+
+            qInfo("[UdpVideoClient] bound port %d (recvmmsg backend), ring=%dMB, recv=%dMB, frame=%dKB",
+                  port,
+                  m_ringBufferSize / (1024 * 1024),
+                  m_recvBufferSize / (1024 * 1024),
+                  m_frameBufferSize / 1024);
+            return true;
+        }
+        qWarning("[UdpVideoClient] recvmmsg backend unavailable, falling back to QUdpSocket");
+    }
+
     ensureIoThread();
 
     bool result = false;
@@ -98,6 +182,9 @@ bool UdpVideoClient::bind(quint16 port)
 
 quint16 UdpVideoClient::localPort() const
 {
+    if (m_batchReceiver) {
+        return m_batchReceiver->localPort();
+    }
     return m_socket ? m_socket->localPort() : 0;
 }
 
@@ -145,6 +232,9 @@ void UdpVideoClient::close()
 {
     m_closed = true;
     m_active = false;
+    if (m_batchReceiver) {
+        m_batchReceiver->stop();
+    }
     if (m_socket && m_ioThread && m_ioThread->isRunning()) {
         QMetaObject::invokeMethod(m_socket, [this]() {
             m_socket->close();
@@ -158,13 +248,19 @@ void UdpVideoClient::close()
 
 QString UdpVideoClient::stats() const
 {
-    return QString("recv=%1,buf=%2,pkts=%3,gaps=%4,frames=%5,drops=%6")
+    return QString("recv=%1,buf=%2,pkts=%3,gaps=%4,frames=%5,drops=%6,skipped=%7,fecRec=%8,fecLost=%9,bwe=%10kbps,late=%11")
         .arg(m_totalRecv.load())
         .arg(m_ringBuffer.available())
         .arg(m_totalPackets.load())
         .arg(m_gapCount.load())
         .arg(m_completedFrames.load())
-        .arg(m_droppedFrames.load());
+        .arg(m_droppedFrames.load())
+        .arg(m_skippedFrames.load())
+        .arg(m_seqFec->recoveredCount())
+        .arg(m_seqFec->unrecoveredCount())
+        .arg(m_targetBitrate.load() / 1000)
+        .arg(m_latePackets.load())
+        + (m_batchReceiver ? "," + m_batchReceiver->stats() : QString());
 }
 
 void UdpVideoClient::ensureIoThread()
@@ -184,104 +280,200 @@ void UdpVideoClient::onSocketReadyRead()
 
     while (m_socket->hasPendingDatagrams()) {
         qint64 size = m_socket->readDatagram(recvBuf, sizeof(recvBuf));
-        if (size <= SEQ_HEADER_SIZE) continue;
-
-        // 解析头部: seq (4B big-endian) + flags (1B)
-        uint32_t seq = (static_cast<uint32_t>(static_cast<uint8_t>(recvBuf[0])) << 24) |
-                       (static_cast<uint32_t>(static_cast<uint8_t>(recvBuf[1])) << 16) |
-                       (static_cast<uint32_t>(static_cast<uint8_t>(recvBuf[2])) << 8)  |
-                        static_cast<uint32_t>(static_cast<uint8_t>(recvBuf[3]));
-        uint8_t flags = static_cast<uint8_t>(recvBuf[4]);
-
-        // 首包检测
-        if (m_firstPacket) {
-            m_expectedSeq = seq;
-            m_firstPacket = false;
-            emit connected();
-        }
+        handleDatagram(recvBuf, static_cast<int>(size), committed);
+    }
+
+    if (committed) {
+        m_dataAvailable.wakeAll();
+    }
+    updateBandwidthEstimate();
+}
 
-        // 丢包统计
-        if (seq != m_expectedSeq) {
-            uint32_t gap = seq - m_expectedSeq;
-            m_gapCount.fetch_add(gap);
+void UdpVideoClient::handleDatagram(const char *data, int size, bool &committed)
+{
+    if (size <= SEQ_HEADER_SIZE) return;
+
+    // FEC 解码器按 seq 顺序交付（含恢复出的包）
+    auto deliver = [this, &committed](uint32_t seq, uint8_t flags, const uint8_t *payload, int len) {
+        processPacket(seq, flags, reinterpret_cast<const char *>(payload), len, committed);
+    };
+
+    // 解析头部: seq (4B big-endian) + flags (1B)
+    uint32_t seq = (static_cast<uint32_t>(static_cast<uint8_t>(data[0])) << 24) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(data[1])) << 16) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(data[2])) << 8)  |
+                    static_cast<uint32_t>(static_cast<uint8_t>(data[3]));
+    uint8_t flags = static_cast<uint8_t>(data[4]);
+    int payloadSize = size - SEQ_HEADER_SIZE;
+    const bool fecEnabled = m_fecEnabled.load(std::memory_order_relaxed);
+    m_feedbackBytes.fetch_add(static_cast<uint32_t>(size), std::memory_order_relaxed);
+
+    // 校验包：不占用序号，不参与丢包统计
+    if (flags & fec::SEQ_FEC_FLAG_PARITY) {
+        if (fecEnabled) {
+            m_seqFec->onParity(seq, reinterpret_cast<const uint8_t *>(data + SEQ_HEADER_SIZE),
+                               payloadSize, deliver);
         }
-        m_expectedSeq = seq + 1;
+        return;
+    }
+
+    // 首包检测
+    if (m_firstPacket) {
+        m_expectedSeq = seq;
+        m_firstPacket = false;
+        emit connected();
+    }
 
-        int payloadSize = static_cast<int>(size) - SEQ_HEADER_SIZE;
-        m_totalPackets++;
+    // 丢包统计（原始到达，FEC 恢复前）
+    // 序号按序列号算术比较：迟到 / 乱序包（seq 在 m_expectedSeq 之前）已在跳过它时计为丢失，
+    // 这里单独计数且不回退 m_expectedSeq，否则其后每个包都会被再计一次丢失，虚高回报给 FEC/码率的丢包率
+    uint32_t lost = 0;
+    const uint32_t gap = seq - m_expectedSeq;
+    if (gap >= 0x80000000u) {
+        m_latePackets.fetch_add(1, std::memory_order_relaxed);
         m_totalRecv += payloadSize;
+        if (fecEnabled) {
+            // 迟到的数据包仍可能帮助 FEC 恢复同组的其他包
+            m_seqFec->onData(seq, flags, reinterpret_cast<const uint8_t *>(data + SEQ_HEADER_SIZE),
+                             payloadSize, deliver);
+        }
+        // 无 FEC 时所在帧已因缺口丢弃，交给帧重组只会打断当前帧
+        return;
+    }
+    if (gap > 0) {
+        lost = gap;
+        m_gapCount.fetch_add(gap);
+        m_reportLost.fetch_add(gap, std::memory_order_relaxed);
+        m_reportBursts.fetch_add(1, std::memory_order_relaxed);
+        uint32_t prevMax = m_reportMaxBurst.load(std::memory_order_relaxed);
+        while (gap > prevMax &&
+               !m_reportMaxBurst.compare_exchange_weak(prevMax, gap, std::memory_order_relaxed)) {
+        }
+    }
+    m_expectedSeq = seq + 1;
+    m_feedbackLatest.store((static_cast<uint64_t>(seq) << 32)
+                               | static_cast<uint32_t>(qsc::ClockSync::nowUs()),
+                           std::memory_order_relaxed);
+
+    m_totalPackets++;
+    m_totalRecv += payloadSize;
+    m_reportPackets.fetch_add(1, std::memory_order_relaxed);
+    m_bwe.onPacket(m_clock.elapsed(), size, lost);
+
+    if (fecEnabled) {
+        m_seqFec->onData(seq, flags, reinterpret_cast<const uint8_t *>(data + SEQ_HEADER_SIZE),
+                         payloadSize, deliver);
+    } else {
+        processPacket(seq, flags, data + SEQ_HEADER_SIZE, payloadSize, committed);
+    }
+}
 
-        // ═══ 帧重组状态机 ═══
-        //
-        // SOF (Start of Frame) → 开始收集新帧
-        // EOF (End of Frame)   → 帧接收完成，提交到环形缓冲区
-        // seq 不连续           → 有丢包，整帧丢弃（不送解码器）
-        //
-        // 这保证了解码器只收到完整的帧数据，
-        // 即使 WiFi 丢包也不会导致字节流错位→画面持续脏污。
-
-        if (flags & FLAG_SOF) {
-            // ── 帧首包 ──
-            if (m_frameState == FrameState::COLLECTING) {
-                // 上一帧的 EOF 丢失，丢弃不完整帧
-                m_droppedFrames++;
-            }
-            m_frameLen = 0;
-            m_lastSeq = seq;
+void UdpVideoClient::processPacket(uint32_t seq, uint8_t flags, const char *payload, int payloadSize,
+                                   bool &committed)
+{
+    // ═══ 帧重组状态机 ═══
+    //
+    // SOF (Start of Frame) → 开始收集新帧
+    // EOF (End of Frame)   → 帧接收完成，提交到环形缓冲区
+    // seq 不连续           → 有丢包（FEC 也未能恢复），整帧丢弃（不送解码器）
+    //
+    // 这保证了解码器只收到完整的帧数据，
+    // 即使 WiFi 丢包也不会导致字节流错位→画面持续脏污。
+
+    if (flags & FLAG_SOF) {
+        // ── 帧首包 ──
+        if (m_frameState == FrameState::COLLECTING) {
+            // 上一帧的 EOF 丢失，丢弃不完整帧
+            dropFrame();
+        }
+        m_frameLen = 0;
+        m_lastSeq = seq;
+        m_frameStartMs = m_clock.elapsed();
 
-            if (payloadSize <= m_frameBufferSize) {
-                memcpy(m_frameBuffer, recvBuf + SEQ_HEADER_SIZE, payloadSize);
-                m_frameLen = payloadSize;
-            }
+        if (payloadSize <= m_frameBufferSize) {
+            memcpy(m_frameBuffer, payload, payloadSize);
+            m_frameLen = payloadSize;
+        }
 
-            if (flags & FLAG_EOF) {
-                // 单包帧（SOF|EOF），直接提交
-                commitFrame();
-                committed = true;
-                m_frameState = FrameState::WAITING_SOF;
-            } else {
-                m_frameState = FrameState::COLLECTING;
-            }
-        } else if (m_frameState == FrameState::COLLECTING) {
-            // ── 帧中间或尾包 ──
-            if (seq != m_lastSeq + 1) {
-                // seq 不连续 → 中间有丢包，整帧作废
-                m_droppedFrames++;
+        if (flags & FLAG_EOF) {
+            // 单包帧（SOF|EOF），直接提交
+            commitFrame();
+            committed = true;
+            m_frameState = FrameState::WAITING_SOF;
+        } else {
+            m_frameState = FrameState::COLLECTING;
+        }
+    } else if (m_frameState == FrameState::COLLECTING) {
+        // ── 帧中间或尾包 ──
+        if (seq != m_lastSeq + 1) {
+            // seq 不连续 → 中间有丢包，整帧作废
+            dropFrame();
+            m_frameLen = 0;
+            m_frameState = FrameState::WAITING_SOF;
+        } else {
+            m_lastSeq = seq;
+            if (m_frameLen + payloadSize > m_frameBufferSize) {
+                // 帧数据超出预期大小，丢弃
+                dropFrame();
                 m_frameLen = 0;
                 m_frameState = FrameState::WAITING_SOF;
             } else {
-                m_lastSeq = seq;
-                if (m_frameLen + payloadSize > m_frameBufferSize) {
-                    // 帧数据超出预期大小，丢弃
-                    m_droppedFrames++;
-                    m_frameLen = 0;
+                memcpy(m_frameBuffer + m_frameLen, payload, payloadSize);
+                m_frameLen += payloadSize;
+
+                if (flags & FLAG_EOF) {
+                    // 帧尾包 → 帧接收完成
+                    commitFrame();
+                    committed = true;
                     m_frameState = FrameState::WAITING_SOF;
-                } else {
-                    memcpy(m_frameBuffer + m_frameLen,
-                           recvBuf + SEQ_HEADER_SIZE, payloadSize);
-                    m_frameLen += payloadSize;
-
-                    if (flags & FLAG_EOF) {
-                        // 帧尾包 → 帧接收完成
-                        commitFrame();
-                        committed = true;
-                        m_frameState = FrameState::WAITING_SOF;
-                    }
                 }
             }
         }
-        // else: 非 SOF 且处于 WAITING_SOF → 孤立包（已丢弃帧的残余），忽略
+    } else if (!m_awaitingKeyFrame) {
+        // 非 SOF 且处于 WAITING_SOF → 孤立包：整帧的 SOF 已丢失
+        dropFrame();
     }
+    // else: 已丢弃帧的残余，忽略
+}
 
-    if (committed) {
-        m_dataAvailable.wakeAll();
-    }
+void UdpVideoClient::dropFrame()
+{
+    // 丢帧后解码参考链断裂，后续 P 帧送入解码器只会产生花屏
+    m_droppedFrames++;
+    m_awaitingKeyFrame = true;
+    emit keyFrameNeeded();
 }
 
 void UdpVideoClient::commitFrame()
 {
     if (m_frameLen <= 0) return;
 
+    // 带宽估计按帧首包到达时间计算延迟梯度（与帧大小无关），配置帧没有有效 PTS
+    if (m_frameLen >= FRAME_META_SIZE && !(static_cast<uint8_t>(m_frameBuffer[0]) & META_FLAG_CONFIG)) {
+        uint64_t ptsAndFlags = 0;
+        for (int i = 0; i < 8; ++i) {
+            ptsAndFlags = (ptsAndFlags << 8) | static_cast<uint8_t>(m_frameBuffer[i]);
+        }
+        m_bwe.onFrame(m_frameStartMs, static_cast<int64_t>(ptsAndFlags & 0x3FFFFFFFFFFFFFFFULL));
+        updateCaptureLatency(static_cast<int64_t>(ptsAndFlags & 0x3FFFFFFFFFFFFFFFULL));
+    }
+
+    if (m_awaitingKeyFrame) {
+        const uint8_t metaFlags = m_frameLen >= FRAME_META_SIZE
+                                      ? static_cast<uint8_t>(m_frameBuffer[0]) : 0;
+        if (!(metaFlags & (META_FLAG_KEY_FRAME | META_FLAG_CONFIG))) {
+            // 依赖帧：丢弃并再次请求（上层限频），防止请求本身丢失
+            m_skippedFrames++;
+            m_frameLen = 0;
+            emit keyFrameNeeded();
+            return;
+        }
+        // 配置帧（SPS/PPS）照常放行，收到关键帧才结束等待
+        if (metaFlags & META_FLAG_KEY_FRAME) {
+            m_awaitingKeyFrame = false;
+        }
+    }
+
     QMutexLocker locker(&m_mutex);
     if (m_ringBuffer.freeSpace() < m_frameLen) {
         // 关键修复：缓冲区满时丢弃新帧，而非 drop() 旧数据
@@ -291,11 +483,62 @@ void UdpVideoClient::commitFrame()
         //
         // 丢弃新帧只造成时间跳过（一帧黑/冻结），不破坏已提交的数据流，
         // 下一个 IDR 或后续帧可正常恢复。
-        m_droppedFrames++;
         m_frameLen = 0;
+        locker.unlock();
+        dropFrame();
         return;
     }
     m_ringBuffer.write(m_frameBuffer, m_frameLen);
     m_completedFrames++;
     m_frameLen = 0;
 }
+
+void UdpVideoClient::updateBandwidthEstimate()
+{
+    const qint64 now = m_clock.elapsed();
+    if (now - m_lastBweUpdate < BWE_UPDATE_INTERVAL_MS) return;
+    m_lastBweUpdate = now;
+
+    const quint32 target = m_bwe.update(now);
+    m_targetBitrate.store(target, std::memory_order_relaxed);
+
+    // OS 接收缓冲跟随目标码率（约 10 帧）：码率降下来后缓冲不再容纳过多陈旧数据；
+    // 变化超过 25% 才调整，避免频繁 setsockopt
+    const int recvSize = recvBufferSizeFor(target);
+    if (qAbs(recvSize - m_appliedRecvBuffer) * 4 <= m_appliedRecvBuffer) return;
+    if (m_batchReceiver) {
+        m_batchReceiver->setReceiveBufferSize(recvSize);
+    } else if (m_socket) {
+        m_socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, QVariant(recvSize));
+    }
+    qInfo("[UdpVideoClient] target bitrate %ukbps (%s, loss=%.1f%%) → recv=%dKB",
+          target / 1000, m_bwe.usageName(), m_bwe.lossRatio() * 100.0, recvSize / 1024);
+    m_appliedRecvBuffer = recvSize;
+}
+
+int UdpVideoClient::recvBufferSizeFor(quint32 bitrateBps) const
+{
+    qint64 recvSize = static_cast<qint64>(bitrateBps) / 8 / m_maxFps * 10;
+    return qMax(static_cast<int>(qMin(recvSize, static_cast<qint64>(16 * 1024 * 1024))),
+                MIN_RECV_BUFFER);
+}
+
+void UdpVideoClient::setClockSync(std::shared_ptr<const qsc::ClockSync> clockSync)
+{
+    std::atomic_store(&m_clockSync, std::move(clockSync));
+}
+
+void UdpVideoClient::updateCaptureLatency(int64_t ptsUs)
+{
+    const std::shared_ptr<const qsc::ClockSync> clockSync = std::atomic_load(&m_clockSync);
+    if (!clockSync || !clockSync->isSynced()) {
+        return;
+    }
+    const int64_t latencyUs = qsc::ClockSync::nowUs() - clockSync->deviceToClientUs(ptsUs);
+    // 时钟误差上界为 RTT/2，略小于 0 属正常；偏差过大说明 PTS 不是单调时钟（个别编码器），不上报
+    if (latencyUs < -50000 || latencyUs > 10000000) {
+        return;
+    }
+    m_captureLatencyUs.store(latencyUs, std::memory_order_relaxed);
+    qsc::PerformanceMonitor::instance().reportCaptureLatency(latencyUs / 1000.0);
+}
@@ -14,6 +14,32 @@
  *   客户端按 SOF→EOF 重组帧数据。若 SOF 到 EOF 之间有任何
  *   丢包（seq 不连续），整帧丢弃，不送解码器。解码器只收到完整的
  *   帧数据，即使 WiFi 丢包也不会导致字节流错位→画面脏污。
+ *
+ * 视频 FEC（可选）：
+ *   flags bit 7 为校验包，交给 fec::SeqFecDecoder 恢复丢包后再按 seq 顺序
+ *   进入帧重组。接收端统计原始丢包率/突发长度/恢复数，经控制通道回报，
+ *   发送端据此调整校验比例。
+ *
+ * 关键帧请求：
+ *   出现无法恢复的丢帧后，后续依赖帧（P 帧）全部丢弃，直到收到关键帧/配置帧，
+ *   并发出 keyFrameNeeded() 由上层经控制通道请求编码器立即输出同步帧，
+ *   画面冻结时间从"等待下一个周期 IDR"缩短到约一个 RTT。
+ *
+ * 带宽估计：
+ *   每个数据包和每帧首包到达时间送入 BandwidthEstimator（到达速率 + 帧间延迟梯度 + 丢包），
+ *   约每 50ms 更新一次目标码率，由上层经控制通道回报编码器；OS 接收缓冲随目标码率调整。
+ *
+ * 传输反馈：
+ *   记录最新按序到达的 seq 及其到达时刻和区间内收到的字节数，由上层定期经控制通道
+ *   发给设备端 UdpVideoSender，用于发送端的延迟梯度拥塞控制与发送节拍。
+ *
+ * 采集→接收延迟：
+ *   设置 ClockSync 后，每帧收齐时把 PTS（设备采集时刻）换算到客户端时钟，
+ *   与收齐时刻相减得到该帧的采集→接收延迟，上报 PerformanceMonitor。
+ *
+ * 接收后端：
+ *   Linux 优先使用 UdpBatchReceiver（epoll 线程 + recvmmsg 批量 + UDP_GRO），
+ *   其他平台或原生套接字创建失败时回退到 QUdpSocket + IO 线程。
  */
 
 #ifndef UDP_VIDEO_CLIENT_H
@@ -25,10 +51,17 @@
 #include <QMutex>
 #include <QWaitCondition>
 #include <QHostAddress>
+#include <QElapsedTimer>
 #include <atomic>
+#include <memory>
 
+#include "BandwidthEstimator.h"
+#include "ClockSync.h"
 #include "KcpClient.h"  // CircularBuffer
 
+namespace fec { class SeqFecDecoder; }
+class UdpBatchReceiver;
+
 /**
  * @brief 裸 UDP 视频接收器（帧级重组）
  *
@@ -50,11 +83,39 @@ public:
     static constexpr uint8_t FLAG_SOF = 0x01;   // Start of Frame
     static constexpr uint8_t FLAG_EOF = 0x02;   // End of Frame
 
+    // 帧元数据头（ptsAndFlags(8) + size(4)），首字节高两位为 config/keyframe 标志
+    static constexpr int FRAME_META_SIZE = 12;
+    static constexpr uint8_t META_FLAG_CONFIG = 0x80;
+    static constexpr uint8_t META_FLAG_KEY_FRAME = 0x40;
+
     // 缓冲区下限（低码率时的保底值）
     static constexpr int MIN_RING_BUFFER   = 4 * 1024 * 1024;   // 4MB
     static constexpr int MIN_RECV_BUFFER   = 2 * 1024 * 1024;   // 2MB
     static constexpr int MIN_FRAME_BUFFER  = 1024 * 1024;         // 1MB
 
+    // 带宽估计更新间隔
+    static constexpr int BWE_UPDATE_INTERVAL_MS = 50;
+
+    /**
+     * @brief 丢包回报（两次 takeLossReport() 之间的增量）
+     */
+    struct LossReport {
+        quint16 lossPermille = 0;   // 原始丢包率（FEC 恢复前，千分比）
+        quint8 avgBurstX10 = 0;     // 平均突发丢包长度 ×10
+        quint8 maxBurst = 0;        // 最大突发丢包长度
+        quint16 recovered = 0;      // FEC 恢复的包数
+        quint16 unrecovered = 0;    // FEC 未能恢复的包数
+    };
+
+    /**
+     * @brief 传输反馈（两次 takeTransportFeedback() 之间）
+     */
+    struct TransportFeedback {
+        quint32 seq = 0;            // 最新按序到达的 seq
+        quint32 recvTimeUs = 0;     // 该包到达时刻（ClockSync::nowUs() 低 32 位）
+        quint32 recvBytes = 0;      // 区间内收到的字节数（含校验包），0 表示没有新数据
+    };
+
     explicit UdpVideoClient(QObject *parent = nullptr);
     ~UdpVideoClient() override;
 
@@ -69,6 +130,36 @@ public:
      */
     void configure(quint32 bitrateBps, quint32 maxFps);
 
+    /**
+     * @brief 启用视频 FEC 解码（须在 bind() 之前调用，与服务端 video_fec 参数一致）
+     */
+    void setFecEnabled(bool enabled);
+
+    /**
+     * @brief 取出自上次调用以来的丢包统计（任意线程）
+     */
+    LossReport takeLossReport();
+
+    /**
+     * @brief 取出自上次调用以来的传输反馈（任意线程）
+     */
+    TransportFeedback takeTransportFeedback();
+
+    /**
+     * @brief 接收端估计的目标码率（bps，任意线程；收到数据前为 configure() 的码率）
+     */
+    quint32 targetBitrate() const { return m_targetBitrate.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 设置设备时钟同步（任意线程，可随时替换/清除）
+     */
+    void setClockSync(std::shared_ptr<const qsc::ClockSync> clockSync);
+
+    /**
+     * @brief 最近一帧的采集→接收延迟（微秒，任意线程；时钟未同步时为 -1）
+     */
+    qint64 captureLatencyUs() const { return m_captureLatencyUs.load(std::memory_order_relaxed); }
+
     /**
      * @brief 绑定本地端口（服务端将向此端口发送 UDP）
      */
@@ -121,19 +212,33 @@ signals:
     void disconnected();
     void errorOccurred(const QString &error);
 
+    /**
+     * @brief 出现无法恢复的丢帧，需要关键帧（IO 线程发出，丢弃依赖帧期间会重复发出）
+     */
+    void keyFrameNeeded();
+
 private slots:
     void onSocketReadyRead();
 
 private:
     void ensureIoThread();
+    void handleDatagram(const char *data, int size, bool &committed);
+    void processPacket(uint32_t seq, uint8_t flags, const char *payload, int payloadSize, bool &committed);
     void commitFrame();
+    void dropFrame();
+    void updateBandwidthEstimate();
+    void updateCaptureLatency(int64_t ptsUs);
+    int recvBufferSizeFor(quint32 bitrateBps) const;
 
 private:
     QUdpSocket *m_socket = nullptr;
 
-    // 独立 IO 线程：UDP 收包在此线程运行
+    // 独立 IO 线程：UDP 收包在此线程运行（QUdpSocket 回退路径）
     QThread *m_ioThread = nullptr;
 
+    // Linux 批量接收后端（非空时替代 m_socket/m_ioThread 收包）
+    std::unique_ptr<UdpBatchReceiver> m_batchReceiver;
+
     // 环形缓冲区（复用 KcpClient.h 中的 CircularBuffer）
     CircularBuffer m_ringBuffer;
     mutable QMutex m_mutex;
@@ -143,6 +248,7 @@ private:
     int m_ringBufferSize = MIN_RING_BUFFER;
     int m_recvBufferSize = MIN_RECV_BUFFER;
     int m_frameBufferSize = MIN_FRAME_BUFFER;
+    quint32 m_maxFps = 60;
 
     // 状态
     std::atomic<bool> m_active{false};
@@ -158,13 +264,44 @@ private:
     char *m_frameBuffer = nullptr;    // 帧重组缓冲区
     int m_frameLen = 0;               // 当前已累积字节数
     uint32_t m_lastSeq = 0;           // 当前帧的上一个 seq
+    bool m_awaitingKeyFrame = false;  // 丢帧后等待关键帧，期间丢弃依赖帧
+    qint64 m_frameStartMs = 0;        // 当前帧首包到达时间
+
+    // 带宽估计（仅 IO 线程访问估计器）
+    BandwidthEstimator m_bwe;
+    QElapsedTimer m_clock;
+    qint64 m_lastBweUpdate = 0;
+    int m_appliedRecvBuffer = 0;      // 已按目标码率设置的 OS 接收缓冲
+    std::atomic<quint32> m_targetBitrate{0};
+
+    // 时钟同步（控制线程写，IO 线程经 std::atomic_load 读取）
+    std::shared_ptr<const qsc::ClockSync> m_clockSync;
+    std::atomic<qint64> m_captureLatencyUs{-1};
+
+    // 视频 FEC（仅 IO 线程访问解码器）
+    std::atomic<bool> m_fecEnabled{false};
+    std::unique_ptr<fec::SeqFecDecoder> m_seqFec;
 
     // 统计
     std::atomic<uint64_t> m_totalRecv{0};
     std::atomic<uint64_t> m_totalPackets{0};
     std::atomic<uint64_t> m_gapCount{0};
+    std::atomic<uint64_t> m_latePackets{0};     // 迟到 / 乱序包（已按缺口计过一次，不再计丢包）
     std::atomic<uint64_t> m_droppedFrames{0};
     std::atomic<uint64_t> m_completedFrames{0};
+    std::atomic<uint64_t> m_skippedFrames{0};   // 等待关键帧期间丢弃的依赖帧
+
+    // 丢包回报增量（takeLossReport() 时清零）
+    std::atomic<uint32_t> m_reportPackets{0};
+    std::atomic<uint32_t> m_reportLost{0};
+    std::atomic<uint32_t> m_reportBursts{0};
+    std::atomic<uint32_t> m_reportMaxBurst{0};
+    uint64_t m_lastRecovered = 0;
+    uint64_t m_lastUnrecovered = 0;
+
+    // 传输反馈：seq(高 32 位) | 到达时刻(低 32 位) 一并发布，字节数在 takeTransportFeedback() 时清零
+    std::atomic<uint64_t> m_feedbackLatest{0};
+    std::atomic<uint32_t> m_feedbackBytes{0};
 };
 
 #endif // UDP_VIDEO_CLIENT_H
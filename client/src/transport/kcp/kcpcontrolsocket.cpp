@@ -42,6 +42,13 @@ void KcpControlSocket::connectToHost(const QHostAddress &host, quint16 port)
     }
 }
 
+void KcpControlSocket::setFec(int dataShards, int parityShards)
+{
+    if (m_client) {
+        m_client->setFec(dataShards, parityShards);
+    }
+}
+
 bool KcpControlSocket::isValid() const
 {
     return m_client && m_client->isActive();
@@ -61,6 +68,30 @@ qint64 KcpControlSocket::write(const QByteArray &data)
     return write(data.constData(), data.size());
 }
 
+void KcpControlSocket::setMoveLaneCopies(int copies)
+{
+    m_moveLaneCopies = qBound(0, copies, MAX_MOVE_LANE_COPIES);
+}
+
+qint64 KcpControlSocket::writeUnreliable(const char *data, qint64 len)
+{
+    if (!m_client || m_moveLaneCopies <= 0 || len <= 0 || len > 63) {
+        return -1;
+    }
+    char buf[64];
+    buf[0] = static_cast<char>(MOVE_LANE_MARKER);
+    memcpy(buf + 1, data, static_cast<size_t>(len));
+
+    // 重复份数背靠背发出：任一份到达即可，服务端按序号去重
+    bool sent = false;
+    for (int i = 0; i < m_moveLaneCopies; ++i) {
+        if (m_client->sendDatagram(buf, static_cast<int>(len) + 1) > 0) {
+            sent = true;
+        }
+    }
+    return sent ? len : -1;
+}
+
 QByteArray KcpControlSocket::readAll()
 {
     // P-KCP: move 语义避免 COW detach 拷贝
@@ -33,6 +33,9 @@ public:
     static constexpr quint32 KCP_CONV_CONTROL = 0x22334455;
     static constexpr int UPDATE_INTERVAL_MS = 5;  // 极致低延迟：5ms
     static constexpr int MAX_RECV_BUFFER = 64 * 1024;
+    // 不可靠通道数据报首字节，须与 server 端 KcpConfig.MOVE_LANE_MARKER 一致
+    static constexpr quint8 MOVE_LANE_MARKER = 0xE7;
+    static constexpr int MAX_MOVE_LANE_COPIES = 3;
 
     explicit KcpControlSocket(QObject *parent = nullptr);
     virtual ~KcpControlSocket();
@@ -57,6 +60,11 @@ public:
      */
     void connectToHost(const QHostAddress &host, quint16 port);
 
+    /**
+     * @brief 启用控制通道 FEC (k 个数据包 + m 个校验包)
+     */
+    void setFec(int dataShards, int parityShards);
+
     /**
      * @brief 是否有效
      */
@@ -68,6 +76,17 @@ public:
     qint64 write(const char *data, qint64 len);
     qint64 write(const QByteArray &data);
 
+    /**
+     * @brief 触摸 MOVE 不可靠通道：每条消息发送的份数，0 = 关闭（MOVE 走可靠通道）
+     */
+    void setMoveLaneCopies(int copies);
+    int moveLaneCopies() const { return m_moveLaneCopies; }
+
+    /**
+     * @brief 经不可靠通道发送一条消息（加 MOVE_LANE_MARKER 前缀，按 moveLaneCopies 重复发送）
+     */
+    qint64 writeUnreliable(const char *data, qint64 len);
+
     /**
      * @brief 读取所有可用数据
      */
@@ -95,6 +114,7 @@ private slots:
 private:
     KcpControlClient *m_client = nullptr;
     QByteArray m_readBuffer;
+    int m_moveLaneCopies = 0;
 };
 
 #endif // KCPCONTROLSOCKET_H
@@ -110,6 +110,13 @@ bool KcpServer::execute()
     args << QString("use_kcp=true");
     args << QString("kcp_port=%1").arg(m_params.kcpPort);
     args << QString("kcp_control_port=%1").arg(m_params.kcpPort + 1);
+    // FEC 协商：仅启用时下发，旧 server 忽略未知参数，双方格式保持一致
+    if (m_params.kcpFecData > 0 && m_params.kcpFecParity > 0) {
+        args << QString("kcp_fec=%1:%2").arg(m_params.kcpFecData).arg(m_params.kcpFecParity);
+    }
+    if (m_params.videoFec) {
+        args << QString("video_fec=true");
+    }
 
     QString deviceIp = m_params.serial.split(':').first();
     QString clientIp = findClientIpInSameSubnet(deviceIp);
@@ -198,10 +205,15 @@ bool KcpServer::startServerByStep()
     return stepSuccess;
 }
 
-QString KcpServer::findClientIpInSameSubnet(const QString &deviceIp) const
+QString KcpServer::findClientIpInSameSubnet(const QString &deviceIp)
 {
     QString clientIp;
 
+    // 同机的设备替身 / 模拟器
+    if (QHostAddress(deviceIp).isLoopback()) {
+        return deviceIp;
+    }
+
     for (const QNetworkInterface &iface : QNetworkInterface::allInterfaces()) {
         if (iface.flags() & QNetworkInterface::IsUp &&
             iface.flags() & QNetworkInterface::IsRunning &&
@@ -255,6 +267,7 @@ void KcpServer::setupKcpSockets()
     // 创建 KCP video socket
     m_kcpVideoSocket = new KcpVideoSocket(nullptr);
     m_kcpVideoSocket->setBitrate(m_params.bitRate, m_params.maxFps);
+    m_kcpVideoSocket->setFecEnabled(m_params.videoFec);
     if (!m_kcpVideoSocket->bind(m_params.kcpPort)) {
         qCritical() << "Failed to bind KCP video socket to port" << m_params.kcpPort;
         delete m_kcpVideoSocket;
@@ -265,7 +278,14 @@ void KcpServer::setupKcpSockets()
 
     // 创建 KCP control socket
     m_kcpControlSocket = new KcpControlSocket(this);
-    if (!m_kcpControlSocket->bind(m_params.kcpPort + 1)) {
+    if (m_params.kcpFecData > 0 && m_params.kcpFecParity > 0) {
+        m_kcpControlSocket->setFec(m_params.kcpFecData, m_params.kcpFecParity);
+    }
+    m_kcpControlSocket->setMoveLaneCopies(m_params.moveLaneCopies);
+    // 真机回包固定发往 client_ip:kcp_control_port，端口被占用必须直接报错；
+    // 同机设备替身已绑定同一端口，仅此时改用临时端口，替身从首个包学习客户端地址
+    if (!m_kcpControlSocket->bind(m_params.kcpPort + 1)
+        && !(m_params.localStandin && m_kcpControlSocket->bind(0))) {
         qCritical() << "Failed to bind KCP control socket to port" << (m_params.kcpPort + 1);
         emit serverStarted(false);
         return;
@@ -53,6 +53,11 @@ public:
         QString crop = "";
         bool control = true;
         quint16 kcpPort = 27185;          // KCP UDP 视频端口 (控制端口 = kcpPort + 1)
+        quint8 kcpFecData = 0;            // KCP FEC k (0 = 关闭，通过 kcp_fec=k:m 下发给 server)
+        quint8 kcpFecParity = 0;          // KCP FEC m (1 = XOR，>1 = Reed-Solomon)
+        bool videoFec = true;             // UDP 视频自适应 FEC（video_fec=true 下发给 server）
+        quint8 moveLaneCopies = 2;        // 触摸 MOVE 不可靠通道份数（纯客户端设置，server 始终接受）
+        bool localStandin = false;        // 同机设备替身：控制端口被占用时改用临时端口（真机会话保持绑定失败即报错）
         qint32 scid = -1;
     };
 
@@ -67,6 +72,11 @@ public:
     KcpVideoSocket *removeKcpVideoSocket();
     KcpControlSocket *getKcpControlSocket();
 
+    /**
+     * @brief 本机与设备同网段的 IPv4 地址（作为 client_ip 下发），设备为回环地址时返回回环地址
+     */
+    static QString findClientIpInSameSubnet(const QString &deviceIp);
+
 signals:
     void serverStarted(bool success, const QString &deviceName = "", const QSize &size = QSize());
     void serverStoped();
@@ -86,8 +96,6 @@ private:
     void startWaitTimer();
     void stopWaitTimer();
 
-    QString findClientIpInSameSubnet(const QString &deviceIp) const;
-
 private slots:
     void onWorkProcessResult(qsc::AdbProcess::ADB_EXEC_RESULT processResult);
 
@@ -13,6 +13,7 @@ KcpVideoSocket::KcpVideoSocket(QObject *parent)
     connect(m_client, &UdpVideoClient::connected, this, &KcpVideoSocket::connected);
     connect(m_client, &UdpVideoClient::disconnected, this, &KcpVideoSocket::disconnected);
     connect(m_client, &UdpVideoClient::errorOccurred, this, &KcpVideoSocket::errorOccurred);
+    connect(m_client, &UdpVideoClient::keyFrameNeeded, this, &KcpVideoSocket::keyFrameNeeded);
 }
 
 KcpVideoSocket::~KcpVideoSocket()
@@ -27,6 +28,35 @@ void KcpVideoSocket::setBitrate(quint32 bitrateBps, quint32 maxFps)
     }
 }
 
+void KcpVideoSocket::setFecEnabled(bool enabled)
+{
+    if (m_client) {
+        m_client->setFecEnabled(enabled);
+    }
+}
+
+UdpVideoClient::LossReport KcpVideoSocket::takeLossReport()
+{
+    return m_client ? m_client->takeLossReport() : UdpVideoClient::LossReport();
+}
+
+UdpVideoClient::TransportFeedback KcpVideoSocket::takeTransportFeedback()
+{
+    return m_client ? m_client->takeTransportFeedback() : UdpVideoClient::TransportFeedback();
+}
+
+quint32 KcpVideoSocket::targetBitrate() const
+{
+    return m_client ? m_client->targetBitrate() : 0;
+}
+
+void KcpVideoSocket::setClockSync(std::shared_ptr<const qsc::ClockSync> clockSync)
+{
+    if (m_client) {
+        m_client->setClockSync(std::move(clockSync));
+    }
+}
+
 bool KcpVideoSocket::bind(quint16 port)
 {
     return m_client ? m_client->bind(port) : false;
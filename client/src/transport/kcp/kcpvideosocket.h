@@ -16,8 +16,7 @@
 #include <QString>
 #include <atomic>
 
-// 前向声明
-class UdpVideoClient;
+#include "UdpVideoClient.h"
 
 /**
  * @brief UDP 视频 Socket - 兼容旧接口的封装 / UDP Video Socket - Legacy-Compatible Wrapper
@@ -41,6 +40,31 @@ public:
      */
     void setBitrate(quint32 bitrateBps, quint32 maxFps = 60);
 
+    /**
+     * @brief 启用视频 FEC 解码（须在 bind() 之前调用）
+     */
+    void setFecEnabled(bool enabled);
+
+    /**
+     * @brief 取出丢包统计增量（用于向服务端回报）
+     */
+    UdpVideoClient::LossReport takeLossReport();
+
+    /**
+     * @brief 取出传输反馈（用于服务端拥塞控制）
+     */
+    UdpVideoClient::TransportFeedback takeTransportFeedback();
+
+    /**
+     * @brief 接收端估计的目标码率（bps，用于向服务端回报）
+     */
+    quint32 targetBitrate() const;
+
+    /**
+     * @brief 设置设备时钟同步，用于计算每帧采集→接收延迟
+     */
+    void setClockSync(std::shared_ptr<const qsc::ClockSync> clockSync);
+
     /**
      * @brief 绑定本地端口
      */
@@ -91,6 +115,7 @@ signals:
     void connected();
     void disconnected();
     void errorOccurred(const QString &error);
+    void keyFrameNeeded();   // 视频帧无法恢复，需请求关键帧
 
 private:
     UdpVideoClient *m_client = nullptr;
@@ -1,18 +1,29 @@
 #include <QDebug>
 #include <QRegularExpression>
+#include <QTimer>
+#include <QTcpSocket>
 
 #include "devicemanage.h"
 #include "demuxer.h"
 #include "server.h"
 #include "kcpvideosocket.h"
 #include "kcpcontrolsocket.h"
+#include "fastmsg.h"
 #include "videosocket.h"
 #include "adbprocess.h"
+#include "devicemsg.h"
+#include "ClockSync.h"
+#include "multipathcontrol.h"
+#include "controlsocketwriter.h"
+#include "groupbroadcaster.h"
+#include "ConfigCenter.h"
+#include "PerformanceMonitor.h"
 
 // 新架构
 #include "service/DeviceSession.h"
 #include "service/ZeroCopyStreamManager.h"
 #include "service/InputManager.h"
+#include "service/LatencyProbe.h"
 #include "infra/FrameData.h"
 #include "infra/SessionParams.h"
 
@@ -79,6 +90,28 @@ DeviceController::DeviceController(const DeviceParams& params, QObject* parent)
         }
     }, Qt::DirectConnection);
 
+    // 点击→画面延迟探测：在解码线程比较区域亮度，触摸经 InputManager 的正常发送路径写出
+    const int probeTrials = ConfigCenter::instance().latencyProbeTrials();
+    if (probeTrials > 0) {
+        core::LatencyProbe::Options probeOptions;
+        probeOptions.trials = probeTrials;
+        probeOptions.touch = ConfigCenter::instance().latencyProbeTouch();
+        probeOptions.region = ConfigCenter::instance().latencyProbeRegion();
+        probeOptions.threshold = ConfigCenter::instance().latencyProbeThreshold();
+        m_latencyProbe = std::make_unique<core::LatencyProbe>(probeOptions,
+            [this](const QByteArray& msg, std::shared_ptr<std::atomic<qint64>> sentUs) {
+                if (m_session && m_session->inputManager()) {
+                    m_session->inputManager()->postFastMsg(msg, std::move(sentUs));
+                }
+            });
+        core::LatencyProbe* probe = m_latencyProbe.get();
+        m_streamManager->setFrameObserver([probe](const core::FrameData& frame) { probe->onFrame(frame); });
+    }
+
+    // 解码出错时请求服务端立即输出关键帧
+    connect(m_streamManager.get(), &core::ZeroCopyStreamManager::keyFrameRequested,
+            this, &DeviceController::requestKeyFrame);
+
     connect(m_streamManager.get(), &core::ZeroCopyStreamManager::streamStopped, this, [this]() {
         qDebug() << "[DeviceController] Stream stopped";
         stop();
@@ -90,6 +123,26 @@ DeviceController::DeviceController(const DeviceParams& params, QObject* parent)
     connect(m_server, &Server::serverStarted, this, &DeviceController::onServerStart);
     connect(m_server, &Server::serverStoped, this, &DeviceController::onServerStop);
 
+    // 视频 FEC 丢包回报定时器
+    m_fecReportTimer = new QTimer(this);
+    m_fecReportTimer->setInterval(1000);
+    connect(m_fecReportTimer, &QTimer::timeout, this, &DeviceController::onFecReportTimer);
+
+    // 目标码率回报定时器（每秒约 5 次）
+    m_bitrateFeedbackTimer = new QTimer(this);
+    m_bitrateFeedbackTimer->setInterval(200);
+    connect(m_bitrateFeedbackTimer, &QTimer::timeout, this, &DeviceController::onBitrateFeedbackTimer);
+
+    // 视频传输反馈定时器
+    m_videoFeedbackTimer = new QTimer(this);
+    m_videoFeedbackTimer->setInterval(VIDEO_FEEDBACK_INTERVAL_MS);
+    connect(m_videoFeedbackTimer, &QTimer::timeout, this, &DeviceController::onVideoFeedbackTimer);
+
+    // 时钟同步（NTP 式 PING/PONG，USB 和 WiFi 模式均可用）
+    m_clockSync = std::make_shared<ClockSync>();
+    m_clockSyncTimer = new QTimer(this);
+    connect(m_clockSyncTimer, &QTimer::timeout, this, &DeviceController::onClockSyncTimer);
+
     qInfo("[DeviceController] Created for %s", qPrintable(params.serial));
 }
 
@@ -124,6 +177,12 @@ bool DeviceController::start()
     serverParams.localPortCtrl = m_params.localPortCtrl;
     serverParams.useReverse = m_params.useReverse;
     serverParams.kcpPort = m_params.kcpPort;
+    serverParams.kcpFecData = m_params.kcpFecData;
+    serverParams.kcpFecParity = m_params.kcpFecParity;
+    serverParams.videoFec = m_params.videoFec;
+    serverParams.moveLaneCopies = m_params.moveLaneCopies;
+    serverParams.multipathIp = m_params.multipathIp;
+    serverParams.localStandin = qEnvironmentVariableIntValue("KZSCRCPY_LOCAL_STANDIN") != 0;
     serverParams.scid = m_params.scid;
 
     return m_server->start(serverParams);
@@ -131,9 +190,28 @@ bool DeviceController::start()
 
 void DeviceController::stop()
 {
+    emit aboutToStop(m_params.serial);
+    if (m_latencyProbe) {
+        m_latencyProbe->stop();
+    }
+    if (m_fecReportTimer) {
+        m_fecReportTimer->stop();
+    }
+    if (m_bitrateFeedbackTimer) {
+        m_bitrateFeedbackTimer->stop();
+    }
+    if (m_videoFeedbackTimer) {
+        m_videoFeedbackTimer->stop();
+    }
+    if (m_clockSyncTimer) {
+        m_clockSyncTimer->stop();
+    }
+    // 先停会话（输入线程模式下等输入线程退出），再释放它写入用的多路径/直写器
     if (m_session) {
         m_session->stop();
     }
+    m_multipath.reset();
+    m_controlWriter.reset();
     if (m_streamManager) {
         m_streamManager->stop();
     }
@@ -174,6 +252,16 @@ void DeviceController::onServerStart(bool success, const QString& deviceName, co
         if (kcpSocket) {
             m_streamManager->installKcpVideoSocket(kcpSocket);
             qDebug() << "[DeviceController] Installed KCP video socket";
+
+            m_kcpVideoSocket = kcpSocket;
+            connect(kcpSocket, &KcpVideoSocket::keyFrameNeeded, this, &DeviceController::requestKeyFrame);
+            if (m_params.videoFec) {
+                m_fecReportTimer->start();
+            }
+            m_lastSentBitrate = 0;
+            m_bitrateFeedbackTimer->start();
+            m_videoFeedbackTimer->start();
+            kcpSocket->setClockSync(m_clockSync);
         }
     } else {
         auto* tcpSocket = m_server->removeVideoSocket();
@@ -183,6 +271,38 @@ void DeviceController::onServerStart(bool success, const QString& deviceName, co
         }
     }
 
+    // 设备消息（PONG 等）读取 + 时钟同步
+    m_deviceMsgBuffer.clear();
+    m_pathMsgBuffer.clear();
+    m_multipath.reset();
+    m_controlWriter.reset();
+    if (m_server->isWiFiMode()) {
+        if (auto* controlSocket = m_server->getKcpControlSocket()) {
+            connect(controlSocket, &KcpControlSocket::readyRead,
+                    this, &DeviceController::onControlReadyRead, Qt::UniqueConnection);
+        }
+    } else if (auto* controlSocket = m_server->getControlSocket()) {
+        connect(controlSocket, &QTcpSocket::readyRead,
+                this, &DeviceController::onControlReadyRead, Qt::UniqueConnection);
+        if (ConfigCenter::instance().inputThread() || ConfigCenter::instance().groupControl()) {
+            // 输入线程 / 群控发送线程与本线程都要写控制通道，QTcpSocket 不能跨线程写：改为直写描述符
+            controlSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            controlSocket->flush();
+            m_controlWriter = std::make_unique<ControlSocketWriter>(controlSocket->socketDescriptor());
+        }
+        if (auto* pathSocket = m_server->getPathControlSocket()) {
+            m_multipath = std::make_unique<MultipathControl>(controlSocket, pathSocket);
+            m_multipath->setUsbWriter(m_controlWriter.get());
+            m_multipath->setDuplicateCritical(m_params.multipathDuplicate);
+            connect(pathSocket, &KcpControlSocket::readyRead,
+                    this, &DeviceController::onPathControlReadyRead, Qt::UniqueConnection);
+            qInfo("[DeviceController] Multipath control: USB + WiFi (%s)", qPrintable(m_params.multipathIp));
+        }
+    }
+    m_clockSync->reset();
+    m_clockSyncPings = 0;
+    m_clockSyncTimer->start(m_multipath ? MULTIPATH_PROBE_INTERVAL_MS : 200);
+
     // 启动流管线
     if (!m_streamManager->start()) {
         qWarning() << "[DeviceController] Failed to start stream manager";
@@ -193,25 +313,25 @@ void DeviceController::onServerStart(bool success, const QString& deviceName, co
         auto* inputMgr = m_session->inputManager();
 
         auto sendCallback = [this](const QByteArray& data) -> qint64 {
-            if (m_server->isWiFiMode() && m_server->getKcpControlSocket()) {
-                return m_server->getKcpControlSocket()->write(data);
-            } else if (m_server->getControlSocket()) {
-                return m_server->getControlSocket()->write(data);
-            }
-            return -1;
+            return writeControl(data);
         };
 
         inputMgr->initialize(sendCallback, m_params.gameScript);
 
         if (m_server->isWiFiMode()) {
             inputMgr->setKcpControlSocket(m_server->getKcpControlSocket());
-        } else {
+        } else if (!m_multipath && !m_controlWriter) {
             inputMgr->setTcpControlSocket(m_server->getControlSocket());
         }
+        // 多路径 / 输入线程模式保留 sendCallback（writeControl → MultipathControl 选路、ControlSocketWriter 直写）
 
         inputMgr->start();
         qDebug() << "[DeviceController] InputManager started";
 
+        if (m_latencyProbe) {
+            m_latencyProbe->start();
+        }
+
         // 异步获取手机分辨率
         if (m_adbSizeProcess) {
             QStringList args;
@@ -223,6 +343,167 @@ void DeviceController::onServerStart(bool success, const QString& deviceName, co
     emit connected(true, m_params.serial, deviceName, size);
 }
 
+void DeviceController::onFecReportTimer()
+{
+    if (!m_kcpVideoSocket || !m_server || !m_server->getKcpControlSocket()) {
+        return;
+    }
+
+    UdpVideoClient::LossReport report = m_kcpVideoSocket->takeLossReport();
+    m_server->getKcpControlSocket()->write(FastMsg::fecReport(report.lossPermille, report.avgBurstX10,
+                                                              report.maxBurst, report.recovered,
+                                                              report.unrecovered));
+}
+
+void DeviceController::onBitrateFeedbackTimer()
+{
+    if (!m_kcpVideoSocket || !m_server || !m_server->getKcpControlSocket()) {
+        return;
+    }
+
+    const quint32 target = m_kcpVideoSocket->targetBitrate();
+    if (target == 0) {
+        return;
+    }
+    // 小幅波动不发送，避免编码器频繁调整；定期重发防止控制包丢失后编码器一直停在旧值
+    const bool changed = m_lastSentBitrate == 0
+                         || qAbs(static_cast<qint64>(target) - static_cast<qint64>(m_lastSentBitrate)) * 20
+                                >= static_cast<qint64>(m_lastSentBitrate);
+    if (!changed && m_bitrateFeedbackClock.isValid() && m_bitrateFeedbackClock.elapsed() < 1000) {
+        return;
+    }
+    m_server->getKcpControlSocket()->write(FastMsg::bitrateTarget(target));
+    m_lastSentBitrate = target;
+    m_bitrateFeedbackClock.start();
+}
+
+void DeviceController::onVideoFeedbackTimer()
+{
+    if (!m_kcpVideoSocket || !m_server || !m_server->getKcpControlSocket()) {
+        return;
+    }
+
+    const UdpVideoClient::TransportFeedback feedback = m_kcpVideoSocket->takeTransportFeedback();
+    if (feedback.recvBytes == 0) {
+        return;
+    }
+    m_server->getKcpControlSocket()->write(FastMsg::videoFeedback(feedback.seq, feedback.recvTimeUs,
+                                                                  feedback.recvBytes));
+}
+
+void DeviceController::onClockSyncTimer()
+{
+    if (m_multipath) {
+        // 每条路径各发一个 PING，PONG 同时用于选路和时钟同步（ClockSync 只取 RTT 最小的样本）
+        m_multipath->sendProbes(ClockSync::nowUs());
+        return;
+    }
+    // 发送前一刻打时间戳，尽量不把本地排队算进上行
+    if (writeControl(FastMsg::ping(ClockSync::nowUs())) < 0) {
+        return;
+    }
+    if (++m_clockSyncPings == CLOCK_SYNC_FAST_PINGS) {
+        m_clockSyncTimer->setInterval(1000);
+    }
+}
+
+void DeviceController::onControlReadyRead()
+{
+    // 到达即记 t3，解析耗时不计入 RTT
+    const qint64 recvUs = ClockSync::nowUs();
+    if (!m_server) {
+        return;
+    }
+    if (m_server->isWiFiMode()) {
+        if (m_server->getKcpControlSocket()) {
+            m_deviceMsgBuffer.append(m_server->getKcpControlSocket()->readAll());
+        }
+    } else if (m_server->getControlSocket()) {
+        m_deviceMsgBuffer.append(m_server->getControlSocket()->readAll());
+    }
+    parseDeviceMessages(m_deviceMsgBuffer, MultipathControl::PATH_USB, recvUs);
+}
+
+void DeviceController::onPathControlReadyRead()
+{
+    const qint64 recvUs = ClockSync::nowUs();
+    if (!m_server || !m_server->getPathControlSocket()) {
+        return;
+    }
+    m_pathMsgBuffer.append(m_server->getPathControlSocket()->readAll());
+    parseDeviceMessages(m_pathMsgBuffer, MultipathControl::PATH_WIFI, recvUs);
+}
+
+void DeviceController::parseDeviceMessages(QByteArray& buffer, int path, qint64 recvUs)
+{
+    while (!buffer.isEmpty()) {
+        DeviceMsg msg;
+        const qint32 consumed = msg.deserialize(buffer);
+        if (consumed == 0) {
+            break;
+        }
+        if (consumed < 0) {
+            qWarning() << "[DeviceController] Invalid device message, dropping" << buffer.size() << "bytes";
+            buffer.clear();
+            break;
+        }
+        if (msg.type() == DeviceMsg::DMT_PONG) {
+            if (m_multipath) {
+                m_multipath->onPong(path, msg.pongClientTime(), recvUs);
+            }
+            m_clockSync->addSample(msg.pongClientTime(), msg.pongDeviceRecvTime(),
+                                   msg.pongDeviceSendTime(), recvUs);
+            const ClockSync::Estimate estimate = m_clockSync->estimate();
+            if (estimate.valid) {
+                PerformanceMonitor::instance().reportNetworkLatency(estimate.lastRttUs / 2000.0);
+                PerformanceMonitor::instance().reportClockSync(estimate.offsetUs / 1000.0, estimate.drift * 1e6);
+            }
+        }
+        buffer.remove(0, consumed);
+    }
+}
+
+void DeviceController::requestKeyFrame()
+{
+    // 约一个 RTT 内重复请求无意义（服务端编码器会合并），限频 250ms
+    static constexpr qint64 MIN_INTERVAL_MS = 250;
+    if (m_keyFrameRequestTimer.isValid() && m_keyFrameRequestTimer.elapsed() < MIN_INTERVAL_MS) {
+        return;
+    }
+    if (!m_server) {
+        return;
+    }
+
+    if (writeControl(FastMsg::requestKeyFrame()) < 0) {
+        return;
+    }
+    m_keyFrameRequestTimer.start();
+    qDebug() << "[DeviceController] Requested key frame";
+}
+
+qint64 DeviceController::writeControl(const QByteArray& data)
+{
+    if (!m_server) {
+        return -1;
+    }
+    if (m_multipath) {
+        return m_multipath->write(data);
+    }
+    if (m_server->isWiFiMode() && m_server->getKcpControlSocket()) {
+        return m_server->getKcpControlSocket()->write(data);
+    } else if (m_controlWriter) {
+        return m_controlWriter->write(data);
+    } else if (m_server->getControlSocket()) {
+        return m_server->getControlSocket()->write(data);
+    }
+    return -1;
+}
+
+bool DeviceController::threadSafeControl() const
+{
+    return m_server && (m_server->isWiFiMode() || m_controlWriter);
+}
+
 void DeviceController::onServerStop()
 {
     qDebug() << "[DeviceController] Server stopped";
@@ -307,6 +588,7 @@ bool DeviceManage::connectDevice(DeviceParams params)
     auto* controller = new DeviceController(params, this);
     connect(controller, &DeviceController::connected, this, &DeviceManage::onDeviceConnected);
     connect(controller, &DeviceController::disconnected, this, &DeviceManage::onDeviceDisconnected);
+    connect(controller, &DeviceController::aboutToStop, this, &DeviceManage::onDeviceAboutToStop, Qt::DirectConnection);
 
     if (!controller->start()) {
         delete controller;
@@ -348,6 +630,28 @@ void DeviceManage::onDeviceConnected(bool success, const QString &serial, const
     emit deviceConnected(success, serial, deviceName, size);
     if (!success) {
         removeDevice(serial);
+        return;
+    }
+
+    // 自动群控：首台设备为主控，之后的设备加入
+    if (ConfigCenter::instance().groupControl()) {
+        if (!m_group) {
+            startGroupControl(serial, {});
+        } else if (serial != m_groupLeader) {
+            addGroupFollower(serial);
+        }
+    }
+}
+
+void DeviceManage::onDeviceAboutToStop(const QString& serial)
+{
+    if (!m_group) {
+        return;
+    }
+    if (serial == m_groupLeader) {
+        stopGroupControl();
+    } else {
+        m_group->removeFollower(serial);
     }
 }
 
@@ -357,6 +661,87 @@ void DeviceManage::onDeviceDisconnected(const QString& serial)
     removeDevice(serial);
 }
 
+// ---------------------------------------------------------
+// 群控
+// ---------------------------------------------------------
+bool DeviceManage::startGroupControl(const QString& leader, const QStringList& followers)
+{
+    auto* controller = m_devices.value(leader);
+    if (!controller || !controller->session() || !controller->session()->inputManager()) {
+        qWarning("[GroupControl] Leader %s not connected", qPrintable(leader));
+        return false;
+    }
+    stopGroupControl();
+
+    m_group = std::make_shared<GroupBroadcaster>();
+    m_groupLeader = leader;
+    for (const QString& serial : followers) {
+        if (serial != leader) {
+            addGroupFollower(serial);
+        }
+    }
+    controller->session()->inputManager()->setGroupBroadcaster(m_group);
+
+    if (!m_groupStatsTimer) {
+        m_groupStatsTimer = new QTimer(this);
+        m_groupStatsTimer->setInterval(GROUP_STATS_INTERVAL_MS);
+        connect(m_groupStatsTimer, &QTimer::timeout, this, [this]() {
+            if (m_group && m_group->followerCount() > 0) {
+                qInfo().noquote() << "[GroupControl] Leader" << m_groupLeader << "\n" + m_group->stats(true).trimmed();
+            }
+        });
+    }
+    m_groupStatsTimer->start();
+    qInfo("[GroupControl] Started, leader %s, %d followers", qPrintable(leader), m_group->followerCount());
+    return true;
+}
+
+void DeviceManage::stopGroupControl()
+{
+    if (!m_group) {
+        return;
+    }
+    if (m_groupStatsTimer) {
+        m_groupStatsTimer->stop();
+    }
+    // 主控先停止发布（经输入线程投递），再停止各从设备发送线程
+    auto* controller = m_devices.value(m_groupLeader);
+    if (controller && controller->session() && controller->session()->inputManager()) {
+        controller->session()->inputManager()->setGroupBroadcaster(nullptr);
+    }
+    const QString stats = m_group->stats(false).trimmed();
+    if (!stats.isEmpty()) {
+        qInfo().noquote() << "[GroupControl] Final stats\n" + stats;
+    }
+    m_group->clear();
+    m_group.reset();
+    qInfo("[GroupControl] Stopped, leader %s", qPrintable(m_groupLeader));
+    m_groupLeader.clear();
+}
+
+bool DeviceManage::addGroupFollower(const QString& serial)
+{
+    auto* controller = m_devices.value(serial);
+    if (!m_group || !controller || serial == m_groupLeader) {
+        return false;
+    }
+    if (!controller->threadSafeControl()) {
+        qWarning("[GroupControl] %s control channel is not thread-safe (USB needs GroupControl=1 or InputThread=1 "
+                 "before connecting), skipped", qPrintable(serial));
+        return false;
+    }
+    const auto calibration = GroupBroadcaster::Calibration::fromRect(ConfigCenter::instance().groupCalibration(serial));
+    // 从设备停止前经 aboutToStop 移除（发送线程先退出），回调中的指针不会悬空
+    return m_group->addFollower(serial, [controller](const QByteArray& data) {
+        return controller->writeControl(data);
+    }, calibration);
+}
+
+QString DeviceManage::groupControlStats()
+{
+    return m_group ? m_group->stats(false) : QString();
+}
+
 quint16 DeviceManage::getFreePort()
 {
     quint16 port = m_localPortStart;
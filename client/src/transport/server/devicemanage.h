@@ -1,6 +1,7 @@
 #ifndef DEVICEMANAGE_H
 #define DEVICEMANAGE_H
 
+#include <QElapsedTimer>
 #include <QMap>
 #include <QPointer>
 #include <memory>
@@ -10,13 +11,21 @@
 
 // 前向声明
 class Server;
+class KcpVideoSocket;
+class ControlSocketWriter;
+class GroupBroadcaster;
+class QTimer;
 
 namespace qsc {
 namespace core {
 class DeviceSession;
 class ZeroCopyStreamManager;
+class LatencyProbe;
 }
 
+class ClockSync;
+class MultipathControl;
+
 /**
  * @brief 设备控制器 / Device Controller
  *
@@ -40,22 +49,74 @@ public:
     core::DeviceSession* session() const { return m_session.get(); }
     bool isReversePort(quint16 port) const;
 
+    /**
+     * @brief 写控制通道（多路径 / KCP / ControlSocketWriter / QTcpSocket 按连接方式选择）
+     */
+    qint64 writeControl(const QByteArray& data);
+    // writeControl() 可在其他线程调用（WiFi KCP 或 USB 直写器），群控从设备需要
+    bool threadSafeControl() const;
+
 signals:
     void connected(bool success, const QString& serial, const QString& deviceName, const QSize& size);
     void disconnected(const QString& serial);
+    // stop() 开始时发出（直连），控制通道尚可写；群控在此移除从设备的发送线程
+    void aboutToStop(const QString& serial);
 
 private slots:
     void onServerStart(bool success, const QString& deviceName, const QSize& size);
     void onServerStop();
     void onAdbSizeResult(AdbProcess::ADB_EXEC_RESULT processResult);
+    void onFecReportTimer();
+    void onBitrateFeedbackTimer();
+    void onVideoFeedbackTimer();
+    void onClockSyncTimer();
+    void onControlReadyRead();
+    void onPathControlReadyRead();
+    void requestKeyFrame();
+
+private:
+    void parseDeviceMessages(QByteArray& buffer, int path, qint64 recvUs);
 
 private:
     DeviceParams m_params;
     std::unique_ptr<core::DeviceSession> m_session;
+    // 点击→画面延迟探测（LatencyProbeTrials > 0 时创建）；解码线程经帧观察回调访问，须在流管线之后析构
+    std::unique_ptr<core::LatencyProbe> m_latencyProbe;
     std::unique_ptr<core::ZeroCopyStreamManager> m_streamManager;
     QPointer<Server> m_server;
     AdbProcess* m_adbSizeProcess = nullptr;
     QSize m_mobileSize;
+
+    // WiFi 模式视频丢包回报（每秒经 KCP 控制通道发给 server，驱动自适应 FEC）
+    QPointer<KcpVideoSocket> m_kcpVideoSocket;
+    QTimer* m_fecReportTimer = nullptr;
+
+    // 接收端带宽估计回报（目标码率变化 ≥5% 立即发送，否则每秒保活一次）
+    QTimer* m_bitrateFeedbackTimer = nullptr;
+    QElapsedTimer m_bitrateFeedbackClock;
+    quint32 m_lastSentBitrate = 0;
+
+    // 视频传输反馈（每 50ms 一次，驱动设备端 UdpVideoSender 的拥塞控制与发送节拍）
+    static constexpr int VIDEO_FEEDBACK_INTERVAL_MS = 50;
+    QTimer* m_videoFeedbackTimer = nullptr;
+
+    // 时钟同步：连接后前 CLOCK_SYNC_FAST_PINGS 次每 200ms 一次 PING 快速收敛，之后每秒一次
+    static constexpr int CLOCK_SYNC_FAST_PINGS = 8;
+    std::shared_ptr<ClockSync> m_clockSync;
+    QTimer* m_clockSyncTimer = nullptr;
+    int m_clockSyncPings = 0;
+    QByteArray m_deviceMsgBuffer;
+
+    // 多路径（USB + WiFi 控制通道）：探测 PING 兼作时钟同步，持续以固定间隔发送
+    static constexpr int MULTIPATH_PROBE_INTERVAL_MS = 250;
+    std::unique_ptr<MultipathControl> m_multipath;
+    QByteArray m_pathMsgBuffer;
+
+    // 输入线程 / 群控模式的 USB 控制通道写入（多线程共用，QTcpSocket 只负责读）
+    std::unique_ptr<ControlSocketWriter> m_controlWriter;
+
+    // 关键帧请求限频（丢帧期间每个依赖帧都会触发请求）
+    QElapsedTimer m_keyFrameRequestTimer;
 };
 
 /**
@@ -77,18 +138,30 @@ public:
     bool disconnectDevice(const QString &serial) override;
     void disconnectAllDevice() override;
     core::DeviceSession* getSession(const QString& serial) override;
+    bool startGroupControl(const QString& leader, const QStringList& followers) override;
+    void stopGroupControl() override;
+    bool addGroupFollower(const QString& serial) override;
+    QString groupControlStats() override;
 
 private slots:
     void onDeviceConnected(bool success, const QString& serial, const QString& deviceName, const QSize& size);
     void onDeviceDisconnected(const QString& serial);
+    void onDeviceAboutToStop(const QString& serial);
 
 private:
     quint16 getFreePort();
     void removeDevice(const QString& serial);
 
 private:
+    static constexpr int GROUP_STATS_INTERVAL_MS = 5000;
+
     QMap<QString, DeviceController*> m_devices;
     quint16 m_localPortStart = 27183;
+
+    // 群控：主控的 ControlSender 发布，从设备各自的发送线程写出
+    std::shared_ptr<GroupBroadcaster> m_group;
+    QString m_groupLeader;
+    QTimer* m_groupStatsTimer = nullptr;
 };
 
 }
@@ -0,0 +1,244 @@
+#include <QDebug>
+#include <limits>
+
+#include "multipathcontrol.h"
+#include "kcpcontrolsocket.h"
+#include "controlsocketwriter.h"
+#include "fastmsg.h"
+
+namespace qsc {
+
+MultipathControl::MultipathControl(QTcpSocket *usb, KcpControlSocket *wifi)
+    : m_usb(usb)
+    , m_wifi(wifi)
+{
+    refreshPathOpen();
+}
+
+const char *MultipathControl::pathName(int path)
+{
+    return path == PATH_USB ? "USB" : "WiFi";
+}
+
+qint64 MultipathControl::write(const QByteArray &data)
+{
+    bool writable[PATH_COUNT];
+    for (int path = 0; path < PATH_COUNT; ++path) {
+        writable[path] = isWritable(path);
+    }
+    int active = m_activePath.load(std::memory_order_relaxed);
+    if (!writable[active]) {
+        // 当前路径的 socket 已断开，不等下一轮探测，直接换到另一条
+        active = writable[PATH_USB] ? PATH_USB : PATH_WIFI;
+        if (!writable[active]) {
+            return -1;
+        }
+    }
+
+    // 关键消息在每条路径各包装一份；普通消息按原顺序留在当前路径上
+    const bool duplicate = m_duplicate.load(std::memory_order_relaxed);
+    QByteArray out[PATH_COUNT];
+    const char *p = data.constData();
+    int remaining = data.size();
+    while (remaining > 0) {
+        const int size = FastMsg::messageSize(p, remaining);
+        if (size == 0) {
+            // 原版 scrcpy 消息无法按 FastMsg 切分，剩余部分整体走当前路径
+            out[active].append(p, remaining);
+            break;
+        }
+        if (duplicate && isCritical(p, size)) {
+            char wrapped[5 + 2 + 6 * 255];
+            const quint32 seq = m_pathSeq.fetch_add(1, std::memory_order_relaxed) + 1;
+            const int wrappedSize = FastMsg::serializePathDupInto(wrapped, seq, p, size);
+            for (int path = 0; path < PATH_COUNT; ++path) {
+                if (writable[path]) {
+                    out[path].append(wrapped, wrappedSize);
+                }
+            }
+        } else {
+            out[active].append(p, size);
+        }
+        p += size;
+        remaining -= size;
+    }
+
+    qint64 result = -1;
+    for (int path = 0; path < PATH_COUNT; ++path) {
+        if (out[path].isEmpty()) {
+            continue;
+        }
+        const qint64 written = writePath(path, out[path]);
+        if (written < 0) {
+            // 不等下一轮探测：后续消息直接避开这条路径
+            m_pathOpen[path].store(false, std::memory_order_relaxed);
+        }
+        if (path == active) {
+            result = written == out[path].size() ? data.size() : -1;
+        }
+    }
+    return result;
+}
+
+void MultipathControl::sendProbes(qint64 nowUs)
+{
+    refreshPathOpen();
+    expireProbes(nowUs);
+
+    const QByteArray ping = FastMsg::ping(nowUs);
+    for (int path = 0; path < PATH_COUNT; ++path) {
+        if (!isWritable(path) || writePath(path, ping) != ping.size()) {
+            continue;
+        }
+        Probe &probe = m_probes[path][m_nextProbe[path]];
+        m_nextProbe[path] = (m_nextProbe[path] + 1) % MAX_PROBES;
+        if (probe.pending) {
+            // 环形缓冲区已满：最旧的探测还没回，按丢失处理
+            m_stats[path].loss = m_stats[path].loss * (1.0 - LOSS_ALPHA) + LOSS_ALPHA;
+        }
+        probe.sentUs = nowUs;
+        probe.pending = true;
+        m_stats[path].probes++;
+    }
+    updateActivePath();
+}
+
+void MultipathControl::onPong(int path, qint64 clientSendUs, qint64 recvUs)
+{
+    if (path < 0 || path >= PATH_COUNT) {
+        return;
+    }
+    PathStats &stats = m_stats[path];
+    bool matched = false;
+    for (Probe &probe : m_probes[path]) {
+        if (probe.pending && probe.sentUs == clientSendUs) {
+            probe.pending = false;
+            matched = true;
+            break;
+        }
+    }
+    const qint64 rtt = recvUs - clientSendUs;
+    if (rtt < 0) {
+        return;
+    }
+    // 已按超时计为丢失的迟到 PONG 只更新 RTT，丢包率不回退
+    if (matched) {
+        stats.loss *= (1.0 - LOSS_ALPHA);
+    }
+
+    if (stats.pongs == 0) {
+        stats.srttUs = rtt;
+        stats.rttVarUs = rtt / 2;
+    } else {
+        const qint64 err = rtt > stats.srttUs ? rtt - stats.srttUs : stats.srttUs - rtt;
+        stats.rttVarUs = (3 * stats.rttVarUs + err) / 4;
+        stats.srttUs = (7 * stats.srttUs + rtt) / 8;
+    }
+    stats.pongs++;
+    stats.lastPongUs = recvUs;
+    if (!stats.up) {
+        stats.up = true;
+        qInfo("[Multipath] %s path up, rtt %.2f ms", pathName(path), rtt / 1000.0);
+    }
+    updateActivePath();
+}
+
+qint64 MultipathControl::score(const PathStats &stats)
+{
+    if (!stats.up) {
+        return std::numeric_limits<qint64>::max();
+    }
+    return stats.srttUs + 2 * stats.rttVarUs + static_cast<qint64>(stats.loss * LOSS_PENALTY_US);
+}
+
+bool MultipathControl::isCritical(const char *msg, int len)
+{
+    switch (static_cast<quint8>(msg[0])) {
+    case FMT_TOUCH_DOWN:
+    case FMT_TOUCH_UP:
+    case FMT_TOUCH_RESET:
+    case FMT_KEY_DOWN:
+    case FMT_KEY_UP:
+    case FMT_DISCONNECT:
+        return true;
+    case FMT_BATCH:
+        // 批量中只要有非 MOVE 事件就整批重复
+        for (int off = 2; off + 6 <= len; off += 6) {
+            if (static_cast<quint8>(msg[off + 1]) != FTA_MOVE) {
+                return true;
+            }
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
+bool MultipathControl::isWritable(int path) const
+{
+    if (!m_pathOpen[path].load(std::memory_order_relaxed)) {
+        return false;
+    }
+    return path != PATH_USB || !m_usbWriter || m_usbWriter->isValid();
+}
+
+void MultipathControl::refreshPathOpen()
+{
+    // 只在主线程调用：QPointer 与 socket 状态都属于主线程
+    m_pathOpen[PATH_USB].store(m_usb && m_usb->state() == QAbstractSocket::ConnectedState,
+                               std::memory_order_relaxed);
+    m_pathOpen[PATH_WIFI].store(m_wifi && m_wifi->isValid(), std::memory_order_relaxed);
+}
+
+qint64 MultipathControl::writePath(int path, const QByteArray &data)
+{
+    if (path == PATH_USB) {
+        if (m_usbWriter) {
+            return m_usbWriter->write(data);
+        }
+        return m_usb ? m_usb->write(data) : -1;
+    }
+    return m_wifi ? m_wifi->write(data) : -1;
+}
+
+void MultipathControl::expireProbes(qint64 nowUs)
+{
+    for (int path = 0; path < PATH_COUNT; ++path) {
+        PathStats &stats = m_stats[path];
+        const qint64 timeout = qMax(PROBE_TIMEOUT_MIN_US, stats.srttUs + 4 * stats.rttVarUs);
+        for (Probe &probe : m_probes[path]) {
+            if (probe.pending && nowUs - probe.sentUs > timeout) {
+                probe.pending = false;
+                stats.loss = stats.loss * (1.0 - LOSS_ALPHA) + LOSS_ALPHA;
+            }
+        }
+        if (stats.up && (!isWritable(path) || nowUs - stats.lastPongUs > PATH_DOWN_US)) {
+            stats.up = false;
+            qWarning("[Multipath] %s path down (no PONG for %lld ms)", pathName(path),
+                     static_cast<long long>((nowUs - stats.lastPongUs) / 1000));
+        }
+    }
+}
+
+void MultipathControl::updateActivePath()
+{
+    const int current = m_activePath.load(std::memory_order_relaxed);
+    const int other = current == PATH_USB ? PATH_WIFI : PATH_USB;
+    const qint64 currentScore = score(m_stats[current]);
+    const qint64 otherScore = score(m_stats[other]);
+    if (otherScore == std::numeric_limits<qint64>::max()) {
+        return;
+    }
+    const bool switchPath = currentScore == std::numeric_limits<qint64>::max()
+                            || otherScore < static_cast<qint64>(currentScore * SWITCH_RATIO);
+    if (!switchPath) {
+        return;
+    }
+    m_activePath.store(other, std::memory_order_relaxed);
+    qInfo("[Multipath] control path %s -> %s (srtt %.2f / %.2f ms, loss %.1f%% / %.1f%%)",
+          pathName(current), pathName(other),
+          m_stats[current].srttUs / 1000.0, m_stats[other].srttUs / 1000.0,
+          m_stats[current].loss * 100.0, m_stats[other].loss * 100.0);
+}
+
+} // namespace qsc
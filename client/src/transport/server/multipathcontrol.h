@@ -0,0 +1,124 @@
+#ifndef MULTIPATHCONTROL_H
+#define MULTIPATHCONTROL_H
+
+#include <QByteArray>
+#include <QPointer>
+#include <QTcpSocket>
+#include <atomic>
+
+class KcpControlSocket;
+class ControlSocketWriter;
+
+namespace qsc {
+
+/**
+ * @brief 多路径控制发送 / Multipath control sender (USB TCP + WiFi KCP)
+ *
+ * 两条控制路径同时在线，按各自的实测 RTT 和丢包选择最快路径：
+ * - 探测：每条路径定时发送 PING，设备经收到 PING 的同一路径回 PONG；
+ *   RTT 按 TCP 方式平滑（srtt/rttvar），超时未回的 PING 计入丢包率（EWMA）
+ * - 选路：评分 = srtt + 2·rttvar + 丢包率 × LOSS_PENALTY_US；超过 PATH_DOWN_US 没有 PONG
+ *   或 socket 断开的路径视为不可用；新路径评分低于当前路径 SWITCH_RATIO 才切换，避免来回抖动
+ * - 发送：普通消息（MOVE 等）只走当前路径；DOWN/UP/RESET/按键/断开等关键消息加
+ *   FMT_PATH_DUP 包装（全局递增 pathSeq）在每条可用路径各发一份，设备按 pathSeq 去重，
+ *   任一路径先到即生效，慢路径或丢包路径不影响关键事件
+ *
+ * 线程：探测与 PONG 处理在主线程，并由主线程把两条路径的 socket 状态发布到 m_pathOpen；
+ * write() 可在输入线程调用，选路只读原子变量（m_pathOpen、当前路径、ControlSocketWriter::isValid），
+ * 不查询主线程 socket 的状态；写入本身走 ControlSocketWriter / KcpControlSocket::write。写失败的路径立即标记为关闭，
+ * 下一轮探测（refreshPathOpen）再按 socket 实际状态恢复。
+ * 输入线程模式下 USB 路径须经 setUsbWriter() 改为 ControlSocketWriter 直写。
+ */
+class MultipathControl
+{
+public:
+    enum Path {
+        PATH_USB = 0,
+        PATH_WIFI = 1,
+        PATH_COUNT = 2,
+    };
+
+    static constexpr qint64 PROBE_TIMEOUT_MIN_US = 500 * 1000;     // PING 超时下限
+    static constexpr qint64 PATH_DOWN_US = 2 * 1000 * 1000;        // 超过此时间无 PONG 视为断开
+    static constexpr qint64 LOSS_PENALTY_US = 50 * 1000;           // 丢包率 100% 折合 50ms
+    static constexpr double LOSS_ALPHA = 0.1;
+    static constexpr double SWITCH_RATIO = 0.8;
+
+    struct PathStats {
+        bool up = false;
+        qint64 srttUs = 0;
+        qint64 rttVarUs = 0;
+        double loss = 0.0;          // 探测丢失率 EWMA
+        qint64 lastPongUs = 0;
+        quint64 probes = 0;
+        quint64 pongs = 0;
+    };
+
+    MultipathControl(QTcpSocket *usb, KcpControlSocket *wifi);
+
+    /**
+     * @brief 关键消息是否在所有路径重复发送（默认开启）
+     */
+    void setDuplicateCritical(bool enabled) { m_duplicate.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * @brief USB 路径改用线程安全的直写器（不接管所有权，nullptr 恢复 QTcpSocket::write）
+     */
+    void setUsbWriter(ControlSocketWriter *writer) { m_usbWriter = writer; }
+
+    /**
+     * @brief 发送控制数据（可包含多条消息）
+     * @return 当前路径写入成功返回 data.size()，没有可用路径返回 -1
+     */
+    qint64 write(const QByteArray &data);
+
+    /**
+     * @brief 在每条可写路径发送一次 PING 探测，并把超时未回的探测计为丢失
+     */
+    void sendProbes(qint64 nowUs);
+
+    /**
+     * @brief 某路径收到 PONG（clientSendUs 为 PING 携带的客户端时间）
+     */
+    void onPong(int path, qint64 clientSendUs, qint64 recvUs);
+
+    int activePath() const { return m_activePath.load(std::memory_order_relaxed); }
+    PathStats stats(int path) const { return m_stats[path]; }
+
+    static const char *pathName(int path);
+
+private:
+    static qint64 score(const PathStats &stats);
+    static bool isCritical(const char *msg, int len);
+
+    bool isWritable(int path) const;
+    void refreshPathOpen();
+    qint64 writePath(int path, const QByteArray &data);
+    void expireProbes(qint64 nowUs);
+    void updateActivePath();
+
+private:
+    static constexpr int MAX_PROBES = 8;
+
+    struct Probe {
+        qint64 sentUs = 0;
+        bool pending = false;
+    };
+
+    QPointer<QTcpSocket> m_usb;
+    ControlSocketWriter *m_usbWriter = nullptr;
+    QPointer<KcpControlSocket> m_wifi;
+
+    PathStats m_stats[PATH_COUNT];
+    Probe m_probes[PATH_COUNT][MAX_PROBES];
+    int m_nextProbe[PATH_COUNT] = {};
+
+    std::atomic<bool> m_pathOpen[PATH_COUNT] = {};     // socket 已连接（主线程发布）
+    std::atomic<int> m_activePath{PATH_USB};
+    std::atomic<quint32> m_pathSeq{0};
+    std::atomic<bool> m_duplicate{true};
+};
+
+} // namespace qsc
+
+#endif // MULTIPATHCONTROL_H
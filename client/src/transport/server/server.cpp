@@ -1,4 +1,5 @@
 #include <QDebug>
+#include <QHostAddress>
 
 #include "server.h"
 #include "kcpserver.h"
@@ -52,6 +53,11 @@ bool Server::start(Server::ServerParams params)
         kcpParams.crop = m_params.crop;
         kcpParams.control = m_params.control;
         kcpParams.kcpPort = m_params.kcpPort;
+        kcpParams.kcpFecData = m_params.kcpFecData;
+        kcpParams.kcpFecParity = m_params.kcpFecParity;
+        kcpParams.videoFec = m_params.videoFec;
+        kcpParams.moveLaneCopies = m_params.moveLaneCopies;
+        kcpParams.localStandin = m_params.localStandin;
         kcpParams.scid = m_params.scid;
 
         return m_kcpServer->start(kcpParams);
@@ -60,7 +66,7 @@ bool Server::start(Server::ServerParams params)
 
         // 创建 TcpServerHandler
         m_tcpServer = new TcpServerHandler(this);
-        connect(m_tcpServer, &TcpServerHandler::serverStarted, this, &Server::serverStarted);
+        connect(m_tcpServer, &TcpServerHandler::serverStarted, this, &Server::onTcpServerStarted);
         connect(m_tcpServer, &TcpServerHandler::serverStoped, this, &Server::serverStoped);
 
         // 转换参数
@@ -85,11 +91,45 @@ bool Server::start(Server::ServerParams params)
         tcpParams.crop = m_params.crop;
         tcpParams.control = m_params.control;
         tcpParams.scid = m_params.scid;
+        if (!m_params.multipathIp.isEmpty()) {
+            qInfo() << "Server: Multipath enabled, WiFi control path via" << m_params.multipathIp;
+            tcpParams.multipathClientIp = KcpServer::findClientIpInSameSubnet(m_params.multipathIp);
+            tcpParams.multipathControlPort = m_params.kcpPort + 1;
+        }
 
         return m_tcpServer->start(tcpParams);
     }
 }
 
+void Server::onTcpServerStarted(bool success, const QString &deviceName, const QSize &size)
+{
+    // WiFi 路径建立失败不影响 USB 会话，退化为单路径
+    if (success && !m_params.multipathIp.isEmpty() && !setupPathControlSocket()) {
+        qWarning() << "Server: WiFi control path unavailable, continuing with USB only";
+    }
+    emit serverStarted(success, deviceName, size);
+}
+
+bool Server::setupPathControlSocket()
+{
+    if (m_pathControlSocket) {
+        m_pathControlSocket->close();
+        m_pathControlSocket->deleteLater();
+    }
+    // 不启用 FEC：关键消息已双路径发送，不再为单条路径付出冗余
+    m_pathControlSocket = new KcpControlSocket(this);
+    // 与 KcpServer 相同：只有同机设备替身才在本地端口被占用时改用临时端口
+    const quint16 port = m_params.kcpPort + 1;
+    if (!m_pathControlSocket->bind(port) && !(m_params.localStandin && m_pathControlSocket->bind(0))) {
+        qWarning() << "Server: Failed to bind WiFi control path to port" << port;
+        m_pathControlSocket->deleteLater();
+        m_pathControlSocket = Q_NULLPTR;
+        return false;
+    }
+    m_pathControlSocket->connectToHost(QHostAddress(m_params.multipathIp), port);
+    return true;
+}
+
 void Server::stop()
 {
     if (m_kcpServer) {
@@ -102,6 +142,11 @@ void Server::stop()
         m_tcpServer->deleteLater();
         m_tcpServer = Q_NULLPTR;
     }
+    if (m_pathControlSocket) {
+        m_pathControlSocket->close();
+        m_pathControlSocket->deleteLater();
+        m_pathControlSocket = Q_NULLPTR;
+    }
 }
 
 Server::ServerParams Server::getParams()
@@ -141,6 +186,11 @@ VideoSocket* Server::removeVideoSocket()
     return Q_NULLPTR;
 }
 
+KcpControlSocket* Server::getPathControlSocket()
+{
+    return m_pathControlSocket;
+}
+
 QTcpSocket* Server::getControlSocket()
 {
     if (m_tcpServer) {
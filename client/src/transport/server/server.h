@@ -21,6 +21,11 @@ class VideoSocket;
  *   Contains ':': WiFi mode (KCP)
  * - 不包含 ':' (如 abcd1234): USB 模式 (TCP)
  *   No ':': USB mode (TCP)
+ *
+ * USB 模式下指定 multipathIp（设备 WiFi 地址）时再开一条 KCP 控制通道（多路径）：
+ * 视频仍走 USB，控制消息由 MultipathControl 按两条路径的实测 RTT/丢包选路。
+ * With multipathIp set in USB mode, a second KCP control path over WiFi is opened;
+ * video stays on USB and MultipathControl picks the control path by measured RTT/loss.
  */
 class Server : public QObject
 {
@@ -56,6 +61,16 @@ public:
 
         // KCP 模式参数 / KCP mode parameters
         quint16 kcpPort = 27185;          // KCP UDP 视频端口 / KCP UDP video port (ctrl = kcpPort+1)
+        quint8 kcpFecData = 0;            // KCP FEC 数据包数 k (0=关闭) / FEC data shards
+        quint8 kcpFecParity = 0;          // KCP FEC 校验包数 m / FEC parity shards
+        bool videoFec = true;             // UDP 视频自适应 FEC / Loss-adaptive video FEC
+        quint8 moveLaneCopies = 2;        // 触摸 MOVE 不可靠通道份数 (0=关闭) / Touch-move lane copies
+
+        // 多路径参数 / Multipath parameters
+        QString multipathIp = "";         // USB 模式下设备 WiFi 地址，空 = 关闭 / Device WiFi IP in USB mode, empty = off
+
+        // 同机设备替身（KZSCRCPY_LOCAL_STANDIN=1）：KCP 控制端口被占用时改用临时端口 / Same-host stand-in
+        bool localStandin = false;
 
         qint32 scid = -1;
     };
@@ -82,10 +97,20 @@ public:
     VideoSocket *removeVideoSocket();
     QTcpSocket *getControlSocket();
 
+    // 多路径: USB 之外的 WiFi KCP 控制通道 / Multipath: the extra WiFi KCP control path
+    bool isMultipath() const { return !m_pathControlSocket.isNull(); }
+    KcpControlSocket *getPathControlSocket();
+
 signals:
     void serverStarted(bool success, const QString &deviceName = "", const QSize &size = QSize());
     void serverStoped();
 
+private slots:
+    void onTcpServerStarted(bool success, const QString &deviceName, const QSize &size);
+
+private:
+    bool setupPathControlSocket();
+
 private:
     bool m_useKcp = false;
     ServerParams m_params;
@@ -93,6 +118,7 @@ private:
     // 内部实现 (互斥)
     QPointer<KcpServer> m_kcpServer;
     QPointer<TcpServerHandler> m_tcpServer;
+    QPointer<KcpControlSocket> m_pathControlSocket;
 };
 
 #endif // SERVER_H
@@ -0,0 +1,190 @@
+#include "controlsocketwriter.h"
+
+// winsock2.h 必须先于任何可能引入 windows.h 的头文件
+#ifdef Q_OS_WIN
+#include <winsock2.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#endif
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "fastmsg.h"
+
+ControlSocketWriter::ControlSocketWriter(qintptr descriptor)
+    : m_fd(descriptor)
+{
+    if (m_fd < 0) {
+        m_failed.store(true);
+    }
+}
+
+qint64 ControlSocketWriter::write(const char *data, qint64 len)
+{
+    if (!data || len <= 0 || m_failed.load(std::memory_order_relaxed)) {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 先补发之前超时暂存的抬起/复位，保持消息顺序
+    if (!m_pending.isEmpty()) {
+        const WriteResult r = writeLocked(m_pending.constData(), m_pending.size());
+        if (r == WriteResult::Failed) {
+            return -1;
+        }
+        if (r == WriteResult::Timeout) {
+            return holdRelease(data, len) ? len : -1;
+        }
+        m_pending.resize(0);
+    }
+
+    const WriteResult r = writeLocked(data, len);
+    if (r == WriteResult::Sent) {
+        return len;
+    }
+    if (r == WriteResult::Timeout && holdRelease(data, len)) {
+        return len;
+    }
+    return -1;
+}
+
+ControlSocketWriter::WriteResult ControlSocketWriter::writeLocked(const char *data, qint64 len)
+{
+    QElapsedTimer stall;
+    qint64 sent = 0;
+    while (sent < len) {
+        const qint64 n = sendSome(data + sent, len - sent);
+        if (n > 0) {
+            sent += n;
+            continue;
+        }
+        if (n < 0) {
+            m_failed.store(true);
+            qWarning("[ControlSocketWriter] send failed, control channel closed");
+            return WriteResult::Failed;
+        }
+
+        // 发送缓冲区满
+        m_stalls.fetch_add(1, std::memory_order_relaxed);
+        if (!stall.isValid()) {
+            stall.start();
+        }
+        if (sent == 0) {
+            // 还没发出任何字节：整条丢弃不会破坏帧边界
+            if (!waitWritable(WRITE_TIMEOUT_MS)) {
+                return WriteResult::Timeout;
+            }
+            continue;
+        }
+        const int left = STALL_LIMIT_MS - static_cast<int>(stall.elapsed());
+        if (left <= 0 || !waitWritable(left)) {
+            m_failed.store(true);
+            qWarning("[ControlSocketWriter] stalled mid-message for %d ms, control channel unusable", STALL_LIMIT_MS);
+            return WriteResult::Failed;
+        }
+    }
+    return WriteResult::Sent;
+}
+
+bool ControlSocketWriter::holdRelease(const char *data, qint64 len)
+{
+    if (!containsRelease(data, static_cast<int>(len))) {
+        return false;
+    }
+    m_heldReleases.fetch_add(1, std::memory_order_relaxed);
+    if (m_pending.size() + len > MAX_PENDING_BYTES) {
+        // 积压过多：复位所有触摸点代替逐条抬起
+        qWarning("[ControlSocketWriter] pending releases exceed %d bytes, falling back to touch reset",
+                 MAX_PENDING_BYTES);
+        m_pending.resize(0);
+        m_pending.append(static_cast<char>(FMT_TOUCH_RESET));
+        return true;
+    }
+    m_pending.append(data, static_cast<int>(len));
+    return true;
+}
+
+bool ControlSocketWriter::containsRelease(const char *data, int len)
+{
+    while (len > 0) {
+        const int size = FastMsg::messageSize(data, len);
+        if (size <= 0) {
+            break;
+        }
+        const char *msg = data;
+        if (static_cast<quint8>(msg[0]) == FMT_PATH_DUP) {
+            msg += 5;  // 多路径包装：检查内层消息
+        }
+        switch (static_cast<quint8>(msg[0])) {
+        case FMT_TOUCH_UP:
+        case FMT_TOUCH_RESET:
+        case FMT_KEY_UP:
+            return true;
+        case FMT_BATCH: {
+            const int count = static_cast<quint8>(msg[1]);
+            for (int i = 0; i < count; ++i) {
+                const quint8 action = static_cast<quint8>(msg[2 + i * 6 + 1]);
+                if (action == FTA_UP || action == FTA_RESET) {
+                    return true;
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        data += size;
+        len -= size;
+    }
+    return false;
+}
+
+qint64 ControlSocketWriter::sendSome(const char *data, qint64 len)
+{
+#ifdef Q_OS_WIN
+    const int n = ::send(static_cast<SOCKET>(m_fd), data, static_cast<int>(len), 0);
+    if (n == SOCKET_ERROR) {
+        return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+    }
+    return n;
+#else
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    for (;;) {
+        const ssize_t n = ::send(static_cast<int>(m_fd), data, static_cast<size_t>(len), flags);
+        if (n >= 0) {
+            return n;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+#endif
+}
+
+bool ControlSocketWriter::waitWritable(int timeoutMs)
+{
+#ifdef Q_OS_WIN
+    WSAPOLLFD pfd = {};
+    pfd.fd = static_cast<SOCKET>(m_fd);
+    pfd.events = POLLWRNORM;
+    return WSAPoll(&pfd, 1, timeoutMs) > 0 && (pfd.revents & POLLWRNORM);
+#else
+    pollfd pfd = {};
+    pfd.fd = static_cast<int>(m_fd);
+    pfd.events = POLLOUT;
+    int ret;
+    do {
+        ret = ::poll(&pfd, 1, timeoutMs);
+    } while (ret < 0 && errno == EINTR);
+    return ret > 0 && (pfd.revents & POLLOUT);
+#endif
+}
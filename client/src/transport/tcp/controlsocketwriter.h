@@ -0,0 +1,75 @@
+#ifndef CONTROLSOCKETWRITER_H
+#define CONTROLSOCKETWRITER_H
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <atomic>
+#include <mutex>
+
+/**
+ * @brief TCP 控制通道直写器 / Direct, thread-safe writer for the TCP control socket
+ *
+ * QTcpSocket 只能在所属线程（GUI 线程）使用。输入线程模式下，输入线程（触摸/按键）
+ * 和 GUI 线程（时钟同步 PING、关键帧请求等）都要写控制通道，因此该连接的所有写入
+ * 都改为经本类直接对套接字描述符调用 send()：
+ * - 互斥锁保证两个线程的消息不会交错
+ * - 发送缓冲区满时 poll 等待可写；一条消息还没发出任何字节时最多等 WRITE_TIMEOUT_MS，
+ *   超时按发送失败处理（控制消息很小，缓冲区满说明链路已卡住）；已发出一部分时必须发完，
+ *   否则帧边界错位，超过 STALL_LIMIT_MS 仍发不完则视为连接失效，之后的写入都返回 -1
+ * - 超时的消息含抬起/复位（TOUCH_UP、KEY_UP、TOUCH_RESET 或 BATCH 中的 UP/RESET）时不丢弃，
+ *   暂存并在下一次写入前先发出，避免设备端触摸点或按键卡在按下状态；暂存超过
+ *   MAX_PENDING_BYTES 时改为只保留一条 TOUCH_RESET
+ *
+ * 启用后不得再经 QTcpSocket::write 写同一连接（其内部缓冲区中的数据会与直写的数据乱序），
+ * 读取仍由 QTcpSocket 负责。
+ */
+class ControlSocketWriter
+{
+public:
+    static constexpr int WRITE_TIMEOUT_MS = 50;
+    static constexpr int STALL_LIMIT_MS = 1000;
+    static constexpr int MAX_PENDING_BYTES = 4096;
+
+    explicit ControlSocketWriter(qintptr descriptor);
+
+    ControlSocketWriter(const ControlSocketWriter &) = delete;
+    ControlSocketWriter &operator=(const ControlSocketWriter &) = delete;
+
+    /**
+     * @brief 完整写入一条或多条消息（线程安全）
+     * @return 成功（含暂存待发的抬起/复位消息）返回 len，失败返回 -1
+     */
+    qint64 write(const char *data, qint64 len);
+    qint64 write(const QByteArray &data) { return write(data.constData(), data.size()); }
+
+    bool isValid() const { return !m_failed.load(std::memory_order_relaxed); }
+
+    // 发送缓冲区满而等待的次数
+    quint64 stalls() const { return m_stalls.load(std::memory_order_relaxed); }
+
+    // 超时后暂存、稍后补发的抬起/复位消息数
+    quint64 heldReleases() const { return m_heldReleases.load(std::memory_order_relaxed); }
+
+private:
+    enum class WriteResult { Sent, Timeout, Failed };
+
+    // 持锁写入一段完整数据：Timeout 表示未发出任何字节即超时
+    WriteResult writeLocked(const char *data, qint64 len);
+    // 含抬起/复位时暂存到 m_pending 并返回 true
+    bool holdRelease(const char *data, qint64 len);
+    static bool containsRelease(const char *data, int len);
+
+    // 返回发出的字节数；缓冲区满返回 0；连接错误返回 -1
+    qint64 sendSome(const char *data, qint64 len);
+    bool waitWritable(int timeoutMs);
+
+private:
+    const qintptr m_fd;
+    std::mutex m_mutex;
+    std::atomic<bool> m_failed{false};
+    std::atomic<quint64> m_stalls{0};
+    std::atomic<quint64> m_heldReleases{0};
+    QByteArray m_pending;   // 待补发的抬起/复位消息（持 m_mutex 访问）
+};
+
+#endif // CONTROLSOCKETWRITER_H
@@ -236,6 +236,11 @@ bool TcpServerHandler::execute()
     if (-1 != m_params.scid) {
         args << QString("scid=%1").arg(m_params.scid, 8, 16, QChar('0'));
     }
+    if (0 != m_params.multipathControlPort) {
+        args << QString("multipath=true");
+        args << QString("kcp_control_port=%1").arg(m_params.multipathControlPort);
+        args << QString("client_ip=%1").arg(m_params.multipathClientIp);
+    }
 
 #ifdef SERVER_DEBUGGER
     qInfo("Server debugger waiting for a client on device port " SERVER_DEBUGGER_PORT "...");
@@ -62,6 +62,10 @@ public:
         QString crop = "";
         bool control = true;
         qint32 scid = -1;
+
+        // 多路径：设备另开 KCP 控制通道发往 multipathClientIp:multipathControlPort（端口 0 = 关闭）
+        QString multipathClientIp = "";
+        quint16 multipathControlPort = 0;
     };
 
     explicit TcpServerHandler(QObject *parent = nullptr);
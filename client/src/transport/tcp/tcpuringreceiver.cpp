@@ -0,0 +1,476 @@
+#include <QDebug>
+#include <cstring>
+
+#include "tcpuringreceiver.h"
+
+// 提供缓冲区环、多发 recv、SINGLE_ISSUER 需要 6.0 及以上的 uapi 头文件；
+// 头文件缺失或过旧时按不支持编译（open() 返回 false），调用方继续使用 QTcpSocket
+#if defined(Q_OS_LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+// 特性宏均为 #define（IORING_REGISTER_PBUF_RING 等为枚举，无法检测，与 RECV_MULTISHOT 同属 6.0 uapi）
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_SETUP_SINGLE_ISSUER) && defined(IORING_SETUP_COOP_TASKRUN) \
+    && defined(__NR_io_uring_setup)
+#define QSC_TCP_URING 1
+#endif
+#endif
+#endif
+
+#ifdef QSC_TCP_URING
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef QSC_TCP_URING
+
+// io_uring 完成事件的 user_data
+static constexpr quint64 RECV_ID = 1;
+static constexpr quint64 WAKE_ID = 2;
+
+// 提供缓冲区组号
+static constexpr quint16 BUF_GROUP = 0;
+
+// 未使用 liburing：三个系统调用直接封装，避免新增依赖
+static int uringSetup(unsigned entries, io_uring_params *params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int uringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static int uringRegister(int ringFd, unsigned opcode, void *arg, unsigned nrArgs)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, ringFd, opcode, arg, nrArgs));
+}
+
+struct TcpUringReceiver::Native {
+    void *sqRing = MAP_FAILED;
+    size_t sqRingSize = 0;
+    void *cqRing = MAP_FAILED;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned *sqArray = nullptr;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe *cqes = nullptr;
+
+    io_uring_buf_ring *bufRing = static_cast<io_uring_buf_ring *>(MAP_FAILED);
+    size_t bufRingSize = 0;
+    char *buffers = static_cast<char *>(MAP_FAILED);
+    size_t buffersSize = 0;
+
+    io_uring_sqe *getSqe()
+    {
+        const unsigned tail = *sqTail;
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+            return nullptr;
+        }
+        const unsigned index = tail & sqMask;
+        sqArray[index] = index;
+        io_uring_sqe *sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    void commitSqe()
+    {
+        __atomic_store_n(sqTail, *sqTail + 1, __ATOMIC_RELEASE);
+    }
+};
+
+#else
+
+struct TcpUringReceiver::Native {
+};
+
+#endif
+
+TcpUringReceiver::TcpUringReceiver() = default;
+
+TcpUringReceiver::~TcpUringReceiver()
+{
+    close();
+}
+
+bool TcpUringReceiver::isSupported()
+{
+#ifdef QSC_TCP_URING
+    return true;
+#else
+    return false;
+#endif
+}
+
+QString TcpUringReceiver::stats() const
+{
+    return QString("bytes=%1,completions=%2,enters=%3,noBuffers=%4,multishot=%5")
+        .arg(m_bytes)
+        .arg(m_completions)
+        .arg(m_enters)
+        .arg(m_noBuffers)
+        .arg(m_multishot ? 1 : 0);
+}
+
+void TcpUringReceiver::requestStop()
+{
+    m_stopRequested.store(true);
+#ifdef QSC_TCP_URING
+    const int wakeFd = m_wakeFd.load();
+    if (wakeFd >= 0) {
+        const quint64 one = 1;
+        ssize_t ret = ::write(wakeFd, &one, sizeof(one));
+        Q_UNUSED(ret);
+    }
+#endif
+}
+
+#ifdef QSC_TCP_URING
+
+bool TcpUringReceiver::open(int fd)
+{
+    close();
+    if (fd < 0) {
+        return false;
+    }
+    m_fd = fd;
+    std::unique_ptr<Native> native(new Native());
+
+    // 只有接收线程提交，SINGLE_ISSUER/COOP_TASKRUN 减少内核侧唤醒；旧内核不认识时去掉重试
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_COOP_TASKRUN;
+    int ringFd = uringSetup(RING_ENTRIES, &params);
+    if (ringFd < 0 && errno == EINVAL) {
+        memset(&params, 0, sizeof(params));
+        ringFd = uringSetup(RING_ENTRIES, &params);
+    }
+    if (ringFd < 0) {
+        qWarning("[TcpUringReceiver] io_uring_setup failed: %s", strerror(errno));
+        return false;
+    }
+    m_ringFd = ringFd;
+    m_native = std::move(native);
+    Native &n = *m_native;
+
+    // SQ/CQ 环映射（FEAT_SINGLE_MMAP 时两者共用一块）
+    n.sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    n.cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        n.sqRingSize = n.cqRingSize = qMax(n.sqRingSize, n.cqRingSize);
+    }
+    n.sqRing = mmap(nullptr, n.sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd,
+                    IORING_OFF_SQ_RING);
+    if (n.sqRing == MAP_FAILED) {
+        qWarning("[TcpUringReceiver] mmap SQ ring failed: %s", strerror(errno));
+        close();
+        return false;
+    }
+    if (singleMmap) {
+        n.cqRing = n.sqRing;
+    } else {
+        n.cqRing = mmap(nullptr, n.cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd,
+                        IORING_OFF_CQ_RING);
+        if (n.cqRing == MAP_FAILED) {
+            qWarning("[TcpUringReceiver] mmap CQ ring failed: %s", strerror(errno));
+            close();
+            return false;
+        }
+    }
+    n.sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    n.sqes = static_cast<io_uring_sqe *>(mmap(nullptr, n.sqesSize, PROT_READ | PROT_WRITE,
+                                              MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+    if (n.sqes == MAP_FAILED) {
+        qWarning("[TcpUringReceiver] mmap SQEs failed: %s", strerror(errno));
+        close();
+        return false;
+    }
+
+    char *sq = static_cast<char *>(n.sqRing);
+    char *cq = static_cast<char *>(n.cqRing);
+    n.sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    n.sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    n.sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    n.sqEntries = params.sq_entries;
+    n.sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    n.cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    n.cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    n.cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    n.cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    // 提供缓冲区环（内核 5.19+）：环本身和数据区都预先分配，稳态零分配
+    n.bufRingSize = BUF_COUNT * sizeof(io_uring_buf);
+    n.bufRing = static_cast<io_uring_buf_ring *>(mmap(nullptr, n.bufRingSize, PROT_READ | PROT_WRITE,
+                                                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    n.buffersSize = static_cast<size_t>(BUF_COUNT) * BUF_SIZE;
+    n.buffers = static_cast<char *>(mmap(nullptr, n.buffersSize, PROT_READ | PROT_WRITE,
+                                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0));
+    if (n.bufRing == MAP_FAILED || n.buffers == MAP_FAILED) {
+        qWarning("[TcpUringReceiver] buffer allocation failed: %s", strerror(errno));
+        close();
+        return false;
+    }
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<quint64>(n.bufRing);
+    reg.ring_entries = BUF_COUNT;
+    reg.bgid = BUF_GROUP;
+    if (uringRegister(ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        qWarning("[TcpUringReceiver] register buffer ring failed: %s", strerror(errno));
+        close();
+        return false;
+    }
+    n.bufRing->tail = 0;
+    for (int bid = 0; bid < BUF_COUNT; ++bid) {
+        recycleBuffer(bid);
+    }
+
+    // 停止通知：eventfd 上挂一个 poll，requestStop() 写入后 io_uring_enter 立即返回
+    const int wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    io_uring_sqe *sqe = wakeFd >= 0 ? n.getSqe() : nullptr;
+    if (!sqe) {
+        qWarning("[TcpUringReceiver] eventfd failed: %s", strerror(errno));
+        if (wakeFd >= 0) {
+            ::close(wakeFd);
+        }
+        close();
+        return false;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = wakeFd;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = WAKE_ID;
+    n.commitSqe();
+    m_pendingSubmit++;
+    m_wakeFd.store(wakeFd);
+    if (m_stopRequested.load()) {
+        requestStop();      // 与 requestStop() 的竞争：任一方看到对方的写入都会补发唤醒
+    }
+
+    if (!armRecv()) {
+        close();
+        return false;
+    }
+
+    qInfo("[TcpUringReceiver] fd %d, %d x %dKB provided buffers, multishot recv", fd, BUF_COUNT, BUF_SIZE / 1024);
+    return true;
+}
+
+void TcpUringReceiver::close()
+{
+    const int wakeFd = m_wakeFd.exchange(-1);
+    if (m_ringFd >= 0) {
+        if (m_completions > 0) {
+            qInfo("[TcpUringReceiver] closed: %s", qPrintable(stats()));
+        }
+        // 先关 ring（取消未完成的 recv），再释放内核可能写入的缓冲区
+        ::close(m_ringFd);
+        m_ringFd = -1;
+    }
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+    }
+    if (m_native) {
+        Native &n = *m_native;
+        if (n.buffers != MAP_FAILED) munmap(n.buffers, n.buffersSize);
+        if (n.bufRing != MAP_FAILED) munmap(n.bufRing, n.bufRingSize);
+        if (n.sqes != MAP_FAILED) munmap(n.sqes, n.sqesSize);
+        if (n.cqRing != MAP_FAILED && n.cqRing != n.sqRing) munmap(n.cqRing, n.cqRingSize);
+        if (n.sqRing != MAP_FAILED) munmap(n.sqRing, n.sqRingSize);
+        m_native.reset();
+    }
+    m_fd = -1;
+    m_curBid = -1;
+    m_curOffset = 0;
+    m_curLen = 0;
+    m_recvArmed = false;
+    m_eof = false;
+    m_failed = false;
+    m_pendingSubmit = 0;
+}
+
+qint32 TcpUringReceiver::recv(quint8 *buf, qint32 size)
+{
+    if (!buf || m_ringFd < 0) {
+        return -1;
+    }
+    qint32 copied = 0;
+    while (copied < size) {
+        if (m_curBid < 0 && !nextChunk()) {
+            return m_failed ? -1 : 0;
+        }
+        const int n = qMin(size - copied, m_curLen - m_curOffset);
+        memcpy(buf + copied, m_native->buffers + static_cast<size_t>(m_curBid) * BUF_SIZE + m_curOffset, n);
+        copied += n;
+        m_curOffset += n;
+        if (m_curOffset == m_curLen) {
+            // 缓冲区用完立即归还，内核可继续收进来
+            recycleBuffer(m_curBid);
+            m_curBid = -1;
+        }
+    }
+    return size;
+}
+
+bool TcpUringReceiver::nextChunk()
+{
+    Native &n = *m_native;
+    for (;;) {
+        if (m_stopRequested.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        const unsigned head = *n.cqHead;
+        if (head != __atomic_load_n(n.cqTail, __ATOMIC_ACQUIRE)) {
+            const io_uring_cqe cqe = n.cqes[head & n.cqMask];
+            __atomic_store_n(n.cqHead, head + 1, __ATOMIC_RELEASE);
+            m_completions++;
+            if (cqe.user_data == WAKE_ID) {
+                continue;       // 循环开头检查停止标志
+            }
+            if (cqe.user_data != RECV_ID) {
+                continue;
+            }
+            if (!(cqe.flags & IORING_CQE_F_MORE)) {
+                m_recvArmed = false;
+            }
+            const bool hasBuffer = cqe.flags & IORING_CQE_F_BUFFER;
+            const int bid = static_cast<int>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            if (cqe.res > 0 && hasBuffer) {
+                m_curBid = bid;
+                m_curOffset = 0;
+                m_curLen = cqe.res;
+                m_bytes += static_cast<quint64>(cqe.res);
+                return true;
+            }
+            if (hasBuffer) {
+                recycleBuffer(bid);
+            }
+            if (cqe.res == 0) {
+                m_eof = true;
+                return false;
+            }
+            if (cqe.res == -ENOBUFS) {
+                // 消费端落后，缓冲区全部在途；当前块已归还，重新挂接收即可
+                m_noBuffers++;
+                continue;
+            }
+            if (cqe.res == -EINVAL && m_multishot) {
+                // 内核 < 6.0 不支持多发 recv：退化为每块提交一次
+                m_multishot = false;
+                qInfo("[TcpUringReceiver] multishot recv unsupported, using single-shot recv");
+                continue;
+            }
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                continue;
+            }
+            qWarning("[TcpUringReceiver] recv failed: %s", strerror(-cqe.res));
+            m_eof = true;
+            m_failed = true;
+            return false;
+        }
+
+        if (m_eof) {
+            return false;
+        }
+        if (!m_recvArmed && !armRecv()) {
+            m_failed = true;
+            return false;
+        }
+        // 完成队列为空：提交挂起的请求并阻塞到至少一个完成事件
+        m_enters++;
+        const int ret = uringEnter(m_ringFd, static_cast<unsigned>(m_pendingSubmit), 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            qWarning("[TcpUringReceiver] io_uring_enter failed: %s", strerror(errno));
+            m_failed = true;
+            return false;
+        }
+        m_pendingSubmit = qMax(0, m_pendingSubmit - ret);
+    }
+}
+
+bool TcpUringReceiver::armRecv()
+{
+    io_uring_sqe *sqe = m_native->getSqe();
+    if (!sqe) {
+        qWarning("[TcpUringReceiver] submission queue full");
+        return false;
+    }
+    // len = 0：每次完成使用整块提供缓冲区
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = m_fd;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUF_GROUP;
+    sqe->ioprio = m_multishot ? IORING_RECV_MULTISHOT : 0;
+    sqe->user_data = RECV_ID;
+    m_native->commitSqe();
+    m_pendingSubmit++;
+    m_recvArmed = true;
+    return true;
+}
+
+void TcpUringReceiver::recycleBuffer(int bid)
+{
+    // tail 与 bufs[0] 的保留字段重叠，只写 addr/len/bid。
+    // 不用 ring->bufs：__DECLARE_FLEX_ARRAY 在 C++ 下带一个空结构体占位，bufs 的偏移会错开
+    io_uring_buf_ring *ring = m_native->bufRing;
+    const quint16 tail = ring->tail;
+    io_uring_buf *slot = reinterpret_cast<io_uring_buf *>(ring) + (tail & (BUF_COUNT - 1));
+    slot->addr = reinterpret_cast<quint64>(m_native->buffers + static_cast<size_t>(bid) * BUF_SIZE);
+    slot->len = BUF_SIZE;
+    slot->bid = static_cast<quint16>(bid);
+    __atomic_store_n(&ring->tail, static_cast<quint16>(tail + 1), __ATOMIC_RELEASE);
+}
+
+#else // !QSC_TCP_URING
+
+bool TcpUringReceiver::open(int fd)
+{
+    Q_UNUSED(fd);
+    return false;
+}
+
+void TcpUringReceiver::close()
+{
+}
+
+qint32 TcpUringReceiver::recv(quint8 *buf, qint32 size)
+{
+    Q_UNUSED(buf);
+    Q_UNUSED(size);
+    return -1;
+}
+
+bool TcpUringReceiver::nextChunk()
+{
+    return false;
+}
+
+bool TcpUringReceiver::armRecv()
+{
+    return false;
+}
+
+void TcpUringReceiver::recycleBuffer(int bid)
+{
+    Q_UNUSED(bid);
+}
+
+#endif // QSC_TCP_URING
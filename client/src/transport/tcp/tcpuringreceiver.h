@@ -0,0 +1,106 @@
+#ifndef TCPURINGRECEIVER_H
+#define TCPURINGRECEIVER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief TCP 视频流 io_uring 接收后端 / io_uring receive backend for the TCP video stream
+ *
+ * QTcpSocket 路径每块数据需要 poll + read 两次系统调用，再经 Qt 内部缓冲拷贝一次，
+ * 且 waitForReadyRead 的 50ms 守卫在链路短暂空闲时表现为延迟尖峰。本后端：
+ * - 注册一组提供缓冲区（provided buffer ring，BUF_COUNT × BUF_SIZE），内核直接把数据收进去
+ * - 一个多发（multishot）recv 请求持续产生完成事件，稳态下没有逐块提交
+ * - 完成队列中已有数据时直接消费，不进内核；为空才用一次 io_uring_enter 阻塞等待
+ * - recv() 把数据从提供缓冲区直接拷到调用方缓冲区（Demuxer 传入的是 AVPacket 数据区），
+ *   整个帧只拷贝一次，消费完的缓冲区立即归还给内核
+ * - requestStop() 写 eventfd，等待中的 io_uring_enter 立即返回（无超时轮询）
+ *
+ * 内核不支持多发 recv 时退化为单发 recv + 提供缓冲区；io_uring 不可用
+ * （非 Linux、内核 < 5.19、被 seccomp 禁用、编译时 uapi 头文件早于 6.0）时 open() 返回 false，
+ * 调用方继续使用 QTcpSocket。
+ *
+ * 线程：open()/recv()/close() 只在接收线程调用；requestStop() 可在任意线程调用。
+ */
+class TcpUringReceiver
+{
+public:
+    static constexpr int RING_ENTRIES = 8;
+    static constexpr int BUF_COUNT = 32;            // 必须是 2 的幂
+    static constexpr int BUF_SIZE = 64 * 1024;
+
+    TcpUringReceiver();
+    ~TcpUringReceiver();
+
+    TcpUringReceiver(const TcpUringReceiver &) = delete;
+    TcpUringReceiver &operator=(const TcpUringReceiver &) = delete;
+
+    /**
+     * @brief 当前构建是否包含 io_uring 后端（编译期确定：Linux 且 uapi 头文件足够新）
+     */
+    static bool isSupported();
+
+    /**
+     * @brief 在已连接的 TCP 套接字上建立 io_uring 接收（不接管 fd 的所有权）
+     * @return 失败返回 false，调用方应回退到 QTcpSocket
+     */
+    bool open(int fd);
+
+    /**
+     * @brief 阻塞接收恰好 size 字节
+     * @return 成功返回 size；停止 / 对端关闭返回 0；错误返回 -1
+     */
+    qint32 recv(quint8 *buf, qint32 size);
+
+    /**
+     * @brief 请求停止（线程安全），等待中的 recv() 立即返回 0
+     */
+    void requestStop();
+
+    /**
+     * @brief 释放 io_uring 与缓冲区（可重复调用）
+     */
+    void close();
+
+    bool isOpen() const { return m_ringFd >= 0; }
+
+    /**
+     * @brief 统计: 字节数/完成事件数/io_uring_enter 调用数/缓冲区耗尽次数
+     */
+    QString stats() const;
+
+private:
+    bool nextChunk();
+    bool armRecv();
+    void recycleBuffer(int bid);
+
+private:
+    int m_fd = -1;
+    int m_ringFd = -1;
+    std::atomic<int> m_wakeFd{-1};
+    std::atomic<bool> m_stopRequested{false};
+
+    // 当前正在消费的缓冲区
+    int m_curBid = -1;
+    int m_curOffset = 0;
+    int m_curLen = 0;
+
+    bool m_multishot = true;
+    bool m_recvArmed = false;
+    bool m_eof = false;
+    bool m_failed = false;
+    int m_pendingSubmit = 0;
+
+    struct Native;                      // 映射的 SQ/CQ 环与缓冲区环（平台相关，定义在 .cpp）
+    std::unique_ptr<Native> m_native;
+
+    // 统计
+    quint64 m_bytes = 0;
+    quint64 m_completions = 0;
+    quint64 m_enters = 0;
+    quint64 m_noBuffers = 0;
+};
+
+#endif // TCPURINGRECEIVER_H
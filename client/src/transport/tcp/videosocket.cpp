@@ -3,6 +3,7 @@
 #include <QThread>
 
 #include "videosocket.h"
+#include "tcpuringreceiver.h"
 
 VideoSocket::VideoSocket(QObject *parent) : QTcpSocket(parent)
 {
@@ -11,6 +12,10 @@ VideoSocket::VideoSocket(QObject *parent) : QTcpSocket(parent)
 
     // 设置较大的接收缓冲区（视频数据量大）
     setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 256 * 1024);
+
+    if (TcpUringReceiver::isSupported()) {
+        m_uring.reset(new TcpUringReceiver());
+    }
 }
 
 VideoSocket::~VideoSocket()
@@ -20,6 +25,18 @@ VideoSocket::~VideoSocket()
 void VideoSocket::requestStop()
 {
     m_stopRequested.store(true);
+    if (m_uring) {
+        m_uring->requestStop();
+    }
+}
+
+void VideoSocket::close()
+{
+    // io_uring 持有 socket 的引用，先释放才能让 close 真正断开连接
+    if (m_uring) {
+        m_uring->close();
+    }
+    QTcpSocket::close();
 }
 
 qint32 VideoSocket::subThreadRecvData(quint8 *buf, qint32 bufSize)
@@ -40,6 +57,17 @@ qint32 VideoSocket::subThreadRecvData(quint8 *buf, qint32 bufSize)
     // 120fps 下超时 50ms → 每 50ms 堆积 6 帧 → 只显示最后 1 帧 → 体感 20fps。
     static constexpr int WAIT_TIMEOUT_MS = 50;
 
+    if (!m_uringTried) {
+        m_uringTried = true;
+        // 失败时保留对象（requestStop 可能正在其他线程访问），只是不再使用
+        if (m_uring && !m_uring->open(static_cast<int>(socketDescriptor()))) {
+            qWarning("[VideoSocket] io_uring backend unavailable, falling back to QTcpSocket");
+        }
+    }
+    if (m_uring && m_uring->isOpen()) {
+        return uringRecvData(buf, bufSize);
+    }
+
     while (bytesAvailable() < bufSize) {
         if (m_stopRequested.load(std::memory_order_acquire)) {
             return 0;
@@ -53,3 +81,21 @@ qint32 VideoSocket::subThreadRecvData(quint8 *buf, qint32 bufSize)
 
     return read((char *)buf, bufSize);
 }
+
+qint32 VideoSocket::uringRecvData(quint8 *buf, qint32 bufSize)
+{
+    // 握手阶段 Qt 可能已多读了一部分到内部缓冲区，先交付；
+    // 之后不再调用 waitForReadyRead，Qt 不会再从 socket 读取
+    qint32 buffered = 0;
+    if (QTcpSocket::bytesAvailable() > 0) {
+        buffered = static_cast<qint32>(read((char *)buf, qMin<qint64>(bytesAvailable(), bufSize)));
+        if (buffered < 0) {
+            return -1;
+        }
+        if (buffered == bufSize) {
+            return bufSize;
+        }
+    }
+    const qint32 ret = m_uring->recv(buf + buffered, bufSize - buffered);
+    return ret > 0 ? bufSize : ret;
+}
@@ -3,6 +3,9 @@
 
 #include <QTcpSocket>
 #include <atomic>
+#include <memory>
+
+class TcpUringReceiver;
 
 /**
  * @brief TCP 视频接收 Socket / TCP Video Receive Socket
@@ -10,7 +13,9 @@
  * 用于 USB 模式下通过 adb forward 接收视频数据。
  * Receives video data via adb forward in USB mode.
  *
- * 使用 waitForReadyRead() 进行 OS 级 socket 阻塞等待，
+ * Linux 上优先使用 io_uring 接收（TcpUringReceiver：提供缓冲区环 + 多发 recv），
+ * 数据直接从内核缓冲区拷到 Demuxer 的 AVPacket，无 50ms 守卫等待；
+ * 不可用时回退到 waitForReadyRead() 进行 OS 级 socket 阻塞等待，
  * 不依赖 Qt 事件循环（Demuxer 线程无事件循环），
  * 数据到达时立即返回（微秒级延迟）。
  */
@@ -36,8 +41,20 @@ public:
      */
     void requestStop();
 
+    /**
+     * @brief 关闭（先释放 io_uring，再关闭 socket）
+     */
+    void close() override;
+
+private:
+    qint32 uringRecvData(quint8 *buf, qint32 bufSize);
+
 private:
     std::atomic<bool> m_stopRequested{false};
+
+    // io_uring 后端：构造时创建（requestStop 可跨线程访问），首次接收时在 Demuxer 线程打开
+    std::unique_ptr<TcpUringReceiver> m_uring;
+    bool m_uringTried = false;
 };
 
 #endif // VIDEOSOCKET_H
@@ -534,6 +534,9 @@ public:
         json["key"] = m_key;
         json["speedRatioX"] = m_speedX;
         json["speedRatioY"] = m_speedY;
+        // 移动重采样参数没有编辑界面，手动写在键位文件中，保存时原样保留
+        if (m_moveRateHz > 0) json["moveRateHz"] = m_moveRateHz;
+        if (m_predictMs > 0) json["predictMs"] = m_predictMs;
         return json;
     }
 
@@ -541,6 +544,8 @@ public:
         if (json.contains("key")) m_key = json["key"].toString();
         if (json.contains("speedRatioX")) m_speedX = json["speedRatioX"].toDouble();
         if (json.contains("speedRatioY")) m_speedY = json["speedRatioY"].toDouble();
+        if (json.contains("moveRateHz")) m_moveRateHz = json["moveRateHz"].toDouble();
+        if (json.contains("predictMs")) m_predictMs = json["predictMs"].toDouble();
     }
 
     QString getKey() const override { return m_key; }
@@ -606,6 +611,8 @@ protected:
 private:
     double m_speedX = 1.0;
     double m_speedY = 1.0;
+    double m_moveRateHz = 0.0;
+    double m_predictMs = 0.0;
     bool m_isEditing = false; bool m_showCursor = false;
     EditMode m_editMode = Edit_None;
     QString m_displayKey;
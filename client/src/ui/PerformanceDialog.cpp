@@ -49,12 +49,16 @@ void PerformanceDialog::setupUI()
     m_renderLatencyLabel = new QLabel("0.0 ms", this);
     m_framesLabel = new QLabel("0", this);
     m_droppedLabel = new QLabel("0", this);
+    m_captureLatencyLabel = new QLabel("-", this);
+    m_glassToGlassLabel = new QLabel("-", this);
 
     m_fpsNameLabel = new QLabel(this);
     m_decodeNameLabel = new QLabel(this);
     m_renderNameLabel = new QLabel(this);
     m_framesNameLabel = new QLabel(this);
     m_droppedNameLabel = new QLabel(this);
+    m_captureNameLabel = new QLabel(this);
+    m_glassNameLabel = new QLabel(this);
 
     videoLayout->addWidget(m_fpsNameLabel, 0, 0);
     videoLayout->addWidget(m_fpsLabel, 0, 1);
@@ -66,6 +70,10 @@ void PerformanceDialog::setupUI()
     videoLayout->addWidget(m_framesLabel, 3, 1);
     videoLayout->addWidget(m_droppedNameLabel, 4, 0);
     videoLayout->addWidget(m_droppedLabel, 4, 1);
+    videoLayout->addWidget(m_captureNameLabel, 5, 0);
+    videoLayout->addWidget(m_captureLatencyLabel, 5, 1);
+    videoLayout->addWidget(m_glassNameLabel, 6, 0);
+    videoLayout->addWidget(m_glassToGlassLabel, 6, 1);
 
     mainLayout->addWidget(m_videoGroup);
 
@@ -78,8 +86,10 @@ void PerformanceDialog::setupUI()
     m_bytesSentLabel = new QLabel("0 KB", this);
     m_bytesReceivedLabel = new QLabel("0 KB", this);
     m_pendingLabel = new QLabel("0 bytes", this);
+    m_clockOffsetLabel = new QLabel("-", this);
 
     m_netLatencyNameLabel = new QLabel(this);
+    m_clockNameLabel = new QLabel(this);
     m_sentNameLabel = new QLabel(this);
     m_recvNameLabel = new QLabel(this);
     m_pendingNameLabel = new QLabel(this);
@@ -92,6 +102,8 @@ void PerformanceDialog::setupUI()
     networkLayout->addWidget(m_bytesReceivedLabel, 2, 1);
     networkLayout->addWidget(m_pendingNameLabel, 3, 0);
     networkLayout->addWidget(m_pendingLabel, 3, 1);
+    networkLayout->addWidget(m_clockNameLabel, 4, 0);
+    networkLayout->addWidget(m_clockOffsetLabel, 4, 1);
 
     mainLayout->addWidget(m_networkGroup);
 
@@ -232,8 +244,24 @@ void PerformanceDialog::updateMetrics(const PerformanceMetrics& m)
         m_droppedLabel->setStyleSheet("color: #a1a1aa;");
     }
 
+    // 采集→接收由设备 PTS 经时钟同步换算；端到端 = 采集→接收 + 解码 + 渲染
+    if (m.clockSynced && m.captureLatencyMs > 0) {
+        m_captureLatencyLabel->setText(QString("%1 ms").arg(m.captureLatencyMs, 0, 'f', 1));
+        m_glassToGlassLabel->setText(QString("%1 ms").arg(
+            m.captureLatencyMs + m.avgDecodeLatencyMs + m.avgRenderLatencyMs, 0, 'f', 1));
+    } else {
+        m_captureLatencyLabel->setText("-");
+        m_glassToGlassLabel->setText("-");
+    }
+
     // 网络
     m_networkLatencyLabel->setText(QString("%1 ms").arg(m.networkLatencyMs, 0, 'f', 2));
+    if (m.clockSynced) {
+        m_clockOffsetLabel->setText(QString("%1 ms (%2 ppm)")
+            .arg(m.clockOffsetMs, 0, 'f', 1).arg(m.clockDriftPpm, 0, 'f', 1));
+    } else {
+        m_clockOffsetLabel->setText(tr("未同步"));
+    }
     m_bytesSentLabel->setText(QString("%1 MB").arg(m.bytesSent / 1048576.0, 0, 'f', 2));
     m_bytesReceivedLabel->setText(QString("%1 MB").arg(m.bytesReceived / 1048576.0, 0, 'f', 2));
     m_pendingLabel->setText(QString("%1 bytes").arg(m.pendingBytes));
@@ -292,12 +320,15 @@ void PerformanceDialog::retranslateUi()
     if (m_renderNameLabel) m_renderNameLabel->setText(tr("渲染延迟:"));
     if (m_framesNameLabel) m_framesNameLabel->setText(tr("总帧数:"));
     if (m_droppedNameLabel) m_droppedNameLabel->setText(tr("丢帧数:"));
+    if (m_captureNameLabel) m_captureNameLabel->setText(tr("采集→接收:"));
+    if (m_glassNameLabel) m_glassNameLabel->setText(tr("端到端:"));
 
     // 网络标签名
     if (m_netLatencyNameLabel) m_netLatencyNameLabel->setText(tr("延迟:"));
     if (m_sentNameLabel) m_sentNameLabel->setText(tr("发送:"));
     if (m_recvNameLabel) m_recvNameLabel->setText(tr("接收:"));
     if (m_pendingNameLabel) m_pendingNameLabel->setText(tr("待发送:"));
+    if (m_clockNameLabel) m_clockNameLabel->setText(tr("时钟偏移:"));
 
     // 输入标签名
     if (m_inputRateNameLabel) m_inputRateNameLabel->setText(tr("速率:"));
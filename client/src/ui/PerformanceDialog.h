@@ -39,9 +39,12 @@ private:
     QLabel* m_renderLatencyLabel = nullptr;
     QLabel* m_framesLabel = nullptr;
     QLabel* m_droppedLabel = nullptr;
+    QLabel* m_captureLatencyLabel = nullptr;
+    QLabel* m_glassToGlassLabel = nullptr;
 
     // 网络标签
     QLabel* m_networkLatencyLabel = nullptr;
+    QLabel* m_clockOffsetLabel = nullptr;
     QLabel* m_bytesSentLabel = nullptr;
     QLabel* m_bytesReceivedLabel = nullptr;
     QLabel* m_pendingLabel = nullptr;
@@ -67,8 +70,11 @@ private:
     QLabel* m_renderNameLabel = nullptr;
     QLabel* m_framesNameLabel = nullptr;
     QLabel* m_droppedNameLabel = nullptr;
+    QLabel* m_captureNameLabel = nullptr;
+    QLabel* m_glassNameLabel = nullptr;
     // 网络标签名
     QLabel* m_netLatencyNameLabel = nullptr;
+    QLabel* m_clockNameLabel = nullptr;
     QLabel* m_sentNameLabel = nullptr;
     QLabel* m_recvNameLabel = nullptr;
     QLabel* m_pendingNameLabel = nullptr;
@@ -494,6 +494,14 @@ void Dialog::onStartServer()
     params.logLevel = Config::getInstance().getLogLevel();
     params.codecOptions = Config::getInstance().getCodecOptions();
     params.codecName = Config::getInstance().getCodecName();
+    params.videoFec = Config::getInstance().getVideoFec();
+    Config::getInstance().getKcpFec(params.kcpFecData, params.kcpFecParity);
+    params.moveLaneCopies = static_cast<quint8>(Config::getInstance().getMoveLaneCopies());
+    // 多路径：USB 设备且填写了设备 IP 时，控制消息同时走 USB 和 WiFi
+    if (Config::getInstance().getMultipath() && !m_currentSerial.contains(':')) {
+        params.multipathIp = m_settingsDialog->getDeviceIP().section(':', 0, 0);
+        params.multipathDuplicate = Config::getInstance().getMultipathDuplicate();
+    }
     params.videoCodec = m_settingsDialog->getVideoCodecName();
     params.scid = QRandomGenerator::global()->bounded(1, 10000) & 0x7FFFFFFF;
 
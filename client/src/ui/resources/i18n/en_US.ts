@@ -122,6 +122,10 @@
     <message><source>重置统计</source><translation>Reset</translation></message>
     <message><source>关闭</source><translation>Close</translation></message>
     <message><source>秒</source><translation>sec</translation></message>
+    <message><source>采集→接收:</source><translation>Capture→Recv:</translation></message>
+    <message><source>端到端:</source><translation>Glass-to-glass:</translation></message>
+    <message><source>时钟偏移:</source><translation>Clock offset:</translation></message>
+    <message><source>未同步</source><translation>Not synced</translation></message>
 </context><context>
     <name>ScriptEditorDialog</name>
     <message><source>脚本编辑器</source><translation>Script Editor</translation></message>
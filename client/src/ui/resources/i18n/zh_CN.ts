@@ -122,6 +122,10 @@
     <message><source>重置统计</source><translation>重置统计</translation></message>
     <message><source>关闭</source><translation>关闭</translation></message>
     <message><source>秒</source><translation>秒</translation></message>
+    <message><source>采集→接收:</source><translation>采集→接收:</translation></message>
+    <message><source>端到端:</source><translation>端到端:</translation></message>
+    <message><source>时钟偏移:</source><translation>时钟偏移:</translation></message>
+    <message><source>未同步</source><translation>未同步</translation></message>
 </context>
 <context>
     <name>ScriptEditorDialog</name>
@@ -19,6 +19,7 @@
 #include <QDesktopServices>
 #include <QUrl>
 #include "ConfigCenter.h"
+#include "PerformanceDialog.h"
 
 // ---------------------------------------------------------
 // 可拖拽的标签 (DraggableLabel)
@@ -201,6 +202,16 @@ void ToolForm::initKeyMapPalette() {
     connect(m_antiDetectBtn, &QPushButton::clicked, this, &ToolForm::showAntiDetectSettings);
     layout->addWidget(m_antiDetectBtn);
 
+    // 性能监控（延迟、时钟同步等）
+    m_perfBtn = new QPushButton(tr("性能监控"), ui->page_keymap);
+    m_perfBtn->setMinimumHeight(32);
+    m_perfBtn->setStyleSheet(
+        "QPushButton{background:#27272a;color:#fafafa;border:1px solid #3f3f46;border-radius:6px;font-size:9px;}"
+        "QPushButton:hover{background:#3f3f46;border-color:#6366f1;}"
+    );
+    connect(m_perfBtn, &QPushButton::clicked, this, &ToolForm::showPerformanceDialog);
+    layout->addWidget(m_perfBtn);
+
     // 分隔线
     QFrame* separator = new QFrame(ui->page_keymap);
     separator->setFrameShape(QFrame::HLine);
@@ -526,6 +537,17 @@ void ToolForm::showAntiDetectSettings() {
 // 设备控制按钮槽函数
 // 发送ADB控制指令
 // ---------------------------------------------------------
+void ToolForm::showPerformanceDialog() {
+    // 非模态，重复点击只激活已有窗口
+    if (!m_perfDialog) {
+        m_perfDialog = new qsc::PerformanceDialog(this);
+        m_perfDialog->setAttribute(Qt::WA_DeleteOnClose);
+    }
+    m_perfDialog->show();
+    m_perfDialog->raise();
+    m_perfDialog->activateWindow();
+}
+
 void ToolForm::on_fullScreenBtn_clicked() {
     if (auto* vf = qobject_cast<VideoForm*>(parent())) {
         if (vf->session()) vf->switchFullScreen();
@@ -640,6 +662,7 @@ void ToolForm::retranslateUi()
         m_antiDetectBtn->setText(tr("设置"));
         m_antiDetectBtn->setToolTip(tr("打开设置面板"));
     }
+    if (m_perfBtn) m_perfBtn->setText(tr("性能监控"));
     if (m_refreshBtn) m_refreshBtn->setToolTip(tr("刷新配置列表"));
     if (m_folderBtn) m_folderBtn->setToolTip(tr("打开配置文件夹"));
     if (m_newConfigBtn) m_newConfigBtn->setToolTip(tr("新建配置"));
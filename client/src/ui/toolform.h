@@ -3,6 +3,7 @@
 #define TOOLFORM_H
 
 #include <QWidget>
+#include <QDialog>
 #include <QLabel>
 #include <QMouseEvent>
 #include <QComboBox>
@@ -65,6 +66,7 @@ private slots:
     void refreshConfig();
     void saveConfig();
     void showAntiDetectSettings();
+    void showPerformanceDialog();
     void openKeyMapFolder();
 
 private:
@@ -82,6 +84,8 @@ private:
     QPushButton* m_folderBtn = nullptr;
     QPushButton* m_antiDetectBtn = nullptr;
     QPushButton* m_overlayBtn = nullptr;
+    QPushButton* m_perfBtn = nullptr;
+    QPointer<QDialog> m_perfDialog;
     bool m_overlayVisible = false;
 
     // 可翻译的拖拽标签 / Translatable draggable labels
@@ -114,6 +114,11 @@ void VideoForm::bindSession(qsc::core::DeviceSession* session) {
         connect(m_session, &qsc::core::DeviceSession::frameAvailable,
                 this, &VideoForm::onSessionFrameAvailable, Qt::DirectConnection);
 
+        // 渲染端 NV12 能力告知解码端（GL 上下文未初始化前保持默认）
+        if (m_videoWidget && m_videoWidget->isNV12Probed()) {
+            m_session->setNV12Accepted(m_videoWidget->isNV12Supported());
+        }
+
         // 连接 FPS 更新信号
         connect(m_session, &qsc::core::DeviceSession::fpsUpdated,
                 this, &VideoForm::onSessionFpsUpdated);
@@ -190,23 +195,43 @@ void VideoForm::onSessionFrameAvailable() {
                 if (!m_currentKeyMapFile.isEmpty() && m_session) {
                     m_session->runAutoStartScripts();
                 }
+                // 输入宏（回归测试）：配置了路径时随首帧开始录制/回放
+                const auto& config = qsc::ConfigCenter::instance();
+                if (m_session && !config.inputMacroRecordPath().isEmpty()) {
+                    m_session->startMacroRecording(config.inputMacroRecordPath());
+                }
+                if (m_session && !config.inputMacroReplayPath().isEmpty()) {
+                    m_session->playMacro(config.inputMacroReplayPath(), config.inputMacroSpeed());
+                }
             }
         }, Qt::QueuedConnection);
     }
 
-    m_videoWidget->submitFrameDirect(
-        frame->dataY, frame->dataU, frame->dataV,
-        w, h,
-        frame->linesizeY, frame->linesizeU, frame->linesizeV,
-        [session = m_session, frame]() {
-            // paintGL 完成后归还帧（在 GUI 线程执行）
-            // 捕获 session 指针副本，避免依赖 VideoForm::m_session 生命周期
-            if (session) {
-                session->releaseFrame(frame);  // retain 的引用
-                session->releaseFrame(frame);  // consumeFrame 的引用
-            }
+    // 渲染完成后归还帧（在 GUI 线程执行）
+    // 捕获 session 指针副本，避免依赖 VideoForm::m_session 生命周期
+    auto release = [session = m_session, frame]() {
+        if (session) {
+            session->releaseFrame(frame);  // retain 的引用
+            session->releaseFrame(frame);  // consumeFrame 的引用
         }
-    );
+    };
+
+    if (frame->isNV12 && frame->dataUV) {
+        // NV12 直通：Y + UV 交织平面，由 NV12 着色器完成色彩转换
+        m_videoWidget->submitFrameDirectNV12(
+            frame->dataY, frame->dataUV,
+            w, h,
+            frame->linesizeY, frame->linesizeUV,
+            std::move(release)
+        );
+    } else {
+        m_videoWidget->submitFrameDirect(
+            frame->dataY, frame->dataU, frame->dataV,
+            w, h,
+            frame->linesizeY, frame->linesizeU, frame->linesizeV,
+            std::move(release)
+        );
+    }
 }
 
 void VideoForm::onSessionFpsUpdated(quint32 fps) {
@@ -258,6 +283,13 @@ void VideoForm::initUI() {
     m_videoWidget = new QYUVOpenGLWidget();
     m_videoWidget->hide();
 
+    // GL 上下文初始化后得知 NV12 着色器是否可用，同步给解码端
+    connect(m_videoWidget, &QYUVOpenGLWidget::nv12SupportDetected, this, [this](bool supported) {
+        if (m_session) {
+            m_session->setNV12Accepted(supported);
+        }
+    });
+
     // 设置保持比例容器
     ui->keepRatioWidget->setWidget(m_videoWidget);
     ui->keepRatioWidget->setWidthHeightRatio(m_widthHeightRatio);
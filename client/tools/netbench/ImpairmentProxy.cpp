@@ -0,0 +1,461 @@
+/**
+ * @file ImpairmentProxy.cpp
+ * @brief 本地网络损伤代理实现
+ */
+
+#include "ImpairmentProxy.h"
+#include <QtDebug>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <sstream>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace netbench {
+
+namespace {
+
+constexpr int MAX_DATAGRAM = 65536;
+constexpr int SOCKET_BUFFER = 4 * 1024 * 1024;
+constexpr int UDP_IP_OVERHEAD = 28;         // 带宽按线上字节计（IPv4 20B + UDP 8B）
+constexpr int IDLE_POLL_MS = 20;            // 空闲时检查 stop() 的间隔
+
+int64_t nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool parseDouble(const std::string &s, double *out)
+{
+    char *end = nullptr;
+    *out = std::strtod(s.c_str(), &end);
+    return end && *end == '\0' && !s.empty();
+}
+
+bool parseInt(const std::string &s, int *out)
+{
+    char *end = nullptr;
+    const long v = std::strtol(s.c_str(), &end, 10);
+    if (!end || *end != '\0' || s.empty()) return false;
+    *out = static_cast<int>(v);
+    return true;
+}
+
+std::vector<std::string> split(const std::string &s, char sep)
+{
+    std::vector<std::string> parts;
+    std::string part;
+    std::istringstream in(s);
+    while (std::getline(in, part, sep)) {
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ImpairmentProfile
+// ---------------------------------------------------------------------------
+
+bool ImpairmentProfile::parse(const std::string &spec, ImpairmentProfile *profile)
+{
+    ImpairmentProfile p;
+    if (spec.empty() || spec == "clean") {
+        *profile = p;
+        return true;
+    }
+    for (const std::string &field : split(spec, ',')) {
+        const size_t eq = field.find('=');
+        if (eq == std::string::npos) return false;
+        const std::string key = field.substr(0, eq);
+        const std::vector<std::string> values = split(field.substr(eq + 1), ':');
+        if (values.empty()) return false;
+
+        bool ok = true;
+        if (key == "loss") {
+            ok = parseDouble(values[0], &p.lossRate);
+        } else if (key == "ge") {
+            // ge=pGoodToBad[:pBadToGood[:lossGood[:lossBad]]]
+            double *targets[] = {&p.geGoodToBad, &p.geBadToGood, &p.geLossGood, &p.geLossBad};
+            for (size_t i = 0; i < values.size() && ok; ++i) {
+                ok = i < 4 && parseDouble(values[i], targets[i]);
+            }
+        } else if (key == "delay") {
+            ok = parseInt(values[0], &p.delayMs);
+        } else if (key == "jitter") {
+            ok = parseInt(values[0], &p.jitterMs);
+        } else if (key == "reorder") {
+            ok = parseDouble(values[0], &p.reorderRate)
+                 && (values.size() < 2 || parseInt(values[1], &p.reorderGapMs));
+        } else if (key == "rate") {
+            ok = parseInt(values[0], &p.rateKbps);
+        } else if (key == "queue") {
+            ok = parseInt(values[0], &p.queueMs);
+        } else {
+            ok = false;
+        }
+        if (!ok) return false;
+    }
+    *profile = p;
+    return true;
+}
+
+std::string ImpairmentProfile::describe() const
+{
+    char buf[256];
+    int n = 0;
+    auto append = [&](const char *fmt, auto... args) {
+        if (n < static_cast<int>(sizeof(buf))) {
+            n += std::snprintf(buf + n, sizeof(buf) - n, fmt, args...);
+        }
+    };
+    if (lossRate > 0) append("loss=%.3g ", lossRate);
+    if (geGoodToBad > 0) append("ge=%.3g:%.3g:%.3g:%.3g ", geGoodToBad, geBadToGood, geLossGood, geLossBad);
+    if (delayMs > 0) append("delay=%dms ", delayMs);
+    if (jitterMs > 0) append("jitter=%dms ", jitterMs);
+    if (reorderRate > 0) append("reorder=%.3g:%dms ", reorderRate, reorderGapMs);
+    if (rateKbps > 0) append("rate=%dkbps queue=%dms ", rateKbps, queueMs);
+    if (n == 0) return "clean";
+    return std::string(buf, std::min<size_t>(n - 1, sizeof(buf) - 1));
+}
+
+// ---------------------------------------------------------------------------
+// ImpairmentProxy
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief 单方向链路状态（仅转发线程访问，统计除外）
+ */
+struct ImpairmentProxy::Link {
+    ImpairmentProfile profile;
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> uniform{0.0, 1.0};
+    bool geBad = false;
+    int64_t linkFreeAtUs = 0;       // 瓶颈链路空闲时刻
+    int64_t lastReleaseUs = 0;      // 最近一个按序包的释放时刻
+
+    std::atomic<quint64> received{0};
+    std::atomic<quint64> forwarded{0};
+    std::atomic<quint64> lost{0};
+    std::atomic<quint64> queueDropped{0};
+    std::atomic<quint64> reordered{0};
+    std::atomic<quint64> bytes{0};
+
+    explicit Link(quint32 seed) : rng(seed) {}
+
+    /**
+     * @brief 决定一个数据报的命运
+     * @return 释放时刻（微秒），丢弃返回 -1
+     */
+    int64_t admit(int len, int64_t now)
+    {
+        received.fetch_add(1, std::memory_order_relaxed);
+
+        // 1. 丢包：先按当前状态判定，再转移状态
+        double lossProb = profile.lossRate;
+        if (profile.geGoodToBad > 0) {
+            const double geLoss = geBad ? profile.geLossBad : profile.geLossGood;
+            lossProb = 1.0 - (1.0 - lossProb) * (1.0 - geLoss);
+            if (geBad) {
+                geBad = uniform(rng) >= profile.geBadToGood;
+            } else {
+                geBad = uniform(rng) < profile.geGoodToBad;
+            }
+        }
+        if (lossProb > 0 && uniform(rng) < lossProb) {
+            lost.fetch_add(1, std::memory_order_relaxed);
+            return -1;
+        }
+
+        // 2. 带宽：串行化 + 尾部丢弃
+        int64_t depart = now;
+        if (profile.rateKbps > 0) {
+            const int64_t backlog = std::max<int64_t>(0, linkFreeAtUs - now);
+            if (backlog > static_cast<int64_t>(profile.queueMs) * 1000) {
+                queueDropped.fetch_add(1, std::memory_order_relaxed);
+                return -1;
+            }
+            const int64_t txUs = static_cast<int64_t>(len + UDP_IP_OVERHEAD) * 8 * 1000 / profile.rateKbps;
+            linkFreeAtUs = std::max(linkFreeAtUs, now) + txUs;
+            depart = linkFreeAtUs;
+        }
+
+        // 3. 延迟 + 抖动（不早于前一个包，保持包序）
+        int64_t release = depart + static_cast<int64_t>(profile.delayMs) * 1000;
+        if (profile.jitterMs > 0) {
+            const double j = (uniform(rng) * 2.0 - 1.0) * profile.jitterMs * 1000.0;
+            release = std::max(depart, release + static_cast<int64_t>(j));
+        }
+        release = std::max(release, lastReleaseUs);
+
+        // 4. 乱序：额外延后，不推进 lastReleaseUs，后续包因此反超
+        if (profile.reorderRate > 0 && uniform(rng) < profile.reorderRate) {
+            reordered.fetch_add(1, std::memory_order_relaxed);
+            return release + static_cast<int64_t>(profile.reorderGapMs) * 1000;
+        }
+        lastReleaseUs = release;
+        return release;
+    }
+};
+
+namespace {
+
+struct Pending {
+    int64_t releaseUs;
+    quint64 order;                  // 同一时刻按到达顺序释放
+    int dir;
+    std::vector<char> data;
+};
+
+struct PendingLater {
+    bool operator()(const Pending &a, const Pending &b) const
+    {
+        return a.releaseUs != b.releaseUs ? a.releaseUs > b.releaseUs : a.order > b.order;
+    }
+};
+
+} // namespace
+
+#ifdef Q_OS_LINUX
+struct ImpairmentProxy::Native {
+    int frontFd = -1;               // 面向对端（监听端口）
+    int backFd = -1;                // 面向上游（已 connect）
+    sockaddr_in peer {};
+    bool hasPeer = false;
+    std::priority_queue<Pending, std::vector<Pending>, PendingLater> queue;
+    quint64 order = 0;
+    std::vector<char> buffer = std::vector<char>(MAX_DATAGRAM);
+
+    ~Native()
+    {
+        if (frontFd >= 0) ::close(frontFd);
+        if (backFd >= 0) ::close(backFd);
+    }
+};
+#else
+struct ImpairmentProxy::Native {
+};
+#endif
+
+ImpairmentProxy::ImpairmentProxy()
+{
+    for (auto &link : m_links) {
+        link = std::make_unique<Link>(m_seed);
+    }
+}
+
+ImpairmentProxy::~ImpairmentProxy()
+{
+    stop();
+}
+
+void ImpairmentProxy::setProfile(Direction dir, const ImpairmentProfile &profile)
+{
+    m_links[dir]->profile = profile;
+}
+
+ImpairmentProxy::Stats ImpairmentProxy::stats(Direction dir) const
+{
+    const Link &link = *m_links[dir];
+    Stats s;
+    s.received = link.received.load(std::memory_order_relaxed);
+    s.forwarded = link.forwarded.load(std::memory_order_relaxed);
+    s.lost = link.lost.load(std::memory_order_relaxed);
+    s.queueDropped = link.queueDropped.load(std::memory_order_relaxed);
+    s.reordered = link.reordered.load(std::memory_order_relaxed);
+    s.bytes = link.bytes.load(std::memory_order_relaxed);
+    return s;
+}
+
+#ifdef Q_OS_LINUX
+
+bool ImpairmentProxy::start(quint16 listenPort, const QHostAddress &upstream, quint16 upstreamPort)
+{
+    stop();
+
+    for (int dir = 0; dir < 2; ++dir) {
+        const ImpairmentProfile profile = m_links[dir]->profile;
+        // 两个方向用不同的随机序列，同一 seed 可复现
+        m_links[dir] = std::make_unique<Link>(m_seed * 2654435761u + static_cast<quint32>(dir));
+        m_links[dir]->profile = profile;
+    }
+
+    auto native = std::make_unique<Native>();
+    native->frontFd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    native->backFd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (native->frontFd < 0 || native->backFd < 0) {
+        qWarning("[ImpairmentProxy] socket() failed: %s", strerror(errno));
+        return false;
+    }
+    for (int fd : {native->frontFd, native->backFd}) {
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &SOCKET_BUFFER, sizeof(SOCKET_BUFFER));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &SOCKET_BUFFER, sizeof(SOCKET_BUFFER));
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(listenPort);
+    if (::bind(native->frontFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        qWarning("[ImpairmentProxy] bind(%u) failed: %s", listenPort, strerror(errno));
+        return false;
+    }
+    socklen_t addrLen = sizeof(addr);
+    ::getsockname(native->frontFd, reinterpret_cast<sockaddr *>(&addr), &addrLen);
+    m_listenPort = ntohs(addr.sin_port);
+
+    sockaddr_in up;
+    memset(&up, 0, sizeof(up));
+    up.sin_family = AF_INET;
+    up.sin_addr.s_addr = htonl(upstream.toIPv4Address());
+    up.sin_port = htons(upstreamPort);
+    if (::connect(native->backFd, reinterpret_cast<sockaddr *>(&up), sizeof(up)) < 0) {
+        qWarning("[ImpairmentProxy] connect(upstream:%u) failed: %s", upstreamPort, strerror(errno));
+        return false;
+    }
+
+    m_native = std::move(native);
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread(&ImpairmentProxy::run, this);
+
+    qInfo("[ImpairmentProxy] :%u -> :%u, up[%s] down[%s]", m_listenPort, upstreamPort,
+          m_links[ToUpstream]->profile.describe().c_str(),
+          m_links[ToPeer]->profile.describe().c_str());
+    return true;
+}
+
+void ImpairmentProxy::stop()
+{
+    m_running.store(false, std::memory_order_release);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_native.reset();
+}
+
+void ImpairmentProxy::run()
+{
+    Native &n = *m_native;
+
+    auto forward = [&](const Pending &p) {
+        ssize_t sent;
+        if (p.dir == ToUpstream) {
+            sent = ::send(n.backFd, p.data.data(), p.data.size(), 0);
+        } else {
+            if (!n.hasPeer) return;
+            sent = ::sendto(n.frontFd, p.data.data(), p.data.size(), 0,
+                            reinterpret_cast<const sockaddr *>(&n.peer), sizeof(n.peer));
+        }
+        // 上游尚未绑定时 ICMP 不可达会使已 connect 的套接字报 ECONNREFUSED，视为丢包
+        if (sent > 0) {
+            Link &link = *m_links[p.dir];
+            link.forwarded.fetch_add(1, std::memory_order_relaxed);
+            link.bytes.fetch_add(static_cast<quint64>(sent), std::memory_order_relaxed);
+        }
+    };
+
+    auto ingest = [&](int dir, int len) {
+        const int64_t now = nowUs();
+        const int64_t release = m_links[dir]->admit(len, now);
+        if (release < 0) return;
+        Pending p{release, n.order++, dir, std::vector<char>(n.buffer.data(), n.buffer.data() + len)};
+        if (release <= now && n.queue.empty()) {
+            forward(p);
+        } else {
+            n.queue.push(std::move(p));
+        }
+    };
+
+    pollfd fds[2];
+    fds[0].fd = n.frontFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = n.backFd;
+    fds[1].events = POLLIN;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        // 释放到期的包
+        int64_t now = nowUs();
+        while (!n.queue.empty() && n.queue.top().releaseUs <= now) {
+            forward(n.queue.top());
+            n.queue.pop();
+        }
+
+        // 按下一个释放时刻等待（微秒精度）
+        timespec timeout;
+        int64_t waitUs = static_cast<int64_t>(IDLE_POLL_MS) * 1000;
+        if (!n.queue.empty()) {
+            waitUs = std::min(waitUs, std::max<int64_t>(0, n.queue.top().releaseUs - now));
+        }
+        timeout.tv_sec = 0;
+        timeout.tv_nsec = static_cast<long>(waitUs * 1000);
+        const int ready = ::ppoll(fds, 2, &timeout, nullptr);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            qWarning("[ImpairmentProxy] ppoll failed: %s", strerror(errno));
+            break;
+        }
+        if (ready == 0) continue;
+
+        if (fds[0].revents & POLLIN) {
+            for (;;) {
+                sockaddr_in from;
+                socklen_t fromLen = sizeof(from);
+                const ssize_t len = ::recvfrom(n.frontFd, n.buffer.data(), n.buffer.size(), 0,
+                                               reinterpret_cast<sockaddr *>(&from), &fromLen);
+                if (len < 0) break;
+                n.peer = from;
+                n.hasPeer = true;
+                ingest(ToUpstream, static_cast<int>(len));
+            }
+        }
+        if (fds[1].revents & (POLLIN | POLLERR)) {
+            for (;;) {
+                const ssize_t len = ::recv(n.backFd, n.buffer.data(), n.buffer.size(), 0);
+                if (len < 0) {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                    continue;   // ECONNREFUSED 等异步错误：已被取出，继续读
+                }
+                ingest(ToPeer, static_cast<int>(len));
+            }
+        }
+    }
+}
+
+#else // !Q_OS_LINUX
+
+bool ImpairmentProxy::start(quint16 listenPort, const QHostAddress &upstream, quint16 upstreamPort)
+{
+    Q_UNUSED(listenPort);
+    Q_UNUSED(upstream);
+    Q_UNUSED(upstreamPort);
+    qWarning("[ImpairmentProxy] not supported on this platform");
+    return false;
+}
+
+void ImpairmentProxy::stop()
+{
+}
+
+void ImpairmentProxy::run()
+{
+}
+
+#endif
+
+} // namespace netbench
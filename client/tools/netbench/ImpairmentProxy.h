@@ -0,0 +1,128 @@
+/**
+ * @file ImpairmentProxy.h
+ * @brief 本地网络损伤代理 / Local UDP network impairment proxy
+ *
+ * 在回环上模拟 WiFi/蜂窝链路，供传输基准（netbench）和设备替身复现弱网问题，
+ * 不依赖 tc/netem 或 root 权限。代理监听一个本地端口，把收到的数据报转发给上游，
+ * 上游的回包再转发给最近一次发包的对端；两个方向各自配置一套损伤参数。
+ *
+ * 每个数据报依次经过 / Per-datagram pipeline:
+ * 1. 丢包：独立随机丢包 + Gilbert-Elliott 两状态突发丢包（好/坏状态各有丢包率）
+ * 2. 带宽：按 rateKbps 串行化，链路排队超过 queueMs 尾部丢弃（模拟 AP 缓冲）
+ * 3. 延迟：固定延迟 + 均匀抖动；抖动不改变包序（与真实链路一致，排队不会反超）
+ * 4. 乱序：以 reorderRate 概率额外延后 reorderGapMs，让后续包反超
+ *
+ * 仅 Linux 可用（poll + 非阻塞 UDP），其他平台 start() 返回 false。
+ */
+
+#ifndef IMPAIRMENT_PROXY_H
+#define IMPAIRMENT_PROXY_H
+
+#include <QtGlobal>
+#include <QHostAddress>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace netbench {
+
+/**
+ * @brief 单方向损伤参数
+ */
+struct ImpairmentProfile {
+    double lossRate = 0.0;          // 独立随机丢包率
+
+    // Gilbert-Elliott：每个包之后按转移概率切换状态
+    double geGoodToBad = 0.0;       // 0 表示不启用
+    double geBadToGood = 0.3;
+    double geLossGood = 0.0;
+    double geLossBad = 0.5;
+
+    int delayMs = 0;
+    int jitterMs = 0;               // 均匀分布 [-jitter, +jitter]
+
+    double reorderRate = 0.0;
+    int reorderGapMs = 5;
+
+    int rateKbps = 0;               // 0 表示不限速
+    int queueMs = 100;              // 瓶颈队列深度（按当前速率折算为时长）
+
+    /**
+     * @brief 按 "loss=0.02,ge=0.01:0.3:0:0.5,delay=20,jitter=5,reorder=0.01:5,rate=20000,queue=80" 解析
+     *
+     * 未出现的字段保持默认值；"clean" 或空串表示无损伤。
+     * @return 有无法识别的字段时返回 false
+     */
+    static bool parse(const std::string &spec, ImpairmentProfile *profile);
+    std::string describe() const;
+};
+
+/**
+ * @brief UDP 损伤代理（独立 poll 线程）
+ */
+class ImpairmentProxy
+{
+public:
+    enum Direction {
+        ToUpstream = 0,             // 对端 → 上游
+        ToPeer = 1,                 // 上游 → 对端
+    };
+
+    struct Stats {
+        quint64 received = 0;
+        quint64 forwarded = 0;
+        quint64 lost = 0;           // 随机/突发丢包
+        quint64 queueDropped = 0;   // 瓶颈队列溢出
+        quint64 reordered = 0;
+        quint64 bytes = 0;          // 已转发字节
+    };
+
+    ImpairmentProxy();
+    ~ImpairmentProxy();
+
+    ImpairmentProxy(const ImpairmentProxy &) = delete;
+    ImpairmentProxy &operator=(const ImpairmentProxy &) = delete;
+
+    /**
+     * @brief 设置某方向的损伤参数（start() 之前调用）
+     */
+    void setProfile(Direction dir, const ImpairmentProfile &profile);
+    void setSeed(quint32 seed) { m_seed = seed; }
+
+    /**
+     * @brief 绑定监听端口并启动转发线程
+     * @param listenPort 本地监听端口，0 表示随机
+     * @param upstream 上游地址（仅 IPv4）
+     */
+    bool start(quint16 listenPort, const QHostAddress &upstream, quint16 upstreamPort);
+    void stop();
+
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+    quint16 listenPort() const { return m_listenPort; }
+
+    /**
+     * @brief 统计（任意线程）
+     */
+    Stats stats(Direction dir) const;
+
+private:
+    struct Link;
+    struct Native;
+
+    void run();
+
+private:
+    quint32 m_seed = 1;
+    quint16 m_listenPort = 0;
+    std::unique_ptr<Link> m_links[2];
+    std::unique_ptr<Native> m_native;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+};
+
+} // namespace netbench
+
+#endif // IMPAIRMENT_PROXY_H
@@ -0,0 +1,171 @@
+/**
+ * @file UdpVideoStreamer.cpp
+ * @brief UDP 视频发送端实现
+ */
+
+#include "UdpVideoStreamer.h"
+#include <QVariant>
+#include <QtDebug>
+
+#include <algorithm>
+#include <cstring>
+
+namespace netbench {
+
+UdpVideoStreamer::UdpVideoStreamer() = default;
+
+UdpVideoStreamer::~UdpVideoStreamer()
+{
+    close();
+}
+
+void UdpVideoStreamer::setFecEnabled(bool enabled, int k, int m)
+{
+    if (enabled) {
+        m_fec = std::make_unique<fec::SeqFecEncoder>(1 + MAX_PAYLOAD, k, m);
+    } else {
+        m_fec.reset();
+    }
+}
+
+void UdpVideoStreamer::setFecParams(int k, int m)
+{
+    if (m_fec) {
+        m_fec->setParams(k, m);
+    }
+}
+
+void UdpVideoStreamer::onFecReport(int lossPermille, int avgBurstX10, int maxBurst, int recovered, int unrecovered)
+{
+    if (!m_fec) return;
+
+    const int oldK = m_fec->groupSize();
+    const int oldM = m_fec->parityCount();
+    int k;
+    int m;
+    if (lossPermille == 0 && unrecovered == 0) {
+        m_cleanReports = std::min(m_cleanReports + 1, FEC_CLEAN_REPORTS);
+        k = oldK;
+        m = m_cleanReports >= FEC_CLEAN_REPORTS ? 0 : oldM;
+    } else {
+        m_cleanReports = 0;
+        k = lossPermille >= FEC_LOSSY_PERMILLE ? FEC_K_LOSSY : FEC_K_CLEAN;
+        // 每组期望丢包数 × 2 的余量，至少覆盖观测到的最长突发
+        const int expected = (k * lossPermille * 2 + 999) / 1000;
+        m = std::max(expected, std::min(maxBurst, fec::SEQ_FEC_MAX_PARITY));
+        if (unrecovered > 0) {
+            m = std::max(m, oldM + 1);
+        }
+        m = std::max(1, std::min(m, fec::SEQ_FEC_MAX_PARITY));
+    }
+
+    if (k != oldK || m != oldM) {
+        m_fec->setParams(k, m);
+        qInfo("[UdpVideoStreamer] FEC %d:%d -> %d:%d (loss=%.1f%%, burst=%.1f/%d, recovered=%d, unrecovered=%d)",
+              oldK, oldM, k, m, lossPermille / 10.0, avgBurstX10 / 10.0, maxBurst, recovered, unrecovered);
+    }
+}
+
+bool UdpVideoStreamer::open(const QHostAddress &host, quint16 port, int sendBufferSize)
+{
+    close();
+    m_socket = std::make_unique<QUdpSocket>();
+    if (!m_socket->bind(QHostAddress::AnyIPv4, 0)) {
+        qWarning("[UdpVideoStreamer] bind failed: %s", qPrintable(m_socket->errorString()));
+        m_socket.reset();
+        return false;
+    }
+    m_socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, QVariant(sendBufferSize));
+    m_host = host;
+    m_port = port;
+    m_seq = 0;
+    m_stats = Stats();
+    return true;
+}
+
+void UdpVideoStreamer::close()
+{
+    if (m_socket) {
+        m_socket->close();
+        m_socket.reset();
+    }
+}
+
+bool UdpVideoStreamer::sendFrame(const uint8_t *data, int len, qint64 ptsUs, bool config, bool keyFrame)
+{
+    if (!m_socket || len < 0) return false;
+
+    quint64 ptsAndFlags = config ? PACKET_FLAG_CONFIG : static_cast<quint64>(ptsUs);
+    if (!config && keyFrame) {
+        ptsAndFlags |= PACKET_FLAG_KEY_FRAME;
+    }
+
+    const size_t total = static_cast<size_t>(FRAME_META_SIZE) + len;
+    if (m_frameBuffer.size() < total) {
+        m_frameBuffer.resize(total);
+    }
+    uint8_t *buf = m_frameBuffer.data();
+    for (int i = 0; i < 8; ++i) {
+        buf[i] = static_cast<uint8_t>(ptsAndFlags >> (56 - 8 * i));
+    }
+    buf[8] = static_cast<uint8_t>(len >> 24);
+    buf[9] = static_cast<uint8_t>(len >> 16);
+    buf[10] = static_cast<uint8_t>(len >> 8);
+    buf[11] = static_cast<uint8_t>(len);
+    if (len > 0) {
+        memcpy(buf + FRAME_META_SIZE, data, len);
+    }
+
+    m_stats.frames++;
+    return sendRaw(buf, static_cast<int>(total));
+}
+
+bool UdpVideoStreamer::sendRaw(const uint8_t *data, int len)
+{
+    if (!m_socket || len <= 0) return false;
+
+    int pos = 0;
+    while (pos < len) {
+        const int chunk = std::min(len - pos, MAX_PAYLOAD);
+        const bool first = pos == 0;
+        const bool last = pos + chunk == len;
+        const bool protect = m_fec && m_fec->beginPacket();
+        const uint32_t seq = m_seq++;
+
+        m_packet[0] = static_cast<uint8_t>(seq >> 24);
+        m_packet[1] = static_cast<uint8_t>(seq >> 16);
+        m_packet[2] = static_cast<uint8_t>(seq >> 8);
+        m_packet[3] = static_cast<uint8_t>(seq);
+        uint8_t flags = 0;
+        if (first) flags |= FLAG_SOF;
+        if (last) flags |= FLAG_EOF;
+        if (protect) flags |= fec::SEQ_FEC_FLAG_PROTECTED;
+        m_packet[4] = flags;
+        memcpy(m_packet + SEQ_HEADER_SIZE, data + pos, chunk);
+
+        sendDatagram(m_packet, SEQ_HEADER_SIZE + chunk);
+        m_stats.packets++;
+
+        // 累加校验（分组满或帧尾时发出校验包）
+        if (protect) {
+            m_fec->addPacket(seq, m_packet + 4, 1 + chunk, last, [this](const uint8_t *parity, int parityLen) {
+                sendDatagram(parity, parityLen);
+                m_stats.parityPackets++;
+            });
+        }
+        pos += chunk;
+    }
+    return true;
+}
+
+void UdpVideoStreamer::sendDatagram(const uint8_t *data, int len)
+{
+    const qint64 sent = m_socket->writeDatagram(reinterpret_cast<const char *>(data), len, m_host, m_port);
+    if (sent == len) {
+        m_stats.bytes += static_cast<quint64>(len);
+    } else {
+        m_stats.sendErrors++;
+    }
+}
+
+} // namespace netbench
@@ -0,0 +1,109 @@
+/**
+ * @file UdpVideoStreamer.h
+ * @brief UDP 视频发送端（C++ 版 UdpVideoSender）/ C++ port of the device-side UDP video sender
+ *
+ * 与服务端 UdpVideoSender 线上格式一致：
+ *   每个 UDP 包 = [uint32 seq][uint8 flags][payload ≤ 1395B]，flags 含 SOF/EOF/PROTECTED，
+ *   帧数据前置 12B 帧头 [PTS+flags(8)][size(4)]，可选序号分组 FEC（fec::SeqFecEncoder）。
+ *
+ * 用于本地工具在没有真机的情况下驱动 UdpVideoClient（传输基准、设备替身）。
+ * 非线程安全：open()/sendFrame() 在同一线程调用；setFecParams() 可在任意线程调用。
+ */
+
+#ifndef UDP_VIDEO_STREAMER_H
+#define UDP_VIDEO_STREAMER_H
+
+#include <QHostAddress>
+#include <QUdpSocket>
+#include <memory>
+#include <vector>
+
+#include "FecCodec.h"
+
+namespace netbench {
+
+class UdpVideoStreamer
+{
+public:
+    static constexpr int MTU = 1400;
+    static constexpr int SEQ_HEADER_SIZE = 5;
+    static constexpr int MAX_PAYLOAD = MTU - SEQ_HEADER_SIZE;
+    static constexpr int FRAME_META_SIZE = 12;
+    static constexpr uint8_t FLAG_SOF = 0x01;
+    static constexpr uint8_t FLAG_EOF = 0x02;
+    static constexpr quint64 PACKET_FLAG_CONFIG = 1ULL << 63;
+    static constexpr quint64 PACKET_FLAG_KEY_FRAME = 1ULL << 62;
+
+    // 自适应 FEC 边界（与 UdpVideoSender 一致）
+    static constexpr int FEC_K_CLEAN = 16;
+    static constexpr int FEC_K_LOSSY = 8;
+    static constexpr int FEC_LOSSY_PERMILLE = 30;
+    static constexpr int FEC_CLEAN_REPORTS = 3;
+
+    struct Stats {
+        quint64 frames = 0;
+        quint64 packets = 0;
+        quint64 parityPackets = 0;
+        quint64 bytes = 0;          // 含 5B 序号头和校验包
+        quint64 sendErrors = 0;
+    };
+
+    UdpVideoStreamer();
+    ~UdpVideoStreamer();
+
+    UdpVideoStreamer(const UdpVideoStreamer &) = delete;
+    UdpVideoStreamer &operator=(const UdpVideoStreamer &) = delete;
+
+    /**
+     * @brief 启用序号分组 FEC（open() 之前调用；m=0 表示协商启用但暂不发校验）
+     */
+    void setFecEnabled(bool enabled, int k = 16, int m = 1);
+
+    /**
+     * @brief 调整 FEC 参数（任意线程，下一个分组边界生效）
+     */
+    void setFecParams(int k, int m);
+
+    /**
+     * @brief 客户端丢包回报（FEC_REPORT），按 UdpVideoSender::onFecReport 的策略调整 k/m
+     */
+    void onFecReport(int lossPermille, int avgBurstX10, int maxBurst, int recovered, int unrecovered);
+
+    bool fecEnabled() const { return m_fec != nullptr; }
+    int fecGroupSize() const { return m_fec ? m_fec->groupSize() : 0; }
+    int fecParityCount() const { return m_fec ? m_fec->parityCount() : 0; }
+
+    bool open(const QHostAddress &host, quint16 port, int sendBufferSize = 4 * 1024 * 1024);
+    void close();
+
+    /**
+     * @brief 发送一帧（前置 12B 帧头）
+     * @param ptsUs 编码器 PTS（微秒），config 帧忽略
+     */
+    bool sendFrame(const uint8_t *data, int len, qint64 ptsUs, bool config, bool keyFrame);
+
+    /**
+     * @brief 原样分片发送（不加帧头，用于 codec meta 等）
+     */
+    bool sendRaw(const uint8_t *data, int len);
+
+    Stats stats() const { return m_stats; }
+
+private:
+    void sendDatagram(const uint8_t *data, int len);
+
+private:
+    std::unique_ptr<QUdpSocket> m_socket;
+    QHostAddress m_host;
+    quint16 m_port = 0;
+    uint32_t m_seq = 0;
+    std::unique_ptr<fec::SeqFecEncoder> m_fec;
+    int m_cleanReports = 0;
+    std::vector<uint8_t> m_frameBuffer;
+    uint8_t m_packet[MTU] = {};
+    Stats m_stats;
+};
+
+} // namespace netbench
+
+#endif // UDP_VIDEO_STREAMER_H
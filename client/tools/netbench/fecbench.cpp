@@ -0,0 +1,319 @@
+/**
+ * @file fecbench.cpp
+ * @brief FEC 编解码吞吐基准 / FEC codec throughput benchmark
+ *
+ * 对 FecEncoder / FecDecoder 逐个 k:m 方案测量编码与解码吞吐（按原始负载字节计）：
+ *   - 编码：连续编码整组数据包，含校验增量累加
+ *   - 解码：每组丢弃前 m 个数据包（XOR 为 1 个），全部依靠校验恢复（最坏情况），
+ *           并校验恢复出的负载与原始数据一致
+ *
+ * FecCodec.h 按编译期宏选择 GF(2^8) 内核（__AVX2__ / __SSSE3__ / 标量查表），
+ * 因此本工具按指令集各编译一份：qsc_fecbench_scalar / _ssse3 / _avx2，输出首行标明内核。
+ *
+ * --check 只做正确性检查，失败时返回非 0：
+ *   - 零分配：替换全局 operator new 计数，预热后稳态解码（无丢包 / 丢包恢复）不得有堆分配
+ *   - 参数不一致：对端 k:m 超出解码器上限时数据包仍须全部交付
+ *
+ * 用法 / Usage:
+ *   qsc_fecbench_avx2 [--codes 10:1,16:1,8:3,10:3,16:4,32:8] [--size 1200] [--seconds 0.5]
+ *   qsc_fecbench_avx2 --check
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "FecCodec.h"
+
+// 全局堆分配计数（单线程使用）
+static unsigned long long g_allocCount = 0;
+
+void* operator new(std::size_t size)
+{
+    ++g_allocCount;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+struct Code {
+    int k;
+    int m;
+};
+
+const char* kernelName()
+{
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSSE3__)
+    return "ssse3";
+#elif defined(__SSE2__)
+    return "scalar (xor sse2)";
+#else
+    return "scalar";
+#endif
+}
+
+double nowSec()
+{
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+}
+
+bool parseCodes(const char* spec, std::vector<Code>* codes)
+{
+    codes->clear();
+    std::string s(spec);
+    size_t pos = 0;
+    while (pos < s.size()) {
+        size_t end = s.find(',', pos);
+        if (end == std::string::npos) end = s.size();
+        int k = 0;
+        int m = 0;
+        if (std::sscanf(s.substr(pos, end - pos).c_str(), "%d:%d", &k, &m) != 2 ||
+            k < 1 || k > fec::FEC_RS_MAX_DATA || m < 1 || m > fec::FEC_RS_MAX_PARITY) {
+            return false;
+        }
+        codes->push_back({k, m});
+        pos = end + 1;
+    }
+    return !codes->empty();
+}
+
+struct Encoded {
+    std::vector<std::vector<uint8_t>> packets;  // 一组的编码输出（k 个数据包 + 校验包）
+};
+
+/**
+ * 预编码若干组作为解码输入；每组数据包长度在 [size/2, size] 间变化，覆盖短分片补零路径
+ */
+std::vector<Encoded> encodeGroups(const Code& code, int size, int groups, std::vector<std::vector<uint8_t>>* payloads)
+{
+    std::mt19937 rng(1);
+    fec::FecEncoder encoder(code.k, size + fec::FEC_RS_HEADER_SIZE, code.m);
+    std::vector<Encoded> out(groups);
+    payloads->clear();
+    for (int g = 0; g < groups; ++g) {
+        for (int i = 0; i < code.k; ++i) {
+            std::vector<uint8_t> payload(size / 2 + rng() % (size / 2 + 1));
+            for (auto& b : payload) b = static_cast<uint8_t>(rng());
+            encoder.encode(payload.data(), static_cast<int>(payload.size()), [&](const uint8_t* data, int len) {
+                out[g].packets.emplace_back(data, data + len);
+            });
+            payloads->push_back(std::move(payload));
+        }
+    }
+    return out;
+}
+
+void benchEncode(const Code& code, int size, double seconds)
+{
+    std::vector<uint8_t> payload(size);
+    std::mt19937 rng(2);
+    for (auto& b : payload) b = static_cast<uint8_t>(rng());
+    fec::FecEncoder encoder(code.k, size + fec::FEC_RS_HEADER_SIZE, code.m);
+
+    unsigned long long bytes = 0;
+    volatile uint8_t sink = 0;      // 防止输出回调被优化掉
+    const double start = nowSec();
+    double elapsed = 0;
+    do {
+        for (int i = 0; i < code.k * 64; ++i) {
+            encoder.encode(payload.data(), size, [&sink](const uint8_t* data, int len) { sink = data[len - 1]; });
+        }
+        bytes += static_cast<unsigned long long>(size) * code.k * 64;
+        elapsed = nowSec() - start;
+    } while (elapsed < seconds);
+
+    std::printf("  %-6s %3d:%-3d %-7s %10.1f MB/s\n", code.m > 1 ? "rs" : "xor", code.k, code.m,
+                "encode", bytes / elapsed / 1e6);
+}
+
+bool benchDecode(const Code& code, int size, double seconds)
+{
+    // 组号为 8 位，预编码 256 组可按组号循环反复解码
+    constexpr int GROUPS = 256;
+    std::vector<std::vector<uint8_t>> payloads;
+    const std::vector<Encoded> groups = encodeGroups(code, size, GROUPS, &payloads);
+    const int lost = code.m > 1 ? code.m : 1;
+    fec::FecDecoder decoder(code.k, size + fec::FEC_RS_HEADER_SIZE, code.m);
+
+    unsigned long long bytes = 0;
+    unsigned long long recovered = 0;
+    bool ok = true;
+    const double start = nowSec();
+    double elapsed = 0;
+    do {
+        for (int g = 0; g < GROUPS; ++g) {
+            int next = g * code.k + lost;
+            // 丢弃前 lost 个数据包：其余数据包按序透传，校验到齐后按丢失索引顺序输出恢复包
+            for (size_t p = lost; p < groups[g].packets.size(); ++p) {
+                const auto& pkt = groups[g].packets[p];
+                decoder.decode(pkt.data(), static_cast<int>(pkt.size()), [&](const uint8_t* data, int len) {
+                    bytes += static_cast<unsigned long long>(len);
+                    if (next < (g + 1) * code.k) {
+                        const auto& expect = payloads[next++];
+                        ok = ok && static_cast<int>(expect.size()) == len && memcmp(expect.data(), data, len) == 0;
+                    } else {
+                        recovered++;
+                        const auto& expect = payloads[g * code.k + (recovered - 1) % lost];
+                        ok = ok && static_cast<int>(expect.size()) == len && memcmp(expect.data(), data, len) == 0;
+                    }
+                });
+            }
+        }
+        elapsed = nowSec() - start;
+    } while (elapsed < seconds);
+
+    std::printf("  %-6s %3d:%-3d %-7s %10.1f MB/s  (recovered %llu, lost %d/group)%s\n", code.m > 1 ? "rs" : "xor",
+                code.k, code.m, "decode", bytes / elapsed / 1e6, recovered, lost, ok ? "" : "  MISMATCH");
+    return ok;
+}
+
+/**
+ * 预热后反复解码 256 组（组号回绕一圈，覆盖全部组槽复用），期间堆分配计数必须不变
+ */
+bool checkZeroAlloc(const Code& code, int size)
+{
+    constexpr int GROUPS = 256;
+    std::vector<std::vector<uint8_t>> payloads;
+    const std::vector<Encoded> groups = encodeGroups(code, size, GROUPS, &payloads);
+    const int lost = code.m > 1 ? code.m : 1;
+    fec::FecDecoder decoder(code.k, size + fec::FEC_RS_HEADER_SIZE, code.m);
+
+    unsigned long long delivered = 0;
+    auto feed = [&](int dropPerGroup) {
+        for (int g = 0; g < GROUPS; ++g) {
+            for (size_t p = dropPerGroup; p < groups[g].packets.size(); ++p) {
+                const auto& pkt = groups[g].packets[p];
+                decoder.decode(pkt.data(), static_cast<int>(pkt.size()),
+                               [&delivered](const uint8_t*, int) { ++delivered; });
+            }
+        }
+    };
+
+    feed(0);
+    const unsigned long long before = g_allocCount;
+    delivered = 0;
+    feed(0);
+    feed(lost);
+    const unsigned long long allocs = g_allocCount - before;
+    const unsigned long long expected = 2ULL * GROUPS * code.k;
+
+    const bool ok = allocs == 0 && delivered == expected;
+    std::printf("  %-6s %3d:%-3d zero-alloc   allocs=%llu delivered=%llu/%llu %s\n", code.m > 1 ? "rs" : "xor",
+                code.k, code.m, allocs, delivered, expected, ok ? "OK" : "FAIL");
+    return ok;
+}
+
+/**
+ * 对端 k:m 大于本端解码器上限：数据包必须照常交付（只是无法参与恢复）
+ */
+bool checkMismatchedPeer(const Code& code, int size)
+{
+    constexpr int GROUPS = 4;
+    std::vector<std::vector<uint8_t>> payloads;
+    const std::vector<Encoded> groups = encodeGroups(code, size, GROUPS, &payloads);
+    fec::FecDecoder decoder(std::max(1, code.k / 2), size + fec::FEC_RS_HEADER_SIZE, std::max(1, code.m / 2));
+
+    size_t next = 0;
+    bool ordered = true;
+    for (const Encoded& group : groups) {
+        for (const auto& pkt : group.packets) {
+            decoder.decode(pkt.data(), static_cast<int>(pkt.size()), [&](const uint8_t* data, int len) {
+                ordered = ordered && next < payloads.size() && static_cast<int>(payloads[next].size()) == len &&
+                          memcmp(payloads[next].data(), data, len) == 0;
+                ++next;
+            });
+        }
+    }
+
+    const bool ok = ordered && next == payloads.size();
+    std::printf("  %-6s %3d:%-3d peer>limit    delivered=%zu/%zu %s\n", code.m > 1 ? "rs" : "xor", code.k, code.m,
+                next, payloads.size(), ok ? "OK" : "FAIL");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<Code> codes = {{10, 1}, {16, 1}, {8, 3}, {10, 3}, {16, 4}, {32, 8}};
+    int size = 1200;
+    double seconds = 0.5;
+    bool check = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--codes" && i + 1 < argc) {
+            if (!parseCodes(argv[++i], &codes)) {
+                std::fprintf(stderr, "invalid --codes (expected k:m list, k 1-%d, m 1-%d)\n",
+                             fec::FEC_RS_MAX_DATA, fec::FEC_RS_MAX_PARITY);
+                return 1;
+            }
+        } else if (arg == "--size" && i + 1 < argc) {
+            size = std::max(16, std::min(1400, std::atoi(argv[++i])));
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::max(0.05, std::atof(argv[++i]));
+        } else if (arg == "--check") {
+            check = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--codes 10:1,8:3,...] [--size 1200] [--seconds 0.5] [--check]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    bool ok = true;
+    if (check) {
+        std::printf("kernel=%s size=%d check\n", kernelName(), size);
+        for (const Code& code : codes) {
+            ok = checkZeroAlloc(code, size) && ok;
+            if (code.k > 1) {
+                ok = checkMismatchedPeer(code, size) && ok;
+            }
+        }
+        return ok ? 0 : 2;
+    }
+
+    std::printf("kernel=%s size=%d seconds=%.2f\n", kernelName(), size, seconds);
+    for (const Code& code : codes) {
+        benchEncode(code, size, seconds);
+        ok = benchDecode(code, size, seconds) && ok;
+    }
+    return ok ? 0 : 2;
+}
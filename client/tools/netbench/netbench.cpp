@@ -0,0 +1,490 @@
+/**
+ * @file netbench.cpp
+ * @brief 传输基准 / Transport benchmark over the local impairment proxy
+ *
+ * 在回环上把视频发送端 → ImpairmentProxy → 接收端串起来，按损伤配置逐一运行各传输方案，
+ * 输出吞吐、帧延迟分位数与 FEC 恢复率，用于比较 KCP / 裸 UDP / 序号分组 FEC 在弱网下的表现。
+ *
+ * 传输方案 / Transports:
+ *   udp           UdpVideoStreamer → UdpVideoClient，无 FEC
+ *   udp-fec1      固定 k=16,m=1（单校验，等价 XOR）
+ *   udp-fec3      固定 k=8,m=3（Cauchy RS）
+ *   udp-adaptive  初始 16:1，每秒按 takeLossReport() 走 UdpVideoSender 的自适应策略
+ *   kcp           KcpTransport 视频流模式（延迟梯度拥塞控制）
+ *   kcp-fec       KcpTransport + KCP 层 RS 10:3
+ *
+ * 视频源为合成 GOP：每 2 秒一个关键帧（约 6 倍平均 P 帧大小），帧大小 ±25% 随机。
+ * 接收端丢帧后发出 keyFrameNeeded 时，下一帧强制为关键帧（模拟 REQUEST_KEYFRAME）。
+ * 帧延迟 = 接收端读出完整帧的时刻 - 发送时刻（同一进程同一单调时钟）。
+ *
+ * 用法 / Usage:
+ *   qsc_netbench [--duration 10] [--bitrate 8000000] [--fps 60] [--seed 1]
+ *                [--transports udp,udp-fec3,kcp] [--profile name=spec ...]
+ *   spec 语法见 ImpairmentProfile::parse，例如 --profile lossy=loss=0.03,delay=10,jitter=3
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ClockSync.h"
+#include "ImpairmentProxy.h"
+#include "KcpTransport.h"
+#include "UdpVideoClient.h"
+#include "UdpVideoStreamer.h"
+
+using netbench::ImpairmentProfile;
+using netbench::ImpairmentProxy;
+using netbench::UdpVideoStreamer;
+
+namespace {
+
+constexpr int FRAME_META_SIZE = 12;
+constexpr int DRAIN_MS = 1000;                  // 发送结束后等待在途数据的时间
+constexpr int KCP_SEND_CHUNK = 32 * 1024;       // ikcp_send 单次不得超过 128 个分片
+constexpr quint64 PTS_MASK = 0x3FFFFFFFFFFFFFFFULL;
+
+struct BenchConfig {
+    int durationSec = 10;
+    quint32 bitrate = 8000000;
+    int fps = 60;
+    quint32 seed = 1;
+};
+
+struct NamedProfile {
+    std::string name;
+    ImpairmentProfile profile;
+};
+
+struct Result {
+    quint64 framesSent = 0;
+    quint64 framesDelivered = 0;
+    quint64 bytesDelivered = 0;
+    std::vector<double> latencyMs;
+    double rawLoss = 0.0;           // 代理丢弃比例（数据方向）
+    quint64 recovered = 0;
+    quint64 unrecovered = 0;
+    bool hasRecovery = false;
+};
+
+/**
+ * @brief 合成视频源（确定性）
+ */
+class FrameSource
+{
+public:
+    explicit FrameSource(const BenchConfig &config)
+        : m_rng(config.seed)
+        , m_gop(config.fps * 2)
+    {
+        // 一个 GOP 的字节数 = 码率 × 2 秒，关键帧按 6 个 P 帧计
+        const double gopBytes = config.bitrate / 8.0 * 2.0;
+        m_pFrameBytes = gopBytes / (m_gop - 1 + KEY_FRAME_WEIGHT);
+        m_payload.resize(static_cast<size_t>(m_pFrameBytes * KEY_FRAME_WEIGHT * 1.5) + 1024);
+        for (auto &b : m_payload) {
+            b = static_cast<uint8_t>(m_rng());
+        }
+    }
+
+    /**
+     * @return 本帧大小；keyFrame 输出是否关键帧
+     */
+    int next(bool forceKey, bool *keyFrame)
+    {
+        *keyFrame = forceKey || m_index % m_gop == 0;
+        if (*keyFrame) {
+            m_index = 0;    // 强制关键帧后重新开始 GOP
+        }
+        m_index++;
+        const double base = *keyFrame ? m_pFrameBytes * KEY_FRAME_WEIGHT : m_pFrameBytes;
+        std::uniform_real_distribution<double> scale(0.75, 1.25);
+        return std::max(16, static_cast<int>(base * scale(m_rng)));
+    }
+
+    const uint8_t *payload() const { return m_payload.data(); }
+
+private:
+    static constexpr double KEY_FRAME_WEIGHT = 6.0;
+    std::mt19937 m_rng;
+    int m_gop;
+    int m_index = 0;
+    double m_pFrameBytes;
+    std::vector<uint8_t> m_payload;
+};
+
+double percentile(std::vector<double> &values, double p)
+{
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const size_t idx = std::min(values.size() - 1, static_cast<size_t>(p * (values.size() - 1) + 0.5));
+    return values[idx];
+}
+
+quint64 readBE(const uint8_t *p, int n)
+{
+    quint64 v = 0;
+    for (int i = 0; i < n; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+void fillFrameMeta(uint8_t *meta, qint64 ptsUs, bool keyFrame, int size)
+{
+    quint64 ptsAndFlags = static_cast<quint64>(ptsUs);
+    if (keyFrame) {
+        ptsAndFlags |= UdpVideoStreamer::PACKET_FLAG_KEY_FRAME;
+    }
+    for (int i = 0; i < 8; ++i) {
+        meta[i] = static_cast<uint8_t>(ptsAndFlags >> (56 - 8 * i));
+    }
+    for (int i = 0; i < 4; ++i) {
+        meta[8 + i] = static_cast<uint8_t>(size >> (24 - 8 * i));
+    }
+}
+
+void collectProxyLoss(const ImpairmentProxy &proxy, Result *result)
+{
+    const ImpairmentProxy::Stats s = proxy.stats(ImpairmentProxy::ToUpstream);
+    if (s.received > 0) {
+        result->rawLoss = static_cast<double>(s.lost + s.queueDropped) / s.received;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// UDP 视频通道
+// ---------------------------------------------------------------------------
+
+Result runUdp(const BenchConfig &config, const ImpairmentProfile &profile, int fecK, int fecM, bool adaptive)
+{
+    Result result;
+    const bool fecEnabled = fecK > 0;
+    result.hasRecovery = fecEnabled;
+
+    UdpVideoClient client;
+    client.configure(config.bitrate, config.fps);
+    client.setFecEnabled(fecEnabled);
+    if (!client.bind(0)) {
+        qWarning("[netbench] UdpVideoClient bind failed");
+        return result;
+    }
+
+    ImpairmentProxy proxy;
+    proxy.setSeed(config.seed);
+    proxy.setProfile(ImpairmentProxy::ToUpstream, profile);
+    proxy.setProfile(ImpairmentProxy::ToPeer, profile);
+    if (!proxy.start(0, QHostAddress(QHostAddress::LocalHost), client.localPort())) {
+        return result;
+    }
+
+    std::atomic<bool> keyFrameRequested{false};
+    QObject::connect(&client, &UdpVideoClient::keyFrameNeeded, [&keyFrameRequested]() {
+        keyFrameRequested.store(true, std::memory_order_relaxed);
+    });
+
+    UdpVideoStreamer streamer;
+    streamer.setFecEnabled(fecEnabled, fecK, fecM);
+
+    std::atomic<bool> sending{true};
+    std::thread receiver([&]() {
+        std::vector<char> buf;
+        uint8_t meta[FRAME_META_SIZE];
+        for (;;) {
+            if (client.recvBlocking(reinterpret_cast<char *>(meta), FRAME_META_SIZE, 100) != FRAME_META_SIZE) {
+                if (!client.isActive()) break;
+                continue;
+            }
+            const qint64 pts = static_cast<qint64>(readBE(meta, 8) & PTS_MASK);
+            const int size = static_cast<int>(readBE(meta + 8, 4));
+            buf.resize(std::max<size_t>(buf.size(), size));
+            if (size > 0 && client.recvBlocking(buf.data(), size, 1000) != size) {
+                break;
+            }
+            result.latencyMs.push_back((qsc::ClockSync::nowUs() - pts) / 1000.0);
+            result.framesDelivered++;
+            result.bytesDelivered += static_cast<quint64>(size);
+        }
+    });
+
+    // 发送线程：套接字在本线程创建和关闭；onFecReport 只经原子参数影响发送线程
+    std::thread sender([&]() {
+        if (!streamer.open(QHostAddress(QHostAddress::LocalHost), proxy.listenPort())) {
+            sending.store(false, std::memory_order_release);
+            return;
+        }
+        FrameSource source(config);
+        const auto start = std::chrono::steady_clock::now();
+        const auto interval = std::chrono::microseconds(1000000 / config.fps);
+        const int frames = config.durationSec * config.fps;
+        for (int i = 0; i < frames; ++i) {
+            std::this_thread::sleep_until(start + interval * i);
+            bool keyFrame = false;
+            const int size = source.next(keyFrameRequested.exchange(false), &keyFrame);
+            streamer.sendFrame(source.payload(), size, qsc::ClockSync::nowUs(), false, keyFrame);
+            result.framesSent++;
+        }
+        streamer.close();
+        sending.store(false, std::memory_order_release);
+    });
+
+    // 主线程每秒取丢包回报（即客户端的 FEC_REPORT），自适应方案据此调整 k/m
+    while (sending.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const UdpVideoClient::LossReport report = client.takeLossReport();
+        result.recovered += report.recovered;
+        result.unrecovered += report.unrecovered;
+        if (adaptive) {
+            streamer.onFecReport(report.lossPermille, report.avgBurstX10, report.maxBurst,
+                                 report.recovered, report.unrecovered);
+        }
+    }
+    sender.join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(DRAIN_MS));
+
+    const UdpVideoClient::LossReport report = client.takeLossReport();
+    result.recovered += report.recovered;
+    result.unrecovered += report.unrecovered;
+    collectProxyLoss(proxy, &result);
+
+    client.close();
+    receiver.join();
+    proxy.stop();
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// KCP 视频通道
+// ---------------------------------------------------------------------------
+
+Result runKcp(const BenchConfig &config, const ImpairmentProfile &profile, bool fecEnabled)
+{
+    Result result;
+
+    KcpTransport receiver(KcpTransport::CONV_VIDEO);
+    receiver.setVideoStreamMode();
+    if (fecEnabled) {
+        receiver.setFecEnabled(true, 10, 3);
+    }
+    if (!receiver.bind(0)) {
+        qWarning("[netbench] KCP receiver bind failed");
+        return result;
+    }
+
+    ImpairmentProxy proxy;
+    proxy.setSeed(config.seed);
+    proxy.setProfile(ImpairmentProxy::ToUpstream, profile);
+    proxy.setProfile(ImpairmentProxy::ToPeer, profile);
+    if (!proxy.start(0, QHostAddress(QHostAddress::LocalHost), receiver.localPort())) {
+        return result;
+    }
+
+    KcpTransport sender(KcpTransport::CONV_VIDEO);
+    sender.setVideoStreamMode();
+    if (fecEnabled) {
+        sender.setFecEnabled(true, 10, 3);
+    }
+    if (!sender.bind(0)) {
+        qWarning("[netbench] KCP sender bind failed");
+        return result;
+    }
+    sender.connectTo(QHostAddress(QHostAddress::LocalHost), proxy.listenPort());
+
+    // 接收：流模式下按 12B 帧头重新切帧
+    QByteArray pending;
+    QObject::connect(&receiver, &KcpTransport::dataReady, [&]() {
+        for (;;) {
+            const QByteArray data = receiver.recv();
+            if (data.isEmpty()) break;
+            pending.append(data);
+        }
+        int pos = 0;
+        while (pending.size() - pos >= FRAME_META_SIZE) {
+            const uint8_t *meta = reinterpret_cast<const uint8_t *>(pending.constData() + pos);
+            const int size = static_cast<int>(readBE(meta + 8, 4));
+            if (pending.size() - pos < FRAME_META_SIZE + size) break;
+            const qint64 pts = static_cast<qint64>(readBE(meta, 8) & PTS_MASK);
+            result.latencyMs.push_back((qsc::ClockSync::nowUs() - pts) / 1000.0);
+            result.framesDelivered++;
+            result.bytesDelivered += static_cast<quint64>(size);
+            pos += FRAME_META_SIZE + size;
+        }
+        pending.remove(0, pos);
+    });
+
+    // 发送：1ms 精度定时器按帧率节拍；命令队列满时剩余数据留到下一拍
+    FrameSource source(config);
+    QByteArray outgoing;
+    QElapsedTimer clock;
+    const int frames = config.durationSec * config.fps;
+    int sent = 0;
+    QEventLoop loop;
+    QTimer pacer;
+    pacer.setTimerType(Qt::PreciseTimer);
+    pacer.setInterval(1);
+    QObject::connect(&pacer, &QTimer::timeout, [&]() {
+        while (sent < frames && clock.nsecsElapsed() / 1000 >= static_cast<qint64>(sent) * 1000000 / config.fps) {
+            bool keyFrame = false;
+            const int size = source.next(false, &keyFrame);
+            const int offset = static_cast<int>(outgoing.size());
+            outgoing.resize(offset + FRAME_META_SIZE + size);
+            uint8_t *buf = reinterpret_cast<uint8_t *>(outgoing.data() + offset);
+            fillFrameMeta(buf, qsc::ClockSync::nowUs(), keyFrame, size);
+            memcpy(buf + FRAME_META_SIZE, source.payload(), size);
+            sent++;
+        }
+        int pos = 0;
+        while (pos < outgoing.size()) {
+            const int chunk = std::min(KCP_SEND_CHUNK, static_cast<int>(outgoing.size()) - pos);
+            if (sender.send(outgoing.constData() + pos, chunk) < 0) break;
+            pos += chunk;
+        }
+        outgoing.remove(0, pos);
+        if (sent >= frames && outgoing.isEmpty()) {
+            pacer.stop();
+            QTimer::singleShot(DRAIN_MS, &loop, &QEventLoop::quit);
+        }
+    });
+    clock.start();
+    pacer.start();
+    loop.exec();
+
+    result.framesSent = static_cast<quint64>(sent);
+    collectProxyLoss(proxy, &result);
+
+    sender.close();
+    receiver.close();
+    proxy.stop();
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+
+std::vector<NamedProfile> defaultProfiles()
+{
+    const char *specs[][2] = {
+        {"clean", "clean"},
+        {"wifi", "loss=0.005,delay=3,jitter=2"},
+        {"bursty", "ge=0.01:0.25:0:0.6,delay=5,jitter=4"},
+        {"lossy", "loss=0.03,delay=10,jitter=3,reorder=0.005:5"},
+        {"narrow", "rate=10000,queue=60,delay=5"},
+    };
+    std::vector<NamedProfile> profiles;
+    for (const auto &spec : specs) {
+        NamedProfile p;
+        p.name = spec[0];
+        ImpairmentProfile::parse(spec[1], &p.profile);
+        profiles.push_back(p);
+    }
+    return profiles;
+}
+
+void printResult(const std::string &profile, const std::string &transport,
+                 const BenchConfig &config, Result &r)
+{
+    const double delivered = r.framesSent ? 100.0 * r.framesDelivered / r.framesSent : 0.0;
+    const double goodputMbps = r.bytesDelivered * 8.0 / config.durationSec / 1e6;
+    const double p50 = percentile(r.latencyMs, 0.50);
+    const double p99 = percentile(r.latencyMs, 0.99);
+    char recovery[32] = "-";
+    if (r.hasRecovery && r.recovered + r.unrecovered > 0) {
+        std::snprintf(recovery, sizeof(recovery), "%.1f%%",
+                      100.0 * r.recovered / (r.recovered + r.unrecovered));
+    }
+    std::printf("%-10s %-13s %7llu %7.1f%% %8.2f %8.1f %8.1f %8.2f%% %9s\n",
+                profile.c_str(), transport.c_str(),
+                static_cast<unsigned long long>(r.framesSent), delivered, goodputMbps,
+                p50, p99, r.rawLoss * 100.0, recovery);
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("qsc_netbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Transport benchmark over a local UDP impairment proxy");
+    parser.addHelpOption();
+    QCommandLineOption durationOpt("duration", "Seconds per run (default 10).", "sec", "10");
+    QCommandLineOption bitrateOpt("bitrate", "Video bitrate in bps (default 8000000).", "bps", "8000000");
+    QCommandLineOption fpsOpt("fps", "Frame rate (default 60).", "fps", "60");
+    QCommandLineOption seedOpt("seed", "Impairment RNG seed (default 1).", "seed", "1");
+    QCommandLineOption transportsOpt("transports",
+                                     "Comma-separated: udp,udp-fec1,udp-fec3,udp-adaptive,kcp,kcp-fec.",
+                                     "list", "udp,udp-fec1,udp-fec3,udp-adaptive,kcp,kcp-fec");
+    QCommandLineOption profileOpt("profile", "Impairment profile name=spec (repeatable, replaces defaults).",
+                                  "name=spec");
+    parser.addOptions({durationOpt, bitrateOpt, fpsOpt, seedOpt, transportsOpt, profileOpt});
+    parser.process(app);
+
+    BenchConfig config;
+    config.durationSec = std::max(1, parser.value(durationOpt).toInt());
+    config.bitrate = std::max(100000u, parser.value(bitrateOpt).toUInt());
+    config.fps = std::max(1, std::min(240, parser.value(fpsOpt).toInt()));
+    config.seed = parser.value(seedOpt).toUInt();
+
+    std::vector<NamedProfile> profiles;
+    for (const QString &value : parser.values(profileOpt)) {
+        const int eq = value.indexOf('=');
+        NamedProfile p;
+        p.name = value.left(eq).toStdString();
+        if (eq <= 0 || !ImpairmentProfile::parse(value.mid(eq + 1).toStdString(), &p.profile)) {
+            std::fprintf(stderr, "invalid --profile: %s\n", qPrintable(value));
+            return 1;
+        }
+        profiles.push_back(p);
+    }
+    if (profiles.empty()) {
+        profiles = defaultProfiles();
+    }
+    QStringList transports;
+    for (const QString &t : parser.value(transportsOpt).split(',')) {
+        if (!t.isEmpty()) transports.append(t);
+    }
+
+    std::printf("bitrate=%.1fMbps fps=%d duration=%ds seed=%u\n",
+                config.bitrate / 1e6, config.fps, config.durationSec, config.seed);
+    for (const NamedProfile &p : profiles) {
+        std::printf("  %-10s %s\n", p.name.c_str(), p.profile.describe().c_str());
+    }
+    std::printf("%-10s %-13s %7s %8s %8s %8s %8s %9s %9s\n",
+                "profile", "transport", "frames", "deliv", "Mbps", "p50ms", "p99ms", "rawloss", "recovery");
+
+    for (const NamedProfile &p : profiles) {
+        for (const QString &t : transports) {
+            Result r;
+            if (t == "udp") {
+                r = runUdp(config, p.profile, 0, 0, false);
+            } else if (t == "udp-fec1") {
+                r = runUdp(config, p.profile, 16, 1, false);
+            } else if (t == "udp-fec3") {
+                r = runUdp(config, p.profile, 8, 3, false);
+            } else if (t == "udp-adaptive") {
+                r = runUdp(config, p.profile, UdpVideoStreamer::FEC_K_CLEAN, 1, true);
+            } else if (t == "kcp") {
+                r = runKcp(config, p.profile, false);
+            } else if (t == "kcp-fec") {
+                r = runKcp(config, p.profile, true);
+            } else {
+                std::fprintf(stderr, "unknown transport: %s\n", qPrintable(t));
+                return 1;
+            }
+            printResult(p.name, t.toStdString(), config, r);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,298 @@
+#include "FakeAdb.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSettings>
+#include <QtGlobal>
+
+#include <cstdio>
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#endif
+
+#include "StandinServer.h"
+
+namespace standin {
+
+namespace {
+
+constexpr const char *SERVER_CLASS = "com.genymobile.scrcpy.Server";
+
+QString stateDir()
+{
+    const QString custom = QString::fromLocal8Bit(qgetenv("KZSCRCPY_STANDIN_STATE"));
+    return custom.isEmpty() ? QDir::tempPath() + "/qsc_standin" : custom;
+}
+
+QString defaultSerial()
+{
+    const QString serial = QString::fromLocal8Bit(qgetenv("KZSCRCPY_STANDIN_SERIAL"));
+    return serial.isEmpty() ? QStringLiteral("standin-0") : serial;
+}
+
+QString deviceIp()
+{
+    const QString ip = QString::fromLocal8Bit(qgetenv("KZSCRCPY_STANDIN_IP"));
+    return ip.isEmpty() ? QStringLiteral("127.0.0.1") : ip;
+}
+
+// QSettings 的键里 '/' 表示分组，socket 名不含 '/'，直接作键
+void removeByValue(QSettings &settings, const QString &group, quint16 port)
+{
+    settings.beginGroup(group);
+    for (const QString &key : settings.childKeys()) {
+        if (settings.value(key).toUInt() == port) {
+            settings.remove(key);
+        }
+    }
+    settings.endGroup();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// AdbState
+// ---------------------------------------------------------------------------
+
+QString AdbState::filePath()
+{
+    QDir().mkpath(stateDir());
+    return stateDir() + "/adb_state.ini";
+}
+
+void AdbState::setReverse(const QString &socketName, quint16 port)
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    settings.setValue("reverse/" + socketName, port);
+}
+
+void AdbState::removeReverse(const QString &socketName)
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    settings.remove("reverse/" + socketName);
+}
+
+void AdbState::removeAllReverse()
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    settings.remove("reverse");
+}
+
+quint16 AdbState::reversePort(const QString &socketName)
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    return static_cast<quint16>(settings.value("reverse/" + socketName, 0).toUInt());
+}
+
+void AdbState::setForward(const QString &socketName, quint16 port)
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    removeByValue(settings, "forward", port);
+    settings.setValue("forward/" + socketName, port);
+}
+
+void AdbState::removeForward(quint16 port)
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    removeByValue(settings, "forward", port);
+}
+
+void AdbState::removeAllForward()
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    settings.remove("forward");
+}
+
+quint16 AdbState::forwardPort(const QString &socketName)
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    return static_cast<quint16>(settings.value("forward/" + socketName, 0).toUInt());
+}
+
+QStringList AdbState::connectedSerials()
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    return settings.value("devices/connected").toStringList();
+}
+
+void AdbState::setConnected(const QString &serial, bool connected)
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    QStringList serials = settings.value("devices/connected").toStringList();
+    serials.removeAll(serial);
+    if (connected) {
+        serials.append(serial);
+    }
+    settings.setValue("devices/connected", serials);
+}
+
+void AdbState::setServerPid(qint64 pid)
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    if (pid > 0) {
+        settings.setValue("server/pid", pid);
+    } else {
+        settings.remove("server/pid");
+    }
+}
+
+qint64 AdbState::serverPid()
+{
+    QSettings settings(filePath(), QSettings::IniFormat);
+    return settings.value("server/pid", 0).toLongLong();
+}
+
+// ---------------------------------------------------------------------------
+// FakeAdb
+// ---------------------------------------------------------------------------
+
+bool FakeAdb::isInvokedAsAdb(const QString &program)
+{
+    return QFileInfo(program).completeBaseName().compare("adb", Qt::CaseInsensitive) == 0;
+}
+
+quint16 FakeAdb::parseTcp(const QString &spec)
+{
+    return spec.startsWith("tcp:") ? static_cast<quint16>(spec.mid(4).toUInt()) : 0;
+}
+
+QString FakeAdb::parseLocalAbstract(const QString &spec)
+{
+    return spec.startsWith("localabstract:") ? spec.mid(14) : QString();
+}
+
+int FakeAdb::run(const QStringList &arguments)
+{
+    QStringList args = arguments;
+    // 全局选项：-s <serial> / -t <id> / -d / -e，只有一台替身设备，忽略
+    while (!args.isEmpty()) {
+        if ((args.first() == "-s" || args.first() == "-t" || args.first() == "-P") && args.size() >= 2) {
+            args.erase(args.begin(), args.begin() + 2);
+        } else if (args.first() == "-d" || args.first() == "-e") {
+            args.removeFirst();
+        } else {
+            break;
+        }
+    }
+    if (args.isEmpty()) {
+        std::fprintf(stderr, "adb (qsc_standin): no command\n");
+        return 1;
+    }
+
+    const QString command = args.takeFirst();
+    if (command == "devices") {
+        std::printf("List of devices attached\n");
+        std::printf("%s\tdevice\n", qPrintable(defaultSerial()));
+        for (const QString &serial : AdbState::connectedSerials()) {
+            std::printf("%s\tdevice\n", qPrintable(serial));
+        }
+        std::printf("\n");
+        return 0;
+    }
+    if (command == "connect" && !args.isEmpty()) {
+        QString serial = args.first();
+        if (!serial.contains(':')) {
+            serial += ":5555";
+        }
+        AdbState::setConnected(serial, true);
+        std::printf("connected to %s\n", qPrintable(serial));
+        return 0;
+    }
+    if (command == "disconnect") {
+        for (const QString &serial : args) {
+            AdbState::setConnected(serial, false);
+            std::printf("disconnected %s\n", qPrintable(serial));
+        }
+        return 0;
+    }
+    if (command == "tcpip") {
+        std::printf("restarting in TCP mode port: %s\n", args.isEmpty() ? "5555" : qPrintable(args.first()));
+        return 0;
+    }
+    if (command == "push") {
+        std::printf("%s: 1 file pushed, 0 skipped.\n", args.isEmpty() ? "" : qPrintable(args.first()));
+        return 0;
+    }
+    if (command == "install") {
+        std::printf("Success\n");
+        return 0;
+    }
+    if (command == "start-server" || command == "kill-server") {
+        return 0;
+    }
+    if (command == "reverse" || command == "forward") {
+        const bool reverse = command == "reverse";
+        if (!args.isEmpty() && args.first() == "--remove-all") {
+            reverse ? AdbState::removeAllReverse() : AdbState::removeAllForward();
+            return 0;
+        }
+        if (args.size() >= 2 && args.first() == "--remove") {
+            if (reverse) {
+                AdbState::removeReverse(parseLocalAbstract(args[1]));
+            } else {
+                AdbState::removeForward(parseTcp(args[1]));
+            }
+            return 0;
+        }
+        // reverse localabstract:名字 tcp:端口 / forward tcp:端口 localabstract:名字
+        if (args.size() >= 2) {
+            const QString name = parseLocalAbstract(reverse ? args[0] : args[1]);
+            const quint16 port = parseTcp(reverse ? args[1] : args[0]);
+            if (!name.isEmpty() && port != 0) {
+                reverse ? AdbState::setReverse(name, port) : AdbState::setForward(name, port);
+                if (!reverse) {
+                    std::printf("%u\n", port);
+                }
+                return 0;
+            }
+        }
+        std::fprintf(stderr, "adb: error: unsupported %s arguments\n", qPrintable(command));
+        return 1;
+    }
+    if (command == "shell") {
+        return shell(args);
+    }
+
+    std::fprintf(stderr, "adb (qsc_standin): unsupported command '%s'\n", qPrintable(command));
+    return 1;
+}
+
+int FakeAdb::shell(const QStringList &args)
+{
+    const int serverIndex = args.indexOf(SERVER_CLASS);
+    if (serverIndex >= 0) {
+        // <类名> <版本> key=value...
+        return runStandinServer(args.mid(serverIndex + 2), StandinConfig::fromEnvironment());
+    }
+
+    const QString line = args.join(' ');
+    if (line.startsWith("pkill") || line.startsWith("killall")) {
+#ifdef Q_OS_UNIX
+        const qint64 pid = AdbState::serverPid();
+        if (pid > 0 && ::kill(static_cast<pid_t>(pid), SIGTERM) == 0) {
+            AdbState::setServerPid(0);
+            return 0;
+        }
+#endif
+        return 1;   // 与 pkill 一致：没有匹配进程时返回 1
+    }
+    if (line.startsWith("wm size")) {
+        const QString size = QString::fromLocal8Bit(qgetenv("KZSCRCPY_STANDIN_SIZE"));
+        std::printf("Physical size: %s\n", size.isEmpty() ? "1920x1080" : qPrintable(size));
+        return 0;
+    }
+    if (line.contains("ifconfig") && line.contains("wlan0")) {
+        std::printf("wlan0     Link encap:UNSPEC\n          inet addr:%s  Bcast:0.0.0.0  Mask:255.255.255.0\n",
+                    qPrintable(deviceIp()));
+        return 0;
+    }
+    if (line.contains("addr") && line.contains("wlan0")) {
+        std::printf("wlan0    inet %s/24 brd 0.0.0.0 scope global wlan0\n", qPrintable(deviceIp()));
+        return 0;
+    }
+    // 其余 shell 命令（rm、settings put、input 等）在替身上无副作用
+    return 0;
+}
+
+} // namespace standin
@@ -0,0 +1,71 @@
+/**
+ * @file FakeAdb.h
+ * @brief 假 adb / Fake adb front end for the device stand-in
+ *
+ * 把 qsc_standin 以 adb（Windows 为 adb.exe）为名建软链接或复制，并在配置中把 AdbPath 指向它，
+ * 客户端的整个启动流程（devices / connect / push / reverse / forward / shell app_process）
+ * 就落到本机的设备替身上，不需要真机：
+ * - devices / connect / disconnect / tcpip / push / install：打印与 adb 相同格式的结果
+ * - reverse / forward：把 "localabstract:名字 ↔ tcp:端口" 记录到状态文件，
+ *   替身启动时据此连接（reverse）或监听（forward）客户端的端口
+ * - shell ... com.genymobile.scrcpy.Server <版本> key=value...：在前台运行替身服务端
+ * - shell pkill -f scrcpy：结束上一次运行的替身
+ *
+ * 状态文件默认在 系统临时目录/qsc_standin/adb_state.ini，可用 KZSCRCPY_STANDIN_STATE 指定目录。
+ */
+
+#ifndef FAKE_ADB_H
+#define FAKE_ADB_H
+
+#include <QString>
+#include <QStringList>
+
+namespace standin {
+
+/**
+ * @brief reverse/forward 映射、已连接设备和替身进程号，跨多次 adb 调用持久化
+ */
+class AdbState
+{
+public:
+    static QString filePath();
+
+    static void setReverse(const QString &socketName, quint16 port);
+    static void removeReverse(const QString &socketName);
+    static void removeAllReverse();
+    static quint16 reversePort(const QString &socketName);
+
+    static void setForward(const QString &socketName, quint16 port);
+    static void removeForward(quint16 port);
+    static void removeAllForward();
+    static quint16 forwardPort(const QString &socketName);
+
+    static QStringList connectedSerials();
+    static void setConnected(const QString &serial, bool connected);
+
+    static void setServerPid(qint64 pid);
+    static qint64 serverPid();
+};
+
+class FakeAdb
+{
+public:
+    /**
+     * @brief argv[0] 去掉扩展名后是否为 adb
+     */
+    static bool isInvokedAsAdb(const QString &program);
+
+    /**
+     * @brief 执行一条 adb 命令，返回进程退出码
+     */
+    static int run(const QStringList &args);
+
+private:
+    static int shell(const QStringList &args);
+    static quint16 parseTcp(const QString &spec);
+    static QString parseLocalAbstract(const QString &spec);
+};
+
+} // namespace standin
+
+#endif // FAKE_ADB_H
@@ -0,0 +1,289 @@
+#include "H264FileSource.h"
+
+#include <QFile>
+#include <QtGlobal>
+
+namespace standin {
+
+namespace {
+
+// 指数哥伦布位读取器（越界后所有读取返回 0，由调用方检查 ok）
+class BitReader
+{
+public:
+    explicit BitReader(const QByteArray &data) : m_data(data) {}
+
+    bool ok() const { return !m_overflow; }
+
+    quint32 bits(int n)
+    {
+        quint32 value = 0;
+        for (int i = 0; i < n; ++i) {
+            value = (value << 1) | bit();
+        }
+        return value;
+    }
+
+    quint32 bit()
+    {
+        if (m_pos >= m_data.size() * 8) {
+            m_overflow = true;
+            return 0;
+        }
+        const quint8 byte = static_cast<quint8>(m_data[m_pos / 8]);
+        const quint32 value = (byte >> (7 - m_pos % 8)) & 1;
+        m_pos++;
+        return value;
+    }
+
+    quint32 ue()
+    {
+        int zeros = 0;
+        while (bit() == 0) {
+            if (m_overflow || ++zeros > 31) {
+                m_overflow = true;
+                return 0;
+            }
+        }
+        return ((1u << zeros) - 1) + bits(zeros);
+    }
+
+    qint32 se()
+    {
+        const quint32 value = ue();
+        return (value & 1) ? static_cast<qint32>((value + 1) / 2) : -static_cast<qint32>(value / 2);
+    }
+
+private:
+    const QByteArray &m_data;
+    int m_pos = 0;
+    bool m_overflow = false;
+};
+
+QByteArray unescapeRbsp(const char *data, int len)
+{
+    QByteArray rbsp;
+    rbsp.reserve(len);
+    int zeros = 0;
+    for (int i = 0; i < len; ++i) {
+        const quint8 byte = static_cast<quint8>(data[i]);
+        if (zeros >= 2 && byte == 0x03) {
+            zeros = 0;
+            continue;
+        }
+        zeros = byte == 0 ? zeros + 1 : 0;
+        rbsp.append(static_cast<char>(byte));
+    }
+    return rbsp;
+}
+
+void skipScalingList(BitReader &reader, int size)
+{
+    int lastScale = 8;
+    int nextScale = 8;
+    for (int j = 0; j < size; ++j) {
+        if (nextScale != 0) {
+            nextScale = (lastScale + reader.se() + 256) % 256;
+        }
+        lastScale = nextScale == 0 ? lastScale : nextScale;
+    }
+}
+
+} // namespace
+
+bool H264FileSource::open(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning("[Standin] cannot open %s: %s", qPrintable(path), qPrintable(file.errorString()));
+        return false;
+    }
+    m_data = file.readAll();
+    m_config.clear();
+    m_frames.clear();
+    m_width = 0;
+    m_height = 0;
+
+    const QVector<Nal> nals = splitNals();
+    Frame current;
+    current.offset = -1;
+    bool hasSlice = false;      // 当前帧已有 slice
+    bool seenSlice = false;     // 文件中已出现过 slice
+
+    auto closeFrame = [&](int end) {
+        if (current.offset >= 0 && hasSlice) {
+            current.size = end - current.offset;
+            m_frames.append(current);
+        }
+        current = Frame();
+        current.offset = -1;
+        hasSlice = false;
+    };
+
+    for (const Nal &nal : nals) {
+        if (nal.payload >= nal.end) {
+            continue;
+        }
+        const int type = m_data[nal.payload] & 0x1f;
+        if (type == 7 && m_width == 0) {
+            const QByteArray rbsp = unescapeRbsp(m_data.constData() + nal.payload + 1, nal.end - nal.payload - 1);
+            if (!parseSps(rbsp, &m_width, &m_height)) {
+                qWarning("[Standin] failed to parse SPS in %s", qPrintable(path));
+            }
+        }
+        // 首个 slice 之前的 SPS/PPS 作为 config 包单独发送
+        if (!seenSlice && (type == 7 || type == 8)) {
+            m_config.append(m_data.constData() + nal.start, nal.end - nal.start);
+            continue;
+        }
+
+        const bool vcl = type >= 1 && type <= 5;
+        // 非 VCL（AUD/SEI/SPS/PPS）出现在 slice 之后，或 first_mb_in_slice == 0，都开始新的访问单元
+        const bool firstMb = vcl && nal.payload + 1 < nal.end && (m_data[nal.payload + 1] & 0x80);
+        if (hasSlice && (!vcl || firstMb)) {
+            closeFrame(nal.start);
+        }
+        if (current.offset < 0) {
+            current.offset = nal.start;
+        }
+        if (vcl) {
+            hasSlice = true;
+            seenSlice = true;
+            current.keyFrame = current.keyFrame || type == 5;
+        }
+    }
+    closeFrame(m_data.size());
+
+    if (m_frames.isEmpty() || m_config.isEmpty()) {
+        qWarning("[Standin] %s: no SPS/PPS or no frames (H.264 Annex-B expected)", qPrintable(path));
+        return false;
+    }
+    int keyFrames = 0;
+    for (const Frame &f : m_frames) {
+        keyFrames += f.keyFrame ? 1 : 0;
+    }
+    qInfo("[Standin] %s: %dx%d, %d frames, %d key frames", qPrintable(path), m_width, m_height,
+          static_cast<int>(m_frames.size()), keyFrames);
+    return true;
+}
+
+QVector<H264FileSource::Nal> H264FileSource::splitNals() const
+{
+    QVector<Nal> nals;
+    const char *data = m_data.constData();
+    const int size = m_data.size();
+    int i = 0;
+    while (i + 3 <= size) {
+        if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+            Nal nal;
+            nal.start = (i > 0 && data[i - 1] == 0) ? i - 1 : i;
+            nal.payload = i + 3;
+            if (!nals.isEmpty()) {
+                nals.last().end = nal.start;
+            }
+            nals.append(nal);
+            i += 3;
+        } else {
+            i++;
+        }
+    }
+    if (!nals.isEmpty()) {
+        nals.last().end = size;
+    }
+    return nals;
+}
+
+int H264FileSource::nextKeyFrame(int index) const
+{
+    const int count = m_frames.size();
+    for (int i = 0; i < count; ++i) {
+        const int candidate = (index + i) % count;
+        if (m_frames[candidate].keyFrame) {
+            return candidate;
+        }
+    }
+    return 0;
+}
+
+bool H264FileSource::parseSps(const QByteArray &rbsp, int *width, int *height)
+{
+    BitReader reader(rbsp);
+    const quint32 profile = reader.bits(8);
+    reader.bits(16);    // constraint_set_flags + level_idc
+    reader.ue();        // seq_parameter_set_id
+
+    quint32 chromaFormat = 1;
+    bool separateColourPlane = false;
+    switch (profile) {
+    case 100: case 110: case 122: case 244: case 44:
+    case 83: case 86: case 118: case 128: case 138:
+    case 139: case 134: case 135:
+        chromaFormat = reader.ue();
+        if (chromaFormat == 3) {
+            separateColourPlane = reader.bit();
+        }
+        reader.ue();    // bit_depth_luma_minus8
+        reader.ue();    // bit_depth_chroma_minus8
+        reader.bit();   // qpprime_y_zero_transform_bypass_flag
+        if (reader.bit()) {
+            const int lists = chromaFormat == 3 ? 12 : 8;
+            for (int i = 0; i < lists; ++i) {
+                if (reader.bit()) {
+                    skipScalingList(reader, i < 6 ? 16 : 64);
+                }
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    reader.ue();        // log2_max_frame_num_minus4
+    const quint32 pocType = reader.ue();
+    if (pocType == 0) {
+        reader.ue();    // log2_max_pic_order_cnt_lsb_minus4
+    } else if (pocType == 1) {
+        reader.bit();
+        reader.se();
+        reader.se();
+        const quint32 cycle = reader.ue();
+        for (quint32 i = 0; i < cycle && reader.ok(); ++i) {
+            reader.se();
+        }
+    }
+    reader.ue();        // max_num_ref_frames
+    reader.bit();       // gaps_in_frame_num_value_allowed_flag
+    const quint32 widthMbs = reader.ue() + 1;
+    const quint32 heightMapUnits = reader.ue() + 1;
+    const quint32 frameMbsOnly = reader.bit();
+    if (!frameMbsOnly) {
+        reader.bit();   // mb_adaptive_frame_field_flag
+    }
+    reader.bit();       // direct_8x8_inference_flag
+    quint32 cropLeft = 0, cropRight = 0, cropTop = 0, cropBottom = 0;
+    if (reader.bit()) {
+        cropLeft = reader.ue();
+        cropRight = reader.ue();
+        cropTop = reader.ue();
+        cropBottom = reader.ue();
+    }
+    if (!reader.ok()) {
+        return false;
+    }
+
+    // 裁剪单位：4:2:0 为 2×2，4:2:2 为 2×1，4:4:4 / 单色 / 独立色彩平面为 1×1（场编码高度再 ×2）
+    const quint32 chromaArray = separateColourPlane ? 0 : chromaFormat;
+    const quint32 cropUnitX = (chromaArray == 1 || chromaArray == 2) ? 2 : 1;
+    const quint32 cropUnitY = (chromaArray == 1 ? 2 : 1) * (2 - frameMbsOnly);
+    const qint64 w = static_cast<qint64>(widthMbs) * 16 - static_cast<qint64>(cropLeft + cropRight) * cropUnitX;
+    const qint64 h = static_cast<qint64>(2 - frameMbsOnly) * heightMapUnits * 16
+                     - static_cast<qint64>(cropTop + cropBottom) * cropUnitY;
+    if (w <= 0 || h <= 0 || w > 16384 || h > 16384) {
+        return false;
+    }
+    *width = static_cast<int>(w);
+    *height = static_cast<int>(h);
+    return true;
+}
+
+} // namespace standin
@@ -0,0 +1,71 @@
+/**
+ * @file H264FileSource.h
+ * @brief H.264 Annex-B 文件帧源 / H.264 Annex-B file frame source
+ *
+ * 把录制好的 H.264 裸流（Annex-B，00 00 01 / 00 00 00 01 起始码）切成访问单元，
+ * 按编码器输出的方式交给发送端：
+ * - SPS/PPS 合并为一个 config 包（对应 MediaCodec BUFFER_FLAG_CODEC_CONFIG）
+ * - 其余 NAL 按 first_mb_in_slice == 0 的 slice 切分为帧，含 IDR 的帧标为关键帧
+ * - 分辨率从首个 SPS 解析（裁剪后），供 12B 视频头使用
+ *
+ * 整个文件一次读入内存，帧数据只保存偏移，非线程安全。
+ */
+
+#ifndef H264_FILE_SOURCE_H
+#define H264_FILE_SOURCE_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+namespace standin {
+
+class H264FileSource
+{
+public:
+    struct Frame {
+        int offset = 0;
+        int size = 0;
+        bool keyFrame = false;
+    };
+
+    bool open(const QString &path);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+
+    QByteArray config() const { return m_config; }
+    int frameCount() const { return m_frames.size(); }
+    const Frame &frame(int index) const { return m_frames[index]; }
+    const char *frameData(int index) const { return m_data.constData() + m_frames[index].offset; }
+
+    /**
+     * @brief index 之后（含）第一个关键帧，到文件尾则从头找；没有关键帧返回 0
+     */
+    int nextKeyFrame(int index) const;
+
+    /**
+     * @brief 从 SPS RBSP（不含 NAL 头、已去除防竞争字节）解析显示分辨率
+     */
+    static bool parseSps(const QByteArray &rbsp, int *width, int *height);
+
+private:
+    struct Nal {
+        int start = 0;      // 含起始码
+        int payload = 0;    // NAL 头位置
+        int end = 0;
+    };
+
+    QVector<Nal> splitNals() const;
+
+private:
+    QByteArray m_data;
+    QByteArray m_config;
+    QVector<Frame> m_frames;
+    int m_width = 0;
+    int m_height = 0;
+};
+
+} // namespace standin
+
+#endif // H264_FILE_SOURCE_H
@@ -0,0 +1,791 @@
+#include "StandinServer.h"
+
+#include <QCoreApplication>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "ClockSync.h"
+#include "FakeAdb.h"
+#include "KcpTransport.h"
+#include "fastmsg.h"
+
+namespace standin {
+
+namespace {
+
+constexpr int DEVICE_NAME_FIELD_LENGTH = 64;
+constexpr int FRAME_META_SIZE = 12;
+constexpr quint32 CODEC_ID_H264 = 0x68323634;   // "h264"
+constexpr quint8 MOVE_LANE_MARKER = 0xE7;       // 与 KcpControlSocket::MOVE_LANE_MARKER 一致
+constexpr quint8 DEVICE_MSG_PONG = 3;
+constexpr int STATS_INTERVAL_FRAMES = 600;
+
+// 原版 scrcpy 控制消息（ControlMessageReader 仍兼容）
+constexpr quint8 LEGACY_INJECT_KEYCODE = 0;         // 14B
+constexpr quint8 LEGACY_INJECT_TOUCH_EVENT = 2;     // 32B
+constexpr quint8 LEGACY_BACK_OR_SCREEN_ON = 4;      // 2B
+
+void write32be(char *buf, quint32 value)
+{
+    buf[0] = static_cast<char>(value >> 24);
+    buf[1] = static_cast<char>(value >> 16);
+    buf[2] = static_cast<char>(value >> 8);
+    buf[3] = static_cast<char>(value);
+}
+
+void write64be(char *buf, quint64 value)
+{
+    write32be(buf, static_cast<quint32>(value >> 32));
+    write32be(buf + 4, static_cast<quint32>(value));
+}
+
+quint16 read16be(const char *buf)
+{
+    return static_cast<quint16>((static_cast<quint8>(buf[0]) << 8) | static_cast<quint8>(buf[1]));
+}
+
+quint32 read32be(const char *buf)
+{
+    return (static_cast<quint32>(static_cast<quint8>(buf[0])) << 24) | (static_cast<quint32>(static_cast<quint8>(buf[1])) << 16)
+           | (static_cast<quint32>(static_cast<quint8>(buf[2])) << 8) | static_cast<quint32>(static_cast<quint8>(buf[3]));
+}
+
+quint64 read64be(const char *buf)
+{
+    return (static_cast<quint64>(read32be(buf)) << 32) | read32be(buf + 4);
+}
+
+// FastMsg 之外再识别原版消息，数据不足或类型未知返回 0
+int controlMessageSize(const char *data, int len)
+{
+    if (len <= 0) return 0;
+    int size = 0;
+    switch (static_cast<quint8>(data[0])) {
+    case LEGACY_INJECT_KEYCODE:
+        size = 14;
+        break;
+    case LEGACY_INJECT_TOUCH_EVENT:
+        size = 32;
+        break;
+    case LEGACY_BACK_OR_SCREEN_ON:
+        size = 2;
+        break;
+    default:
+        return FastMsg::messageSize(data, len);
+    }
+    return size <= len ? size : 0;
+}
+
+bool isKnownType(quint8 type)
+{
+    switch (type) {
+    case LEGACY_INJECT_KEYCODE:
+    case LEGACY_INJECT_TOUCH_EVENT:
+    case LEGACY_BACK_OR_SCREEN_ON:
+    case FMT_TOUCH_DOWN:
+    case FMT_TOUCH_UP:
+    case FMT_TOUCH_MOVE:
+    case FMT_TOUCH_RESET:
+    case FMT_KEY_DOWN:
+    case FMT_KEY_UP:
+    case FMT_BATCH:
+    case FMT_FEC_REPORT:
+    case FMT_REQUEST_KEYFRAME:
+    case FMT_BITRATE_TARGET:
+    case FMT_PING:
+    case FMT_TOUCH_MOVE_SEQ:
+    case FMT_PATH_DUP:
+    case FMT_VIDEO_FEEDBACK:
+    case FMT_DISCONNECT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+int u8(const char *buf)
+{
+    return static_cast<quint8>(buf[0]);
+}
+
+const char *touchActionName(quint8 action)
+{
+    switch (action) {
+    case FTA_DOWN:
+        return "TOUCH_DOWN";
+    case FTA_UP:
+        return "TOUCH_UP";
+    case FTA_MOVE:
+        return "TOUCH_MOVE";
+    default:
+        return "TOUCH_RESET";
+    }
+}
+
+bool parseBool(const QString &value)
+{
+    return value == "true" || value == "1";
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// 配置
+// ---------------------------------------------------------------------------
+
+StandinConfig StandinConfig::fromEnvironment()
+{
+    StandinConfig config;
+    config.videoPath = QString::fromLocal8Bit(qgetenv("KZSCRCPY_STANDIN_VIDEO"));
+    config.touchVideoPath = QString::fromLocal8Bit(qgetenv("KZSCRCPY_STANDIN_TOUCH_VIDEO"));
+    config.echoLogPath = QString::fromLocal8Bit(qgetenv("KZSCRCPY_STANDIN_LOG"));
+    const QString name = QString::fromLocal8Bit(qgetenv("KZSCRCPY_STANDIN_NAME"));
+    if (!name.isEmpty()) {
+        config.deviceName = name;
+    }
+    config.fps = qEnvironmentVariableIntValue("KZSCRCPY_STANDIN_FPS");
+    config.wifiImpairment = QString::fromLocal8Bit(qgetenv("KZSCRCPY_STANDIN_WIFI_IMPAIR"));
+    return config;
+}
+
+bool ServerOptions::parse(const QStringList &args, ServerOptions *options)
+{
+    for (const QString &arg : args) {
+        const int eq = arg.indexOf('=');
+        if (eq <= 0) {
+            qWarning("[Standin] invalid server argument: %s", qPrintable(arg));
+            return false;
+        }
+        const QString key = arg.left(eq);
+        const QString value = arg.mid(eq + 1);
+        if (key == "scid") {
+            options->scid = value;
+        } else if (key == "tunnel_forward") {
+            options->tunnelForward = parseBool(value);
+        } else if (key == "control") {
+            options->control = parseBool(value);
+        } else if (key == "video_codec") {
+            options->videoCodec = value;
+        } else if (key == "max_fps") {
+            options->maxFps = value.toInt();
+        } else if (key == "video_bit_rate") {
+            options->videoBitRate = value.toInt();
+        } else if (key == "use_kcp") {
+            options->useKcp = parseBool(value);
+        } else if (key == "kcp_port") {
+            options->kcpPort = static_cast<quint16>(value.toUInt());
+        } else if (key == "kcp_control_port") {
+            options->kcpControlPort = static_cast<quint16>(value.toUInt());
+        } else if (key == "kcp_fec") {
+            const QStringList km = value.split(':');
+            if (km.size() != 2) {
+                qWarning("[Standin] invalid kcp_fec: %s", qPrintable(value));
+                return false;
+            }
+            options->kcpFecData = km[0].toInt();
+            options->kcpFecParity = km[1].toInt();
+        } else if (key == "video_fec") {
+            options->videoFec = parseBool(value);
+        } else if (key == "multipath") {
+            options->multipath = parseBool(value);
+        } else if (key == "client_ip") {
+            options->clientIp = value;
+        }
+        // 其余参数（max_size、capture_orientation、stay_awake 等）对替身无意义，忽略
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// StandinServer
+// ---------------------------------------------------------------------------
+
+StandinServer::StandinServer(const ServerOptions &options, const StandinConfig &config, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_config(config)
+{
+    const int fps = m_config.fps > 0 ? m_config.fps : (m_options.maxFps > 0 ? m_options.maxFps : 60);
+    m_frameIntervalUs = 1000000 / fps;
+}
+
+StandinServer::~StandinServer()
+{
+    if (m_streamer) {
+        m_streamer->close();
+    }
+    if (m_kcp) {
+        m_kcp->close();
+    }
+}
+
+bool StandinServer::start()
+{
+    if (m_config.echoLogPath.isEmpty()) {
+        m_echoFile.open(stderr, QIODevice::WriteOnly);
+    } else {
+        m_echoFile.setFileName(m_config.echoLogPath);
+        if (!m_echoFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            qWarning("[Standin] cannot open echo log %s", qPrintable(m_config.echoLogPath));
+            return false;
+        }
+    }
+    if (m_config.videoPath.isEmpty()) {
+        qWarning("[Standin] no video file (set KZSCRCPY_STANDIN_VIDEO or --video)");
+        return false;
+    }
+    if (m_options.videoCodec != "h264") {
+        qWarning("[Standin] only h264 is supported, requested %s", qPrintable(m_options.videoCodec));
+        return false;
+    }
+    if (!m_source.open(m_config.videoPath)) {
+        return false;
+    }
+    if (!m_config.touchVideoPath.isEmpty()) {
+        if (!m_touchSource.open(m_config.touchVideoPath)) {
+            return false;
+        }
+        // 12B 视频头只发送一次，切换源不能改变分辨率
+        if (m_touchSource.width() != m_source.width() || m_touchSource.height() != m_source.height()) {
+            qWarning("[Standin] touch video is %dx%d, main video is %dx%d", m_touchSource.width(),
+                     m_touchSource.height(), m_source.width(), m_source.height());
+            return false;
+        }
+        m_hasTouchSource = true;
+        qInfo("[Standin] touch video: %s", qPrintable(m_config.touchVideoPath));
+    }
+    const char *mode = m_options.useKcp ? "WiFi (UDP video + KCP control)"
+                       : m_options.multipath ? "multipath (TCP + KCP control)" : "TCP";
+    qInfo("[Standin] %s mode, %d fps, socket %s", mode, 1000000 / m_frameIntervalUs, qPrintable(m_options.socketName()));
+    if (m_options.useKcp) {
+        return startKcp();
+    }
+    if (m_options.multipath && m_options.control && !startKcpControl()) {
+        return false;
+    }
+    return startTcp();
+}
+
+bool StandinServer::startTcp()
+{
+    if (m_options.tunnelForward) {
+        return startTcpForward();
+    }
+
+    // reverse：设备端主动连接 localabstract，经 adb reverse 落到客户端监听的端口（视频先、控制后）
+    const QString name = m_options.socketName();
+    const quint16 videoPort = m_config.videoPort ? m_config.videoPort : AdbState::reversePort(name + "_video");
+    const quint16 controlPort = m_config.controlPort ? m_config.controlPort : AdbState::reversePort(name + "_control");
+    if (videoPort == 0 || (m_options.control && controlPort == 0)) {
+        qWarning("[Standin] no adb reverse mapping for %s", qPrintable(name));
+        return false;
+    }
+
+    m_videoSocket = new QTcpSocket(this);
+    m_videoSocket->connectToHost(QHostAddress::LocalHost, videoPort);
+    if (!m_videoSocket->waitForConnected(3000)) {
+        qWarning("[Standin] video connect to %u failed: %s", videoPort, qPrintable(m_videoSocket->errorString()));
+        return false;
+    }
+    m_videoSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    if (m_options.control) {
+        m_controlSocket = new QTcpSocket(this);
+        m_controlSocket->connectToHost(QHostAddress::LocalHost, controlPort);
+        if (!m_controlSocket->waitForConnected(3000)) {
+            qWarning("[Standin] control connect to %u failed: %s", controlPort,
+                     qPrintable(m_controlSocket->errorString()));
+            return false;
+        }
+        m_controlSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    }
+    onTcpVideoReady();
+    return true;
+}
+
+bool StandinServer::startTcpForward()
+{
+    // forward：设备端监听 localabstract，客户端经 adb forward 连接；每个连接先回一个 dummy byte
+    const QString name = m_options.socketName();
+    const quint16 videoPort = m_config.videoPort ? m_config.videoPort : AdbState::forwardPort(name + "_video");
+    const quint16 controlPort = m_config.controlPort ? m_config.controlPort : AdbState::forwardPort(name + "_control");
+    if (videoPort == 0 || (m_options.control && controlPort == 0)) {
+        qWarning("[Standin] no adb forward mapping for %s", qPrintable(name));
+        return false;
+    }
+
+    auto listen = [this](QTcpServer *&server, quint16 port, QTcpSocket *&socket) {
+        server = new QTcpServer(this);
+        if (!server->listen(QHostAddress::LocalHost, port)) {
+            qWarning("[Standin] listen on %u failed: %s", port, qPrintable(server->errorString()));
+            return false;
+        }
+        connect(server, &QTcpServer::newConnection, this, [this, server, &socket]() {
+            if (socket) {
+                return;
+            }
+            socket = server->nextPendingConnection();
+            socket->setParent(this);
+            socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            socket->write("\0", 1);
+            server->close();
+            if (m_videoSocket && (!m_options.control || m_controlSocket)) {
+                onTcpVideoReady();
+            }
+        });
+        return true;
+    };
+    if (!listen(m_videoServer, videoPort, m_videoSocket)) {
+        return false;
+    }
+    if (m_options.control && !listen(m_controlServer, controlPort, m_controlSocket)) {
+        return false;
+    }
+    return true;
+}
+
+void StandinServer::onTcpVideoReady()
+{
+    connect(m_videoSocket, &QTcpSocket::disconnected, this, [this]() {
+        qInfo("[Standin] video socket closed");
+        finish(0);
+    });
+    if (m_controlSocket) {
+        connect(m_controlSocket, &QTcpSocket::readyRead, this, [this]() {
+            const qint64 now = qsc::ClockSync::nowUs();
+            const QByteArray data = m_controlSocket->readAll();
+            m_fromKcp = false;
+            onControlBytes(m_controlBuffer, data.constData(), data.size(), now);
+        });
+        connect(m_controlSocket, &QTcpSocket::disconnected, this, [this]() {
+            qInfo("[Standin] control socket closed");
+            finish(0);
+        });
+    }
+
+    // 设备名（64B，以 0 结尾）+ codec 头
+    char meta[DEVICE_NAME_FIELD_LENGTH + 12] = {};
+    const QByteArray name = m_config.deviceName.toUtf8().left(DEVICE_NAME_FIELD_LENGTH - 1);
+    memcpy(meta, name.constData(), static_cast<size_t>(name.size()));
+    write32be(meta + DEVICE_NAME_FIELD_LENGTH, CODEC_ID_H264);
+    write32be(meta + DEVICE_NAME_FIELD_LENGTH + 4, static_cast<quint32>(m_source.width()));
+    write32be(meta + DEVICE_NAME_FIELD_LENGTH + 8, static_cast<quint32>(m_source.height()));
+    writeVideo(meta, sizeof(meta));
+    startStreaming();
+}
+
+bool StandinServer::startKcp()
+{
+    const QString clientIp = m_options.clientIp.isEmpty() ? QStringLiteral("127.0.0.1") : m_options.clientIp;
+
+    m_streamer.reset(new netbench::UdpVideoStreamer());
+    if (m_options.videoFec) {
+        m_streamer->setFecEnabled(true, netbench::UdpVideoStreamer::FEC_K_CLEAN, 1);
+    }
+    if (!m_streamer->open(QHostAddress(clientIp), m_options.kcpPort)) {
+        qWarning("[Standin] cannot open UDP video socket to %s:%u", qPrintable(clientIp), m_options.kcpPort);
+        return false;
+    }
+
+    if (m_options.control && !startKcpControl()) {
+        return false;
+    }
+
+    QTimer::singleShot(m_config.startupDelayMs, this, [this]() {
+        char header[12];
+        write32be(header, CODEC_ID_H264);
+        write32be(header + 4, static_cast<quint32>(m_source.width()));
+        write32be(header + 8, static_cast<quint32>(m_source.height()));
+        m_streamer->sendRaw(reinterpret_cast<const uint8_t *>(header), sizeof(header));
+        startStreaming();
+    });
+    return true;
+}
+
+bool StandinServer::startKcpControl()
+{
+    m_kcp = new KcpTransport(KcpTransport::CONV_CONTROL, this);
+    m_kcp->setStreamMode(0);
+    m_kcp->setWindowSize(64, 64);
+    m_kcp->setMinRto(1);
+    if (m_options.kcpFecData > 0 && m_options.kcpFecParity > 0) {
+        m_kcp->setFecEnabled(true, m_options.kcpFecData, m_options.kcpFecParity);
+    }
+    // 不可靠通道在收包线程回调，带着时间戳转到主线程处理
+    m_kcp->setDatagramListener(MOVE_LANE_MARKER, [this](const char *data, int len) {
+        const qint64 now = qsc::ClockSync::nowUs();
+        const QByteArray datagram(data, len);
+        QMetaObject::invokeMethod(this, [this, datagram, now]() { onLaneDatagram(datagram, now); },
+                                  Qt::QueuedConnection);
+    });
+    // 与服务端一致：回包地址从客户端的首个包学习（客户端本地端口可能不是 kcp_control_port）；
+    // 有损伤代理时代理占用 kcp_control_port，KCP 绑定临时端口，学到的对端是代理
+    const bool impaired = !m_config.wifiImpairment.isEmpty();
+    const quint16 bindPort = impaired ? 0 : m_options.kcpControlPort;
+    if (!m_kcp->bind(bindPort)) {
+        qWarning("[Standin] cannot bind KCP control port %u", bindPort);
+        return false;
+    }
+    if (impaired) {
+        netbench::ImpairmentProfile profile;
+        if (!netbench::ImpairmentProfile::parse(m_config.wifiImpairment.toStdString(), &profile)) {
+            qWarning("[Standin] invalid WiFi impairment: %s", qPrintable(m_config.wifiImpairment));
+            return false;
+        }
+        m_wifiProxy.reset(new netbench::ImpairmentProxy());
+        m_wifiProxy->setProfile(netbench::ImpairmentProxy::ToUpstream, profile);
+        m_wifiProxy->setProfile(netbench::ImpairmentProxy::ToPeer, profile);
+        if (!m_wifiProxy->start(m_options.kcpControlPort, QHostAddress::LocalHost, m_kcp->localPort())) {
+            qWarning("[Standin] cannot start impairment proxy on port %u", m_options.kcpControlPort);
+            return false;
+        }
+        qInfo("[Standin] KCP control via impairment proxy :%u (%s)", m_options.kcpControlPort,
+              profile.describe().c_str());
+    }
+    connect(m_kcp, &KcpTransport::dataReady, this, [this]() {
+        const qint64 now = qsc::ClockSync::nowUs();
+        for (QByteArray message = m_kcp->recv(); !message.isEmpty(); message = m_kcp->recv()) {
+            m_fromKcp = true;
+            onControlBytes(m_kcpControlBuffer, message.constData(), message.size(), now);
+        }
+    });
+    connect(m_kcp, &KcpTransport::peerConnected, this, [this]() {
+        qInfo("[Standin] control peer %s:%u", qPrintable(m_kcp->remoteAddress().toString()), m_kcp->remotePort());
+    });
+    return true;
+}
+
+void StandinServer::startStreaming()
+{
+    if (m_streaming) {
+        return;
+    }
+    m_streaming = true;
+    const QByteArray config = m_source.config();
+    sendPacket(config.constData(), config.size(), 0, true, false);
+    m_frameIndex = m_source.nextKeyFrame(0);
+    m_nextFrameUs = qsc::ClockSync::nowUs();
+    sendNextFrame();
+}
+
+void StandinServer::scheduleNextFrame()
+{
+    const qint64 now = qsc::ClockSync::nowUs();
+    m_nextFrameUs += m_frameIntervalUs;
+    // 落后超过 1 秒（如被调试器挂起）不追帧，从现在重新计时
+    if (now - m_nextFrameUs > 1000000) {
+        m_nextFrameUs = now;
+    }
+    const int delayMs = static_cast<int>(qMax<qint64>(0, (m_nextFrameUs - now) / 1000));
+    QTimer::singleShot(delayMs, Qt::PreciseTimer, this, [this]() { sendNextFrame(); });
+}
+
+void StandinServer::sendNextFrame()
+{
+    if (!m_streaming) {
+        return;
+    }
+    // 触摸状态变化：切换到另一文件，先发它的 SPS/PPS，再从首个关键帧开始
+    const bool showTouch = m_hasTouchSource && m_touchesDown > 0;
+    if (showTouch != m_showingTouch) {
+        m_showingTouch = showTouch;
+        const H264FileSource &next = showTouch ? m_touchSource : m_source;
+        const QByteArray config = next.config();
+        sendPacket(config.constData(), config.size(), 0, true, false);
+        m_frameIndex = next.nextKeyFrame(0);
+        m_keyFrameRequested = false;
+    }
+    const H264FileSource &source = m_showingTouch ? m_touchSource : m_source;
+
+    if (m_keyFrameRequested) {
+        m_keyFrameRequested = false;
+        m_frameIndex = source.nextKeyFrame(m_frameIndex);
+    }
+    const H264FileSource::Frame &frame = source.frame(m_frameIndex);
+    // PTS = 发送时刻：替身没有采集环节，发送即“采集”
+    sendPacket(source.frameData(m_frameIndex), frame.size, qsc::ClockSync::nowUs(), false, frame.keyFrame);
+    m_frameIndex = (m_frameIndex + 1) % source.frameCount();
+    m_framesSent++;
+
+    if (m_framesSent % STATS_INTERVAL_FRAMES == 0) {
+        if (m_streamer) {
+            const netbench::UdpVideoStreamer::Stats stats = m_streamer->stats();
+            qInfo("[Standin] frames=%llu messages=%llu packets=%llu parity=%llu fec=%d:%d",
+                  static_cast<unsigned long long>(m_framesSent), static_cast<unsigned long long>(m_messages),
+                  static_cast<unsigned long long>(stats.packets), static_cast<unsigned long long>(stats.parityPackets),
+                  m_streamer->fecGroupSize(), m_streamer->fecParityCount());
+        } else {
+            qInfo("[Standin] frames=%llu messages=%llu", static_cast<unsigned long long>(m_framesSent),
+                  static_cast<unsigned long long>(m_messages));
+        }
+    }
+    scheduleNextFrame();
+}
+
+void StandinServer::sendPacket(const char *data, int len, qint64 ptsUs, bool config, bool keyFrame)
+{
+    if (m_streamer) {
+        m_streamer->sendFrame(reinterpret_cast<const uint8_t *>(data), len, ptsUs, config, keyFrame);
+        return;
+    }
+    quint64 ptsAndFlags = config ? netbench::UdpVideoStreamer::PACKET_FLAG_CONFIG : static_cast<quint64>(ptsUs);
+    if (!config && keyFrame) {
+        ptsAndFlags |= netbench::UdpVideoStreamer::PACKET_FLAG_KEY_FRAME;
+    }
+    char meta[FRAME_META_SIZE];
+    write64be(meta, ptsAndFlags);
+    write32be(meta + 8, static_cast<quint32>(len));
+    writeVideo(meta, FRAME_META_SIZE);
+    writeVideo(data, len);
+}
+
+void StandinServer::writeVideo(const char *data, int len)
+{
+    if (m_videoSocket && m_videoSocket->state() == QAbstractSocket::ConnectedState) {
+        m_videoSocket->write(data, len);
+    }
+}
+
+void StandinServer::onControlBytes(QByteArray &buffer, const char *data, int len, qint64 recvUs)
+{
+    buffer.append(data, len);
+    int pos = 0;
+    while (pos < buffer.size()) {
+        const char *p = buffer.constData() + pos;
+        const int left = buffer.size() - pos;
+        if (!isKnownType(static_cast<quint8>(p[0]))) {
+            // 与服务端一致：未知类型无法重新对齐，丢弃缓冲区
+            qWarning("[Standin] unknown control message type %u, dropping %d bytes",
+                     static_cast<quint8>(p[0]), left);
+            buffer.clear();
+            return;
+        }
+        const int size = controlMessageSize(p, left);
+        if (size <= 0) {
+            break;
+        }
+        handleMessage(p, size, recvUs, false);
+        pos += size;
+        if (buffer.isEmpty()) {
+            return;     // DISCONNECT 已退出
+        }
+    }
+    buffer.remove(0, pos);
+}
+
+bool StandinServer::acceptPathSeq(quint32 pathSeq)
+{
+    // 与 server 端 MultipathControlChannel 相同的滑动窗口
+    if (!m_hasPathSeq) {
+        m_hasPathSeq = true;
+        m_highestPathSeq = pathSeq;
+        m_pathSeqSeen[pathSeq % PATH_SEQ_WINDOW] = true;
+        return true;
+    }
+    const qint32 delta = static_cast<qint32>(pathSeq - m_highestPathSeq);
+    if (delta > 0) {
+        const int clear = qMin(delta, PATH_SEQ_WINDOW);
+        for (int i = 1; i <= clear; ++i) {
+            m_pathSeqSeen[(m_highestPathSeq + static_cast<quint32>(i)) % PATH_SEQ_WINDOW] = false;
+        }
+        m_highestPathSeq = pathSeq;
+        m_pathSeqSeen[pathSeq % PATH_SEQ_WINDOW] = true;
+        return true;
+    }
+    if (delta <= -PATH_SEQ_WINDOW || m_pathSeqSeen[pathSeq % PATH_SEQ_WINDOW]) {
+        return false;
+    }
+    m_pathSeqSeen[pathSeq % PATH_SEQ_WINDOW] = true;
+    return true;
+}
+
+void StandinServer::onLaneDatagram(const QByteArray &datagram, qint64 recvUs)
+{
+    // 只接受完整的 TOUCH_MOVE_SEQ；按通道序号去重（客户端会重复发送多份）
+    if (datagram.size() != 11 || static_cast<quint8>(datagram[0]) != FMT_TOUCH_MOVE_SEQ) {
+        return;
+    }
+    const quint32 laneSeq = read32be(datagram.constData() + 1);
+    if (m_hasLaneSeq && static_cast<qint32>(laneSeq - m_lastLaneSeq) <= 0) {
+        return;
+    }
+    m_hasLaneSeq = true;
+    m_lastLaneSeq = laneSeq;
+    m_fromKcp = true;
+    handleMessage(datagram.constData(), datagram.size(), recvUs, true);
+}
+
+void StandinServer::handleMessage(const char *msg, int len, qint64 recvUs, bool lane)
+{
+    m_messages++;
+    const quint8 type = static_cast<quint8>(msg[0]);
+    switch (type) {
+    case FMT_TOUCH_DOWN:
+    case FMT_TOUCH_UP:
+    case FMT_TOUCH_MOVE:
+        trackTouch(static_cast<quint8>(msg[1]), type - FMT_TOUCH_DOWN);
+        echo(recvUs, lane, QString("%1 id=%2 x=%3 y=%4").arg(touchActionName(type - FMT_TOUCH_DOWN))
+                               .arg(u8(msg + 1)).arg(read16be(msg + 2)).arg(read16be(msg + 4)));
+        break;
+    case FMT_TOUCH_RESET:
+        trackTouch(0, FTA_RESET);
+        echo(recvUs, lane, "TOUCH_RESET");
+        break;
+    case FMT_TOUCH_MOVE_SEQ:
+        echo(recvUs, lane, QString("TOUCH_MOVE id=%1 x=%2 y=%3 lane_seq=%4 down_gen=%5")
+                               .arg(u8(msg + 6)).arg(read16be(msg + 7)).arg(read16be(msg + 9))
+                               .arg(read32be(msg + 1)).arg(u8(msg + 5)));
+        break;
+    case FMT_KEY_DOWN:
+    case FMT_KEY_UP:
+        echo(recvUs, lane, QString("%1 key=%2").arg(type == FMT_KEY_DOWN ? "KEY_DOWN" : "KEY_UP").arg(read16be(msg + 1)));
+        break;
+    case FMT_BATCH: {
+        const int count = static_cast<quint8>(msg[1]);
+        for (int i = 0; i < count; ++i) {
+            const char *e = msg + 2 + i * 6;
+            trackTouch(static_cast<quint8>(e[0]), static_cast<quint8>(e[1]));
+            echo(recvUs, lane, QString("%1 id=%2 x=%3 y=%4 batch=%5/%6").arg(touchActionName(static_cast<quint8>(e[1])))
+                                   .arg(u8(e)).arg(read16be(e + 2)).arg(read16be(e + 4))
+                                   .arg(i + 1).arg(count));
+        }
+        break;
+    }
+    case FMT_FEC_REPORT: {
+        const int loss = read16be(msg + 1);
+        const int avgBurstX10 = static_cast<quint8>(msg[3]);
+        const int maxBurst = static_cast<quint8>(msg[4]);
+        const int recovered = read16be(msg + 5);
+        const int unrecovered = read16be(msg + 7);
+        if (m_streamer && m_options.videoFec) {
+            m_streamer->onFecReport(loss, avgBurstX10, maxBurst, recovered, unrecovered);
+        }
+        echo(recvUs, lane, QString("FEC_REPORT loss=%1 avg_burst=%2 max_burst=%3 recovered=%4 unrecovered=%5 fec=%6:%7")
+                               .arg(loss).arg(avgBurstX10 / 10.0).arg(maxBurst).arg(recovered).arg(unrecovered)
+                               .arg(m_streamer ? m_streamer->fecGroupSize() : 0)
+                               .arg(m_streamer ? m_streamer->fecParityCount() : 0));
+        break;
+    }
+    case FMT_REQUEST_KEYFRAME:
+        m_keyFrameRequested = true;
+        echo(recvUs, lane, "REQUEST_KEYFRAME");
+        break;
+    case FMT_BITRATE_TARGET:
+        // 录制文件无法重新编码，只记录
+        echo(recvUs, lane, QString("BITRATE_TARGET bps=%1").arg(read32be(msg + 1)));
+        break;
+    case FMT_VIDEO_FEEDBACK:
+        echo(recvUs, lane, QString("VIDEO_FEEDBACK seq=%1 recv_us=%2 bytes=%3")
+                               .arg(read32be(msg + 1)).arg(read32be(msg + 5)).arg(read32be(msg + 9)));
+        break;
+    case FMT_PING: {
+        const quint64 clientTime = read64be(msg + 1);
+        char pong[25];
+        pong[0] = static_cast<char>(DEVICE_MSG_PONG);
+        write64be(pong + 1, clientTime);
+        write64be(pong + 9, static_cast<quint64>(recvUs));
+        write64be(pong + 17, static_cast<quint64>(qsc::ClockSync::nowUs()));
+        sendDeviceMessage(pong, sizeof(pong));
+        echo(recvUs, lane, QString("PING client_us=%1").arg(clientTime));
+        break;
+    }
+    case LEGACY_INJECT_KEYCODE:
+        echo(recvUs, lane, QString("INJECT_KEYCODE action=%1 key=%2").arg(u8(msg + 1)).arg(read32be(msg + 2)));
+        break;
+    case LEGACY_INJECT_TOUCH_EVENT:
+        echo(recvUs, lane, QString("INJECT_TOUCH action=%1 pointer=%2 x=%3 y=%4").arg(u8(msg + 1))
+                               .arg(read64be(msg + 2)).arg(read32be(msg + 10)).arg(read32be(msg + 14)));
+        break;
+    case LEGACY_BACK_OR_SCREEN_ON:
+        echo(recvUs, lane, QString("BACK_OR_SCREEN_ON action=%1").arg(u8(msg + 1)));
+        break;
+    case FMT_PATH_DUP: {
+        const quint32 pathSeq = read32be(msg + 1);
+        if (!acceptPathSeq(pathSeq)) {
+            echo(recvUs, lane, QString("DUP_DROPPED path_seq=%1 type=%2").arg(pathSeq).arg(u8(msg + 5)));
+            break;
+        }
+        handleMessage(msg + 5, len - 5, recvUs, lane);
+        break;
+    }
+    case FMT_DISCONNECT:
+        echo(recvUs, lane, "DISCONNECT");
+        m_controlBuffer.clear();
+        m_kcpControlBuffer.clear();
+        finish(0);
+        break;
+    default:
+        break;
+    }
+}
+
+void StandinServer::trackTouch(quint8 seqId, quint8 action)
+{
+    if (action == FTA_RESET) {
+        std::fill(std::begin(m_touchDown), std::end(m_touchDown), false);
+        m_touchesDown = 0;
+    } else if (action == FTA_DOWN && !m_touchDown[seqId]) {
+        m_touchDown[seqId] = true;
+        m_touchesDown++;
+    } else if (action == FTA_UP && m_touchDown[seqId]) {
+        m_touchDown[seqId] = false;
+        m_touchesDown--;
+    }
+}
+
+void StandinServer::sendDeviceMessage(const char *data, int len)
+{
+    if (m_fromKcp && m_kcp && m_kcp->remotePort() != 0) {
+        m_kcp->send(data, len);
+    } else if (m_controlSocket) {
+        m_controlSocket->write(data, len);
+        m_controlSocket->flush();
+    } else if (m_kcp && m_kcp->remotePort() != 0) {
+        m_kcp->send(data, len);
+    }
+}
+
+void StandinServer::echo(qint64 recvUs, bool lane, const QString &text)
+{
+    const char *path = lane ? "lane" : !m_options.multipath ? "rel" : m_fromKcp ? "wifi" : "usb";
+    const QByteArray line = QString("%1 %2 %3\n").arg(recvUs).arg(path).arg(text).toUtf8();
+    m_echoFile.write(line);
+    m_echoFile.flush();
+}
+
+void StandinServer::finish(int exitCode)
+{
+    m_streaming = false;
+    qInfo("[Standin] done: frames=%llu messages=%llu", static_cast<unsigned long long>(m_framesSent),
+          static_cast<unsigned long long>(m_messages));
+    QCoreApplication::exit(exitCode);
+}
+
+// ---------------------------------------------------------------------------
+
+int runStandinServer(const QStringList &serverArgs, const StandinConfig &config)
+{
+    ServerOptions options;
+    if (!ServerOptions::parse(serverArgs, &options)) {
+        return 1;
+    }
+    StandinServer server(options, config);
+    if (!server.start()) {
+        return 1;
+    }
+    const qint64 pid = QCoreApplication::applicationPid();
+    AdbState::setServerPid(pid);
+    const int exitCode = QCoreApplication::exec();
+    if (AdbState::serverPid() == pid) {
+        AdbState::setServerPid(0);
+    }
+    return exitCode;
+}
+
+} // namespace standin
@@ -0,0 +1,174 @@
+/**
+ * @file StandinServer.h
+ * @brief 设备替身服务端 / Device stand-in server
+ *
+ * 在 Linux 主机上模拟手机端 scrcpy server，客户端按正常流程连接、推流、发控制：
+ * - TCP（USB）模式：reverse 时主动连接客户端端口，forward 时监听并发送 dummy byte，
+ *   之后在视频通道发送 64B 设备名 + 12B codec 头 [codec_id][width][height]
+ * - WiFi 模式：UdpVideoStreamer 发送 UDP 视频（可选序号分组 FEC，按 FEC_REPORT 自适应），
+ *   KCP 控制通道（可选 KCP 层 FEC）+ 触摸 MOVE 不可靠通道，视频先发 12B codec 头
+ * - 视频：H264FileSource 按实时帧率发送，帧头 [PTS+flags(8)][size(4)]，PTS 取发送时刻的
+ *   单调时钟（与 PONG 同一时钟，同机时客户端的采集延迟即整条管线延迟）；文件结束后循环
+ * - 触摸响应：指定 touchVideoPath 时，任一触摸点按下期间改发该文件（先发其 config 与首个关键帧），
+ *   全部抬起后切回主视频，供客户端点击→画面延迟探测（LatencyProbe）在无真机时测量整条管线
+ * - 控制：解析 FastMsg 协议（及原版 scrcpy 的三种消息），带接收时间戳逐条写入回显日志；
+ *   PING 经收到它的通道回 PONG，REQUEST_KEYFRAME 跳到下一个 IDR，DISCONNECT / 控制连接断开时退出
+ * - 多路径（multipath=true）：TCP 会话之外再开 KCP 控制通道，PATH_DUP 消息按 pathSeq 去重
+ * - WiFi 损伤：指定 wifiImpairment 时 kcp_control_port 由 ImpairmentProxy 监听，
+ *   KCP 控制通道绑定临时端口作为代理上游，两个方向使用同一套损伤参数
+ *
+ * 回显日志每行：<接收时刻 µs> <rel|lane|usb|wifi> <消息> [字段...]，时间为本机单调时钟；
+ * 多路径时 usb/wifi 表示消息从哪条通道到达（重复的一份记为 DUP_DROPPED）。
+ */
+
+#ifndef STANDIN_SERVER_H
+#define STANDIN_SERVER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QStringList>
+
+#include <memory>
+
+#include "H264FileSource.h"
+#include "ImpairmentProxy.h"
+#include "UdpVideoStreamer.h"
+
+class QTcpServer;
+class QTcpSocket;
+class KcpTransport;
+
+namespace standin {
+
+/**
+ * @brief 替身自身的配置（经假 adb 启动时取自环境变量）
+ */
+struct StandinConfig {
+    QString videoPath;                      // KZSCRCPY_STANDIN_VIDEO
+    QString touchVideoPath;                 // KZSCRCPY_STANDIN_TOUCH_VIDEO，有触摸按下时播放（须与主视频同分辨率）
+    QString deviceName = "qsc-standin";     // KZSCRCPY_STANDIN_NAME
+    QString echoLogPath;                    // KZSCRCPY_STANDIN_LOG，空为 stderr
+    int fps = 0;                            // KZSCRCPY_STANDIN_FPS，0 取 max_fps（未设为 60）
+    int startupDelayMs = 300;               // 模拟 app_process 启动耗时：WiFi 模式客户端在进程启动后才绑定视频端口
+    quint16 videoPort = 0;                  // 直接运行时指定 TCP 端口，覆盖 reverse/forward 状态
+    quint16 controlPort = 0;
+    QString wifiImpairment;                 // KZSCRCPY_STANDIN_WIFI_IMPAIR，KCP 控制通道的损伤参数（ImpairmentProfile 格式）
+
+    static StandinConfig fromEnvironment();
+};
+
+/**
+ * @brief 与 server 端 Options 同名的 key=value 参数（只取替身用得到的）
+ */
+struct ServerOptions {
+    QString scid;                           // 8 位十六进制，空表示未指定
+    bool tunnelForward = false;
+    bool control = true;
+    QString videoCodec = "h264";
+    int maxFps = 0;
+    int videoBitRate = 8000000;
+
+    bool useKcp = false;
+    quint16 kcpPort = 27185;
+    quint16 kcpControlPort = 27186;
+    int kcpFecData = 0;
+    int kcpFecParity = 0;
+    bool videoFec = false;
+    bool multipath = false;
+    QString clientIp;
+
+    static bool parse(const QStringList &args, ServerOptions *options);
+
+    QString socketName() const { return scid.isEmpty() ? QStringLiteral("scrcpy") : "scrcpy_" + scid; }
+};
+
+class StandinServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    StandinServer(const ServerOptions &options, const StandinConfig &config, QObject *parent = nullptr);
+    ~StandinServer() override;
+
+    bool start();
+
+private:
+    bool startTcp();
+    bool startTcpForward();
+    bool startKcp();
+    bool startKcpControl();
+    void onTcpVideoReady();
+    void startStreaming();
+
+    void scheduleNextFrame();
+    void sendNextFrame();
+    void sendPacket(const char *data, int len, qint64 ptsUs, bool config, bool keyFrame);
+    void writeVideo(const char *data, int len);
+    void trackTouch(quint8 seqId, quint8 action);
+
+    void onControlBytes(QByteArray &buffer, const char *data, int len, qint64 recvUs);
+    bool acceptPathSeq(quint32 pathSeq);
+    void handleMessage(const char *msg, int len, qint64 recvUs, bool lane);
+    void onLaneDatagram(const QByteArray &datagram, qint64 recvUs);
+    void sendDeviceMessage(const char *data, int len);
+    void echo(qint64 recvUs, bool lane, const QString &text);
+
+    void finish(int exitCode);
+
+private:
+    ServerOptions m_options;
+    StandinConfig m_config;
+    H264FileSource m_source;
+    H264FileSource m_touchSource;
+    bool m_hasTouchSource = false;
+
+    // TCP 模式
+    QTcpServer *m_videoServer = nullptr;
+    QTcpServer *m_controlServer = nullptr;
+    QTcpSocket *m_videoSocket = nullptr;
+    QTcpSocket *m_controlSocket = nullptr;
+
+    // WiFi 模式
+    std::unique_ptr<netbench::UdpVideoStreamer> m_streamer;
+    KcpTransport *m_kcp = nullptr;
+    std::unique_ptr<netbench::ImpairmentProxy> m_wifiProxy;
+    quint32 m_lastLaneSeq = 0;
+    bool m_hasLaneSeq = false;
+
+    // 推流
+    bool m_streaming = false;
+    int m_frameIndex = 0;
+    int m_frameIntervalUs = 16667;
+    qint64 m_nextFrameUs = 0;
+    bool m_keyFrameRequested = false;
+    quint64 m_framesSent = 0;
+
+    // 触摸响应视频：按 seqId 记录按下的触摸点，有按下时播放 m_touchSource
+    bool m_touchDown[256] = {};
+    int m_touchesDown = 0;
+    bool m_showingTouch = false;
+
+    // 控制
+    QByteArray m_controlBuffer;
+    QByteArray m_kcpControlBuffer;
+    bool m_fromKcp = false;                 // 正在处理的消息来自 KCP 通道（PONG 原路返回）
+
+    // 多路径去重：最近 PATH_SEQ_WINDOW 个 pathSeq 是否已收到
+    static constexpr int PATH_SEQ_WINDOW = 1024;
+    bool m_pathSeqSeen[PATH_SEQ_WINDOW] = {};
+    quint32 m_highestPathSeq = 0;
+    bool m_hasPathSeq = false;
+    QFile m_echoFile;
+    quint64 m_messages = 0;
+};
+
+/**
+ * @brief 解析参数并在当前线程运行替身直到退出（需已创建 QCoreApplication）
+ * @return 进程退出码
+ */
+int runStandinServer(const QStringList &serverArgs, const StandinConfig &config);
+
+} // namespace standin
+
+#endif // STANDIN_SERVER_H
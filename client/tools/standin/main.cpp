@@ -0,0 +1,92 @@
+/**
+ * @file main.cpp
+ * @brief qsc_standin - 设备替身 / Device stand-in for end-to-end tests without a phone
+ *
+ * 两种用法 / Usage:
+ *
+ * 1) 作为假 adb（推荐，走客户端完整的连接流程）：
+ *      ln -s /path/to/qsc_standin /tmp/standin/adb
+ *      KZSCRCPY_LOCAL_STANDIN=1 KZSCRCPY_ADB_PATH=/tmp/standin/adb KZSCRCPY_STANDIN_VIDEO=clip.h264 \
+ *      KZSCRCPY_STANDIN_LOG=/tmp/echo.log ./GameScrcpy
+ *    USB 模式选择设备 standin-0；WiFi 模式连接 127.0.0.1:5555
+ *    KZSCRCPY_LOCAL_STANDIN=1 由客户端读取：替身已绑定 kcp_control_port 时客户端改用临时端口
+ *
+ * 2) 直接运行服务端，参数与 scrcpy server 相同（key=value）：
+ *      qsc_standin --video clip.h264 --video-port 27183 --control-port 27184 -- scid=0000abcd
+ *      qsc_standin --video clip.h264 -- use_kcp=true kcp_port=27185 kcp_control_port=27186 \
+ *                  client_ip=127.0.0.1 video_fec=true
+ *      多路径（TCP + 加损伤的 KCP 控制）：
+ *      qsc_standin --video clip.h264 --video-port 27183 --control-port 27184 \
+ *                  --impair-wifi delay=20,loss=0.05 -- multipath=true client_ip=127.0.0.1 kcp_control_port=27186
+ *
+ * 环境变量 / Environment (假 adb 模式):
+ *   KZSCRCPY_STANDIN_VIDEO   H.264 Annex-B 文件（必需）
+ *   KZSCRCPY_STANDIN_TOUCH_VIDEO  有触摸按下时播放的文件（同分辨率，用于点击→画面延迟探测）
+ *   KZSCRCPY_STANDIN_LOG     控制消息回显日志（默认 stderr）
+ *   KZSCRCPY_STANDIN_NAME    设备名；KZSCRCPY_STANDIN_FPS 帧率；KZSCRCPY_STANDIN_SERIAL 序列号
+ *   KZSCRCPY_STANDIN_IP      ifconfig wlan0 报告的地址；KZSCRCPY_STANDIN_SIZE wm size 报告的尺寸
+ *   KZSCRCPY_STANDIN_STATE   reverse/forward 状态目录
+ *   KZSCRCPY_STANDIN_WIFI_IMPAIR  KCP 控制通道的损伤参数（如 delay=20,loss=0.05）
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include <cstdio>
+
+#include "FakeAdb.h"
+#include "StandinServer.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    if (standin::FakeAdb::isInvokedAsAdb(QString::fromLocal8Bit(argv[0]))) {
+        const int exitCode = standin::FakeAdb::run(app.arguments().mid(1));
+        std::fflush(stdout);
+        return exitCode;
+    }
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Device stand-in: plays a recorded H.264 stream over the scrcpy server "
+                                     "protocols and echoes control messages with timestamps");
+    parser.addHelpOption();
+    QCommandLineOption videoOption("video", "H.264 Annex-B file to stream.", "file");
+    QCommandLineOption touchVideoOption("touch-video", "H.264 file streamed while any touch is down.", "file");
+    QCommandLineOption logOption("log", "Control echo log (default: stderr).", "file");
+    QCommandLineOption nameOption("name", "Device name sent in TCP mode.", "name", "qsc-standin");
+    QCommandLineOption fpsOption("fps", "Frame rate (default: max_fps, or 60).", "fps", "0");
+    QCommandLineOption videoPortOption("video-port", "TCP video port (instead of adb reverse/forward state).", "port", "0");
+    QCommandLineOption controlPortOption("control-port", "TCP control port.", "port", "0");
+    QCommandLineOption delayOption("startup-delay", "Delay before WiFi-mode video starts (ms).", "ms", "300");
+    QCommandLineOption impairOption("impair-wifi", "Impair the KCP control path (e.g. delay=20,loss=0.05).", "spec");
+    parser.addOptions({videoOption, touchVideoOption, logOption, nameOption, fpsOption, videoPortOption, controlPortOption, delayOption,
+                       impairOption});
+    parser.addPositionalArgument("args", "scrcpy server arguments (key=value ...)", "[-- key=value...]");
+    parser.process(app);
+
+    standin::StandinConfig config = standin::StandinConfig::fromEnvironment();
+    if (parser.isSet(videoOption)) {
+        config.videoPath = parser.value(videoOption);
+    }
+    if (parser.isSet(touchVideoOption)) {
+        config.touchVideoPath = parser.value(touchVideoOption);
+    }
+    if (parser.isSet(logOption)) {
+        config.echoLogPath = parser.value(logOption);
+    }
+    if (parser.isSet(nameOption)) {
+        config.deviceName = parser.value(nameOption);
+    }
+    if (parser.isSet(fpsOption)) {
+        config.fps = parser.value(fpsOption).toInt();
+    }
+    config.videoPort = static_cast<quint16>(parser.value(videoPortOption).toUInt());
+    config.controlPort = static_cast<quint16>(parser.value(controlPortOption).toUInt());
+    config.startupDelayMs = parser.value(delayOption).toInt();
+    if (parser.isSet(impairOption)) {
+        config.wifiImpairment = parser.value(impairOption);
+    }
+
+    return standin::runStandinServer(parser.positionalArguments(), config);
+}
@@ -72,6 +72,10 @@ public class Options {
     private int kcpPort = 27185;
     private int kcpControlPort = 27186;  // Control channel port (kcpPort + 1)
     private String clientIp = "";
+    private int kcpFecData = 0;    // KCP FEC k (0 = disabled)
+    private int kcpFecParity = 0;  // KCP FEC m (1 = XOR, >1 = Reed-Solomon)
+    private boolean videoFec = false;  // UDP 视频自适应 FEC（客户端支持时开启）
+    private boolean multipath = false; // USB TCP 会话 + WiFi KCP 控制通道，控制消息双路径
 
     public Ln.Level getLogLevel() {
         return logLevel;
@@ -205,6 +209,22 @@ public class Options {
         return clientIp;
     }
 
+    public int getKcpFecData() {
+        return kcpFecData;
+    }
+
+    public int getKcpFecParity() {
+        return kcpFecParity;
+    }
+
+    public boolean getVideoFec() {
+        return videoFec;
+    }
+
+    public boolean getMultipath() {
+        return multipath;
+    }
+
     @SuppressWarnings("MethodLength")
     public static Options parse(String... args) {
         if (args.length < 1) {
@@ -344,6 +364,22 @@ public class Options {
                 case "client_ip":
                     options.clientIp = value;
                     break;
+                case "kcp_fec": {
+                    // 格式: k:m
+                    String[] parts = value.split(":");
+                    if (parts.length != 2) {
+                        throw new IllegalArgumentException("Invalid kcp_fec: " + value + " (expected k:m)");
+                    }
+                    options.kcpFecData = Integer.parseInt(parts[0]);
+                    options.kcpFecParity = Integer.parseInt(parts[1]);
+                    break;
+                }
+                case "video_fec":
+                    options.videoFec = Boolean.parseBoolean(value);
+                    break;
+                case "multipath":
+                    options.multipath = Boolean.parseBoolean(value);
+                    break;
                 case "raw_stream":
                     boolean rawStream = Boolean.parseBoolean(value);
                     if (rawStream) {
@@ -11,6 +11,7 @@ package com.genymobile.scrcpy;
 
 import com.genymobile.scrcpy.device.ConfigurationException;
 import com.genymobile.scrcpy.session.KcpSession;
+import com.genymobile.scrcpy.session.MultipathSession;
 import com.genymobile.scrcpy.session.ScrcpySession;
 import com.genymobile.scrcpy.session.TcpSession;
 import com.genymobile.scrcpy.util.Ln;
@@ -30,6 +31,7 @@ import java.lang.reflect.Field;
  * <ul>
  *   <li>WiFi 模式 (use_kcp=true): 使用 KCP/UDP，低延迟</li>
  *   <li>USB 模式 (use_kcp=false): 使用 TCP + adb forward，兼容性好</li>
+ *   <li>多路径 (multipath=true): USB 模式外加 WiFi KCP 控制通道，控制消息走最快路径</li>
  * </ul>
  * <p>
  * 优化: 使用策略模式消除 KCP/TCP 代码重复
@@ -53,6 +55,8 @@ public final class Server {
     private static ScrcpySession createSession(Options options) {
         if (options.getUseKcp()) {
             return new KcpSession(options);
+        } else if (options.getMultipath()) {
+            return new MultipathSession(options);
         } else {
             return new TcpSession(options);
         }
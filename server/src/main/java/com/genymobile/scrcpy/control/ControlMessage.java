@@ -2,6 +2,8 @@ package com.genymobile.scrcpy.control;
 
 import com.genymobile.scrcpy.device.Position;
 
+import java.util.Arrays;
+
 /**
  * 游戏投屏控制消息 - 极简版本
  * 只保留按键、触摸和返回键功能
@@ -21,6 +23,17 @@ public final class ControlMessage {
     public static final int TYPE_KEY_DOWN    = 14;  // 3B: keycode(2)
     public static final int TYPE_KEY_UP      = 15;  // 3B
     public static final int TYPE_BATCH       = 16;  // 2+6N: count(1)+[seqId(1)+action(1)+x(2)+y(2)]*N
+    public static final int TYPE_FEC_REPORT  = 17;  // 9B: loss(2)+avgBurst(1)+maxBurst(1)+recovered(2)+unrecovered(2)
+    public static final int TYPE_REQUEST_KEYFRAME = 18;  // 1B: 无载荷，请求编码器立即输出同步帧
+    public static final int TYPE_BITRATE_TARGET = 19;    // 5B: bitrate(4)，客户端估计的目标码率 (bps)
+    public static final int TYPE_PING = 20;              // 9B: clientTimeUs(8)，时钟同步请求，设备以 PONG 回应
+    // 11B: laneSeq(4)+downGen(1)+seqId(1)+x(2)+y(2)，只经不可靠通道发送的 MOVE（见 FastTouch.injectLaneMove）
+    public static final int TYPE_TOUCH_MOVE_SEQ = 21;
+    public static final int TOUCH_MOVE_SEQ_SIZE = 11;
+    // 5+N B: pathSeq(4)+内层消息，多路径会话中同一消息在各路径各发一份，按 pathSeq 去重
+    public static final int TYPE_PATH_DUP = 22;
+    // 13B: seq(4)+recvTimeUs(4)+recvBytes(4)，视频传输反馈，驱动 UdpVideoSender 的拥塞控制与发送节拍
+    public static final int TYPE_VIDEO_FEEDBACK = 23;
     public static final int TYPE_DISCONNECT  = 0xFF; // 1B
 
     // 核心字段
@@ -41,10 +54,74 @@ public final class ControlMessage {
     private int touchX;
     private int touchY;
     private int batchCount;
+    private int laneSeq;
+    private int downGen;
+
+    // 视频 FEC 丢包回报字段
+    private int lossPermille;
+    private int avgBurstX10;
+    private int maxBurst;
+    private int recovered;
+    private int unrecovered;
+
+    // 接收端带宽估计字段
+    private int bitrate;
+
+    // 视频传输反馈字段
+    private int videoSeq;
+    private int recvTimeUs;   // 客户端时钟低 32 位
+    private int recvBytes;
+
+    // 时钟同步字段（微秒）
+    private long clientTime;
+    private long deviceRecvTime;
+
+    // 多路径去重序号（仅 TYPE_PATH_DUP 包装的消息有效）
+    private boolean hasPathSeq;
+    private int pathSeq;
 
     private ControlMessage() {
     }
 
+    /**
+     * 复制一份消息：快速触摸/按键消息复用静态对象，批量消息复用读取端缓冲区，
+     * 跨线程排队（多路径会话）前必须复制
+     */
+    public ControlMessage copy() {
+        ControlMessage msg = new ControlMessage();
+        msg.type = type;
+        msg.metaState = metaState;
+        msg.action = action;
+        msg.keycode = keycode;
+        msg.actionButton = actionButton;
+        msg.buttons = buttons;
+        msg.pointerId = pointerId;
+        msg.pressure = pressure;
+        msg.position = position;
+        msg.repeat = repeat;
+        if (data != null) {
+            int len = type == TYPE_BATCH ? batchCount * 6 : data.length;
+            msg.data = Arrays.copyOf(data, len);
+        }
+        msg.seqId = seqId;
+        msg.touchX = touchX;
+        msg.touchY = touchY;
+        msg.batchCount = batchCount;
+        msg.laneSeq = laneSeq;
+        msg.downGen = downGen;
+        msg.lossPermille = lossPermille;
+        msg.avgBurstX10 = avgBurstX10;
+        msg.maxBurst = maxBurst;
+        msg.recovered = recovered;
+        msg.unrecovered = unrecovered;
+        msg.bitrate = bitrate;
+        msg.clientTime = clientTime;
+        msg.deviceRecvTime = deviceRecvTime;
+        msg.hasPathSeq = hasPathSeq;
+        msg.pathSeq = pathSeq;
+        return msg;
+    }
+
     // FastTouch 对象池 (单线程，避免高频触摸 GC)
     private static final ControlMessage REUSABLE_FAST_TOUCH = new ControlMessage();
     private static final ControlMessage REUSABLE_FAST_KEY = new ControlMessage();
@@ -84,6 +161,7 @@ public final class ControlMessage {
     public static ControlMessage createFastTouch(int type, int seqId, int action, int x, int y) {
         ControlMessage msg = REUSABLE_FAST_TOUCH;
         msg.type = type;
+        msg.hasPathSeq = false;
         msg.seqId = seqId;
         msg.action = action;
         msg.touchX = x;
@@ -91,9 +169,23 @@ public final class ControlMessage {
         return msg;
     }
 
+    public static ControlMessage createLaneMove(int seqId, int downGen, int laneSeq, int x, int y) {
+        ControlMessage msg = REUSABLE_FAST_TOUCH;
+        msg.type = TYPE_TOUCH_MOVE_SEQ;
+        msg.hasPathSeq = false;
+        msg.seqId = seqId;
+        msg.action = 2;
+        msg.downGen = downGen;
+        msg.laneSeq = laneSeq;
+        msg.touchX = x;
+        msg.touchY = y;
+        return msg;
+    }
+
     public static ControlMessage createFastKey(int type, int keycode) {
         ControlMessage msg = REUSABLE_FAST_KEY;
         msg.type = type;
+        msg.hasPathSeq = false;
         msg.keycode = keycode;
         return msg;
     }
@@ -106,6 +198,48 @@ public final class ControlMessage {
         return msg;
     }
 
+    public static ControlMessage createFecReport(int lossPermille, int avgBurstX10, int maxBurst,
+            int recovered, int unrecovered) {
+        ControlMessage msg = new ControlMessage();
+        msg.type = TYPE_FEC_REPORT;
+        msg.lossPermille = lossPermille;
+        msg.avgBurstX10 = avgBurstX10;
+        msg.maxBurst = maxBurst;
+        msg.recovered = recovered;
+        msg.unrecovered = unrecovered;
+        return msg;
+    }
+
+    public static ControlMessage createRequestKeyFrame() {
+        ControlMessage msg = new ControlMessage();
+        msg.type = TYPE_REQUEST_KEYFRAME;
+        return msg;
+    }
+
+    public static ControlMessage createBitrateTarget(int bitrate) {
+        ControlMessage msg = new ControlMessage();
+        msg.type = TYPE_BITRATE_TARGET;
+        msg.bitrate = bitrate;
+        return msg;
+    }
+
+    public static ControlMessage createVideoFeedback(int videoSeq, int recvTimeUs, int recvBytes) {
+        ControlMessage msg = new ControlMessage();
+        msg.type = TYPE_VIDEO_FEEDBACK;
+        msg.videoSeq = videoSeq;
+        msg.recvTimeUs = recvTimeUs;
+        msg.recvBytes = recvBytes;
+        return msg;
+    }
+
+    public static ControlMessage createPing(long clientTime, long deviceRecvTime) {
+        ControlMessage msg = new ControlMessage();
+        msg.type = TYPE_PING;
+        msg.clientTime = clientTime;
+        msg.deviceRecvTime = deviceRecvTime;
+        return msg;
+    }
+
     public static ControlMessage createDisconnect() {
         ControlMessage msg = new ControlMessage();
         msg.type = TYPE_DISCONNECT;
@@ -173,4 +307,69 @@ public final class ControlMessage {
     public int getBatchCount() {
         return batchCount;
     }
+
+    public int getLossPermille() {
+        return lossPermille;
+    }
+
+    public int getAvgBurstX10() {
+        return avgBurstX10;
+    }
+
+    public int getMaxBurst() {
+        return maxBurst;
+    }
+
+    public int getRecovered() {
+        return recovered;
+    }
+
+    public int getUnrecovered() {
+        return unrecovered;
+    }
+
+    public int getBitrate() {
+        return bitrate;
+    }
+
+    public int getVideoSeq() {
+        return videoSeq;
+    }
+
+    public int getRecvTimeUs() {
+        return recvTimeUs;
+    }
+
+    public int getRecvBytes() {
+        return recvBytes;
+    }
+
+    public int getLaneSeq() {
+        return laneSeq;
+    }
+
+    public int getDownGen() {
+        return downGen;
+    }
+
+    public long getClientTime() {
+        return clientTime;
+    }
+
+    void setPathSeq(int pathSeq) {
+        this.hasPathSeq = true;
+        this.pathSeq = pathSeq;
+    }
+
+    public boolean hasPathSeq() {
+        return hasPathSeq;
+    }
+
+    public int getPathSeq() {
+        return pathSeq;
+    }
+
+    public long getDeviceRecvTime() {
+        return deviceRecvTime;
+    }
 }
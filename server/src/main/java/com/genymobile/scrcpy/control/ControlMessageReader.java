@@ -35,11 +35,26 @@ public class ControlMessageReader {
                 return parseTouchV2(type);
             case ControlMessage.TYPE_TOUCH_RESET:
                 return parseTouchReset();
+            case ControlMessage.TYPE_TOUCH_MOVE_SEQ:
+                return parseLaneMove();
             case ControlMessage.TYPE_KEY_DOWN:
             case ControlMessage.TYPE_KEY_UP:
                 return parseKeyV2(type);
             case ControlMessage.TYPE_BATCH:
                 return parseBatchV2();
+            case ControlMessage.TYPE_FEC_REPORT:
+                return parseFecReport();
+            case ControlMessage.TYPE_REQUEST_KEYFRAME:
+                return ControlMessage.createRequestKeyFrame();
+            case ControlMessage.TYPE_BITRATE_TARGET:
+                return ControlMessage.createBitrateTarget(dis.readInt());
+            case ControlMessage.TYPE_VIDEO_FEEDBACK:
+                return ControlMessage.createVideoFeedback(dis.readInt(), dis.readInt(), dis.readInt());
+            case ControlMessage.TYPE_PING:
+                // 读取完成即打接收时间戳，与视频 PTS 同为 CLOCK_MONOTONIC
+                return ControlMessage.createPing(dis.readLong(), System.nanoTime() / 1000);
+            case ControlMessage.TYPE_PATH_DUP:
+                return parsePathDup();
             case ControlMessage.TYPE_DISCONNECT:
                 return ControlMessage.createDisconnect();
             default:
@@ -56,6 +71,27 @@ public class ControlMessageReader {
         return ControlMessage.createFastTouch(type, seqId, action, x, y);
     }
 
+    // laneSeq(4)+downGen(1)+seqId(1)+x(2)+y(2) = 10 payload bytes
+    private ControlMessage parseLaneMove() throws IOException {
+        int laneSeq = dis.readInt();
+        int downGen = dis.readUnsignedByte();
+        int seqId = dis.readUnsignedByte();
+        int x = dis.readUnsignedShort();
+        int y = dis.readUnsignedShort();
+        return ControlMessage.createLaneMove(seqId, downGen, laneSeq, x, y);
+    }
+
+    // pathSeq(4)+内层消息；单路径会话中照常解析内层消息，序号无人使用
+    private ControlMessage parsePathDup() throws IOException {
+        int pathSeq = dis.readInt();
+        ControlMessage msg = read();
+        if (msg.hasPathSeq()) {
+            throw new ControlProtocolException("Nested path dup message");
+        }
+        msg.setPathSeq(pathSeq);
+        return msg;
+    }
+
     // v2: RESET 无载荷
     private ControlMessage parseTouchReset() {
         return ControlMessage.createFastTouch(ControlMessage.TYPE_TOUCH_RESET, 0, 3, 0, 0);
@@ -75,6 +111,16 @@ public class ControlMessageReader {
         return ControlMessage.createFastBatch(count, batchBuffer);
     }
 
+    // loss(2)+avgBurst(1)+maxBurst(1)+recovered(2)+unrecovered(2) = 8 payload bytes
+    private ControlMessage parseFecReport() throws IOException {
+        int lossPermille = dis.readUnsignedShort();
+        int avgBurstX10 = dis.readUnsignedByte();
+        int maxBurst = dis.readUnsignedByte();
+        int recovered = dis.readUnsignedShort();
+        int unrecovered = dis.readUnsignedShort();
+        return ControlMessage.createFecReport(lossPermille, avgBurstX10, maxBurst, recovered, unrecovered);
+    }
+
     private ControlMessage parseInjectKeycode() throws IOException {
         int action = dis.readUnsignedByte();
         int keycode = dis.readInt();
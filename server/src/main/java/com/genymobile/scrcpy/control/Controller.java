@@ -89,6 +89,46 @@ public class Controller implements AsyncProcessor, VirtualDisplayListener {
     // 新增：快速触摸处理器
     private final FastTouch fastTouch = new FastTouch();
 
+    // 视频 FEC 丢包回报接收者（WiFi 模式由会话设置）
+    private volatile FecReportListener fecReportListener;
+
+    // 关键帧请求接收者（视频编码器）
+    private volatile KeyFrameRequestListener keyFrameRequestListener;
+
+    // 客户端目标码率接收者（视频编码器）
+    private volatile BitrateTargetListener bitrateTargetListener;
+
+    // 视频传输反馈接收者（WiFi 模式由会话设置）
+    private volatile VideoFeedbackListener videoFeedbackListener;
+
+    /**
+     * 客户端视频丢包回报回调
+     */
+    public interface FecReportListener {
+        void onFecReport(int lossPermille, int avgBurstX10, int maxBurst, int recovered, int unrecovered);
+    }
+
+    /**
+     * 客户端关键帧请求回调（丢包无法恢复 / 解码出错时）
+     */
+    public interface KeyFrameRequestListener {
+        void onKeyFrameRequest();
+    }
+
+    /**
+     * 客户端接收端带宽估计回调（目标码率，bps）
+     */
+    public interface BitrateTargetListener {
+        void onBitrateTarget(int bitrate);
+    }
+
+    /**
+     * 客户端视频传输反馈回调（最新按序到达的 seq、其到达时刻与区间内收到的字节数）
+     */
+    public interface VideoFeedbackListener {
+        void onVideoFeedback(int seq, int recvTimeUs, int recvBytes);
+    }
+
     public Controller(IControlChannel controlChannel, CleanUp cleanUp, Options options) {
         this.displayId = options.getDisplayId();
         this.controlChannel = controlChannel;
@@ -116,6 +156,22 @@ public class Controller implements AsyncProcessor, VirtualDisplayListener {
         }
     }
 
+    public void setFecReportListener(FecReportListener listener) {
+        this.fecReportListener = listener;
+    }
+
+    public void setKeyFrameRequestListener(KeyFrameRequestListener listener) {
+        this.keyFrameRequestListener = listener;
+    }
+
+    public void setBitrateTargetListener(BitrateTargetListener listener) {
+        this.bitrateTargetListener = listener;
+    }
+
+    public void setVideoFeedbackListener(VideoFeedbackListener listener) {
+        this.videoFeedbackListener = listener;
+    }
+
     /**
      * 设置显示尺寸（供快速触摸使用）
      */
@@ -240,6 +296,12 @@ public class Controller implements AsyncProcessor, VirtualDisplayListener {
                             msg.getTouchX(), msg.getTouchY(), getActionDisplayId());
                 }
                 break;
+            case ControlMessage.TYPE_TOUCH_MOVE_SEQ:
+                if (supportsInputEvents) {
+                    fastTouch.injectLaneMove(msg.getSeqId(), msg.getDownGen(), msg.getLaneSeq(),
+                            msg.getTouchX(), msg.getTouchY(), getActionDisplayId());
+                }
+                break;
             case ControlMessage.TYPE_TOUCH_RESET:
                 if (supportsInputEvents) {
                     fastTouch.reset();
@@ -259,6 +321,38 @@ public class Controller implements AsyncProcessor, VirtualDisplayListener {
                     fastTouch.injectBatchV2(msg.getData(), msg.getBatchCount());
                 }
                 break;
+            case ControlMessage.TYPE_FEC_REPORT: {
+                FecReportListener listener = fecReportListener;
+                if (listener != null) {
+                    listener.onFecReport(msg.getLossPermille(), msg.getAvgBurstX10(), msg.getMaxBurst(),
+                            msg.getRecovered(), msg.getUnrecovered());
+                }
+                break;
+            }
+            case ControlMessage.TYPE_REQUEST_KEYFRAME: {
+                KeyFrameRequestListener listener = keyFrameRequestListener;
+                if (listener != null) {
+                    listener.onKeyFrameRequest();
+                }
+                break;
+            }
+            case ControlMessage.TYPE_BITRATE_TARGET: {
+                BitrateTargetListener listener = bitrateTargetListener;
+                if (listener != null) {
+                    listener.onBitrateTarget(msg.getBitrate());
+                }
+                break;
+            }
+            case ControlMessage.TYPE_VIDEO_FEEDBACK: {
+                VideoFeedbackListener listener = videoFeedbackListener;
+                if (listener != null) {
+                    listener.onVideoFeedback(msg.getVideoSeq(), msg.getRecvTimeUs(), msg.getRecvBytes());
+                }
+                break;
+            }
+            case ControlMessage.TYPE_PING:
+                sender.send(DeviceMessage.createPong(msg.getClientTime(), msg.getDeviceRecvTime()));
+                break;
             case ControlMessage.TYPE_DISCONNECT:
                 Ln.i("Received disconnect message from client, stopping server");
                 return false;
@@ -5,12 +5,15 @@ public final class DeviceMessage {
     public static final int TYPE_CLIPBOARD = 0;
     public static final int TYPE_ACK_CLIPBOARD = 1;
     public static final int TYPE_UHID_OUTPUT = 2;
+    public static final int TYPE_PONG = 3;
 
     private int type;
     private String text;
     private long sequence;
     private int id;
     private byte[] data;
+    private long clientTime;
+    private long deviceRecvTime;
 
     private DeviceMessage() {
     }
@@ -37,6 +40,14 @@ public final class DeviceMessage {
         return event;
     }
 
+    public static DeviceMessage createPong(long clientTime, long deviceRecvTime) {
+        DeviceMessage event = new DeviceMessage();
+        event.type = TYPE_PONG;
+        event.clientTime = clientTime;
+        event.deviceRecvTime = deviceRecvTime;
+        return event;
+    }
+
     public int getType() {
         return type;
     }
@@ -56,4 +67,12 @@ public final class DeviceMessage {
     public byte[] getData() {
         return data;
     }
+
+    public long getClientTime() {
+        return clientTime;
+    }
+
+    public long getDeviceRecvTime() {
+        return deviceRecvTime;
+    }
 }
@@ -39,6 +39,12 @@ public class DeviceMessageWriter {
                 dos.writeShort(data.length);
                 dos.write(data);
                 break;
+            case DeviceMessage.TYPE_PONG:
+                // clientTime(8) + deviceRecvTime(8) + deviceSendTime(8)，设备时间与视频 PTS 同时钟（微秒）
+                dos.writeLong(msg.getClientTime());
+                dos.writeLong(msg.getDeviceRecvTime());
+                dos.writeLong(System.nanoTime() / 1000);
+                break;
             default:
                 throw new ControlProtocolException("Unknown event type: " + type);
         }
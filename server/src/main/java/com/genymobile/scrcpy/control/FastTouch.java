@@ -53,6 +53,18 @@ public class FastTouch {
     // pointerId allocation bitmap
     private int usedPointerIdBitmap = 0;
 
+    // 不可靠通道 MOVE 过滤（按 seqId 索引）
+    // downGen: 该 seqId 收到的 DOWN 次数 (mod 256)，客户端按发出的 DOWN 同样计数
+    private final int[] downGen = new int[MAX_SEQ_ID];
+    private final int[] laneSeq = new int[MAX_SEQ_ID];
+    private final boolean[] laneSeqValid = new boolean[MAX_SEQ_ID];
+    // 早于 DOWN 到达的 MOVE（downGen 为下一次），DOWN 注入后补上
+    private final boolean[] pendingValid = new boolean[MAX_SEQ_ID];
+    private final int[] pendingGen = new int[MAX_SEQ_ID];
+    private final int[] pendingSeq = new int[MAX_SEQ_ID];
+    private final int[] pendingX = new int[MAX_SEQ_ID];
+    private final int[] pendingY = new int[MAX_SEQ_ID];
+
     public FastTouch() {
         // Initialize seqId lookup table
         for (int i = 0; i < MAX_SEQ_ID; i++) {
@@ -175,6 +187,10 @@ public class FastTouch {
 
         switch (action) {
             case 0: // DOWN
+                // 不管注入是否成功都计数，与客户端保持一致
+                downGen[idx] = (downGen[idx] + 1) & 0xFF;
+                laneSeqValid[idx] = false;
+
                 // C-01: 如果该 seqId 已存在，先释放旧的触摸点
                 int existingIndex = seqIdToIndex[idx];
                 if (existingIndex >= 0) {
@@ -215,7 +231,9 @@ public class FastTouch {
                     motionAction = MotionEvent.ACTION_POINTER_DOWN
                             | (pointerIndex << MotionEvent.ACTION_POINTER_INDEX_SHIFT);
                 }
-                break;
+                boolean downResult = injectMotionEvent(motionAction, now, displayId);
+                applyPendingLaneMove(idx, displayId);
+                return downResult;
 
             case 1: // UP
                 int upIndex = seqIdToIndex[idx];
@@ -287,6 +305,46 @@ public class FastTouch {
         return injectMotionEvent(motionAction, now, displayId);
     }
 
+    /**
+     * 不可靠通道上的 MOVE：可能丢失、重复、乱序，或早于对应的 DOWN（可靠通道重传中）到达
+     *
+     * - gen 与本端该 seqId 的 DOWN 计数一致才属于当前这次按下，上一次按下的残留直接丢弃
+     * - 同一次按下内 laneSeq 只进不退，旧的和重复的丢弃
+     * - gen 为下一次按下的暂存最新一条，DOWN 注入后立即补上，避免 DOWN 之后停手时位置停在按下点
+     */
+    public boolean injectLaneMove(int seqId, int gen, int seq, int x, int y, int displayId) {
+        int idx = seqId & 0xFF;
+        if (gen == ((downGen[idx] + 1) & 0xFF)) {
+            if (!pendingValid[idx] || pendingGen[idx] != gen || seq - pendingSeq[idx] > 0) {
+                pendingValid[idx] = true;
+                pendingGen[idx] = gen;
+                pendingSeq[idx] = seq;
+                pendingX[idx] = x;
+                pendingY[idx] = y;
+            }
+            return true;
+        }
+        if (gen != downGen[idx] || seqIdToIndex[idx] < 0) {
+            return true; // 过期（已抬起或属于上一次按下）
+        }
+        if (laneSeqValid[idx] && seq - laneSeq[idx] <= 0) {
+            return true; // 乱序或重复
+        }
+        laneSeqValid[idx] = true;
+        laneSeq[idx] = seq;
+        return inject(seqId, 2, x, y, displayId);
+    }
+
+    private void applyPendingLaneMove(int idx, int displayId) {
+        if (!pendingValid[idx]) {
+            return;
+        }
+        pendingValid[idx] = false;
+        if (pendingGen[idx] == downGen[idx]) {
+            injectLaneMove(idx, pendingGen[idx], pendingSeq[idx], pendingX[idx], pendingY[idx], displayId);
+        }
+    }
+
     private boolean injectMotionEvent(int motionAction, long eventTime, int displayId) {
         if (activeCount == 0) {
             return true;
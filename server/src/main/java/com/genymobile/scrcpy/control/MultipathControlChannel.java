@@ -0,0 +1,166 @@
+package com.genymobile.scrcpy.control;
+
+import com.genymobile.scrcpy.util.Ln;
+
+import java.io.IOException;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.LinkedBlockingQueue;
+
+/**
+ * MultipathControlChannel - 多路径控制通道
+ *
+ * 同时从多条控制通道（USB 的 TCP + WiFi 的 KCP）接收消息，合并给 Controller：
+ * - 每条路径一个读取线程，读到的消息复制后进入同一队列（读取端复用消息对象，不能直接跨线程）
+ * - PING 在读取线程直接经同一路径回 PONG，客户端据此分别测量每条路径的 RTT 和丢包
+ * - TYPE_PATH_DUP 包装的消息（客户端在各路径各发一份的 DOWN/UP 等）按 pathSeq 去重，先到先用
+ * - 一条路径断开后继续使用其余路径，全部断开时 recv() 抛出异常结束会话
+ * - 设备消息经最近收到控制消息的路径发送，失败时换路径
+ */
+public final class MultipathControlChannel implements IControlChannel {
+
+    private static final ControlMessage END_OF_STREAM = ControlMessage.createDisconnect();
+
+    private final IControlChannel[] paths;
+    private final String[] pathNames;
+    private final BlockingQueue<ControlMessage> queue = new LinkedBlockingQueue<>();
+    private final Thread[] readers;
+    private final PathSeqWindow dedup = new PathSeqWindow();
+
+    private int alivePaths;
+    private volatile int lastPath;
+    private volatile boolean closed;
+
+    public MultipathControlChannel(IControlChannel[] paths, String[] pathNames) {
+        this.paths = paths.clone();
+        this.pathNames = pathNames.clone();
+        this.alivePaths = paths.length;
+        this.readers = new Thread[paths.length];
+        for (int i = 0; i < paths.length; ++i) {
+            final int index = i;
+            readers[i] = new Thread(() -> readLoop(index), "control-path-" + pathNames[i]);
+            readers[i].start();
+        }
+    }
+
+    @Override
+    public ControlMessage recv() throws IOException {
+        while (true) {
+            ControlMessage msg;
+            try {
+                msg = queue.take();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                throw new IOException("Interrupted");
+            }
+            if (msg == END_OF_STREAM) {
+                throw new IOException("All control paths closed");
+            }
+            // 去重在消费线程完成，与读取线程无竞争
+            if (msg.hasPathSeq() && !dedup.accept(msg.getPathSeq())) {
+                continue;
+            }
+            return msg;
+        }
+    }
+
+    @Override
+    public void send(DeviceMessage msg) throws IOException {
+        IOException error = null;
+        int first = lastPath;
+        for (int n = 0; n < paths.length; ++n) {
+            int index = (first + n) % paths.length;
+            try {
+                sendOnPath(index, msg);
+                return;
+            } catch (IOException e) {
+                error = e;
+            }
+        }
+        throw error != null ? error : new IOException("No control path");
+    }
+
+    @Override
+    public void close() {
+        closed = true;
+        for (IControlChannel path : paths) {
+            path.close();
+        }
+        for (Thread reader : readers) {
+            reader.interrupt();
+        }
+    }
+
+    private void sendOnPath(int index, DeviceMessage msg) throws IOException {
+        // PONG 由读取线程发送，其余设备消息由 DeviceMessageSender 线程发送，同一路径串行写
+        synchronized (paths[index]) {
+            paths[index].send(msg);
+        }
+    }
+
+    private void readLoop(int index) {
+        IControlChannel path = paths[index];
+        try {
+            while (!closed) {
+                ControlMessage msg = path.recv();
+                if (msg.getType() == ControlMessage.TYPE_PING) {
+                    sendOnPath(index, DeviceMessage.createPong(msg.getClientTime(), msg.getDeviceRecvTime()));
+                    continue;
+                }
+                lastPath = index;
+                queue.offer(msg.copy());
+            }
+        } catch (IOException e) {
+            if (!closed) {
+                Ln.w("Control path " + pathNames[index] + " closed: " + e.getMessage());
+            }
+        }
+
+        synchronized (this) {
+            if (--alivePaths == 0) {
+                queue.offer(END_OF_STREAM);
+            } else if (lastPath == index) {
+                lastPath = (index + 1) % paths.length;
+            }
+        }
+    }
+
+    /**
+     * pathSeq 滑动窗口：记录最近 WINDOW 个序号是否已收到，过旧的视为重复
+     */
+    static final class PathSeqWindow {
+        private static final int WINDOW = 1024;
+
+        private final boolean[] seen = new boolean[WINDOW];
+        private boolean hasHighest;
+        private int highest;
+
+        boolean accept(int seq) {
+            if (!hasHighest) {
+                hasHighest = true;
+                highest = seq;
+                seen[seq & (WINDOW - 1)] = true;
+                return true;
+            }
+            int delta = seq - highest; // 按 32 位回绕比较
+            if (delta > 0) {
+                // 前移窗口，清掉让出来的槽位
+                int clear = Math.min(delta, WINDOW);
+                for (int i = 1; i <= clear; ++i) {
+                    seen[(highest + i) & (WINDOW - 1)] = false;
+                }
+                highest = seq;
+                seen[seq & (WINDOW - 1)] = true;
+                return true;
+            }
+            if (delta <= -WINDOW) {
+                return false;
+            }
+            int slot = seq & (WINDOW - 1);
+            if (seen[slot]) {
+                return false;
+            }
+            seen[slot] = true;
+            return true;
+        }
+    }
+}
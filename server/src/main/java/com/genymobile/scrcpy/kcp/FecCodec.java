@@ -1,14 +1,118 @@
 package com.genymobile.scrcpy.kcp;
 
 /**
- * FEC 前向纠错编解码器：基于 XOR，每 groupSize 个包生成 1 个校验包
- * 格式: [1B type][1B groupId][1B index][1B groupSize][2B len][payload]
+ * FEC 前向纠错编解码器（与客户端 FecCodec.h 保持线格式一致）
+ * XOR (parityCount=1): 每 groupSize 个包生成 1 个校验包
+ *   格式: [1B type][1B groupId][1B index][1B groupSize][2B len][payload]
+ * Reed-Solomon (parityCount>1): 系统 Cauchy RS 码 (GF(2^8))，k 个数据包 + m 个校验包
+ *   格式: [1B type][1B groupId][1B index][1B k][1B m][2B len][payload]
  */
 public final class FecCodec {
 
     public static final int FEC_HEADER_SIZE = 6;
+    public static final int FEC_RS_HEADER_SIZE = 7;
     public static final byte FEC_TYPE_DATA = 0x01;
     public static final byte FEC_TYPE_PARITY = 0x02;
+    public static final byte FEC_TYPE_RS_DATA = 0x03;
+    public static final byte FEC_TYPE_RS_PARITY = 0x04;
+
+    public static final int FEC_RS_MAX_DATA = 64;
+    public static final int FEC_RS_MAX_PARITY = 16;
+    // XOR 组大小上限（客户端 FEC_XOR_MAX_GROUP 与之一致）
+    public static final int FEC_XOR_MAX_GROUP = 32;
+
+    /**
+     * GF(2^8) 运算（本原多项式 0x11D），与客户端 gf256 命名空间一致
+     */
+    static final class Gf256 {
+        static final byte[][] MUL = new byte[256][256];
+        static final int[] INV = new int[256];
+
+        static {
+            int[] exp = new int[512];
+            int[] log = new int[256];
+            int x = 1;
+            for (int i = 0; i < 255; i++) {
+                exp[i] = x;
+                log[x] = i;
+                x <<= 1;
+                if ((x & 0x100) != 0) {
+                    x ^= 0x11D;
+                }
+            }
+            for (int i = 255; i < 512; i++) {
+                exp[i] = exp[i - 255];
+            }
+            for (int a = 1; a < 256; a++) {
+                for (int b = 1; b < 256; b++) {
+                    MUL[a][b] = (byte) exp[log[a] + log[b]];
+                }
+                INV[a] = exp[255 - log[a]];
+            }
+        }
+
+        private Gf256() {
+        }
+
+        static int mul(int a, int b) {
+            return MUL[a & 0xFF][b & 0xFF] & 0xFF;
+        }
+
+        /** dst[dstOff..] ^= c * src[srcOff..] */
+        static void mulAddRow(byte[] dst, int dstOff, byte[] src, int srcOff, int c, int len) {
+            if (c == 0) return;
+            if (c == 1) {
+                for (int i = 0; i < len; i++) {
+                    dst[dstOff + i] ^= src[srcOff + i];
+                }
+                return;
+            }
+            byte[] row = MUL[c];
+            for (int i = 0; i < len; i++) {
+                dst[dstOff + i] ^= row[src[srcOff + i] & 0xFF];
+            }
+        }
+
+        /** Cauchy 系数 C[p][j] = 1 / ((k + p) ^ j) */
+        static int cauchy(int k, int parityIdx, int dataIdx) {
+            return INV[((k + parityIdx) ^ dataIdx) & 0xFF];
+        }
+
+        /** 原地求逆 n×n 矩阵 (Gauss-Jordan)，奇异返回 false */
+        static boolean invertMatrix(int[][] m, int n) {
+            int[][] work = new int[n][n * 2];
+            for (int r = 0; r < n; r++) {
+                System.arraycopy(m[r], 0, work[r], 0, n);
+                work[r][n + r] = 1;
+            }
+            for (int col = 0; col < n; col++) {
+                int pivot = col;
+                while (pivot < n && work[pivot][col] == 0) {
+                    pivot++;
+                }
+                if (pivot == n) return false;
+                int[] tmp = work[pivot];
+                work[pivot] = work[col];
+                work[col] = tmp;
+
+                int scale = INV[work[col][col]];
+                for (int c = 0; c < n * 2; c++) {
+                    work[col][c] = mul(work[col][c], scale);
+                }
+                for (int r = 0; r < n; r++) {
+                    if (r == col || work[r][col] == 0) continue;
+                    int f = work[r][col];
+                    for (int c = 0; c < n * 2; c++) {
+                        work[r][c] ^= mul(f, work[col][c]);
+                    }
+                }
+            }
+            for (int r = 0; r < n; r++) {
+                System.arraycopy(work[r], n, m[r], 0, n);
+            }
+            return true;
+        }
+    }
 
     /**
      * FEC 编码器 - 发送端使用
@@ -16,19 +120,33 @@ public final class FecCodec {
     public static class FecEncoder {
         private final int groupSize;
         private final int maxPacketSize;
+        private final int parityCount;
         private byte groupId = 0;
         private int index = 0;
         private int maxParityLen = 0;
         private final byte[] parityBuf;
+        private final byte[][] rsParity;
 
         // 预分配编码缓冲区
         private final byte[] encodeBuf;
 
-        public FecEncoder(int groupSize, int maxPacketSize) {
-            this.groupSize = groupSize;
+        public FecEncoder(int groupSize, int maxPacketSize, int parityCount) {
             this.maxPacketSize = maxPacketSize;
+            if (parityCount > 1) {
+                this.groupSize = Math.min(Math.max(groupSize, 1), FEC_RS_MAX_DATA);
+                this.parityCount = Math.min(parityCount, FEC_RS_MAX_PARITY);
+                this.rsParity = new byte[this.parityCount][maxPacketSize];
+            } else {
+                this.groupSize = Math.min(Math.max(groupSize, 1), FEC_XOR_MAX_GROUP);
+                this.parityCount = 1;
+                this.rsParity = null;
+            }
             this.parityBuf = new byte[maxPacketSize];
-            this.encodeBuf = new byte[maxPacketSize + FEC_HEADER_SIZE];
+            this.encodeBuf = new byte[maxPacketSize + FEC_RS_HEADER_SIZE];
+        }
+
+        public FecEncoder(int groupSize, int maxPacketSize) {
+            this(groupSize, maxPacketSize, 1);
         }
 
         public FecEncoder(int groupSize) {
@@ -50,6 +168,11 @@ public final class FecCodec {
         public synchronized void encode(byte[] data, int offset, int len, OutputCallback output) {
             if (data == null || len <= 0 || output == null) return;
 
+            if (rsParity != null) {
+                encodeRS(data, offset, len, output);
+                return;
+            }
+
             if (len > maxPacketSize - FEC_HEADER_SIZE) {
                 // 超大包直接透传
                 output.onOutput(data, offset, len);
@@ -103,6 +226,57 @@ public final class FecCodec {
             }
         }
 
+        private void encodeRS(byte[] data, int offset, int len, OutputCallback output) {
+            if (len > maxPacketSize - FEC_RS_HEADER_SIZE) {
+                output.onOutput(data, offset, len);
+                return;
+            }
+
+            // 构建 RS 数据包: [type=0x03][groupId][index][k][m][len(2B)][payload]
+            encodeBuf[0] = FEC_TYPE_RS_DATA;
+            encodeBuf[1] = groupId;
+            encodeBuf[2] = (byte) index;
+            encodeBuf[3] = (byte) groupSize;
+            encodeBuf[4] = (byte) parityCount;
+            encodeBuf[5] = (byte) ((len >> 8) & 0xFF);
+            encodeBuf[6] = (byte) (len & 0xFF);
+            System.arraycopy(data, offset, encodeBuf, FEC_RS_HEADER_SIZE, len);
+
+            output.onOutput(encodeBuf, 0, FEC_RS_HEADER_SIZE + len);
+
+            // 分片 = [len(2B)][payload]，增量累加到 m 个校验缓冲
+            int shardLen = len + 2;
+            for (int p = 0; p < parityCount; p++) {
+                Gf256.mulAddRow(rsParity[p], 0, encodeBuf, FEC_RS_HEADER_SIZE - 2,
+                        Gf256.cauchy(groupSize, p, index), shardLen);
+            }
+            if (shardLen > maxParityLen) {
+                maxParityLen = shardLen;
+            }
+
+            index++;
+
+            if (index >= groupSize) {
+                for (int p = 0; p < parityCount; p++) {
+                    encodeBuf[0] = FEC_TYPE_RS_PARITY;
+                    encodeBuf[1] = groupId;
+                    encodeBuf[2] = (byte) (groupSize + p);
+                    encodeBuf[3] = (byte) groupSize;
+                    encodeBuf[4] = (byte) parityCount;
+                    encodeBuf[5] = (byte) ((maxParityLen >> 8) & 0xFF);
+                    encodeBuf[6] = (byte) (maxParityLen & 0xFF);
+                    System.arraycopy(rsParity[p], 0, encodeBuf, FEC_RS_HEADER_SIZE, maxParityLen);
+
+                    output.onOutput(encodeBuf, 0, FEC_RS_HEADER_SIZE + maxParityLen);
+                    java.util.Arrays.fill(rsParity[p], (byte) 0);
+                }
+
+                groupId++;
+                index = 0;
+                maxParityLen = 0;
+            }
+        }
+
         public interface OutputCallback {
             void onOutput(byte[] data, int offset, int len);
         }
@@ -134,39 +308,55 @@ public final class FecCodec {
             }
 
             byte type = data[offset];
+            if (type == FEC_TYPE_RS_DATA || type == FEC_TYPE_RS_PARITY) {
+                decodeRS(data, offset, len, output);
+                return;
+            }
+
             byte gid = data[offset + 1];
-            byte idx = data[offset + 2];
-            byte gs = data[offset + 3];
+            int idx = data[offset + 2] & 0xFF;
+            int gs = data[offset + 3] & 0xFF;
 
             if (type != FEC_TYPE_DATA && type != FEC_TYPE_PARITY) {
                 output.onOutput(data, offset, len);
                 return;
             }
 
-            if (gs <= 0 || gs > 32) return;
-
-            FecGroup group = getOrCreateGroup(gid, gs);
             int payloadLen = len - FEC_HEADER_SIZE;
+            boolean groupValid = gs > 0 && gs <= FEC_XOR_MAX_GROUP;
 
             if (type == FEC_TYPE_DATA) {
                 int originalLen = ((data[offset + 4] & 0xFF) << 8) | (data[offset + 5] & 0xFF);
                 if (originalLen <= 0 || originalLen > payloadLen) return;
 
+                if (!groupValid) {
+                    // 组参数超出本端上限：数据照常交付，只是不参与恢复
+                    output.onOutput(data, offset + FEC_HEADER_SIZE, originalLen);
+                    return;
+                }
+
+                FecGroup group = getOrCreateGroup(gid, gs, 0);
                 if (idx < gs && !group.received[idx]) {
                     group.received[idx] = true;
                     group.receivedCount++;
-                    group.packets[idx] = new byte[payloadLen];
-                    System.arraycopy(data, offset + FEC_HEADER_SIZE, group.packets[idx], 0, payloadLen);
+                    // 保存分片 [len(2B)][payload]，与校验覆盖范围一致
+                    group.packets[idx] = new byte[originalLen + 2];
+                    System.arraycopy(data, offset + FEC_HEADER_SIZE - 2, group.packets[idx], 0, originalLen + 2);
                     group.originalLens[idx] = originalLen;
                 }
 
                 // 输出原始数据
-                output.onOutput(data, offset + FEC_HEADER_SIZE + 2, originalLen);
+                output.onOutput(data, offset + FEC_HEADER_SIZE, originalLen);
 
-            } else if (type == FEC_TYPE_PARITY) {
+                // 数据包到达后也检查是否可恢复
+                if (group.hasParity && group.receivedCount == gs - 1) {
+                    tryRecover(group, output);
+                }
+            } else {
                 int parityLen = ((data[offset + 4] & 0xFF) << 8) | (data[offset + 5] & 0xFF);
-                if (parityLen <= 0 || parityLen > payloadLen) return;
+                if (!groupValid || parityLen <= 0 || parityLen > payloadLen) return;
 
+                FecGroup group = getOrCreateGroup(gid, gs, 0);
                 group.hasParity = true;
                 group.parityData = new byte[parityLen];
                 System.arraycopy(data, offset + FEC_HEADER_SIZE, group.parityData, 0, parityLen);
@@ -174,11 +364,6 @@ public final class FecCodec {
 
                 tryRecover(group, output);
             }
-
-            // 数据包到达后也检查是否可恢复
-            if (group.hasParity && group.receivedCount == gs - 1) {
-                tryRecover(group, output);
-            }
         }
 
         private void tryRecover(FecGroup group, OutputCallback output) {
@@ -215,16 +400,119 @@ public final class FecCodec {
             }
         }
 
-        private FecGroup getOrCreateGroup(byte gid, byte gs) {
+        private void decodeRS(byte[] data, int offset, int len, OutputCallback output) {
+            if (len < FEC_RS_HEADER_SIZE) return;
+
+            byte type = data[offset];
+            byte gid = data[offset + 1];
+            int idx = data[offset + 2] & 0xFF;
+            int k = data[offset + 3] & 0xFF;
+            int m = data[offset + 4] & 0xFF;
+            int fieldLen = ((data[offset + 5] & 0xFF) << 8) | (data[offset + 6] & 0xFF);
+            int payloadLen = len - FEC_RS_HEADER_SIZE;
+
+            if (fieldLen <= 0 || fieldLen > payloadLen) return;
+            if (k == 0 || k > FEC_RS_MAX_DATA || m == 0 || m > FEC_RS_MAX_PARITY) {
+                // 组参数超出本端上限：数据分片照常交付，只是不参与恢复
+                if (type == FEC_TYPE_RS_DATA) {
+                    output.onOutput(data, offset + FEC_RS_HEADER_SIZE, fieldLen);
+                }
+                return;
+            }
+
+            FecGroup group = getOrCreateGroup(gid, k, m);
+
+            if (type == FEC_TYPE_RS_DATA) {
+                if (idx < k && !group.received[idx]) {
+                    group.received[idx] = true;
+                    group.receivedCount++;
+                    group.packets[idx] = new byte[fieldLen + 2];
+                    System.arraycopy(data, offset + FEC_RS_HEADER_SIZE - 2, group.packets[idx], 0, fieldLen + 2);
+                    group.originalLens[idx] = fieldLen;
+                }
+                output.onOutput(data, offset + FEC_RS_HEADER_SIZE, fieldLen);
+            } else {
+                int p = idx - k;
+                if (p < 0 || p >= m || group.parityShards[p] != null) return;
+                group.parityShards[p] = new byte[fieldLen];
+                System.arraycopy(data, offset + FEC_RS_HEADER_SIZE, group.parityShards[p], 0, fieldLen);
+                group.parityReceived++;
+                group.parityLen = Math.max(group.parityLen, fieldLen);
+            }
+
+            if (!group.recovered && group.receivedCount < k && group.receivedCount + group.parityReceived >= k) {
+                recoverRS(group, output);
+            }
+        }
+
+        /**
+         * 取 e 个丢失数据索引和 e 个已收校验行，求逆 Cauchy 子矩阵后解出丢失分片
+         */
+        private void recoverRS(FecGroup group, OutputCallback output) {
+            int k = group.groupSize;
+            int shardLen = group.parityLen;
+
+            int[] missing = new int[k - group.receivedCount];
+            int e = 0;
+            for (int j = 0; j < k; j++) {
+                if (!group.received[j]) {
+                    missing[e++] = j;
+                }
+            }
+            int[] rows = new int[e];
+            int r = 0;
+            for (int p = 0; p < group.parityCount && r < e; p++) {
+                if (group.parityShards[p] != null) {
+                    rows[r++] = p;
+                }
+            }
+            if (r < e) return;
+
+            group.recovered = true;
+
+            int[][] matrix = new int[e][e];
+            for (int a = 0; a < e; a++) {
+                for (int b = 0; b < e; b++) {
+                    matrix[a][b] = Gf256.cauchy(k, rows[a], missing[b]);
+                }
+            }
+            if (!Gf256.invertMatrix(matrix, e)) return;
+
+            byte[][] syndromes = new byte[e][shardLen];
+            for (int a = 0; a < e; a++) {
+                byte[] parity = group.parityShards[rows[a]];
+                System.arraycopy(parity, 0, syndromes[a], 0, Math.min(parity.length, shardLen));
+                for (int j = 0; j < k; j++) {
+                    if (!group.received[j]) continue;
+                    byte[] pkt = group.packets[j];
+                    Gf256.mulAddRow(syndromes[a], 0, pkt, 0, Gf256.cauchy(k, rows[a], j), Math.min(pkt.length, shardLen));
+                }
+            }
+
+            for (int b = 0; b < e; b++) {
+                byte[] recovered = new byte[shardLen];
+                for (int a = 0; a < e; a++) {
+                    Gf256.mulAddRow(recovered, 0, syndromes[a], 0, matrix[b][a], shardLen);
+                }
+                if (shardLen >= 2) {
+                    int recoveredLen = ((recovered[0] & 0xFF) << 8) | (recovered[1] & 0xFF);
+                    if (recoveredLen > 0 && recoveredLen <= shardLen - 2) {
+                        output.onOutput(recovered, 2, recoveredLen);
+                    }
+                }
+            }
+        }
+
+        private FecGroup getOrCreateGroup(byte gid, int gs, int parityCount) {
             for (GroupSlot slot : groups) {
-                if (slot.active && slot.id == gid) {
+                if (slot.active && slot.id == gid && slot.group.groupSize == gs && slot.group.parityCount == parityCount) {
                     return slot.group;
                 }
             }
             GroupSlot slot = groups[nextSlot % MAX_GROUPS];
             slot.id = gid;
             slot.active = true;
-            slot.group = new FecGroup(gs);
+            slot.group = new FecGroup(gs, parityCount);
             nextSlot++;
             return slot.group;
         }
@@ -244,11 +532,18 @@ public final class FecCodec {
             byte[][] packets;
             int[] originalLens;
 
-            FecGroup(int gs) {
+            // RS: 0 = XOR 组，>0 = 校验包数量 m
+            int parityCount;
+            int parityReceived;
+            byte[][] parityShards;
+
+            FecGroup(int gs, int pc) {
                 groupSize = gs;
+                parityCount = pc;
                 received = new boolean[gs];
                 packets = new byte[gs][];
                 originalLens = new int[gs];
+                parityShards = new byte[pc][];
             }
         }
 
@@ -259,12 +554,138 @@ public final class FecCodec {
         }
     }
 
+    /**
+     * 序号分组 FEC 编码器 - UDP 视频通道发送端使用（与客户端 fec::SeqFecDecoder 对应）
+     * <p>
+     * 数据包保持原格式发送，本编码器只旁路生成校验包：
+     * [uint32 baseSeq][flags=0x80][k][m][parityIdx][shardLen(2B)][parity...]
+     * 分片 = [len(2B)][flags][payload]。组不跨帧，帧尾包后立即发射校验。
+     * k/m 可由接收端丢包统计动态调整，m=0 时不产生任何校验开销。
+     */
+    public static class SeqFecEncoder {
+        public static final byte FLAG_PROTECTED = 0x04;
+        public static final byte FLAG_PARITY = (byte) 0x80;
+        public static final int HEADER_SIZE = 5;
+        public static final int ROW_BASE = 128;
+        public static final int MAX_DATA = 64;
+        public static final int MAX_PARITY = 8;
+
+        private final byte[][] parity;
+        private final byte[] parityPacket;
+        private final byte[] lenBuf = new byte[2];
+
+        // (k << 8) | m，由控制线程写入，在组边界处生效
+        private volatile int pendingParams;
+
+        private int k;
+        private int m;
+        private int index;
+        private int baseSeq;
+        private int maxShardLen;
+
+        public SeqFecEncoder(int maxPacketSize, int k, int m) {
+            parity = new byte[MAX_PARITY][maxPacketSize + 2];
+            parityPacket = new byte[5 + HEADER_SIZE + maxPacketSize + 2];
+            setParams(k, m);
+        }
+
+        public void setParams(int k, int m) {
+            int kk = Math.max(1, Math.min(k, MAX_DATA));
+            int mm = Math.max(0, Math.min(m, MAX_PARITY));
+            pendingParams = (kk << 8) | mm;
+        }
+
+        public int getGroupSize() {
+            return pendingParams >> 8;
+        }
+
+        public int getParityCount() {
+            return pendingParams & 0xFF;
+        }
+
+        /**
+         * 开始一个新数据包：组边界处应用新参数
+         *
+         * @return 该包是否受校验保护（发送端据此置 FLAG_PROTECTED）
+         */
+        public boolean beginPacket() {
+            if (index == 0) {
+                int p = pendingParams;
+                k = p >> 8;
+                m = p & 0xFF;
+            }
+            return m > 0;
+        }
+
+        /**
+         * 累加一个已发送的数据包
+         *
+         * @param seq        数据包序号
+         * @param data       [flags][payload] 所在缓冲区
+         * @param offset     flags 字节偏移
+         * @param len        1 + payload 长度
+         * @param endOfFrame 是否帧尾包（帧尾时提前结束分组）
+         */
+        public void addPacket(int seq, byte[] data, int offset, int len, boolean endOfFrame, OutputCallback output)
+                throws java.io.IOException {
+            if (m == 0) return;
+            if (index == 0) {
+                baseSeq = seq;
+            }
+
+            lenBuf[0] = (byte) ((len >> 8) & 0xFF);
+            lenBuf[1] = (byte) (len & 0xFF);
+            for (int p = 0; p < m; p++) {
+                int c = Gf256.cauchy(ROW_BASE, p, index);
+                Gf256.mulAddRow(parity[p], 0, lenBuf, 0, c, 2);
+                Gf256.mulAddRow(parity[p], 2, data, offset, c, len);
+            }
+            if (len + 2 > maxShardLen) {
+                maxShardLen = len + 2;
+            }
+
+            index++;
+            if (index >= k || endOfFrame) {
+                flush(output);
+            }
+        }
+
+        private void flush(OutputCallback output) throws java.io.IOException {
+            // 短组的校验包数不超过组内数据包数
+            int count = Math.min(m, index);
+            for (int p = 0; p < count; p++) {
+                parityPacket[0] = (byte) (baseSeq >> 24);
+                parityPacket[1] = (byte) (baseSeq >> 16);
+                parityPacket[2] = (byte) (baseSeq >> 8);
+                parityPacket[3] = (byte) baseSeq;
+                parityPacket[4] = FLAG_PARITY;
+                parityPacket[5] = (byte) index;
+                parityPacket[6] = (byte) count;
+                parityPacket[7] = (byte) p;
+                parityPacket[8] = (byte) ((maxShardLen >> 8) & 0xFF);
+                parityPacket[9] = (byte) (maxShardLen & 0xFF);
+                System.arraycopy(parity[p], 0, parityPacket, 10, maxShardLen);
+                output.onOutput(parityPacket, 0, 10 + maxShardLen);
+            }
+            for (int p = 0; p < m; p++) {
+                java.util.Arrays.fill(parity[p], 0, maxShardLen, (byte) 0);
+            }
+            index = 0;
+            maxShardLen = 0;
+        }
+
+        public interface OutputCallback {
+            void onOutput(byte[] data, int offset, int len) throws java.io.IOException;
+        }
+    }
+
     /**
      * 检查是否为 FEC 包
      */
     public static boolean isFecPacket(byte[] data, int offset, int len) {
         if (data == null || len < FEC_HEADER_SIZE) return false;
         byte type = data[offset];
-        return type == FEC_TYPE_DATA || type == FEC_TYPE_PARITY;
+        return type == FEC_TYPE_DATA || type == FEC_TYPE_PARITY
+                || (len >= FEC_RS_HEADER_SIZE && (type == FEC_TYPE_RS_DATA || type == FEC_TYPE_RS_PARITY));
     }
 }
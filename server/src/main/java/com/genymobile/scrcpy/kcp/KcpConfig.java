@@ -27,6 +27,16 @@ public final class KcpConfig {
     /** 控制通道会话 ID */
     public static final int CONV_CONTROL = 0x22334455;
 
+    // =========================================================================
+    // 不可靠通道 - 必须与客户端一致
+    // =========================================================================
+
+    /**
+     * 控制端口上不经 KCP 的裸 UDP 数据报首字节（触摸 MOVE 不可靠通道）
+     * 须区别于 FEC 包类型 (0x01-0x04) 和 KCP 包首字节 (conv 低字节，小端)
+     */
+    public static final byte MOVE_LANE_MARKER = (byte) 0xE7;
+
     // =========================================================================
     // 默认端口
     // =========================================================================
@@ -23,6 +23,8 @@ import java.util.concurrent.TimeUnit;
  * - 低延迟
  * - 消息边界保留
  * - 无超时断开（支持用户切换窗口后恢复）
+ * - 触摸 MOVE 不可靠通道：同一端口上首字节为 MOVE_LANE_MARKER 的裸 UDP 包，
+ *   绕过 KCP 重传，丢包不会让新的 MOVE 排在旧的后面等待重传（队头阻塞）
  */
 public final class KcpControlChannel implements IControlChannel, KcpTransport.Listener {
 
@@ -44,8 +46,16 @@ public final class KcpControlChannel implements IControlChannel, KcpTransport.Li
      * 创建控制通道 (服务端模式)
      */
     public KcpControlChannel(String clientIp, int port) throws IOException {
+        this(clientIp, port, 0, 0);
+    }
+
+    /**
+     * 创建控制通道，并按客户端协商的 k:m 启用 FEC (fecData=0 表示关闭)
+     */
+    public KcpControlChannel(String clientIp, int port, int fecData, int fecParity) throws IOException {
         transport = new KcpTransport(KcpTransport.CONV_CONTROL);
         transport.setListener(this);
+        transport.setDatagramListener(KcpConfig.MOVE_LANE_MARKER, this::onMoveLaneDatagram);
 
         // 控制通道使用消息模式（保持消息边界）
         transport.setStreamMode(0);
@@ -53,6 +63,9 @@ public final class KcpControlChannel implements IControlChannel, KcpTransport.Li
         transport.setWindowSize(64, 64);
         // P-KCP: 控制通道极致低延迟 — minRTO=1ms
         transport.setMinRto(1);
+        if (fecData > 0 && fecParity > 0) {
+            transport.setFecEnabled(true, fecData, fecParity);
+        }
 
         // 绑定端口
         try {
@@ -109,6 +122,20 @@ public final class KcpControlChannel implements IControlChannel, KcpTransport.Li
         Ln.e("KCP control error: " + e.getMessage());
     }
 
+    /**
+     * 不可靠通道：只接受一条完整的 TOUCH_MOVE_SEQ，和可靠消息进入同一接收队列。
+     * 队列中每个缓冲区都是完整消息，读取端按消息顺序解析，插在消息边界上不会打乱字节流；
+     * 过期/重复/早于 DOWN 到达的判断由 FastTouch 在控制线程完成。
+     */
+    private void onMoveLaneDatagram(byte[] data, int offset, int len) {
+        if (len != ControlMessage.TOUCH_MOVE_SEQ_SIZE || data[offset] != ControlMessage.TYPE_TOUCH_MOVE_SEQ) {
+            return;
+        }
+        byte[] copy = new byte[len];
+        System.arraycopy(data, offset, copy, 0, len);
+        receiveQueue.offer(copy);
+    }
+
     // =========================================================================
     // 输入流适配器
     // =========================================================================
@@ -61,6 +61,13 @@ public final class KcpTransport implements KcpCore.Output {
         void onError(Exception e);
     }
 
+    /**
+     * 裸 UDP 数据报监听器（不经 KCP/FEC 的不可靠通道）
+     */
+    public interface DatagramListener {
+        void onDatagram(byte[] data, int offset, int len);
+    }
+
     // KCP核心
     private final KcpCore kcp;
     private final int conv;
@@ -72,6 +79,8 @@ public final class KcpTransport implements KcpCore.Output {
     // 状态
     private final AtomicBoolean running = new AtomicBoolean(false);
     private Listener listener;
+    private byte datagramMarker;
+    private volatile DatagramListener datagramListener;
 
     // 线程
     private Thread updateThread;
@@ -118,6 +127,14 @@ public final class KcpTransport implements KcpCore.Output {
         this.listener = listener;
     }
 
+    /**
+     * 设置裸数据报监听器：首字节为 marker 的 UDP 包不送入 KCP，去掉首字节后直接回调（接收线程）
+     */
+    public void setDatagramListener(byte marker, DatagramListener listener) {
+        this.datagramMarker = marker;
+        this.datagramListener = listener;
+    }
+
     // =========================================================================
     // 配置
     // =========================================================================
@@ -181,14 +198,16 @@ public final class KcpTransport implements KcpCore.Output {
     }
 
     /**
-     * 启用/禁用 FEC 前向纠错 (XOR 冗余，允许丢 1 包恢复)
+     * 启用/禁用 FEC 前向纠错
+     * parityCount=1: XOR 冗余，允许每组丢 1 包恢复
+     * parityCount>1: Reed-Solomon k:m，允许每组丢任意 m 包恢复
      */
-    public void setFecEnabled(boolean enabled, int groupSize) {
+    public void setFecEnabled(boolean enabled, int groupSize, int parityCount) {
         this.fecEnabled = enabled;
         if (enabled) {
-            fecEncoder = new FecCodec.FecEncoder(groupSize);
+            fecEncoder = new FecCodec.FecEncoder(groupSize, 1400, parityCount);
             fecDecoder = new FecCodec.FecDecoder();
-            Ln.i("KCP FEC enabled: groupSize=" + groupSize);
+            Ln.i("KCP FEC enabled: " + (parityCount > 1 ? "RS " : "XOR ") + groupSize + ":" + Math.max(parityCount, 1));
         } else {
             fecEncoder = null;
             fecDecoder = null;
@@ -196,6 +215,10 @@ public final class KcpTransport implements KcpCore.Output {
         }
     }
 
+    public void setFecEnabled(boolean enabled, int groupSize) {
+        setFecEnabled(enabled, groupSize, 1);
+    }
+
     public void setFecEnabled(boolean enabled) {
         setFecEnabled(enabled, 10);
     }
@@ -457,6 +480,13 @@ public final class KcpTransport implements KcpCore.Output {
                     remoteAddress = (InetSocketAddress) packet.getSocketAddress();
                 }
 
+                DatagramListener rawListener = datagramListener;
+                if (rawListener != null && packet.getLength() > 1
+                        && packet.getData()[packet.getOffset()] == datagramMarker) {
+                    rawListener.onDatagram(packet.getData(), packet.getOffset() + 1, packet.getLength() - 1);
+                    continue;
+                }
+
                 synchronized (this) {
                     // FEC 解码
                     if (fecEnabled && fecDecoder != null) {
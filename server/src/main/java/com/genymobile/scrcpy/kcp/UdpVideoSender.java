@@ -4,6 +4,7 @@ import com.genymobile.scrcpy.device.IStreamer;
 import com.genymobile.scrcpy.device.Size;
 import com.genymobile.scrcpy.util.Codec;
 import com.genymobile.scrcpy.util.Ln;
+import com.genymobile.scrcpy.video.BitrateControl;
 
 import android.media.MediaCodec;
 
@@ -24,6 +25,17 @@ import java.nio.ByteBuffer;
  *   - flags bit 0 (SOF): 帧首包标志 (Start of Frame)
  *   - flags bit 1 (EOF): 帧尾包标志 (End of Frame)
  *   - 单包帧: flags = SOF|EOF (0x03)
+ *   - flags bit 2 (PROTECTED): 该包属于某个 FEC 分组
+ *   - flags bit 7 (PARITY): 校验包，不占用序号（见 FecCodec.SeqFecEncoder）
+ *
+ * 自适应 FEC：
+ *   客户端每秒经控制通道回报丢包率、突发长度与恢复成功数，
+ *   发送端据此调整分组大小 k 与校验包数 m。链路干净时 m=0，零开销。
+ *
+ * 拥塞控制与发送节拍：
+ *   客户端约每 50ms 回报最新到达的 seq 及其到达时刻，VideoRateController 由单向延迟
+ *   变化估计排队延迟并调整速率；速率作为编码器建议码率（BitrateControl），
+ *   同时 VideoPacer 按速率 × 2.5 匀速放出数据包，避免 I 帧突发压满 AP 缓冲区。
  *
  * 帧完整性保证：
  *   客户端按 SOF→EOF 重组帧数据。若 SOF 到 EOF 之间有任何丢包
@@ -36,7 +48,7 @@ import java.nio.ByteBuffer;
  *   - 无协议头开销（KCP 24 字节 vs UDP 5 字节）
  *   - 无用户态锁/线程开销（KCP 需 updateLoop + receiveLoop）
  */
-public final class UdpVideoSender implements IStreamer {
+public final class UdpVideoSender implements IStreamer, BitrateControl {
 
     private static final long PACKET_FLAG_CONFIG = 1L << 63;
     private static final long PACKET_FLAG_KEY_FRAME = 1L << 62;
@@ -50,6 +62,12 @@ public final class UdpVideoSender implements IStreamer {
     private static final byte FLAG_SOF = 0x01;   // Start of Frame（帧首包）
     private static final byte FLAG_EOF = 0x02;   // End of Frame（帧尾包）
 
+    // 自适应 FEC 边界
+    private static final int FEC_K_CLEAN = 16;   // 低丢包时的分组大小
+    private static final int FEC_K_LOSSY = 8;    // 丢包 >= 3% 时缩小分组，降低恢复延迟
+    private static final int FEC_LOSSY_PERMILLE = 30;
+    private static final int FEC_CLEAN_REPORTS = 3;  // 连续 N 次无丢包后关闭 FEC
+
     private final DatagramSocket socket;
     private final InetSocketAddress target;
     private final Codec codec;
@@ -62,6 +80,7 @@ public final class UdpVideoSender implements IStreamer {
     // 统计
     private long totalPackets = 0;
     private long totalBytes = 0;
+    private long totalParityPackets = 0;
 
     // 预分配缓冲区（根据码率动态计算）
     private final byte[] frameBuffer;
@@ -69,6 +88,15 @@ public final class UdpVideoSender implements IStreamer {
     // 发送缓冲区（避免每个 UDP 包分配 byte[]）
     private final byte[] sendBuffer = new byte[MTU];
 
+    // 视频 FEC（null 表示客户端不支持，从不发送校验包）
+    private final FecCodec.SeqFecEncoder fecEncoder;
+    private final FecCodec.SeqFecEncoder.OutputCallback paritySender;
+    private int cleanReports = 0;
+
+    // 拥塞控制（控制线程回报，编码线程发送）与发送节拍（仅编码线程）
+    private final VideoRateController rateController;
+    private final VideoPacer pacer = new VideoPacer();
+
     /**
      * 创建 UDP 视频发送器
      *
@@ -78,10 +106,11 @@ public final class UdpVideoSender implements IStreamer {
      * @param sendCodecMeta 是否发送编码器信息
      * @param sendFrameMeta 是否发送帧元数据
      * @param bitrateBps    码率（用于配置 socket 缓冲区）
+     * @param fec           客户端是否支持视频 FEC（初始 m=1，之后按丢包回报调整）
      */
     public UdpVideoSender(String clientIp, int port, Codec codec,
             boolean sendCodecMeta, boolean sendFrameMeta,
-            int bitrateBps) throws IOException {
+            int bitrateBps, boolean fec) throws IOException {
 
         this.codec = codec;
         this.sendCodecMeta = sendCodecMeta;
@@ -108,11 +137,27 @@ public final class UdpVideoSender implements IStreamer {
         // 好处：send() 不用每次指定目标，且内核跳过路由查找
         socket.connect(target);
 
+        rateController = new VideoRateController(bitrateBps);
+
+        if (fec) {
+            fecEncoder = new FecCodec.SeqFecEncoder(1 + MAX_PAYLOAD, FEC_K_CLEAN, 1);
+            paritySender = (buf, off, n) -> {
+                pacer.pace(n);
+                socket.send(new DatagramPacket(buf, off, n, target));
+                rateController.onParitySent(n);
+                totalParityPackets++;
+            };
+        } else {
+            fecEncoder = null;
+            paritySender = null;
+        }
+
         Ln.i("UdpVideoSender: streaming to " + clientIp + ":" + port +
                 " (pure UDP, no KCP)" +
                 " bitrate=" + (bitrateBps / 1000000) + "Mbps" +
                 " frameBuf=" + (frameBuffer.length / 1024) + "KB" +
-                " sendBuf=" + (sendBufSize / 1024) + "KB");
+                " sendBuf=" + (sendBufSize / 1024) + "KB" +
+                " fec=" + fec);
     }
 
     @Override
@@ -235,10 +280,13 @@ public final class UdpVideoSender implements IStreamer {
         int pos = off;
         int remaining = len;
         boolean first = true;
+        pacer.setRate(rateController.getPacingRateBps());
 
         while (remaining > 0) {
             int chunkSize = Math.min(remaining, MAX_PAYLOAD);
             boolean last = (remaining - chunkSize == 0);
+            boolean protect = fecEncoder != null && fecEncoder.beginPacket();
+            int curSeq = seq;
 
             // 序号头 (big-endian uint32)
             sendBuffer[0] = (byte) (seq >> 24);
@@ -251,15 +299,23 @@ public final class UdpVideoSender implements IStreamer {
             byte flags = 0;
             if (first) flags |= FLAG_SOF;
             if (last)  flags |= FLAG_EOF;
+            if (protect) flags |= FecCodec.SeqFecEncoder.FLAG_PROTECTED;
             sendBuffer[4] = flags;
 
             // 拷贝 payload
             System.arraycopy(data, pos, sendBuffer, SEQ_HEADER_SIZE, chunkSize);
 
-            // 发送
+            // 按节拍发送
+            pacer.pace(SEQ_HEADER_SIZE + chunkSize);
             DatagramPacket packet = new DatagramPacket(
                     sendBuffer, SEQ_HEADER_SIZE + chunkSize, target);
             socket.send(packet);
+            rateController.onPacketSent(curSeq, SEQ_HEADER_SIZE + chunkSize);
+
+            // 累加校验（分组满或帧尾时发出校验包）
+            if (protect) {
+                fecEncoder.addPacket(curSeq, sendBuffer, 4, 1 + chunkSize, last, paritySender);
+            }
 
             totalPackets++;
             totalBytes += SEQ_HEADER_SIZE + chunkSize;
@@ -269,9 +325,87 @@ public final class UdpVideoSender implements IStreamer {
         }
     }
 
+    /**
+     * 客户端丢包回报（控制线程调用，参数在下一个分组边界生效）
+     *
+     * 策略：
+     *   - 连续 3 次无丢包且无未恢复 → m=0，关闭校验
+     *   - 丢包 >= 3% 用小分组 k=8，否则 k=16
+     *   - m 取 max(2 倍期望丢包数, 最大突发长度)，有未恢复则在当前基础上 +1
+     *
+     * @param lossPermille 原始丢包率（千分比，FEC 恢复前）
+     * @param avgBurstX10  平均突发丢包长度 ×10
+     * @param maxBurst     最大突发丢包长度
+     * @param recovered    FEC 恢复的包数
+     * @param unrecovered  FEC 未能恢复的丢包数
+     */
+    public void onFecReport(int lossPermille, int avgBurstX10, int maxBurst, int recovered, int unrecovered) {
+        rateController.onLoss(lossPermille);
+        if (fecEncoder == null) {
+            return;
+        }
+
+        int oldK = fecEncoder.getGroupSize();
+        int oldM = fecEncoder.getParityCount();
+        int k;
+        int m;
+
+        if (lossPermille == 0 && unrecovered == 0) {
+            if (cleanReports < FEC_CLEAN_REPORTS) {
+                cleanReports++;
+            }
+            k = oldK;
+            m = cleanReports >= FEC_CLEAN_REPORTS ? 0 : oldM;
+        } else {
+            cleanReports = 0;
+            k = lossPermille >= FEC_LOSSY_PERMILLE ? FEC_K_LOSSY : FEC_K_CLEAN;
+            // 每组期望丢包数 × 2 的余量，至少覆盖观测到的最长突发
+            int expected = (k * lossPermille * 2 + 999) / 1000;
+            m = Math.max(expected, Math.min(maxBurst, FecCodec.SeqFecEncoder.MAX_PARITY));
+            if (unrecovered > 0) {
+                m = Math.max(m, oldM + 1);
+            }
+            m = Math.max(1, Math.min(m, FecCodec.SeqFecEncoder.MAX_PARITY));
+        }
+
+        if (k != oldK || m != oldM) {
+            fecEncoder.setParams(k, m);
+            Ln.i("UdpVideoSender: FEC " + oldK + ":" + oldM + " -> " + k + ":" + m
+                    + " (loss=" + (lossPermille / 10.0) + "%, burst=" + (avgBurstX10 / 10.0) + "/" + maxBurst
+                    + ", recovered=" + recovered + ", unrecovered=" + unrecovered + ")");
+        }
+    }
+
+    /**
+     * 客户端传输反馈（控制线程调用）
+     *
+     * @param seq        最新按序到达的 seq
+     * @param recvTimeUs 该包到达时刻（客户端时钟低 32 位）
+     * @param recvBytes  自上次反馈以来收到的字节数
+     */
+    public void onVideoFeedback(int seq, int recvTimeUs, int recvBytes) {
+        int oldRate = rateController.getRateBps();
+        rateController.onFeedback(seq, recvTimeUs, recvBytes);
+        int newRate = rateController.getRateBps();
+        if (Math.abs(newRate - oldRate) * 10L >= oldRate) {
+            Ln.d("UdpVideoSender: rate " + oldRate / 1000 + " -> " + newRate / 1000 + " kbps"
+                    + " (queue=" + rateController.getQueueDelayUs() / 1000 + "ms)");
+        }
+    }
+
+    // =========================================================================
+    // BitrateControl: 发送端拥塞控制的速率估计作为编码器码率上限
+    // =========================================================================
+
+    @Override
+    public int getSuggestedBitrate(int baseBitrate) {
+        return Math.min(baseBitrate, rateController.getRateBps());
+    }
+
     public String getStats() {
-        return String.format("packets=%d, bytes=%d, seq=%d",
-                totalPackets, totalBytes, seq);
+        return String.format("packets=%d, bytes=%d, seq=%d, parity=%d, rate=%dkbps, paced=%dms",
+                totalPackets, totalBytes, seq, totalParityPackets,
+                rateController.getRateBps() / 1000, pacer.getPacedMs());
     }
 
     public void close() {
@@ -0,0 +1,59 @@
+package com.genymobile.scrcpy.kcp;
+
+import java.util.concurrent.locks.LockSupport;
+
+/**
+ * 视频发送节拍器（令牌桶）
+ *
+ * 按 VideoRateController 给出的速率匀速放出数据包，避免整个 I 帧一次性压进 AP 缓冲区。
+ * 允许 BURST_BYTES 的突发，令牌不足时在编码线程上 park 到令牌够用为止。
+ * 只在编码线程调用，非线程安全。
+ */
+final class VideoPacer {
+
+    private static final int BURST_BYTES = 16 * 1400;   // 约 16 个包
+
+    private long rateBps;
+    private double tokens = BURST_BYTES;
+    private long lastNs;
+
+    // 统计
+    private long pacedNs;
+
+    /**
+     * @param rateBps 节拍速率（bps），0 表示不限速
+     */
+    void setRate(long rateBps) {
+        this.rateBps = rateBps;
+    }
+
+    /**
+     * 发送 bytes 字节前调用，令牌不足时阻塞
+     */
+    void pace(int bytes) {
+        long now = System.nanoTime();
+        if (rateBps <= 0) {
+            tokens = BURST_BYTES;
+            lastNs = now;
+            return;
+        }
+        if (lastNs != 0) {
+            tokens = Math.min(BURST_BYTES, tokens + (now - lastNs) * rateBps / 8e9);
+        }
+        lastNs = now;
+        tokens -= bytes;
+        if (tokens < 0) {
+            // 等待期间的令牌在下次调用时按 lastNs 补回
+            long waitNs = (long) (-tokens * 8e9 / rateBps);
+            LockSupport.parkNanos(waitNs);
+            pacedNs += waitNs;
+        }
+    }
+
+    /**
+     * 累计节拍等待时间（毫秒）
+     */
+    long getPacedMs() {
+        return pacedNs / 1_000_000;
+    }
+}
@@ -0,0 +1,193 @@
+package com.genymobile.scrcpy.kcp;
+
+/**
+ * 视频发送端延迟梯度速率控制
+ *
+ * UdpVideoSender 记录每个序号的发送时刻；客户端约每 50ms 经控制通道回报
+ * 最新按序到达的 seq、其到达时刻（客户端时钟）和区间内收到的字节数。
+ *
+ * 单向延迟 = 到达时刻 - 发送时刻。两端时钟偏差是常量，减去 10 秒窗口内的最小值后抵消：
+ *   排队延迟 = 平滑单向延迟 - 最小单向延迟
+ *
+ * 每 ROUND_US 调整一次速率：
+ *   - 排队低于目标 TARGET_QUEUE_DELAY_US：按比例升速（最多 ×1.1），发送端受应用限制
+ *     （本轮发送速率不到估计值一半）时不升速
+ *   - 高于目标：按比例降速（最多 ×0.5），不低于本轮交付速率（排队时交付速率即瓶颈速率，
+ *     排队要几轮才能排空，没有这个下限会连续减半到最小速率）
+ *   - 排队已过半目标时出现丢包视为拥塞丢包，额外 ×0.85；纯随机丢包（无排队）不降速
+ * 速率上限为配置码率（编码器不会超过它），下限 MIN_RATE_BPS。
+ *
+ * 输出：编码器建议码率（UdpVideoSender 实现 BitrateControl）与发送节拍速率（速率 × PACING_GAIN）。
+ * 编码线程调用 onPacketSent/onParitySent，控制线程调用 onFeedback/onLoss，方法均加锁。
+ */
+public final class VideoRateController {
+
+    public static final int TARGET_QUEUE_DELAY_US = 15_000;
+    public static final int MIN_RATE_BPS = 500_000;
+    // I 帧可达平均帧的数倍，节拍按平均速率发会让关键帧在本地排队，留 2.5 倍余量
+    public static final double PACING_GAIN = 2.5;
+
+    private static final int ROUND_US = 100_000;
+    private static final int MIN_OWD_WINDOW_US = 10_000_000;
+    private static final int HISTORY = 4096;    // 发送时刻环形缓冲（序号数，2 的幂）
+
+    private final int maxRateBps;
+    private volatile int rateBps;
+
+    // 发送时刻（发送端时钟微秒低 32 位），按 seq & (HISTORY - 1) 索引
+    private final int[] sendTimeUs = new int[HISTORY];
+    private int nextSeq;
+    private boolean anySent;
+
+    // 单向延迟（含两端时钟偏差，只用差值）
+    private boolean hasOwd;
+    private int owd;            // EWMA 1/4
+    private int minOwd;
+    private int minOwdStamp;
+
+    // 当前轮次
+    private boolean roundStarted;
+    private int roundStartUs;
+    private long roundSentBytes;
+    private long roundRecvBytes;
+    private boolean hasRecvStart;
+    private int roundRecvStartUs;   // 客户端时钟：上一轮最后一次反馈的到达时刻
+    private int lastRecvUs;
+    private boolean roundLoss;
+
+    /**
+     * @param maxRateBps 配置码率（bps），速率上限与初始值
+     */
+    public VideoRateController(int maxRateBps) {
+        this.maxRateBps = Math.max(maxRateBps, MIN_RATE_BPS);
+        this.rateBps = this.maxRateBps;
+    }
+
+    private static int nowUs() {
+        return (int) (System.nanoTime() / 1000);
+    }
+
+    /**
+     * 当前速率估计（bps，任意线程）
+     */
+    public int getRateBps() {
+        return rateBps;
+    }
+
+    /**
+     * 发送节拍速率（bps，任意线程）
+     */
+    public long getPacingRateBps() {
+        return (long) (rateBps * PACING_GAIN);
+    }
+
+    /**
+     * 当前排队延迟估计（微秒）
+     */
+    public synchronized int getQueueDelayUs() {
+        return hasOwd ? Math.max(0, owd - minOwd) : 0;
+    }
+
+    public void onPacketSent(int seq, int bytes) {
+        onPacketSent(seq, bytes, nowUs());
+    }
+
+    synchronized void onPacketSent(int seq, int bytes, int nowUs) {
+        sendTimeUs[seq & (HISTORY - 1)] = nowUs;
+        nextSeq = seq + 1;
+        anySent = true;
+        roundSentBytes += bytes;
+    }
+
+    /**
+     * 校验包不占序号，只计入发送字节
+     */
+    public synchronized void onParitySent(int bytes) {
+        roundSentBytes += bytes;
+    }
+
+    /**
+     * 客户端丢包回报（FEC 恢复前的原始丢包率），在下一轮结束时生效
+     */
+    public synchronized void onLoss(int lossPermille) {
+        if (lossPermille > 0) {
+            roundLoss = true;
+        }
+    }
+
+    /**
+     * 客户端传输反馈
+     *
+     * @param seq        最新按序到达的 seq
+     * @param recvTimeUs 该包到达时刻（客户端时钟低 32 位）
+     * @param recvBytes  自上次反馈以来收到的字节数
+     */
+    public void onFeedback(int seq, int recvTimeUs, int recvBytes) {
+        onFeedback(seq, recvTimeUs, recvBytes, nowUs());
+    }
+
+    synchronized void onFeedback(int seq, int recvTimeUs, int recvBytes, int nowUs) {
+        int age = nextSeq - seq;
+        if (!anySent || age <= 0 || age > HISTORY) {
+            // 序号超出发送记录（过旧或尚未发送），不可用于延迟测量
+            return;
+        }
+
+        int sample = recvTimeUs - sendTimeUs[seq & (HISTORY - 1)];
+        owd = hasOwd ? owd + (sample - owd) / 4 : sample;
+        // 窗口到期后用当前样本重新开始，跟随路由变化
+        if (!hasOwd || sample - minOwd < 0 || nowUs - minOwdStamp > MIN_OWD_WINDOW_US) {
+            minOwd = sample;
+            minOwdStamp = nowUs;
+        }
+        hasOwd = true;
+
+        if (!roundStarted) {
+            roundStarted = true;
+            roundStartUs = nowUs;
+            roundRecvBytes = 0;
+        } else {
+            roundRecvBytes += recvBytes;
+        }
+        lastRecvUs = recvTimeUs;
+
+        if (nowUs - roundStartUs >= ROUND_US) {
+            onRoundEnd(nowUs);
+        }
+    }
+
+    private void onRoundEnd(int nowUs) {
+        int elapsed = Math.max(nowUs - roundStartUs, 1);
+        double sentBps = roundSentBytes * 8e6 / elapsed;
+        double deliveredBps = 0;
+        int recvSpan = lastRecvUs - roundRecvStartUs;
+        if (hasRecvStart && recvSpan > 0) {
+            deliveredBps = roundRecvBytes * 8e6 / recvSpan;
+        }
+
+        int delay = getQueueDelayUs();
+        double rate = rateBps;
+        double offset = Math.max(-1.0, (double) (TARGET_QUEUE_DELAY_US - delay) / TARGET_QUEUE_DELAY_US);
+        if (offset > 0) {
+            if (sentBps * 2 >= rate) {
+                rate *= 1.0 + 0.1 * offset;
+            }
+        } else {
+            rate *= 1.0 + 0.5 * offset;
+        }
+        if (roundLoss && delay > TARGET_QUEUE_DELAY_US / 2) {
+            rate *= 0.85;
+        }
+        if (rate < rateBps && deliveredBps > 0) {
+            rate = Math.max(rate, Math.min(deliveredBps, rateBps));
+        }
+        rateBps = (int) Math.max(MIN_RATE_BPS, Math.min(maxRateBps, rate));
+
+        roundStartUs = nowUs;
+        roundSentBytes = 0;
+        roundRecvBytes = 0;
+        roundRecvStartUs = lastRecvUs;
+        hasRecvStart = true;
+        roundLoss = false;
+    }
+}
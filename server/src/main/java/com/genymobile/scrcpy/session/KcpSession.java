@@ -53,7 +53,8 @@ public class KcpSession extends ScrcpySession {
                 options.getVideoCodec(),
                 options.getSendCodecMeta(),
                 options.getSendFrameMeta(),
-                options.getVideoBitRate()
+                options.getVideoBitRate(),
+                options.getVideoFec()
         );
         return udpVideoSender;
     }
@@ -65,10 +66,22 @@ public class KcpSession extends ScrcpySession {
 
         Ln.i("Starting KCP control channel to " + clientIp + ":" + port);
 
-        kcpControlChannel = new KcpControlChannel(clientIp, port);
+        kcpControlChannel = new KcpControlChannel(clientIp, port, options.getKcpFecData(), options.getKcpFecParity());
         return kcpControlChannel;
     }
 
+    @Override
+    protected void onSessionInitialized() throws IOException {
+        // 客户端丢包回报 → 视频发送端调整 FEC 参数
+        if (controller != null && udpVideoSender != null && options.getVideoFec()) {
+            controller.setFecReportListener(udpVideoSender::onFecReport);
+        }
+        // 客户端传输反馈 → 视频发送端拥塞控制与发送节拍
+        if (controller != null && udpVideoSender != null) {
+            controller.setVideoFeedbackListener(udpVideoSender::onVideoFeedback);
+        }
+    }
+
     @Override
     protected String getSessionName() {
         return String.format("WiFi mode (UDP video + KCP control): video_port=%d, control_port=%d, client=%s",
@@ -0,0 +1,76 @@
+/*
+ * MultipathSession.java - USB + WiFi 多路径会话
+ *
+ * Copyright (C) 2019-2026 Rankun
+ * Licensed under the Apache License, Version 2.0
+ */
+
+package com.genymobile.scrcpy.session;
+
+import com.genymobile.scrcpy.Options;
+import com.genymobile.scrcpy.control.IControlChannel;
+import com.genymobile.scrcpy.control.MultipathControlChannel;
+import com.genymobile.scrcpy.kcp.KcpControlChannel;
+import com.genymobile.scrcpy.util.Ln;
+
+import java.io.IOException;
+
+/**
+ * 多路径会话 (USB TCP 视频/控制 + WiFi KCP 控制)
+ * <p>
+ * 在 USB 会话的基础上再开一条 KCP 控制通道，两条路径的消息合并给 Controller：
+ * <ul>
+ *   <li>视频：沿用 USB 的 TCP 通道</li>
+ *   <li>控制：客户端按各路径实测 RTT/丢包选择最快路径发送，DOWN/UP 等关键消息可两路各发一份，
+ *       由 {@link MultipathControlChannel} 去重</li>
+ *   <li>一条控制路径断开后继续使用另一条，不需要重连</li>
+ *   <li>需要 client_ip 和 kcp_control_port 参数</li>
+ * </ul>
+ */
+public class MultipathSession extends TcpSession {
+
+    private KcpControlChannel kcpControlChannel;
+    private MultipathControlChannel multipathChannel;
+
+    public MultipathSession(Options options) {
+        super(options);
+
+        if (options.getClientIp().isEmpty()) {
+            throw new IllegalArgumentException("Multipath mode requires client_ip parameter");
+        }
+    }
+
+    @Override
+    protected IControlChannel createControlChannel() throws IOException {
+        IControlChannel tcpChannel = super.createControlChannel();
+
+        String clientIp = options.getClientIp();
+        int port = options.getKcpControlPort();
+        Ln.i("Starting KCP control path to " + clientIp + ":" + port);
+        kcpControlChannel = new KcpControlChannel(clientIp, port, options.getKcpFecData(), options.getKcpFecParity());
+
+        multipathChannel = new MultipathControlChannel(
+                new IControlChannel[] {tcpChannel, kcpControlChannel},
+                new String[] {"usb", "wifi"});
+        return multipathChannel;
+    }
+
+    @Override
+    protected String getSessionName() {
+        return String.format("Multipath mode (TCP video + TCP/KCP control): tunnel_forward=%s, control_port=%d, client=%s",
+                options.isTunnelForward(),
+                options.getKcpControlPort(),
+                options.getClientIp());
+    }
+
+    @Override
+    protected void onCleanup() {
+        super.onCleanup();
+        if (multipathChannel != null) {
+            multipathChannel.close();
+            multipathChannel = null;
+        } else if (kcpControlChannel != null) {
+            kcpControlChannel.close();
+        }
+    }
+}
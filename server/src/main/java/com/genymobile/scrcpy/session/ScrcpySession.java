@@ -83,6 +83,12 @@ public abstract class ScrcpySession implements Closeable {
                     SurfaceCapture surfaceCapture = new ScreenCapture(controller, options);
                     SurfaceEncoder surfaceEncoder = new SurfaceEncoder(surfaceCapture, videoStreamer, options);
                     asyncProcessors.add(surfaceEncoder);
+                    // 客户端丢帧后请求立即输出同步帧，无需等待周期 IDR
+                    if (controller != null) {
+                        controller.setKeyFrameRequestListener(surfaceEncoder::requestSyncFrame);
+                        // 客户端带宽估计回报的目标码率作为 ABR 上限
+                        controller.setBitrateTargetListener(surfaceEncoder::setClientTargetBitrate);
+                    }
                     Ln.i("Video streaming started");
                 }
             }
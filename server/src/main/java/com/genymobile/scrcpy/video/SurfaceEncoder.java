@@ -26,6 +26,7 @@ import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.util.List;
 import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
 
 public class SurfaceEncoder implements AsyncProcessor {
 
@@ -56,6 +57,12 @@ public class SurfaceEncoder implements AsyncProcessor {
     private Thread thread;
     private final AtomicBoolean stopped = new AtomicBoolean();
 
+    // 客户端请求的同步帧（控制线程置位，编码线程消费；多次请求合并为一次）
+    private final AtomicBoolean syncFrameRequested = new AtomicBoolean();
+
+    // 客户端带宽估计回报的目标码率（控制线程写入，编码线程读取；0 表示未收到）
+    private final AtomicInteger clientTargetBitrate = new AtomicInteger();
+
     private final CaptureReset reset = new CaptureReset();
 
     public SurfaceEncoder(SurfaceCapture capture, IStreamer streamer, Options options) {
@@ -220,6 +227,32 @@ public class SurfaceEncoder implements AsyncProcessor {
 
         boolean eos;
         do {
+            if (syncFrameRequested.getAndSet(false)) {
+                try {
+                    Bundle params = new Bundle();
+                    params.putInt(MediaCodec.PARAMETER_KEY_REQUEST_SYNC_FRAME, 0);
+                    codec.setParameters(params);
+                    Ln.d("Sync frame requested by client");
+                } catch (IllegalStateException e) {
+                    // 编码器已停止，忽略
+                }
+            }
+
+            // 客户端判定网络过载：立即降码率，不等 ABR 窗口（队列每多堆积一个窗口就多 500ms 延迟）
+            int clientTarget = Math.min(clientTargetBitrate.get(), videoBitRate);
+            if (clientTarget > 0 && clientTarget < abrCurrentBitrate * 0.95f) {
+                try {
+                    Bundle params = new Bundle();
+                    params.putInt(MediaCodec.PARAMETER_KEY_VIDEO_BITRATE, clientTarget);
+                    codec.setParameters(params);
+                    Ln.d("ABR adjust: " + abrCurrentBitrate / 1000 + " -> " + clientTarget / 1000
+                            + " kbps (client estimate)");
+                    abrCurrentBitrate = clientTarget;
+                } catch (IllegalStateException e) {
+                    // 部分编码器不支持动态码率
+                }
+            }
+
             int outputBufferId = codec.dequeueOutputBuffer(bufferInfo, DEQUEUE_TIMEOUT_US);
 
             try {
@@ -267,6 +300,10 @@ public class SurfaceEncoder implements AsyncProcessor {
                                 int networkSuggested = bitrateControl.getSuggestedBitrate(videoBitRate);
                                 newTarget = Math.min(newTarget, networkSuggested);
                             }
+                            // 客户端接收端估计同样作为上限，恢复时由上面的 +10% 逐步跟上
+                            if (clientTarget > 0) {
+                                newTarget = Math.min(newTarget, clientTarget);
+                            }
 
                             // 码率变化超过 5% 才实际调整，避免频繁设置
                             if (Math.abs(newTarget - abrCurrentBitrate) > abrCurrentBitrate * 0.05f) {
@@ -296,6 +333,20 @@ public class SurfaceEncoder implements AsyncProcessor {
         } while (!eos);
     }
 
+    /**
+     * 请求编码器尽快输出同步帧（IDR），在编码循环中生效
+     */
+    public void requestSyncFrame() {
+        syncFrameRequested.set(true);
+    }
+
+    /**
+     * 客户端接收端带宽估计的目标码率（bps），作为 ABR 上限，低于当前码率时立即生效
+     */
+    public void setClientTargetBitrate(int bitrate) {
+        clientTargetBitrate.set(Math.max(bitrate, 0));
+    }
+
     private static MediaCodec createMediaCodec(Codec codec, String encoderName)
             throws IOException, ConfigurationException {
         if (encoderName != null) {
@@ -422,6 +422,206 @@ public class ControlMessageReaderTest {
         Assert.assertEquals(-1, bis.read()); // EOS
     }
 
+    @Test
+    public void testParseFecReport() throws IOException {
+        ByteArrayOutputStream bos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(bos);
+        dos.writeByte(ControlMessage.TYPE_FEC_REPORT);
+        dos.writeShort(0xFFFE); // lossPermille (unsigned 16)
+        dos.writeByte(0xC8); // avgBurstX10 (unsigned 8)
+        dos.writeByte(0xFF); // maxBurst (unsigned 8)
+        dos.writeShort(0x8001); // recovered (unsigned 16)
+        dos.writeShort(0xFFFF); // unrecovered (unsigned 16)
+        byte[] packet = bos.toByteArray();
+        Assert.assertEquals(9, packet.length);
+
+        ByteArrayInputStream bis = new ByteArrayInputStream(packet);
+        ControlMessageReader reader = new ControlMessageReader(bis);
+
+        ControlMessage event = reader.read();
+        Assert.assertEquals(ControlMessage.TYPE_FEC_REPORT, event.getType());
+        Assert.assertEquals(0xFFFE, event.getLossPermille());
+        Assert.assertEquals(0xC8, event.getAvgBurstX10());
+        Assert.assertEquals(0xFF, event.getMaxBurst());
+        Assert.assertEquals(0x8001, event.getRecovered());
+        Assert.assertEquals(0xFFFF, event.getUnrecovered());
+
+        Assert.assertEquals(-1, bis.read()); // EOS
+    }
+
+    @Test
+    public void testParseRequestKeyFrame() throws IOException {
+        ByteArrayOutputStream bos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(bos);
+        dos.writeByte(ControlMessage.TYPE_REQUEST_KEYFRAME);
+        // followed by a key event: REQUEST_KEYFRAME has no payload and must not consume it
+        dos.writeByte(ControlMessage.TYPE_KEY_DOWN);
+        dos.writeShort(KeyEvent.KEYCODE_ENTER);
+        byte[] packet = bos.toByteArray();
+
+        ByteArrayInputStream bis = new ByteArrayInputStream(packet);
+        ControlMessageReader reader = new ControlMessageReader(bis);
+
+        ControlMessage event = reader.read();
+        Assert.assertEquals(ControlMessage.TYPE_REQUEST_KEYFRAME, event.getType());
+
+        event = reader.read();
+        Assert.assertEquals(ControlMessage.TYPE_KEY_DOWN, event.getType());
+        Assert.assertEquals(KeyEvent.KEYCODE_ENTER, event.getKeycode());
+
+        Assert.assertEquals(-1, bis.read()); // EOS
+    }
+
+    @Test
+    public void testParseBitrateTarget() throws IOException {
+        ByteArrayOutputStream bos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(bos);
+        dos.writeByte(ControlMessage.TYPE_BITRATE_TARGET);
+        dos.write(new byte[] {0x01, 0x02, 0x03, 0x04}); // bitrate, big-endian
+        byte[] packet = bos.toByteArray();
+
+        ByteArrayInputStream bis = new ByteArrayInputStream(packet);
+        ControlMessageReader reader = new ControlMessageReader(bis);
+
+        ControlMessage event = reader.read();
+        Assert.assertEquals(ControlMessage.TYPE_BITRATE_TARGET, event.getType());
+        Assert.assertEquals(0x01020304, event.getBitrate());
+
+        Assert.assertEquals(-1, bis.read()); // EOS
+    }
+
+    @Test
+    public void testParseVideoFeedback() throws IOException {
+        ByteArrayOutputStream bos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(bos);
+        dos.writeByte(ControlMessage.TYPE_VIDEO_FEEDBACK);
+        dos.writeInt(0x01020304); // seq
+        dos.writeInt(0xF0E0D0C0); // recvTimeUs (client clock, wraps)
+        dos.writeInt(150000); // recvBytes
+        byte[] packet = bos.toByteArray();
+
+        ByteArrayInputStream bis = new ByteArrayInputStream(packet);
+        ControlMessageReader reader = new ControlMessageReader(bis);
+
+        ControlMessage event = reader.read();
+        Assert.assertEquals(ControlMessage.TYPE_VIDEO_FEEDBACK, event.getType());
+        Assert.assertEquals(0x01020304, event.getVideoSeq());
+        Assert.assertEquals(0xF0E0D0C0, event.getRecvTimeUs());
+        Assert.assertEquals(150000, event.getRecvBytes());
+
+        Assert.assertEquals(-1, bis.read()); // EOS
+    }
+
+    @Test
+    public void testParsePing() throws IOException {
+        ByteArrayOutputStream bos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(bos);
+        dos.writeByte(ControlMessage.TYPE_PING);
+        dos.writeLong(0x0102030405060708L); // clientTimeUs
+        byte[] packet = bos.toByteArray();
+
+        ByteArrayInputStream bis = new ByteArrayInputStream(packet);
+        ControlMessageReader reader = new ControlMessageReader(bis);
+
+        long before = System.nanoTime() / 1000;
+        ControlMessage event = reader.read();
+        long after = System.nanoTime() / 1000;
+        Assert.assertEquals(ControlMessage.TYPE_PING, event.getType());
+        Assert.assertEquals(0x0102030405060708L, event.getClientTime());
+        // receive timestamp is taken at read time, on the monotonic clock (µs)
+        Assert.assertTrue(event.getDeviceRecvTime() >= before);
+        Assert.assertTrue(event.getDeviceRecvTime() <= after);
+
+        Assert.assertEquals(-1, bis.read()); // EOS
+    }
+
+    @Test
+    public void testParseLaneMove() throws IOException {
+        ByteArrayOutputStream bos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(bos);
+        dos.writeByte(ControlMessage.TYPE_TOUCH_MOVE_SEQ);
+        dos.writeInt(0x01020304); // laneSeq
+        dos.writeByte(0xFE); // downGen (unsigned 8)
+        dos.writeByte(0x81); // seqId (unsigned 8)
+        dos.writeShort(0xFFF0); // x (unsigned 16)
+        dos.writeShort(0x8000); // y (unsigned 16)
+        byte[] packet = bos.toByteArray();
+        Assert.assertEquals(1 + 10, packet.length);
+
+        ByteArrayInputStream bis = new ByteArrayInputStream(packet);
+        ControlMessageReader reader = new ControlMessageReader(bis);
+
+        ControlMessage event = reader.read();
+        Assert.assertEquals(ControlMessage.TYPE_TOUCH_MOVE_SEQ, event.getType());
+        Assert.assertEquals(0x01020304, event.getLaneSeq());
+        Assert.assertEquals(0xFE, event.getDownGen());
+        Assert.assertEquals(0x81, event.getSeqId());
+        Assert.assertEquals(2, event.getAction()); // MOVE
+        Assert.assertEquals(0xFFF0, event.getTouchX());
+        Assert.assertEquals(0x8000, event.getTouchY());
+        Assert.assertFalse(event.hasPathSeq());
+
+        Assert.assertEquals(-1, bis.read()); // EOS
+    }
+
+    @Test
+    public void testParsePathDup() throws IOException {
+        ByteArrayOutputStream bos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(bos);
+        dos.writeByte(ControlMessage.TYPE_PATH_DUP);
+        dos.writeInt(0x01020304); // pathSeq
+        dos.writeByte(ControlMessage.TYPE_TOUCH_DOWN);
+        dos.writeByte(7); // seqId
+        dos.writeShort(1000); // x
+        dos.writeShort(2000); // y
+        // an unwrapped message afterwards must not inherit the path sequence
+        dos.writeByte(ControlMessage.TYPE_TOUCH_UP);
+        dos.writeByte(7); // seqId
+        dos.writeShort(1000); // x
+        dos.writeShort(2000); // y
+        byte[] packet = bos.toByteArray();
+
+        ByteArrayInputStream bis = new ByteArrayInputStream(packet);
+        ControlMessageReader reader = new ControlMessageReader(bis);
+
+        ControlMessage event = reader.read();
+        Assert.assertEquals(ControlMessage.TYPE_TOUCH_DOWN, event.getType());
+        Assert.assertEquals(7, event.getSeqId());
+        Assert.assertEquals(1000, event.getTouchX());
+        Assert.assertEquals(2000, event.getTouchY());
+        Assert.assertTrue(event.hasPathSeq());
+        Assert.assertEquals(0x01020304, event.getPathSeq());
+
+        event = reader.read();
+        Assert.assertEquals(ControlMessage.TYPE_TOUCH_UP, event.getType());
+        Assert.assertFalse(event.hasPathSeq());
+
+        Assert.assertEquals(-1, bis.read()); // EOS
+    }
+
+    @Test
+    public void testParseNestedPathDup() throws IOException {
+        ByteArrayOutputStream bos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(bos);
+        dos.writeByte(ControlMessage.TYPE_PATH_DUP);
+        dos.writeInt(1); // pathSeq
+        dos.writeByte(ControlMessage.TYPE_PATH_DUP);
+        dos.writeInt(2); // nested pathSeq
+        dos.writeByte(ControlMessage.TYPE_KEY_DOWN);
+        dos.writeShort(KeyEvent.KEYCODE_ENTER);
+        byte[] packet = bos.toByteArray();
+
+        ByteArrayInputStream bis = new ByteArrayInputStream(packet);
+        ControlMessageReader reader = new ControlMessageReader(bis);
+
+        try {
+            reader.read();
+            Assert.fail("Nested path dup message must be rejected");
+        } catch (ControlProtocolException e) {
+            // expected
+        }
+    }
+
     @Test
     public void testMultiEvents() throws IOException {
         ByteArrayOutputStream bos = new ByteArrayOutputStream();
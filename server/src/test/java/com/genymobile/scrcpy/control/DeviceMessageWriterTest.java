@@ -6,7 +6,9 @@ import org.junit.Test;
 import java.io.ByteArrayOutputStream;
 import java.io.DataOutputStream;
 import java.io.IOException;
+import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
 
 public class DeviceMessageWriterTest {
 
@@ -51,6 +53,33 @@ public class DeviceMessageWriterTest {
         Assert.assertArrayEquals(expected, actual);
     }
 
+    @Test
+    public void testSerializePong() throws IOException {
+        ByteArrayOutputStream bos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(bos);
+        dos.writeByte(DeviceMessage.TYPE_PONG);
+        dos.writeLong(0x0102030405060708L); // clientTime
+        dos.writeLong(0x1112131415161718L); // deviceRecvTime
+        byte[] expectedPrefix = bos.toByteArray();
+
+        bos = new ByteArrayOutputStream();
+        DeviceMessageWriter writer = new DeviceMessageWriter(bos);
+
+        DeviceMessage msg = DeviceMessage.createPong(0x0102030405060708L, 0x1112131415161718L);
+        long before = System.nanoTime() / 1000;
+        writer.write(msg);
+        long after = System.nanoTime() / 1000;
+
+        byte[] actual = bos.toByteArray();
+
+        // type(1) + clientTime(8) + deviceRecvTime(8) + deviceSendTime(8)
+        Assert.assertEquals(1 + 24, actual.length);
+        Assert.assertArrayEquals(expectedPrefix, Arrays.copyOf(actual, expectedPrefix.length));
+        long sendTime = ByteBuffer.wrap(actual, expectedPrefix.length, 8).getLong();
+        Assert.assertTrue(sendTime >= before);
+        Assert.assertTrue(sendTime <= after);
+    }
+
     @Test
     public void testSerializeUhidOutput() throws IOException {
         ByteArrayOutputStream bos = new ByteArrayOutputStream();
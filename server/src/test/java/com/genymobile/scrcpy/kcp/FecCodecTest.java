@@ -0,0 +1,64 @@
+package com.genymobile.scrcpy.kcp;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+public class FecCodecTest {
+
+    private static List<byte[]> decodeAll(FecCodec.FecDecoder decoder, List<byte[]> packets) {
+        List<byte[]> out = new ArrayList<>();
+        for (byte[] packet : packets) {
+            decoder.decode(packet, 0, packet.length, (data, offset, len) -> out.add(Arrays.copyOfRange(data, offset, offset + len)));
+        }
+        return out;
+    }
+
+    @Test
+    public void testXorRecoversLostPacket() {
+        FecCodec.FecEncoder encoder = new FecCodec.FecEncoder(4, 1400, 1);
+        List<byte[]> payloads = new ArrayList<>();
+        List<byte[]> packets = new ArrayList<>();
+        for (int i = 0; i < 4; i++) {
+            byte[] payload = new byte[10 + i];
+            Arrays.fill(payload, (byte) (i + 1));
+            payloads.add(payload);
+            encoder.encode(payload, 0, payload.length, (data, offset, len) -> packets.add(Arrays.copyOfRange(data, offset, offset + len)));
+        }
+        Assert.assertEquals(5, packets.size());
+
+        // Drop the second data packet; the parity packet must recover it
+        packets.remove(1);
+        List<byte[]> out = decodeAll(new FecCodec.FecDecoder(), packets);
+
+        Assert.assertEquals(4, out.size());
+        Assert.assertArrayEquals(payloads.get(0), out.get(0));
+        Assert.assertArrayEquals(payloads.get(2), out.get(1));
+        Assert.assertArrayEquals(payloads.get(3), out.get(2));
+        Assert.assertArrayEquals(payloads.get(1), out.get(3));
+    }
+
+    @Test
+    public void testXorDataDeliveredWhenGroupExceedsLimit() {
+        // groupSize 40 > FEC_XOR_MAX_GROUP: the data packet must still be delivered
+        byte[] packet = {FecCodec.FEC_TYPE_DATA, 0, 5, 40, 0, 3, 0x11, 0x22, 0x33};
+        List<byte[]> out = decodeAll(new FecCodec.FecDecoder(), Arrays.asList(packet));
+
+        Assert.assertEquals(1, out.size());
+        Assert.assertArrayEquals(new byte[] {0x11, 0x22, 0x33}, out.get(0));
+    }
+
+    @Test
+    public void testRsDataDeliveredWhenGroupExceedsLimit() {
+        // k 80 > FEC_RS_MAX_DATA and m 20 > FEC_RS_MAX_PARITY: data delivered, parity ignored
+        byte[] data = {FecCodec.FEC_TYPE_RS_DATA, 0, 7, 80, 20, 0, 2, 0x44, 0x55};
+        byte[] parity = {FecCodec.FEC_TYPE_RS_PARITY, 0, 80, 80, 20, 0, 2, 0x66, 0x77};
+        List<byte[]> out = decodeAll(new FecCodec.FecDecoder(), Arrays.asList(data, parity));
+
+        Assert.assertEquals(1, out.size());
+        Assert.assertArrayEquals(new byte[] {0x44, 0x55}, out.get(0));
+    }
+}
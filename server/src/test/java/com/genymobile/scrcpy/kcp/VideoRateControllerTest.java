@@ -0,0 +1,72 @@
+package com.genymobile.scrcpy.kcp;
+
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.util.ArrayDeque;
+
+public class VideoRateControllerTest {
+
+    private static final int PACKET = 1400;
+    private static final int MAX_RATE = 8_000_000;
+
+    // Sends at sendBps through a drop-tail bottleneck of bottleneckBps and reports every 50 ms.
+    // clockOffsetUs shifts the receiver clock; only delay differences may matter.
+    private static VideoRateController simulate(int sendBps, int bottleneckBps, int durationMs, int clockOffsetUs) {
+        VideoRateController cc = new VideoRateController(MAX_RATE);
+        long intervalUs = (long) (PACKET * 8e6 / sendBps);
+        long nextSendUs = 0;
+        double linkFreeUs = 0;
+        ArrayDeque<long[]> inFlight = new ArrayDeque<>();
+        int seq = 0;
+        int pendingBytes = 0;
+        int lastSeq = -1;
+        long lastArrivalUs = 0;
+
+        for (long t = 0; t < durationMs * 1000L; t += 1000) {
+            while (nextSendUs <= t) {
+                cc.onPacketSent(seq, PACKET, (int) nextSendUs);
+                linkFreeUs = Math.max(nextSendUs, linkFreeUs) + PACKET * 8e6 / bottleneckBps;
+                inFlight.add(new long[] {seq, (long) linkFreeUs});
+                seq++;
+                nextSendUs += intervalUs;
+            }
+            while (!inFlight.isEmpty() && inFlight.peek()[1] <= t) {
+                long[] packet = inFlight.poll();
+                lastSeq = (int) packet[0];
+                lastArrivalUs = packet[1];
+                pendingBytes += PACKET;
+            }
+            if (t % 50_000 == 0 && pendingBytes > 0) {
+                cc.onFeedback(lastSeq, (int) (lastArrivalUs + clockOffsetUs), pendingBytes, (int) t);
+                pendingBytes = 0;
+            }
+        }
+        return cc;
+    }
+
+    @Test
+    public void testCleanLinkKeepsConfiguredRate() {
+        VideoRateController cc = simulate(4_000_000, 8_000_000, 2000, 0);
+        Assert.assertEquals(MAX_RATE, cc.getRateBps());
+        Assert.assertEquals(0, cc.getQueueDelayUs());
+    }
+
+    @Test
+    public void testQueueingReducesRateToBottleneck() {
+        VideoRateController cc = simulate(8_000_000, 4_000_000, 2000, 0);
+        Assert.assertTrue(cc.getQueueDelayUs() > VideoRateController.TARGET_QUEUE_DELAY_US);
+        // The delivery-rate floor stops the decrease at the bottleneck instead of the minimum rate
+        Assert.assertTrue(cc.getRateBps() >= 3_500_000);
+        Assert.assertTrue(cc.getRateBps() <= 4_500_000);
+        Assert.assertEquals((long) (cc.getRateBps() * VideoRateController.PACING_GAIN), cc.getPacingRateBps());
+    }
+
+    @Test
+    public void testClockOffsetAndWrapDoNotMatter() {
+        VideoRateController reference = simulate(8_000_000, 2_000_000, 2000, 0);
+        VideoRateController wrapped = simulate(8_000_000, 2_000_000, 2000, Integer.MAX_VALUE - 500_000);
+        Assert.assertEquals(reference.getRateBps(), wrapped.getRateBps());
+        Assert.assertEquals(reference.getQueueDelayUs(), wrapped.getQueueDelayUs());
+    }
+}